@@ -0,0 +1,245 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "common/io/binary_protocol.h"
+#include "common/lang/string.h"
+
+namespace common {
+
+void put_u8(std::string &buf, uint8_t v)
+{
+  buf.push_back(static_cast<char>(v));
+}
+
+void put_u16(std::string &buf, uint16_t v)
+{
+  buf.push_back(static_cast<char>(v & 0xFF));
+  buf.push_back(static_cast<char>(v >> 8));
+}
+
+void put_u32(std::string &buf, uint32_t v)
+{
+  char bytes[4] = {static_cast<char>(v & 0xFF),
+      static_cast<char>((v >> 8) & 0xFF),
+      static_cast<char>((v >> 16) & 0xFF),
+      static_cast<char>(v >> 24)};
+  buf.append(bytes, sizeof(bytes));
+}
+
+void put_float(std::string &buf, float v)
+{
+  uint32_t bits;
+  memcpy(&bits, &v, sizeof(bits));
+  put_u32(buf, bits);
+}
+
+size_t begin_binary_message(std::string &buf, BinaryMessageType type)
+{
+  put_u8(buf, static_cast<uint8_t>(type));
+  size_t pos = buf.size();
+  put_u32(buf, 0);
+  return pos;
+}
+
+void finish_binary_message(std::string &buf, size_t header_pos)
+{
+  uint32_t size = static_cast<uint32_t>(buf.size() - header_pos - 4);
+  for (int i = 0; i < 4; i++) {
+    buf[header_pos + i] = static_cast<char>((size >> (i * 8)) & 0xFF);
+  }
+}
+
+namespace {
+
+/// 按顺序读取消息内容，越界时 ok 变成 false
+class BinaryReader
+{
+public:
+  BinaryReader(const char *data, uint32_t size) : data_(data), size_(size)
+  {}
+
+  bool ok() const { return ok_; }
+
+  uint32_t get_u32()
+  {
+    if (!check(4)) {
+      return 0;
+    }
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(data_ + pos_);
+    pos_ += 4;
+    return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+  }
+
+  uint16_t get_u16()
+  {
+    if (!check(2)) {
+      return 0;
+    }
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(data_ + pos_);
+    pos_ += 2;
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+  }
+
+  uint8_t get_u8()
+  {
+    if (!check(1)) {
+      return 0;
+    }
+    return static_cast<uint8_t>(data_[pos_++]);
+  }
+
+  const char *get_bytes(uint32_t size)
+  {
+    if (!check(size)) {
+      return nullptr;
+    }
+    const char *p = data_ + pos_;
+    pos_ += size;
+    return p;
+  }
+
+private:
+  bool check(uint32_t size)
+  {
+    if (!ok_ || size > size_ - pos_) {
+      ok_ = false;
+      return false;
+    }
+    return true;
+  }
+
+private:
+  const char *data_;
+  uint32_t    size_;
+  uint32_t    pos_ = 0;
+  bool        ok_  = true;
+};
+
+}  // namespace
+
+bool BinaryColumn::is_null(int row) const
+{
+  return (nulls[row / 8] >> (row % 8)) & 1;
+}
+
+std::string BinaryColumn::cell_string(int row) const
+{
+  if (type == BinaryColumnType::NULLS || is_null(row)) {
+    return "NULL";
+  }
+  switch (type) {
+    case BinaryColumnType::INT: return std::to_string(ints[row]);
+    case BinaryColumnType::BOOL: return std::to_string(ints[row]);
+    case BinaryColumnType::FLOAT: return double_to_str(floats[row]);
+    case BinaryColumnType::DATE: {
+      char buf[16] = {0};
+      int  date = ints[row];
+      snprintf(buf, sizeof(buf), "%04d-%02d-%02d", date / 10000, (date % 10000) / 100, date % 100);
+      return buf;
+    }
+    case BinaryColumnType::STRING: return dictionary[codes[row]];
+    default: return "";
+  }
+}
+
+bool parse_binary_message(const char *buf, size_t size, BinaryMessage &message, size_t &consumed)
+{
+  if (size < BINARY_MESSAGE_HEADER_SIZE) {
+    return false;
+  }
+  BinaryReader reader(buf + 1, 4);
+  uint32_t     body_size = reader.get_u32();
+  if (size - BINARY_MESSAGE_HEADER_SIZE < body_size) {
+    return false;
+  }
+  message.type = static_cast<BinaryMessageType>(buf[0]);
+  message.data = buf + BINARY_MESSAGE_HEADER_SIZE;
+  message.size = body_size;
+  consumed     = BINARY_MESSAGE_HEADER_SIZE + body_size;
+  return true;
+}
+
+bool decode_binary_schema(const BinaryMessage &message, std::vector<std::string> &names)
+{
+  names.clear();
+  BinaryReader reader(message.data, message.size);
+  uint16_t     column_num = reader.get_u16();
+  for (int i = 0; i < column_num && reader.ok(); i++) {
+    uint16_t    len  = reader.get_u16();
+    const char *name = reader.get_bytes(len);
+    if (name != nullptr) {
+      names.emplace_back(name, len);
+    }
+  }
+  return reader.ok();
+}
+
+bool decode_binary_batch(const BinaryMessage &message, BinaryBatch &batch)
+{
+  BinaryReader reader(message.data, message.size);
+  batch.rows          = static_cast<int>(reader.get_u32());
+  uint16_t column_num = reader.get_u16();
+  batch.columns.resize(column_num);
+
+  const uint32_t bitmap_size = (batch.rows + 7) / 8;
+  for (BinaryColumn &column : batch.columns) {
+    column.type        = static_cast<BinaryColumnType>(reader.get_u8());
+    const char *bitmap = reader.get_bytes(bitmap_size);
+    if (bitmap == nullptr) {
+      return false;
+    }
+    column.nulls.assign(bitmap, bitmap + bitmap_size);
+
+    column.ints.clear();
+    column.floats.clear();
+    column.dictionary.clear();
+    column.codes.clear();
+    switch (column.type) {
+      case BinaryColumnType::NULLS: break;
+      case BinaryColumnType::INT:
+      case BinaryColumnType::DATE: {
+        column.ints.resize(batch.rows);
+        for (int i = 0; i < batch.rows; i++) {
+          column.ints[i] = static_cast<int32_t>(reader.get_u32());
+        }
+      } break;
+      case BinaryColumnType::BOOL: {
+        column.ints.resize(batch.rows);
+        for (int i = 0; i < batch.rows; i++) {
+          column.ints[i] = reader.get_u8();
+        }
+      } break;
+      case BinaryColumnType::FLOAT: {
+        column.floats.resize(batch.rows);
+        for (int i = 0; i < batch.rows; i++) {
+          uint32_t bits = reader.get_u32();
+          memcpy(&column.floats[i], &bits, sizeof(bits));
+        }
+      } break;
+      case BinaryColumnType::STRING: {
+        uint32_t dictionary_size = reader.get_u32();
+        for (uint32_t i = 0; i < dictionary_size && reader.ok(); i++) {
+          uint32_t    len = reader.get_u32();
+          const char *str = reader.get_bytes(len);
+          if (str != nullptr) {
+            column.dictionary.emplace_back(str, len);
+          }
+        }
+        column.codes.resize(batch.rows);
+        for (int i = 0; i < batch.rows; i++) {
+          column.codes[i] = reader.get_u32();
+          if (reader.ok() && column.codes[i] >= column.dictionary.size()) {
+            return false;
+          }
+        }
+      } break;
+      default: return false;
+    }
+    if (!reader.ok()) {
+      return false;
+    }
+  }
+  return reader.ok();
+}
+
+}  // namespace common
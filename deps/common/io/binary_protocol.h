@@ -0,0 +1,95 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace common {
+
+/**
+ * @brief 二进制结果协议
+ * @details 请求仍然是以'\0'结尾的SQL文本，结果由若干个消息组成，每个消息的格式是
+ * [1字节类型][4字节长度][消息内容]，整数都使用小端序。
+ * 一个请求的结果以 END 消息结束。查询的结果先发送一个 SCHEMA 消息，再发送若干个按列存放的 BATCH 消息，
+ * 其它的状态信息(比如 SUCCESS、耗时)使用 TEXT 消息。
+ *
+ * SCHEMA: [2字节列数] 每一列 [2字节长度][列名]
+ * BATCH : [4字节行数][2字节列数] 每一列 [1字节类型][NULL位图，(行数+7)/8字节][数据]
+ *   INT/DATE: 每行4字节整数，DATE 是 yyyymmdd 格式的整数
+ *   FLOAT   : 每行4字节浮点数
+ *   BOOL    : 每行1字节
+ *   STRING  : [4字节字典大小] 每一项 [4字节长度][内容]，然后每行一个4字节的字典下标
+ *   NULLS   : 整列都是 NULL，没有数据
+ * NULL 的行在数据中占位，值没有意义
+ */
+enum class BinaryMessageType : uint8_t
+{
+  SCHEMA = 'S',
+  BATCH  = 'B',
+  TEXT   = 'T',
+  END    = 'E',
+};
+
+enum class BinaryColumnType : uint8_t
+{
+  NULLS  = 0,
+  INT    = 1,
+  FLOAT  = 2,
+  DATE   = 3,
+  BOOL   = 4,
+  STRING = 5,
+};
+
+static constexpr int BINARY_MESSAGE_HEADER_SIZE = 5;
+
+void put_u8(std::string &buf, uint8_t v);
+void put_u16(std::string &buf, uint16_t v);
+void put_u32(std::string &buf, uint32_t v);
+void put_float(std::string &buf, float v);
+
+/**
+ * @brief 在缓存中追加一个消息头，返回长度字段的位置，内容写完之后用 finish_binary_message 填上长度
+ */
+size_t begin_binary_message(std::string &buf, BinaryMessageType type);
+void   finish_binary_message(std::string &buf, size_t header_pos);
+
+/// 解码后的一列
+struct BinaryColumn
+{
+  BinaryColumnType         type = BinaryColumnType::NULLS;
+  std::vector<uint8_t>     nulls;       ///< NULL位图
+  std::vector<int32_t>     ints;        ///< INT/DATE/BOOL
+  std::vector<float>       floats;
+  std::vector<std::string> dictionary;  ///< STRING 的字典
+  std::vector<uint32_t>    codes;       ///< STRING 每行的字典下标
+
+  bool        is_null(int row) const;
+  std::string cell_string(int row) const;
+};
+
+/// 解码后的一批数据
+struct BinaryBatch
+{
+  int                       rows = 0;
+  std::vector<BinaryColumn> columns;
+};
+
+/// 缓存中的一个完整消息，data 指向缓存内部
+struct BinaryMessage
+{
+  BinaryMessageType type;
+  const char       *data;
+  uint32_t          size;
+};
+
+/**
+ * @brief 从缓存的开头解析一个消息
+ * @param consumed 消息占用的字节数
+ * @return 缓存中还没有完整的消息时返回 false
+ */
+bool parse_binary_message(const char *buf, size_t size, BinaryMessage &message, size_t &consumed);
+
+bool decode_binary_schema(const BinaryMessage &message, std::vector<std::string> &names);
+bool decode_binary_batch(const BinaryMessage &message, BinaryBatch &batch);
+
+}  // namespace common
@@ -0,0 +1,417 @@
+#include <errno.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <new>
+#include <thread>
+
+#include "common/io/shm_channel.h"
+
+namespace common {
+
+namespace {
+
+static constexpr uint32_t SHM_CHANNEL_MAGIC = 0x4d485354;  // "TSHM"
+
+/// 共享内存的开头，后面依次是请求环与结果环的控制信息，然后是两个环的数据
+struct ShmRegionHeader
+{
+  uint32_t magic;
+  uint32_t ring_size;
+};
+
+static constexpr size_t REQUEST_HEADER_OFFSET  = 64;
+static constexpr size_t RESPONSE_HEADER_OFFSET = REQUEST_HEADER_OFFSET + sizeof(ShmRingHeader);
+static constexpr size_t DATA_OFFSET            = RESPONSE_HEADER_OFFSET + sizeof(ShmRingHeader);
+
+size_t region_size(uint32_t ring_size)
+{
+  return DATA_OFFSET + 2 * static_cast<size_t>(ring_size);
+}
+
+inline void cpu_relax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#endif
+}
+
+}  // namespace
+
+void ShmRing::attach(ShmRingHeader *header, char *data, uint32_t capacity)
+{
+  header_   = header;
+  data_     = data;
+  capacity_ = capacity;
+}
+
+uint32_t ShmRing::readable() const
+{
+  return static_cast<uint32_t>(
+      header_->write_pos.load(std::memory_order_acquire) - header_->read_pos.load(std::memory_order_relaxed));
+}
+
+uint32_t ShmRing::writable() const
+{
+  return capacity_ - static_cast<uint32_t>(header_->write_pos.load(std::memory_order_relaxed) -
+                                           header_->read_pos.load(std::memory_order_acquire));
+}
+
+uint32_t ShmRing::write(const char *data, uint32_t size)
+{
+  const uint64_t write_pos = header_->write_pos.load(std::memory_order_relaxed);
+  const uint32_t n         = std::min(size, writable());
+  if (n == 0) {
+    return 0;
+  }
+
+  const uint32_t pos   = static_cast<uint32_t>(write_pos % capacity_);
+  const uint32_t first = std::min(n, capacity_ - pos);
+  memcpy(data_ + pos, data, first);
+  memcpy(data_, data + first, n - first);
+  header_->write_pos.store(write_pos + n, std::memory_order_release);
+  return n;
+}
+
+uint32_t ShmRing::read(char *buf, uint32_t size)
+{
+  const uint64_t read_pos = header_->read_pos.load(std::memory_order_relaxed);
+  const uint32_t n        = std::min(size, readable());
+  if (n == 0) {
+    return 0;
+  }
+
+  const uint32_t pos   = static_cast<uint32_t>(read_pos % capacity_);
+  const uint32_t first = std::min(n, capacity_ - pos);
+  memcpy(buf, data_ + pos, first);
+  memcpy(buf + first, data_, n - first);
+  header_->read_pos.store(read_pos + n, std::memory_order_release);
+  return n;
+}
+
+bool ShmRing::prepare_read_wait()
+{
+  // 先设置标记再检查，与 take_reader_waiting 中先发布数据再检查标记配合，不会丢失唤醒
+  header_->reader_waiting.store(1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (readable() > 0) {
+    header_->reader_waiting.store(0, std::memory_order_relaxed);
+    return false;
+  }
+  return true;
+}
+
+bool ShmRing::prepare_write_wait()
+{
+  header_->writer_waiting.store(1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (writable() > 0) {
+    header_->writer_waiting.store(0, std::memory_order_relaxed);
+    return false;
+  }
+  return true;
+}
+
+bool ShmRing::take_reader_waiting()
+{
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  return header_->reader_waiting.load(std::memory_order_relaxed) != 0 &&
+         header_->reader_waiting.exchange(0, std::memory_order_relaxed) != 0;
+}
+
+bool ShmRing::take_writer_waiting()
+{
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  return header_->writer_waiting.load(std::memory_order_relaxed) != 0 &&
+         header_->writer_waiting.exchange(0, std::memory_order_relaxed) != 0;
+}
+
+ShmChannel::~ShmChannel()
+{
+  if (memory_ != nullptr) {
+    munmap(memory_, memory_size_);
+    memory_ = nullptr;
+  }
+  for (int &fd : fds_) {
+    if (fd >= 0) {
+      close(fd);
+      fd = -1;
+    }
+  }
+}
+
+void ShmChannel::map_rings()
+{
+  const uint32_t ring_size = reinterpret_cast<ShmRegionHeader *>(memory_)->ring_size;
+  request_ring_.attach(
+      reinterpret_cast<ShmRingHeader *>(memory_ + REQUEST_HEADER_OFFSET), memory_ + DATA_OFFSET, ring_size);
+  response_ring_.attach(reinterpret_cast<ShmRingHeader *>(memory_ + RESPONSE_HEADER_OFFSET),
+      memory_ + DATA_OFFSET + ring_size,
+      ring_size);
+}
+
+int ShmChannel::create(uint32_t ring_size)
+{
+  if (ring_size == 0) {
+    return -1;
+  }
+
+  fds_[SHM_MEMORY_FD] = memfd_create("tdb_shm_channel", MFD_CLOEXEC);
+  if (fds_[SHM_MEMORY_FD] < 0) {
+    return -1;
+  }
+  memory_size_ = region_size(ring_size);
+  if (ftruncate(fds_[SHM_MEMORY_FD], static_cast<off_t>(memory_size_)) < 0) {
+    return -1;
+  }
+  void *memory = mmap(nullptr, memory_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fds_[SHM_MEMORY_FD], 0);
+  if (memory == MAP_FAILED) {
+    return -1;
+  }
+  memory_ = static_cast<char *>(memory);
+
+  ShmRegionHeader *header = reinterpret_cast<ShmRegionHeader *>(memory_);
+  header->magic           = SHM_CHANNEL_MAGIC;
+  header->ring_size       = ring_size;
+  new (memory_ + REQUEST_HEADER_OFFSET) ShmRingHeader();
+  new (memory_ + RESPONSE_HEADER_OFFSET) ShmRingHeader();
+  map_rings();
+
+  fds_[SHM_CLIENT_EVENT_FD] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  return fds_[SHM_CLIENT_EVENT_FD] < 0 ? -1 : 0;
+}
+
+int ShmChannel::attach(const int fds[SHM_CHANNEL_FD_NUM])
+{
+  std::copy(fds, fds + SHM_CHANNEL_FD_NUM, fds_);
+
+  struct stat st;
+  if (fstat(fds_[SHM_MEMORY_FD], &st) < 0 || static_cast<size_t>(st.st_size) < DATA_OFFSET) {
+    return -1;
+  }
+  memory_size_ = static_cast<size_t>(st.st_size);
+  void *memory = mmap(nullptr, memory_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fds_[SHM_MEMORY_FD], 0);
+  if (memory == MAP_FAILED) {
+    return -1;
+  }
+  memory_ = static_cast<char *>(memory);
+
+  const ShmRegionHeader *header = reinterpret_cast<const ShmRegionHeader *>(memory_);
+  if (header->magic != SHM_CHANNEL_MAGIC || header->ring_size == 0 ||
+      region_size(header->ring_size) != memory_size_) {
+    return -1;
+  }
+  map_rings();
+  return 0;
+}
+
+int ShmChannel::effective_spin_us(int spin_us)
+{
+  static const bool single_cpu = std::thread::hardware_concurrency() <= 1;
+  return single_cpu ? 0 : std::max(spin_us, 0);
+}
+
+void ShmChannel::notify(int event_fd)
+{
+  uint64_t value = 1;
+  while (::write(event_fd, &value, sizeof(value)) < 0 && errno == EINTR) {
+  }
+}
+
+void ShmChannel::drain(int event_fd)
+{
+  uint64_t value = 0;
+  while (::read(event_fd, &value, sizeof(value)) < 0 && errno == EINTR) {
+  }
+}
+
+void ShmChannel::ring_doorbell(int peer_fd)
+{
+  // 套接字缓存满时说明已经有很多没有处理的唤醒，不需要再写
+  const char value = 0;
+  while (send(peer_fd, &value, 1, MSG_DONTWAIT | MSG_NOSIGNAL) < 0 && errno == EINTR) {
+  }
+}
+
+int ShmChannel::drain_doorbell(int peer_fd)
+{
+  char buf[64];
+  while (true) {
+    ssize_t ret = recv(peer_fd, buf, sizeof(buf), MSG_DONTWAIT);
+    if (ret > 0) {
+      continue;
+    }
+    if (ret == 0) {
+      return -1;
+    }
+    if (errno == EINTR) {
+      continue;
+    }
+    return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+  }
+}
+
+int ShmChannel::client_wait(int peer_fd)
+{
+  struct pollfd pfds[2];
+  pfds[0].fd     = fds_[SHM_CLIENT_EVENT_FD];
+  pfds[0].events = POLLIN;
+  pfds[1].fd     = peer_fd;
+  pfds[1].events = POLLIN;
+  while (true) {
+    pfds[0].revents = 0;
+    pfds[1].revents = 0;
+    if (poll(pfds, 2, -1) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return -1;
+    }
+    // 通道建立之后服务端不会再往套接字中写数据，套接字上有事件说明服务端断开了
+    if (pfds[1].revents != 0) {
+      return -1;
+    }
+    if (pfds[0].revents & POLLIN) {
+      drain(fds_[SHM_CLIENT_EVENT_FD]);
+      return 0;
+    }
+  }
+}
+
+int ShmChannel::client_send(const char *data, size_t size, int peer_fd)
+{
+  size_t sent = 0;
+  while (sent < size) {
+    const uint32_t n = request_ring_.write(data + sent, static_cast<uint32_t>(std::min<size_t>(size - sent, UINT32_MAX)));
+    if (n > 0) {
+      sent += n;
+      if (request_ring_.take_reader_waiting()) {
+        ring_doorbell(peer_fd);
+      }
+      continue;
+    }
+    if (request_ring_.prepare_write_wait() && client_wait(peer_fd) < 0) {
+      return -1;
+    }
+  }
+  return 0;
+}
+
+ssize_t ShmChannel::client_recv(char *buf, size_t size, int spin_us, int peer_fd)
+{
+  spin_us = effective_spin_us(spin_us);
+  const auto spin_end = std::chrono::steady_clock::now() + std::chrono::microseconds(spin_us);
+  while (true) {
+    const uint32_t n = response_ring_.read(buf, static_cast<uint32_t>(std::min<size_t>(size, UINT32_MAX)));
+    if (n > 0) {
+      if (response_ring_.take_writer_waiting()) {
+        ring_doorbell(peer_fd);
+      }
+      return n;
+    }
+
+    if (spin_us > 0 && std::chrono::steady_clock::now() < spin_end) {
+      cpu_relax();
+      continue;
+    }
+    if (response_ring_.prepare_read_wait() && client_wait(peer_fd) < 0) {
+      return 0;
+    }
+  }
+}
+
+int send_fds(int sock, const char *data, size_t size, const int *fds, int fd_num)
+{
+  struct iovec iov;
+  iov.iov_base = const_cast<char *>(data);
+  iov.iov_len  = size;
+
+  union {
+    char           buf[CMSG_SPACE(sizeof(int) * SHM_CHANNEL_FD_NUM)];
+    struct cmsghdr align;
+  } control;
+  memset(&control, 0, sizeof(control));
+
+  struct msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov    = &iov;
+  msg.msg_iovlen = 1;
+  if (fd_num > 0) {
+    if (fd_num > SHM_CHANNEL_FD_NUM) {
+      return -1;
+    }
+    msg.msg_control    = control.buf;
+    msg.msg_controllen = CMSG_SPACE(sizeof(int) * fd_num);
+
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level     = SOL_SOCKET;
+    cmsg->cmsg_type      = SCM_RIGHTS;
+    cmsg->cmsg_len       = CMSG_LEN(sizeof(int) * fd_num);
+    memcpy(CMSG_DATA(cmsg), fds, sizeof(int) * fd_num);
+  }
+
+  while (true) {
+    ssize_t ret = sendmsg(sock, &msg, MSG_NOSIGNAL);
+    if (ret >= 0) {
+      return static_cast<size_t>(ret) == size ? 0 : -1;
+    }
+    if (errno != EINTR) {
+      return -1;
+    }
+  }
+}
+
+ssize_t recv_fds(int sock, char *data, size_t size, int *fds, int &fd_num)
+{
+  struct iovec iov;
+  iov.iov_base = data;
+  iov.iov_len  = size;
+
+  union {
+    char           buf[CMSG_SPACE(sizeof(int) * SHM_CHANNEL_FD_NUM)];
+    struct cmsghdr align;
+  } control;
+
+  struct msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov        = &iov;
+  msg.msg_iovlen     = 1;
+  msg.msg_control    = control.buf;
+  msg.msg_controllen = sizeof(control.buf);
+
+  ssize_t ret = 0;
+  do {
+    ret = recvmsg(sock, &msg, MSG_CMSG_CLOEXEC);
+  } while (ret < 0 && errno == EINTR);
+  if (ret < 0) {
+    return -1;
+  }
+
+  const int capacity = fd_num;
+  fd_num = 0;
+  for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+    if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS) {
+      continue;
+    }
+    const int num = static_cast<int>((cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int));
+    int       received[SHM_CHANNEL_FD_NUM];
+    memcpy(received, CMSG_DATA(cmsg), sizeof(int) * std::min<int>(num, SHM_CHANNEL_FD_NUM));
+    for (int i = 0; i < num && i < SHM_CHANNEL_FD_NUM; i++) {
+      if (fd_num < capacity) {
+        fds[fd_num++] = received[i];
+      } else {
+        close(received[i]);
+      }
+    }
+  }
+  return ret;
+}
+
+}  // namespace common
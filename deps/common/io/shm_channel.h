@@ -0,0 +1,184 @@
+#pragma once
+
+#include <stdint.h>
+#include <sys/types.h>
+#include <atomic>
+
+namespace common {
+
+/**
+ * @brief 共享内存中一个单生产者单消费者的字节环的控制信息
+ * @details 读写位置只增不减，对容量取模得到在数据区中的位置。读写位置以及等待标记分别放在不同的缓存行，
+ * 避免生产者与消费者互相干扰。
+ */
+struct ShmRingHeader
+{
+  alignas(64) std::atomic<uint64_t> write_pos{0};
+  alignas(64) std::atomic<uint64_t> read_pos{0};
+  alignas(64) std::atomic<uint32_t> reader_waiting{0};  ///< 消费者读不到数据，准备睡眠
+  std::atomic<uint32_t> writer_waiting{0};              ///< 生产者写不进去，准备睡眠
+};
+
+/**
+ * @brief 共享内存中的字节环，只有一个生产者和一个消费者，读写都不需要系统调用
+ * @details 一方需要睡眠时先设置等待标记再检查一次环，另一方读写之后检查等待标记，
+ * 标记已经设置时才唤醒对方，对方一直在轮询时不会有系统调用
+ */
+class ShmRing
+{
+public:
+  void attach(ShmRingHeader *header, char *data, uint32_t capacity);
+
+  uint32_t capacity() const { return capacity_; }
+  uint32_t readable() const;
+  uint32_t writable() const;
+
+  /**
+   * @brief 生产者写入数据，空间不够时只写一部分
+   * @return 实际写入的字节数
+   */
+  uint32_t write(const char *data, uint32_t size);
+
+  /**
+   * @brief 消费者读取数据
+   * @return 实际读到的字节数，没有数据时返回0
+   */
+  uint32_t read(char *buf, uint32_t size);
+
+  /**
+   * @brief 消费者读不到数据、准备睡眠前调用
+   * @return false 表示设置等待标记的同时有数据到达，不需要睡眠
+   */
+  bool prepare_read_wait();
+  /**
+   * @brief 生产者写不进去、准备睡眠前调用
+   * @return false 表示设置等待标记的同时有空间空出来，不需要睡眠
+   */
+  bool prepare_write_wait();
+
+  /**
+   * @brief 生产者写入数据之后调用，返回 true 表示消费者在睡眠，需要唤醒
+   */
+  bool take_reader_waiting();
+  /**
+   * @brief 消费者读走数据之后调用，返回 true 表示生产者在睡眠，需要唤醒
+   */
+  bool take_writer_waiting();
+
+private:
+  ShmRingHeader *header_   = nullptr;
+  char          *data_     = nullptr;
+  uint32_t       capacity_ = 0;
+};
+
+/**
+ * @brief 共享内存通道中各个描述符的位置
+ */
+enum ShmChannelFd
+{
+  SHM_MEMORY_FD = 0,      ///< 共享内存(memfd)
+  SHM_CLIENT_EVENT_FD,    ///< 客户端等待结果数据或者请求环的空间时睡眠的eventfd
+  SHM_CHANNEL_FD_NUM
+};
+
+/// 客户端通过Unix Socket发送这个请求(以'\0'结尾)申请共享内存通道
+static constexpr const char *SHM_HANDSHAKE_REQUEST = "\x01shm";
+/// 服务端的应答只有一个字节，同意时通过 SCM_RIGHTS 带上通道的描述符
+static constexpr char SHM_HANDSHAKE_ACCEPT = 'Y';
+static constexpr char SHM_HANDSHAKE_REJECT = 'N';
+
+/**
+ * @brief 同一台机器上客户端与服务端之间的共享内存通道
+ * @details 一块memfd内存中有请求环与结果环，各自只有一个生产者和一个消费者。
+ * 服务端创建通道，通过Unix Socket把描述符发给客户端，之后请求与结果都只经过共享内存。
+ * 对端在轮询时读写不需要系统调用，只有对端已经睡眠时才需要唤醒：客户端在eventfd上睡眠；
+ * 服务端仍然在libevent中等待Unix Socket可读，客户端往套接字中写一个字节唤醒它，
+ * 这样客户端断开时服务端也能立即发现。
+ * @note 函数返回0表示成功，-1表示失败，与 common/io/io.h 相同
+ */
+class ShmChannel
+{
+public:
+  ShmChannel() = default;
+  ~ShmChannel();
+
+  ShmChannel(const ShmChannel &) = delete;
+  ShmChannel &operator=(const ShmChannel &) = delete;
+
+  /**
+   * @brief 服务端创建通道
+   * @param ring_size 每个环的容量
+   */
+  int create(uint32_t ring_size);
+
+  /**
+   * @brief 客户端使用服务端发过来的描述符打开通道，描述符由通道负责关闭
+   */
+  int attach(const int fds[SHM_CHANNEL_FD_NUM]);
+
+  int fd(ShmChannelFd which) const { return fds_[which]; }
+
+  ShmRing &request_ring() { return request_ring_; }
+  ShmRing &response_ring() { return response_ring_; }
+
+  /**
+   * @brief 客户端发送全部数据，请求环满时等待服务端读走
+   * @param peer_fd 与服务端的Unix Socket，等待时用来发现服务端断开
+   */
+  int client_send(const char *data, size_t size, int peer_fd);
+
+  /**
+   * @brief 客户端读取结果，没有数据时先轮询 spin_us 微秒再睡眠
+   * @return 读到的字节数，服务端断开时返回0，出错时返回-1
+   */
+  ssize_t client_recv(char *buf, size_t size, int spin_us, int peer_fd);
+
+  /**
+   * @brief 实际使用的轮询时间
+   * @details 只有一个CPU时对端要等轮询的一方让出CPU才能执行，轮询只会增加延迟，直接睡眠
+   */
+  static int effective_spin_us(int spin_us);
+
+  /// 唤醒在eventfd上睡眠的客户端
+  static void notify(int event_fd);
+  /// 清除eventfd上的计数，醒来之后调用
+  static void drain(int event_fd);
+
+  /// 往套接字中写一个字节，唤醒在套接字上等待的服务端
+  static void ring_doorbell(int peer_fd);
+  /**
+   * @brief 读走套接字中唤醒用的字节
+   * @return 对端已经断开时返回-1
+   */
+  static int drain_doorbell(int peer_fd);
+
+private:
+  /**
+   * @brief 客户端睡眠，直到eventfd被唤醒或者服务端断开
+   * @return 服务端断开时返回-1
+   */
+  int client_wait(int peer_fd);
+
+  void map_rings();
+
+private:
+  int      fds_[SHM_CHANNEL_FD_NUM] = {-1, -1};
+  char    *memory_      = nullptr;
+  size_t   memory_size_ = 0;
+  ShmRing  request_ring_;
+  ShmRing  response_ring_;
+};
+
+/**
+ * @brief 通过Unix Socket发送数据并附带描述符
+ */
+int send_fds(int sock, const char *data, size_t size, const int *fds, int fd_num);
+
+/**
+ * @brief 通过Unix Socket接收数据以及附带的描述符
+ * @param fd_num 传入fds的容量，返回收到的描述符个数
+ * @return 收到的字节数，出错时返回-1
+ */
+ssize_t recv_fds(int sock, char *data, size_t size, int *fds, int &fd_num);
+
+}  // namespace common
@@ -23,7 +23,8 @@ int compare_int(void *arg1, void *arg2)
 {
   int v1 = *(int *)arg1;
   int v2 = *(int *)arg2;
-  return v1 - v2;
+  // 直接相减在两个值的符号不同时可能溢出
+  return v1 < v2 ? -1 : (v1 > v2 ? 1 : 0);
 }
 
 int compare_float(void *arg1, void *arg2)
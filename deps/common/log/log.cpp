@@ -17,6 +17,10 @@ See the Mulan PSL v2 for more details. */
 #include <stdarg.h>
 #include <stdio.h>
 #include <execinfo.h>
+#include <time.h>
+
+#include <algorithm>
+#include <chrono>
 
 #include "common/lang/string.h"
 #include "common/log/log.h"
@@ -24,6 +28,117 @@ namespace common {
 
 Log *g_log = nullptr;
 
+/**
+ * @brief 一个线程的日志缓存
+ * @details 单生产者单消费者的环形缓存。只有所属线程追加数据，只有持有 Log::lock_ 的线程把数据写到文件。
+ * 线程退出时把缓存标记为关闭，写完剩余的数据后由 Log 释放。
+ */
+class LogLineBuffer
+{
+public:
+  explicit LogLineBuffer(size_t capacity) : data_(new char[capacity]), capacity_(capacity)
+  {}
+
+  size_t capacity() const { return capacity_; }
+  size_t used() const
+  {
+    return write_pos_.load(std::memory_order_relaxed) - read_pos_.load(std::memory_order_acquire);
+  }
+
+  /// 空间不够时什么都不写，返回false
+  bool append(const char *data, size_t size)
+  {
+    const uint64_t write_pos = write_pos_.load(std::memory_order_relaxed);
+    const uint64_t read_pos  = read_pos_.load(std::memory_order_acquire);
+    if (capacity_ - (write_pos - read_pos) < size) {
+      return false;
+    }
+
+    const size_t offset = write_pos % capacity_;
+    const size_t first  = std::min(size, capacity_ - offset);
+    memcpy(data_.get() + offset, data, first);
+    memcpy(data_.get(), data + first, size - first);
+    write_pos_.store(write_pos + size, std::memory_order_release);
+    return true;
+  }
+
+  /// 把缓存中的数据写到 os 中，返回写出的行数
+  int drain(std::ostream &os)
+  {
+    const uint64_t write_pos = write_pos_.load(std::memory_order_acquire);
+    const uint64_t read_pos  = read_pos_.load(std::memory_order_relaxed);
+    if (write_pos == read_pos) {
+      return 0;
+    }
+
+    const size_t size   = write_pos - read_pos;
+    const size_t offset = read_pos % capacity_;
+    const size_t first  = std::min(size, capacity_ - offset);
+    const char  *data   = data_.get();
+    os.write(data + offset, first);
+    os.write(data, size - first);
+    const int lines = static_cast<int>(std::count(data + offset, data + offset + first, '\n') +
+                                       std::count(data, data + size - first, '\n'));
+    read_pos_.store(write_pos, std::memory_order_release);
+    return lines;
+  }
+
+  void close() { closed_.store(true, std::memory_order_release); }
+  bool closed() const { return closed_.load(std::memory_order_acquire); }
+
+private:
+  std::unique_ptr<char[]> data_;
+  const size_t            capacity_;
+  std::atomic<uint64_t>   write_pos_{0};
+  std::atomic<uint64_t>   read_pos_{0};
+  std::atomic<bool>       closed_{false};
+};
+
+namespace {
+
+/**
+ * @brief 线程持有的日志缓存，线程退出时通知 Log 回收
+ */
+struct LogThreadBuffer
+{
+  uint64_t                   log_id = 0;
+  std::shared_ptr<LogLineBuffer> buffer;
+
+  ~LogThreadBuffer()
+  {
+    if (buffer) {
+      buffer->close();
+    }
+  }
+};
+
+/**
+ * @brief 每个线程缓存的当前时间，秒数不变时不用再调用 localtime
+ */
+struct LogClock
+{
+  time_t    seconds = -1;
+  struct tm tm;
+  char      text[32];  ///< YYYY-MM-DD HH:MM:SS
+
+  const LogClock &refresh(time_t now)
+  {
+    if (now != seconds) {
+      localtime_r(&now, &tm);
+      snprintf(text, sizeof(text), "%04d-%02d-%02d %02d:%02d:%02d",
+               tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec);
+      seconds = now;
+    }
+    return *this;
+  }
+};
+
+thread_local LogThreadBuffer thread_log_buffer;
+thread_local LogClock        thread_log_clock;
+std::atomic<uint64_t>        log_id_generator{0};
+
+}  // namespace
+
 Log::Log(const std::string &log_file_name, const LOG_LEVEL log_level, const LOG_LEVEL console_level)
     : log_name_(log_file_name), log_level_(log_level), console_level_(console_level)
 {
@@ -46,11 +161,16 @@ Log::Log(const std::string &log_file_name, const LOG_LEVEL log_level, const LOG_
   check_param_valid();
 
   context_getter_ = []() { return 0; };
+
+  id_ = ++log_id_generator;
 }
 
 Log::~Log(void)
 {
+  stop_async();
+
   pthread_mutex_lock(&lock_);
+  flush_locked();
   if (ofs_.is_open()) {
     ofs_.close();
   }
@@ -85,7 +205,6 @@ bool Log::check_output(const LOG_LEVEL level, const char *module)
 
 int Log::output(const LOG_LEVEL level, const char *module, const char *prefix, const char *f, ...)
 {
-  bool locked = false;
   try {
     va_list args;
     char msg[ONE_KILO];
@@ -101,31 +220,11 @@ int Log::output(const LOG_LEVEL level, const char *module, const char *prefix, c
     }
 
     if (LOG_LEVEL_PANIC <= level && level <= log_level_) {
-      pthread_mutex_lock(&lock_);
-      locked = true;
-      ofs_ << prefix;
-      ofs_ << msg;
-      ofs_ << "\n";
-      ofs_.flush();
-      log_line_++;
-      pthread_mutex_unlock(&lock_);
-      locked = false;
+      return write(level, prefix, msg);
     } else if (default_set_.find(module) != default_set_.end()) {
-      pthread_mutex_lock(&lock_);
-      locked = true;
-      ofs_ << prefix;
-      ofs_ << msg;
-      ofs_ << "\n";
-      ofs_.flush();
-      log_line_++;
-      pthread_mutex_unlock(&lock_);
-      locked = false;
+      return write(level, prefix, msg);
     }
-
   } catch (std::exception &e) {
-    if (locked) {
-      pthread_mutex_unlock(&lock_);
-    }
     std::cerr << e.what() << std::endl;
     return LOG_STATUS_ERR;
   }
@@ -133,6 +232,150 @@ int Log::output(const LOG_LEVEL level, const char *module, const char *prefix, c
   return LOG_STATUS_OK;
 }
 
+int Log::write(const LOG_LEVEL level, const char *prefix, const char *msg)
+{
+  if (async() && level > LOG_LEVEL_ERR) {
+    // prefix 和 msg 都不超过 ONE_KILO
+    char         line[2 * ONE_KILO + 1];
+    const size_t prefix_len = strlen(prefix);
+    const size_t msg_len    = strlen(msg);
+    memcpy(line, prefix, prefix_len);
+    memcpy(line + prefix_len, msg, msg_len);
+    line[prefix_len + msg_len] = '\n';
+    const size_t line_len      = prefix_len + msg_len + 1;
+
+    LogLineBuffer *buffer = thread_buffer();
+    bool       done   = buffer->append(line, line_len);
+    if (!done) {
+      // 后台线程跟不上，当前线程自己写文件
+      flush();
+      done = buffer->append(line, line_len);
+    }
+    if (done) {
+      if (buffer->used() >= buffer->capacity() / 2 && !flush_requested_.exchange(true)) {
+        async_cond_.notify_one();
+      }
+      return LOG_STATUS_OK;
+    }
+  }
+
+  // 同步输出前先把缓存中的日志写出去，保证同一个线程的日志是有序的
+  pthread_mutex_lock(&lock_);
+  flush_locked();
+  ofs_ << prefix;
+  ofs_ << msg;
+  ofs_ << "\n";
+  ofs_.flush();
+  log_line_++;
+  pthread_mutex_unlock(&lock_);
+  return LOG_STATUS_OK;
+}
+
+LogLineBuffer *Log::thread_buffer()
+{
+  LogThreadBuffer &thread_buffer = thread_log_buffer;
+  if (thread_buffer.buffer && thread_buffer.log_id == id_) {
+    return thread_buffer.buffer.get();
+  }
+
+  if (thread_buffer.buffer) {
+    thread_buffer.buffer->close();
+  }
+  thread_buffer.buffer = std::make_shared<LogLineBuffer>(LOG_THREAD_BUFFER_SIZE);
+  thread_buffer.log_id = id_;
+
+  pthread_mutex_lock(&lock_);
+  buffers_.push_back(thread_buffer.buffer);
+  pthread_mutex_unlock(&lock_);
+  return thread_buffer.buffer.get();
+}
+
+int Log::start_async(int flush_interval_ms)
+{
+  std::lock_guard<std::mutex> guard(async_mutex_);
+  if (async_thread_.joinable()) {
+    return LOG_STATUS_OK;
+  }
+
+  async_stop_ = false;
+  async_thread_ = std::thread(&Log::async_flush_loop, this, std::max(flush_interval_ms, 1));
+  async_.store(true);
+  return LOG_STATUS_OK;
+}
+
+void Log::stop_async()
+{
+  {
+    std::lock_guard<std::mutex> guard(async_mutex_);
+    if (!async_thread_.joinable()) {
+      return;
+    }
+    async_.store(false);
+    async_stop_ = true;
+  }
+  async_cond_.notify_all();
+  async_thread_.join();
+  flush();
+}
+
+void Log::async_flush_loop(int flush_interval_ms)
+{
+  std::unique_lock<std::mutex> guard(async_mutex_);
+  while (!async_stop_) {
+    async_cond_.wait_for(guard, std::chrono::milliseconds(flush_interval_ms), [this]() {
+      return async_stop_ || flush_requested_.load();
+    });
+    flush_requested_.store(false);
+
+    guard.unlock();
+    flush();
+    guard.lock();
+  }
+}
+
+void Log::flush()
+{
+  pthread_mutex_lock(&lock_);
+  flush_locked();
+  pthread_mutex_unlock(&lock_);
+}
+
+void Log::flush_locked()
+{
+  rotate_locked();
+
+  int lines = 0;
+  for (auto iter = buffers_.begin(); iter != buffers_.end();) {
+    LogLineBuffer &buffer = **iter;
+    // 先看是否关闭再取数据，关闭之后所属线程不会再写
+    const bool closed = buffer.closed();
+    lines += buffer.drain(ofs_);
+    if (closed) {
+      iter = buffers_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+
+  if (lines > 0) {
+    ofs_.flush();
+    log_line_ += lines;
+  }
+}
+
+void Log::format_head(char *head, size_t size)
+{
+  struct timeval tv;
+  gettimeofday(&tv, nullptr);
+  const LogClock &clock = thread_log_clock.refresh(tv.tv_sec);
+  snprintf(head, size, "%s.%06d pid:%u tid:%llx ctx:%lx",
+           clock.text,
+           (int)tv.tv_usec,
+           (int32_t)getpid(),
+           gettid(),
+           context_id());
+}
+
 int Log::set_console_level(LOG_LEVEL console_level)
 {
   if (LOG_LEVEL_PANIC <= console_level && console_level < LOG_LEVEL_LAST) {
@@ -313,6 +556,16 @@ int Log::rotate(const int year, const int month, const int day)
   return result;
 }
 
+void Log::rotate_locked()
+{
+  if (rotate_type_ == LOG_ROTATE_BYDAY) {
+    const LogClock &clock = thread_log_clock.refresh(time(nullptr));
+    rotate_by_day(clock.tm.tm_year + 1900, clock.tm.tm_mon + 1, clock.tm.tm_mday);
+  } else {
+    rotate_by_size();
+  }
+}
+
 void Log::set_context_getter(std::function<intptr_t()> context_getter)
 {
   if (context_getter) {
@@ -363,6 +616,19 @@ int LoggerFactory::init_default(
   return init(log_file, &g_log, log_level, console_level, rotate_type);
 }
 
+bool LogRateLimiter::allow(uint64_t &suppressed)
+{
+  const int64_t now = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+  int64_t next = next_us_.load(std::memory_order_relaxed);
+  if (now < next || !next_us_.compare_exchange_strong(next, now + interval_us_)) {
+    suppressed_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  suppressed = suppressed_.exchange(0, std::memory_order_relaxed);
+  return true;
+}
+
 const char *lbt()
 {
   constexpr int buffer_size = 100;
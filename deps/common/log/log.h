@@ -20,12 +20,18 @@ See the Mulan PSL v2 for more details. */
 #include <pthread.h>
 #include <string.h>
 
+#include <atomic>
+#include <condition_variable>
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <functional>
+#include <thread>
+#include <vector>
 
 #include "common/defs.h"
 
@@ -37,6 +43,8 @@ const unsigned int FILENAME_LENGTH_MAX = 256;  // the max filename length
 const int LOG_STATUS_OK = 0;
 const int LOG_STATUS_ERR = 1;
 const int LOG_MAX_LINE = 100000;
+const int LOG_THREAD_BUFFER_SIZE = 128 * ONE_KILO;    ///< 异步输出时每个线程的日志缓存大小
+const int LOG_ASYNC_FLUSH_INTERVAL_MS = 100;        ///< 异步输出时后台线程最长多久写一次文件
 
 typedef enum {
   LOG_LEVEL_PANIC = 0,
@@ -50,6 +58,21 @@ typedef enum {
 
 typedef enum { LOG_ROTATE_BYDAY = 0, LOG_ROTATE_BYSIZE, LOG_ROTATE_LAST } LOG_ROTATE;
 
+/**
+ * @brief 编译期保留的最高日志级别
+ * @details 高于这个级别的 LOG_XXX 在编译期就被判定为不输出，运行时既不检查级别也不计算参数。
+ * 默认调试版本保留全部级别，其它版本保留到 INFO。可以在编译时通过 -DLOG_COMPILE_LEVEL=n 修改。
+ */
+#ifndef LOG_COMPILE_LEVEL
+#ifdef DEBUG
+#define LOG_COMPILE_LEVEL 5
+#else
+#define LOG_COMPILE_LEVEL 3
+#endif
+#endif
+
+class LogLineBuffer;
+
 class Log 
 {
 public:
@@ -109,6 +132,25 @@ public:
 
   int rotate(const int year = 0, const int month = 0, const int day = 0);
 
+  /**
+   * @brief 打开异步输出
+   * @details 打开后各线程把格式化好的日志追加到自己的缓存中，不再竞争锁和写文件，由后台线程批量写到文件。
+   * 缓存写满时当前线程会同步地把所有缓存写出去，所以不会丢日志。ERROR 和 PANIC 级别的日志总是同步写。
+   */
+  int start_async(int flush_interval_ms = LOG_ASYNC_FLUSH_INTERVAL_MS);
+  /// 停止后台线程并把缓存中的日志都写到文件中
+  void stop_async();
+  bool async() const { return async_.load(std::memory_order_relaxed); }
+
+  /// 把各线程缓存中的日志写到文件中
+  void flush();
+
+  /**
+   * @brief 生成日志头，包括时间、进程、线程和上下文信息
+   * @details 每个线程缓存了精确到秒的时间字符串，同一秒内的日志不再调用 localtime。
+   */
+  void format_head(char *head, size_t size);
+
   /**
    * @brief 设置一个在日志中打印当前上下文信息的回调函数
    * @details 比如设置一个获取当前session标识的函数，那么每次在打印日志时都会输出session信息。
@@ -124,6 +166,14 @@ private:
   int rename_old_logs();
   int rotate_by_day(const int year, const int month, const int day);
 
+  /// 以下函数需要持有 lock_
+  void rotate_locked();
+  void flush_locked();
+
+  int write(const LOG_LEVEL level, const char *prefix, const char *msg);
+  LogLineBuffer *thread_buffer();
+  void async_flush_loop(int flush_interval_ms);
+
   template <class T>
   int out(const LOG_LEVEL console_level, const LOG_LEVEL log_level, T &message);
 
@@ -151,6 +201,36 @@ private:
   DefaultSet default_set_;
 
   std::function<intptr_t()> context_getter_;
+
+  uint64_t id_;  ///< 用来区分线程缓存属于哪个 Log 对象
+
+  std::atomic<bool> async_{false};
+  std::atomic<bool> flush_requested_{false};
+  bool async_stop_ = false;
+  std::thread async_thread_;
+  std::mutex async_mutex_;
+  std::condition_variable async_cond_;
+  std::vector<std::shared_ptr<LogLineBuffer>> buffers_;  ///< 各线程的日志缓存，由 lock_ 保护
+};
+
+/**
+ * @brief 限制一个日志位置的输出频率
+ * @details 每个 LOG_XXX_LIMITED 所在的位置有一个静态的限流器，interval_ms 内只放过一条日志，
+ * 其余的只计数，被跳过的条数附在下一条放过的日志后面。
+ */
+class LogRateLimiter
+{
+public:
+  explicit LogRateLimiter(int interval_ms) : interval_us_(static_cast<int64_t>(interval_ms) * 1000)
+  {}
+
+  /// 返回 true 表示这一条可以输出，suppressed 返回上一条输出之后被跳过的条数
+  bool allow(uint64_t &suppressed);
+
+private:
+  const int64_t         interval_us_;
+  std::atomic<int64_t>  next_us_{0};
+  std::atomic<uint64_t> suppressed_{0};
 };
 
 class LoggerFactory {
@@ -175,26 +255,8 @@ extern Log *g_log;
 
 #define LOG_HEAD(prefix, level)                                            \
   if (common::g_log) {                                                     \
-    struct timeval tv;                                                     \
-    gettimeofday(&tv, NULL);                                               \
-    struct tm *p = localtime(&tv.tv_sec);                                  \
-    char sz_head[LOG_HEAD_SIZE] = {0};                                     \
-    if (p) {                                                               \
-      int usec = (int)tv.tv_usec;                                          \
-      snprintf(sz_head, LOG_HEAD_SIZE,                                     \
-          "%04d-%02d-%02d %02d:%02d:%02u.%06d pid:%u tid:%llx ctx:%lx",    \
-          p->tm_year + 1900,                                               \
-          p->tm_mon + 1,                                                   \
-          p->tm_mday,                                                      \
-          p->tm_hour,                                                      \
-          p->tm_min,                                                       \
-          p->tm_sec,                                                       \
-          usec,                                                            \
-          (int32_t)getpid(),                                               \
-          gettid(),                                                        \
-          common::g_log->context_id());                                    \
-      common::g_log->rotate(p->tm_year + 1900, p->tm_mon + 1, p->tm_mday); \
-    }                                                                      \
+    char sz_head[LOG_HEAD_SIZE];                                           \
+    common::g_log->format_head(sz_head, sizeof(sz_head));                  \
     snprintf(prefix,                                                       \
         sizeof(prefix),                                                    \
         "[%s %s %s@%s:%u] >> ",                                            \
@@ -206,14 +268,36 @@ extern Log *g_log;
         );                                                                 \
   }
 
-#define LOG_OUTPUT(level, fmt, ...)                                    \
-  do {                                                                 \
-    using namespace common;                                            \
-    if (g_log && g_log->check_output(level, __FILE_NAME__)) {          \
-      char prefix[ONE_KILO] = {0};                                     \
-      LOG_HEAD(prefix, level);                                         \
-      g_log->output(level, __FILE_NAME__, prefix, fmt, ##__VA_ARGS__); \
-    }                                                                  \
+#define LOG_OUTPUT(level, fmt, ...)                                                                  \
+  do {                                                                                               \
+    using namespace common;                                                                          \
+    if (g_log && (level) <= LOG_COMPILE_LEVEL && g_log->check_output(level, __FILE_NAME__)) {        \
+      char prefix[ONE_KILO];                                                                         \
+      LOG_HEAD(prefix, level);                                                                       \
+      g_log->output(level, __FILE_NAME__, prefix, fmt, ##__VA_ARGS__);                               \
+    }                                                                                                \
+  } while (0)
+
+/**
+ * 热点路径上使用的限流日志，同一个位置每 interval_ms 毫秒最多输出一条
+ */
+#define LOG_OUTPUT_LIMITED(level, interval_ms, fmt, ...)                                                      \
+  do {                                                                                                        \
+    using namespace common;                                                                                   \
+    if (g_log && (level) <= LOG_COMPILE_LEVEL && g_log->check_output(level, __FILE_NAME__)) {                 \
+      static LogRateLimiter log_rate_limiter(interval_ms);                                                    \
+      uint64_t suppressed = 0;                                                                                \
+      if (log_rate_limiter.allow(suppressed)) {                                                               \
+        char prefix[ONE_KILO];                                                                                \
+        LOG_HEAD(prefix, level);                                                                              \
+        if (suppressed > 0) {                                                                                 \
+          g_log->output(level, __FILE_NAME__, prefix, fmt " (%llu similar suppressed)", ##__VA_ARGS__,        \
+                        static_cast<unsigned long long>(suppressed));                                         \
+        } else {                                                                                              \
+          g_log->output(level, __FILE_NAME__, prefix, fmt, ##__VA_ARGS__);                                    \
+        }                                                                                                     \
+      }                                                                                                       \
+    }                                                                                                         \
   } while (0)
 
 #define LOG_DEFAULT(fmt, ...) LOG_OUTPUT(common::g_log->get_log_level(), fmt, ##__VA_ARGS__)
@@ -224,6 +308,11 @@ extern Log *g_log;
 #define LOG_DEBUG(fmt, ...) LOG_OUTPUT(common::LOG_LEVEL_DEBUG, fmt, ##__VA_ARGS__)
 #define LOG_TRACE(fmt, ...) LOG_OUTPUT(common::LOG_LEVEL_TRACE, fmt, ##__VA_ARGS__)
 
+#define LOG_WARN_LIMITED(interval_ms, fmt, ...) LOG_OUTPUT_LIMITED(common::LOG_LEVEL_WARN, interval_ms, fmt, ##__VA_ARGS__)
+#define LOG_INFO_LIMITED(interval_ms, fmt, ...) LOG_OUTPUT_LIMITED(common::LOG_LEVEL_INFO, interval_ms, fmt, ##__VA_ARGS__)
+#define LOG_DEBUG_LIMITED(interval_ms, fmt, ...) \
+  LOG_OUTPUT_LIMITED(common::LOG_LEVEL_DEBUG, interval_ms, fmt, ##__VA_ARGS__)
+
 template <class T>
 Log &Log::operator<<(T msg)
 {
@@ -286,6 +375,7 @@ int Log::out(const LOG_LEVEL console_level, const LOG_LEVEL log_level, T &msg)
     if (LOG_LEVEL_PANIC <= log_level && log_level <= log_level_) {
       pthread_mutex_lock(&lock_);
       locked = true;
+      flush_locked();
       ofs_ << prefix;
       ofs_ << msg;
       ofs_.flush();
@@ -0,0 +1,315 @@
+//
+// 连接数压测工具：通过本机回环地址建立大量连接，统计建立连接的速度与服务端每个连接占用的内存
+//
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define PORT_DEFAULT 6789
+
+struct BenchOptions
+{
+  const char *host        = "127.0.0.1";
+  int         port        = PORT_DEFAULT;
+  int         connections = 10000;  ///< 建立的连接数
+  int         in_flight   = 256;    ///< 同时正在建立的连接数
+  int         server_pid  = 0;      ///< 服务端进程号，用来统计服务端的内存
+  int         idle_ms     = 1000;   ///< 连接都建立之后空闲的时间
+  const char *sql         = "help;";
+};
+
+/// 一个连接的状态
+struct Connection
+{
+  int    fd   = -1;
+  size_t sent = 0;      ///< 请求已经发送的字节数
+  bool   done = false;  ///< 已经收到完整的结果
+};
+
+static long server_rss_kb(int pid)
+{
+  if (pid <= 0) {
+    return -1;
+  }
+  std::string path = "/proc/" + std::to_string(pid) + "/status";
+  FILE *file = fopen(path.c_str(), "r");
+  if (file == nullptr) {
+    return -1;
+  }
+  char line[256];
+  long rss = -1;
+  while (fgets(line, sizeof(line), file) != nullptr) {
+    if (strncmp(line, "VmRSS:", 6) == 0) {
+      rss = atol(line + 6);
+      break;
+    }
+  }
+  fclose(file);
+  return rss;
+}
+
+static void raise_open_files_limit(int connections)
+{
+  struct rlimit limit;
+  if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+    limit.rlim_cur = limit.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &limit);
+  }
+  if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY &&
+      limit.rlim_cur < static_cast<rlim_t>(connections) + 16) {
+    fprintf(stderr, "warning: open files limit %lu is less than %d connections\n",
+        (unsigned long)limit.rlim_cur, connections);
+  }
+}
+
+static int start_connect(const struct sockaddr_in &addr)
+{
+  int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+  if (fd < 0) {
+    fprintf(stderr, "create socket error. errmsg=%d:%s\n", errno, strerror(errno));
+    return -1;
+  }
+  int yes = 1;
+  setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+  if (connect(fd, (const struct sockaddr *)&addr, sizeof(addr)) < 0 && errno != EINPROGRESS) {
+    fprintf(stderr, "failed to connect. errmsg=%d:%s\n", errno, strerror(errno));
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+/**
+ * @brief 发送请求并读取结果，返回 false 表示连接出错
+ * @details 请求与结果都以 '\0' 结尾，结果读完之后 done 为 true
+ */
+static bool process(Connection &conn, const std::string &request)
+{
+  while (conn.sent < request.size()) {
+    ssize_t n = write(conn.fd, request.data() + conn.sent, request.size() - conn.sent);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return errno == EAGAIN || errno == EINPROGRESS;
+    }
+    conn.sent += n;
+  }
+
+  char buf[4096];
+  while (true) {
+    ssize_t n = read(conn.fd, buf, sizeof(buf));
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return errno == EAGAIN;
+    }
+    if (n == 0) {
+      return false;
+    }
+    if (memchr(buf, 0, n) != nullptr) {
+      conn.done = true;
+      return true;
+    }
+  }
+}
+
+/**
+ * @brief 在所有连接上各执行一次请求，等待全部完成
+ * @param connect_new 是否需要先建立连接，此时最多同时建立 in_flight 个连接
+ * @return 失败的连接个数
+ */
+static int run_round(const BenchOptions &options, const struct sockaddr_in &addr, std::vector<Connection> &conns,
+    bool connect_new)
+{
+  int epfd = epoll_create1(0);
+  if (epfd < 0) {
+    fprintf(stderr, "epoll_create1 error. errmsg=%d:%s\n", errno, strerror(errno));
+    return static_cast<int>(conns.size());
+  }
+
+  std::string request(options.sql);
+  request.push_back('\0');
+
+  size_t next     = 0;
+  int    active   = 0;
+  int    finished = 0;
+  int    failures = 0;
+  const int total = static_cast<int>(conns.size());
+
+  auto finish = [&](size_t index, bool ok) {
+    epoll_ctl(epfd, EPOLL_CTL_DEL, conns[index].fd, nullptr);
+    if (!ok) {
+      failures++;
+      close(conns[index].fd);
+      conns[index].fd = -1;
+    }
+    active--;
+    finished++;
+  };
+
+  auto launch = [&](size_t index) {
+    Connection &conn = conns[index];
+    conn.sent = 0;
+    conn.done = false;
+    if (connect_new) {
+      conn.fd = start_connect(addr);
+    }
+    if (conn.fd < 0) {
+      failures++;
+      finished++;
+      return;
+    }
+    struct epoll_event ev;
+    ev.events   = EPOLLIN | EPOLLOUT | EPOLLET;
+    ev.data.u64 = index;
+    epoll_ctl(epfd, EPOLL_CTL_ADD, conn.fd, &ev);
+    active++;
+  };
+
+  std::vector<struct epoll_event> events(1024);
+  while (finished < total) {
+    // 建立连接时限制同时进行中的个数，避免超过服务端的 backlog
+    const int limit = connect_new ? options.in_flight : total;
+    while (next < conns.size() && active < limit) {
+      launch(next++);
+    }
+
+    int n = epoll_wait(epfd, events.data(), static_cast<int>(events.size()), 5000);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      fprintf(stderr, "epoll_wait error. errmsg=%d:%s\n", errno, strerror(errno));
+      break;
+    }
+    if (n == 0) {
+      fprintf(stderr, "timeout: %d connections are still waiting\n", active);
+      break;
+    }
+    for (int i = 0; i < n; i++) {
+      const size_t index = events[i].data.u64;
+      Connection  &conn  = conns[index];
+      if (conn.fd < 0 || conn.done) {
+        continue;
+      }
+      if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+        finish(index, false);
+        continue;
+      }
+      bool ok = process(conn, request);
+      if (!ok || conn.done) {
+        finish(index, ok);
+      }
+    }
+  }
+  close(epfd);
+  return failures + (total - finished);
+}
+
+static void usage(const char *name)
+{
+  printf("Usage: %s [-h host] [-p port] [-c connections] [-f connections_in_flight] [-s server_pid]\n"
+         "          [-i idle_ms] [-q sql]\n",
+      name);
+}
+
+int main(int argc, char *argv[])
+{
+  BenchOptions options;
+  int          opt;
+  while ((opt = getopt(argc, argv, "h:p:c:f:s:i:q:")) > 0) {
+    switch (opt) {
+      case 'h': options.host = optarg; break;
+      case 'p': options.port = atoi(optarg); break;
+      case 'c': options.connections = std::max(atoi(optarg), 1); break;
+      case 'f': options.in_flight = std::max(atoi(optarg), 1); break;
+      case 's': options.server_pid = atoi(optarg); break;
+      case 'i': options.idle_ms = std::max(atoi(optarg), 0); break;
+      case 'q': options.sql = optarg; break;
+      default: usage(argv[0]); return 1;
+    }
+  }
+
+  raise_open_files_limit(options.connections);
+
+  struct hostent *host = gethostbyname(options.host);
+  if (host == nullptr) {
+    fprintf(stderr, "gethostbyname failed. errmsg=%d:%s\n", errno, strerror(errno));
+    return 1;
+  }
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_port   = htons(options.port);
+  addr.sin_addr   = *((struct in_addr *)host->h_addr);
+
+  std::vector<Connection> conns(options.connections);
+  const long rss_before = server_rss_kb(options.server_pid);
+
+  // 1. 建立连接，每个连接执行一次请求，说明连接已经被服务端接收并且可以处理请求
+  auto begin = std::chrono::steady_clock::now();
+  int failures = run_round(options, addr, conns, true);
+  double connect_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+  const int established = options.connections - failures;
+  printf("connections=%d established=%d elapsed=%.3fs accept_rate=%.1f conn/s\n",
+      options.connections,
+      established,
+      connect_seconds,
+      connect_seconds > 0 ? established / connect_seconds : 0.0);
+
+  // 2. 连接都空闲一段时间之后统计服务端的内存
+  std::this_thread::sleep_for(std::chrono::milliseconds(options.idle_ms));
+  const long rss_idle = server_rss_kb(options.server_pid);
+  if (rss_before >= 0 && rss_idle >= 0 && established > 0) {
+    printf("server rss before=%ldKB idle=%ldKB per_connection=%.2fKB\n",
+        rss_before,
+        rss_idle,
+        static_cast<double>(rss_idle - rss_before) / established);
+  }
+
+  // 3. 所有空闲的连接同时再执行一次请求
+  std::vector<Connection> alive;
+  for (const Connection &conn : conns) {
+    if (conn.fd >= 0) {
+      alive.push_back(conn);
+    }
+  }
+  begin = std::chrono::steady_clock::now();
+  int sweep_failures = run_round(options, addr, alive, false);
+  double sweep_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+  printf("sweep requests=%zu failures=%d elapsed=%.3fs throughput=%.1f req/s\n",
+      alive.size(),
+      sweep_failures,
+      sweep_seconds,
+      sweep_seconds > 0 ? (alive.size() - sweep_failures) / sweep_seconds : 0.0);
+  const long rss_sweep = server_rss_kb(options.server_pid);
+  if (rss_sweep >= 0) {
+    printf("server rss after sweep=%ldKB\n", rss_sweep);
+  }
+
+  for (const Connection &conn : alive) {
+    if (conn.fd >= 0) {
+      close(conn.fd);
+    }
+  }
+  return failures == 0 && sweep_failures == 0 ? 0 : 1;
+}
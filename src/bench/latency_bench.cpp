@@ -0,0 +1,308 @@
+//
+// 往返延迟压测工具：一个连接依次发送同一个点查询，统计每个请求的往返延迟。
+// 可以分别使用TCP、Unix Socket以及Unix Socket上申请的共享内存通道，比较通讯层的开销。
+// 使用 --reconnect 时每个请求都重新建立连接，统计建立连接加上第一个请求的延迟，模拟短连接的客户端
+//
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <getopt.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/io/shm_channel.h"
+
+#define PORT_DEFAULT 6789
+
+struct BenchOptions
+{
+  const char *host             = "127.0.0.1";
+  int         port             = PORT_DEFAULT;
+  const char *unix_socket_path = nullptr;
+  bool        shm              = false;  ///< 是否申请共享内存通道，需要使用Unix Socket
+  int         spin_us          = 200;    ///< 共享内存通道上等待结果时先轮询的时间
+  int         requests         = 10000;  ///< 统计的请求个数
+  int         warmup           = 1000;   ///< 预热的请求个数，不统计
+  const char *sql              = "select * from bench_point where id = 1;";
+  bool        setup            = true;   ///< 是否创建测试表
+  bool        reconnect        = false;  ///< 每个请求都重新建立连接
+};
+
+/// 一个连接，打开共享内存通道之后请求与结果都经过共享内存
+struct Connection
+{
+  int                                 fd = -1;
+  std::unique_ptr<common::ShmChannel> shm;
+  int                                 spin_us = 0;
+
+  ~Connection()
+  {
+    shm.reset();
+    if (fd >= 0) {
+      close(fd);
+    }
+  }
+
+  bool send_all(const std::string &data)
+  {
+    if (shm != nullptr) {
+      return shm->client_send(data.data(), data.size(), fd) == 0;
+    }
+    size_t sent = 0;
+    while (sent < data.size()) {
+      ssize_t n = write(fd, data.data() + sent, data.size() - sent);
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      if (n <= 0) {
+        return false;
+      }
+      sent += n;
+    }
+    return true;
+  }
+
+  /// 读到'\0'为止，即一个请求的完整结果
+  bool recv_response(std::string &response)
+  {
+    response.clear();
+    char buf[4096];
+    while (true) {
+      ssize_t n = shm != nullptr ? shm->client_recv(buf, sizeof(buf), spin_us, fd) : read(fd, buf, sizeof(buf));
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      if (n <= 0) {
+        return false;
+      }
+      const char *end = static_cast<const char *>(memchr(buf, 0, n));
+      if (end != nullptr) {
+        response.append(buf, end - buf);
+        return true;
+      }
+      response.append(buf, n);
+    }
+  }
+
+  bool execute(const std::string &request, std::string &response)
+  {
+    return send_all(request) && recv_response(response);
+  }
+};
+
+static int connect_server(const BenchOptions &options)
+{
+  if (options.unix_socket_path != nullptr) {
+    int sockfd = socket(PF_UNIX, SOCK_STREAM, 0);
+    if (sockfd < 0) {
+      fprintf(stderr, "create unix socket error. errmsg=%d:%s\n", errno, strerror(errno));
+      return -1;
+    }
+    struct sockaddr_un sockaddr;
+    memset(&sockaddr, 0, sizeof(sockaddr));
+    sockaddr.sun_family = PF_UNIX;
+    snprintf(sockaddr.sun_path, sizeof(sockaddr.sun_path), "%s", options.unix_socket_path);
+    if (connect(sockfd, (struct sockaddr *)&sockaddr, sizeof(sockaddr)) < 0) {
+      fprintf(stderr, "failed to connect to %s. errmsg=%d:%s\n", sockaddr.sun_path, errno, strerror(errno));
+      close(sockfd);
+      return -1;
+    }
+    return sockfd;
+  }
+
+  struct hostent *host = gethostbyname(options.host);
+  if (host == nullptr) {
+    fprintf(stderr, "gethostbyname failed. errmsg=%d:%s\n", errno, strerror(errno));
+    return -1;
+  }
+  int sockfd = socket(AF_INET, SOCK_STREAM, 0);
+  if (sockfd < 0) {
+    fprintf(stderr, "create socket error. errmsg=%d:%s\n", errno, strerror(errno));
+    return -1;
+  }
+  int yes = 1;
+  setsockopt(sockfd, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+
+  struct sockaddr_in serv_addr;
+  memset(&serv_addr, 0, sizeof(serv_addr));
+  serv_addr.sin_family = AF_INET;
+  serv_addr.sin_port   = htons(options.port);
+  serv_addr.sin_addr   = *((struct in_addr *)host->h_addr);
+  if (connect(sockfd, (struct sockaddr *)&serv_addr, sizeof(serv_addr)) < 0) {
+    fprintf(stderr, "failed to connect. errmsg=%d:%s\n", errno, strerror(errno));
+    close(sockfd);
+    return -1;
+  }
+  return sockfd;
+}
+
+static bool open_shm_channel(Connection &conn)
+{
+  std::string request = std::string(common::SHM_HANDSHAKE_REQUEST) + '\0';
+  if (!conn.send_all(request)) {
+    return false;
+  }
+
+  char reply  = 0;
+  int  fds[common::SHM_CHANNEL_FD_NUM];
+  int  fd_num = common::SHM_CHANNEL_FD_NUM;
+  if (common::recv_fds(conn.fd, &reply, 1, fds, fd_num) != 1 || reply != common::SHM_HANDSHAKE_ACCEPT ||
+      fd_num != common::SHM_CHANNEL_FD_NUM) {
+    for (int i = 0; i < fd_num; i++) {
+      close(fds[i]);
+    }
+    fprintf(stderr, "server refused shared memory channel\n");
+    return false;
+  }
+
+  auto channel = std::make_unique<common::ShmChannel>();
+  if (channel->attach(fds) < 0) {
+    fprintf(stderr, "failed to map shared memory channel\n");
+    return false;
+  }
+  conn.shm = std::move(channel);
+  return true;
+}
+
+/**
+ * @brief 建立连接，需要时再申请共享内存通道
+ */
+static bool open_connection(const BenchOptions &options, Connection &conn)
+{
+  conn.spin_us = options.spin_us;
+  conn.fd      = connect_server(options);
+  if (conn.fd < 0) {
+    return false;
+  }
+  return !options.shm || open_shm_channel(conn);
+}
+
+/**
+ * @brief 执行一个请求，reconnect 时先建立一个新的连接，请求结束之后断开
+ */
+static bool run_once(const BenchOptions &options, Connection &conn, const std::string &request, std::string &response)
+{
+  if (!options.reconnect) {
+    return conn.execute(request, response);
+  }
+  Connection short_conn;
+  return open_connection(options, short_conn) && short_conn.execute(request, response);
+}
+
+static double percentile(const std::vector<double> &sorted, double p)
+{
+  if (sorted.empty()) {
+    return 0;
+  }
+  size_t index = static_cast<size_t>(p * (sorted.size() - 1));
+  return sorted[index];
+}
+
+static void usage(const char *name)
+{
+  printf("Usage: %s [-h host] [-p port] [-s unix_socket] [--shm] [--spin us] [-n requests] [-w warmup]\n"
+         "          [-q sql] [-k(skip setup)] [--reconnect]\n",
+      name);
+}
+
+int main(int argc, char *argv[])
+{
+  BenchOptions options;
+  static struct option long_options[] = {
+      {"shm", no_argument, nullptr, 'M'},
+      {"spin", required_argument, nullptr, 'S'},
+      {"reconnect", no_argument, nullptr, 'R'},
+      {nullptr, 0, nullptr, 0}
+  };
+  int opt;
+  while ((opt = getopt_long(argc, argv, "h:p:s:n:w:q:k", long_options, nullptr)) > 0) {
+    switch (opt) {
+      case 'h': options.host = optarg; break;
+      case 'p': options.port = atoi(optarg); break;
+      case 's': options.unix_socket_path = optarg; break;
+      case 'M': options.shm = true; break;
+      case 'S': options.spin_us = std::max(atoi(optarg), 0); break;
+      case 'n': options.requests = std::max(atoi(optarg), 1); break;
+      case 'w': options.warmup = std::max(atoi(optarg), 0); break;
+      case 'q': options.sql = optarg; break;
+      case 'k': options.setup = false; break;
+      case 'R': options.reconnect = true; break;
+      default: usage(argv[0]); return 1;
+    }
+  }
+  if (options.shm && options.unix_socket_path == nullptr) {
+    fprintf(stderr, "--shm requires a unix socket(-s)\n");
+    return 1;
+  }
+
+  Connection conn;
+  if (!open_connection(options, conn)) {
+    return 1;
+  }
+
+  std::string response;
+  if (options.setup) {
+    // 表已经存在时建表失败，不影响测试
+    const char *setup_sqls[] = {"create table bench_point(id int, v int);",
+        "create index bench_point_id on bench_point(id);",
+        "insert into bench_point values(1, 100);"};
+    for (const char *sql : setup_sqls) {
+      if (!conn.execute(std::string(sql) + '\0', response)) {
+        fprintf(stderr, "failed to setup: %s\n", sql);
+        return 1;
+      }
+    }
+  }
+
+  const std::string request = std::string(options.sql) + '\0';
+  for (int i = 0; i < options.warmup; i++) {
+    if (!run_once(options, conn, request, response)) {
+      fprintf(stderr, "connection was broken\n");
+      return 1;
+    }
+  }
+
+  std::vector<double> latencies;
+  latencies.reserve(options.requests);
+  const auto begin = std::chrono::steady_clock::now();
+  for (int i = 0; i < options.requests; i++) {
+    const auto start = std::chrono::steady_clock::now();
+    if (!run_once(options, conn, request, response)) {
+      fprintf(stderr, "connection was broken\n");
+      return 1;
+    }
+    latencies.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+  }
+  const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+  std::sort(latencies.begin(), latencies.end());
+  double total = 0;
+  for (double latency : latencies) {
+    total += latency;
+  }
+  const char *transport = options.shm ? "shm" : (options.unix_socket_path != nullptr ? "unix" : "tcp");
+  printf("transport=%s%s requests=%d qps=%.0f latency_us avg=%.2f p50=%.2f p99=%.2f max=%.2f\n",
+      transport,
+      options.reconnect ? "+reconnect" : "",
+      options.requests,
+      options.requests / seconds,
+      total / latencies.size(),
+      percentile(latencies, 0.5),
+      percentile(latencies, 0.99),
+      latencies.back());
+  printf("last response: %s", response.c_str());
+  return 0;
+}
@@ -0,0 +1,276 @@
+//
+// 压测工具：多个连接同时发送慢查询与快查询，统计请求的延迟
+//
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define PORT_DEFAULT 6789
+
+struct BenchOptions
+{
+  const char *host             = "127.0.0.1";
+  int         port             = PORT_DEFAULT;
+  const char *unix_socket_path = nullptr;
+  int         connections      = 16;   ///< 并发连接数，每个连接一个线程
+  int         requests         = 200;  ///< 每个连接发送的请求数
+  int         slow_percent     = 5;    ///< 慢查询所占的百分比
+  int         rows             = 300;  ///< 测试表的行数，慢查询是这张表的三表连接
+  bool        setup            = true; ///< 是否创建并填充测试表
+};
+
+/// 一次请求的结果
+struct Sample
+{
+  bool   slow;
+  double latency_ms;
+};
+
+static int connect_server(const BenchOptions &options)
+{
+  int sockfd = -1;
+  if (options.unix_socket_path != nullptr) {
+    sockfd = socket(PF_UNIX, SOCK_STREAM, 0);
+    if (sockfd < 0) {
+      fprintf(stderr, "create unix socket error. errmsg=%d:%s\n", errno, strerror(errno));
+      return -1;
+    }
+    struct sockaddr_un sockaddr;
+    memset(&sockaddr, 0, sizeof(sockaddr));
+    sockaddr.sun_family = PF_UNIX;
+    snprintf(sockaddr.sun_path, sizeof(sockaddr.sun_path), "%s", options.unix_socket_path);
+    if (connect(sockfd, (struct sockaddr *)&sockaddr, sizeof(sockaddr)) < 0) {
+      fprintf(stderr, "failed to connect to %s. errmsg=%d:%s\n", sockaddr.sun_path, errno, strerror(errno));
+      close(sockfd);
+      return -1;
+    }
+    return sockfd;
+  }
+
+  struct hostent *host = gethostbyname(options.host);
+  if (host == nullptr) {
+    fprintf(stderr, "gethostbyname failed. errmsg=%d:%s\n", errno, strerror(errno));
+    return -1;
+  }
+  sockfd = socket(AF_INET, SOCK_STREAM, 0);
+  if (sockfd < 0) {
+    fprintf(stderr, "create socket error. errmsg=%d:%s\n", errno, strerror(errno));
+    return -1;
+  }
+  int yes = 1;
+  setsockopt(sockfd, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+
+  struct sockaddr_in serv_addr;
+  memset(&serv_addr, 0, sizeof(serv_addr));
+  serv_addr.sin_family = AF_INET;
+  serv_addr.sin_port   = htons(options.port);
+  serv_addr.sin_addr   = *((struct in_addr *)host->h_addr);
+  if (connect(sockfd, (struct sockaddr *)&serv_addr, sizeof(serv_addr)) < 0) {
+    fprintf(stderr, "failed to connect. errmsg=%d:%s\n", errno, strerror(errno));
+    close(sockfd);
+    return -1;
+  }
+  return sockfd;
+}
+
+/**
+ * @brief 发送一条SQL并等待完整的结果
+ * @details 请求与结果都以 '\0' 结尾
+ */
+static bool execute(int sockfd, const std::string &sql, std::string *result = nullptr)
+{
+  const char *data = sql.c_str();
+  size_t      left = sql.size() + 1;
+  while (left > 0) {
+    ssize_t n = write(sockfd, data, left);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      fprintf(stderr, "send error: %d:%s\n", errno, strerror(errno));
+      return false;
+    }
+    data += n;
+    left -= n;
+  }
+
+  char buf[8192];
+  while (true) {
+    ssize_t n = ::recv(sockfd, buf, sizeof(buf), 0);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      fprintf(stderr, "connection was broken while waiting result of '%s'\n", sql.c_str());
+      return false;
+    }
+    const char *end = static_cast<const char *>(memchr(buf, 0, n));
+    if (result != nullptr) {
+      result->append(buf, end == nullptr ? n : end - buf);
+    }
+    if (end != nullptr) {
+      return true;
+    }
+  }
+}
+
+static bool setup_table(const BenchOptions &options)
+{
+  int sockfd = connect_server(options);
+  if (sockfd < 0) {
+    return false;
+  }
+  std::string result;
+  execute(sockfd, "drop table bench_t;");
+  if (!execute(sockfd, "create table bench_t(id int, v int);", &result) || result.find("SUCCESS") == std::string::npos) {
+    fprintf(stderr, "failed to create table bench_t: %s\n", result.c_str());
+    close(sockfd);
+    return false;
+  }
+
+  const int batch = 100;
+  for (int begin = 0; begin < options.rows; begin += batch) {
+    std::string sql = "insert into bench_t values ";
+    for (int id = begin; id < std::min(begin + batch, options.rows); id++) {
+      if (id != begin) {
+        sql += ",";
+      }
+      sql += "(" + std::to_string(id) + "," + std::to_string(id % 10) + ")";
+    }
+    sql += ";";
+    if (!execute(sockfd, sql)) {
+      close(sockfd);
+      return false;
+    }
+  }
+  close(sockfd);
+  return true;
+}
+
+static void run_connection(const BenchOptions &options, int index, std::vector<Sample> &samples,
+    std::atomic<int> &failures)
+{
+  int sockfd = connect_server(options);
+  if (sockfd < 0) {
+    failures++;
+    return;
+  }
+
+  std::mt19937 random(index * 7919 + 17);
+  std::uniform_int_distribution<int> percent(0, 99);
+  std::uniform_int_distribution<int> id(0, std::max(options.rows - 1, 0));
+
+  const std::string slow_sql = "select count(*) from bench_t a, bench_t b, bench_t c where a.v = b.v and b.v = c.v;";
+  for (int i = 0; i < options.requests; i++) {
+    bool        slow = percent(random) < options.slow_percent;
+    std::string sql  = slow ? slow_sql : "select * from bench_t where id = " + std::to_string(id(random)) + ";";
+
+    auto begin = std::chrono::steady_clock::now();
+    if (!execute(sockfd, sql)) {
+      failures++;
+      break;
+    }
+    auto end = std::chrono::steady_clock::now();
+    samples.push_back({slow, std::chrono::duration<double, std::milli>(end - begin).count()});
+  }
+  close(sockfd);
+}
+
+static double percentile(const std::vector<double> &sorted, double p)
+{
+  if (sorted.empty()) {
+    return 0;
+  }
+  size_t index = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+  return sorted[std::min(index, sorted.size() - 1)];
+}
+
+static void report(const char *name, std::vector<double> latencies)
+{
+  std::sort(latencies.begin(), latencies.end());
+  printf("%-5s count=%-7zu p50=%.3fms p99=%.3fms max=%.3fms\n",
+      name,
+      latencies.size(),
+      percentile(latencies, 0.5),
+      percentile(latencies, 0.99),
+      latencies.empty() ? 0.0 : latencies.back());
+}
+
+static void usage(const char *name)
+{
+  printf("Usage: %s [-h host] [-p port] [-s unix_socket_path] [-c connections] [-n requests_per_connection]\n"
+         "          [-w slow_query_percent] [-r table_rows] [-k (skip creating table)]\n",
+      name);
+}
+
+int main(int argc, char *argv[])
+{
+  BenchOptions options;
+  int          opt;
+  while ((opt = getopt(argc, argv, "h:p:s:c:n:w:r:k")) > 0) {
+    switch (opt) {
+      case 'h': options.host = optarg; break;
+      case 'p': options.port = atoi(optarg); break;
+      case 's': options.unix_socket_path = optarg; break;
+      case 'c': options.connections = std::max(atoi(optarg), 1); break;
+      case 'n': options.requests = std::max(atoi(optarg), 1); break;
+      case 'w': options.slow_percent = std::clamp(atoi(optarg), 0, 100); break;
+      case 'r': options.rows = std::max(atoi(optarg), 1); break;
+      case 'k': options.setup = false; break;
+      default: usage(argv[0]); return 1;
+    }
+  }
+
+  if (options.setup && !setup_table(options)) {
+    return 1;
+  }
+
+  std::vector<std::vector<Sample>> samples(options.connections);
+  std::vector<std::thread>         threads;
+  std::atomic<int>                 failures{0};
+
+  auto begin = std::chrono::steady_clock::now();
+  for (int i = 0; i < options.connections; i++) {
+    threads.emplace_back(run_connection, std::cref(options), i, std::ref(samples[i]), std::ref(failures));
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+  std::vector<double> all, fast, slow;
+  for (const std::vector<Sample> &connection_samples : samples) {
+    for (const Sample &sample : connection_samples) {
+      all.push_back(sample.latency_ms);
+      (sample.slow ? slow : fast).push_back(sample.latency_ms);
+    }
+  }
+
+  printf("connections=%d requests=%zu failures=%d elapsed=%.3fs throughput=%.1f req/s\n",
+      options.connections,
+      all.size(),
+      failures.load(),
+      seconds,
+      seconds > 0 ? all.size() / seconds : 0.0);
+  report("all", all);
+  report("fast", fast);
+  report("slow", slow);
+  return failures.load() == 0 ? 0 : 1;
+}
@@ -15,8 +15,10 @@ See the Mulan PSL v2 for more details. */
 #include <arpa/inet.h>
 #include <cerrno>
 #include <errno.h>
+#include <getopt.h>
 #include <netdb.h>
 #include <netinet/in.h>
+#include <poll.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -28,7 +30,12 @@ See the Mulan PSL v2 for more details. */
 #include <termios.h>
 #include <time.h>
 
+#include <string>
+#include <vector>
+
 #include "common/defs.h"
+#include "common/io/binary_protocol.h"
+#include "common/io/shm_channel.h"
 #include "common/lang/string.h"
 
 #ifdef USE_READLINE
@@ -155,15 +162,260 @@ int init_tcp_sock(const char *server_host, int server_port)
   return sockfd;
 }
 
+#define SHM_SPIN_US 200
+
+/**
+ * 通过Unix Socket申请共享内存通道，服务端不支持时返回空，继续使用套接字
+ */
+common::ShmChannel *open_shm_channel(int sockfd)
+{
+  const std::string request = std::string(common::SHM_HANDSHAKE_REQUEST) + '\0';
+  if (write(sockfd, request.data(), request.size()) != static_cast<ssize_t>(request.size())) {
+    fprintf(stderr, "send error: %d:%s \n", errno, strerror(errno));
+    return nullptr;
+  }
+
+  char reply = 0;
+  int fds[common::SHM_CHANNEL_FD_NUM];
+  int fd_num = common::SHM_CHANNEL_FD_NUM;
+  if (common::recv_fds(sockfd, &reply, 1, fds, fd_num) != 1 || reply != common::SHM_HANDSHAKE_ACCEPT ||
+      fd_num != common::SHM_CHANNEL_FD_NUM) {
+    for (int i = 0; i < fd_num; i++) {
+      close(fds[i]);
+    }
+    fprintf(stderr, "server refused shared memory channel, use the socket instead\n");
+    return nullptr;
+  }
+
+  common::ShmChannel *channel = new common::ShmChannel;
+  if (channel->attach(fds) < 0) {
+    fprintf(stderr, "failed to map shared memory channel, use the socket instead\n");
+    delete channel;
+    return nullptr;
+  }
+  return channel;
+}
+
+/**
+ * 发送请求与接收结果，打开共享内存通道之后都经过共享内存，返回值与 write/recv 相同
+ */
+ssize_t send_request(int sockfd, common::ShmChannel *shm, const char *data, size_t size)
+{
+  if (shm == nullptr) {
+    return write(sockfd, data, size);
+  }
+  return shm->client_send(data, size, sockfd) < 0 ? -1 : static_cast<ssize_t>(size);
+}
+
+ssize_t recv_response(int sockfd, common::ShmChannel *shm, char *buf, size_t size)
+{
+  if (shm == nullptr) {
+    return recv(sockfd, buf, size, 0);
+  }
+  return shm->client_recv(buf, size, SHM_SPIN_US, sockfd);
+}
+
+/**
+ * 二进制协议的结果解析：收到的数据交给 feed，完整的消息按照与文本协议相同的格式输出
+ */
+class BinaryResponsePrinter
+{
+public:
+  /**
+   * @return 这些数据中结束了几个请求的结果，数据格式错误时返回-1
+   */
+  int feed(const char *data, size_t size)
+  {
+    pending_.append(data, size);
+    int finished = 0;
+    size_t pos = 0;
+    common::BinaryMessage message;
+    size_t consumed = 0;
+    while (common::parse_binary_message(pending_.data() + pos, pending_.size() - pos, message, consumed)) {
+      pos += consumed;
+      switch (message.type) {
+        case common::BinaryMessageType::SCHEMA: {
+          if (!common::decode_binary_schema(message, names_)) {
+            return -1;
+          }
+          line_.clear();
+          for (size_t i = 0; i < names_.size(); i++) {
+            line_ += (i == 0 ? "" : " | ") + names_[i];
+          }
+          line_ += '\n';
+          fwrite(line_.data(), 1, line_.size(), stdout);
+        } break;
+        case common::BinaryMessageType::BATCH: {
+          if (!common::decode_binary_batch(message, batch_)) {
+            return -1;
+          }
+          line_.clear();
+          for (int row = 0; row < batch_.rows; row++) {
+            for (size_t i = 0; i < batch_.columns.size(); i++) {
+              if (i != 0) {
+                line_ += " | ";
+              }
+              line_ += batch_.columns[i].cell_string(row);
+            }
+            line_ += '\n';
+          }
+          fwrite(line_.data(), 1, line_.size(), stdout);
+        } break;
+        case common::BinaryMessageType::TEXT: {
+          fwrite(message.data, 1, message.size, stdout);
+        } break;
+        case common::BinaryMessageType::END: {
+          finished++;
+        } break;
+        default: {
+          return -1;
+        }
+      }
+    }
+    pending_.erase(0, pos);
+    return finished;
+  }
+
+private:
+  std::string               pending_;  // 还不是完整消息的数据
+  std::string               line_;
+  std::vector<std::string>  names_;
+  common::BinaryBatch       batch_;
+};
+
+/**
+ * 流水线模式：从标准输入按行读取语句，最多有 depth 个语句已经发送但是还没有收到结果，
+ * 不需要每个语句都等一次往返。结果按照发送的顺序输出，最后在标准错误输出耗时
+ */
+int run_pipeline(int sockfd, int depth, bool binary)
+{
+  BinaryResponsePrinter printer;
+  std::string out;          // 还没有发送出去的数据
+  size_t out_pos = 0;
+  int outstanding = 0;      // 已经开始发送但是还没有收到结果的语句个数
+  long statements = 0;
+  bool input_eof = false;
+  char line[MAX_MEM_BUFFER_SIZE];
+  char recv_buf[MAX_MEM_BUFFER_SIZE];
+
+  struct timeval begin, end;
+  gettimeofday(&begin, nullptr);
+
+  while (true) {
+    while (!input_eof && outstanding < depth) {
+      if (fgets(line, sizeof(line), stdin) == nullptr) {
+        input_eof = true;
+        break;
+      }
+      if (common::is_blank(line)) {
+        continue;
+      }
+      if (is_exit_command(line)) {
+        input_eof = true;
+        break;
+      }
+      size_t len = strlen(line);
+      while (len > 0 && (line[len - 1] == '\n' || line[len - 1] == '\r')) {
+        line[--len] = 0;
+      }
+      if (out_pos == out.size()) {
+        out.clear();
+        out_pos = 0;
+      }
+      out.append(line, len + 1);  // 包含结尾的'\0'
+      outstanding++;
+      statements++;
+    }
+
+    if (outstanding == 0 && input_eof) {
+      break;
+    }
+
+    struct pollfd pfd;
+    pfd.fd = sockfd;
+    pfd.events = POLLIN | (out_pos < out.size() ? POLLOUT : 0);
+    pfd.revents = 0;
+    if (poll(&pfd, 1, -1) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      fprintf(stderr, "poll error: %d:%s \n", errno, strerror(errno));
+      return 1;
+    }
+
+    if ((pfd.revents & POLLOUT) && out_pos < out.size()) {
+      ssize_t send_bytes = send(sockfd, out.data() + out_pos, out.size() - out_pos, MSG_DONTWAIT);
+      if (send_bytes < 0 && errno != EAGAIN && errno != EINTR) {
+        fprintf(stderr, "send error: %d:%s \n", errno, strerror(errno));
+        return 1;
+      }
+      if (send_bytes > 0) {
+        out_pos += send_bytes;
+      }
+    }
+
+    if (pfd.revents & (POLLIN | POLLERR | POLLHUP)) {
+      ssize_t len = recv(sockfd, recv_buf, sizeof(recv_buf), MSG_DONTWAIT);
+      if (len < 0 && (errno == EAGAIN || errno == EINTR)) {
+        continue;
+      }
+      if (len <= 0) {
+        fprintf(stderr, "Connection was broken: %s\n", len == 0 ? "closed by server" : strerror(errno));
+        return 1;
+      }
+      if (binary) {
+        int finished = printer.feed(recv_buf, len);
+        if (finished < 0) {
+          fprintf(stderr, "invalid binary response\n");
+          return 1;
+        }
+        outstanding -= finished;
+        continue;
+      }
+      for (ssize_t i = 0; i < len; i++) {
+        if (0 == recv_buf[i]) {
+          outstanding--;
+        } else {
+          putchar(recv_buf[i]);
+        }
+      }
+    }
+  }
+
+  gettimeofday(&end, nullptr);
+  double seconds = (end.tv_sec - begin.tv_sec) + (end.tv_usec - begin.tv_usec) / 1000000.0;
+  fprintf(stderr, "pipeline depth %d: %ld statements in %.3f s, %.1f statements/s\n",
+      depth, statements, seconds, seconds > 0 ? statements / seconds : 0.0);
+  return 0;
+}
+
 int main(int argc, char *argv[])
 {
   const char *unix_socket_path = nullptr;
   const char *server_host = "127.0.0.1";
   int server_port = PORT_DEFAULT;
+  int pipeline_depth = 0;
+  bool binary = false;
+  bool use_shm = false;
   int opt;
   extern char *optarg;
-  while ((opt = getopt(argc, argv, "s:h:p:")) > 0) {
+  static struct option long_options[] = {
+      {"pipeline", required_argument, nullptr, 'P'},
+      {"binary", no_argument, nullptr, 'B'},
+      {"shm", no_argument, nullptr, 'M'},
+      {nullptr, 0, nullptr, 0}
+  };
+  while ((opt = getopt_long(argc, argv, "s:h:p:", long_options, nullptr)) > 0) {
     switch (opt) {
+      case 'P':
+        pipeline_depth = atoi(optarg);
+        break;
+      case 'B':
+        binary = true;
+        break;
+      case 'M':
+        use_shm = true;
+        break;
       case 's':
         unix_socket_path = optarg;
         break;
@@ -189,6 +441,23 @@ int main(int argc, char *argv[])
     return 1;
   }
 
+  if (pipeline_depth > 0) {
+    if (use_shm) {
+      fprintf(stderr, "--shm does not support --pipeline, use the socket instead\n");
+    }
+    int ret = run_pipeline(sockfd, pipeline_depth, binary);
+    close(sockfd);
+    return ret;
+  }
+
+  // 共享内存通道只能通过Unix Socket申请
+  common::ShmChannel *shm = nullptr;
+  if (use_shm && unix_socket_path == nullptr) {
+    fprintf(stderr, "--shm requires a unix socket(-s), use the socket instead\n");
+  } else if (use_shm) {
+    shm = open_shm_channel(sockfd);
+  }
+
   char send_buf[MAX_MEM_BUFFER_SIZE];
 
   char *input_command = nullptr;
@@ -203,7 +472,7 @@ int main(int argc, char *argv[])
       break;
     }
 
-    if ((send_bytes = write(sockfd, input_command, strlen(input_command) + 1)) == -1) { // TODO writen
+    if ((send_bytes = send_request(sockfd, shm, input_command, strlen(input_command) + 1)) == -1) { // TODO writen
       fprintf(stderr, "send error: %d:%s \n", errno, strerror(errno));
       exit(1);
     }
@@ -211,7 +480,19 @@ int main(int argc, char *argv[])
     memset(send_buf, 0, sizeof(send_buf));
 
     int len = 0;
-    while ((len = recv(sockfd, send_buf, MAX_MEM_BUFFER_SIZE, 0)) > 0) {
+    if (binary) {
+      // 服务端使用二进制协议(-P binary)时，读到 END 消息才是完整的结果
+      BinaryResponsePrinter printer;
+      int finished = 0;
+      while (finished == 0 && (len = recv_response(sockfd, shm, send_buf, MAX_MEM_BUFFER_SIZE)) > 0) {
+        finished = printer.feed(send_buf, len);
+      }
+      if (finished < 0) {
+        fprintf(stderr, "invalid binary response\n");
+        break;
+      }
+    }
+    while (!binary && (len = recv_response(sockfd, shm, send_buf, MAX_MEM_BUFFER_SIZE)) > 0) {
       bool msg_end = false;
       for (int i = 0; i < len; i++) {
         if (0 == send_buf[i]) {
@@ -236,6 +517,7 @@ int main(int argc, char *argv[])
       break;
     }
   }
+  delete shm;
   close(sockfd);
 
   return 0;
@@ -12,6 +12,9 @@
 #include "include/storage_engine/schema/default_handler.h"
 #include "include/storage_engine/transaction/trx.h"
 #include "include/common/global_context.h"
+#include "include/common/worker_pool.h"
+#include "include/query_engine/slow_query_log.h"
+#include "include/storage_engine/schema/system_table.h"
 
 using namespace common;
 
@@ -98,6 +101,17 @@ int init_log(ProcessParam *process_cfg, Ini &properties)
       g_log->set_default_module(it->second);
     }
 
+    // 默认异步输出，LOG_ASYNC=0 时每条日志都同步写文件
+    int log_async = 1;
+    key = ("LOG_ASYNC");
+    it = log_section.find(key);
+    if (it != log_section.end()) {
+      str_to_val(it->second, log_async);
+    }
+    if (log_async != 0) {
+      g_log->start_async();
+    }
+
     if (process_cfg->is_demon()) {
       sys_log_redirect(log_file_name.c_str(), log_file_name.c_str());
     }
@@ -138,6 +152,36 @@ int init_global_objects(ProcessParam *process_param, Ini &properties)
   }
   GCTX.trx_manager_ = TrxManager::instance();
 
+  // 慢查询日志，SLOW_QUERY_TIME_MS 小于0时关闭
+  double slow_query_time_ms = -1;
+  int slow_query_history_size = 1000;
+  str_to_val(properties.get("SLOW_QUERY_TIME_MS", "-1", "LOG"), slow_query_time_ms);
+  str_to_val(properties.get("SLOW_QUERY_HISTORY_SIZE", "1000", "LOG"), slow_query_history_size);
+  std::string slow_query_log_file = properties.get("SLOW_QUERY_LOG_FILE_NAME", "", "LOG");
+  if (!slow_query_log_file.empty()) {
+    slow_query_log_file = getAboslutPath(slow_query_log_file.c_str());
+  }
+  SlowQueryLog::instance().init(slow_query_log_file, slow_query_time_ms, slow_query_history_size);
+  rc = SlowQueryLog::register_system_table();
+  if (RC_FAIL(rc)) {
+    LOG_ERROR("failed to register system table %s. rc=%s", SlowQueryLog::SYSTEM_TABLE_NAME, strrc(rc));
+    ret = -1;
+  }
+
+  // 配置为0或者没有配置时使用CPU的核数
+  int sql_thread_num = 0;
+  std::string sql_thread_num_str = properties.get(THREAD_COUNT, "0", SQL_THREADS);
+  str_to_val(sql_thread_num_str, sql_thread_num);
+#ifndef CONCURRENCY
+  // 没有打开并发编译选项时缓冲池的锁是空操作，多个线程同时读页面会互相覆盖，不能并行扫描
+  if (sql_thread_num != 1) {
+    LOG_INFO("concurrency is disabled, use 1 worker thread instead of %d", sql_thread_num);
+    sql_thread_num = 1;
+  }
+#endif
+  GCTX.worker_pool_ = new WorkerPool(sql_thread_num);
+  LOG_INFO("sql worker pool init with %d threads", GCTX.worker_pool_->thread_num());
+
   rc = GCTX.handler_->init("tdb");
   if (RC_FAIL(rc)) {
     LOG_ERROR("failed to init handler. rc=%s", strrc(rc));
@@ -148,6 +192,11 @@ int init_global_objects(ProcessParam *process_param, Ini &properties)
 
 int uninit_global_objects()
 {
+  if (GCTX.worker_pool_ != nullptr) {
+    delete GCTX.worker_pool_;
+    GCTX.worker_pool_ = nullptr;
+  }
+
   // TODO use global context
   DefaultHandler *default_handler = &DefaultHandler::get_default();
   if (default_handler != nullptr) {
@@ -155,6 +204,9 @@ int uninit_global_objects()
     delete default_handler;
   }
 
+  SystemTables::instance().clear();
+  SlowQueryLog::instance().cleanup();
+
   BufferPoolManager *bpm = &BufferPoolManager::instance();
   if (bpm != nullptr) {
     BufferPoolManager::set_instance(nullptr);
@@ -0,0 +1,109 @@
+#include "include/common/query_stats.h"
+
+#include <vector>
+
+#include "include/query_engine/planner/operator/exchange_physical_operator.h"
+
+static thread_local QueryStats *current_stats = nullptr;
+
+const char *query_phase_name(QueryPhase phase)
+{
+  switch (phase) {
+    case QueryPhase::PARSE: return "parse";
+    case QueryPhase::ANALYZE: return "analyze";
+    case QueryPhase::PLAN: return "plan";
+    case QueryPhase::OPTIMIZE: return "optimize";
+    case QueryPhase::EXECUTE: return "execute";
+    case QueryPhase::SEND: return "send";
+    default: return "unknown";
+  }
+}
+
+QueryStats *QueryStats::current()
+{
+  return current_stats;
+}
+
+void QueryStats::set_current(QueryStats *stats)
+{
+  current_stats = stats;
+}
+
+namespace {
+
+/**
+ * @brief 描述一组位置相同的算子，并行执行时每条流水线中相同位置的算子合并成一项
+ * @details 输出形如 PROJECT(10) <- TABLE_SCAN t(10/1000)，括号中是输出的行数和扫描的行数，
+ * 有多个子算子时用方括号括起来
+ */
+void describe_operators(const std::vector<PhysicalOperator *> &peers, uint64_t &rows_scanned, std::string &out)
+{
+  PhysicalOperator *oper = peers.front();
+  uint64_t rows = 0;
+  uint64_t scanned = 0;
+  for (PhysicalOperator *peer : peers) {
+    rows += peer->rows_out();
+    scanned += peer->rows_scanned();
+  }
+  rows_scanned += scanned;
+
+  out += oper->name();
+  if (oper->type() == PhysicalOperatorType::TABLE_SCAN || oper->type() == PhysicalOperatorType::INDEX_SCAN) {
+    const std::string param = oper->param();
+    out += " " + param.substr(0, param.find(','));
+  }
+  out += "(" + std::to_string(rows);
+  if (scanned > 0) {
+    out += "/" + std::to_string(scanned);
+  }
+  out += ")";
+
+  // 交换算子下面每条流水线都是一样的计划
+  std::vector<std::vector<PhysicalOperator *>> children;
+  if (oper->type() == PhysicalOperatorType::EXCHANGE) {
+    children.emplace_back();
+    for (PhysicalOperator *peer : peers) {
+      auto *exchange = static_cast<ExchangePhysicalOperator *>(peer);
+      for (int i = 0; i < exchange->pipeline_num(); i++) {
+        children.back().push_back(exchange->pipeline(i));
+      }
+    }
+  } else {
+    children.resize(oper->children().size());
+    for (PhysicalOperator *peer : peers) {
+      for (size_t i = 0; i < children.size() && i < peer->children().size(); i++) {
+        children[i].push_back(peer->children()[i].get());
+      }
+    }
+  }
+
+  if (children.empty()) {
+    return;
+  }
+  out += " <- ";
+  if (children.size() > 1) {
+    out += "[";
+  }
+  for (size_t i = 0; i < children.size(); i++) {
+    if (i > 0) {
+      out += ", ";
+    }
+    describe_operators(children[i], rows_scanned, out);
+  }
+  if (children.size() > 1) {
+    out += "]";
+  }
+}
+
+}  // namespace
+
+void QueryStats::collect_operators(PhysicalOperator *root)
+{
+  if (root == nullptr) {
+    return;
+  }
+  operators_.clear();
+  rows_scanned = 0;
+  describe_operators({root}, rows_scanned, operators_);
+  rows_sent = root->rows_out();
+}
@@ -0,0 +1,114 @@
+#include "include/common/worker_pool.h"
+
+/// 当前线程在所属线程池中的编号，不是工作线程时为-1
+static thread_local const WorkerPool *current_pool = nullptr;
+static thread_local int current_index = -1;
+
+WorkerPool::WorkerPool(int thread_num)
+{
+  if (thread_num <= 0) {
+    thread_num = static_cast<int>(std::thread::hardware_concurrency());
+  }
+  if (thread_num <= 0) {
+    thread_num = 1;
+  }
+
+  for (int i = 0; i < thread_num; i++) {
+    queues_.emplace_back(new TaskQueue);
+  }
+  for (int i = 0; i < thread_num; i++) {
+    threads_.emplace_back(&WorkerPool::thread_func, this, i);
+  }
+}
+
+WorkerPool::~WorkerPool()
+{
+  stop();
+}
+
+void WorkerPool::stop()
+{
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (stopped_) {
+      return;
+    }
+    stopped_ = true;
+  }
+  cond_.notify_all();
+
+  for (std::thread &thread : threads_) {
+    thread.join();
+  }
+}
+
+void WorkerPool::submit(std::function<void()> task)
+{
+  int index = 0;
+  if (current_pool == this) {
+    index = current_index;
+  } else {
+    index = static_cast<int>(next_queue_.fetch_add(1) % queues_.size());
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(queues_[index]->lock);
+    queues_[index]->tasks.emplace_back(std::move(task));
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    pending_++;
+  }
+  cond_.notify_one();
+}
+
+bool WorkerPool::pop_task(int index, std::function<void()> &task)
+{
+  const int queue_num = static_cast<int>(queues_.size());
+  for (int i = 0; i < queue_num; i++) {
+    TaskQueue &queue = *queues_[(index + i) % queue_num];
+    std::lock_guard<std::mutex> guard(queue.lock);
+    if (queue.tasks.empty()) {
+      continue;
+    }
+
+    if (i == 0) {
+      // 自己的队列从尾部取，最近提交的任务数据更可能还在缓存中
+      task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+    } else {
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+    }
+    return true;
+  }
+  return false;
+}
+
+void WorkerPool::thread_func(int index)
+{
+  current_pool = this;
+  current_index = index;
+
+  while (true) {
+    {
+      std::unique_lock<std::mutex> guard(lock_);
+      cond_.wait(guard, [this]() { return pending_ > 0 || stopped_; });
+      if (pending_ == 0) {
+        break;  // stopped_ 并且没有任务了
+      }
+      pending_--;
+    }
+
+    // pending_ 计数保证一定有一个任务可以取到
+    std::function<void()> task;
+    while (!pop_task(index, task)) {
+      std::this_thread::yield();
+    }
+    task();
+  }
+
+  current_pool = nullptr;
+  current_index = -1;
+}
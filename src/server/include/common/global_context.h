@@ -3,6 +3,7 @@
 class BufferPoolManager;
 class DefaultHandler;
 class TrxManager;
+class WorkerPool;
 
 /**
  * @brief 放一些全局对象
@@ -13,6 +14,7 @@ struct GlobalContext
   BufferPoolManager *buffer_pool_manager_ = nullptr;
   DefaultHandler *handler_ = nullptr;
   TrxManager *trx_manager_ = nullptr;
+  WorkerPool *worker_pool_ = nullptr;  ///< 执行SQL的工作线程池，用于查询内的并行执行
 
   static GlobalContext &instance();
 };
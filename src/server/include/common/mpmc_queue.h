@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+/**
+ * @brief 有界的无锁多生产者多消费者队列
+ * @details 环形数组，每个槽位有一个序号。生产者与消费者各自通过CAS抢占位置，
+ * 再根据槽位的序号判断槽位是否已经可以写入或者读取，不需要加锁。
+ * 容量向上取整到2的幂。队列满时 push 失败，队列空时 pop 失败，由调用者决定等待还是放弃
+ */
+template <typename T>
+class MpmcQueue
+{
+public:
+  explicit MpmcQueue(size_t capacity)
+  {
+    capacity_ = 2;
+    while (capacity_ < capacity) {
+      capacity_ <<= 1;
+    }
+    mask_  = capacity_ - 1;
+    cells_ = std::make_unique<Cell[]>(capacity_);
+    for (size_t i = 0; i < capacity_; i++) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  MpmcQueue(const MpmcQueue &) = delete;
+  MpmcQueue &operator=(const MpmcQueue &) = delete;
+
+  size_t capacity() const { return capacity_; }
+
+  bool push(T value)
+  {
+    Cell  *cell = nullptr;
+    size_t pos  = enqueue_pos_.load(std::memory_order_relaxed);
+    while (true) {
+      cell             = &cells_[pos & mask_];
+      size_t   seq     = cell->sequence.load(std::memory_order_acquire);
+      intptr_t diff    = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;  // 槽位还没有被消费者读走，队列已满
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    cell->value = std::move(value);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool pop(T &value)
+  {
+    Cell  *cell = nullptr;
+    size_t pos  = dequeue_pos_.load(std::memory_order_relaxed);
+    while (true) {
+      cell             = &cells_[pos & mask_];
+      size_t   seq     = cell->sequence.load(std::memory_order_acquire);
+      intptr_t diff    = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+      if (diff == 0) {
+        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;  // 槽位还没有被生产者写入，队列为空
+      } else {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    value = std::move(cell->value);
+    cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+    return true;
+  }
+
+private:
+  static constexpr size_t CACHE_LINE_SIZE = 64;
+
+  struct Cell
+  {
+    std::atomic<size_t> sequence;
+    T                   value{};
+  };
+
+  size_t                  capacity_ = 0;
+  size_t                  mask_     = 0;
+  std::unique_ptr<Cell[]> cells_;
+
+  // 生产者与消费者的位置放在不同的缓存行上，避免互相干扰
+  alignas(CACHE_LINE_SIZE) std::atomic<size_t> enqueue_pos_{0};
+  alignas(CACHE_LINE_SIZE) std::atomic<size_t> dequeue_pos_{0};
+};
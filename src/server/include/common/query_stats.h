@@ -0,0 +1,96 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+class PhysicalOperator;
+
+/**
+ * @brief 语句执行的各个阶段
+ */
+enum class QueryPhase
+{
+  PARSE,
+  ANALYZE,
+  PLAN,      ///< 生成逻辑计划和物理计划，使用缓存的计划时只有这个阶段
+  OPTIMIZE,
+  EXECUTE,   ///< 执行算子、产生结果的时间，不包括 SEND
+  SEND,      ///< 把结果写到套接字或共享内存中的时间
+  NUM
+};
+
+const char *query_phase_name(QueryPhase phase);
+
+/**
+ * @brief 一条语句执行过程中的资源统计
+ * @details 语句执行时 QueryEngine 把它设置为当前线程的统计对象，缓冲池、重做日志和结果发送等位置
+ * 通过 QueryStats::current() 直接累加，没有在执行语句的线程(比如后台刷盘)不统计。
+ * 并行执行时工作线程共享同一个对象，所以存储层累加的计数器都是原子变量。
+ */
+class QueryStats
+{
+public:
+  QueryStats() = default;
+  QueryStats(const QueryStats &) = delete;
+  QueryStats &operator=(const QueryStats &) = delete;
+
+  /// 当前线程正在执行的语句的统计，没有时为空
+  static QueryStats *current();
+  static void set_current(QueryStats *stats);
+
+  void add_phase_time(QueryPhase phase, int64_t ns)
+  {
+    phase_ns_[static_cast<int>(phase)] += ns;
+  }
+  int64_t phase_time(QueryPhase phase) const
+  {
+    return phase_ns_[static_cast<int>(phase)];
+  }
+
+  /**
+   * @brief 语句结束、关闭算子之前调用，汇总各个算子的行数
+   * @details 根算子输出的行数就是返回给客户端的行数，扫描算子读取的行数累加到 rows_scanned
+   */
+  void collect_operators(PhysicalOperator *root);
+  const std::string &operators() const { return operators_; }
+
+public:
+  std::atomic<uint64_t> pages_read{0};     ///< 从磁盘读取的页面数
+  std::atomic<uint64_t> pages_hit{0};      ///< 在缓冲池中命中的页面数
+  std::atomic<uint64_t> pages_written{0};  ///< 写到磁盘的页面数，包括淘汰时刷出的脏页
+  std::atomic<uint64_t> log_bytes{0};      ///< 写入重做日志的字节数
+  uint64_t              bytes_sent = 0;    ///< 写给客户端的结果字节数
+  uint64_t              rows_scanned = 0;  ///< 扫描算子从表或索引中读取的行数
+  uint64_t              rows_sent = 0;     ///< 返回给客户端的行数
+  int64_t               total_ns = 0;      ///< 从开始解析到结果写完的时间，包括发送暂停时等待的时间
+
+private:
+  int64_t     phase_ns_[static_cast<int>(QueryPhase::NUM)] = {0};
+  std::string operators_;  ///< 各算子输出的行数，比如 PROJECT(10) <- TABLE_SCAN(10/1000)
+};
+
+/**
+ * @brief 把作用域内的时间累加到当前语句的某个阶段中
+ */
+class QueryPhaseTimer
+{
+public:
+  QueryPhaseTimer(QueryStats *stats, QueryPhase phase)
+      : stats_(stats), phase_(phase), begin_(std::chrono::steady_clock::now())
+  {}
+  ~QueryPhaseTimer()
+  {
+    if (stats_ != nullptr) {
+      auto end = std::chrono::steady_clock::now();
+      stats_->add_phase_time(phase_, std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin_).count());
+    }
+  }
+
+private:
+  QueryStats                           *stats_;
+  QueryPhase                            phase_;
+  std::chrono::steady_clock::time_point begin_;
+};
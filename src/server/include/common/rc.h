@@ -60,7 +60,8 @@
   DEFINE_RC(VARIABLE_NOT_EXISTS)            \
   DEFINE_RC(VARIABLE_NOT_VALID)             \
   DEFINE_RC(LOGBUF_FULL)                    \
-  DEFINE_RC(ONLY_FUNCTIONS)
+  DEFINE_RC(ONLY_FUNCTIONS)                 \
+  DEFINE_RC(SEND_PAUSED)
 
 enum class RC
 {
@@ -8,9 +8,25 @@
 #define MAX_CONNECTION_NUM_DEFAULT (65535*2)
 #define PORT "PORT"
 #define PORT_DEFAULT 6789
+#define SEND_WINDOW_SIZE "SEND_WINDOW_SIZE"
+#define SEND_WINDOW_SIZE_DEFAULT (256 * 1024)
+#define REUSE_PORT "REUSE_PORT"
+#define TCP_NODELAY_OPTION "TCP_NODELAY"
+#define TCP_CORK_OPTION "TCP_CORK"
+#define SHM_TRANSPORT "SHM_TRANSPORT"
+#define SHM_RING_SIZE "SHM_RING_SIZE"
+#define SHM_RING_SIZE_DEFAULT (256 * 1024)
+#define SHM_SPIN_US "SHM_SPIN_US"
+#define SHM_SPIN_US_DEFAULT 50
+#define SESSION_POOL_SIZE "SESSION_POOL_SIZE"
+#define SESSION_POOL_SIZE_DEFAULT 1024
 
 #define SESSION_STAGE_NAME "SessionStage"
 
+#define SQL_THREADS "SQLThreads"
+#define IO_THREADS "IOThreads"
+#define THREAD_COUNT "count"
+
 /* 磁盘文件，包括存放数据的文件和索引(B+Tree)文件，都按照页来组织。每一页都有一个编号，称为PageNum */
 using PageNum = int32_t;
 
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief 执行SQL的工作线程池
+ * @details 每个线程有自己的任务队列。线程优先从自己队列的尾部取任务，
+ * 自己的队列为空时再从其它线程队列的头部窃取任务(work stealing)。
+ * 在工作线程中提交的任务放到当前线程自己的队列中，其它线程提交的任务轮流放到各个队列中。
+ * 线程个数由配置文件中的 [SQLThreads] count 决定
+ */
+class WorkerPool
+{
+public:
+  explicit WorkerPool(int thread_num);
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool &) = delete;
+  WorkerPool &operator=(const WorkerPool &) = delete;
+
+  int thread_num() const { return static_cast<int>(threads_.size()); }
+
+  void submit(std::function<void()> task);
+
+  /**
+   * @brief 停止所有线程，已经提交但是还没有执行的任务会在停止前执行完
+   */
+  void stop();
+
+private:
+  struct TaskQueue
+  {
+    std::mutex                        lock;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  void thread_func(int index);
+  bool pop_task(int index, std::function<void()> &task);
+
+private:
+  std::vector<std::unique_ptr<TaskQueue>> queues_;
+  std::vector<std::thread>                threads_;
+
+  std::mutex              lock_;
+  std::condition_variable cond_;
+  int                     pending_ = 0;  ///< 还没有被取走的任务个数，由 lock_ 保护
+  bool                    stopped_ = false;
+
+  std::atomic<unsigned int> next_queue_{0};
+};
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <vector>
+
+#include "stmt.h"
+
+class Db;
+class Table;
+
+/**
+ * @brief 重新计算表统计信息的语句
+ * @ingroup Statement
+ * @details 没有指定表名时包含当前数据库中的所有表，视图没有统计信息，会被跳过
+ */
+class AnalyzeTableStmt : public Stmt
+{
+public:
+  explicit AnalyzeTableStmt(std::vector<Table *> &&tables) : tables_(std::move(tables)) {}
+  virtual ~AnalyzeTableStmt() = default;
+
+  StmtType type() const override { return StmtType::ANALYZE_TABLE; }
+
+  const std::vector<Table *> &tables() const { return tables_; }
+
+  static RC create(Db *db, const AnalyzeTableSqlNode &analyze_table, Stmt *&stmt);
+
+private:
+  std::vector<Table *> tables_;
+};
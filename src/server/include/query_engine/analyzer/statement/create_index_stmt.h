@@ -3,6 +3,7 @@
 #include <string>
 
 #include "stmt.h"
+#include "include/storage_engine/index/index_meta.h"
 
 struct CreateIndexSqlNode;
 class Table;
@@ -15,11 +16,13 @@ class FieldMeta;
 class CreateIndexStmt : public Stmt
 {
 public:
-  CreateIndexStmt(Table *table, std::vector<const FieldMeta*> &multi_field_metas, const std::string &index_name, bool is_unique)
+  CreateIndexStmt(Table *table, std::vector<const FieldMeta*> &multi_field_metas, const std::string &index_name, bool is_unique,
+      IndexType index_type = IndexType::BPLUS_TREE)
         : table_(table),
           multi_field_metas_(multi_field_metas),
           index_name_(index_name),
-          is_unique_(is_unique)
+          is_unique_(is_unique),
+          index_type_(index_type)
   {}
 
   virtual ~CreateIndexStmt() = default;
@@ -31,6 +34,7 @@ public:
   std::vector<const FieldMeta*> &multi_field_metas()  { return multi_field_metas_; }
   const std::string &index_name() const { return index_name_; }
   const bool is_unique() const { return is_unique_; }
+  IndexType index_type() const { return index_type_; }
 
 public:
   static RC create(Db *db, const CreateIndexSqlNode &create_index, Stmt *&stmt);
@@ -40,4 +44,5 @@ private:
   std::vector<const FieldMeta*> multi_field_metas_;
   std::string index_name_;
   bool is_unique_;
+  IndexType index_type_;
 };
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "stmt.h"
+
+struct CachedPlan;
+
+/**
+ * @brief PREPARE 语句
+ * @ingroup Statement
+ * @details 语句本身只记录名字和SQL，计划在查询引擎中生成，执行时保存到会话中
+ */
+class PrepareStmt : public Stmt
+{
+public:
+  PrepareStmt(const std::string &name, const std::string &sql) : name_(name), sql_(sql) {}
+  virtual ~PrepareStmt() = default;
+
+  StmtType type() const override { return StmtType::PREPARE; }
+
+  const std::string &name() const { return name_; }
+  const std::string &sql() const { return sql_; }
+
+  void set_plan(std::shared_ptr<const CachedPlan> plan) { plan_ = std::move(plan); }
+  const std::shared_ptr<const CachedPlan> &plan() const { return plan_; }
+
+  static RC create(const PrepareSqlNode &prepare, Stmt *&stmt)
+  {
+    if (prepare.name.empty() || prepare.sql.empty()) {
+      return RC::INVALID_ARGUMENT;
+    }
+    stmt = new PrepareStmt(prepare.name, prepare.sql);
+    return RC::SUCCESS;
+  }
+
+private:
+  std::string name_;
+  std::string sql_;
+  std::shared_ptr<const CachedPlan> plan_;
+};
+
+/**
+ * @brief EXECUTE 语句，使用给定的参数执行 PREPARE 过的语句
+ * @ingroup Statement
+ */
+class ExecuteStmt : public Stmt
+{
+public:
+  ExecuteStmt(const std::string &name, const std::vector<Value> &params) : name_(name), params_(params) {}
+  virtual ~ExecuteStmt() = default;
+
+  StmtType type() const override { return StmtType::EXECUTE; }
+
+  const std::string &name() const { return name_; }
+  const std::vector<Value> &params() const { return params_; }
+
+  static RC create(const ExecuteSqlNode &execute, Stmt *&stmt)
+  {
+    stmt = new ExecuteStmt(execute.name, execute.params);
+    return RC::SUCCESS;
+  }
+
+private:
+  std::string name_;
+  std::vector<Value> params_;
+};
+
+/**
+ * @brief DEALLOCATE PREPARE 语句
+ * @ingroup Statement
+ */
+class DeallocatePrepareStmt : public Stmt
+{
+public:
+  explicit DeallocatePrepareStmt(const std::string &name) : name_(name) {}
+  virtual ~DeallocatePrepareStmt() = default;
+
+  StmtType type() const override { return StmtType::DEALLOCATE_PREPARE; }
+
+  const std::string &name() const { return name_; }
+
+  static RC create(const DeallocateSqlNode &deallocate, Stmt *&stmt)
+  {
+    stmt = new DeallocatePrepareStmt(deallocate.name);
+    return RC::SUCCESS;
+  }
+
+private:
+  std::string name_;
+};
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "stmt.h"
+
+/**
+ * @brief RESET SESSION 语句，把会话恢复成刚建立连接时的状态
+ * @ingroup Statement
+ */
+class ResetSessionStmt : public Stmt
+{
+public:
+  ResetSessionStmt() = default;
+  virtual ~ResetSessionStmt() = default;
+
+  StmtType type() const override { return StmtType::RESET_SESSION; }
+
+  static RC create(Stmt *&stmt)
+  {
+    stmt = new ResetSessionStmt();
+    return RC::SUCCESS;
+  }
+};
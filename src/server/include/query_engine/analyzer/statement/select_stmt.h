@@ -71,6 +71,14 @@ public:
     return function_results_;
   }
 
+  int limit() const {
+    return limit_;
+  }
+
+  int offset() const {
+    return offset_;
+  }
+
 private:
 
   static RC analyze_tables_and_projects(
@@ -91,4 +99,6 @@ private:
   FilterStmt *having_stmt_ = nullptr;
   OrderByStmt *order_stmt_ = nullptr;
   std::vector<FuncResult> function_results_;
+  int limit_ = -1;  ///< 小于0表示没有limit
+  int offset_ = 0;
 };
@@ -32,6 +32,7 @@ class Db;
   DEFINE_ENUM_ITEM(SYNC)            \
   DEFINE_ENUM_ITEM(SHOW_TABLES)     \
   DEFINE_ENUM_ITEM(DESC_TABLE)      \
+  DEFINE_ENUM_ITEM(ANALYZE_TABLE)   \
   DEFINE_ENUM_ITEM(BEGIN)           \
   DEFINE_ENUM_ITEM(COMMIT)          \
   DEFINE_ENUM_ITEM(ROLLBACK)        \
@@ -42,7 +43,11 @@ class Db;
   DEFINE_ENUM_ITEM(PREDICATE)       \
   DEFINE_ENUM_ITEM(SET_VARIABLE)    \
   DEFINE_ENUM_ITEM(GROUP_BY)        \
-  DEFINE_ENUM_ITEM(CREATE_VIEW)
+  DEFINE_ENUM_ITEM(CREATE_VIEW)     \
+  DEFINE_ENUM_ITEM(PREPARE)         \
+  DEFINE_ENUM_ITEM(EXECUTE)         \
+  DEFINE_ENUM_ITEM(DEALLOCATE_PREPARE) \
+  DEFINE_ENUM_ITEM(RESET_SESSION)
 
 enum class StmtType {
   #define DEFINE_ENUM_ITEM(name)  name,
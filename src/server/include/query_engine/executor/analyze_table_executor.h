@@ -0,0 +1,18 @@
+#pragma once
+
+#include "include/common/rc.h"
+
+class QueryInfo;
+
+/**
+ * @brief 执行 ANALYZE 语句，重新计算统计信息后把每一列的统计结果返回给客户端
+ * @ingroup Executor
+ */
+class AnalyzeTableExecutor
+{
+public:
+  AnalyzeTableExecutor() = default;
+  virtual ~AnalyzeTableExecutor() = default;
+
+  RC execute(QueryInfo *query_info);
+};
@@ -12,7 +12,13 @@
 
 class Executor{
     public:
+        /**
+         * @brief 执行语句并发送结果
+         * @details 缓存的结果超过连接的发送窗口时在两行之间暂停，返回 SEND_PAUSED，结果集保持打开
+         */
         RC execute(SessionRequest *request, QueryInfo *queryInfo, bool &need_disconnect);
-    private:
-        size_t min_width = 0;
+        /**
+         * @brief 继续发送暂停的结果，可能再次暂停
+         */
+        RC resume(SessionRequest *request, bool &need_disconnect);
 };
\ No newline at end of file
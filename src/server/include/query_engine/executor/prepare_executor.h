@@ -0,0 +1,46 @@
+#pragma once
+
+#include "include/common/rc.h"
+#include "include/query_engine/analyzer/statement/prepare_stmt.h"
+#include "include/query_engine/structor/query_info.h"
+#include "include/session/session.h"
+
+/**
+ * @brief PREPARE 语句的执行器，把查询引擎生成的计划保存到会话中
+ * @ingroup Executor
+ */
+class PrepareExecutor
+{
+ public:
+  PrepareExecutor() = default;
+  virtual ~PrepareExecutor() = default;
+
+  RC execute(QueryInfo *query_info)
+  {
+    auto *prepare_stmt = static_cast<PrepareStmt *>(query_info->stmt());
+    if (prepare_stmt->plan() == nullptr) {
+      return RC::INTERNAL;
+    }
+    Session *session = query_info->session_event()->session();
+    session->add_prepared_stmt(prepare_stmt->name(), prepare_stmt->plan());
+    return RC::SUCCESS;
+  }
+};
+
+/**
+ * @brief DEALLOCATE PREPARE 语句的执行器
+ * @ingroup Executor
+ */
+class DeallocatePrepareExecutor
+{
+ public:
+  DeallocatePrepareExecutor() = default;
+  virtual ~DeallocatePrepareExecutor() = default;
+
+  RC execute(QueryInfo *query_info)
+  {
+    auto *deallocate_stmt = static_cast<DeallocatePrepareStmt *>(query_info->stmt());
+    Session *session = query_info->session_event()->session();
+    return session->remove_prepared_stmt(deallocate_stmt->name()) ? RC::SUCCESS : RC::NOTFOUND;
+  }
+};
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "include/common/rc.h"
+#include "include/query_engine/structor/query_info.h"
+#include "include/session/session.h"
+#include "include/session/session_request.h"
+
+/**
+ * @brief RESET SESSION 的执行器
+ * @details 回滚还没有结束的事务，清除会话变量与PREPARE的语句，当前数据库恢复为默认数据库。
+ * 客户端复用连接之前执行一次，就不需要重新建立连接
+ * @ingroup Executor
+ */
+class ResetSessionExecutor
+{
+public:
+  ResetSessionExecutor() = default;
+  virtual ~ResetSessionExecutor() = default;
+
+  RC execute(QueryInfo *query_info)
+  {
+    Session *session = query_info->session_event()->session();
+    return session->reset();
+  }
+};
@@ -42,6 +42,15 @@ public:
   {
     return tuple_schema_;
   }
+  /// 文本协议中每一列补齐到的宽度
+  void set_column_width(size_t width)
+  {
+    column_width_ = width;
+  }
+  size_t column_width() const
+  {
+    return column_width_;
+  }
   RC return_code() const
   {
     return return_code_;
@@ -62,6 +71,7 @@ private:
   Session *session_ = nullptr; ///< 当前所属会话
   std::unique_ptr<PhysicalOperator> operator_;  ///< 执行计划
   TupleSchema tuple_schema_;   ///< 返回的表头信息。可能有也可能没有
+  size_t column_width_ = 0;
   RC return_code_ = RC::SUCCESS;
   std::string state_string_;
 };
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "include/common/rc.h"
+#include "rewrite_rule.h"
+
+/**
+ * @brief 常量折叠
+ * @ingroup Rewriter
+ * @details 算术运算的操作数都是常量时，在优化阶段直接计算出结果，比如 a > 1 + 2 改写成 a > 3。
+ * 表达式重写是自底向上进行的，所以嵌套的常量运算会一次折叠完成
+ */
+class ArithmeticSimplificationRule : public ExpressionRewriteRule
+{
+public:
+  ArithmeticSimplificationRule() = default;
+  virtual ~ArithmeticSimplificationRule() = default;
+
+  RC rewrite(std::unique_ptr<Expression> &expr, bool &change_made) override;
+};
@@ -10,6 +10,11 @@ class LogicalNode;
  * @ingroup Rewriter
  * @details 如果有简单的比较运算，比如比较的两边都是常量，那我们就可以在运行执行计划之前就知道结果，
  * 进而直接将表达式改成结果，这样就可以减少运行时的计算量。
+ * 另外还会处理这些情况：
+ * - 与 NULL 常量的大小比较恒为假；
+ * - 不允许为空的字段上的 IS NULL 恒为假，IS NOT NULL 恒为真；
+ * - 常量 op 字段 改写成 字段 op' 常量，后面的索引选择与代价估计只需要处理一种形式；
+ * - 常量列表上的 IN 与 EXISTS 直接计算，只有一个值的 IN 改写成等值比较。
  */
 class ComparisonSimplificationRule : public ExpressionRewriteRule 
 {
@@ -7,7 +7,8 @@ class LogicalNode;
 /**
  * @brief 简化多个表达式联结的运算
  * @ingroup Rewriter
- * @details 比如只有一个表达式，或者表达式可以直接出来
+ * @details 比如只有一个表达式，或者表达式可以直接计算出来。
+ * 同时会展开嵌套的同类连接，并检查 AND 连接的字段范围条件是否矛盾
  */
 class ConjunctionSimplificationRule : public ExpressionRewriteRule 
 {
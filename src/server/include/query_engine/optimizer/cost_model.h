@@ -0,0 +1,81 @@
+#pragma once
+
+#include "include/query_engine/planner/node/logical_node.h"
+
+class Table;
+class Index;
+class IndexMeta;
+class Field;
+class TableGetLogicalNode;
+
+/// 顺序读取一个页面的代价，其它代价都以它为单位
+#define SEQ_PAGE_COST 1.0
+/// 随机读取一个页面的代价，索引查找与回表都按随机读计算
+#define RANDOM_PAGE_COST 4.0
+/// 处理一行数据的代价
+#define CPU_TUPLE_COST 0.01
+/// 计算一次表达式(比如比较运算)的代价
+#define CPU_OPERATOR_COST 0.0025
+/// 探测哈希表时每行数据的额外代价
+#define HASH_TUPLE_COST 0.005
+/// 构建哈希表时每行数据的额外代价，要编码整行数据并插入哈希表，比探测更贵，构建侧应该是小的一边
+#define HASH_BUILD_COST 0.01
+
+/// 哈希连接的哈希表只能放在内存中，估计的大小超过这个值时不使用哈希连接
+#define HASH_JOIN_MEMORY_LIMIT (64L * 1024 * 1024)
+
+/// 没有统计信息也无法从数据页面推算时使用的表行数
+#define DEFAULT_TABLE_ROWS 1000.0
+
+/**
+ * @brief 代价模型
+ * @details 代价由页面 I/O 与逐行的 CPU 代价组成。表的行数、页面数以及列的统计信息来自 ANALYZE，
+ * 没有统计信息时行数从数据页面数推算，选择率使用默认值
+ */
+class CostModel
+{
+public:
+  /// 表的估计行数
+  static double table_rows(const Table *table);
+  /// 表的数据页面数
+  static double table_pages(const Table *table);
+  /// 一行数据占用的字节数，估计哈希表的内存使用时用到
+  static double row_width(const Table *table);
+
+  /// 字段上不同值的个数，没有统计信息时假设每一行都不同
+  static double column_ndv(const Field &field);
+
+  /**
+   * @brief 估计条件的选择率
+   * @details 支持字段与常量的比较、字段之间的等值比较以及 AND/OR，其它条件使用默认值
+   */
+  static double selectivity(const Expression *expr);
+
+  /// 按照统计信息判断是否应该放弃索引而使用全表扫描，并估计单表访问的行数与代价
+  static void estimate_table_get(TableGetLogicalNode &table_get);
+
+  static double nested_loop_join_cost(double left_rows, double left_cost, double right_rows, double right_cost);
+  static double hash_join_cost(double left_rows, double left_cost, double right_rows, double right_cost);
+  static double merge_join_cost(double left_rows, double left_cost, double right_rows, double right_cost);
+  /**
+   * @brief 索引嵌套循环连接的代价
+   * @param matches 每次探测返回的行数
+   * @param index_pages 探测一次需要读取的索引页面数(即 B+ 树的高度)
+   */
+  static double index_nested_loop_join_cost(double left_rows, double left_cost, double matches, double index_pages);
+
+  /// 在有 rows 个索引项的 B+ 树中查找一次需要读取的页面数
+  static double index_height(double rows);
+
+  /// 用索引做一次等值查找需要读取的索引页面数
+  static double index_lookup_pages(const IndexMeta &index_meta, double rows);
+
+  /// 外部排序的代价
+  static double sort_cost(double rows);
+
+  /**
+   * @brief 自底向上为逻辑计划中的每个节点估计行数与代价
+   * @details 已经由连接枚举估计过的节点不会重新计算
+   */
+  static void estimate(LogicalNode &node);
+};
@@ -7,6 +7,14 @@
 #include "include/query_engine/structor/expression/expression.h"
 #include "rewrite_rule.h"
 
+class TableGetLogicalNode;
+
+/**
+ * @brief 化简执行计划中的表达式
+ * @ingroup Rewriter
+ * @details 包括算子自身的表达式、表扫描上的谓词与连接条件。先化简子表达式，再对当前表达式应用各个化简规则。
+ * 只处理当前算子，子算子由 Rewriter 遍历
+ */
 class ExpressionRewriter : public RewriteRule 
 {
 public:
@@ -17,6 +25,9 @@ public:
 
 private:
   RC rewrite_expression(std::unique_ptr<Expression> &expr, bool &change_made);
+  RC rewrite_binary_children(
+      std::unique_ptr<Expression> &left_expr, std::unique_ptr<Expression> &right_expr, bool &change_made);
+  RC rewrite_table_get_predicates(TableGetLogicalNode &table_get, bool &change_made);
 
 private:
   std::vector<std::unique_ptr<ExpressionRewriteRule>> expr_rewrite_rules_;
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <memory>
+
+#include "include/common/rc.h"
+#include "include/query_engine/planner/node/logical_node.h"
+
+/// 参与连接的表不超过这个数目时使用动态规划枚举连接顺序，否则使用贪心算法
+#define JOIN_DP_MAX_TABLES 10
+
+/// 一组连接中最多支持的表的个数，超过时保持原来的连接顺序
+#define JOIN_MAX_TABLES 32
+
+/**
+ * @brief 基于代价的连接顺序与连接方式选择
+ * @details 从逻辑计划中找出由连接节点与单表节点组成的子树，把其中所有的连接条件按照 AND 拆开，
+ * 在表的子集上做动态规划(表太多时使用贪心算法)，枚举包括 bushy 树在内的连接树，
+ * 并为每一次连接选择嵌套循环、哈希、归并与索引嵌套循环连接中代价最低的一种。
+ * 优先连接有条件相关的两组表，只有不存在这样的连接顺序时才考虑笛卡尔积。
+ * 每个条件都放在能够计算它的最低的连接上
+ */
+class JoinReorder
+{
+public:
+  RC rewrite(std::unique_ptr<LogicalNode> &node);
+
+private:
+  RC reorder(std::unique_ptr<LogicalNode> &join_root);
+};
@@ -4,10 +4,18 @@
 
 #include "include/query_engine/planner/node/logical_node.h"
 #include "rewriter.h"
+#include "join_reorder.h"
 
 class Optimizer{
 public:
     RC rewrite(std::unique_ptr<LogicalNode> &logical_operator);
+
+    /**
+     * @brief 基于代价的优化，在规则重写之后执行
+     * @details 选择连接顺序与连接方式，并为每个逻辑节点估计输出行数与代价
+     */
+    RC optimize(std::unique_ptr<LogicalNode> &logical_operator);
 private:
     Rewriter rewriter_;
-};
\ No newline at end of file
+    JoinReorder join_reorder_;
+};
@@ -3,12 +3,16 @@
 #include <vector>
 #include "rewrite_rule.h"
 
+class TableGetLogicalNode;
+
 /**
- * @brief 将一些谓词表达式下推到表数据扫描中
+ * @brief 将一些谓词表达式下推到表数据扫描与连接中
  * @ingroup Rewriter
- * @details 这样可以提前过滤一些数据
+ * @details 这样可以提前过滤一些数据。谓词下面是由连接和单表节点组成的子树时，
+ * 按照 AND 拆开谓词，只涉及一张表的条件下推到这张表的扫描上，涉及多张表的条件变成连接条件，
+ * 无法确定引用了哪些表的条件(比如子查询)保留在原来的位置
  */
-class PredicatePushdownRewriter : public RewriteRule 
+class PredicatePushdownRewriter : public RewriteRule
 {
 public:
   PredicatePushdownRewriter() = default;
@@ -17,6 +21,6 @@ public:
   RC rewrite(std::unique_ptr<LogicalNode> &oper, bool &change_made) override;
 
 private:
-  RC get_exprs_can_pushdown(
-      std::unique_ptr<Expression> &expr, std::vector<std::unique_ptr<Expression>> &pushdown_exprs);
+  void derive_equalities(LogicalNode *join_tree, const std::vector<TableGetLogicalNode *> &table_gets,
+      std::vector<std::unique_ptr<Expression>> &conjuncts);
 };
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class Field;
+class Expression;
+class LogicalNode;
+class TableGetLogicalNode;
+
+/// 用位图表示一组表，第 i 位对应第 i 个单表节点
+using RelSet = uint32_t;
+
+/// 位图能够表示的最多的表的个数
+#define REL_SET_MAX_TABLES 32
+
+inline bool subset_of(RelSet sub, RelSet set) { return (sub & ~set) == 0; }
+
+/// 字段属于哪个单表节点。别名相同的表才是同一个节点，找不到或者有歧义时返回 -1
+int field_owner(const Field &field, const std::vector<TableGetLogicalNode *> &leaves);
+
+/**
+ * @brief 计算表达式引用了哪些表
+ * @details 含有子查询、聚合、外层查询的字段等无法确定引用关系的表达式时返回false
+ */
+bool referenced_tables(Expression *expr, const std::vector<TableGetLogicalNode *> &leaves, RelSet &tables);
+
+/// 把 AND 连接的条件拆开，恒为真的常量条件直接丢弃
+void split_conjuncts(std::unique_ptr<Expression> expr, std::vector<std::unique_ptr<Expression>> &conjuncts);
+
+/// 把拆开的条件重新用 AND 连接起来，没有条件时返回空指针
+std::unique_ptr<Expression> merge_conjuncts(std::vector<std::unique_ptr<Expression>> &conjuncts);
+
+/**
+ * @brief 是否是只由连接节点和单表节点组成的子树
+ * @param leaves 按照从左到右的顺序收集到的单表节点
+ */
+bool is_join_tree(LogicalNode *node, std::vector<TableGetLogicalNode *> &leaves);
@@ -14,7 +14,7 @@ class LogicalNode;
 /**
  * @brief 根据一些规则对逻辑计划进行重写
  * @ingroup Rewriter
- * @details 当前仅实现了一两个非常简单的规则。
+ * @details 包括表达式的常量折叠与化简、去掉恒为真的过滤算子以及谓词下推。
  * 重写包括对逻辑计划和计划中包含的表达式。
  */
 class Rewriter 
@@ -79,6 +79,7 @@ enum class ConjunctionType {
 struct WhereConditions {
   ConjunctionType           type = ConjunctionType::AND;
   std::vector<ConditionSqlNode>   conditions;
+  bool                      has_range = false;  ///< 包含 BETWEEN 展开的条件，只能与 AND 一起使用
 };
 
 /**
@@ -103,6 +104,17 @@ struct JoinSqlNode
   std::vector<ConditionSqlNode> join_conditions; //join condition
 };
 
+/**
+ * @brief 描述一个 limit 结构
+ * @ingroup SQLParser
+ * @details limit 小于0表示没有限制返回的行数
+ */
+struct LimitSqlNode
+{
+  int limit  = -1;  ///< 最多返回多少行
+  int offset = 0;   ///< 跳过前面多少行
+};
+
 enum AggrType
 {
   AGGR_COUNT,         ///< count
@@ -153,6 +165,7 @@ struct SelectSqlNode
   std::vector<RelAttrSqlNode>     group_by_attributes; ///< group by 属性
   WhereConditions                 having_conditions; /// < group by 条件
   std::vector<OrderByNode>        order_lists;   ///< order 列表
+  LimitSqlNode                    limit;         ///< limit/offset
   std::vector<FunctionUnit>       functions;     ///< function 列表
 };
 //struct SelectFunctionNode
@@ -271,6 +284,7 @@ struct CreateIndexSqlNode
   std::string relation_name;   ///< Relation name
   std::vector<std::string> multi_attribute_names;
   bool is_unique_;
+  std::string index_type;      ///< USING 指定的索引类型，为空表示默认的B+树
 };
 
 /**
@@ -293,6 +307,16 @@ struct DescTableSqlNode
   std::string relation_name;
 };
 
+/**
+ * @brief 描述一个analyze语句
+ * @ingroup SQLParser
+ * @details 重新计算表的统计信息，没有指定表名时分析当前数据库中的所有表
+ */
+struct AnalyzeTableSqlNode
+{
+  std::string relation_name;
+};
+
 /**
  * @brief 描述一个load data语句
  * @ingroup SQLParser
@@ -317,6 +341,37 @@ struct SetVariableSqlNode
 
 class ParsedSqlNode;
 
+/**
+ * @brief 描述一个prepare语句
+ * @ingroup SQLParser
+ * @details PREPARE name FROM 'sql'，sql 中可以使用 ? 作为参数占位符
+ */
+struct PrepareSqlNode
+{
+  std::string name;
+  std::string sql;
+};
+
+/**
+ * @brief 描述一个execute语句
+ * @ingroup SQLParser
+ * @details EXECUTE name [USING value, ...]，参数按照占位符出现的顺序绑定
+ */
+struct ExecuteSqlNode
+{
+  std::string        name;
+  std::vector<Value> params;
+};
+
+/**
+ * @brief 描述一个deallocate prepare语句
+ * @ingroup SQLParser
+ */
+struct DeallocateSqlNode
+{
+  std::string name;
+};
+
 /**
  * @brief 描述一个explain语句
  * @ingroup SQLParser
@@ -363,6 +418,7 @@ enum SqlCommandFlag
   SCF_SYNC,
   SCF_SHOW_TABLES,
   SCF_DESC_TABLE,
+  SCF_ANALYZE_TABLE,
   SCF_BEGIN,        ///< 事务开始语句，可以在这里扩展只读事务
   SCF_COMMIT,
   SCF_CLOG_SYNC,
@@ -372,6 +428,10 @@ enum SqlCommandFlag
   SCF_EXIT,
   SCF_EXPLAIN,
   SCF_SET_VARIABLE, ///< 设置变量
+  SCF_PREPARE,
+  SCF_EXECUTE,
+  SCF_DEALLOCATE_PREPARE,
+  SCF_RESET_SESSION,  ///< 重置会话：回滚未结束的事务，清除会话变量与PREPARE的语句
 };
 /**
  * @brief 表示一个SQL语句
@@ -394,9 +454,13 @@ public:
   CreateIndexSqlNode        create_index;
   DropIndexSqlNode          drop_index;
   DescTableSqlNode          desc_table;
+  AnalyzeTableSqlNode       analyze_table;
   LoadDataSqlNode           load_data;
   ExplainSqlNode            explain;
   SetVariableSqlNode        set_variable;
+  PrepareSqlNode            prepare;
+  ExecuteSqlNode            execute;
+  DeallocateSqlNode         deallocate;
 
 public:
   ParsedSqlNode();
@@ -416,6 +480,12 @@ public:
     return sql_nodes_;
   }
 
+  /// 为新出现的参数占位符分配序号
+  int next_param_index() { return param_count_++; }
+  /// 语句中参数占位符的个数
+  int param_count() const { return param_count_; }
+
 private:
   std::vector<std::unique_ptr<ParsedSqlNode>> sql_nodes_;  ///< 这里记录SQL命令。虽然看起来支持多个，但是当前仅处理一个
+  int param_count_ = 0;
 };
@@ -7,4 +7,17 @@
 
 namespace Parser {
     RC parse(QueryInfo *query_info);
+
+    /**
+     * @brief 只做语法解析与基本的检查，不修改请求的结果
+     * @param param_count 语句中参数占位符的个数
+     * @return 没有解析出任何语句时返回 RC::INTERNAL
+     */
+    RC parse(const std::string &sql, std::unique_ptr<ParsedSqlNode> &sql_node, int &param_count);
+
+    /**
+     * @brief 把一个消息中用分号分隔的多条语句拆开
+     * @details 引号中的分号不算，与词法分析一样字符串中没有转义。每条语句保留结尾的分号，空白的语句会被忽略
+     */
+    void split(const std::string &sql, std::vector<std::string> &statements);
 }
\ No newline at end of file
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "value.h"
+
+/**
+ * @brief 把SQL中的常量替换成参数占位符，得到计划缓存使用的规范化SQL
+ * @ingroup SQLParser
+ * @details 只处理 select/update/delete 语句中 WHERE、ON、SET 后面的数字与字符串常量，
+ * 结果与词法分析器产生的值相同。IN 后面的常量列表、算术运算中的常量、LIMIT 后面的数字
+ * 在语法上不能换成占位符(或者换掉之后会失去常量折叠)，保持原样。
+ * 连续的空白字符合并成一个空格，所以只有空白不同的SQL会得到同一个结果
+ */
+class SqlNormalizer
+{
+public:
+  /**
+   * @brief 规范化SQL
+   * @param normalized 替换之后的SQL
+   * @param params     被替换掉的常量，按照在SQL中出现的顺序排列
+   * @return 不能或者不需要使用计划缓存的SQL返回false，比如其它类型的语句、已经含有占位符、有词法错误或者日期无效
+   */
+  static bool normalize(const std::string &sql, std::string &normalized, std::vector<Value> &params);
+};
@@ -19,6 +19,8 @@ public:
     return LogicalNodeType::AGGR;
   }
 
+  std::unique_ptr<LogicalNode> clone() const override;
+
   const std::vector<std::unique_ptr<Expression>> &expressions() const  {
     return expressions_;
   }
@@ -27,6 +29,12 @@ public:
   const std::vector<AggrType> _aggr_types_() const {return aggr_types_; }
   const std::vector<Field> _aggr_fields_() const { return aggr_fields_; }
 
+protected:
+  AggrLogicalNode() = default;
+
+  /// 复制聚合的描述信息，供 clone 使用
+  void copy_aggr_to(AggrLogicalNode &node) const;
+
 protected:
   std::vector<std::string> alias_;
   std::vector<AggrType> aggr_types_;
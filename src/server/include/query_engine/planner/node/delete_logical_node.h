@@ -21,6 +21,8 @@ public:
     return table_;
   }
 
+  std::unique_ptr<LogicalNode> clone() const override;
+
 private:
   Table *table_ = nullptr;
 };
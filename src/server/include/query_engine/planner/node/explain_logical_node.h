@@ -17,5 +17,10 @@ public:
     return LogicalNodeType::EXPLAIN;
   }
 
+  std::unique_ptr<LogicalNode> clone() const override
+  {
+    return clone_to(std::make_unique<ExplainLogicalNode>());
+  }
+
 private:
 };
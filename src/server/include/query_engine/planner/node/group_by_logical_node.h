@@ -18,4 +18,9 @@ public:
   LogicalNodeType type() const override {
     return LogicalNodeType::GROUP_BY;
   }
+
+  std::unique_ptr<LogicalNode> clone() const override;
+
+private:
+  GroupByLogicalNode() = default;
 };
@@ -16,6 +16,8 @@ public:
     return LogicalNodeType::INSERT;
   }
 
+  std::unique_ptr<LogicalNode> clone() const override;
+
   Table *table() const { return table_; }
 
   std::vector<std::vector<Value>> & multi_values() { return multi_values_; }
@@ -1,9 +1,22 @@
 #pragma once
 
- #include <memory>
+#include <memory>
+#include <vector>
 #include "logical_node.h"
 
-//TODO [Lab3] 请根据需要实现自己的JoinLogicalNode，当前实现仅为建议实现
+class Index;
+
+/**
+ * @brief 连接的执行方式，由优化器根据代价选择
+ */
+enum class JoinMethod
+{
+  NESTED_LOOP,        ///< 嵌套循环，每一行左表数据重新扫描一次右子树
+  HASH,               ///< 使用右子树的数据构建哈希表，左子树逐行探测
+  MERGE,              ///< 两边按照连接键排序之后归并
+  INDEX_NESTED_LOOP,  ///< 每一行左表数据通过右表上的索引查找匹配的行
+};
+
 class JoinLogicalNode : public LogicalNode
 {
 public:
@@ -15,16 +28,39 @@ public:
     return LogicalNodeType::JOIN;
   }
 
+  std::unique_ptr<LogicalNode> clone() const override;
+
   void set_condition(std::unique_ptr<Expression> &&condition)
   {
     condition_ = std::move(condition);
   }
 
+  /// 连接条件。使用哈希或者归并连接时，这里只剩下连接键之外的其它条件
   std::unique_ptr<Expression> &condition()
   {
     return condition_;
   }
+
+  void set_method(JoinMethod method) { method_ = method; }
+  JoinMethod method() const { return method_; }
+
+  /**
+   * @brief 等值连接键
+   * @details left_keys 中的表达式只引用左子树中的表，right_keys 只引用右子树中的表，按下标一一对应。
+   * 索引嵌套循环连接只有一个键，右边的键就是索引字段
+   */
+  std::vector<std::unique_ptr<Expression>> &left_keys() { return left_keys_; }
+  std::vector<std::unique_ptr<Expression>> &right_keys() { return right_keys_; }
+
+  /// 索引嵌套循环连接时，右子树(一定是单表)上使用的索引
+  void set_index(Index *index) { index_ = index; }
+  Index *index() const { return index_; }
+
 private:
-  // Join的条件，目前只支持等值连接
   std::unique_ptr<Expression> condition_;
+
+  JoinMethod method_ = JoinMethod::NESTED_LOOP;
+  std::vector<std::unique_ptr<Expression>> left_keys_;
+  std::vector<std::unique_ptr<Expression>> right_keys_;
+  Index *index_ = nullptr;
 };
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "logical_node.h"
+
+/**
+ * @brief limit/offset 逻辑算子
+ * @details limit 小于0表示不限制输出的行数
+ */
+class LimitLogicalNode : public LogicalNode
+{
+public:
+  LimitLogicalNode(int limit, int offset);
+  ~LimitLogicalNode() override = default;
+
+  LogicalNodeType type() const override
+  {
+    return LogicalNodeType::LIMIT;
+  }
+
+  std::unique_ptr<LogicalNode> clone() const override;
+
+  int limit() const { return limit_; }
+  int offset() const { return offset_; }
+
+private:
+  int limit_ = -1;
+  int offset_ = 0;
+};
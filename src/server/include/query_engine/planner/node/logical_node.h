@@ -17,7 +17,8 @@ enum class LogicalNodeType
   DELETE,     ///< 删除，删除可能会有子查询
   UPDATE,     ///< 更新
   EXPLAIN,    ///< 查看执行计划
-  GROUP_BY    ///< Group By
+  GROUP_BY,   ///< Group By
+  LIMIT       ///< limit/offset
 };
 
 class LogicalNode
@@ -28,6 +29,12 @@ public:
 
   virtual LogicalNodeType type() const = 0;
 
+  /**
+   * @brief 复制以当前节点为根的整棵逻辑计划树
+   * @details 生成物理计划时会取走逻辑节点中的表达式，计划缓存中的计划每次使用前都要先复制一份
+   */
+  virtual std::unique_ptr<LogicalNode> clone() const = 0;
+
   void add_child(std::unique_ptr<LogicalNode> oper);
   std::vector<std::unique_ptr<LogicalNode>> &children()
   {
@@ -38,9 +45,28 @@ public:
     return expressions_;
   }
 
+  /**
+   * @brief 优化器估计的输出行数与执行代价
+   * @details 代价包括所有子节点的代价。小于0表示没有估计过
+   */
+  void set_estimate(double rows, double cost)
+  {
+    estimated_rows_ = rows;
+    estimated_cost_ = cost;
+  }
+  double estimated_rows() const { return estimated_rows_; }
+  double estimated_cost() const { return estimated_cost_; }
+
+protected:
+  /// 把子树、表达式以及代价估计复制到 node 中，由子类的 clone 调用
+  std::unique_ptr<LogicalNode> clone_to(std::unique_ptr<LogicalNode> node) const;
+
 protected:
   std::vector<std::unique_ptr<LogicalNode>> children_;  ///< 子算子
   ///< 表达式，比如select中的列，where中的谓词等等，都可以使用表达式来表示
   ///< 表达式能是一个常量，也可以是一个函数，也可以是一个列，也可以是一个子查询等等
   std::vector<std::unique_ptr<Expression>> expressions_;    
+
+  double estimated_rows_ = -1;
+  double estimated_cost_ = -1;
 };
@@ -14,6 +14,8 @@ public:
   {
     return LogicalNodeType::ORDER;
   }
+  /// 排序单元属于 OrderByStmt，复制出的节点与原节点共用它们
+  std::unique_ptr<LogicalNode> clone() const override;
   std::vector<OrderByUnit *> order_units() {
     return order_units_;
   }
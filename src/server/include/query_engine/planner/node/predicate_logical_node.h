@@ -16,4 +16,6 @@ public:
   LogicalNodeType type() const override {
     return LogicalNodeType::PREDICATE;
   }
+
+  std::unique_ptr<LogicalNode> clone() const override;
 };
@@ -23,6 +23,10 @@ public:
     return LogicalNodeType::PROJECTION;
   }
 
+  std::unique_ptr<LogicalNode> clone() const override {
+    return clone_to(std::make_unique<ProjectLogicalNode>(std::vector<Expression *>()));
+  }
+
   const std::vector<std::unique_ptr<Expression>> &expressions() const {
     return expressions_;
   }
@@ -14,6 +14,8 @@ public:
     return LogicalNodeType::TABLE_GET;
   }
 
+  std::unique_ptr<LogicalNode> clone() const override;
+
   Table *table() const  { return table_; }
   std::string table_alias() const { return table_alias_; }
   bool readonly() const { return readonly_; }
@@ -24,6 +26,32 @@ public:
     return predicates_;
   }
 
+  /**
+   * @brief 要求按照某个索引的顺序输出数据
+   * @details 上层的 order by + limit 可以直接利用索引的有序性，在输出足够的行之后就停止扫描
+   */
+  void set_ordered_index(Index *index) { ordered_index_ = index; }
+  Index *ordered_index() const { return ordered_index_; }
+
+  /**
+   * @brief 查询中用到的当前表的所有字段
+   * @details 只有能够确定所有用到的字段时才会设置，用于判断能否只扫描索引而不读取数据页面
+   */
+  void set_used_fields(std::vector<std::string> &&fields)
+  {
+    used_fields_       = std::move(fields);
+    used_fields_known_ = true;
+  }
+  bool used_fields_known() const { return used_fields_known_; }
+  const std::vector<std::string> &used_fields() const { return used_fields_; }
+
+  /**
+   * @brief 优化器根据统计信息估计出全表扫描比索引扫描的代价更低
+   * @details 没有统计信息时不会设置，仍然按照规则选择索引
+   */
+  void set_prefer_table_scan(bool prefer) { prefer_table_scan_ = prefer; }
+  bool prefer_table_scan() const { return prefer_table_scan_; }
+
 private:
   Table *table_ = nullptr;
   std::string table_alias_;
@@ -31,8 +59,15 @@ private:
   bool readonly_ = false;
 
   // 与当前表相关的过滤操作，可以尝试在遍历数据时执行
-  // 这里的表达式都是比较简单的比较运算，并且左右两边都是取字段表达式或值表达式
-  // 不包含复杂的表达式运算，比如加减乘除、或者conjunction expression
+  // 这里的表达式只引用当前表的字段，可以是任意的运算，比如加减乘除、或者conjunction expression
+  // 选择索引时只考虑字段与常量的比较
   // 如果有多个表达式，他们的关系都是 AND
   std::vector<std::unique_ptr<Expression>> predicates_;
+
+  Index *ordered_index_ = nullptr;
+
+  std::vector<std::string> used_fields_;
+  bool used_fields_known_ = false;
+
+  bool prefer_table_scan_ = false;
 };
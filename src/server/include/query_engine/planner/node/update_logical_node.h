@@ -16,6 +16,8 @@ public:
   {
     return LogicalNodeType::UPDATE;
   }
+
+  std::unique_ptr<LogicalNode> clone() const override;
   Table *table() const {
     return table_;
   }
@@ -4,10 +4,38 @@
 #include "include/query_engine/planner/node/aggr_logical_node.h"
 #include "include/query_engine/structor/tuple/aggregation_tuple.h"
 
+/**
+ * @brief 聚合的中间状态
+ * @details 并行执行时每个线程各自维护一份中间状态，最后合并到一起
+ */
+class Aggregator
+{
+public:
+  Aggregator(const std::vector<AggrType> &aggr_types, const std::vector<Field> &aggr_fields);
+
+  void init();
+  RC   update(const Tuple &tuple);
+  void merge(const Aggregator &other);
+  void finish(std::vector<std::string> &alias, AggrTuple &tuple);
+
+private:
+  static void aggr_update(AggrType aggr_type, Value &aggr_result, const Value &value);
+
+private:
+  const std::vector<AggrType> &aggr_types_;
+  const std::vector<Field>    &aggr_fields_;
+
+  std::vector<Value> aggr_results_;
+  std::vector<bool>  all_null_;
+  std::vector<int>   counts_;
+};
+
+class ExchangePhysicalOperator;
+
 class AggrPhysicalOperator : public PhysicalOperator
 {
 public:
-  AggrPhysicalOperator(AggrLogicalNode *logical_operator) {
+  AggrPhysicalOperator(AggrLogicalNode *logical_operator) : aggregator_(aggr_types_, aggr_fields_) {
     for (int i = 0; i < logical_operator->_alias_().size(); i++) {
       alias_.emplace_back(logical_operator->_alias_()[i]);
       aggr_types_.emplace_back(logical_operator->_aggr_types_()[i]);
@@ -34,17 +62,18 @@ public:
 
   Tuple *current_tuple() override;
 
+private:
+  /**
+   * @brief 子算子是 exchange 时，每个并行的流水线各自做部分聚合，再合并结果
+   */
+  RC parallel_aggregate(ExchangePhysicalOperator &exchange);
+
 private:
   std::vector<std::string> alias_;
   std::vector<AggrType> aggr_types_;
   std::vector<Field> aggr_fields_;
 
-  std::vector<Value> aggr_results_;
-  std::vector<bool> all_null_;
-  std::vector<int> counts_;
-  bool is_first_called_;
+  Aggregator aggregator_;
+  bool is_first_called_ = true;
   AggrTuple tuple_;
-  void aggr_init();
-  void aggr_update(AggrType aggr_type, Value& aggr_result, Value& value);
-  void aggr_done();
-};
\ No newline at end of file
+};
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "physical_operator.h"
+#include "include/common/setting.h"
+
+class Table;
+
+/// 并行扫描时每一段(morsel)包含的页面个数
+#define MORSEL_PAGE_NUM 16
+
+/**
+ * @brief 并行扫描共享的页面段队列
+ * @details 表中已经分配的页面被切分成若干段，每个扫描线程处理完一段后再取下一段，
+ * 处理得快的线程自然会处理更多的段，不会因为数据分布不均匀而等待
+ */
+class MorselQueue
+{
+public:
+  MorselQueue() = default;
+
+  void reset(std::vector<std::pair<PageNum, PageNum>> &&morsels);
+  bool pop(PageNum &begin_page, PageNum &end_page);
+
+  /// 出错时让其它线程尽快停止
+  void cancel();
+
+  size_t size() const { return morsels_.size(); }
+
+private:
+  std::vector<std::pair<PageNum, PageNum>> morsels_;
+  std::atomic<size_t>                      next_{0};
+};
+
+/**
+ * @brief 并行执行的交换算子
+ * @ingroup PhysicalOperator
+ * @details 包含多条相同的流水线(扫描 + 过滤)，流水线中的扫描算子共享同一个 MorselQueue。
+ * execute 在工作线程池中同时运行所有流水线，每一行交给调用方提供的函数处理，比如做部分聚合，
+ * 当前线程也会运行一条流水线。按照普通算子调用 next 时只运行第一条流水线，它会扫描所有的数据。
+ * 第一条流水线作为 children_ 用于 explain 展示，其它流水线保存在 pipelines_ 中
+ */
+class ExchangePhysicalOperator : public PhysicalOperator
+{
+public:
+  ExchangePhysicalOperator(Table *table, std::shared_ptr<MorselQueue> morsel_queue);
+
+  virtual ~ExchangePhysicalOperator() = default;
+
+  PhysicalOperatorType type() const override
+  {
+    return PhysicalOperatorType::EXCHANGE;
+  }
+
+  std::string param() const override;
+
+  void add_pipeline(std::unique_ptr<PhysicalOperator> pipeline);
+  int  pipeline_num() const { return static_cast<int>(pipelines_.size()) + 1; }
+  PhysicalOperator *pipeline(int index);
+
+  RC open(Trx *trx) override;
+  RC next() override;
+  RC close() override;
+
+  Tuple *current_tuple() override;
+
+  /**
+   * @brief 并行运行所有流水线，直到数据全部处理完或者出现错误
+   * @param consumer 处理流水线输出的每一行，第一个参数是流水线的编号，同一条流水线的数据只在一个线程中处理
+   */
+  RC execute(const std::function<RC(int, Tuple &)> &consumer);
+
+private:
+  RC run_pipeline(int index, const std::function<RC(int, Tuple &)> &consumer);
+
+private:
+  Table *table_ = nullptr;
+  Trx *trx_ = nullptr;
+  std::shared_ptr<MorselQueue> morsel_queue_;
+  std::vector<std::unique_ptr<PhysicalOperator>> pipelines_;
+};
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "include/common/rc.h"
+#include "include/query_engine/parser/value.h"
+#include "include/query_engine/structor/tuple/tuple.h"
+#include "include/storage_engine/recorder/record.h"
+
+/// 外部排序默认使用的内存上限，超过之后会把当前已经排好序的数据写到临时文件中
+#define DEFAULT_SORT_MEMORY_BUDGET (64 * 1024 * 1024)
+
+/// 一次多路归并最多同时打开的顺串个数，超过时先做中间归并
+#define MAX_SORT_MERGE_FAN_IN 128
+
+/**
+ * @brief 排序键编码
+ * @ingroup PhysicalOperator
+ * @details 把一个Value编码成可以直接按memcmp比较的字节串，多个键依次追加即可得到复合键。
+ * 每个键以一个字节的NULL标志开头，NULL在升序时排在最前面；降序时把整个键按位取反。
+ * 数值类型统一转换成double后做符号位变换并按大端序输出，字符串按0x00转义并以0x00 0x00结尾。
+ */
+class SortKeyEncoder
+{
+public:
+  static void append(const Value &value, bool is_asc, std::string &key);
+};
+
+/**
+ * @brief 排序算子中一行数据的编码
+ * @details 排序时只保存一行所引用的记录(可能来自多张表)，格式为 [RID][len][data] [RID][len][data] ...
+ * 输出时把记录直接指向编码后的数据，再通过 set_record 交给子算子的 tuple，不再做拷贝
+ */
+class SortRowCodec
+{
+public:
+  void encode(const Tuple &tuple, std::string &payload);
+  void decode(char *payload, int payload_len, Tuple &tuple);
+
+private:
+  std::vector<Record *> input_records_;
+  std::vector<Record>   output_records_;  ///< 不持有内存
+  std::vector<Record *> output_record_ptrs_;
+};
+
+/**
+ * @brief 有内存上限的外部排序
+ * @ingroup PhysicalOperator
+ * @details 每一行由一个排序键和一段负载组成，都保存在按块分配的arena中，
+ * 只另外维护一个指向每一行的指针数组用于排序。
+ * 当arena与指针数组占用的内存超过上限时，把当前数据排序后写成一个顺串(run)到临时文件，
+ * 最后用败者树对所有顺串做多路归并。没有发生溢出时直接在内存中输出。
+ */
+class ExternalSorter
+{
+public:
+  explicit ExternalSorter(
+      size_t memory_budget = DEFAULT_SORT_MEMORY_BUDGET, size_t merge_fan_in = MAX_SORT_MERGE_FAN_IN);
+  ~ExternalSorter();
+
+  ExternalSorter(const ExternalSorter &) = delete;
+  ExternalSorter &operator=(const ExternalSorter &) = delete;
+
+  /**
+   * @brief 添加一行数据，数据会被复制，调用后可以立即复用key和payload的内存
+   */
+  RC add(const char *key, int key_len, const char *payload, int payload_len);
+
+  /**
+   * @brief 输入结束，开始准备输出
+   */
+  RC finish();
+
+  /**
+   * @brief 按排序键从小到大输出下一行
+   * @details 返回的payload在下一次调用next或者reset之前一直有效。没有数据时返回RECORD_EOF
+   */
+  RC next(char *&payload, int &payload_len);
+
+  /**
+   * @brief 释放所有内存与临时文件，可以重新开始一次排序
+   */
+  void reset();
+
+  /// 已经写到临时文件中的顺串个数，用于观察是否发生了溢出
+  int spilled_run_count() const { return spilled_runs_; }
+
+private:
+  struct RunReader;
+  class LoserTree;
+
+  char *allocate(size_t size);
+  size_t memory_usage() const;
+  void   sort_in_memory();
+  RC     spill_run();
+  RC     merge_runs(std::vector<FILE *> &runs, FILE *output);
+  RC     merge_tail_runs(size_t count);
+  RC     open_merge(std::vector<FILE *> &runs);
+
+private:
+  size_t memory_budget_;
+  size_t merge_fan_in_;
+
+  std::vector<std::unique_ptr<char[]>> blocks_;        ///< arena 使用的内存块
+  std::vector<std::unique_ptr<char[]>> large_blocks_;  ///< 超过内存块大小的行单独分配
+  size_t                               large_bytes_ = 0;
+  size_t                               block_used_  = 0;  ///< 最后一个内存块已经使用的字节数
+  size_t                               block_count_ = 0;  ///< 当前正在使用的内存块个数
+  std::vector<char *>                  entries_;          ///< arena 中每一行的起始位置
+  size_t                               output_pos_ = 0;
+
+  std::vector<FILE *>          runs_;        ///< 已经溢出到临时文件中的顺串
+  std::vector<int>             run_levels_;  ///< 每个顺串经过了几次归并
+  int                          spilled_runs_ = 0;
+  std::unique_ptr<LoserTree>   merger_;
+  bool                         finished_ = false;
+};
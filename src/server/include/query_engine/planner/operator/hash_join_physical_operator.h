@@ -0,0 +1,64 @@
+#pragma once
+
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "physical_operator.h"
+#include "external_sort.h"
+#include "table_scan_physical_operator.h"
+#include "include/query_engine/structor/tuple/join_tuple.h"
+
+/**
+ * @brief 哈希连接
+ * @ingroup PhysicalOperator
+ * @details 打开时读取右子树的所有数据，按照连接键建立内存中的哈希表，之后逐行读取左子树并探测哈希表。
+ * 哈希表中只保存每一行引用的记录的编码，输出时解码回右子树的 tuple。
+ * 连接键为 NULL 的行不会匹配；连接键之外的条件在匹配之后计算。
+ * 左子树是(经过过滤的)表扫描并且连接键都是它的字段时，先建立哈希表，再把右边所有的键做成布隆过滤器下推给左边的扫描，
+ * 扫描可以提前丢弃不能匹配的记录，键比较少时还可以用布隆过滤器索引跳过页面
+ */
+class HashJoinPhysicalOperator : public PhysicalOperator
+{
+public:
+  HashJoinPhysicalOperator(std::vector<std::unique_ptr<Expression>> &&left_keys,
+      std::vector<std::unique_ptr<Expression>> &&right_keys, std::unique_ptr<Expression> condition);
+  ~HashJoinPhysicalOperator() override = default;
+
+  PhysicalOperatorType type() const override
+  {
+    return PhysicalOperatorType::HASH_JOIN;
+  }
+
+  std::string param() const override;
+
+  RC open(Trx *trx) override;
+  RC next() override;
+  RC close() override;
+  Tuple *current_tuple() override;
+
+private:
+  RC build();
+  RC match_condition(bool &result);
+
+  /// 找到可以接收运行时过滤器的左边的扫描，并按照扫描的表初始化过滤器的键
+  TableScanPhysicalOperator *probe_scan(RuntimeFilter &runtime_filter) const;
+
+private:
+  std::vector<std::unique_ptr<Expression>> left_keys_;
+  std::vector<std::unique_ptr<Expression>> right_keys_;
+  std::unique_ptr<Expression> condition_;
+
+  SortRowCodec codec_;
+  std::deque<std::string> build_rows_;  ///< 右子树每一行的编码，deque 保证已有的数据不会移动
+  std::unordered_map<std::string, std::vector<size_t>> hash_table_;
+  std::shared_ptr<RuntimeFilter> runtime_filter_;  ///< 下推给左边扫描的过滤器，不能下推时为空
+
+  const std::vector<size_t> *matches_ = nullptr;  ///< 当前左边的行在哈希表中匹配到的行
+  size_t match_pos_ = 0;
+  std::string probe_key_;
+
+  Tuple *right_tuple_ = nullptr;
+  JoinedTuple joined_tuple_;
+};
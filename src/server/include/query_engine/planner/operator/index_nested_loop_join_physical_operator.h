@@ -0,0 +1,48 @@
+#pragma once
+
+#include "physical_operator.h"
+#include "include/query_engine/structor/tuple/join_tuple.h"
+
+class IndexScanPhysicalOperator;
+
+/**
+ * @brief 索引嵌套循环连接
+ * @ingroup PhysicalOperator
+ * @details 右子节点是某张表上的索引扫描。每读到一行左边的数据，计算出探测键，
+ * 用等值范围重新扫描右表的索引，只读取可能匹配的行。完整的连接条件仍然在组合之后计算一次
+ */
+class IndexNestedLoopJoinPhysicalOperator : public PhysicalOperator
+{
+public:
+  /**
+   * @param left_keys 只有一个表达式，只引用左子树，用它的值探测索引
+   * @param right_keys 对应的右表索引字段，只用于展示
+   */
+  IndexNestedLoopJoinPhysicalOperator(std::vector<std::unique_ptr<Expression>> &&left_keys,
+      std::vector<std::unique_ptr<Expression>> &&right_keys, std::unique_ptr<Expression> condition);
+  ~IndexNestedLoopJoinPhysicalOperator() override = default;
+
+  PhysicalOperatorType type() const override
+  {
+    return PhysicalOperatorType::INDEX_NL_JOIN;
+  }
+
+  std::string param() const override;
+
+  RC open(Trx *trx) override;
+  RC next() override;
+  RC close() override;
+  Tuple *current_tuple() override;
+
+private:
+  RC match_condition(bool &result);
+
+private:
+  std::vector<std::unique_ptr<Expression>> left_keys_;
+  std::vector<std::unique_ptr<Expression>> right_keys_;
+  std::unique_ptr<Expression> condition_;
+
+  IndexScanPhysicalOperator *index_scan_ = nullptr;
+  bool probing_ = false;
+  JoinedTuple joined_tuple_;
+};
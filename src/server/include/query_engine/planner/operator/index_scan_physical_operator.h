@@ -2,9 +2,27 @@
 
 #include "physical_operator.h"
 #include "include/query_engine/structor/tuple/row_tuple.h"
+#include "include/query_engine/structor/expression/expression_compiler.h"
 #include "include/storage_engine/recorder/record_manager.h"
 
 class IndexScanner;
+
+/**
+ * @brief 索引扫描的范围
+ * @details 键值已经是索引中的存储格式。多列索引的键是所有字段拼接后的完整长度
+ */
+struct IndexScanRange
+{
+  std::string left_key;
+  bool        has_left        = false;
+  bool        left_inclusive  = false;
+  std::string right_key;
+  bool        has_right       = false;
+  bool        right_inclusive = false;
+  bool        empty           = false;  ///< 条件互相矛盾，不需要扫描
+  std::string desc;                     ///< 用于 explain 展示
+};
+
 /**
  * TODO [Lab2]
  * 通过索引来扫描文件,与TableScanOperator扮演同等的角色.
@@ -30,8 +48,22 @@ public:
       right_value_ = *right_value;
       right_null_ = false;
     }
+    range_.has_left = !left_null_;
+    range_.left_inclusive = left_inclusive;
+    if (range_.has_left) {
+      range_.left_key.assign(left_value_.data(), left_value_.length());
+    }
+    range_.has_right = !right_null_;
+    range_.right_inclusive = right_inclusive;
+    if (range_.has_right) {
+      range_.right_key.assign(right_value_.data(), right_value_.length());
+    }
   }
 
+  IndexScanPhysicalOperator(Table *table, Index *index, bool readonly, IndexScanRange range)
+      : table_(table), index_(index), readonly_(readonly), range_(std::move(range))
+  {}
+
   ~IndexScanPhysicalOperator() override = default;
 
   PhysicalOperatorType type() const override
@@ -55,14 +87,33 @@ public:
     predicates_ = std::move(predicates);
   }
 
+  /**
+   * @brief 查询只用到索引中的字段时，直接使用索引项构造数据
+   * @details 数据页面的可见性提示表明记录对当前事务可见时，不再读取数据页面
+   */
+  void set_index_only(bool index_only) { index_only_ = index_only; }
+
+  /**
+   * @brief 使用新的范围重新扫描索引
+   * @details 算子需要已经打开过。索引嵌套循环连接每次探测时调用，不会重新设置输出的 tuple
+   */
+  RC rescan(IndexScanRange range);
+
  private:
+  RC open_scanner();
+  /// 取下一个索引项的RID，不是只读的扫描从事先收集好的RID中取
+  RC next_rid(RID &rid);
   RC filter(RowTuple &tuple, bool &result);
+  /// 使用当前索引项构造记录，不能只使用索引时返回false
+  bool read_index_entry(const RID &rid);
+
   Table *table_ = nullptr;
   std::string table_alias_;
   Index *index_ = nullptr;
   IndexScanner *index_scanner_ = nullptr;
   RecordFileHandler *record_handler_ = nullptr;
   bool  readonly_ = false;
+  Trx *trx_ = nullptr;
 
   RecordPageHandler record_page_handler_;
   Record current_record_;
@@ -74,5 +125,16 @@ public:
   bool right_inclusive_ = false;
   bool left_null_ = true;
   bool right_null_ = true;
+  IndexScanRange range_;
+
+  std::vector<RID> rids_;        ///< 不是只读的扫描在第一次调用 next 时收集的RID
+  size_t           rid_pos_ = 0;
+  bool             rids_collected_ = false;
+
+  bool index_only_ = false;
+  std::vector<char> index_record_;               ///< 使用索引项构造的记录
+  std::vector<std::pair<int, int>> key_fields_;  ///< 索引键中每个字段在记录中的偏移与长度
   std::vector<std::unique_ptr<Expression>> predicates_;
+  std::vector<std::unique_ptr<ExprKernel>> kernels_;  ///< 打开算子时由 predicates_ 编译得到
+  bool                                     always_false_ = false;  ///< 谓词中有恒为假的常量，不需要读取任何数据
 };
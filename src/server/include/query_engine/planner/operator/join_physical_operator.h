@@ -3,6 +3,18 @@
 #include "physical_operator.h"
 #include "include/query_engine/structor/tuple/join_tuple.h"
 
+/**
+ * @brief 计算一行数据的等值连接键
+ * @details 使用排序键的编码，值相等时得到相同的字节串。任意一个键为 NULL 时 is_null 为 true，
+ * 这一行不会与任何行匹配
+ */
+RC encode_join_key(
+    const std::vector<std::unique_ptr<Expression>> &keys, const Tuple &tuple, std::string &key, bool &is_null);
+
+/// explain 时展示的连接键，比如 a.id=b.id
+std::string join_keys_to_string(
+    const std::vector<std::unique_ptr<Expression>> &left_keys, const std::vector<std::unique_ptr<Expression>> &right_keys);
+
 class JoinPhysicalOperator : public PhysicalOperator
 {
 public:
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "physical_operator.h"
+
+/**
+ * @brief limit/offset 物理算子
+ * @ingroup PhysicalOperator
+ * @details 跳过前 offset 行，输出 limit 行之后直接返回 RECORD_EOF，不再从子算子拉取数据。
+ * 子算子是按索引顺序扫描时，order by + limit 只需要读取前 offset + limit 行
+ */
+class LimitPhysicalOperator : public PhysicalOperator
+{
+public:
+  LimitPhysicalOperator(int limit, int offset);
+
+  virtual ~LimitPhysicalOperator() = default;
+
+  PhysicalOperatorType type() const override
+  {
+    return PhysicalOperatorType::LIMIT;
+  }
+
+  std::string param() const override;
+
+  RC open(Trx *trx) override;
+  RC next() override;
+  RC close() override;
+
+  Tuple *current_tuple() override;
+
+private:
+  int limit_ = -1;   ///< 小于0表示不限制
+  int offset_ = 0;
+  int skipped_ = 0;  ///< 已经跳过的行数
+  int emitted_ = 0;  ///< 已经输出的行数
+};
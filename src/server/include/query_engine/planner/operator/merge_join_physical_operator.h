@@ -0,0 +1,73 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "physical_operator.h"
+#include "external_sort.h"
+#include "include/query_engine/structor/tuple/join_tuple.h"
+
+/**
+ * @brief 排序归并连接
+ * @ingroup PhysicalOperator
+ * @details 打开时用外部排序把左右两个子树的数据都按照连接键排序，内存不够时会溢出到临时文件。
+ * 之后同时顺序读取两边，右边连接键相同的一组行缓存在内存中，与左边键相同的每一行依次组合输出。
+ * 连接键为 NULL 的行不会匹配
+ */
+class MergeJoinPhysicalOperator : public PhysicalOperator
+{
+public:
+  MergeJoinPhysicalOperator(std::vector<std::unique_ptr<Expression>> &&left_keys,
+      std::vector<std::unique_ptr<Expression>> &&right_keys, std::unique_ptr<Expression> condition);
+  ~MergeJoinPhysicalOperator() override = default;
+
+  PhysicalOperatorType type() const override
+  {
+    return PhysicalOperatorType::MERGE_JOIN;
+  }
+
+  std::string param() const override;
+
+  RC open(Trx *trx) override;
+  RC next() override;
+  RC close() override;
+  Tuple *current_tuple() override;
+
+private:
+  /// 把子树的数据全部读出来排序，每一行的负载为 [键的长度][键][记录的编码]
+  RC sort_child(PhysicalOperator &child, const std::vector<std::unique_ptr<Expression>> &keys,
+      ExternalSorter &sorter, Tuple *&tuple);
+  /// 读取排序之后的下一行，拆分出键与记录的编码
+  static RC fetch(ExternalSorter &sorter, std::string_view &key, char *&row, int &row_len);
+  RC advance_left();
+  RC load_right_group();
+  RC match_condition(bool &result);
+
+private:
+  std::vector<std::unique_ptr<Expression>> left_keys_;
+  std::vector<std::unique_ptr<Expression>> right_keys_;
+  std::unique_ptr<Expression> condition_;
+
+  ExternalSorter left_sorter_;
+  ExternalSorter right_sorter_;
+  SortRowCodec left_codec_;
+  SortRowCodec right_codec_;
+  Tuple *left_tuple_ = nullptr;
+  Tuple *right_tuple_ = nullptr;
+
+  std::string left_key_;  ///< 左边当前行的连接键
+  bool left_valid_ = false;
+
+  std::string_view right_key_;  ///< 右边已经读出但还没有处理的一行
+  char *right_row_ = nullptr;
+  int right_row_len_ = 0;
+  bool right_valid_ = false;
+
+  std::string group_key_;                ///< 当前缓存的右边这一组行的连接键
+  std::vector<std::string> right_group_;
+  size_t group_pos_ = 0;
+  bool group_valid_ = false;
+
+  JoinedTuple joined_tuple_;
+};
@@ -2,6 +2,7 @@
 
 #include <memory>
 #include "physical_operator.h"
+#include "external_sort.h"
 #include "include/query_engine/structor/expression/expression.h"
 #include "include/query_engine/analyzer/statement/orderby_stmt.h"
 
@@ -10,11 +11,13 @@ class OrderByStmt;
 /**
  * @brief 排序物理算子
  * @ingroup PhysicalOperator
+ * @details 子算子输出的每一行被编码为可以直接memcmp比较的排序键，与该行引用的记录一起交给外部排序，
+ * 内存超过上限时会溢出到临时文件，因此排序占用的内存是有界的
  */
 class OrderPhysicalOperator : public PhysicalOperator
 {
 public:
-  OrderPhysicalOperator(std::vector<OrderByUnit *> order_units);
+  OrderPhysicalOperator(std::vector<OrderByUnit *> order_units, size_t memory_budget = DEFAULT_SORT_MEMORY_BUDGET);
 
   virtual ~OrderPhysicalOperator() = default;
 
@@ -34,7 +37,8 @@ private:
 private:
   std::vector<OrderByUnit *> order_units_;
   bool is_init_ = true;
-  std::vector<std::vector<Record *>> st_;  // sort table
-  std::vector<int> st_idx_;
-  std::vector<int>::iterator it_;
+  ExternalSorter sorter_;
+  std::string sort_key_;                   ///< 复用的排序键缓冲
+  std::string payload_;                    ///< 复用的行数据缓冲
+  SortRowCodec codec_;
 };
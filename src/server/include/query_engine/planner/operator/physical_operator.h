@@ -27,6 +27,12 @@ enum class PhysicalOperatorType
   GROUP_BY,
   ORDER_BY,
   JOIN,
+  HASH_JOIN,
+  MERGE_JOIN,
+  INDEX_NL_JOIN,
+  LIMIT,
+  TOP_N,
+  EXCHANGE,
 };
 
 class PhysicalOperator
@@ -51,6 +57,22 @@ public:
 
   virtual Tuple *current_tuple() = 0;
 
+  /**
+   * @brief 取下一行并统计本算子输出的行数，父算子和执行器都通过它驱动子算子
+   */
+  RC next_row()
+  {
+    RC rc = next();
+    if (rc == RC::SUCCESS) {
+      rows_out_++;
+    }
+    return rc;
+  }
+
+  /// 执行统计：输出的行数，以及扫描算子从表或索引中读取的行数
+  uint64_t rows_out() const { return rows_out_; }
+  uint64_t rows_scanned() const { return rows_scanned_; }
+
   void add_child(std::unique_ptr<PhysicalOperator> oper) {
     children_.emplace_back(std::move(oper));
   }
@@ -66,10 +88,23 @@ public:
     }
   }
 
+  /// 由逻辑计划带过来的估计值，explain 时展示
+  void set_estimate(double rows, double cost)
+  {
+    estimated_rows_ = rows;
+    estimated_cost_ = cost;
+  }
+  double estimated_rows() const { return estimated_rows_; }
+  double estimated_cost() const { return estimated_cost_; }
+
 public:
   bool isdelete_ = false;
 
 protected:
   const Tuple *father_tuple_ = nullptr;
+  double estimated_rows_ = -1;
+  double estimated_cost_ = -1;
+  uint64_t rows_out_ = 0;
+  uint64_t rows_scanned_ = 0;
   std::vector<std::unique_ptr<PhysicalOperator>> children_;
 };
@@ -6,6 +6,8 @@
 #include "physical_operator.h"
 #include "src/server/include/query_engine/planner/node/logical_node.h"
 
+class Index;
+class Value;
 class TableGetLogicalNode;
 class PredicateLogicalNode;
 class OrderByLogicalNode;
@@ -17,6 +19,8 @@ class UpdateLogicalNode;
 class ExplainLogicalNode;
 class JoinLogicalNode;
 class GroupByLogicalNode;
+class LimitLogicalNode;
+struct IndexScanRange;
 
 /**
  * @brief 物理算子树生成器
@@ -32,6 +36,8 @@ public:
   RC create(LogicalNode &logical_operator, std::unique_ptr<PhysicalOperator> &oper, bool is_delete = false);
 
 private:
+  RC create_operator(LogicalNode &logical_operator, std::unique_ptr<PhysicalOperator> &oper, bool is_delete);
+
   RC create_plan(TableGetLogicalNode &logical_oper, std::unique_ptr<PhysicalOperator> &oper, bool is_delete = false);
   RC create_plan(PredicateLogicalNode &logical_oper, std::unique_ptr<PhysicalOperator> &oper, bool is_delete = false);
   RC create_plan(ProjectLogicalNode &logical_oper, std::unique_ptr<PhysicalOperator> &oper, bool is_delete = false);
@@ -42,4 +48,27 @@ private:
   RC create_plan(UpdateLogicalNode &logical_oper, std::unique_ptr<PhysicalOperator> &oper);
   RC create_plan(ExplainLogicalNode &logical_oper, std::unique_ptr<PhysicalOperator> &oper, bool is_delete = false);
   RC create_plan(JoinLogicalNode &logical_oper, std::unique_ptr<PhysicalOperator> &oper);
+  RC create_plan(LimitLogicalNode &logical_oper, std::unique_ptr<PhysicalOperator> &oper);
+
+  /**
+   * @brief 判断 order by 能否直接利用表上索引的顺序
+   * @details 只支持单个升序的字段排序，并且字段上有单列索引。索引中的 NULL 是按照原始字节排序的，
+   * 因此字段要么不允许为 NULL，要么有一个下推的比较条件可以过滤掉 NULL
+   */
+  TableGetLogicalNode *find_ordered_index_scan(OrderByLogicalNode &order_oper, Index *&index);
+
+  /**
+   * @brief 根据下推的条件选择索引以及扫描范围
+   * @details 单列索引可以使用等值与范围条件，多列索引只能使用前缀字段上的等值条件。
+   * covered_predicates 返回已经完全由索引范围保证、不需要再过滤的条件下标(从小到大)
+   */
+  Index *select_index(
+      TableGetLogicalNode &table_get_oper, IndexScanRange &range, std::vector<size_t> &covered_predicates);
+
+  /**
+   * @brief 为 过滤 + 全表扫描 创建并行执行的流水线
+   * @details 表被切分成多个页面段，每个工作线程运行一条流水线，各自从共享的队列中取页面段处理。
+   * 不满足并行条件时 oper 保持为空，由调用方按照普通方式创建算子
+   */
+  RC create_parallel_scan(LogicalNode &logical_oper, std::unique_ptr<PhysicalOperator> &oper);
 };
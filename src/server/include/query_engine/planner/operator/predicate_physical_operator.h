@@ -26,4 +26,6 @@ public:
 
 private:
   std::unique_ptr<Expression> expression_;
+  bool is_constant_ = false;     ///< 条件是否已经在优化时化简成了常量
+  bool constant_value_ = false;
 };
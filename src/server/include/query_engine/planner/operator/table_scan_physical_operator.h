@@ -2,10 +2,28 @@
 
 #include "physical_operator.h"
 #include "include/storage_engine/recorder/record_manager.h"
+#include "include/storage_engine/recorder/zone_map.h"
+#include "include/storage_engine/index/bloom_filter.h"
 #include "include/common/rc.h"
 #include "include/query_engine/structor/tuple/row_tuple.h"
+#include "include/query_engine/structor/expression/expression_compiler.h"
 
 class Table;
+class MorselQueue;
+class BloomFilterIndex;
+
+/**
+ * @brief 哈希连接下推到探测侧扫描的运行时过滤器
+ * @ingroup PhysicalOperator
+ * @details 包含构建侧所有连接键的布隆过滤器，键的哈希按照探测侧表中字段的格式计算，
+ * 扫描时直接根据记录中的字段判断，不在过滤器中的记录不可能与构建侧匹配
+ */
+struct RuntimeFilter
+{
+  BloomKey              key;     ///< 探测侧表中的连接键字段
+  BloomFilter           filter;  ///< 构建侧所有连接键的哈希
+  std::vector<uint64_t> hashes;  ///< 构建侧不同的键比较少时保存所有的哈希，可以用布隆过滤器索引跳过页面，否则为空
+};
 
 /**
  * @brief 表扫描物理算子
@@ -22,6 +40,9 @@ public:
 
   std::string param() const override;
 
+  Table *table() const { return table_; }
+  const std::string &table_alias() const { return table_alias_; }
+
   PhysicalOperatorType type() const override
   {
     return PhysicalOperatorType::TABLE_SCAN;
@@ -35,8 +56,26 @@ public:
 
   void set_predicates(std::vector<std::unique_ptr<Expression>> &&exprs);
 
+  /**
+   * @brief 并行扫描时，多个扫描算子共享同一个页面段队列，每次从队列中取一段页面来扫描
+   */
+  void set_morsel_queue(std::shared_ptr<MorselQueue> morsel_queue) { morsel_queue_ = std::move(morsel_queue); }
+
+  /**
+   * @brief 设置运行时过滤器，需要在 open 之前设置
+   */
+  void set_runtime_filter(std::shared_ptr<const RuntimeFilter> runtime_filter)
+  {
+    runtime_filter_ = std::move(runtime_filter);
+  }
+
 private:
   RC filter(RowTuple &tuple, bool &result);
+  RC open_next_morsel();
+
+  /// 找出可以用来跳过页面的布隆过滤器索引以及要查找的键
+  void collect_bloom_probes();
+  bool may_match_page(PageNum page_num) const;
 
 private:
   Table *                                  table_ = nullptr;
@@ -46,5 +85,13 @@ private:
   RecordFileScanner                        record_scanner_;
   Record                                   current_record_;
   RowTuple                                 tuple_;
-  std::vector<std::unique_ptr<Expression>> predicates_; // TODO chang predicate to table tuple filter
+  std::vector<std::unique_ptr<Expression>> predicates_;
+  std::vector<std::unique_ptr<ExprKernel>> kernels_;     ///< 打开算子时由 predicates_ 编译得到
+  bool                                     always_false_ = false;  ///< 谓词中有恒为假的常量，不需要读取任何数据
+  ZonePredicate                            zone_predicate_;        ///< 根据页面摘要跳过页面的条件
+  std::vector<std::pair<const BloomFilterIndex *, std::vector<uint64_t>>> bloom_probes_;  ///< 布隆过滤器索引与要查找的键
+  std::shared_ptr<const RuntimeFilter>     runtime_filter_;
+  std::shared_ptr<MorselQueue>             morsel_queue_;
+  std::vector<Record>                      system_records_;  ///< 扫描系统表时打开算子生成的全部记录
+  size_t                                   system_pos_ = 0;
 };
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <memory>
+#include "physical_operator.h"
+#include "external_sort.h"
+#include "include/query_engine/analyzer/statement/orderby_stmt.h"
+
+/**
+ * @brief order by + limit 的物理算子
+ * @ingroup PhysicalOperator
+ * @details 只保留排序后前 offset + limit 行，使用一个大小有界的大顶堆。
+ * 堆满之后，排序键不小于堆顶的行直接丢弃，不再编码它引用的记录，
+ * 内存占用与 offset + limit 成正比，与输入的行数无关
+ */
+class TopNPhysicalOperator : public PhysicalOperator
+{
+public:
+  TopNPhysicalOperator(std::vector<OrderByUnit *> order_units, int limit, int offset);
+
+  virtual ~TopNPhysicalOperator() = default;
+
+  PhysicalOperatorType type() const override
+  {
+    return PhysicalOperatorType::TOP_N;
+  }
+
+  std::string param() const override;
+
+  RC open(Trx *trx) override;
+  RC next() override;
+  RC close() override;
+
+  Tuple *current_tuple() override;
+
+private:
+  struct HeapEntry
+  {
+    std::string key;
+    std::string payload;
+    size_t      seq = 0;  ///< 输入顺序，保证相同排序键的行按输入顺序输出
+  };
+
+  RC fill_heap();
+
+private:
+  std::vector<OrderByUnit *> order_units_;
+  int limit_ = 0;
+  int offset_ = 0;
+  bool is_init_ = true;
+
+  std::vector<HeapEntry> heap_;
+  size_t output_pos_ = 0;
+  std::string sort_key_;
+  SortRowCodec codec_;
+};
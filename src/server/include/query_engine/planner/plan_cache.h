@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "include/common/rc.h"
+#include "include/query_engine/parser/value.h"
+
+class Stmt;
+class LogicalNode;
+
+/// 会话级计划缓存最多保存的计划个数
+#define SESSION_PLAN_CACHE_CAPACITY 64
+/// 全局计划缓存最多保存的计划个数
+#define GLOBAL_PLAN_CACHE_CAPACITY 1024
+
+/**
+ * @brief 缓存的查询计划
+ * @details 保存经过重写与代价优化的逻辑计划，SQL 中的常量都用参数占位符代替，
+ * 执行时复制一份逻辑计划并绑定参数的值，然后只需要生成物理计划。
+ * 逻辑计划中的排序节点引用了语句中的对象，所以语句与计划一起保存。
+ * 缓存的计划创建之后不再修改，可以在多个会话之间共享
+ */
+struct CachedPlan
+{
+  CachedPlan();
+  ~CachedPlan();
+
+  std::string key;                            ///< 缓存的键，由数据库名与规范化之后的SQL组成
+  std::string sql;                            ///< 生成计划的SQL，计划失效时用它重新生成
+  uint64_t schema_version = 0;                ///< 生成计划时数据库的模式版本，执行过DDL之后计划失效
+  int param_count = 0;                        ///< 参数占位符的个数
+  std::shared_ptr<Stmt> stmt;
+  std::unique_ptr<LogicalNode> logical_plan;  ///< 为空表示这条SQL不能使用缓存的计划，避免每次都重新尝试
+
+  bool usable() const { return logical_plan != nullptr; }
+
+  /**
+   * @brief 复制逻辑计划并把参数占位符替换成参数的值
+   * @param params 按照占位符出现的顺序排列的参数
+   */
+  RC instantiate(const std::vector<Value> &params, std::unique_ptr<LogicalNode> &logical_plan) const;
+};
+
+/**
+ * @brief 按照最近最少使用的策略淘汰的计划缓存
+ * @details 每个会话有自己的缓存，另外还有一个所有会话共享的全局缓存。
+ * 查找时会检查计划生成时的模式版本，过期的计划直接删除
+ */
+class PlanCache
+{
+public:
+  explicit PlanCache(size_t capacity) : capacity_(capacity) {}
+  ~PlanCache() = default;
+
+  /**
+   * @brief 查找计划
+   * @param schema_version 数据库当前的模式版本，与计划中记录的版本不同时计划已经失效
+   */
+  std::shared_ptr<const CachedPlan> get(const std::string &key, uint64_t schema_version);
+
+  /// 加入计划，已经有相同的键时替换原来的计划
+  void put(std::shared_ptr<const CachedPlan> plan);
+
+  void clear();
+  size_t size() const;
+
+  /// 所有会话共享的全局缓存
+  static PlanCache &global_instance();
+
+private:
+  using PlanList = std::list<std::shared_ptr<const CachedPlan>>;
+
+  mutable std::mutex mutex_;
+  size_t capacity_ = 0;
+  PlanList plans_;  ///< 最近使用的计划放在前面
+  std::unordered_map<std::string, PlanList::iterator> entries_;
+};
@@ -10,6 +10,7 @@
 class Planner{
 public:
     RC plan_logical_tree(QueryInfo *query_info, std::unique_ptr<LogicalNode> &logical_operator);
+    RC plan_logical_tree(Stmt *stmt, std::unique_ptr<LogicalNode> &logical_operator);
     RC plan_physical_operator(std::unique_ptr<LogicalNode> &logical_operator, QueryInfo *query_info);
 private:
     LogicalPlanGenerator logical_plan_generator_;
@@ -1,12 +1,19 @@
 #pragma once
 
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "include/common/rc.h"
 #include "include/query_engine/planner/planner.h"
 #include "include/query_engine/optimizer/optimizer.h"
 #include "include/query_engine/executor/execution_engine.h"
 
 class SessionRequest;
+struct RequestProgress;
 class QueryInfo;
+class Db;
+struct CachedPlan;
 
 class QueryEngine
 {
@@ -14,8 +21,48 @@ public:
   QueryEngine() = default;
   ~QueryEngine() = default;
 
+  /**
+   * @brief 处理一个请求，把结果作为一个以分隔符结尾的消息写回客户端
+   * @details 请求中有多条用分号分隔的语句时，按顺序在同一个事务中执行，遇到失败的语句就停止并回滚
+   * 结果集太大、客户端接收不及时的时候，语句在两行结果之间暂停，request->paused() 为 true，
+   * 套接字可写之后调用 resume_session_request 继续执行
+   * @return 是否需要断开连接，请求暂停时没有意义
+   */
   bool process_session_request(SessionRequest *request);
+  /**
+   * @brief 从暂停的位置继续执行请求，可能再次暂停
+   */
+  bool resume_session_request(SessionRequest *request);
+  /**
+   * @brief 连接断开时放弃暂停的请求，关闭结果集并结束请求自己开启的事务
+   */
+  void cancel_session_request(SessionRequest *request);
   RC planQuery(QueryInfo *query_info);
+
+  /**
+   * @brief 为一条SQL生成可以缓存的计划，PREPARE 与计划缓存都使用它
+   * @details 生成失败时 plan 中的逻辑计划为空，计划缓存用它记录不能缓存的SQL
+   */
+  RC build_cached_plan(Db *db, const std::string &key, const std::string &sql, std::shared_ptr<const CachedPlan> &plan);
+
+private:
+  /// 按照执行进度依次执行请求中的语句，都执行完之后写回消息分隔符
+  bool run_request(SessionRequest *request);
+  /// 执行一条语句或者继续发送暂停的结果，不写消息分隔符。返回语句执行的结果，暂停时返回 SEND_PAUSED
+  RC execute_statement(SessionRequest *request, RequestProgress &progress);
+  /// 语句结束时汇总资源统计，超过阈值时记录慢查询，然后释放 QueryInfo。返回语句执行的时间
+  int64_t finish_statement(SessionRequest *request, RequestProgress &progress, RC rc);
+  /// 多条语句的请求在同一个事务中执行，遇到失败的语句就回滚
+  void begin_batch(SessionRequest *request);
+  void end_batch(SessionRequest *request);
+
+  /// 按照规范化之后的SQL查找计划缓存，命中时直接生成物理计划
+  RC plan_from_cache(QueryInfo *query_info, bool &hit);
+  /// 使用 PREPARE 保存的计划执行 EXECUTE 语句
+  RC plan_execute(QueryInfo *query_info);
+  /// 复制缓存的逻辑计划，绑定参数之后生成物理计划
+  RC instantiate_plan(QueryInfo *query_info, const std::shared_ptr<const CachedPlan> &plan, const std::vector<Value> &params);
+
 private:
   Planner planner_;
   Optimizer optimizer_;
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "common/log/log.h"
+#include "include/common/query_stats.h"
+#include "include/common/rc.h"
+
+/**
+ * @brief 慢查询日志中的一条记录
+ */
+struct SlowQueryRecord
+{
+  std::string start_time;  ///< 语句开始执行的时间，精确到微秒
+  std::string db;
+  std::string sql;
+  RC          rc       = RC::SUCCESS;
+  int64_t     total_ns = 0;
+  int64_t     phase_ns[static_cast<int>(QueryPhase::NUM)] = {0};
+  uint64_t    pages_read    = 0;
+  uint64_t    pages_hit     = 0;
+  uint64_t    pages_written = 0;
+  uint64_t    rows_scanned  = 0;
+  uint64_t    rows_sent     = 0;
+  uint64_t    bytes_sent    = 0;
+  uint64_t    log_bytes     = 0;
+  std::string operators;
+
+  /// 一行 JSON，SQL 过长时截断，保证整行不超过日志一行的长度限制
+  std::string to_json() const;
+};
+
+/**
+ * @brief 慢查询日志
+ * @details 执行时间不少于阈值的语句以 JSON 的形式逐行写到单独的日志文件中，按天滚动。
+ * 最近的若干条同时保存在内存中，可以通过系统表 slow_query_log 查询。
+ * 配置在 [LOG] 中：SLOW_QUERY_TIME_MS 为阈值，小于0时关闭；SLOW_QUERY_LOG_FILE_NAME 为日志文件名；
+ * SLOW_QUERY_HISTORY_SIZE 为内存中保留的条数。
+ */
+class SlowQueryLog
+{
+public:
+  static constexpr const char *SYSTEM_TABLE_NAME = "slow_query_log";
+
+  static SlowQueryLog &instance();
+
+  /**
+   * @param file_name    日志文件名，为空时只保存在内存中
+   * @param threshold_ms 执行时间不少于这个值的语句记为慢查询，小于0时关闭
+   * @param history_size 内存中保留的条数
+   */
+  RC   init(const std::string &file_name, double threshold_ms, int history_size);
+  void cleanup();
+
+  /// 注册系统表 slow_query_log，需要在事务模块初始化之后调用
+  static RC register_system_table();
+
+  bool is_slow(int64_t total_ns) const
+  {
+    const int64_t threshold_ns = threshold_ns_.load(std::memory_order_relaxed);
+    return threshold_ns >= 0 && total_ns >= threshold_ns;
+  }
+
+  /**
+   * @brief 语句结束时调用，不是慢查询时什么都不做
+   */
+  void record(const char *db, const std::string &sql, RC rc, const QueryStats &stats);
+
+  std::vector<SlowQueryRecord> history() const;
+
+private:
+  std::atomic<int64_t>         threshold_ns_{-1};
+  mutable std::mutex           lock_;
+  std::deque<SlowQueryRecord>  history_;
+  size_t                       history_size_ = 0;
+  std::unique_ptr<common::Log> log_;
+};
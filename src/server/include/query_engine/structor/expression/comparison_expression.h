@@ -42,8 +42,10 @@ public:
   RC set_trx(Trx *trx) const;
 
   ComparisonExpr* copy() const override {
-    ComparisonExpr *res = new ComparisonExpr(comp_, static_cast<std::unique_ptr<Expression>>(left_->copy()),
-        static_cast<std::unique_ptr<Expression>>(right_->copy()));
+    // IS [NOT] NULL 没有右边的表达式
+    ComparisonExpr *res = new ComparisonExpr(comp_,
+        static_cast<std::unique_ptr<Expression>>(left_ == nullptr ? nullptr : left_->copy()),
+        static_cast<std::unique_ptr<Expression>>(right_ == nullptr ? nullptr : right_->copy()));
     res->set_name(name());
     res->set_alias(alias());
     return res;
@@ -36,6 +36,7 @@ enum class ExprType
   ARITHMETIC,   ///< 算术运算
   REL_ATTR,     ///< 属性
   AGGR,         ///< 聚合
+  PARAM,        ///< 预处理语句中的参数占位符，执行前替换成常量值
 };
 
 /**
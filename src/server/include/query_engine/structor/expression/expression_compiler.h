@@ -0,0 +1,65 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "include/common/rc.h"
+
+class Expression;
+class RowTuple;
+class Table;
+struct ZonePredicate;
+
+/**
+ * @brief 编译之后的谓词
+ * @ingroup Expression
+ * @details 直接按照字段在记录中的偏移读取数据计算结果，不需要构造 Value 对象
+ */
+class ExprKernel
+{
+public:
+  virtual ~ExprKernel() = default;
+
+  virtual RC evaluate(const RowTuple &tuple, bool &result) const = 0;
+
+  /// 是否完全编译成了类型特化的计算，为false表示其中有部分仍然按照表达式树求值
+  virtual bool compiled() const { return true; }
+
+  /// 结果是否与记录无关，是的话通过 value 返回结果
+  virtual bool constant(bool &value) const { return false; }
+};
+
+/**
+ * @brief 把单表扫描上的谓词编译成按类型与比较符特化的计算
+ * @ingroup Expression
+ * @details 支持布尔常量，字段与常量、字段与字段(类型相同的数值)的比较，IS [NOT] NULL，
+ * 字段 [NOT] IN 常量列表(使用列表的哈希集合)，以及它们的 AND/OR 组合。
+ * 比较的语义与 Value::compare 相同：浮点数按照 EPSILON 比较，字符串按照字节比较，NULL 参与的比较结果为假。
+ * 其它表达式(比如LIKE、算术运算)仍然调用 Expression::get_value 求值
+ */
+class ExpressionCompiler
+{
+public:
+  ExpressionCompiler(const Table *table, const std::string &table_alias) : table_(table), table_alias_(table_alias)
+  {}
+
+  /**
+   * @brief 编译谓词
+   * @details 返回的对象引用了 expr，expr 的生命周期需要比返回的对象长。不会返回空
+   */
+  std::unique_ptr<ExprKernel> compile(const Expression *expr) const;
+
+  /**
+   * @brief 把谓词转换成根据页面摘要判断的条件
+   * @details 只转换 列 op 常量、列 IS [NOT] NULL、列 IN 常量列表以及它们的 AND/OR 组合，
+   * AND 中不能转换的部分直接忽略。没有可以转换的部分时返回 false
+   */
+  bool compile_zone_predicate(const Expression *expr, ZonePredicate &predicate) const;
+
+  /// 引用当前表的字段在表中的序号，不是当前表的字段时返回-1
+  int field_index(const Expression *expr) const;
+
+private:
+  const Table *table_ = nullptr;
+  std::string  table_alias_;
+};
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "expression.h"
+
+/**
+ * @brief 参数占位符，即SQL中的 ?
+ * @ingroup Expression
+ * @details 预处理语句与计划缓存中的计划使用它代替常量，每次执行前复制计划并把它替换成绑定的值，
+ * 所以不会真正被求值
+ */
+class ParamExpr : public Expression
+{
+public:
+  explicit ParamExpr(int index) : index_(index) {
+    this->type_ = ExprType::PARAM;
+  }
+
+  ~ParamExpr() override = default;
+
+  RC get_value(const Tuple &tuple, Value &value) const override;
+
+  AttrType value_type() const override { return AttrType::UNDEFINED; }
+
+  /// 参数的序号，按照在SQL中出现的顺序从0开始编号
+  int index() const { return index_; }
+
+  ParamExpr* copy() const override {
+    auto *res = new ParamExpr(index_);
+    res->set_name(name());
+    res->set_alias(alias());
+    return res;
+  }
+
+private:
+  int index_ = 0;
+};
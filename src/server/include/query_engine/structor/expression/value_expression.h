@@ -1,5 +1,9 @@
 #pragma once
 
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
 #include "expression.h"
 
 class ValueExpr : public Expression
@@ -38,6 +42,8 @@ private:
 /**
  * @brief 很多常量值表达式
  * @ingroup Expression
+ * @details 用于 IN 与 EXISTS 后面的值列表。列表中的非空值类型相同并且比较结果精确时(整数、日期与字符串)，
+ * 同时按值建立哈希集合，类型相同的值查找时不需要逐个比较
  */
 class ValuesExpr : public Expression {
 public:
@@ -51,13 +57,23 @@ public:
   RC try_get_value(Value &value) const override { return RC::SUCCESS; }
   AttrType value_type() const override { return AttrType::UNDEFINED; }
 
-  void add_value(const Value &value) {
-    values_.push_back(value);
-  }
+  void add_value(const Value &value);
 
+  const std::vector<Value> &values() const { return values_; }
+
+  /**
+   * @brief 判断 value 是否在列表中
+   * @details 与 SQL 的语义相同：value 为 NULL，或者没有找到相等的值而列表中有 NULL 时，结果为 NULL
+   */
   RC value_in(const Value &value, Value &result) const;
   RC value_exists(Value &result) const;
 
+  /// 哈希集合中值的类型，没有建立哈希集合时为 UNDEFINED
+  AttrType hash_type() const { return hashable_ ? hash_type_ : UNDEFINED; }
+  bool has_null() const { return has_null_; }
+  bool contains_int(int value) const { return int_set_.count(value) > 0; }
+  bool contains_string(std::string_view value) const { return string_set_.find(value) != string_set_.end(); }
+
   ValuesExpr* copy() const override {
     auto *res = new ValuesExpr;
     for (auto &value : values_) {
@@ -69,7 +85,17 @@ public:
   }
 
 private:
-  std::vector<Value> values_;
-};
+  struct StringHash
+  {
+    using is_transparent = void;
+    size_t operator()(std::string_view value) const { return std::hash<std::string_view>()(value); }
+  };
 
+  std::vector<Value> values_;
 
+  bool     has_null_  = false;
+  bool     hashable_  = true;
+  AttrType hash_type_ = UNDEFINED;
+  std::unordered_set<int> int_set_;
+  std::unordered_set<std::string, StringHash, std::equal_to<>> string_set_;
+};
@@ -3,6 +3,7 @@
 #include <string>
 #include <memory>
 #include "include/session/session_request.h"
+#include "include/common/query_stats.h"
 #include "include/query_engine/planner/operator/physical_operator.h"
 
 class SessionRequest;
@@ -51,6 +52,12 @@ public:
         return stmt_;
     }
 
+    /**
+     * @brief 使用计划缓存中的语句
+     * @details 缓存中的语句与其它请求共享，QueryInfo 不负责释放它。原来的语句会被释放
+     */
+    void set_cached_stmt(std::shared_ptr<Stmt> stmt);
+
     void set_operator(std::unique_ptr<PhysicalOperator> op)
     {
         operator_ = std::move(op);
@@ -60,11 +67,19 @@ public:
         return operator_;
     }
 
+    /// 这条语句的资源统计，语句结束时写到慢查询日志中
+    QueryStats &stats()
+    {
+        return stats_;
+    }
+
 private:
   std::unique_ptr<ParsedSqlNode> sql_node_;
   Stmt *stmt_ = nullptr;
+  std::shared_ptr<Stmt> cached_stmt_;
   std::unique_ptr<PhysicalOperator> operator_;
   SessionRequest                   *session_event_ = nullptr;
   std::string sql_;
+  QueryStats stats_;
 };
 
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "plain_communicator.h"
+#include "include/query_engine/parser/value.h"
+
+class TupleSchema;
+
+/**
+ * @brief 使用二进制协议返回结果
+ * @ingroup Communicator
+ * @details 接收请求与 PlainCommunicator 一样，结果的格式参考 common/io/binary_protocol.h。
+ * 查询结果按行追加进来，攒够一批之后按列编码：整数、浮点数、日期使用原始的4字节编码，
+ * 字符串在每一批中做字典编码，NULL 使用位图表示，不需要把每个值都格式化成文本
+ */
+class BinaryCommunicator : public PlainCommunicator
+{
+public:
+  static constexpr int BATCH_ROWS = 4096;  ///< 一批最多的行数
+
+  BinaryCommunicator();
+  ~BinaryCommunicator() override = default;
+
+  /**
+   * @brief 文本信息(比如执行状态、耗时)放在 TEXT 消息中
+   */
+  RC write_result(const char *data, int32_t size) override;
+
+  RC write_schema(const TupleSchema &schema);
+
+  /**
+   * @brief 追加一行结果，攒够一批时发送出去
+   * @details TEXTS 类型的值需要调用者先读出文本的内容，转换成字符串
+   */
+  RC append_row(std::vector<Value> &row);
+
+  /**
+   * @brief 发送还没有发送的行
+   */
+  RC flush_batch();
+
+  /**
+   * @brief 结果发送完之后释放批使用的缓存，空闲的连接不保留
+   */
+  void release_batch();
+
+private:
+  void encode_column(int column);
+
+private:
+  int                rows_       = 0;
+  int                column_num_ = 0;
+  std::vector<Value> cells_;    ///< 按行存放还没有发送的值
+  std::string        message_;  ///< 编码消息使用的缓存，在批之间重复使用
+  std::unordered_map<std::string_view, uint32_t> dictionary_;  ///< 编码字符串列时使用的字典
+};
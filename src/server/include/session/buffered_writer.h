@@ -1,19 +1,28 @@
 #pragma once
 
+#include <string>
+#include <sys/types.h>
+
 #include "ring_buffer.h"
 
+namespace common {
+class ShmChannel;
+}
+
 /**
  * @brief 支持以缓存模式写入数据到文件/socket
  * @details 缓存使用ring buffer实现，当缓存满时会自动刷新缓存。
  * 看起来直接使用fdopen也可以实现缓存写，不过fdopen会在close时直接关闭fd。
- * @note 在执行close时，描述符fd并不会被关闭
+ * 写入不会因为非阻塞的套接字暂时写不进去而等待：环形缓存满并且套接字返回EAGAIN时，数据追加到溢出缓存中，
+ * 由调用者根据 pending 决定是否暂停产生数据，参考 Communicator::check_send_window。
+ * @note 在执行close时，描述符fd并不会被关闭，没有写出去的数据会被丢弃
  */
 class BufferedWriter
 {
 public:
   BufferedWriter(int fd);
   BufferedWriter(int fd, int32_t size);
-  ~BufferedWriter();
+  virtual ~BufferedWriter();
 
   /**
    * @brief 关闭缓存
@@ -22,7 +31,7 @@ public:
 
   /**
    * @brief 写数据到文件/socket
-   * @details 缓存满会自动刷新缓存
+   * @details 缓存满会自动刷新缓存，刷新不完的数据放到溢出缓存中
    * @param data 要写入的数据
    * @param size 要写入的数据大小 
    * @param write_size 实际写入的数据大小
@@ -39,20 +48,59 @@ public:
 
   /**
    * @brief 刷新缓存
-   * @details 将缓存中的数据全部写入文件/socket
+   * @details 将缓存中的数据写入文件/socket，非阻塞的套接字暂时写不进去时直接返回，剩余的数据留在缓存中
    */
   RC flush();
 
+  /**
+   * @brief 还没有写到文件/socket中的数据大小
+   */
+  int64_t pending() const
+  {
+    return buffer_.size() + static_cast<int64_t>(overflow_.size() - overflow_pos_);
+  }
+
+protected:
+  /**
+   * @brief 把一段数据写到文件/socket中，与 ::write 的返回值相同
+   * @details 子类可以改成写到其它的通道中，写不进去时返回-1并把errno设置为EAGAIN
+   */
+  virtual ssize_t write_some(const char *buf, int32_t size);
+
 private:
   /**
    * @brief 刷新缓存
    * @details 期望缓存可以刷新size大小的数据，实际刷新的数据量可能小于size也可能大于size。
    * 通常是在缓存满的时候，希望刷新掉一部分数据，然后继续写入。
    * @param size 期望刷新的数据大小
+   * @param would_block 套接字暂时写不进去
    */
-  RC flush_internal(int32_t size);
+  RC flush_internal(int32_t size, bool &would_block);
 
-private:
+protected:
   int fd_ = -1;
+
+private:
   RingBuffer buffer_;
-};
\ No newline at end of file
+  std::string overflow_;         ///< 环形缓存已满时写入的数据，排在环形缓存中的数据之后
+  size_t      overflow_pos_ = 0; ///< 溢出缓存中已经写出去的数据大小
+};
+
+/**
+ * @brief 把缓存的数据写到共享内存通道的结果环中
+ * @details 结果环满时与非阻塞的套接字一样返回EAGAIN，由调用者暂停产生数据并等待套接字可读，
+ * 客户端读走结果之后通过套接字唤醒服务端。客户端在睡眠时通过eventfd唤醒它，客户端在轮询时写入不需要系统调用
+ * @note fd 是与客户端的Unix Socket，用来读走唤醒用的字节
+ */
+class ShmWriter : public BufferedWriter
+{
+public:
+  ShmWriter(int fd, common::ShmChannel *channel);
+  ~ShmWriter() override;
+
+protected:
+  ssize_t write_some(const char *buf, int32_t size) override;
+
+private:
+  common::ShmChannel *channel_ = nullptr;
+};
@@ -2,8 +2,10 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 #include <event.h>
+#include "common/io/shm_channel.h"
 #include "include/common/rc.h"
 #include "include/query_engine/executor/sql_result.h"
 #include "include/session/buffered_writer.h"
@@ -43,6 +45,54 @@ public:
    */
   virtual RC read_event(SessionRequest *&event) = 0;
 
+  /**
+   * @brief 是否还有已经收到但是没有处理的数据
+   * @details 这些数据可能已经包含了完整的请求，套接字上不会再有可读事件，需要主动再调用一次read_event
+   */
+  virtual bool has_pending_data() const { return shm_has_data(); }
+
+  /**
+   * @brief 请求处理完之后检查是否已经有下一个请求
+   * @details 使用共享内存通道时先在请求环上轮询一段时间，客户端很快发来下一个请求时不需要经过事件循环，
+   * 双方都没有系统调用
+   */
+  bool wait_pending_data();
+
+  /**
+   * @brief 允许客户端通过Unix Socket申请共享内存通道
+   * @param ring_size 请求环与结果环的容量
+   * @param spin_us 请求处理完之后在请求环上轮询等待下一个请求的时间
+   */
+  void enable_shm(uint32_t ring_size, int spin_us)
+  {
+    shm_ring_size_ = ring_size;
+    shm_spin_us_   = spin_us;
+  }
+
+  /**
+   * @brief 是否已经切换到共享内存通道
+   */
+  bool use_shm() const
+  {
+    return shm_ != nullptr;
+  }
+
+  /**
+   * @brief 等待结果可以继续发送时监听的事件
+   * @details 使用共享内存通道时，客户端读走结果之后往套接字中写一个字节，所以等待的是可读事件
+   */
+  short write_events() const
+  {
+    return use_shm() ? EV_READ : EV_WRITE;
+  }
+
+  /**
+   * @brief 准备在事件循环中等待下一个请求
+   * @details 使用共享内存通道时设置等待标记，客户端写入请求之后才会唤醒服务端
+   * @return 设置等待标记时请求已经到了，客户端不会再唤醒，调用者应该直接触发读事件
+   */
+  bool prepare_wait_request();
+
   /**
    * @brief 关联的会话信息
    */
@@ -59,6 +109,22 @@ public:
     return read_event_;
   }
 
+  /**
+   * @brief libevent使用的数据，结果发送不完时等待套接字可写，参考server.cpp
+   */
+  struct event &write_event()
+  {
+    return write_event_;
+  }
+
+  /**
+   * @brief 与客户端通讯的描述符
+   */
+  int fd() const
+  {
+    return fd_;
+  }
+
   /**
    * @brief 对端地址
    * 如果是unix socket，可能没有意义
@@ -76,17 +142,84 @@ public:
     return writer_->writen(send_message_delimiter_.data(), send_message_delimiter_.size());
   }
 
-  void flush(){
-    writer_->flush();
+  /**
+   * @brief 把缓存的结果写到套接字中，套接字暂时写不进去时不等待
+   */
+  RC flush(){
+    return writer_->flush();
+  }
+
+  /**
+   * @brief 是否还有没有写到套接字中的结果
+   */
+  bool has_pending_output() const
+  {
+    return writer_ != nullptr && writer_->pending() > 0;
+  }
+
+  /**
+   * @brief 设置发送窗口，即一个连接最多缓存多少还没有发送出去的结果。0表示不限制
+   */
+  void set_send_window(int32_t size)
+  {
+    send_window_ = size;
+  }
+
+  /**
+   * @brief 检查缓存的结果是否超过了发送窗口
+   * @details 超过发送窗口时先尝试写到套接字，仍然超过时 full 为 true，调用者应该在当前行之后暂停产生结果
+   */
+  RC check_send_window(bool &full);
+
+  /**
+   * @brief 缓存的结果是否已经降到发送窗口的一半以下，暂停的请求可以继续执行
+   */
+  bool below_low_watermark() const
+  {
+    return writer_->pending() <= send_window_ / 2;
+  }
+
+  /**
+   * @brief 结果发送暂停的请求，等待套接字可写之后继续执行
+   */
+  SessionRequest *paused_request() const
+  {
+    return paused_request_;
+  }
+  void set_paused_request(SessionRequest *request)
+  {
+    paused_request_ = request;
   }
 
+protected:
+  /**
+   * @brief 接收请求数据，返回值与 ::read 相同
+   * @details 使用共享内存通道时从请求环中读取，请求环为空时设置等待标记并返回-1，errno为EAGAIN
+   */
+  ssize_t recv_data(char *buf, int32_t size);
+
+  /**
+   * @brief 处理客户端申请共享内存通道的请求，通过Unix Socket直接应答
+   * @details 只在启用了共享内存通道、还没有切换并且没有缓存的结果时同意，之后请求与结果都只经过共享内存
+   */
+  RC accept_shm_handshake();
+
+  bool shm_has_data() const;
+
 protected:
   Session *session_ = nullptr;
   struct event read_event_;
+  struct event write_event_;
+  int32_t send_window_ = 0;  ///< 发送窗口，0表示不限制
+  SessionRequest *paused_request_ = nullptr;
   std::string addr_;
   BufferedWriter *writer_ = nullptr;
   std::vector<char> send_message_delimiter_; ///< 发送消息分隔符
   int fd_ = -1;
+
+  std::unique_ptr<common::ShmChannel> shm_;  ///< 共享内存通道，没有切换时为空
+  uint32_t shm_ring_size_ = 0;               ///< 共享内存通道中环的容量，0表示不允许切换
+  int shm_spin_us_ = 0;                      ///< 请求处理完之后轮询请求环的时间
 };
 
 /**
@@ -98,6 +231,7 @@ enum class CommunicateProtocol
   PLAIN,  ///< 以'\0'结尾的协议
   CLI,    ///< 与客户端进行交互的协议
   MYSQL,  ///< mysql通讯协议。具体实现参考 MysqlCommunicator
+  BINARY, ///< 请求与PLAIN相同，结果使用按列编码的二进制格式。具体实现参考 BinaryCommunicator
 };
 
 /**
@@ -2,12 +2,18 @@
 
 #include <vector>
 #include <cstring>
+#include <string>
 #include "communicator.h"
+#include "ring_buffer.h"
 
 /**
  * @brief 与客户端进行通讯
  * @ingroup Communicator
- * @details 使用简单的文本通讯协议，每个消息使用'\0'结尾
+ * @details 使用简单的文本通讯协议，每个消息使用'\0'结尾。
+ * 接收消息是增量的：每次有数据可读时，把套接字中的数据读到连接自己的环形缓存中，
+ * 再把'\0'之前的部分拼到请求缓存里。消息不完整时直接返回，等待下一次可读事件继续，不会空转。
+ * 一个消息后面多读到的数据留在环形缓存中，作为下一个请求的开头。
+ * 两个缓存都属于连接，在请求之间重复使用，不需要每个请求重新分配
  */
 class PlainCommunicator : public Communicator 
 {
@@ -18,4 +24,23 @@ public:
   RC read_event(SessionRequest *&event) override;
   RC write_state(SqlResult *sql_result, bool &need_disconnect) override;
   RC write_result(const char *data, int32_t size) override;
+
+  bool has_pending_data() const override { return recv_buffer_.size() > 0 || shm_has_data(); }
+
+private:
+  /**
+   * @brief 把环形缓存中的数据移动到请求缓存，直到遇到'\0'或者环形缓存为空
+   * @param complete 是否已经得到一个完整的消息
+   */
+  RC take_message(bool &complete);
+
+  /**
+   * @brief 从套接字中读取数据放到环形缓存中
+   * @param would_block 套接字中暂时没有数据
+   */
+  RC fill_buffer(bool &would_block);
+
+private:
+  RingBuffer  recv_buffer_;  ///< 从套接字中读到但是还没有处理的数据
+  std::string message_;      ///< 正在拼接的消息，不包含结尾的'\0'
 };
@@ -5,8 +5,9 @@
 #include "include/common/rc.h"
 
 /**
- * @brief 环形缓存，当前用于通讯写入数据时的缓存
+ * @brief 环形缓存，用于通讯写入数据时的缓存，以及接收请求时暂存从套接字读到的数据
  * @ingroup Communicator
+ * @details 内存在第一次写入时才分配，缓存为空时可以通过 release 释放，空闲的连接不占用缓存的内存
  */
 class RingBuffer
 {
@@ -55,10 +56,31 @@ public:
    */
   RC write(const char *buf, int32_t size, int32_t &write_size);
 
+  /**
+   * @brief 获取一段连续的可写入空间，不会移动写指针
+   * @details 可以直接把套接字中的数据读到这段空间里，避免多复制一次。写入完成后执行commit函数移动写指针。
+   * 缓存已满时 size 为0
+   * @param buf 可写入的空间
+   * @param size 空间大小
+   */
+  RC write_buffer(char *&buf, int32_t &size);
+
+  /**
+   * @brief 将写指针向前移动size个字节
+   * @details 通常在write_buffer函数获取空间并写入数据后调用
+   * @param size 移动的字节数
+   */
+  RC commit(int32_t size);
+
+  /**
+   * @brief 缓存为空时释放内存，下一次写入时重新分配
+   */
+  void release();
+
   /**
    * @brief 缓存的总容量
    */
-  int32_t capacity() const { return static_cast<int32_t>(buffer_.size()); }
+  int32_t capacity() const { return capacity_; }
 
   /**
    * @brief 缓存中剩余的可写入数据的空间
@@ -72,9 +94,18 @@ public:
 
 private:
   int32_t read_pos() const { return (write_pos_ - this->size() + capacity()) % capacity(); }
+
+  /// 写入之前确保内存已经分配
+  void allocate()
+  {
+    if (buffer_.empty()) {
+      buffer_.resize(capacity_);
+    }
+  }
   
 private:
-  std::vector<char> buffer_;      ///< 缓存使用的内存，使用vector方便管理
+  std::vector<char> buffer_;      ///< 缓存使用的内存，使用vector方便管理，没有分配时为空
+  int32_t capacity_ = 0;          ///< 缓存的容量
   int32_t data_size_ = 0;         ///< 已经写入的数据量
   int32_t write_pos_ = 0;         ///< 当前写指针的位置，范围不会超出[0, capacity)
 };
\ No newline at end of file
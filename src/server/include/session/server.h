@@ -7,7 +7,9 @@
 #include <fcntl.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
+#include <atomic>
 #include <memory>
+#include <semaphore>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -15,6 +17,8 @@
 #include <sys/types.h>
 #include <sys/un.h>
 #include <unistd.h>
+#include <thread>
+#include <vector>
 #include <event2/thread.h>
 
 #include "common/defs.h"
@@ -22,6 +26,7 @@
 #include "common/log/log.h"
 #include "common/io/io.h"
 
+#include "include/common/mpmc_queue.h"
 #include "include/common/setting.h"
 #include "include/query_engine/query_engine.h"
 #include "server_param.h"
@@ -37,6 +42,12 @@ class QueryEngine;
  * @ingroup Communicator
  * @details 当前支持网络连接，有TCP和Unix Socket两种方式。通过命令行参数来指定使用哪种方式。
  * 启动后监听端口或unix socket，使用libevent来监听事件，当有新的连接到达时，创建一个Communicator对象进行处理。
+ * 监听套接字默认在主线程的event_base上，新连接轮流分配给若干个IO线程。打开 REUSE_PORT 时每个IO线程
+ * 各自使用 SO_REUSEPORT 监听同一个端口，由内核分配连接，接收连接不再经过主线程。每个IO线程有自己的event_base，
+ * 只负责读出完整的请求，再通过无锁队列交给SQL线程执行，慢查询不会阻塞其它连接。
+ * 连接的读事件不是持久的，SQL线程把结果发送完之后才重新注册，所以一个连接同时最多只有一个请求在执行。
+ * 发送结果不会阻塞线程：缓存的结果超过发送窗口时请求暂停，在IO线程上等待套接字可写，
+ * 缓存降到窗口的一半以下再交给SQL线程继续执行，每个连接占用的内存不超过发送窗口
  */
 class Server 
 {
@@ -53,23 +64,58 @@ public:
   void shutdown();
 
 private:
+  /**
+   * @brief 一个监听套接字
+   */
+  struct Listener
+  {
+    Server            *server  = nullptr;
+    int                fd      = -1;
+    struct event      *ev      = nullptr;
+    struct event_base *io_base = nullptr;  ///< 接收的连接放在哪个IO线程上，为空时轮流分配
+  };
+
   /**
    * @brief 接收到新的连接时，调用此函数创建Communicator对象
-   * @details 此函数作为libevent中监听套接字对应的回调函数
+   * @details 此函数作为libevent中监听套接字对应的回调函数，一次接收所有已经完成握手的连接
    * @param fd libevent回调函数传入的参数，即监听套接字
    * @param ev 本次触发的事件，通常是EV_READ
-   * @param arg 在注册libevent回调函数时，传入的参数，即Server对象
+   * @param arg 在注册libevent回调函数时，传入的参数，即Listener对象
    */
   static void accept(int fd, short ev, void *arg);
+
+  /**
+   * @brief 为新的连接创建Communicator对象，并注册到IO线程上
+   * @param io_base 连接所在的IO线程，为空时轮流分配
+   */
+  void init_connection(int client_fd, const struct sockaddr_in &addr, struct event_base *io_base);
   /**
    * @brief 接收到客户端消息时，调用此函数创建任务
-   * @details 此函数作为libevent中客户端套接字对应的回调函数。当有新的消息到达时，调用此函数创建任务。
+   * @details 此函数作为libevent中客户端套接字对应的回调函数，在IO线程中执行。
+   * 读到完整的请求之后放到请求队列中，由SQL线程处理。
    * @param fd libevent回调函数传入的参数，即客户端套接字
    * @param ev 本次触发的事件，通常是EV_READ
    * @param arg 在注册libevent回调函数时，传入的参数，即Communicator对象
    */
   static void recv(int fd, short ev, void *arg);
 
+  /**
+   * @brief 套接字可写时，调用此函数继续发送缓存的结果
+   * @details 此函数作为libevent中客户端套接字写事件的回调函数，在IO线程中执行。
+   * 有暂停的请求时，缓存降到发送窗口的一半以下就把请求交给SQL线程继续执行；
+   * 否则等缓存全部发送完之后再接收下一个请求
+   */
+  static void send(int fd, short ev, void *arg);
+
+  /**
+   * @brief 重新注册连接的读事件，在请求处理完之后调用
+   */
+  static int add_read_event(Communicator *comm);
+  /**
+   * @brief 注册连接的写事件，结果没有发送完时调用
+   */
+  static int add_write_event(Communicator *comm);
+
 private:
   /**
    * @brief 将socket描述符设置为非阻塞模式
@@ -78,10 +124,33 @@ private:
    */
   int set_non_block(int fd);
 
+  /**
+   * @brief 根据参数开关连接的 TCP_CORK
+   * @details 执行请求时打开，结果写完之后关闭，把响应合并成尽量少的报文，最后不满一个报文的数据在关闭时立即发出
+   */
+  void set_cork(Communicator *comm, bool cork);
+
+  /**
+   * @brief 把进程能打开的描述符个数调整到系统允许的上限，每个连接占用一个描述符
+   */
+  void raise_open_files_limit();
+
   int start();
 
+  /**
+   * @brief 创建一个监听TCP端口的套接字
+   */
+  int create_tcp_socket();
+
+  /**
+   * @brief 在指定的event_base上监听套接字
+   */
+  int add_listener(int fd, struct event_base *base, struct event_base *io_base);
+  void close_listeners();
+
   /**
    * @brief 启动TCP服务
+   * @details 打开 REUSE_PORT 时，为每个IO线程创建一个监听套接字，否则只在主线程上监听
    */
   int start_tcp_server();
 
@@ -95,16 +164,52 @@ private:
    */
   int start_stdin_server();
 
+  /**
+   * @brief 创建IO线程与SQL线程
+   */
+  int start_threads();
+  void stop_threads();
+
+  void io_thread_func(struct event_base *base);
+  /**
+   * @brief SQL线程从请求队列中取出请求执行，取到空请求时退出
+   */
+  void sql_thread_func();
+  void submit_request(SessionRequest *request);
+  /**
+   * @brief IO线程中发现连接断开时调用，交给SQL线程关闭连接
+   * @details 关闭连接会回滚并释放会话中的事务，事务模块只能在SQL线程中使用
+   */
+  void submit_close(Communicator *comm);
+  /**
+   * @brief 执行请求并写回结果
+   * @details 连接中已经收到了下一个完整的请求时继续执行，都处理完之后再重新注册读事件。
+   * 请求暂停或者结果没有发送完时注册写事件，由 send 接着处理
+   */
+  void handle_request(SessionRequest *request);
+
 private:
   volatile bool started_ = false;
 
-  int server_socket_ = -1;  ///< 监听套接字，是一个描述符
   struct event_base *event_base_ = nullptr; ///< libevent对象
-  struct event *listen_ev_ = nullptr;  ///< libevent监听套接字事件
+  std::vector<std::unique_ptr<Listener>> listeners_;  ///< 监听套接字以及对应的事件
 
   ServerParam server_param_;  ///< 服务启动参数
 
   CommunicatorFactory communicator_factory_; ///< 通过这个对象创建新的Communicator对象
 
+  std::vector<struct event_base *> io_bases_;    ///< 每个IO线程的event_base，连接的读事件注册在这里
+  std::vector<std::thread>         io_threads_;
+  std::atomic<unsigned int>        next_io_{0};  ///< 下一个连接分配给哪个IO线程
+
+  std::vector<std::thread>                      sql_threads_;
+  std::unique_ptr<MpmcQueue<SessionRequest *>>  request_queue_;     ///< 等待执行的请求
+  std::counting_semaphore<>                     request_ready_{0};  ///< 请求队列中请求的个数
+
+  static constexpr int MAX_PIPELINED_REQUESTS = 64;  ///< 一个连接连续执行的请求个数上限
+  static constexpr int MAX_ACCEPT_PER_EVENT   = 256; ///< 一次可读事件最多接收的连接个数，避免长时间占用事件循环
+
+  static Server *instance_;  ///< 正在运行的服务，读事件的回调函数通过它把请求交给SQL线程
+
   static QueryEngine query_engine_;  ///< 通过这个对象处理查询请求
 };
@@ -23,8 +23,28 @@ public:
 
   int port; ///< 监听的端口号
 
+  int io_thread_num = 0;  ///< 监听连接读事件的线程个数，0表示使用CPU的核数
+
+  int sql_thread_num = 0;  ///< 执行SQL请求的线程个数，0表示使用CPU的核数。没有打开 CONCURRENCY 编译选项时只能是1
+
+  int send_window_size;  ///< 每个连接最多缓存多少字节还没有发送出去的结果，超过时暂停执行。0表示不限制
+
+  bool reuse_port;   ///< 每个IO线程使用 SO_REUSEPORT 各自监听端口
+
+  bool tcp_nodelay;  ///< 连接是否设置 TCP_NODELAY
+
+  bool tcp_cork;     ///< 执行请求时是否打开 TCP_CORK，结果写完之后关闭
+
   std::string unix_socket_path; ///< unix socket的路径
 
+  bool shm_transport;     ///< 是否允许Unix Socket上的客户端申请共享内存通道
+
+  int shm_ring_size;      ///< 共享内存通道中请求环与结果环的容量
+
+  int shm_spin_us;        ///< 请求处理完之后在共享内存通道上轮询下一个请求的时间，0表示直接回到事件循环
+
+  int session_pool_size;  ///< 连接断开之后最多缓存多少个空闲会话给新的连接复用，0表示不缓存
+
   bool use_std_io = false;  ///< 是否使用标准输入输出作为通信条件
 
   ///< 如果使用标准输入输出作为通信条件，就不再监听端口
@@ -1,14 +1,22 @@
 #pragma once
 
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "include/common/rc.h"
 
 class Trx;
 class Db;
 class SessionRequest;
+class PlanCache;
+struct CachedPlan;
 
 /**
  * @brief 表示会话
- * @details 当前一个连接一个会话，没有做特殊的会话管理，这也简化了会话处理
+ * @details 一个连接一个会话。连接断开之后会话重置并放回 SessionPool，新的连接直接复用
  */
 class Session 
 {
@@ -20,7 +28,7 @@ public:
   static Session &default_session();
 
 public:
-  Session() = default;
+  Session();
   ~Session();
 
   Session(const Session &other);
@@ -65,6 +73,28 @@ public:
   void set_sql_debug(bool sql_debug) { sql_debug_ = sql_debug; }
   bool sql_debug_on() const { return sql_debug_; }
 
+  /**
+   * @brief 保存 PREPARE 的语句，已经有同名的语句时替换掉
+   */
+  void add_prepared_stmt(const std::string &name, std::shared_ptr<const CachedPlan> plan);
+  /// 查找 PREPARE 过的语句，没有时返回空
+  std::shared_ptr<const CachedPlan> find_prepared_stmt(const std::string &name) const;
+  /// 删除 PREPARE 过的语句，没有这个语句时返回false
+  bool remove_prepared_stmt(const std::string &name);
+
+  /**
+   * @brief 会话级的计划缓存
+   * @details 先在会话的缓存中查找，找不到时再查找所有会话共享的全局缓存
+   */
+  PlanCache &plan_cache();
+
+  /**
+   * @brief 把会话恢复成刚建立连接时的状态，RESET SESSION 以及会话放回会话池时调用
+   * @details 多语句事务还没有结束时先回滚；事务对象交还给事务管理器复用。
+   * 会话级的计划缓存只是缓存，带有模式版本号，当前数据库没有变化时保留
+   */
+  RC reset();
+
   /**
    * @brief 将指定会话设置到线程变量中
    * 
@@ -83,4 +113,45 @@ private:
   SessionRequest *current_request_ = nullptr; ///< 当前正在处理的请求
   bool trx_multi_operation_mode_ = false;   ///< 当前事务的模式，是否多语句模式. 单语句模式自动提交
   bool sql_debug_ = false;                  ///< 是否输出SQL调试信息
+
+  std::unordered_map<std::string, std::shared_ptr<const CachedPlan>> prepared_stmts_;  ///< PREPARE 的语句
+  std::unique_ptr<PlanCache> plan_cache_;
+};
+
+/**
+ * @brief 空闲会话池
+ * @details 短连接的客户端频繁地建立与断开连接，每次都分配会话以及事务对象的开销不小。
+ * 连接断开时会话重置之后放回池中，新的连接从池中取出。多语句事务没有结束的会话不放回，
+ * 与之前一样直接释放。IO线程与SQL线程都可能释放会话，没有打开并发编译选项时也要加锁，
+ * 所以不使用 common::Mutex
+ */
+class SessionPool
+{
+public:
+  static SessionPool &instance();
+
+  ~SessionPool();
+
+  /**
+   * @brief 池中最多保留的空闲会话个数，0表示不缓存
+   */
+  void set_capacity(int capacity);
+
+  /**
+   * @brief 取出一个空闲会话，没有时基于默认会话新建一个
+   */
+  Session *acquire();
+
+  /**
+   * @brief 连接断开时调用，会话重置之后放回池中，池满或者不能复用时释放
+   */
+  void release(Session *session);
+
+  /// 当前空闲会话的个数
+  size_t idle_size();
+
+private:
+  std::mutex             lock_;
+  std::vector<Session *> idle_sessions_;
+  size_t                 capacity_ = 0;
 };
@@ -1,12 +1,37 @@
 #pragma once
 
 #include <string.h>
+#include <chrono>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "include/query_engine/executor/sql_result.h"
 
 class Session;
 class Communicator;
+class SessionRequest;
+class QueryInfo;
+
+/**
+ * @brief 请求的执行进度
+ * @details 客户端接收结果的速度跟不上时，语句在两行结果之间暂停发送，执行进度保存在请求中，
+ * 套接字可写之后再从暂停的位置继续执行，参考 QueryEngine::resume_session_request
+ */
+struct RequestProgress
+{
+  std::vector<std::string>        statements;                     ///< 请求拆分出来的语句
+  size_t                          next_statement  = 0;            ///< 下一条要执行的语句
+  bool                            own_trx         = false;        ///< 多条语句的请求是否自己开启了事务
+  bool                            need_disconnect = true;         ///< 执行完之后是否需要断开连接
+  RC                              rc              = RC::SUCCESS;  ///< 最近执行的语句的结果
+  SessionRequest                 *paused          = nullptr;      ///< 结果发送暂停的语句
+  std::unique_ptr<SessionRequest> statement_request;              ///< 多条语句时当前语句的请求
+  std::unique_ptr<QueryInfo>      query_info;                     ///< 正在执行的语句，结果发送完之后才能释放
+  std::chrono::high_resolution_clock::time_point start_time;     ///< 正在执行的语句开始的时间
+
+  ~RequestProgress();
+};
 
 /**
  * @brief 表示一个SQL请求
@@ -26,8 +51,24 @@ public:
 
   SqlResult *sql_result() { return &sql_result_; }
 
+  RequestProgress &progress() { return progress_; }
+
+  /**
+   * @brief 结果发送是否暂停了，暂停的请求需要在套接字可写之后继续执行
+   */
+  bool paused() const { return progress_.paused != nullptr; }
+
+  /**
+   * @brief 是否是关闭连接的请求
+   * @details IO线程发现连接断开时不直接释放会话，而是提交这样一个请求，由SQL线程关闭连接
+   */
+  bool close_request() const { return close_request_; }
+  void set_close_request(bool close_request) { close_request_ = close_request; }
+
 private:
-  Communicator *communicator_ = nullptr;  ///< 与客户端通讯的对象
-  SqlResult     sql_result_;              ///< SQL执行结果
-  std::string   query_;                   ///< SQL语句
+  Communicator   *communicator_ = nullptr;  ///< 与客户端通讯的对象
+  bool            close_request_ = false;   ///< 关闭连接的请求，没有SQL语句
+  SqlResult       sql_result_;              ///< SQL执行结果
+  std::string     query_;                   ///< SQL语句
+  RequestProgress progress_;                ///< 执行进度
 };
@@ -59,6 +59,9 @@ public:
 
   int file_desc() const;
 
+  /// 文件中已经分配的页面数，包括文件头所在的页面
+  int32_t allocated_page_count() const { return file_header_ == nullptr ? 0 : file_header_->allocated_pages; }
+
   RC recover_page(PageNum page_num);
 
   /**
@@ -100,6 +103,10 @@ public:
   ~BufferPoolIterator();
 
   RC init(FileBufferPool &bp, PageNum start_page = 0);
+  /**
+   * @brief 只遍历 (start_page, end_page) 之间已经分配的页面
+   */
+  RC init(FileBufferPool &bp, PageNum start_page, PageNum end_page);
   bool has_next();
   PageNum next();
   RC reset();
@@ -107,6 +114,7 @@ public:
 private:
   common::Bitmap bitmap_;
   PageNum current_page_num_ = -1;
+  PageNum end_page_num_ = -1;  ///< 小于0表示遍历到文件末尾
 };
 
 /**
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "include/common/rc.h"
+#include "include/query_engine/parser/value.h"
+
+class TableMeta;
+
+/**
+ * @brief 分块的布隆过滤器
+ * @ingroup Index
+ * @details 过滤器由若干个64字节(一个缓存行)的块组成，一个键只会落在一个块中，
+ * 在块的8个64位字中各设置一位，插入和查询都只访问一个缓存行。
+ * 静态方法直接操作调用方提供的内存(比如缓冲池中的页面)，对象本身是一个内存中的过滤器
+ */
+class BloomFilter
+{
+public:
+  static constexpr int BLOCK_SIZE = 64;
+  static constexpr int BITS_PER_KEY = 12;  ///< 每个键占用的位数，误判率大约是1%
+
+  BloomFilter() = default;
+
+  /// 按照预计的键的个数分配空间并清空
+  void init(int expected_keys);
+
+  void insert(uint64_t hash);
+  bool may_contain(uint64_t hash) const;
+
+  static void insert(char *blocks, int block_num, uint64_t hash);
+  static bool may_contain(const char *blocks, int block_num, uint64_t hash);
+
+private:
+  std::vector<uint64_t> words_;
+  int                   block_num_ = 0;
+};
+
+/**
+ * @brief 布隆过滤器的键
+ * @ingroup Index
+ * @details 由表中的若干个字段组成，按照字段在记录中的格式计算哈希，
+ * 保证记录中的值与相等的常量得到同样的哈希。
+ * 只支持整数、日期、布尔与定长字符串，浮点数按照误差比较、TEXT 在记录中保存的不是内容，都不能用哈希判断相等
+ */
+class BloomKey
+{
+public:
+  static bool support_type(AttrType type);
+
+  /// field_indexes 是字段在表中的序号
+  RC init(const TableMeta &table_meta, const std::vector<int> &field_indexes);
+
+  const std::vector<int> &field_indexes() const { return field_indexes_; }
+
+  /// 计算记录中的键的哈希，有字段为 NULL 时返回 false，这样的记录不会与任何值相等
+  bool hash_record(const char *record, uint64_t &hash) const;
+
+  /**
+   * @brief 计算与字段比较的常量的哈希
+   * @details 值的个数与字段的个数相同。有 NULL 或者类型与字段不同(需要类型转换才能比较)时返回 false
+   */
+  bool hash_values(const Value *values, uint64_t &hash) const;
+
+private:
+  struct Column
+  {
+    int      field_index = 0;
+    AttrType type        = UNDEFINED;
+    int      offset      = 0;
+    int      len         = 0;
+    bool     nullable    = false;
+  };
+
+  std::vector<int>    field_indexes_;
+  std::vector<Column> columns_;
+  int                 null_bitmap_offset_ = -1;
+  int                 null_bitmap_len_    = 0;
+};
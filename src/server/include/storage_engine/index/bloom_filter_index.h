@@ -0,0 +1,84 @@
+#pragma once
+
+#include <shared_mutex>
+
+#include "include/storage_engine/index/index.h"
+#include "include/storage_engine/index/bloom_filter.h"
+#include "include/storage_engine/buffer/buffer_pool.h"
+
+struct ZonePredicate;
+
+/**
+ * @brief 布隆过滤器索引文件的头
+ * @details 放在索引文件的第一个页面，第 g 组数据页面的过滤器放在第 FIRST_FILTER_PAGE + g 个页面
+ */
+struct BloomIndexFileHeader
+{
+  int32_t pages_per_group;  ///< 多少个数据页面共用一个过滤器
+  int32_t filter_num;       ///< 已经分配的过滤器页面个数
+};
+
+/**
+ * @brief 布隆过滤器索引
+ * @ingroup Index
+ * @details 把数据文件中连续的若干个页面分成一组，每组使用一个页面大小的分块布隆过滤器，
+ * 记录这组页面中出现过的键。过滤器页面通过缓冲池读写，与B+树索引一样在 sync 时落盘，
+ * 故障恢复时重做插入会重新设置对应的位。
+ * 索引只能回答某组页面中是否可能有某个键，不支持扫描，只用于 col = const 的条件跳过数据页面，
+ * 以及哈希连接把构建侧的键下推到探测侧的扫描时跳过页面。
+ * 布隆过滤器不能删除元素，删除记录时什么也不做，多出来的位只会增加误判
+ */
+class BloomFilterIndex : public Index
+{
+public:
+  static constexpr PageNum HEADER_PAGE       = 1;
+  static constexpr PageNum FIRST_FILTER_PAGE = 2;
+
+  BloomFilterIndex(Table *table) : table_(table)
+  {}
+  virtual ~BloomFilterIndex() noexcept;
+
+  RC create(const char *file_name, const IndexMeta &index_meta, const std::vector<FieldMeta> &multi_field_metas);
+  RC open(const char *file_name, const IndexMeta &index_meta, const std::vector<FieldMeta> &multi_field_metas);
+  RC close() override;
+
+  RC insert_entry(const char *record, const RID *rid) override;
+  RC delete_entry(const char *record, const RID *rid) override;
+
+  /**
+   * 不支持扫描，总是返回nullptr
+   */
+  IndexScanner *create_scanner(const char *left_key, int left_len, bool left_inclusive, const char *right_key,
+      int right_len, bool right_inclusive) override;
+
+  RC sync() override;
+
+  const BloomKey &key() const { return key_; }
+
+  /**
+   * @brief 根据扫描上的条件计算要查找的键
+   * @details 每个字段都需要有 字段 = 常量 的条件，单个字段的索引也可以使用 IN 常量列表。
+   * 条件不能确定要查找的键时返回 false
+   */
+  bool probe_hashes(const ZonePredicate &predicate, std::vector<uint64_t> &hashes) const;
+
+  /**
+   * @brief 数据页面所在的一组页面中是否可能有任意一个键
+   * @details 没有过滤器的页面返回 true
+   */
+  bool may_contain_any(PageNum page_num, const std::vector<uint64_t> &hashes) const;
+
+private:
+  RC init_key(const IndexMeta &index_meta, const std::vector<FieldMeta> &multi_field_metas);
+  RC write_header();
+
+  /// 分配过滤器页面，直到第 group 组有过滤器
+  RC ensure_filter(int group);
+
+private:
+  Table *               table_ = nullptr;
+  FileBufferPool *      file_buffer_pool_ = nullptr;
+  BloomIndexFileHeader  header_;
+  BloomKey              key_;
+  mutable std::shared_mutex lock_;  ///< 插入时修改过滤器页面，与查询互斥
+};
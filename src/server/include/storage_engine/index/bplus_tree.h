@@ -28,14 +28,25 @@ enum class BplusTreeOperationType
 
 /**
  * @brief 属性比较器
+ * @details 多列索引的键是各个字段按顺序拼接起来的，逐个字段按照各自的类型比较
  */
 class AttrComparator
 {
  public:
   void init(AttrType type, int length)
   {
-    attr_type_ = type;
-    attr_length_ = length;
+    init(1, &type, &length);
+  }
+
+  void init(int attr_amount, const AttrType types[], const int32_t lengths[])
+  {
+    attr_amount_ = attr_amount;
+    attr_length_ = 0;
+    for (int i = 0; i < attr_amount; i++) {
+      attr_types_[i] = types[i];
+      attr_lengths_[i] = lengths[i];
+      attr_length_ += lengths[i];
+    }
   }
 
   int attr_length() const
@@ -45,7 +56,21 @@ class AttrComparator
 
   int operator()(const char *v1, const char *v2) const
   {
-    switch (attr_type_) {
+    for (int i = 0; i < attr_amount_; i++) {
+      const int result = compare(attr_types_[i], attr_lengths_[i], v1, v2);
+      if (result != 0) {
+        return result;
+      }
+      v1 += attr_lengths_[i];
+      v2 += attr_lengths_[i];
+    }
+    return 0;
+  }
+
+ private:
+  static int compare(AttrType attr_type, int attr_length, const char *v1, const char *v2)
+  {
+    switch (attr_type) {
       case INTS: {
         return common::compare_int((void *)v1, (void *)v2);
       } break;
@@ -53,21 +78,23 @@ class AttrComparator
         return common::compare_float((void *)v1, (void *)v2);
       }
       case CHARS: {
-        return common::compare_string((void *)v1, attr_length_, (void *)v2, attr_length_);
+        return common::compare_string((void *)v1, attr_length, (void *)v2, attr_length);
       }
       case DATES: {
         return common::compare_int((void *)v1, (void *)v2);
       }
       default: {
-        ASSERT(false, "unknown attr type. %d", attr_type_);
+        ASSERT(false, "unknown attr type. %d", attr_type);
         return 0;
       }
     }
   }
 
  private:
-  AttrType attr_type_;
-  int attr_length_;
+  int attr_amount_ = 0;
+  AttrType attr_types_[MAX_FIELD_AMOUNT];
+  int32_t attr_lengths_[MAX_FIELD_AMOUNT];
+  int attr_length_ = 0;
 };
 
 /**
@@ -82,6 +109,11 @@ class KeyComparator
     attr_comparator_.init(type, length);
   }
 
+  void init(int attr_amount, const AttrType types[], const int32_t lengths[])
+  {
+    attr_comparator_.init(attr_amount, types, lengths);
+  }
+
   const AttrComparator &attr_comparator() const
   {
     return attr_comparator_;
@@ -203,7 +235,7 @@ struct IndexFileHeader
   AttrType multi_attr_types[MAX_FIELD_AMOUNT];   // 每个索引字段的类型
   int32_t attrs_length;       // 索引字段的总长度
   int32_t key_length;         // 索引键的总长度，attrs length + sizeof(RID)
-  AttrType attrs_type;        // 索引字段的整体类型：如果是多列索引，则统一视为CHAR类型
+  AttrType attrs_type;        // 索引字段的整体类型：如果是多列索引，则统一视为CHAR类型，比较时仍按各字段的类型
   bool is_unique_;            // 是否是唯一索引
 
   const std::string to_string()
@@ -555,7 +587,11 @@ class BplusTreeHandler
   RC adjust_root(Frame *root_frame);
 
  private:
-  common::MemPoolItem::unique_ptr make_key(const char *multi_keys[], const RID &rid, int multi_keys_num = 1, int left_or_right = 0, bool all_in_one_input_key = false);
+  /**
+   * @param left_or_right 0 插入，1 查找左边界，2 查找右边界，3 不带RID的完整键
+   * @param bound_key_len 查找边界时 multi_keys[0] 是拼接好的键，长度可以只覆盖前面若干个字段
+   */
+  common::MemPoolItem::unique_ptr make_key(const char *multi_keys[], const RID &rid, int multi_keys_num = 1, int left_or_right = 0, int bound_key_len = 0);
   void free_key(char *key);
 
  protected:
@@ -597,6 +633,11 @@ class BplusTreeScanner
 
   RC next_entry(RID &rid, bool isdelete);
 
+  /**
+   * @brief 上一次 next_entry 返回的索引项的键，在下一次调用 next_entry 之前有效
+   */
+  const char *current_key();
+
   RC close();
 
  private:
@@ -618,5 +659,6 @@ class BplusTreeScanner
 
   common::MemPoolItem::unique_ptr right_key_;
   int iter_index_ = 0;
+  int current_index_ = -1;  ///< 上一次返回的索引项在 current_frame_ 中的位置
   bool first_emitted_ = false;
 };
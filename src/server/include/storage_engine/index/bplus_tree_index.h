@@ -17,7 +17,7 @@ class BplusTreeIndex : public Index
 
   RC create(const char *file_name, const IndexMeta &index_meta, const std::vector<FieldMeta> &multi_field_metas);
   RC open(const char *file_name, const IndexMeta &index_meta, const std::vector<FieldMeta> &multi_field_metas);
-  RC close();
+  RC close() override;
 
   RC insert_entry(const char *record, const RID *rid) override;
   RC delete_entry(const char *record, const RID *rid) override;
@@ -52,6 +52,7 @@ class BplusTreeIndexScanner : public IndexScanner
   ~BplusTreeIndexScanner() noexcept override;
 
   RC next_entry(RID *rid, bool isdelete) override;
+  const char *current_key() override;
   RC destroy() override;
 
   RC open(const char *left_key, int left_len, bool left_inclusive, const char *right_key, int right_len,
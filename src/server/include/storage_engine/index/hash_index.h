@@ -0,0 +1,125 @@
+#pragma once
+
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+#include "include/storage_engine/index/index.h"
+#include "include/storage_engine/buffer/buffer_pool.h"
+
+/**
+ * @brief 哈希索引文件的头
+ * @details 放在索引文件的第一个页面，紧跟在后面的是 dir_page_num 个目录页面的页号。
+ * 目录有 2^global_depth 项，每项是一个桶页面的页号，按顺序存放在目录页面中
+ */
+struct HashIndexFileHeader
+{
+  int32_t key_len;          ///< 键的长度，多列索引是各个字段的长度之和
+  int32_t entry_size;       ///< 一个索引项的大小：哈希值 + 键 + RID
+  int32_t bucket_capacity;  ///< 一个桶页面可以放多少个索引项
+  int32_t global_depth;     ///< 目录使用哈希值的高 global_depth 位
+  int32_t dir_page_num;     ///< 目录页面的个数
+};
+
+/**
+ * @brief 哈希桶页面的头
+ * @details 后面紧跟着 size 个索引项。桶满了并且无法分裂(所有键的哈希值都相同或者目录已经最大)时，
+ * 把多出来的索引项放到溢出页面上，溢出页面使用同样的格式
+ */
+struct HashBucketHeader
+{
+  int32_t local_depth;  ///< 桶中所有键的哈希值的高 local_depth 位都相同
+  int32_t size;         ///< 页面中索引项的个数
+  PageNum overflow;     ///< 溢出页面，没有时是 BP_INVALID_PAGE_NUM
+};
+
+/**
+ * @brief 可扩展哈希索引
+ * @ingroup Index
+ * @details 目录常驻内存，一次等值查找只需要读取一个桶页面。
+ * 桶满时只分裂这一个桶，目录需要加倍时按照哈希值的高位把每一项复制成两项。
+ * 键按照字段在记录中的格式拼接，字符串后面补0，与多列B+树索引的键一致。
+ * 键中有 NULL 的记录不放到索引中，它们不会与任何值相等，唯一索引中也不会冲突。
+ * 只支持等值查找，键的类型与 BloomKey 一样需要能够按照字节判断相等
+ */
+class HashIndex : public Index
+{
+public:
+  static constexpr PageNum HEADER_PAGE = 1;
+
+  HashIndex(Table *table) : table_(table)
+  {}
+  virtual ~HashIndex() noexcept;
+
+  /// 可以放到哈希索引中的字段类型
+  static bool support_type(AttrType type);
+
+  RC create(const char *file_name, const IndexMeta &index_meta, const std::vector<FieldMeta> &multi_field_metas);
+  RC open(const char *file_name, const IndexMeta &index_meta, const std::vector<FieldMeta> &multi_field_metas);
+  RC close() override;
+
+  RC insert_entry(const char *record, const RID *rid) override;
+  RC delete_entry(const char *record, const RID *rid) override;
+
+  /**
+   * 只支持左右边界相同并且都包含边界的等值查找，其它范围返回nullptr。
+   * 比键短的边界按照字符串补0，比键长的边界不会与任何键相等
+   */
+  IndexScanner *create_scanner(const char *left_key, int left_len, bool left_inclusive, const char *right_key,
+      int right_len, bool right_inclusive) override;
+
+  RC sync() override;
+
+  /// 查找键对应的所有记录
+  RC find(const char *key, std::vector<RID> &rids);
+
+private:
+  RC init_null_bits();
+  /// 从记录中取出键，有字段为 NULL 时返回 false
+  bool make_key(const char *record, std::string &key) const;
+  uint32_t bucket_slot(uint32_t hash) const;
+
+  RC load_directory();
+  /// 把目录中 [begin, end) 的部分写到目录页面
+  RC write_directory(int begin, int end);
+  RC write_header();
+  /// 目录页面不够放下整个目录时分配新的页面
+  RC ensure_dir_pages();
+  RC double_directory();
+
+  /// 在键所在的桶及其溢出页面中找与键相同的索引项
+  RC find_in_bucket(uint32_t hash, const std::string &key, std::vector<RID> &rids);
+  /// 唯一索引中键相同的记录是否已经存在，正在被删除的记录不算
+  bool conflict(const std::vector<RID> &rids);
+
+  RC split_bucket(uint32_t slot, Frame *frame);
+  RC append_overflow(Frame *frame, const char *entry);
+
+private:
+  Table *               table_ = nullptr;
+  FileBufferPool *      file_buffer_pool_ = nullptr;
+  HashIndexFileHeader   header_;
+  std::vector<PageNum>  dir_pages_;  ///< 目录页面的页号
+  std::vector<PageNum>  directory_;  ///< 每个槽位对应的桶页面
+  std::vector<int>      null_bits_;  ///< 键中每个字段在 NULL 位图中的位置，不允许为 NULL 的字段是 -1
+  mutable std::shared_mutex lock_;
+};
+
+/**
+ * @brief 哈希索引扫描器
+ * @ingroup Index
+ * @details 创建时就找到了所有的记录，扫描过程中删除记录不影响后面的结果
+ */
+class HashIndexScanner : public IndexScanner
+{
+public:
+  HashIndexScanner(std::vector<RID> rids) : rids_(std::move(rids))
+  {}
+
+  RC next_entry(RID *rid, bool isdelete) override;
+  RC destroy() override;
+
+private:
+  std::vector<RID> rids_;
+  size_t           position_ = 0;
+};
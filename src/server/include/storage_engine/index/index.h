@@ -65,6 +65,11 @@ public:
    */
   virtual RC sync() = 0;
 
+  /**
+   * @brief 关闭索引文件
+   */
+  virtual RC close() = 0;
+
 protected:
   RC init(const IndexMeta &index_meta, const std::vector<FieldMeta> &multi_field_metas);
 
@@ -88,5 +93,11 @@ public:
    * 如果没有更多的元素，返回RECORD_EOF
    */
   virtual RC next_entry(RID *rid, bool isdelete) = 0;
+
+  /**
+   * 上一次 next_entry 返回的索引项的键，格式与索引中保存的一致(多列索引是各个字段拼接在一起)
+   * 不支持时返回nullptr
+   */
+  virtual const char *current_key() { return nullptr; }
   virtual RC destroy() = 0;
 };
@@ -17,6 +17,21 @@ namespace Json {
 class Value;
 }  // namespace Json
 
+/**
+ * @brief 索引的类型
+ * @ingroup Index
+ */
+enum class IndexType
+{
+  BPLUS_TREE,  ///< B+树，支持等值与范围查询
+  BLOOM,       ///< 按页面分组的布隆过滤器，只能用来判断一组页面中是否可能有某个值
+  HASH,        ///< 可扩展哈希，只支持等值查询
+};
+
+const char *index_type_to_string(IndexType type);
+/// 按名字(不区分大小写)解析索引类型，名字不认识时返回 INVALID_ARGUMENT
+RC index_type_from_string(const char *name, IndexType &type);
+
 /**
  * @brief 描述一个索引
  * @ingroup Index
@@ -27,14 +42,18 @@ class IndexMeta
 public:
   IndexMeta() = default;
 
-  RC init(bool unique, const char *name, std::vector<const FieldMeta *> &multi_fields);
+  RC init(bool unique, const char *name, std::vector<const FieldMeta *> &multi_fields,
+      IndexType type = IndexType::BPLUS_TREE);
 
 public:
   const char *name() const;
   const char *field(int i) const;
   const char *multi_fields() const;
   const size_t field_amount() const;
+  /// 用户字段的个数，不包含B+树的键中附带的系统字段，它们总是在用户字段的后面
+  size_t user_field_amount() const { return user_field_amount_; }
   const bool is_unique() const;
+  IndexType type() const { return type_; }
 
   void desc(std::ostream &os) const;
 
@@ -44,6 +63,8 @@ public:
 
 protected:
   bool is_unique_;  // 是否是唯一索引
+  IndexType type_ = IndexType::BPLUS_TREE;
   std::string name_;  // index's name
   std::vector<std::string> multi_fields_;
+  size_t user_field_amount_ = 0;
 };
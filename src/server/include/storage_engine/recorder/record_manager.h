@@ -1,5 +1,9 @@
 #pragma once
 
+#include <functional>
+#include <shared_mutex>
+#include <unordered_map>
+
 #include "include/storage_engine/buffer/buffer_pool.h"
 #include "include/storage_engine/recorder/record.h"
 #include "include/storage_engine/recorder/condition_filter.h"
@@ -288,6 +292,16 @@ public:
    */
   RC visit_record(const RID &rid, bool readonly, std::function<void(Record &)> visitor);
 
+  /**
+   * @brief 页面的可见性提示
+   * @details 页面上的记录都已经提交并且没有被删除时，提示中保存这些记录中最大的提交事务号，
+   * 之后开始的事务可以跳过这个页面上记录的可见性检查(参考 Trx::page_visible)，比如只扫描索引时不再读取数据页面。
+   * 提示由全表扫描时设置，页面上的记录发生变化时清除，只保存在内存中。没有提示时返回-1
+   */
+  int32_t visible_hint(PageNum page_num) const;
+  void    set_visible_hint(PageNum page_num, int32_t xid);
+  void    clear_visible_hint(PageNum page_num);
+
 private:
   /**
    * @brief 初始化当前没有填满记录的页面，初始化free_pages_成员
@@ -300,6 +314,9 @@ private:
   FileBufferPool             *file_buffer_pool_ = nullptr;
   std::unordered_set<PageNum> free_pages_;  // 没有填充满的页面集合
   common::Mutex               lock_;        // 未满page集合free_pages_的锁。当编译时增加-DCONCURRENCY=ON 选项时，才会真正的支持并发
+
+  std::unordered_map<PageNum, int32_t> visible_hints_;  // 页面的可见性提示
+  mutable std::shared_mutex            hint_lock_;      // 并行扫描时多个线程会同时设置提示，不依赖 CONCURRENCY 选项
 };
 
 /**
@@ -324,6 +341,12 @@ public:
    */
   RC open_scan(Table *table, FileBufferPool &buffer_pool, Trx *trx, bool readonly, ConditionFilter *condition_filter);
 
+  /**
+   * @brief 打开一个只遍历 [begin_page, end_page) 范围内页面的扫描，用于并行扫描时每个线程处理一部分页面
+   */
+  RC open_scan(Table *table, FileBufferPool &buffer_pool, Trx *trx, bool readonly, ConditionFilter *condition_filter,
+      PageNum begin_page, PageNum end_page);
+
   /**
    * @brief 关闭一个文件扫描，释放相应的资源
    */
@@ -344,6 +367,16 @@ public:
    */
   RC   next(Record &record);
 
+  /**
+   * @brief 设置页面过滤函数
+   * @details 返回 false 的页面不会被读取，比如根据页面摘要判断页面上没有满足条件的记录。
+   * 需要在打开扫描之前设置，关闭扫描之后仍然有效
+   */
+  void set_page_filter(std::function<bool(PageNum)> page_filter) { page_filter_ = std::move(page_filter); }
+
+  /// 被页面过滤函数跳过的页面数
+  int skipped_pages() const { return skipped_pages_; }
+
 private:
   /**
    * @brief 获取该文件中的下一条记录
@@ -367,4 +400,7 @@ private:
   RecordPageHandler  record_page_handler_;         // 处理文件某页面的记录
   RecordPageIterator record_page_iterator_;        // 遍历某个页面上的所有record
   Record             next_record_;                 // 获取的记录放在这里缓存起来
+  int32_t            page_visible_xid_ = -1;       // 当前页面已经遍历过的记录中最大的提交事务号，-1表示有不可见的记录
+  std::function<bool(PageNum)> page_filter_;       // 判断是否需要读取某个页面
+  int                skipped_pages_    = 0;
 };
\ No newline at end of file
@@ -4,13 +4,22 @@
 #include <vector>
 
 #include "include/storage_engine/recorder/table_meta.h"
+#include "include/storage_engine/index/index_meta.h"
 #include "include/query_engine/parser/value.h"
 #include "include/storage_engine/buffer/buffer_pool.h"
 #include "include/storage_engine/recorder/record.h"
+#include "include/storage_engine/recorder/table_stats.h"
+#include "include/storage_engine/recorder/zone_map.h"
 
 class RecordFileScanner;
 class RecordFileHandler;
 class Index;
+class Table;
+
+/**
+ * @brief 生成系统表中的全部记录
+ */
+using SystemRecordLoader = std::function<RC(Table &table, std::vector<Record> &records)>;
 
 /**
  * @brief 表
@@ -49,6 +58,18 @@ public:
       int attribute_count,
       const AttrInfoSqlNode attributes[]);
 
+  /**
+   * 创建一个系统表
+   * @details 系统表只在内存中，没有数据文件和索引，扫描时由 loader 生成当前的全部记录
+   * @param name 表名
+   * @param loader 生成记录的函数，记录通过 make_record 生成
+   */
+  RC create_system(int32_t table_id,
+      const char *name,
+      int attribute_count,
+      const AttrInfoSqlNode attributes[],
+      SystemRecordLoader loader);
+
   /**
    * 删除一个表
    * @param name 表名
@@ -86,9 +107,31 @@ public:
 
   RC recover_insert_record(Record &record);
 
-  RC create_index(Trx *trx, std::vector<const FieldMeta *> &multi_field_metas, const char *index_name, bool is_unique);
+  RC create_index(Trx *trx, std::vector<const FieldMeta *> &multi_field_metas, const char *index_name, bool is_unique,
+      IndexType index_type = IndexType::BPLUS_TREE);
 
   RC get_record_scanner(RecordFileScanner &scanner, Trx *trx, bool readonly);
+  RC get_record_scanner(RecordFileScanner &scanner, Trx *trx, bool readonly, PageNum begin_page, PageNum end_page);
+
+  /**
+   * @brief 把数据文件中已经分配的页面按顺序切分成若干段，每段最多包含 page_num_per_morsel 个页面
+   * @details 每一段用 [起始页面, 结束页面) 表示，用于并行扫描
+   */
+  RC split_pages(int page_num_per_morsel, std::vector<std::pair<PageNum, PageNum>> &morsels) const;
+
+  /**
+   * @brief 重新计算表的统计信息并保存到 <table>.stats 文件中
+   * @param worker_pool 用于并行扫描，为空时只在当前线程扫描
+   */
+  RC analyze(Trx *trx, WorkerPool *worker_pool);
+
+  const TableStats &stats() const { return stats_; }
+
+  /// 数据页面的摘要，扫描时用来跳过不可能有满足条件的记录的页面
+  const ZoneMap &zone_map() const { return zone_map_; }
+
+  /// 数据文件中已经分配的数据页面数(不包括文件头)，用于估计扫描的代价
+  int32_t data_page_count() const;
 
   RecordFileHandler *record_handler() const
   {
@@ -103,6 +146,9 @@ public:
   const TableMeta &table_meta() const;
 
   const bool is_view() const { return table_meta_.is_view(); }
+  bool is_system() const { return system_loader_ != nullptr; }
+  /// 生成系统表当前的全部记录
+  RC load_system_records(std::vector<Record> &records);
   const char *origin_table_name() const { return table_meta_.origin_table_name(); }
   SelectStmt *select_stmt() { return table_meta_.select_stmt(); }
 
@@ -126,4 +172,7 @@ private:
   FileBufferPool *data_buffer_pool_ = nullptr;   /// 数据文件关联的buffer pool
   RecordFileHandler *record_handler_ = nullptr;  /// 记录操作
   std::vector<Index *> indexes_;
+  TableStats  stats_;
+  ZoneMap     zone_map_;
+  SystemRecordLoader system_loader_;  /// 系统表生成记录的函数，普通表为空
 };
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "include/common/rc.h"
+#include "include/query_engine/parser/parse_defs.h"
+#include "include/query_engine/parser/value.h"
+
+class Table;
+class Trx;
+class WorkerPool;
+
+/// ANALYZE 时每张表最多采样的行数，直方图与高频值都从样本中计算
+#define STATS_SAMPLE_ROWS 30000
+
+/// 等深直方图的桶数
+#define STATS_HISTOGRAM_BUCKETS 32
+
+/// 每一列最多记录的高频值个数
+#define STATS_MCV_NUM 16
+
+/// 统计信息不可用时，单个比较条件的默认选择率
+#define DEFAULT_SELECTIVITY (1.0 / 3)
+#define DEFAULT_EQ_SELECTIVITY 0.1
+
+/**
+ * @brief HyperLogLog 基数估计
+ * @details 使用 2^10 个 6bit 的寄存器(按字节存放)，标准误差约为 3%。
+ * 多个线程各自统计之后可以合并，寄存器以十六进制字符串的形式持久化
+ */
+class HyperLogLog
+{
+public:
+  static constexpr int PRECISION = 10;
+  static constexpr int REGISTER_NUM = 1 << PRECISION;
+
+  HyperLogLog() : registers_(REGISTER_NUM, 0) {}
+
+  void add(const Value &value);
+  void add_hash(uint64_t hash);
+  void merge(const HyperLogLog &other);
+  double estimate() const;
+
+  std::string to_string() const;
+  RC from_string(const std::string &str);
+
+  static uint64_t hash_value(const Value &value);
+
+private:
+  std::vector<uint8_t> registers_;
+};
+
+/**
+ * @brief 单列的统计信息
+ * @details null_frac、mcv_freqs 与 histogram_frac 都是相对于全表行数的比例，
+ * 直方图只描述不在高频值列表中的非空值，相邻两个边界之间包含的行数大致相同
+ */
+struct ColumnStats
+{
+  std::string name;
+  AttrType type = UNDEFINED;
+  double null_frac = 0;
+  double ndv = 0;  ///< 不同的非空值个数
+
+  std::vector<Value> mcv_values;
+  std::vector<double> mcv_freqs;
+
+  std::vector<Value> histogram;  ///< 等深直方图的桶边界，有 n+1 个边界时表示 n 个桶
+  double histogram_frac = 0;
+
+  HyperLogLog hll;
+
+  /**
+   * @brief 估计 "列 op value" 的选择率
+   * @details 支持等值、不等与范围比较，以及 IS [NOT] NULL。其它运算返回默认值
+   */
+  double selectivity(CompOp op, const Value &value) const;
+  double eq_selectivity(const Value &value) const;
+
+  /// 列值小于(或者小于等于) value 的行所占的比例
+  double less_selectivity(const Value &value, bool inclusive) const;
+
+private:
+  double histogram_position(const Value &value) const;
+};
+
+/**
+ * @brief 表的统计信息
+ * @details 由 ANALYZE 计算，保存在表元数据旁边的 <table>.stats 文件中。
+ * 两次 ANALYZE 之间用插入、删除计数器维护行数，优化器据此判断统计信息是否过期
+ */
+class TableStats
+{
+public:
+  TableStats() = default;
+
+  /// 新创建的表，行数从0开始精确计数
+  void init_empty();
+
+  RC load(const std::string &file);
+  RC save(const std::string &file) const;
+
+  void on_insert() { inserted_.fetch_add(1, std::memory_order_relaxed); }
+  void on_delete() { deleted_.fetch_add(1, std::memory_order_relaxed); }
+
+  /// 行数是否可信。对于老版本创建且从来没有 ANALYZE 过的表，只能通过页面数估计
+  bool row_count_known() const { return row_count_known_; }
+  int64_t row_count() const;
+  bool analyzed() const;
+  int64_t page_count() const;
+
+  /// 上次 ANALYZE 以来插入与删除的行数
+  int64_t modified_rows() const;
+
+  /**
+   * @brief 获取某一列的统计信息
+   * @details 返回的是一份拷贝。数据量变化之后，接近唯一的列会按行数等比例调整不同值的个数
+   */
+  bool column(const char *name, ColumnStats &stats) const;
+
+  void set_analyzed(int64_t rows, int64_t pages, std::vector<ColumnStats> &&columns);
+
+  /**
+   * @brief 扫描整张表并重新计算统计信息
+   * @details 数据页面被切分成若干段，由线程池并行扫描。每个线程精确统计行数和空值个数，
+   * 用 HyperLogLog 估计不同值个数，用蓄水池抽样保留一部分行；最后合并样本并计算高频值与直方图
+   */
+  static RC analyze(Table *table, Trx *trx, WorkerPool *worker_pool, std::vector<ColumnStats> &columns,
+      int64_t &rows, int64_t &pages);
+
+private:
+  mutable std::mutex lock_;
+  bool row_count_known_ = false;
+  bool analyzed_ = false;
+  int64_t base_rows_ = 0;  ///< 上次 ANALYZE (或者建表)时的行数
+  int64_t pages_ = 0;
+  std::shared_ptr<const std::vector<ColumnStats>> columns_;
+
+  std::atomic<int64_t> inserted_{0};
+  std::atomic<int64_t> deleted_{0};
+};
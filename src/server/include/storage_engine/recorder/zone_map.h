@@ -0,0 +1,93 @@
+#pragma once
+
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "include/common/rc.h"
+#include "include/common/setting.h"
+#include "include/query_engine/parser/parse_defs.h"
+#include "include/query_engine/parser/value.h"
+
+class Table;
+class TableMeta;
+
+/**
+ * @brief 判断数据页面能否跳过的条件
+ * @details 由扫描上的谓词转换得到。AND/OR 节点组合子条件，比较节点表示 列 op 常量 或者 列 IS [NOT] NULL
+ */
+struct ZonePredicate
+{
+  enum class Kind
+  {
+    AND,
+    OR,
+    COMPARE,
+  };
+
+  Kind  kind        = Kind::AND;
+  int   field_index = -1;  ///< 字段在表中的序号
+  CompOp comp       = NO_OP;
+  Value value;
+  std::vector<ZonePredicate> children;
+};
+
+/**
+ * @brief 数据页面的摘要(zone map)
+ * @details 记录每个页面上每一列的最小值、最大值与空值个数。插入记录时只会扩大范围，删除记录时不会缩小，
+ * 所以摘要描述的范围总是包含页面上的所有数据，空值个数是一个上限。
+ * 摘要只保存在内存中，打开表时扫描一遍数据构建，重启之后删除的数据不再影响范围。
+ * 扫描时如果某个页面的摘要说明页面上不可能有满足条件的记录，就不需要读取这个页面
+ */
+class ZoneMap
+{
+public:
+  ZoneMap() = default;
+
+  /**
+   * @brief 扫描表中所有的记录构建摘要
+   * @details 只在打开或创建表时调用，此时没有并发的修改
+   */
+  RC build(Table *table);
+
+  /// 插入记录之后扩大记录所在页面的范围
+  void on_insert(PageNum page_num, const char *record);
+
+  /**
+   * @brief 页面上是否可能有满足条件的记录
+   * @details 没有摘要的页面以及无法判断的条件都返回 true
+   */
+  bool may_match(PageNum page_num, const ZonePredicate &predicate) const;
+
+private:
+  struct ColumnZone
+  {
+    bool  has_value  = false;  ///< 是否有非空值，没有时 min 与 max 无效
+    int   null_count = 0;
+    Value min;
+    Value max;
+  };
+  using PageZone = std::vector<ColumnZone>;
+
+  struct Column
+  {
+    int      field_index = 0;
+    AttrType type        = UNDEFINED;
+    int      offset      = 0;
+    int      len         = 0;
+  };
+
+  void widen(PageZone &zone, const char *record) const;
+  bool may_match(const PageZone &zone, const ZonePredicate &predicate) const;
+  bool may_match(const ColumnZone &zone, AttrType type, CompOp comp, const Value &value) const;
+
+private:
+  std::vector<Column> columns_;
+  std::vector<int>    column_of_field_;  ///< 字段序号到 columns_ 下标的映射，不记录摘要的字段为-1
+  int                 null_offset_ = 0;
+  int                 null_len_    = 0;
+
+  bool built_ = false;  ///< 构建完成之前所有的页面都不能跳过，也不维护摘要
+  std::unordered_map<PageNum, PageZone> pages_;
+  mutable std::shared_mutex             lock_;  ///< 插入与并行扫描会同时访问，不依赖 CONCURRENCY 选项
+};
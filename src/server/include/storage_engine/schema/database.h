@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <fcntl.h>
 #include <sys/stat.h>
 
@@ -47,6 +48,7 @@ public:
 
   RC drop_table(const char *table_name);
 
+  /// 数据库中没有这个表时，再查找同名的系统表
   Table *find_table(const char *table_name) const;
   Table *find_table(int32_t table_id) const;
 
@@ -60,6 +62,13 @@ public:
 
   LogManager *log_manager();
 
+  /**
+   * @brief 模式版本
+   * @details 表、视图、索引以及统计信息发生变化时加一，缓存的查询计划记录生成时的版本，版本不同时计划失效
+   */
+  uint64_t schema_version() const { return schema_version_.load(); }
+  void bump_schema_version() { schema_version_++; }
+
 private:
   RC open_all_tables();
 
@@ -71,4 +80,6 @@ private:
 
   /// 给每个table都分配一个ID，用来记录日志。这里假设所有的DDL都不会并发操作，所以相关的数据都不上锁
   int32_t next_table_id_ = 0;
+
+  std::atomic<uint64_t> schema_version_{0};
 };
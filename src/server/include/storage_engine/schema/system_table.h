@@ -0,0 +1,35 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "include/common/rc.h"
+#include "include/storage_engine/recorder/table.h"
+
+/**
+ * @brief 系统表
+ * @details 系统表只存在于内存中，所有数据库共享，在任何数据库中都可以用表名直接查询，但是不能修改。
+ * 数据库中有同名的表时优先使用数据库中的表。系统表的表ID从 SYSTEM_TABLE_ID_BEGIN 开始，不会与普通表冲突。
+ */
+class SystemTables
+{
+public:
+  static constexpr int32_t SYSTEM_TABLE_ID_BEGIN = 1 << 30;
+
+  static SystemTables &instance();
+
+  /**
+   * @brief 注册一个系统表，需要在事务模块初始化之后调用，表中的隐藏字段由事务模块决定
+   */
+  RC add(const char *name, int attribute_count, const AttrInfoSqlNode attributes[], SystemRecordLoader loader);
+
+  Table *find(const char *name) const;
+
+  /// 释放所有系统表
+  void clear();
+
+private:
+  mutable std::mutex                  lock_;
+  std::vector<std::unique_ptr<Table>> tables_;
+};
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <mutex>
+
 #include "include/storage_engine/transaction/trx.h"
 
+class MvccTrx;
+
 /**
 * @brief MVCC(多版本并发控制)事务管理器
  */
@@ -18,10 +22,14 @@ public:
   // 找到对应事务号的事务，当前仅在recover场景下使用
   Trx *find_trx(int32_t trx_id) override;
   void all_trxes(std::vector<Trx *> &trxes) override;
+  /**
+   * @brief 已经结束的事务对象放到空闲列表中，create_trx 时重新初始化之后复用，不再重新分配
+   */
   void destroy_trx(Trx *trx) override;
 
   int32_t next_trx_id();
-  int32_t max_trx_id() const;
+  /// 还没有被删除的记录的 end_xid
+  static int32_t max_trx_id();
 
   // 在 recover 场景下使用，确保当前事务 id 不小于 trx_id
   void update_trx_id(int32_t trx_id);
@@ -29,8 +37,12 @@ public:
 private:
   std::vector<FieldMeta> fields_; // 存储事务数据需要用到的字段元数据，所有表结构都需要带
   std::atomic<int32_t> current_trx_id_{0};
-  common::Mutex      lock_;
+  // 空闲的事务对象在不同的会话之间复用，没有打开并发编译选项时也要真正加锁
+  std::mutex         lock_;
   std::vector<Trx *> trxes_;
+  std::vector<MvccTrx *> free_trxes_;  ///< 可以复用的事务对象，最多保留 MAX_FREE_TRX_NUM 个
+
+  static const size_t MAX_FREE_TRX_NUM = 1024;
 };
 
 class MvccTrx : public Trx
@@ -56,6 +68,13 @@ class MvccTrx : public Trx
    */
   RC visit_record(Table *table, Record &record, bool readonly) override;
 
+  int32_t visible_xid(Table *table, const Record &record) override;
+
+  /**
+   * @brief 页面上最大的提交事务号不超过当前事务号时，所有记录都对当前事务可见
+   */
+  bool page_visible(int32_t hint) override { return started_ && hint >= 0 && hint <= trx_id_; }
+
   RC start_if_need() override;
   RC commit() override;
   RC rollback() override;
@@ -64,6 +83,16 @@ class MvccTrx : public Trx
 
   int32_t id() const override { return trx_id_; }
 
+  /**
+   * @brief 事务没有开始或者已经提交、回滚，并且不是恢复时创建的，对象可以复用
+   */
+  bool reusable() const { return !started_ && !recovering_ && operations_.empty(); }
+
+  /**
+   * @brief 复用事务对象，恢复成新建时的状态。操作集合清空之后仍然保留分配好的桶
+   */
+  void reinit(LogManager *log_manager);
+
  private:
   /**
    * @brief 获取指定表上的与版本号相关的字段
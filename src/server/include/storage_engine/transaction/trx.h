@@ -102,6 +102,17 @@ public:
   virtual RC delete_record(Table *table, Record &record) = 0;
   virtual RC visit_record(Table *table, Record &record, bool readonly) = 0;
 
+  /**
+   * @brief 记录已经提交并且没有被删除时，返回使它可见的事务号，否则返回-1
+   * @details 用于维护数据页面的可见性提示，参考 RecordFileHandler::visible_hint
+   */
+  virtual int32_t visible_xid(Table *table, const Record &record) = 0;
+
+  /**
+   * @brief 页面的可见性提示为 hint 时，页面上所有记录是否都对当前事务可见
+   */
+  virtual bool page_visible(int32_t hint) = 0;
+
   virtual RC start_if_need() = 0;
   virtual RC commit() = 0;
   virtual RC rollback() = 0;
@@ -31,6 +31,8 @@ public:
  RC insert_record(Table *table, Record &record) override;
  RC delete_record(Table *table, Record &record) override;
  RC visit_record(Table *table, Record &record, bool readonly) override;
+ int32_t visible_xid(Table *table, const Record &record) override { return 0; }
+ bool page_visible(int32_t hint) override { return true; }
 
  RC start_if_need() override;
  RC commit() override;
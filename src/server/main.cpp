@@ -22,7 +22,7 @@ void usage()
   std::cout << "-p: server port. if not specified, the item in the config file will be used" << std::endl;
   std::cout << "-f: path of config file." << std::endl;
   std::cout << "-s: use unix socket and the argument is socket address" << std::endl;
-  std::cout << "-P: protocol. {plain(default), mysql, cli}." << std::endl;
+  std::cout << "-P: protocol. {plain(default), mysql, cli, binary}." << std::endl;
   std::cout << "-t: transaction model. {vacuous(default), mvcc}." << std::endl;
   std::cout << "-n: buffer pool memory size in byte" << std::endl;
 }
@@ -112,8 +112,51 @@ Server *init_server()
   server_param.listen_addr = listen_addr;
   server_param.max_connection_num = max_connection_num;
   server_param.port = port;
+
+  it = net_section.find(SEND_WINDOW_SIZE);
+  if (it != net_section.end()) {
+    std::string str = it->second;
+    str_to_val(str, server_param.send_window_size);
+  }
+
+  it = net_section.find(REUSE_PORT);
+  if (it != net_section.end()) {
+    str_to_val(it->second, server_param.reuse_port);
+  }
+  it = net_section.find(TCP_NODELAY_OPTION);
+  if (it != net_section.end()) {
+    str_to_val(it->second, server_param.tcp_nodelay);
+  }
+  it = net_section.find(TCP_CORK_OPTION);
+  if (it != net_section.end()) {
+    str_to_val(it->second, server_param.tcp_cork);
+  }
+
+  it = net_section.find(SHM_TRANSPORT);
+  if (it != net_section.end()) {
+    str_to_val(it->second, server_param.shm_transport);
+  }
+  it = net_section.find(SHM_RING_SIZE);
+  if (it != net_section.end()) {
+    str_to_val(it->second, server_param.shm_ring_size);
+  }
+  it = net_section.find(SHM_SPIN_US);
+  if (it != net_section.end()) {
+    str_to_val(it->second, server_param.shm_spin_us);
+  }
+  it = net_section.find(SESSION_POOL_SIZE);
+  if (it != net_section.end()) {
+    str_to_val(it->second, server_param.session_pool_size);
+  }
+
+  std::string thread_num_str = get_properties()->get(THREAD_COUNT, "0", IO_THREADS);
+  str_to_val(thread_num_str, server_param.io_thread_num);
+  thread_num_str = get_properties()->get(THREAD_COUNT, "0", SQL_THREADS);
+  str_to_val(thread_num_str, server_param.sql_thread_num);
   if (0 == strcasecmp(process_param->get_protocol().c_str(), "mysql")) {
     server_param.protocol = CommunicateProtocol::MYSQL;
+  } else if (0 == strcasecmp(process_param->get_protocol().c_str(), "binary")) {
+    server_param.protocol = CommunicateProtocol::BINARY;
   } else if (0 == strcasecmp(process_param->get_protocol().c_str(), "cli")) {
     server_param.use_std_io = true;
     server_param.protocol = CommunicateProtocol::CLI;
@@ -4,6 +4,7 @@
 #include "include/query_engine/structor/expression/attribute_expression.h"
 #include "include/query_engine/structor/expression/arithmetic_expression.h"
 #include "include/query_engine/structor/expression/value_expression.h"
+#include "include/query_engine/structor/expression/param_expression.h"
 #include "include/query_engine/analyzer/statement/select_stmt.h"
 
 RC analyze_expression(
@@ -166,6 +167,10 @@ RC analyze_expression(
     res_expr->set_name(expr->name());
     res_expr->set_alias(expr->alias());
     return RC::SUCCESS;
+
+  } else if (expr->type() == ExprType::PARAM) {
+    res_expr = dynamic_cast<const ParamExpr *>(expr)->copy();
+    return RC::SUCCESS;
   }
 
   return RC::UNIMPLENMENT;
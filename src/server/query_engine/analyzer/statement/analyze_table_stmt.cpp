@@ -0,0 +1,26 @@
+#include "include/query_engine/analyzer/statement/analyze_table_stmt.h"
+#include "include/storage_engine/schema/database.h"
+
+RC AnalyzeTableStmt::create(Db *db, const AnalyzeTableSqlNode &analyze_table, Stmt *&stmt)
+{
+  std::vector<Table *> tables;
+  if (!analyze_table.relation_name.empty()) {
+    Table *table = db->find_table(analyze_table.relation_name.c_str());
+    if (table == nullptr || table->is_view() || table->is_system()) {
+      return RC::SCHEMA_TABLE_NOT_EXIST;
+    }
+    tables.push_back(table);
+  } else {
+    std::vector<std::string> table_names;
+    db->all_tables(table_names);
+    for (const std::string &table_name : table_names) {
+      Table *table = db->find_table(table_name.c_str());
+      if (table != nullptr && !table->is_view()) {
+        tables.push_back(table);
+      }
+    }
+  }
+
+  stmt = new AnalyzeTableStmt(std::move(tables));
+  return RC::SUCCESS;
+}
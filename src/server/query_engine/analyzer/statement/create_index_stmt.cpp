@@ -1,5 +1,7 @@
 #include "include/query_engine/analyzer/statement/create_index_stmt.h"
 #include "include/storage_engine/recorder/table.h"
+#include "include/storage_engine/index/bloom_filter.h"
+#include "include/storage_engine/index/hash_index.h"
 #include "include/storage_engine/schema/database.h"
 #include "common/lang/string.h"
 #include "common/log/log.h"
@@ -24,6 +26,23 @@ RC CreateIndexStmt::create(Db *db, const CreateIndexSqlNode &create_index, Stmt
     LOG_WARN("no such table. db=%s, table_name=%s", db->name(), table_name);
     return RC::SCHEMA_TABLE_NOT_EXIST;
   }
+  if (table->is_system()) {
+    LOG_WARN("system table is read only. table_name=%s", table_name);
+    return RC::INVALID_ARGUMENT;
+  }
+
+  IndexType index_type = IndexType::BPLUS_TREE;
+  if (!create_index.index_type.empty() &&
+      index_type_from_string(create_index.index_type.c_str(), index_type) != RC::SUCCESS) {
+    LOG_WARN("unknown index type. table=%s, index=%s, type=%s",
+        table_name, create_index.index_name.c_str(), create_index.index_type.c_str());
+    return RC::INVALID_ARGUMENT;
+  }
+  // 布隆过滤器无法确定键是否已经存在
+  if (index_type == IndexType::BLOOM && create_index.is_unique_) {
+    LOG_WARN("bloom index can not be unique. table=%s, index=%s", table_name, create_index.index_name.c_str());
+    return RC::INVALID_ARGUMENT;
+  }
 
   std::vector<const FieldMeta*> multi_field_metas;
   for (int i = 0; i < create_index.multi_attribute_names.size(); i++) {
@@ -33,11 +52,25 @@ RC CreateIndexStmt::create(Db *db, const CreateIndexSqlNode &create_index, Stmt
              db->name(), table_name, create_index.multi_attribute_names[i].c_str());
       return RC::SCHEMA_FIELD_NOT_EXIST;
     }
+    // 布隆过滤器按照哈希判断相等，浮点数与长文本不能这样比较
+    if (index_type == IndexType::BLOOM && !BloomKey::support_type(field_meta->type())) {
+      LOG_WARN("bloom index does not support field type. table=%s, field name=%s, type=%d",
+             table_name, field_meta->name(), field_meta->type());
+      return RC::INVALID_ARGUMENT;
+    }
+    if (index_type == IndexType::HASH && !HashIndex::support_type(field_meta->type())) {
+      LOG_WARN("hash index does not support field type. table=%s, field name=%s, type=%d",
+             table_name, field_meta->name(), field_meta->type());
+      return RC::INVALID_ARGUMENT;
+    }
     multi_field_metas.emplace_back(field_meta);
   }
 
-  for (int i = 0; i < table->table_meta().sys_field_num(); i ++) {
-    multi_field_metas.emplace_back(table->table_meta().field(i));
+  // B+树的键带上系统字段以区分同一行的多个版本，布隆过滤器与哈希索引只关心用户字段的值
+  if (index_type == IndexType::BPLUS_TREE) {
+    for (int i = 0; i < table->table_meta().sys_field_num(); i ++) {
+      multi_field_metas.emplace_back(table->table_meta().field(i));
+    }
   }
 
   Index *index = table->find_index(create_index.index_name.c_str());
@@ -46,7 +79,7 @@ RC CreateIndexStmt::create(Db *db, const CreateIndexSqlNode &create_index, Stmt
     return RC::SCHEMA_INDEX_NAME_REPEAT;
   }
 
-  stmt = new CreateIndexStmt(table, multi_field_metas, create_index.index_name, create_index.is_unique_);
+  stmt = new CreateIndexStmt(table, multi_field_metas, create_index.index_name, create_index.is_unique_, index_type);
 
   return RC::SUCCESS;
 }
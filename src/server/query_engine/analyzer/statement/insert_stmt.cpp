@@ -23,6 +23,10 @@ RC InsertStmt::create(Db *db, const InsertSqlNode &inserts, Stmt *&stmt)
     LOG_WARN("no such table. db=%s, table_name=%s", db->name(), table_name);
     return RC::SCHEMA_TABLE_NOT_EXIST;
   }
+  if (table->is_system()) {
+    LOG_WARN("system table is read only. table_name=%s", table_name);
+    return RC::INVALID_ARGUMENT;
+  }
   Table *view;
   bool is_view = table->is_view();
   if (is_view) {
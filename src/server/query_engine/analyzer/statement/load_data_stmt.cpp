@@ -23,6 +23,10 @@ RC LoadDataStmt::create(Db *db, const LoadDataSqlNode &load_data, Stmt *&stmt)
     LOG_WARN("no such table. db=%s, table_name=%s", db->name(), table_name);
     return RC::SCHEMA_TABLE_NOT_EXIST;
   }
+  if (table->is_system()) {
+    LOG_WARN("system table is read only. table_name=%s", table_name);
+    return RC::INVALID_ARGUMENT;
+  }
 
   if (0 != access(load_data.file_name.c_str(), R_OK)) {
     LOG_WARN("no such file to load. file name=%s, error=%s", load_data.file_name.c_str(), strerror(errno));
@@ -363,6 +363,8 @@ RC SelectStmt::create(Db *db, const SelectSqlNode &select_sql, Stmt *&stmt)
   select_stmt->having_stmt_ = having_stmt;
   select_stmt->order_stmt_ = order_stmt;
   select_stmt->join_filter_stmts_.swap(join_filter_stmts);
+  select_stmt->limit_ = select_sql.limit.limit;
+  select_stmt->offset_ = select_sql.limit.offset;
   stmt = select_stmt;
   return RC::SUCCESS;
 }
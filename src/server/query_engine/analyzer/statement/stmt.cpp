@@ -9,12 +9,15 @@
 #include "include/query_engine/analyzer/statement/create_table_stmt.h"
 #include "include/query_engine/analyzer/statement/drop_table_stmt.h"
 #include "include/query_engine/analyzer/statement/desc_table_stmt.h"
+#include "include/query_engine/analyzer/statement/analyze_table_stmt.h"
 #include "include/query_engine/analyzer/statement/help_stmt.h"
 #include "include/query_engine/analyzer/statement/show_tables_stmt.h"
 #include "include/query_engine/analyzer/statement/exit_stmt.h"
 #include "include/query_engine/analyzer/statement/load_data_stmt.h"
 #include "include/query_engine/analyzer/statement/trx_begin_stmt.h"
 #include "include/query_engine/analyzer/statement/trx_end_stmt.h"
+#include "include/query_engine/analyzer/statement/prepare_stmt.h"
+#include "include/query_engine/analyzer/statement/reset_session_stmt.h"
 
 RC Stmt::create_stmt(Db *db, ParsedSqlNode &sql_node, Stmt *&stmt)
 {
@@ -48,6 +51,9 @@ RC Stmt::create_stmt(Db *db, ParsedSqlNode &sql_node, Stmt *&stmt)
     case SCF_DESC_TABLE: {
       return DescTableStmt::create(db, sql_node.desc_table, stmt);
     }
+    case SCF_ANALYZE_TABLE: {
+      return AnalyzeTableStmt::create(db, sql_node.analyze_table, stmt);
+    }
     case SCF_HELP: {
       return HelpStmt::create(stmt);
     }
@@ -73,6 +79,22 @@ RC Stmt::create_stmt(Db *db, ParsedSqlNode &sql_node, Stmt *&stmt)
       return TrxEndStmt::create(sql_node.flag, stmt);
     }
 
+    case SCF_PREPARE: {
+      return PrepareStmt::create(sql_node.prepare, stmt);
+    }
+
+    case SCF_EXECUTE: {
+      return ExecuteStmt::create(sql_node.execute, stmt);
+    }
+
+    case SCF_DEALLOCATE_PREPARE: {
+      return DeallocatePrepareStmt::create(sql_node.deallocate, stmt);
+    }
+
+    case SCF_RESET_SESSION: {
+      return ResetSessionStmt::create(stmt);
+    }
+
     default: {
       LOG_INFO("Command::type %d doesn't need to create statement.", sql_node.flag);
     } break;
@@ -32,6 +32,10 @@ RC UpdateStmt::create(Db *db, const UpdateSqlNode &update, Stmt *&stmt)
     LOG_WARN("no such table. db=%s, table_name=%s", db->name(), table_name);
     return RC::SCHEMA_TABLE_NOT_EXIST;
   }
+  if (table->is_system()) {
+    LOG_WARN("system table is read only. table_name=%s", table_name);
+    return RC::INVALID_ARGUMENT;
+  }
   if (table->is_view()) {
     table = db->find_table(table->origin_table_name());
     if (nullptr == table) {
@@ -57,7 +61,7 @@ RC UpdateStmt::create(Db *db, const UpdateSqlNode &update, Stmt *&stmt)
         Expression *expression = nullptr;
         const std::unordered_map <std::string, Table *> table_map;
         const std::vector <Table *>                     tables;
-        if (expr->type() == ExprType::VALUE) {
+        if (expr->type() == ExprType::VALUE || expr->type() == ExprType::PARAM) {
           RC rc = analyze_expression(expr, db, table_map, tables, expression);
           if (RC::SUCCESS != rc) {
             LOG_ERROR("Analyze ValueExpr Failed. RC = %d:%s", rc, strrc(rc));
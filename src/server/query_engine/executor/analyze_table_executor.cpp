@@ -0,0 +1,71 @@
+#include "include/query_engine/executor/analyze_table_executor.h"
+
+#include <cmath>
+
+#include "include/common/global_context.h"
+#include "include/query_engine/structor/query_info.h"
+#include "include/session/session.h"
+#include "include/query_engine/analyzer/statement/analyze_table_stmt.h"
+#include "include/query_engine/planner/operator/string_list_physical_operator.h"
+#include "include/storage_engine/recorder/table.h"
+#include "include/storage_engine/schema/database.h"
+
+using namespace std;
+
+RC AnalyzeTableExecutor::execute(QueryInfo *query_info)
+{
+  Stmt *stmt = query_info->stmt();
+  SessionRequest *session_event = query_info->session_event();
+  Session *session = session_event->session();
+  ASSERT(stmt->type() == StmtType::ANALYZE_TABLE,
+         "analyze table executor can not run this command: %d", static_cast<int>(stmt->type()));
+
+  AnalyzeTableStmt *analyze_stmt = static_cast<AnalyzeTableStmt *>(stmt);
+  SqlResult *sql_result = session_event->sql_result();
+  Trx *trx = session->current_trx();
+
+  TupleSchema tuple_schema;
+  tuple_schema.append_cell(TupleCellSpec("", "Table", "Table"));
+  tuple_schema.append_cell(TupleCellSpec("", "Column", "Column"));
+  tuple_schema.append_cell(TupleCellSpec("", "Rows", "Rows"));
+  tuple_schema.append_cell(TupleCellSpec("", "Null_frac", "Null_frac"));
+  tuple_schema.append_cell(TupleCellSpec("", "NDV", "NDV"));
+  tuple_schema.append_cell(TupleCellSpec("", "MCV", "MCV"));
+  tuple_schema.append_cell(TupleCellSpec("", "Buckets", "Buckets"));
+
+  auto oper = new StringListPhysicalOperator;
+  for (Table *table : analyze_stmt->tables()) {
+    RC rc = table->analyze(trx, GCTX.worker_pool_);
+    if (rc != RC::SUCCESS) {
+      delete oper;
+      return rc;
+    }
+
+    const TableStats &stats = table->stats();
+    const TableMeta &table_meta = table->table_meta();
+    const string rows = to_string(stats.row_count());
+    for (int i = table_meta.sys_field_num(); i < table_meta.field_num() - table_meta.null_filed_num(); i++) {
+      ColumnStats column;
+      if (!stats.column(table_meta.field(i)->name(), column)) {
+        continue;
+      }
+      char null_frac[32];
+      snprintf(null_frac, sizeof(null_frac), "%.4f", column.null_frac);
+      const int buckets = column.histogram.empty() ? 0 : static_cast<int>(column.histogram.size()) - 1;
+      oper->append({table->name(),
+          column.name,
+          rows,
+          null_frac,
+          to_string(static_cast<int64_t>(std::llround(column.ndv))),
+          to_string(column.mcv_values.size()),
+          to_string(buckets)});
+    }
+  }
+
+  // 统计信息变化之后缓存的计划需要重新估计代价
+  session->get_current_db()->bump_schema_version();
+
+  sql_result->set_tuple_schema(tuple_schema);
+  sql_result->set_operator(unique_ptr<PhysicalOperator>(oper));
+  return RC::SUCCESS;
+}
@@ -5,12 +5,15 @@
 #include "include/query_engine/executor/create_index_executor.h"
 #include "include/query_engine/executor/create_table_executor.h"
 #include "include/query_engine/executor/desc_table_executor.h"
+#include "include/query_engine/executor/analyze_table_executor.h"
 #include "include/query_engine/executor/drop_table_executor.h"
 #include "include/query_engine/executor/help_executor.h"
 #include "include/query_engine/executor/show_tables_executor.h"
 #include "include/query_engine/executor/load_data_executor.h"
 #include "include/query_engine/executor/trx_begin_executor.h"
 #include "include/query_engine/executor/trx_end_executor.h"
+#include "include/query_engine/executor/prepare_executor.h"
+#include "include/query_engine/executor/reset_session_executor.h"
 
 RC CommandExecutor::execute(QueryInfo *query_info)
 {
@@ -37,6 +40,11 @@ RC CommandExecutor::execute(QueryInfo *query_info)
       return executor.execute(query_info);
     }
 
+    case StmtType::ANALYZE_TABLE: {
+      AnalyzeTableExecutor executor;
+      return executor.execute(query_info);
+    }
+
     case StmtType::HELP: {
       HelpExecutor executor;
       return executor.execute(query_info);
@@ -63,6 +71,21 @@ RC CommandExecutor::execute(QueryInfo *query_info)
       return executor.execute(query_info);
     }
 
+    case StmtType::PREPARE: {
+      PrepareExecutor executor;
+      return executor.execute(query_info);
+    }
+
+    case StmtType::DEALLOCATE_PREPARE: {
+      DeallocatePrepareExecutor executor;
+      return executor.execute(query_info);
+    }
+
+    case StmtType::RESET_SESSION: {
+      ResetSessionExecutor executor;
+      return executor.execute(query_info);
+    }
+
     case StmtType::EXIT: {
       return RC::SUCCESS;
     }
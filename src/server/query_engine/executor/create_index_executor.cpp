@@ -3,6 +3,7 @@
 #include "include/query_engine/structor/query_info.h"
 #include "include/query_engine/analyzer/statement/create_index_stmt.h"
 #include "include/session/session.h"
+#include "include/storage_engine/schema/database.h"
 
 RC CreateIndexExecutor::execute(QueryInfo *query_info)
 {
@@ -15,5 +16,11 @@ RC CreateIndexExecutor::execute(QueryInfo *query_info)
   
   Trx *trx = session->current_trx();
   Table *table = create_index_stmt->table();
-  return table->create_index(trx, create_index_stmt->multi_field_metas(), create_index_stmt->index_name().c_str(), create_index_stmt->is_unique());
+  RC rc = table->create_index(trx, create_index_stmt->multi_field_metas(), create_index_stmt->index_name().c_str(),
+      create_index_stmt->is_unique(), create_index_stmt->index_type());
+  if (rc == RC::SUCCESS) {
+    // 新的索引可能让缓存的计划不再是最优的
+    session->get_current_db()->bump_schema_version();
+  }
+  return rc;
 }
\ No newline at end of file
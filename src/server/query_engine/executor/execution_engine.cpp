@@ -4,6 +4,7 @@
 #include "include/query_engine/planner/operator/physical_operator.h"
 #include "include/query_engine/analyzer/statement/select_stmt.h"
 #include "include/session/communicator.h"
+#include "include/session/binary_communicator.h"
 #include "include/query_engine/structor/query_info.h"
 #include "include/storage_engine/transaction/trx.h"
 #include "include/session/session.h"
@@ -16,16 +17,17 @@ const char END_DELIM = '\0';
 const char NEW_LINE = '\n';
 
 RC write_to_communicator(const char* data, int32_t size, Communicator* communicator, const size_t &min_width){
-  if(size < min_width){
-    int diff = min_width - size;
-    char* padding = new char[diff];
-    memset(padding, ' ', diff);
-    RC rc = communicator->write_result(padding, diff);
+  // 补齐用的空格从固定的缓存中写出，不需要每个单元格都分配内存
+  static const std::string SPACES(64, ' ');
+  size_t padding = size < min_width ? min_width - size : 0;
+  while (padding > 0) {
+    const int32_t len = static_cast<int32_t>(std::min(padding, SPACES.size()));
+    RC rc = communicator->write_result(SPACES.data(), len);
     if(RC_FAIL(rc)){
       LOG_WARN("failed to send data to client. err=%s", strerror(errno));
       return rc;
     }
-    delete[] padding;
+    padding -= len;
   }
   RC rc = communicator->write_result(data, size);
   if(RC_FAIL(rc)){
@@ -66,6 +68,7 @@ void set_operator_schema(QueryInfo *query_info, size_t& min_width)
 
   SqlResult *sql_result = query_info->session_event()->sql_result();
   sql_result->set_tuple_schema(schema);
+  sql_result->set_column_width(min_width);
   sql_result->set_operator(std::move(physical_operator));
 }
 
@@ -127,34 +130,25 @@ RC value_to_string(Value &value, std::string &cell_str){
   return RC::SUCCESS;
 }
 
-RC send_result(SessionRequest *request, bool &need_disconnect, const size_t &min_width){
-  RC rc;
-  need_disconnect = true;
-
-  SqlResult *sql_result = request->sql_result();
-  Communicator* communicator = request->get_communicator();
-
-  if (RC::SUCCESS != sql_result->return_code() || !sql_result->has_operator()) {
-    return communicator->write_state(sql_result, need_disconnect);
-  }
-
-  rc = sql_result->init();
-  if(RC_FAIL(rc)){
-    sql_result->close();
-    sql_result->set_return_code(rc);
-    return communicator->write_state(sql_result, need_disconnect);
-  }
-
-  const TupleSchema &schema = sql_result->tuple_schema();
-  const int cell_num = schema.cell_num();
-
-  rc = send_schema(schema, cell_num, communicator, min_width);
-  if(RC_FAIL(rc)){
+/**
+ * 缓存的结果超过发送窗口时返回 SEND_PAUSED，在两行之间暂停发送。发送失败时关闭结果集
+ */
+RC check_send_window(SqlResult *sql_result, Communicator *communicator){
+  bool full = false;
+  RC rc = communicator->check_send_window(full);
+  if (RC_FAIL(rc)) {
     LOG_WARN("failed to send data to client. err=%s", strerror(errno));
     sql_result->close();
     return rc;
   }
+  return full ? RC::SEND_PAUSED : RC::SUCCESS;
+}
 
+/**
+ * 以文本的形式逐行发送结果，正常结束时返回 RECORD_EOF，发送窗口满时返回 SEND_PAUSED。发送失败时关闭结果集
+ */
+RC send_text_rows(SqlResult *sql_result, Communicator *communicator, const size_t &min_width){
+  RC rc = RC::SUCCESS;
   Tuple *tuple = nullptr;
   while(RC::SUCCESS == (rc = sql_result->next_tuple(tuple))){
     int column_num;
@@ -198,6 +192,98 @@ RC send_result(SessionRequest *request, bool &need_disconnect, const size_t &min
         sql_result->close();
         return rc;
     }
+
+    rc = check_send_window(sql_result, communicator);
+    if (rc != RC::SUCCESS) {
+        return rc;
+    }
+  }
+
+  return rc;
+}
+
+/**
+ * 以按列编码的二进制格式发送结果，正常结束时返回 RECORD_EOF，发送窗口满时返回 SEND_PAUSED。发送失败时关闭结果集
+ */
+RC send_binary_rows(SqlResult *sql_result, BinaryCommunicator *communicator){
+  RC rc = RC::SUCCESS;
+  std::vector<Value> row;
+  Tuple *tuple = nullptr;
+  while(RC::SUCCESS == (rc = sql_result->next_tuple(tuple))){
+    const int column_num = tuple == nullptr ? 0 : tuple->cell_num();
+    if (column_num == 0) {
+      continue;
+    }
+    row.resize(column_num);
+    for (int i = 0; i < column_num; i++) {
+      rc = tuple->cell_at(i, row[i]);
+      if (rc != RC::SUCCESS) {
+        LOG_WARN("failed to get value from tuple. rc=%s", strrc(rc));
+        sql_result->close();
+        return rc;
+      }
+      if (row[i].attr_type() == TEXTS) {
+        // 文本类型的值中存放的是文件名，需要读出内容
+        std::string text;
+        rc = value_to_string(row[i], text);
+        if (rc != RC::SUCCESS) {
+          LOG_WARN("failed to convert value to string. rc=%s", strrc(rc));
+          sql_result->close();
+          return rc;
+        }
+        row[i].set_string(text.c_str(), static_cast<int>(text.size()));
+      }
+    }
+    rc = communicator->append_row(row);
+    if (RC_FAIL(rc)) {
+      LOG_WARN("failed to send data to client. err=%s", strerror(errno));
+      sql_result->close();
+      return rc;
+    }
+
+    rc = check_send_window(sql_result, communicator);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+  }
+
+  if (rc == RC::RECORD_EOF) {
+    RC flush_rc = communicator->flush_batch();
+    communicator->release_batch();
+    if (RC_FAIL(flush_rc)) {
+      LOG_WARN("failed to send data to client. err=%s", strerror(errno));
+      sql_result->close();
+      return flush_rc;
+    }
+  }
+  return rc;
+}
+
+/**
+ * 发送结果集中剩下的行，都发送完之后关闭结果集并写回执行状态
+ */
+RC send_rows(SessionRequest *request, bool &need_disconnect){
+  RC rc;
+  need_disconnect = true;
+
+  SqlResult *sql_result = request->sql_result();
+  Communicator* communicator = request->get_communicator();
+  const int cell_num = sql_result->tuple_schema().cell_num();
+
+  auto *binary = dynamic_cast<BinaryCommunicator *>(communicator);
+  if (binary != nullptr) {
+    rc = send_binary_rows(sql_result, binary);
+  } else {
+    rc = send_text_rows(sql_result, communicator, sql_result->column_width());
+  }
+  if (!sql_result->has_operator()) {
+    // 发送失败时结果集已经关闭
+    return rc;
+  }
+  if (rc == RC::SEND_PAUSED) {
+    // 客户端接收得慢，结果集保持打开，套接字可写之后从下一行继续
+    need_disconnect = false;
+    return rc;
   }
 
   if (rc == RC::RECORD_EOF) {
@@ -230,11 +316,48 @@ RC send_result(SessionRequest *request, bool &need_disconnect, const size_t &min
   return rc;
 }
 
+RC send_result(SessionRequest *request, bool &need_disconnect){
+  RC rc;
+  need_disconnect = true;
+
+  SqlResult *sql_result = request->sql_result();
+  Communicator* communicator = request->get_communicator();
+
+  if (RC::SUCCESS != sql_result->return_code() || !sql_result->has_operator()) {
+    return communicator->write_state(sql_result, need_disconnect);
+  }
+
+  rc = sql_result->init();
+  if(RC_FAIL(rc)){
+    sql_result->close();
+    sql_result->set_return_code(rc);
+    return communicator->write_state(sql_result, need_disconnect);
+  }
+
+  const TupleSchema &schema = sql_result->tuple_schema();
+  const int cell_num = schema.cell_num();
+
+  auto *binary = dynamic_cast<BinaryCommunicator *>(communicator);
+  if (binary != nullptr) {
+    rc = cell_num > 0 ? binary->write_schema(schema) : RC::SUCCESS;
+  } else {
+    rc = send_schema(schema, cell_num, communicator, sql_result->column_width());
+  }
+  if(RC_FAIL(rc)){
+    LOG_WARN("failed to send data to client. err=%s", strerror(errno));
+    sql_result->close();
+    return rc;
+  }
+
+  return send_rows(request, need_disconnect);
+}
+
 RC Executor::execute(SessionRequest *request, QueryInfo *query_info, bool &need_disconnect)
 {
   RC rc;
-  min_width = 0;
   if(query_info->physical_operator() != nullptr){
+    // 多个会话可能同时执行查询，列宽只属于这一次查询
+    size_t min_width = 0;
     set_operator_schema(query_info, min_width);
   }else{
     // Query doesn't have physical operator, such as: insert, update
@@ -248,8 +371,15 @@ RC Executor::execute(SessionRequest *request, QueryInfo *query_info, bool &need_
     }
   }
 
-  rc = send_result(request, need_disconnect, min_width);
+  rc = send_result(request, need_disconnect);
 
   request->get_communicator()->flush();
   return rc;
-}
\ No newline at end of file
+}
+
+RC Executor::resume(SessionRequest *request, bool &need_disconnect)
+{
+  RC rc = send_rows(request, need_disconnect);
+  request->get_communicator()->flush();
+  return rc;
+}
@@ -1,5 +1,6 @@
 #include "include/query_engine/executor/sql_result.h"
 #include "include/session/session.h"
+#include "include/common/query_stats.h"
 #include "include/storage_engine/transaction/trx.h"
 #include "common/log/log.h"
 #include "include/query_engine/structor/tuple/tuple.h"
@@ -38,6 +39,9 @@ RC SqlResult::close()
     LOG_WARN("failed to close operator. rc=%s", strrc(rc));
   }
 
+  if (QueryStats *stats = QueryStats::current()) {
+    stats->collect_operators(operator_.get());
+  }
   operator_.reset();
 
   if (session_ && !session_->is_trx_multi_operation_mode()) {
@@ -55,7 +59,7 @@ RC SqlResult::close()
 
 RC SqlResult::next_tuple(Tuple *&tuple)
 {
-  RC rc = operator_->next();
+  RC rc = operator_->next_row();
   if (rc != RC::SUCCESS) {
     return rc;
   }
@@ -0,0 +1,33 @@
+#include "include/query_engine/optimizer/arithmetic_simplification_rule.h"
+#include "include/query_engine/structor/expression/arithmetic_expression.h"
+#include "include/query_engine/structor/expression/value_expression.h"
+
+RC ArithmeticSimplificationRule::rewrite(std::unique_ptr<Expression> &expr, bool &change_made)
+{
+  change_made = false;
+  if (expr->type() != ExprType::ARITHMETIC) {
+    return RC::SUCCESS;
+  }
+
+  auto *arithmetic_expr = static_cast<ArithmeticExpr *>(expr.get());
+  const bool negative = arithmetic_expr->arithmetic_type() == ArithmeticExpr::Type::NEGATIVE;
+  const std::unique_ptr<Expression> &left = arithmetic_expr->left();
+  const std::unique_ptr<Expression> &right = arithmetic_expr->right();
+  if (left == nullptr || left->type() != ExprType::VALUE ||
+      (!negative && (right == nullptr || right->type() != ExprType::VALUE))) {
+    return RC::SUCCESS;
+  }
+
+  Value value;
+  RC rc = arithmetic_expr->try_get_value(value);
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+
+  auto *value_expr = new ValueExpr(value);
+  value_expr->set_name(expr->name());
+  value_expr->set_alias(expr->alias());
+  expr.reset(value_expr);
+  change_made = true;
+  return RC::SUCCESS;
+}
@@ -1,20 +1,146 @@
 #include "include/query_engine/optimizer/comparison_simplification_rule.h"
 #include "include/query_engine/structor/expression/comparison_expression.h"
+#include "include/query_engine/structor/expression/field_expression.h"
 #include "include/query_engine/structor/expression/value_expression.h"
 
+namespace {
+
+CompOp swap_comp(CompOp comp)
+{
+  switch (comp) {
+    case LESS_EQUAL: return GREAT_EQUAL;
+    case LESS_THAN: return GREAT_THAN;
+    case GREAT_EQUAL: return LESS_EQUAL;
+    case GREAT_THAN: return LESS_THAN;
+    default: return comp;
+  }
+}
+
+bool is_constant(const Expression *expr)
+{
+  return expr != nullptr && (expr->type() == ExprType::VALUE || expr->type() == ExprType::PARAM);
+}
+
+/// 字段的值是否一定不为空。视图中的字段可能来自聚合，不做判断
+bool never_null(Expression *expr)
+{
+  if (expr->type() != ExprType::FIELD) {
+    return false;
+  }
+  Field &field = static_cast<FieldExpr *>(expr)->field();
+  return !field.table()->is_view() && !field.nullable();
+}
+
+void replace_with_constant(std::unique_ptr<Expression> &expr, bool constant)
+{
+  auto *value_expr = new ValueExpr(Value(constant));
+  value_expr->set_name(expr->name());
+  value_expr->set_alias(expr->alias());
+  expr.reset(value_expr);
+}
+
+/**
+ * @brief 常量列表上的 (NOT) IN 与 (NOT) EXISTS
+ * @details 常量之间的运算直接计算出结果；只有一个值的 IN 改写成等值比较，这样可以使用索引。
+ * 列表中的 NULL 会让 NOT IN 的结果变成未知，这种情况不改写
+ */
+RC rewrite_in_list(std::unique_ptr<Expression> &expr, bool &change_made)
+{
+  auto *cmp_expr = static_cast<ComparisonExpr *>(expr.get());
+  std::unique_ptr<Expression> &left = cmp_expr->left();
+  std::unique_ptr<Expression> &right = cmp_expr->right();
+  const CompOp comp = cmp_expr->comp();
+
+  const bool is_exists = comp == EXISTS || comp == NOT_EXISTS;
+  if ((is_exists && left->type() == ExprType::VALUES) ||
+      (!is_exists && left->type() == ExprType::VALUE && right != nullptr && right->type() == ExprType::VALUES)) {
+    Value value;
+    RC rc = cmp_expr->try_get_value(value);
+    if (rc == RC::SUCCESS) {
+      replace_with_constant(expr, value.get_boolean());
+      change_made = true;
+    }
+    return rc;
+  }
+
+  if (is_exists || right == nullptr || right->type() != ExprType::VALUES) {
+    return RC::SUCCESS;
+  }
+  const std::vector<Value> &values = static_cast<ValuesExpr *>(right.get())->values();
+  if (values.size() != 1 || values.front().is_null()) {
+    return RC::SUCCESS;
+  }
+
+  std::unique_ptr<Expression> value_expr(new ValueExpr(values.front()));
+  value_expr->set_name(right->name());
+  auto *new_expr = new ComparisonExpr(comp == IN ? EQUAL_TO : NOT_EQUAL, std::move(left), std::move(value_expr));
+  new_expr->set_name(expr->name());
+  new_expr->set_alias(expr->alias());
+  expr.reset(new_expr);
+  change_made = true;
+  return RC::SUCCESS;
+}
+
+}  // namespace
+
 RC ComparisonSimplificationRule::rewrite(std::unique_ptr<Expression> &expr, bool &change_made)
 {
   RC rc = RC::SUCCESS;
   change_made = false;
-  if (expr->type() == ExprType::COMPARISON) {
-    auto *cmp_expr = dynamic_cast<ComparisonExpr *>(expr.get());
+  if (expr->type() != ExprType::COMPARISON) {
+    return rc;
+  }
+
+  auto *cmp_expr = static_cast<ComparisonExpr *>(expr.get());
+  std::unique_ptr<Expression> &left = cmp_expr->left();
+  std::unique_ptr<Expression> &right = cmp_expr->right();
+  const CompOp comp = cmp_expr->comp();
+
+  if (comp == IS_NULL || comp == IS_NOT_NULL) {
+    if (left->type() == ExprType::VALUE) {
+      const bool is_null = static_cast<ValueExpr *>(left.get())->get_value().is_null();
+      replace_with_constant(expr, (comp == IS_NULL) == is_null);
+      change_made = true;
+    } else if (never_null(left.get())) {
+      replace_with_constant(expr, comp == IS_NOT_NULL);
+      change_made = true;
+    }
+    return rc;
+  }
+
+  if (comp == IN || comp == NOT_IN || comp == EXISTS || comp == NOT_EXISTS) {
+    return rewrite_in_list(expr, change_made);
+  }
+
+  if (comp > GREAT_THAN || right == nullptr) {
+    return rc;
+  }
+
+  if (left->type() == ExprType::VALUE && right->type() == ExprType::VALUE) {
     Value value;
     RC sub_rc = cmp_expr->try_get_value(value);
     if (sub_rc == RC::SUCCESS) {
-      std::unique_ptr<Expression> new_expr(new ValueExpr(value));
-      expr.swap(new_expr);
+      replace_with_constant(expr, value.get_boolean());
       change_made = true;
     }
+    return rc;
+  }
+
+  // 与 NULL 比较大小的结果总是假
+  for (const std::unique_ptr<Expression> *side : {&left, &right}) {
+    if ((*side)->type() == ExprType::VALUE && static_cast<ValueExpr *>(side->get())->get_value().is_null()) {
+      replace_with_constant(expr, false);
+      change_made = true;
+      return rc;
+    }
+  }
+
+  if (is_constant(left.get()) && right->type() == ExprType::FIELD) {
+    auto *new_expr = new ComparisonExpr(swap_comp(comp), std::move(right), std::move(left));
+    new_expr->set_name(expr->name());
+    new_expr->set_alias(expr->alias());
+    expr.reset(new_expr);
+    change_made = true;
   }
   return rc;
 }
@@ -1,7 +1,11 @@
 #include "common/log/log.h"
 #include "include/query_engine/optimizer/conjunction_simplification_rule.h"
-#include "include/query_engine/structor/expression/value_expression.h"
+#include "include/query_engine/structor/expression/comparison_expression.h"
 #include "include/query_engine/structor/expression/conjunction_expression.h"
+#include "include/query_engine/structor/expression/field_expression.h"
+#include "include/query_engine/structor/expression/value_expression.h"
+
+namespace {
 
 RC try_to_get_bool_constant(std::unique_ptr<Expression> &expr, bool &constant_value)
 {
@@ -12,6 +16,161 @@ RC try_to_get_bool_constant(std::unique_ptr<Expression> &expr, bool &constant_va
   }
   return RC::INTERNAL;
 }
+
+/**
+ * @brief 一个字段上所有 字段 op 常量 条件的交集
+ * @details 只处理比较结果精确的类型，浮点数按照 EPSILON 比较，区间不一定能准确判断
+ */
+class FieldRange
+{
+public:
+  explicit FieldRange(const Field &field) : field_(field) {}
+
+  const Field &field() const { return field_; }
+
+  void add(CompOp comp, const Value &value)
+  {
+    switch (comp) {
+      case EQUAL_TO: {
+        if (has_eq_ && eq_.compare(value) != 0) {
+          empty_ = true;
+        }
+        has_eq_ = true;
+        eq_ = value;
+      } break;
+      case NOT_EQUAL: {
+        not_equals_.push_back(value);
+      } break;
+      case GREAT_EQUAL:
+      case GREAT_THAN: {
+        const bool inclusive = comp == GREAT_EQUAL;
+        const int cmp = has_low_ ? value.compare(low_) : 1;
+        if (cmp > 0 || (cmp == 0 && !inclusive)) {
+          has_low_ = true;
+          low_ = value;
+          low_inclusive_ = inclusive;
+        }
+      } break;
+      case LESS_EQUAL:
+      case LESS_THAN: {
+        const bool inclusive = comp == LESS_EQUAL;
+        const int cmp = has_high_ ? value.compare(high_) : -1;
+        if (cmp < 0 || (cmp == 0 && !inclusive)) {
+          has_high_ = true;
+          high_ = value;
+          high_inclusive_ = inclusive;
+        }
+      } break;
+      default: break;
+    }
+  }
+
+  bool empty() const
+  {
+    if (empty_) {
+      return true;
+    }
+    if (has_eq_) {
+      if (has_low_) {
+        const int cmp = eq_.compare(low_);
+        if (cmp < 0 || (cmp == 0 && !low_inclusive_)) {
+          return true;
+        }
+      }
+      if (has_high_) {
+        const int cmp = eq_.compare(high_);
+        if (cmp > 0 || (cmp == 0 && !high_inclusive_)) {
+          return true;
+        }
+      }
+      for (const Value &value : not_equals_) {
+        if (eq_.compare(value) == 0) {
+          return true;
+        }
+      }
+      return false;
+    }
+    if (has_low_ && has_high_) {
+      const int cmp = low_.compare(high_);
+      return cmp > 0 || (cmp == 0 && !(low_inclusive_ && high_inclusive_));
+    }
+    return false;
+  }
+
+private:
+  Field field_;
+  bool  empty_ = false;
+
+  bool  has_eq_ = false;
+  Value eq_;
+
+  bool  has_low_ = false;
+  bool  low_inclusive_ = false;
+  Value low_;
+
+  bool  has_high_ = false;
+  bool  high_inclusive_ = false;
+  Value high_;
+
+  std::vector<Value> not_equals_;
+};
+
+/**
+ * @brief 判断 AND 连接的条件之间是否有矛盾，比如 a = 1 AND a = 2、a > 5 AND a < 3
+ * @details 化简规则已经把常量都换到了比较的右边，这里只看 字段 op 常量 的形式
+ */
+bool has_contradiction(std::vector<std::unique_ptr<Expression>> &conjuncts)
+{
+  std::vector<FieldRange> ranges;
+  for (std::unique_ptr<Expression> &conjunct : conjuncts) {
+    if (conjunct->type() != ExprType::COMPARISON) {
+      continue;
+    }
+    auto *comparison_expr = static_cast<ComparisonExpr *>(conjunct.get());
+    Expression *left = comparison_expr->left().get();
+    Expression *right = comparison_expr->right().get();
+    if (comparison_expr->comp() > GREAT_THAN || right == nullptr || left->type() != ExprType::FIELD ||
+        right->type() != ExprType::VALUE) {
+      continue;
+    }
+
+    const Field &field = static_cast<FieldExpr *>(left)->field();
+    const Value &value = static_cast<ValueExpr *>(right)->get_value();
+    const AttrType attr_type = field.attr_type();
+    if ((attr_type != INTS && attr_type != DATES && attr_type != CHARS) || value.is_null() ||
+        value.attr_type() != attr_type) {
+      continue;
+    }
+
+    auto iter = ranges.begin();
+    while (iter != ranges.end() && !(iter->field() == field)) {
+      ++iter;
+    }
+    if (iter == ranges.end()) {
+      ranges.emplace_back(field);
+      iter = ranges.end() - 1;
+    }
+    iter->add(comparison_expr->comp(), value);
+  }
+
+  for (const FieldRange &range : ranges) {
+    if (range.empty()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void replace_with_constant(std::unique_ptr<Expression> &expr, bool constant)
+{
+  auto *value_expr = new ValueExpr(Value(constant));
+  value_expr->set_name(expr->name());
+  value_expr->set_alias(expr->alias());
+  expr.reset(value_expr);
+}
+
+}  // namespace
+
 RC ConjunctionSimplificationRule::rewrite(std::unique_ptr<Expression> &expr, bool &change_made)
 {
   RC rc = RC::SUCCESS;
@@ -21,7 +180,24 @@ RC ConjunctionSimplificationRule::rewrite(std::unique_ptr<Expression> &expr, boo
 
   change_made = false;
   auto conjunction_expr = static_cast<ConjunctionExpr *>(expr.get());
+  const ConjunctionType conjunction_type = conjunction_expr->conjunction_type();
   std::vector<std::unique_ptr<Expression>> &child_exprs = conjunction_expr->children();
+
+  // 展开同类型的嵌套连接，比如 (a AND b) AND c 展开成 a AND b AND c
+  std::vector<std::unique_ptr<Expression>> flat_exprs;
+  for (std::unique_ptr<Expression> &child_expr : child_exprs) {
+    if (child_expr->type() == ExprType::CONJUNCTION &&
+        static_cast<ConjunctionExpr *>(child_expr.get())->conjunction_type() == conjunction_type) {
+      for (std::unique_ptr<Expression> &grand_child : static_cast<ConjunctionExpr *>(child_expr.get())->children()) {
+        flat_exprs.emplace_back(std::move(grand_child));
+      }
+      change_made = true;
+    } else {
+      flat_exprs.emplace_back(std::move(child_expr));
+    }
+  }
+  child_exprs.swap(flat_exprs);
+
   // 先看看有没有能够直接去掉的表达式。比如AND时恒为true的表达式可以删除
   // 或者是否可以直接计算出当前表达式的值。比如AND时，如果有一个表达式为false，那么整个表达式就是false
   for (auto iter = child_exprs.begin(); iter != child_exprs.end();) {
@@ -33,29 +209,31 @@ RC ConjunctionSimplificationRule::rewrite(std::unique_ptr<Expression> &expr, boo
       continue;
     }
 
-    if (conjunction_expr->conjunction_type() == ConjunctionType::AND) {
-      if (constant_value == true) {
-        child_exprs.erase(iter);
-      } else {
-        // always be false
-        std::unique_ptr<Expression> child_expr = std::move(child_exprs.front());
-        child_exprs.clear();
-        expr = std::move(child_expr);
-        return rc;
-      }
-    } else {
-      // conjunction_type == OR
-      if (constant_value == true) {
-        // always be true
-        std::unique_ptr<Expression> child_expr = std::move(child_exprs.front());
-        child_exprs.clear();
-        expr = std::move(child_expr);
-        return rc;
-      } else {
-        child_exprs.erase(iter);
-      }
+    const bool absorbing = conjunction_type == ConjunctionType::AND ? false : true;
+    if (constant_value == absorbing) {
+      // AND 时为 false、OR 时为 true，整个表达式的值就是这个常量
+      replace_with_constant(expr, absorbing);
+      change_made = true;
+      return rc;
     }
+    iter = child_exprs.erase(iter);
+    change_made = true;
+  }
+
+  if (child_exprs.empty()) {
+    // 所有的子表达式都是中性的常量
+    replace_with_constant(expr, conjunction_type == ConjunctionType::AND);
+    change_made = true;
+    return rc;
+  }
+
+  if (conjunction_type == ConjunctionType::AND && has_contradiction(child_exprs)) {
+    LOG_TRACE("conjunction expression is always false");
+    replace_with_constant(expr, false);
+    change_made = true;
+    return rc;
   }
+
   if (child_exprs.size() == 1) {
     LOG_TRACE("conjunction expression has only 1 child");
     std::unique_ptr<Expression> child_expr = std::move(child_exprs.front());
@@ -0,0 +1,377 @@
+#include "include/query_engine/optimizer/cost_model.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "include/query_engine/planner/node/table_get_logical_node.h"
+#include "include/query_engine/planner/node/join_logical_node.h"
+#include "include/query_engine/planner/node/limit_logical_node.h"
+#include "include/query_engine/structor/expression/comparison_expression.h"
+#include "include/query_engine/structor/expression/conjunction_expression.h"
+#include "include/query_engine/structor/expression/field_expression.h"
+#include "include/query_engine/structor/expression/value_expression.h"
+#include "include/storage_engine/buffer/page.h"
+#include "include/storage_engine/recorder/field.h"
+#include "include/storage_engine/recorder/table.h"
+
+namespace {
+
+/// B+ 树一个页面大约能放下的索引项个数
+constexpr double INDEX_FANOUT = 200.0;
+
+CompOp swap_comp(CompOp comp)
+{
+  switch (comp) {
+    case LESS_EQUAL: return GREAT_EQUAL;
+    case LESS_THAN: return GREAT_THAN;
+    case GREAT_EQUAL: return LESS_EQUAL;
+    case GREAT_THAN: return LESS_THAN;
+    default: return comp;
+  }
+}
+
+bool is_constant(const Expression *expr)
+{
+  return expr->type() == ExprType::VALUE || expr->type() == ExprType::PARAM;
+}
+
+/**
+ * @brief 把 value op field 统一成 field op value 的形式
+ * @details 预处理语句中的参数也当作常量，value 的类型是 UNDEFINED
+ * @return 不是字段与常量的比较时返回空
+ */
+const FieldExpr *field_value_comparison(const ComparisonExpr *expr, CompOp &comp, Value &value)
+{
+  const Expression *left = expr->_left_().get();
+  const Expression *right = expr->_right_().get();
+  comp = expr->comp();
+  if (left == nullptr || right == nullptr) {
+    return nullptr;
+  }
+  if (is_constant(left) && right->type() == ExprType::FIELD) {
+    std::swap(left, right);
+    comp = swap_comp(comp);
+  }
+  if (left->type() != ExprType::FIELD || !is_constant(right)) {
+    return nullptr;
+  }
+  value = right->type() == ExprType::VALUE ? static_cast<const ValueExpr *>(right)->get_value() : Value();
+  return static_cast<const FieldExpr *>(left);
+}
+
+bool unique_index_on(const Field &field)
+{
+  const TableMeta &table_meta = field.table()->table_meta();
+  for (int i = 0; i < table_meta.index_num(); i++) {
+    const IndexMeta *index_meta = table_meta.index(i);
+    if (index_meta->is_unique() && index_meta->user_field_amount() == 1 &&
+        0 == strcmp(index_meta->field(0), field.field_name())) {
+      return true;
+    }
+  }
+  return false;
+}
+
+double default_selectivity(const Field &field, CompOp comp)
+{
+  switch (comp) {
+    case EQUAL_TO: {
+      return unique_index_on(field) ? 1.0 / CostModel::table_rows(field.table()) : DEFAULT_EQ_SELECTIVITY;
+    }
+    case NOT_EQUAL: return 1 - DEFAULT_EQ_SELECTIVITY;
+    case IS_NULL: return field.meta()->nullable() ? DEFAULT_EQ_SELECTIVITY : 0;
+    case IS_NOT_NULL: return field.meta()->nullable() ? 1 - DEFAULT_EQ_SELECTIVITY : 1;
+    default: return DEFAULT_SELECTIVITY;
+  }
+}
+
+double comparison_selectivity(const ComparisonExpr *expr)
+{
+  CompOp comp;
+  Value value;
+  const FieldExpr *field_expr = field_value_comparison(expr, comp, value);
+  if (field_expr != nullptr) {
+    const Field &field = field_expr->field();
+    ColumnStats column_stats;
+    if (field.table()->stats().analyzed() && field.table()->stats().column(field.field_name(), column_stats)) {
+      if (value.attr_type() != UNDEFINED) {
+        return column_stats.selectivity(comp, value);
+      }
+      if (comp == EQUAL_TO) {
+        // 参数的值未知，等值条件按照不同值的个数估计
+        return 1.0 / std::max(column_stats.ndv, 1.0);
+      }
+    }
+    return default_selectivity(field, comp);
+  }
+
+  const Expression *left = expr->_left_().get();
+  const Expression *right = expr->_right_().get();
+  if (left != nullptr && right != nullptr && left->type() == ExprType::FIELD && right->type() == ExprType::FIELD) {
+    if (comp != EQUAL_TO) {
+      return DEFAULT_SELECTIVITY;
+    }
+    const double ndv = std::max(CostModel::column_ndv(static_cast<const FieldExpr *>(left)->field()),
+                                CostModel::column_ndv(static_cast<const FieldExpr *>(right)->field()));
+    return 1.0 / std::max(ndv, 1.0);
+  }
+  return comp == EQUAL_TO ? DEFAULT_EQ_SELECTIVITY : DEFAULT_SELECTIVITY;
+}
+
+/// 下推到表上的条件中，可以用作索引范围的部分的选择率
+double index_selectivity(TableGetLogicalNode &table_get, const IndexMeta &index_meta, bool &usable)
+{
+  usable = false;
+  if (index_meta.type() == IndexType::BLOOM) {
+    return 1;
+  }
+  const bool hash = index_meta.type() == IndexType::HASH;
+  double selectivity = 1;
+  const int field_amount = static_cast<int>(index_meta.user_field_amount());
+  for (int i = 0; i < field_amount; i++) {
+    bool has_eq = false;
+    for (std::unique_ptr<Expression> &predicate : table_get.predicates()) {
+      if (predicate->type() != ExprType::COMPARISON) {
+        continue;
+      }
+      auto *compare_expr = static_cast<const ComparisonExpr *>(predicate.get());
+      CompOp comp;
+      Value value;
+      const FieldExpr *field_expr = field_value_comparison(compare_expr, comp, value);
+      if (field_expr == nullptr || field_expr->field().table() != table_get.table() ||
+          0 != strcmp(field_expr->field_name(), index_meta.field(i)) || value.is_null()) {
+        continue;
+      }
+      // B+树可以使用前缀字段上的等值条件，以及紧接着的一个字段上的范围条件
+      const bool range_comp = comp == LESS_THAN || comp == LESS_EQUAL || comp == GREAT_THAN || comp == GREAT_EQUAL;
+      if (comp != EQUAL_TO && !(range_comp && !hash)) {
+        continue;
+      }
+      selectivity *= comparison_selectivity(compare_expr);
+      usable = true;
+      has_eq = has_eq || comp == EQUAL_TO;
+    }
+    if (!has_eq) {
+      // 哈希索引只能查找完整的键
+      usable = usable && !hash;
+      break;
+    }
+  }
+  return selectivity;
+}
+
+}  // namespace
+
+double CostModel::table_rows(const Table *table)
+{
+  if (table->is_view()) {
+    return DEFAULT_TABLE_ROWS;
+  }
+  const TableStats &stats = table->stats();
+  if (stats.row_count_known()) {
+    return std::max(static_cast<double>(stats.row_count()), 1.0);
+  }
+  const double per_page = std::max(1, BP_PAGE_DATA_SIZE / std::max(table->table_meta().record_size(), 1));
+  return std::max(table_pages(table) * per_page, 1.0);
+}
+
+double CostModel::table_pages(const Table *table)
+{
+  if (table->is_view()) {
+    return DEFAULT_TABLE_ROWS / 100;
+  }
+  return std::max(static_cast<double>(table->data_page_count()), 1.0);
+}
+
+double CostModel::row_width(const Table *table)
+{
+  return table->is_view() ? 64 : table->table_meta().record_size();
+}
+
+double CostModel::column_ndv(const Field &field)
+{
+  const Table *table = field.table();
+  ColumnStats column_stats;
+  if (!table->is_view() && table->stats().analyzed() && table->stats().column(field.field_name(), column_stats) &&
+      column_stats.ndv >= 1) {
+    return column_stats.ndv;
+  }
+  return table_rows(table);
+}
+
+double CostModel::selectivity(const Expression *expr)
+{
+  if (expr == nullptr) {
+    return 1;
+  }
+  switch (expr->type()) {
+    case ExprType::VALUE: {
+      return static_cast<const ValueExpr *>(expr)->get_value().get_boolean() ? 1 : 0;
+    }
+    case ExprType::COMPARISON: {
+      return comparison_selectivity(static_cast<const ComparisonExpr *>(expr));
+    }
+    case ExprType::CONJUNCTION: {
+      auto *conjunction_expr = const_cast<ConjunctionExpr *>(static_cast<const ConjunctionExpr *>(expr));
+      const bool is_and = conjunction_expr->conjunction_type() == ConjunctionType::AND;
+      double result = is_and ? 1 : 0;
+      for (const std::unique_ptr<Expression> &child : conjunction_expr->children()) {
+        const double child_selectivity = selectivity(child.get());
+        result = is_and ? result * child_selectivity : result + child_selectivity - result * child_selectivity;
+      }
+      return conjunction_expr->children().empty() ? 1 : result;
+    }
+    default: {
+      return DEFAULT_SELECTIVITY;
+    }
+  }
+}
+
+void CostModel::estimate_table_get(TableGetLogicalNode &table_get)
+{
+  Table *table = table_get.table();
+  const double rows = table_rows(table);
+  const double pages = table_pages(table);
+
+  double selectivity = 1;
+  for (std::unique_ptr<Expression> &predicate : table_get.predicates()) {
+    selectivity *= CostModel::selectivity(predicate.get());
+  }
+  const double output_rows = rows * selectivity;
+  const double filter_cost = static_cast<double>(table_get.predicates().size()) * CPU_OPERATOR_COST;
+
+  const double seq_cost = pages * SEQ_PAGE_COST + rows * (CPU_TUPLE_COST + filter_cost);
+  if (table->is_view()) {
+    table_get.set_estimate(output_rows, seq_cost);
+    return;
+  }
+
+  // 每个索引都按照它能用到的条件估计扫描的行数，回表读取的页面按随机读计算
+  double index_cost = -1;
+  const TableMeta &table_meta = table->table_meta();
+  for (int i = 0; i < table_meta.index_num(); i++) {
+    bool usable = false;
+    const double index_selectivity = ::index_selectivity(table_get, *table_meta.index(i), usable);
+    if (!usable) {
+      continue;
+    }
+    const double matches = rows * index_selectivity;
+    const double cost = index_lookup_pages(*table_meta.index(i), rows) * RANDOM_PAGE_COST +
+                        std::min(matches, pages) * RANDOM_PAGE_COST +
+                        matches * (2 * CPU_TUPLE_COST + filter_cost);
+    if (index_cost < 0 || cost < index_cost) {
+      index_cost = cost;
+    }
+  }
+
+  if (index_cost < 0) {
+    table_get.set_estimate(output_rows, seq_cost);
+  } else if (table->stats().analyzed() && seq_cost < index_cost) {
+    table_get.set_prefer_table_scan(true);
+    table_get.set_estimate(output_rows, seq_cost);
+  } else {
+    table_get.set_estimate(output_rows, index_cost);
+  }
+}
+
+double CostModel::nested_loop_join_cost(double left_rows, double left_cost, double right_rows, double right_cost)
+{
+  // 每一行左边的数据都会重新执行一次右子树
+  return left_cost + std::max(left_rows, 1.0) * right_cost + left_rows * right_rows * CPU_OPERATOR_COST;
+}
+
+double CostModel::hash_join_cost(double left_rows, double left_cost, double right_rows, double right_cost)
+{
+  // 右边构建哈希表，左边探测
+  return left_cost + right_cost + left_rows * HASH_TUPLE_COST + right_rows * HASH_BUILD_COST;
+}
+
+double CostModel::merge_join_cost(double left_rows, double left_cost, double right_rows, double right_cost)
+{
+  return left_cost + right_cost + sort_cost(left_rows) + sort_cost(right_rows) +
+         (left_rows + right_rows) * CPU_OPERATOR_COST;
+}
+
+double CostModel::index_nested_loop_join_cost(double left_rows, double left_cost, double matches, double index_pages)
+{
+  return left_cost +
+         left_rows * (index_pages * RANDOM_PAGE_COST + matches * (RANDOM_PAGE_COST + CPU_TUPLE_COST));
+}
+
+double CostModel::index_height(double rows)
+{
+  return std::max(1.0, std::ceil(std::log(std::max(rows, 2.0)) / std::log(INDEX_FANOUT)));
+}
+
+double CostModel::index_lookup_pages(const IndexMeta &index_meta, double rows)
+{
+  // 哈希索引的目录在内存中，只需要读取一个桶页面
+  return index_meta.type() == IndexType::HASH ? 1 : index_height(rows);
+}
+
+double CostModel::sort_cost(double rows)
+{
+  return rows <= 1 ? 0 : rows * std::log2(rows) * CPU_OPERATOR_COST * 2;
+}
+
+void CostModel::estimate(LogicalNode &node)
+{
+  for (std::unique_ptr<LogicalNode> &child : node.children()) {
+    estimate(*child);
+  }
+
+  double child_rows = 0;
+  double child_cost = 0;
+  if (!node.children().empty()) {
+    child_rows = std::max(node.children().front()->estimated_rows(), 0.0);
+    child_cost = std::max(node.children().front()->estimated_cost(), 0.0);
+  }
+
+  switch (node.type()) {
+    case LogicalNodeType::TABLE_GET: {
+      if (node.estimated_rows() < 0) {
+        estimate_table_get(static_cast<TableGetLogicalNode &>(node));
+      }
+    } break;
+    case LogicalNodeType::JOIN: {
+      if (node.estimated_rows() >= 0 || node.children().size() != 2) {
+        break;
+      }
+      auto &join_node = static_cast<JoinLogicalNode &>(node);
+      LogicalNode &left = *node.children()[0];
+      LogicalNode &right = *node.children()[1];
+      const double rows = left.estimated_rows() * right.estimated_rows() * selectivity(join_node.condition().get());
+      node.set_estimate(rows,
+          nested_loop_join_cost(left.estimated_rows(), left.estimated_cost(), right.estimated_rows(),
+              right.estimated_cost()));
+    } break;
+    case LogicalNodeType::PREDICATE: {
+      double selectivity = 1;
+      for (std::unique_ptr<Expression> &expr : node.expressions()) {
+        selectivity *= CostModel::selectivity(expr.get());
+      }
+      node.set_estimate(child_rows * selectivity, child_cost + child_rows * CPU_OPERATOR_COST);
+    } break;
+    case LogicalNodeType::AGGR: {
+      node.set_estimate(1, child_cost + child_rows * CPU_OPERATOR_COST * node.expressions().size());
+    } break;
+    case LogicalNodeType::ORDER: {
+      node.set_estimate(child_rows, child_cost + sort_cost(child_rows));
+    } break;
+    case LogicalNodeType::LIMIT: {
+      auto &limit_node = static_cast<LimitLogicalNode &>(node);
+      double rows = std::max(child_rows - limit_node.offset(), 0.0);
+      if (limit_node.limit() >= 0) {
+        rows = std::min(rows, static_cast<double>(limit_node.limit()));
+      }
+      node.set_estimate(rows, child_cost);
+    } break;
+    case LogicalNodeType::PROJECTION: {
+      if (!node.children().empty()) {
+        node.set_estimate(child_rows, child_cost + child_rows * CPU_TUPLE_COST);
+      }
+    } break;
+    default: break;
+  }
+}
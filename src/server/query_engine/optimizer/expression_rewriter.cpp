@@ -1,12 +1,18 @@
 #include "include/query_engine/optimizer/expression_rewriter.h"
+#include "include/query_engine/optimizer/arithmetic_simplification_rule.h"
 #include "include/query_engine/optimizer/comparison_simplification_rule.h"
 #include "include/query_engine/optimizer/conjunction_simplification_rule.h"
+#include "include/query_engine/planner/node/join_logical_node.h"
+#include "include/query_engine/planner/node/table_get_logical_node.h"
+#include "include/query_engine/structor/expression/arithmetic_expression.h"
 #include "include/query_engine/structor/expression/comparison_expression.h"
 #include "include/query_engine/structor/expression/conjunction_expression.h"
+#include "include/query_engine/structor/expression/value_expression.h"
 #include "common/log/log.h"
 
 ExpressionRewriter::ExpressionRewriter()
 {
+  expr_rewrite_rules_.emplace_back(new ArithmeticSimplificationRule);
   expr_rewrite_rules_.emplace_back(new ComparisonSimplificationRule);
   expr_rewrite_rules_.emplace_back(new ConjunctionSimplificationRule);
 }
@@ -32,40 +38,85 @@ RC ExpressionRewriter::rewrite(std::unique_ptr<LogicalNode> &oper, bool &change_
     return rc;
   }
 
-  std::vector<std::unique_ptr<LogicalNode>> &child_opers = oper->children();
-  for (std::unique_ptr<LogicalNode> &child_oper : child_opers) {
-    bool sub_change_made = false;
-    rc = rewrite(child_oper, sub_change_made);
+  if (oper->type() == LogicalNodeType::TABLE_GET) {
+    rc = rewrite_table_get_predicates(static_cast<TableGetLogicalNode &>(*oper), sub_change_made);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
     if (sub_change_made && !change_made) {
       change_made = true;
     }
-    if (rc != RC::SUCCESS) {
-      break;
+  } else if (oper->type() == LogicalNodeType::JOIN) {
+    std::unique_ptr<Expression> &condition = static_cast<JoinLogicalNode &>(*oper).condition();
+    if (condition != nullptr) {
+      rc = rewrite_expression(condition, sub_change_made);
+      if (rc != RC::SUCCESS) {
+        return rc;
+      }
+      if (sub_change_made && !change_made) {
+        change_made = true;
+      }
     }
   }
+
   return rc;
 }
 
-RC ExpressionRewriter::rewrite_expression(std::unique_ptr<Expression> &expr, bool &change_made)
+RC ExpressionRewriter::rewrite_table_get_predicates(TableGetLogicalNode &table_get, bool &change_made)
 {
   RC rc = RC::SUCCESS;
-
   change_made = false;
-  for (std::unique_ptr<ExpressionRewriteRule> &rule : expr_rewrite_rules_) {
+  std::vector<std::unique_ptr<Expression>> &predicates = table_get.predicates();
+  if (predicates.empty()) {
+    return rc;
+  }
+
+  for (std::unique_ptr<Expression> &predicate : predicates) {
     bool sub_change_made = false;
-    rc = rule->rewrite(expr, sub_change_made);
+    rc = rewrite_expression(predicate, sub_change_made);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
     if (sub_change_made && !change_made) {
       change_made = true;
     }
-    if (rc != RC::SUCCESS) {
-      break;
-    }
   }
 
-  if (change_made || rc != RC::SUCCESS) {
+  // 扫描上的多个谓词之间是 AND 的关系，组合成一个表达式再化简一次，这样可以发现谓词之间的矛盾。
+  // 组合与拆分本身不算作修改，只有谓词的个数变化时才认为有修改，否则重写会一直进行下去
+  const size_t predicate_num = predicates.size();
+  std::unique_ptr<Expression> conjunction(new ConjunctionExpr(ConjunctionType::AND, predicates));
+  ConjunctionSimplificationRule conjunction_rule;
+  bool ignored = false;
+  rc = conjunction_rule.rewrite(conjunction, ignored);
+  if (rc != RC::SUCCESS) {
     return rc;
   }
 
+  std::vector<std::unique_ptr<Expression>> new_predicates;
+  if (conjunction->type() == ExprType::CONJUNCTION &&
+      static_cast<ConjunctionExpr *>(conjunction.get())->conjunction_type() == ConjunctionType::AND) {
+    new_predicates = std::move(static_cast<ConjunctionExpr *>(conjunction.get())->children());
+  } else if (conjunction->type() == ExprType::VALUE && conjunction->value_type() == BOOLEANS &&
+             static_cast<ValueExpr *>(conjunction.get())->get_value().get_boolean()) {
+    // 恒为真，不需要任何谓词
+  } else {
+    new_predicates.emplace_back(std::move(conjunction));
+  }
+
+  if (new_predicates.size() != predicate_num) {
+    change_made = true;
+  }
+  table_get.set_predicates(std::move(new_predicates));
+  return rc;
+}
+
+RC ExpressionRewriter::rewrite_expression(std::unique_ptr<Expression> &expr, bool &change_made)
+{
+  RC rc = RC::SUCCESS;
+
+  // 先化简子表达式再化简当前表达式，这样 1 + 2 = a 这种表达式一轮就可以化简完
+  change_made = false;
   switch (expr->type()) {
     case ExprType::FIELD:
     case ExprType::VALUE: {
@@ -74,25 +125,17 @@ RC ExpressionRewriter::rewrite_expression(std::unique_ptr<Expression> &expr, boo
 
     case ExprType::COMPARISON: {
       auto comparison_expr = static_cast<ComparisonExpr *>(expr.get());
-      std::unique_ptr<Expression> &left_expr = comparison_expr->left();
-      std::unique_ptr<Expression> &right_expr = comparison_expr->right();
-
-      bool left_change_made = false;
-      rc = rewrite_expression(left_expr, left_change_made);
+      rc = rewrite_binary_children(comparison_expr->left(), comparison_expr->right(), change_made);
       if (rc != RC::SUCCESS) {
         return rc;
       }
+    } break;
 
-      bool right_change_made = false;
-      if (right_expr != nullptr) {
-        rc = rewrite_expression(right_expr, right_change_made);
-        if (rc != RC::SUCCESS) {
-          return rc;
-        }
-      }
-
-      if (left_change_made || right_change_made) {
-        change_made = true;
+    case ExprType::ARITHMETIC: {
+      auto arithmetic_expr = static_cast<ArithmeticExpr *>(expr.get());
+      rc = rewrite_binary_children(arithmetic_expr->left(), arithmetic_expr->right(), change_made);
+      if (rc != RC::SUCCESS) {
+        return rc;
       }
     } break;
 
@@ -118,5 +161,42 @@ RC ExpressionRewriter::rewrite_expression(std::unique_ptr<Expression> &expr, boo
       // do nothing
     } break;
   }
+
+  for (std::unique_ptr<ExpressionRewriteRule> &rule : expr_rewrite_rules_) {
+    bool sub_change_made = false;
+    rc = rule->rewrite(expr, sub_change_made);
+    if (sub_change_made && !change_made) {
+      change_made = true;
+    }
+    if (rc != RC::SUCCESS) {
+      break;
+    }
+  }
+  return rc;
+}
+
+RC ExpressionRewriter::rewrite_binary_children(
+    std::unique_ptr<Expression> &left_expr, std::unique_ptr<Expression> &right_expr, bool &change_made)
+{
+  RC rc = RC::SUCCESS;
+  bool left_change_made = false;
+  if (left_expr != nullptr) {
+    rc = rewrite_expression(left_expr, left_change_made);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+  }
+
+  bool right_change_made = false;
+  if (right_expr != nullptr) {
+    rc = rewrite_expression(right_expr, right_change_made);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+  }
+
+  if (left_change_made || right_change_made) {
+    change_made = true;
+  }
   return rc;
 }
@@ -0,0 +1,449 @@
+#include "include/query_engine/optimizer/join_reorder.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "common/log/log.h"
+#include "include/query_engine/optimizer/cost_model.h"
+#include "include/query_engine/optimizer/relation_util.h"
+#include "include/query_engine/planner/node/join_logical_node.h"
+#include "include/query_engine/planner/node/table_get_logical_node.h"
+#include "include/query_engine/structor/expression/comparison_expression.h"
+#include "include/query_engine/structor/expression/conjunction_expression.h"
+#include "include/query_engine/structor/expression/field_expression.h"
+#include "include/storage_engine/index/index.h"
+#include "include/storage_engine/recorder/table.h"
+
+using namespace std;
+
+namespace {
+
+/// 哈希表中每一项除了数据之外的额外开销
+constexpr double HASH_ENTRY_OVERHEAD = 48;
+
+struct Conjunct
+{
+  unique_ptr<Expression> expr;
+  RelSet tables = 0;  ///< 条件引用的表，无法确定时为所有表
+  double selectivity = 1;
+
+  /// 等值连接条件左右两边分别引用的表，不能作为连接键时都为0
+  RelSet left_tables = 0;
+  RelSet right_tables = 0;
+};
+
+struct Plan
+{
+  RelSet tables = 0;
+  double rows = 0;
+  double cost = 0;
+  double width = 0;  ///< 一行数据的字节数
+
+  int leaf = -1;  ///< 单表节点的下标，连接时为 -1
+  int left = -1;
+  int right = -1;
+
+  JoinMethod method = JoinMethod::NESTED_LOOP;
+  Index *index = nullptr;
+  vector<int> keys;  ///< 作为连接键使用的条件
+
+  /// 索引嵌套循环连接每次探测右表时估计的行数与代价
+  double probe_rows = 0;
+  double probe_cost = 0;
+};
+
+void collect_join_tree(
+    unique_ptr<LogicalNode> &node, vector<unique_ptr<LogicalNode>> &leaves, vector<unique_ptr<Expression>> &conditions)
+{
+  if (node->type() == LogicalNodeType::JOIN) {
+    split_conjuncts(std::move(static_cast<JoinLogicalNode *>(node.get())->condition()), conditions);
+    collect_join_tree(node->children()[0], leaves, conditions);
+    collect_join_tree(node->children()[1], leaves, conditions);
+    return;
+  }
+  leaves.emplace_back(std::move(node));
+}
+
+/// 哈希表与归并连接的键按照字节比较，只接受两边类型相同并且比较是精确的类型
+bool exact_key_type(AttrType left, AttrType right)
+{
+  return left == right && (left == INTS || left == DATES || left == CHARS);
+}
+
+/**
+ * @brief 在表的子集上枚举连接树
+ */
+class JoinEnumerator
+{
+public:
+  JoinEnumerator(vector<TableGetLogicalNode *> &leaves, vector<Conjunct> &conjuncts)
+      : leaves_(leaves), conjuncts_(conjuncts)
+  {}
+
+  int enumerate()
+  {
+    for (size_t i = 0; i < leaves_.size(); i++) {
+      Plan plan;
+      plan.tables = 1u << i;
+      plan.leaf = static_cast<int>(i);
+      plan.rows = std::max(leaves_[i]->estimated_rows(), 1.0);
+      plan.cost = leaves_[i]->estimated_cost();
+      plan.width = CostModel::row_width(leaves_[i]->table());
+      plans_.push_back(plan);
+    }
+    return leaves_.size() <= JOIN_DP_MAX_TABLES ? dynamic_programming() : greedy();
+  }
+
+  const Plan &plan(int index) const { return plans_[index]; }
+
+  /// 条件是否恰好在 left 与 right 连接时才能计算
+  bool placed_at(const Conjunct &conjunct, RelSet left, RelSet right) const
+  {
+    return subset_of(conjunct.tables, left | right) && !subset_of(conjunct.tables, left) &&
+           !subset_of(conjunct.tables, right);
+  }
+
+private:
+  bool connected(RelSet left, RelSet right) const
+  {
+    for (const Conjunct &conjunct : conjuncts_) {
+      if (placed_at(conjunct, left, right)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// 在右边的单表上找一个可以用等值条件查找的单列索引
+  Index *probe_index(const Plan &right, const Conjunct &conjunct, double &matches) const
+  {
+    Table *table = leaves_[right.leaf]->table();
+    if (table->is_view()) {
+      return nullptr;
+    }
+    auto *comparison_expr = static_cast<ComparisonExpr *>(conjunct.expr.get());
+    Expression *index_side =
+        subset_of(conjunct.left_tables, right.tables) ? comparison_expr->left().get() : comparison_expr->right().get();
+    if (index_side->type() != ExprType::FIELD) {
+      return nullptr;
+    }
+    Expression *probe_side =
+        index_side == comparison_expr->left().get() ? comparison_expr->right().get() : comparison_expr->left().get();
+    const Field &field = static_cast<FieldExpr *>(index_side)->field();
+    const TableMeta &table_meta = table->table_meta();
+    Index *index = nullptr;
+    int best_score = 0;
+    for (int i = 0; i < table_meta.index_num(); i++) {
+      const IndexMeta *index_meta = table_meta.index(i);
+      if (index_meta->type() == IndexType::BLOOM || index_meta->user_field_amount() != 1 ||
+          0 != strcmp(index_meta->field(0), field.field_name())) {
+        continue;
+      }
+      // 哈希索引按照字节查找，探测的值需要与字段的类型相同
+      const bool hash = index_meta->type() == IndexType::HASH;
+      if (hash && probe_side->value_type() != field.attr_type()) {
+        continue;
+      }
+      // 优先使用唯一索引，其次是哈希索引
+      const int score = 1 + (index_meta->is_unique() ? 2 : 0) + (hash ? 1 : 0);
+      if (score > best_score) {
+        index = table->find_index(index_meta->name());
+        best_score = score;
+      }
+    }
+    matches = CostModel::table_rows(table) / std::max(CostModel::column_ndv(field), 1.0);
+    return index;
+  }
+
+  /// 以 left 为左子树、right 为右子树连接，选择代价最低的连接方式
+  Plan join(int left_index, int right_index) const
+  {
+    const Plan &left = plans_[left_index];
+    const Plan &right = plans_[right_index];
+
+    Plan plan;
+    plan.tables = left.tables | right.tables;
+    plan.left = left_index;
+    plan.right = right_index;
+    plan.width = left.width + right.width;
+
+    double rows = left.rows * right.rows;
+    vector<int> keys;
+    for (size_t i = 0; i < conjuncts_.size(); i++) {
+      const Conjunct &conjunct = conjuncts_[i];
+      if (!placed_at(conjunct, left.tables, right.tables)) {
+        continue;
+      }
+      rows *= conjunct.selectivity;
+      if (conjunct.left_tables != 0 &&
+          ((subset_of(conjunct.left_tables, left.tables) && subset_of(conjunct.right_tables, right.tables)) ||
+              (subset_of(conjunct.left_tables, right.tables) && subset_of(conjunct.right_tables, left.tables)))) {
+        keys.push_back(static_cast<int>(i));
+      }
+    }
+    plan.rows = std::max(rows, 1.0);
+
+    plan.method = JoinMethod::NESTED_LOOP;
+    plan.cost = CostModel::nested_loop_join_cost(left.rows, left.cost, right.rows, right.cost);
+    if (keys.empty()) {
+      return plan;
+    }
+
+    if (right.rows * (right.width + HASH_ENTRY_OVERHEAD) <= HASH_JOIN_MEMORY_LIMIT) {
+      double cost = CostModel::hash_join_cost(left.rows, left.cost, right.rows, right.cost);
+      if (cost < plan.cost) {
+        plan.method = JoinMethod::HASH;
+        plan.cost = cost;
+        plan.keys = keys;
+      }
+    }
+
+    double cost = CostModel::merge_join_cost(left.rows, left.cost, right.rows, right.cost);
+    if (cost < plan.cost) {
+      plan.method = JoinMethod::MERGE;
+      plan.cost = cost;
+      plan.keys = keys;
+    }
+
+    if (right.leaf >= 0) {
+      for (int key : keys) {
+        double matches = 0;
+        Index *index = probe_index(right, conjuncts_[key], matches);
+        if (index == nullptr) {
+          continue;
+        }
+        const double table_rows = CostModel::table_rows(leaves_[right.leaf]->table());
+        const double index_pages = CostModel::index_lookup_pages(index->index_meta(), table_rows);
+        cost = CostModel::index_nested_loop_join_cost(left.rows, left.cost, matches, index_pages);
+        if (cost < plan.cost) {
+          plan.method = JoinMethod::INDEX_NESTED_LOOP;
+          plan.cost = cost;
+          plan.index = index;
+          plan.keys = {key};
+          plan.probe_rows = matches * right.rows / table_rows;
+          plan.probe_cost = CostModel::index_nested_loop_join_cost(1, 0, matches, index_pages);
+        }
+      }
+    }
+    return plan;
+  }
+
+  /// 按照子集从小到大的顺序，枚举每个子集所有的两部分划分
+  int dynamic_programming()
+  {
+    const int leaf_num = static_cast<int>(leaves_.size());
+    const RelSet all = (1u << leaf_num) - 1;
+    vector<int> best(all + 1, -1);
+    for (int i = 0; i < leaf_num; i++) {
+      best[1u << i] = i;
+    }
+
+    // 先不考虑笛卡尔积，只有无法连接所有的表时才允许
+    for (bool cross_product : {false, true}) {
+      for (RelSet set = 1; set <= all; set++) {
+        if ((set & (set - 1)) == 0) {
+          continue;
+        }
+        for (RelSet left = (set - 1) & set; left > 0; left = (left - 1) & set) {
+          const RelSet right = set ^ left;
+          if (best[left] < 0 || best[right] < 0 || (!cross_product && !connected(left, right))) {
+            continue;
+          }
+          Plan plan = join(best[left], best[right]);
+          if (best[set] < 0 || plan.cost < plans_[best[set]].cost) {
+            plans_.push_back(std::move(plan));
+            best[set] = static_cast<int>(plans_.size()) - 1;
+          }
+        }
+      }
+      if (best[all] >= 0) {
+        break;
+      }
+    }
+    return best[all];
+  }
+
+  /// 每次选择代价最低的两组表连接，直到只剩一组
+  int greedy()
+  {
+    vector<int> current;
+    for (size_t i = 0; i < leaves_.size(); i++) {
+      current.push_back(static_cast<int>(i));
+    }
+
+    while (current.size() > 1) {
+      int best_left = -1;
+      int best_right = -1;
+      bool best_connected = false;
+      Plan best_plan;
+      for (size_t i = 0; i < current.size(); i++) {
+        for (size_t j = 0; j < current.size(); j++) {
+          if (i == j) {
+            continue;
+          }
+          const bool is_connected = connected(plans_[current[i]].tables, plans_[current[j]].tables);
+          if (best_connected && !is_connected) {
+            continue;
+          }
+          Plan plan = join(current[i], current[j]);
+          if (best_left < 0 || (is_connected && !best_connected) || plan.cost < best_plan.cost) {
+            best_left = static_cast<int>(i);
+            best_right = static_cast<int>(j);
+            best_connected = is_connected;
+            best_plan = std::move(plan);
+          }
+        }
+      }
+
+      plans_.push_back(std::move(best_plan));
+      const int joined = static_cast<int>(plans_.size()) - 1;
+      current.erase(current.begin() + std::max(best_left, best_right));
+      current.erase(current.begin() + std::min(best_left, best_right));
+      current.push_back(joined);
+    }
+    return current.front();
+  }
+
+private:
+  vector<TableGetLogicalNode *> &leaves_;
+  vector<Conjunct> &conjuncts_;
+  vector<Plan> plans_;
+};
+
+unique_ptr<LogicalNode> build_plan(const JoinEnumerator &enumerator, int plan_index,
+    vector<unique_ptr<LogicalNode>> &leaves, vector<Conjunct> &conjuncts)
+{
+  const Plan &plan = enumerator.plan(plan_index);
+  if (plan.leaf >= 0) {
+    return std::move(leaves[plan.leaf]);
+  }
+
+  auto join_node = make_unique<JoinLogicalNode>();
+  join_node->add_child(build_plan(enumerator, plan.left, leaves, conjuncts));
+  join_node->add_child(build_plan(enumerator, plan.right, leaves, conjuncts));
+
+  const RelSet left_tables = enumerator.plan(plan.left).tables;
+  const RelSet right_tables = enumerator.plan(plan.right).tables;
+  vector<unique_ptr<Expression>> residual;
+  for (size_t i = 0; i < conjuncts.size(); i++) {
+    Conjunct &conjunct = conjuncts[i];
+    if (!enumerator.placed_at(conjunct, left_tables, right_tables)) {
+      continue;
+    }
+    if (std::find(plan.keys.begin(), plan.keys.end(), static_cast<int>(i)) == plan.keys.end()) {
+      residual.emplace_back(std::move(conjunct.expr));
+      continue;
+    }
+
+    auto *comparison_expr = static_cast<ComparisonExpr *>(conjunct.expr.get());
+    const bool left_first = subset_of(conjunct.left_tables, left_tables);
+    unique_ptr<Expression> &left_key = left_first ? comparison_expr->left() : comparison_expr->right();
+    unique_ptr<Expression> &right_key = left_first ? comparison_expr->right() : comparison_expr->left();
+    if (plan.method == JoinMethod::INDEX_NESTED_LOOP) {
+      // 索引中的字符串按照定长比较，探测到的行仍然需要用原来的条件检查一次
+      join_node->left_keys().emplace_back(left_key->copy());
+      join_node->right_keys().emplace_back(right_key->copy());
+      residual.emplace_back(std::move(conjunct.expr));
+    } else {
+      join_node->left_keys().emplace_back(std::move(left_key));
+      join_node->right_keys().emplace_back(std::move(right_key));
+    }
+  }
+
+  if (residual.size() == 1) {
+    join_node->set_condition(std::move(residual.front()));
+  } else if (residual.size() > 1) {
+    join_node->set_condition(make_unique<ConjunctionExpr>(ConjunctionType::AND, residual));
+  }
+  if (plan.method == JoinMethod::INDEX_NESTED_LOOP) {
+    join_node->children()[1]->set_estimate(plan.probe_rows, plan.probe_cost);
+  }
+  join_node->set_method(plan.method);
+  join_node->set_index(plan.index);
+  join_node->set_estimate(plan.rows, plan.cost);
+  return join_node;
+}
+
+}  // namespace
+
+RC JoinReorder::rewrite(unique_ptr<LogicalNode> &node)
+{
+  if (node == nullptr) {
+    return RC::SUCCESS;
+  }
+  if (node->type() == LogicalNodeType::JOIN) {
+    return reorder(node);
+  }
+  for (unique_ptr<LogicalNode> &child : node->children()) {
+    RC rc = rewrite(child);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+  }
+  return RC::SUCCESS;
+}
+
+RC JoinReorder::reorder(unique_ptr<LogicalNode> &join_root)
+{
+  vector<TableGetLogicalNode *> table_gets;
+  if (!is_join_tree(join_root.get(), table_gets) || table_gets.size() > JOIN_MAX_TABLES) {
+    for (unique_ptr<LogicalNode> &child : join_root->children()) {
+      RC rc = rewrite(child);
+      if (rc != RC::SUCCESS) {
+        return rc;
+      }
+    }
+    return RC::SUCCESS;
+  }
+
+  vector<unique_ptr<LogicalNode>> leaves;
+  vector<unique_ptr<Expression>> conditions;
+  collect_join_tree(join_root, leaves, conditions);
+
+  const int leaf_num = static_cast<int>(leaves.size());
+  const RelSet all_tables = leaf_num == JOIN_MAX_TABLES ? ~0u : (1u << leaf_num) - 1;
+  vector<Conjunct> conjuncts;
+  for (unique_ptr<Expression> &condition : conditions) {
+    RelSet tables = 0;
+    const bool resolved = referenced_tables(condition.get(), table_gets, tables) && tables != 0;
+    if (!resolved) {
+      // 无法确定引用关系的条件放在最上层的连接上
+      tables = all_tables;
+    } else if ((tables & (tables - 1)) == 0) {
+      // 内连接中只涉及一张表的条件直接在扫描这张表时过滤
+      table_gets[__builtin_ctz(tables)]->predicates().emplace_back(std::move(condition));
+      continue;
+    }
+
+    Conjunct conjunct;
+    conjunct.tables = tables;
+    conjunct.selectivity = CostModel::selectivity(condition.get());
+    if (resolved && condition->type() == ExprType::COMPARISON) {
+      auto *comparison_expr = static_cast<ComparisonExpr *>(condition.get());
+      RelSet left_tables = 0;
+      RelSet right_tables = 0;
+      if (comparison_expr->comp() == EQUAL_TO &&
+          referenced_tables(comparison_expr->left().get(), table_gets, left_tables) &&
+          referenced_tables(comparison_expr->right().get(), table_gets, right_tables) && left_tables != 0 &&
+          right_tables != 0 && (left_tables & right_tables) == 0 &&
+          exact_key_type(comparison_expr->left()->value_type(), comparison_expr->right()->value_type())) {
+        conjunct.left_tables = left_tables;
+        conjunct.right_tables = right_tables;
+      }
+    }
+    conjunct.expr = std::move(condition);
+    conjuncts.emplace_back(std::move(conjunct));
+  }
+
+  for (TableGetLogicalNode *table_get : table_gets) {
+    CostModel::estimate_table_get(*table_get);
+  }
+
+  JoinEnumerator enumerator(table_gets, conjuncts);
+  const int best = enumerator.enumerate();
+  join_root = build_plan(enumerator, best, leaves, conjuncts);
+  LOG_TRACE("reordered join of %d tables. rows=%.0f, cost=%.2f",
+      leaf_num, join_root->estimated_rows(), join_root->estimated_cost());
+  return RC::SUCCESS;
+}
@@ -1,12 +1,40 @@
 #include "include/query_engine/optimizer/optimizer.h"
+#include "include/query_engine/optimizer/cost_model.h"
+#include "common/log/log.h"
+
+namespace {
+/// 逻辑计划重写的最大轮数
+constexpr int MAX_REWRITE_ROUNDS = 16;
+}  // namespace
 
 RC Optimizer::rewrite(std::unique_ptr<LogicalNode> &logical_operator)
 {
-    RC rc;
-    bool change = false;
-    rc = rewriter_.rewrite(logical_operator, change);
-    if(rc != RC::SUCCESS){
-      return rc;
+    // 一条规则的结果可能让其它规则继续生效，比如谓词下推之后扫描上的条件可以再化简，
+    // 所以重复执行直到没有变化。规则本身保证会收敛，这里的上限只是防止出现意外的循环
+    RC rc = RC::SUCCESS;
+    bool change = true;
+    for (int round = 0; change && round < MAX_REWRITE_ROUNDS; round++) {
+      change = false;
+      rc = rewriter_.rewrite(logical_operator, change);
+      if(rc != RC::SUCCESS){
+        return rc;
+      }
+    }
+    if (change) {
+      LOG_WARN("logical plan rewriting did not converge after %d rounds", MAX_REWRITE_ROUNDS);
     }
     return rc;
-}
\ No newline at end of file
+}
+
+RC Optimizer::optimize(std::unique_ptr<LogicalNode> &logical_operator)
+{
+    if (logical_operator == nullptr) {
+      return RC::SUCCESS;
+    }
+    RC rc = join_reorder_.rewrite(logical_operator);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+    CostModel::estimate(*logical_operator);
+    return RC::SUCCESS;
+}
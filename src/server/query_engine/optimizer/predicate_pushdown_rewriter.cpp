@@ -1,9 +1,212 @@
 #include "include/query_engine/optimizer/predicate_pushdown_rewriter.h"
+
+#include <map>
+#include <set>
+#include <string>
+
+#include "include/query_engine/optimizer/relation_util.h"
+#include "include/query_engine/planner/node/join_logical_node.h"
 #include "include/query_engine/planner/node/logical_node.h"
 #include "include/query_engine/planner/node/table_get_logical_node.h"
 #include "include/query_engine/structor/expression/value_expression.h"
 #include "include/query_engine/structor/expression/conjunction_expression.h"
 #include "include/query_engine/structor/expression/comparison_expression.h"
+#include "include/query_engine/structor/expression/field_expression.h"
+
+namespace {
+
+/// 按照 AND 拆开表达式但不取走它们，用于收集已经放在连接与扫描上的条件
+void visit_conjuncts(Expression *expr, std::vector<Expression *> &conjuncts)
+{
+  if (expr == nullptr) {
+    return;
+  }
+  if (expr->type() == ExprType::CONJUNCTION &&
+      static_cast<ConjunctionExpr *>(expr)->conjunction_type() == ConjunctionType::AND) {
+    for (std::unique_ptr<Expression> &child : static_cast<ConjunctionExpr *>(expr)->children()) {
+      visit_conjuncts(child.get(), conjuncts);
+    }
+    return;
+  }
+  conjuncts.push_back(expr);
+}
+
+/// 收集连接子树中已有的连接条件与扫描条件
+void collect_placed_conjuncts(LogicalNode *node, std::vector<Expression *> &conjuncts)
+{
+  if (node->type() == LogicalNodeType::JOIN) {
+    visit_conjuncts(static_cast<JoinLogicalNode *>(node)->condition().get(), conjuncts);
+  } else if (node->type() == LogicalNodeType::TABLE_GET) {
+    for (std::unique_ptr<Expression> &predicate : static_cast<TableGetLogicalNode *>(node)->predicates()) {
+      visit_conjuncts(predicate.get(), conjuncts);
+    }
+  }
+  for (std::unique_ptr<LogicalNode> &child : node->children()) {
+    collect_placed_conjuncts(child.get(), conjuncts);
+  }
+}
+
+/**
+ * @brief 由等值条件构成的字段等价类
+ * @details 只接受比较结果精确的类型，这样等值关系才具有传递性。
+ * 等价类中有字段等于常量时，其它字段也等于这个常量；否则不同表的字段之间两两相等
+ */
+class EquivalenceClasses
+{
+public:
+  explicit EquivalenceClasses(const std::vector<TableGetLogicalNode *> &leaves) : leaves_(leaves) {}
+
+  void add_fact(Expression *expr)
+  {
+    if (expr->type() != ExprType::COMPARISON) {
+      return;
+    }
+    auto *comparison_expr = static_cast<ComparisonExpr *>(expr);
+    if (comparison_expr->comp() != EQUAL_TO) {
+      return;
+    }
+
+    Expression *left = comparison_expr->left().get();
+    Expression *right = comparison_expr->right().get();
+    if (left->type() == ExprType::VALUE || left->type() == ExprType::PARAM) {
+      std::swap(left, right);
+    }
+    if (left->type() != ExprType::FIELD) {
+      return;
+    }
+
+    const int left_column = column(static_cast<FieldExpr *>(left));
+    if (left_column < 0) {
+      return;
+    }
+    if (right->type() == ExprType::FIELD) {
+      const int right_column = column(static_cast<FieldExpr *>(right));
+      if (right_column < 0 || left->value_type() != right->value_type()) {
+        return;
+      }
+      parents_[find(left_column)] = find(right_column);
+      equal_pairs_.emplace(std::min(left_column, right_column), std::max(left_column, right_column));
+    } else if (right->type() == ExprType::VALUE) {
+      auto *value_expr = static_cast<ValueExpr *>(right);
+      if (!value_expr->get_value().is_null() && value_expr->value_type() == left->value_type() &&
+          constants_[left_column] == nullptr) {
+        constants_[left_column] = value_expr;
+      }
+    } else if (right->type() == ExprType::PARAM && constants_[left_column] == nullptr) {
+      // 参数的值在执行时才知道，同一个参数与等价类中的每个字段的比较结果都相同
+      constants_[left_column] = right;
+    }
+  }
+
+  void derive(std::vector<std::unique_ptr<Expression>> &derived)
+  {
+    const int column_num = static_cast<int>(columns_.size());
+    std::vector<Expression *> class_constants(column_num, nullptr);
+    for (int i = 0; i < column_num; i++) {
+      if (constants_[i] != nullptr && class_constants[find(i)] == nullptr) {
+        class_constants[find(i)] = constants_[i];
+      }
+    }
+
+    for (int i = 0; i < column_num; i++) {
+      Expression *constant = class_constants[find(i)];
+      if (constant != nullptr) {
+        if (constants_[i] == nullptr) {
+          derived.emplace_back(new ComparisonExpr(EQUAL_TO,
+              std::unique_ptr<Expression>(columns_[i]->copy()), std::unique_ptr<Expression>(constant->copy())));
+        }
+        continue;
+      }
+      for (int j = i + 1; j < column_num; j++) {
+        if (find(i) != find(j) || owners_[i] == owners_[j] || equal_pairs_.count({i, j}) > 0) {
+          continue;
+        }
+        derived.emplace_back(new ComparisonExpr(EQUAL_TO,
+            std::unique_ptr<Expression>(columns_[i]->copy()), std::unique_ptr<Expression>(columns_[j]->copy())));
+      }
+    }
+  }
+
+private:
+  int column(FieldExpr *field_expr)
+  {
+    const AttrType type = field_expr->value_type();
+    if (type != INTS && type != DATES && type != CHARS) {
+      return -1;
+    }
+    const int owner = field_owner(field_expr->field(), leaves_);
+    if (owner < 0) {
+      return -1;
+    }
+    auto key = std::make_pair(owner, std::string(field_expr->field_name()));
+    auto iter = ids_.find(key);
+    if (iter != ids_.end()) {
+      return iter->second;
+    }
+    const int id = static_cast<int>(columns_.size());
+    ids_.emplace(key, id);
+    columns_.push_back(field_expr);
+    owners_.push_back(owner);
+    parents_.push_back(id);
+    constants_.push_back(nullptr);
+    return id;
+  }
+
+  int find(int id)
+  {
+    while (parents_[id] != id) {
+      parents_[id] = parents_[parents_[id]];
+      id = parents_[id];
+    }
+    return id;
+  }
+
+private:
+  const std::vector<TableGetLogicalNode *> &leaves_;
+  std::map<std::pair<int, std::string>, int> ids_;
+  std::vector<FieldExpr *> columns_;
+  std::vector<int> owners_;
+  std::vector<int> parents_;
+  std::vector<Expression *> constants_;  ///< 条件中直接与字段比较的常量或者参数
+  std::set<std::pair<int, int>> equal_pairs_;
+};
+
+RelSet node_tables(LogicalNode *node, const std::vector<TableGetLogicalNode *> &leaves)
+{
+  if (node->type() == LogicalNodeType::TABLE_GET) {
+    for (size_t i = 0; i < leaves.size(); i++) {
+      if (leaves[i] == node) {
+        return 1u << i;
+      }
+    }
+    return 0;
+  }
+  RelSet tables = 0;
+  for (std::unique_ptr<LogicalNode> &child : node->children()) {
+    tables |= node_tables(child.get(), leaves);
+  }
+  return tables;
+}
+
+/// 把涉及多张表的条件放到能够计算它的最低的连接上
+void attach_to_join(LogicalNode *node, const std::vector<TableGetLogicalNode *> &leaves, RelSet tables,
+    std::unique_ptr<Expression> expr)
+{
+  for (std::unique_ptr<LogicalNode> &child : node->children()) {
+    if (child->type() == LogicalNodeType::JOIN && subset_of(tables, node_tables(child.get(), leaves))) {
+      attach_to_join(child.get(), leaves, tables, std::move(expr));
+      return;
+    }
+  }
+
+  auto *join_node = static_cast<JoinLogicalNode *>(node);
+  std::vector<std::unique_ptr<Expression>> conditions;
+  split_conjuncts(std::move(join_node->condition()), conditions);
+  conditions.emplace_back(std::move(expr));
+  join_node->set_condition(merge_conjuncts(conditions));
+}
+
+}  // namespace
 
 RC PredicatePushdownRewriter::rewrite(std::unique_ptr<LogicalNode> &oper, bool &change_made)
 {
@@ -17,89 +220,69 @@ RC PredicatePushdownRewriter::rewrite(std::unique_ptr<LogicalNode> &oper, bool &
   }
 
   std::unique_ptr<LogicalNode> &child_oper = oper->children().front();
-  if (child_oper->type() != LogicalNodeType::TABLE_GET) {
+  std::vector<TableGetLogicalNode *> table_gets;
+  if (!is_join_tree(child_oper.get(), table_gets) || table_gets.size() > REL_SET_MAX_TABLES) {
     return rc;
   }
 
-  auto table_get_oper = static_cast<TableGetLogicalNode *>(child_oper.get());
-
   std::vector<std::unique_ptr<Expression>> &predicate_oper_exprs = oper->expressions();
   if (predicate_oper_exprs.size() != 1) {
     return rc;
   }
 
   std::unique_ptr<Expression> &predicate_expr = predicate_oper_exprs.front();
-  std::vector<std::unique_ptr<Expression>> pushdown_exprs;
-  rc = get_exprs_can_pushdown(predicate_expr, pushdown_exprs);
-  if (rc != RC::SUCCESS) {
-    LOG_WARN("failed to get exprs can pushdown. rc=%s", strrc(rc));
-    return rc;
+  std::vector<std::unique_ptr<Expression>> conjuncts;
+  split_conjuncts(std::move(predicate_expr), conjuncts);
+  derive_equalities(child_oper.get(), table_gets, conjuncts);
+
+  std::vector<std::unique_ptr<Expression>> remain_exprs;
+  for (std::unique_ptr<Expression> &conjunct : conjuncts) {
+    RelSet tables = 0;
+    if (!referenced_tables(conjunct.get(), table_gets, tables) || tables == 0) {
+      // 子查询、外层查询的字段以及常量条件留在原地
+      remain_exprs.emplace_back(std::move(conjunct));
+      continue;
+    }
+
+    change_made = true;
+    if ((tables & (tables - 1)) == 0) {
+      table_gets[__builtin_ctz(tables)]->predicates().emplace_back(std::move(conjunct));
+    } else {
+      // 内连接中 WHERE 里的多表条件与连接条件等价，放到连接上避免先生成笛卡尔积
+      attach_to_join(child_oper.get(), table_gets, tables, std::move(conjunct));
+    }
   }
 
+  predicate_expr = merge_conjuncts(remain_exprs);
   if (!predicate_expr) {
     // 所有的表达式都下推到了下层算子
     // 这个predicate operator其实就可以不要了。但是这里没办法删除，弄一个空的表达式吧
-    LOG_TRACE("all expressions of predicate operator were pushdown to table get operator, then make a fake one");
+    LOG_TRACE("all expressions of predicate operator were pushdown, then make a fake one");
 
     Value value((bool)true);
     predicate_expr = std::unique_ptr<Expression>(new ValueExpr(value));
   }
-
-  if (!pushdown_exprs.empty()) {
-    change_made = true;
-    table_get_oper->set_predicates(std::move(pushdown_exprs));
-  }
   return rc;
 }
 
 /**
- * 查看表达式是否可以直接下放到table get算子的filter
- * @param expr 是当前的表达式。如果可以下放给table get 算子，执行完成后expr就失效了
- * @param pushdown_exprs 当前所有要下放给table get 算子的filter。此函数执行多次，
- *                       pushdown_exprs 只会增加，不要做清理操作
+ * 根据等值条件的传递性推导出新的条件，比如 a = b AND b = 5 可以推导出 a = 5，
+ * 这样 a 上的索引也可以使用。推导时也会考虑已经放在连接和扫描上的条件，
+ * 已经存在的条件不会重复生成，所以多次执行这条规则不会不断增加条件
+ * @param conjuncts 当前要下推的条件，推导出的条件追加在后面
  */
-RC PredicatePushdownRewriter::get_exprs_can_pushdown(
-    std::unique_ptr<Expression> &expr, std::vector<std::unique_ptr<Expression>> &pushdown_exprs)
+void PredicatePushdownRewriter::derive_equalities(LogicalNode *join_tree,
+    const std::vector<TableGetLogicalNode *> &table_gets, std::vector<std::unique_ptr<Expression>> &conjuncts)
 {
-  RC rc = RC::SUCCESS;
-  if (expr->type() == ExprType::CONJUNCTION) {
-    ConjunctionExpr *conjunction_expr = static_cast<ConjunctionExpr *>(expr.get());
-    // 或 操作的比较，太复杂，现在不考虑
-    if (conjunction_expr->conjunction_type() == ConjunctionType::OR) {
-      return rc;
-    }
-
-    std::vector<std::unique_ptr<Expression>> &child_exprs = conjunction_expr->children();
-    for (auto iter = child_exprs.begin(); iter != child_exprs.end();) {
-      // 对每个子表达式，判断是否可以下放到table get 算子
-      // 如果可以的话，就从当前孩子节点中删除他
-      rc = get_exprs_can_pushdown(*iter, pushdown_exprs);
-      if (rc != RC::SUCCESS) {
-        LOG_WARN("failed to get pushdown expressions. rc=%s", strrc(rc));
-        return rc;
-      }
-
-      if (!*iter) {
-        child_exprs.erase(iter);
-      } else {
-        ++iter;
-      }
-    }
-  } else if (expr->type() == ExprType::COMPARISON) {
-    // 如果是比较操作，并且比较的左边或右边是表某个列值，那么就下推下去
-    auto comparison_expr = static_cast<ComparisonExpr *>(expr.get());
-    std::unique_ptr<Expression> &left_expr = comparison_expr->left();
-    std::unique_ptr<Expression> &right_expr = comparison_expr->right();
-    // 比较操作的左右两边只要有一个是取列字段值的并且另一边也是取字段值或常量，就pushdown
-    if (left_expr->type() != ExprType::FIELD && right_expr->type() != ExprType::FIELD) {
-      return rc;
-    }
-    if (left_expr->type() != ExprType::FIELD && left_expr->type() != ExprType::VALUE &&
-        right_expr->type() != ExprType::FIELD && right_expr->type() != ExprType::VALUE) {
-      return rc;
-    }
+  std::vector<Expression *> facts;
+  collect_placed_conjuncts(join_tree, facts);
+  for (std::unique_ptr<Expression> &conjunct : conjuncts) {
+    facts.push_back(conjunct.get());
+  }
 
-    pushdown_exprs.emplace_back(std::move(expr));
+  EquivalenceClasses classes(table_gets);
+  for (Expression *fact : facts) {
+    classes.add_fact(fact);
   }
-  return rc;
+  classes.derive(conjuncts);
 }
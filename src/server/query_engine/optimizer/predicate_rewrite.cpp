@@ -26,18 +26,21 @@ RC PredicateRewriteRule::rewrite(std::unique_ptr<LogicalNode> &oper, bool &chang
 
   // 如果仅有的一个子节点是predicate
   // 并且这个子节点可以判断为恒为TRUE，那么可以省略这个子节点，并把他的子节点们（就是孙子节点）接管过来
-  // 如果可以判断恒为false，那么就可以删除子节点
+  // 恒为false时保留这个子节点，由predicate算子直接返回结束，上层的聚合等算子仍然需要一个空的输入
+  if (expr->value_type() != BOOLEANS) {
+    return RC::SUCCESS;
+  }
   auto value_expr = static_cast<ValueExpr *>(expr.get());
   bool bool_value = value_expr->get_value().get_boolean();
-  if (true == bool_value) {
-    std::vector<std::unique_ptr<LogicalNode>> grand_child_opers;
-    grand_child_opers.swap(child_oper->children());
-    child_opers.clear();
-    for (auto &grand_child_oper : grand_child_opers) {
-      oper->add_child(std::move(grand_child_oper));
-    }
-  } else {
-    child_opers.clear();
+  if (!bool_value) {
+    return RC::SUCCESS;
+  }
+
+  std::vector<std::unique_ptr<LogicalNode>> grand_child_opers;
+  grand_child_opers.swap(child_oper->children());
+  child_opers.clear();
+  for (auto &grand_child_oper : grand_child_opers) {
+    oper->add_child(std::move(grand_child_oper));
   }
 
   change_made = true;
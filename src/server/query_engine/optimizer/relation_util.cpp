@@ -0,0 +1,116 @@
+#include "include/query_engine/optimizer/relation_util.h"
+
+#include "include/query_engine/planner/node/logical_node.h"
+#include "include/query_engine/planner/node/table_get_logical_node.h"
+#include "include/query_engine/structor/expression/arithmetic_expression.h"
+#include "include/query_engine/structor/expression/comparison_expression.h"
+#include "include/query_engine/structor/expression/conjunction_expression.h"
+#include "include/query_engine/structor/expression/field_expression.h"
+#include "include/query_engine/structor/expression/value_expression.h"
+
+using namespace std;
+
+int field_owner(const Field &field, const vector<TableGetLogicalNode *> &leaves)
+{
+  int owner = -1;
+  for (size_t i = 0; i < leaves.size(); i++) {
+    if (leaves[i]->table() != field.table()) {
+      continue;
+    }
+    if (field.table_alias()[0] != '\0' && leaves[i]->table_alias() != field.table_alias()) {
+      continue;
+    }
+    if (owner >= 0) {
+      return -1;
+    }
+    owner = static_cast<int>(i);
+  }
+  return owner;
+}
+
+bool referenced_tables(Expression *expr, const vector<TableGetLogicalNode *> &leaves, RelSet &tables)
+{
+  if (expr == nullptr) {
+    return true;
+  }
+  switch (expr->type()) {
+    case ExprType::FIELD: {
+      int owner = field_owner(static_cast<FieldExpr *>(expr)->field(), leaves);
+      if (owner < 0) {
+        return false;
+      }
+      tables |= 1u << owner;
+      return true;
+    }
+    case ExprType::VALUE:
+    case ExprType::VALUES:
+    case ExprType::PARAM: {
+      return true;
+    }
+    case ExprType::COMPARISON: {
+      auto *comparison_expr = static_cast<ComparisonExpr *>(expr);
+      return referenced_tables(comparison_expr->left().get(), leaves, tables) &&
+             referenced_tables(comparison_expr->right().get(), leaves, tables);
+    }
+    case ExprType::ARITHMETIC: {
+      auto *arithmetic_expr = static_cast<ArithmeticExpr *>(expr);
+      return referenced_tables(arithmetic_expr->left().get(), leaves, tables) &&
+             referenced_tables(arithmetic_expr->right().get(), leaves, tables);
+    }
+    case ExprType::CONJUNCTION: {
+      for (unique_ptr<Expression> &child : static_cast<ConjunctionExpr *>(expr)->children()) {
+        if (!referenced_tables(child.get(), leaves, tables)) {
+          return false;
+        }
+      }
+      return true;
+    }
+    default: {
+      return false;
+    }
+  }
+}
+
+void split_conjuncts(unique_ptr<Expression> expr, vector<unique_ptr<Expression>> &conjuncts)
+{
+  if (expr == nullptr) {
+    return;
+  }
+  if (expr->type() == ExprType::CONJUNCTION &&
+      static_cast<ConjunctionExpr *>(expr.get())->conjunction_type() == ConjunctionType::AND) {
+    for (unique_ptr<Expression> &child : static_cast<ConjunctionExpr *>(expr.get())->children()) {
+      split_conjuncts(std::move(child), conjuncts);
+    }
+    return;
+  }
+  if (expr->type() == ExprType::VALUE) {
+    const Value &value = static_cast<ValueExpr *>(expr.get())->get_value();
+    if (!value.is_null() && value.get_boolean()) {
+      return;
+    }
+  }
+  conjuncts.emplace_back(std::move(expr));
+}
+
+unique_ptr<Expression> merge_conjuncts(vector<unique_ptr<Expression>> &conjuncts)
+{
+  if (conjuncts.empty()) {
+    return nullptr;
+  }
+  if (conjuncts.size() == 1) {
+    return std::move(conjuncts.front());
+  }
+  return make_unique<ConjunctionExpr>(ConjunctionType::AND, conjuncts);
+}
+
+bool is_join_tree(LogicalNode *node, vector<TableGetLogicalNode *> &leaves)
+{
+  if (node->type() == LogicalNodeType::TABLE_GET) {
+    leaves.push_back(static_cast<TableGetLogicalNode *>(node));
+    return true;
+  }
+  if (node->type() != LogicalNodeType::JOIN || node->children().size() != 2) {
+    return false;
+  }
+  return is_join_tree(node->children()[0].get(), leaves) && is_join_tree(node->children()[1].get(), leaves);
+}
@@ -6,6 +6,8 @@
 
 Rewriter::Rewriter()
 {
+  rewrite_rules_.emplace_back(new ExpressionRewriter);
+  rewrite_rules_.emplace_back(new PredicateRewriteRule);
   rewrite_rules_.emplace_back(new PredicatePushdownRewriter);
 }
 
@@ -1405,7 +1405,19 @@ RETURN_TOKEN(GROUP);
 case 64:
 YY_RULE_SETUP
 #line 142 "lex_sql.l"
-yylval->string=strdup(yytext); RETURN_TOKEN(ID);
+{
+  /* 以下关键字的规则写在 {ID} 之前，与 {ID} 匹配的长度相同时按规则顺序优先返回关键字 */
+  if (0 == strcasecmp(yytext, "LIMIT")) { RETURN_TOKEN(LIMIT); }
+  if (0 == strcasecmp(yytext, "OFFSET")) { RETURN_TOKEN(OFFSET); }
+  if (0 == strcasecmp(yytext, "BETWEEN")) { RETURN_TOKEN(BETWEEN); }
+  if (0 == strcasecmp(yytext, "ANALYZE")) { RETURN_TOKEN(ANALYZE); }
+  if (0 == strcasecmp(yytext, "PREPARE")) { RETURN_TOKEN(PREPARE); }
+  if (0 == strcasecmp(yytext, "EXECUTE")) { RETURN_TOKEN(EXECUTE); }
+  if (0 == strcasecmp(yytext, "DEALLOCATE")) { RETURN_TOKEN(DEALLOCATE); }
+  if (0 == strcasecmp(yytext, "USING")) { RETURN_TOKEN(USING); }
+  if (0 == strcasecmp(yytext, "RESET")) { RETURN_TOKEN(RESET); }
+  yylval->string=strdup(yytext); RETURN_TOKEN(ID);
+}
 	YY_BREAK
 case 65:
 YY_RULE_SETUP
@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "include/query_engine/parser/parser.h"
 
 CalcSqlNode::~CalcSqlNode()
@@ -21,19 +23,12 @@ void ParsedSqlResult::add_sql_node(std::unique_ptr<ParsedSqlNode> sql_node)
 
 int sql_parse(const char *st, ParsedSqlResult *sql_result);
 
-RC Parser::parse(QueryInfo *query_info)
+RC Parser::parse(const std::string &sql, std::unique_ptr<ParsedSqlNode> &sql_node, int &param_count)
 {
-  RC rc = RC::SUCCESS;
-  
-  SqlResult *sql_result = query_info->session_event()->sql_result();
-  const std::string &sql = query_info->sql();
-
   ParsedSqlResult parsed_sql_result;
 
   sql_parse(sql.c_str(), &parsed_sql_result);
   if (parsed_sql_result.sql_nodes().empty()) {
-    sql_result->set_return_code(RC::SUCCESS);
-    sql_result->set_state_string("");
     return RC::INTERNAL;
   }
 
@@ -41,13 +36,10 @@ RC Parser::parse(QueryInfo *query_info)
     LOG_WARN("got multi sql commands but only 1 will be handled");
   }
 
-  std::unique_ptr<ParsedSqlNode> sql_node = std::move(parsed_sql_result.sql_nodes().front());
+  param_count = parsed_sql_result.param_count();
+  sql_node = std::move(parsed_sql_result.sql_nodes().front());
   if (sql_node->flag == SCF_ERROR) {
-    // set error information to event
-    rc = RC::SQL_SYNTAX;
-    sql_result->set_return_code(rc);
-    sql_result->set_state_string("");
-    return rc;
+    return RC::SQL_SYNTAX;
   }
 
   if (sql_node->flag == SCF_CREATE_TABLE) {
@@ -63,10 +55,7 @@ RC Parser::parse(QueryInfo *query_info)
       for (const auto & value: values) {
         if(value.attr_type() == DATES && value.get_int() <= 0) {
           // check invalid date data
-          rc = RC::INVALID_ARGUMENT;
-          sql_result->set_return_code(rc);
-          sql_result->set_state_string("");
-          return rc;
+          return RC::INVALID_ARGUMENT;
         }
       }
     }
@@ -80,10 +69,7 @@ RC Parser::parse(QueryInfo *query_info)
           Value value;
           left_expr->get_value(value);
           if (value.get_int() <= 0) {
-            rc = RC::INVALID_ARGUMENT;
-            sql_result->set_return_code(rc);
-            sql_result->set_state_string("");
-            return rc;
+            return RC::INVALID_ARGUMENT;
           }
         }
       }
@@ -93,10 +79,7 @@ RC Parser::parse(QueryInfo *query_info)
           Value value;
           right_expr->get_value(value);
           if (value.get_int() <= 0) {
-            rc = RC::INVALID_ARGUMENT;
-            sql_result->set_return_code(rc);
-            sql_result->set_state_string("");
-            return rc;
+            return RC::INVALID_ARGUMENT;
           }
         }
       }
@@ -106,7 +89,71 @@ RC Parser::parse(QueryInfo *query_info)
 
   }
 
+  if (sql_node->flag == SCF_EXECUTE) {
+    for (const Value &value : sql_node->execute.params) {
+      if (value.attr_type() == DATES && value.get_int() <= 0) {
+        return RC::INVALID_ARGUMENT;
+      }
+    }
+  }
+
+  return RC::SUCCESS;
+}
+
+void Parser::split(const std::string &sql, std::vector<std::string> &statements)
+{
+  statements.clear();
+  size_t begin = 0;
+  char quote = 0;
+  for (size_t i = 0; i <= sql.size(); i++) {
+    const char c = (i < sql.size()) ? sql[i] : ';';
+    if (quote != 0) {
+      if (c == quote) {
+        quote = 0;
+      }
+      continue;
+    }
+    if (c == '\'' || c == '"') {
+      quote = c;
+    } else if (c == ';') {
+      std::string statement = sql.substr(begin, std::min(i + 1, sql.size()) - begin);
+      if (statement.find_first_not_of(" \t\r\n;") != std::string::npos) {
+        statements.emplace_back(std::move(statement));
+      }
+      begin = i + 1;
+    }
+  }
+  // 引号没有闭合时整个剩余部分作为一条语句，交给语法解析报错
+  if (quote != 0 && begin < sql.size()) {
+    statements.emplace_back(sql.substr(begin));
+  }
+}
+
+RC Parser::parse(QueryInfo *query_info)
+{
+  SqlResult *sql_result = query_info->session_event()->sql_result();
+
+  std::unique_ptr<ParsedSqlNode> sql_node;
+  int param_count = 0;
+  RC rc = parse(query_info->sql(), sql_node, param_count);
+  if (rc == RC::SUCCESS && param_count > 0) {
+    // 参数占位符只能出现在 PREPARE 的语句中
+    LOG_WARN("parameter placeholders are only allowed in prepared statements");
+    rc = RC::SQL_SYNTAX;
+  }
+  if (rc == RC::INTERNAL) {
+    sql_result->set_return_code(RC::SUCCESS);
+    sql_result->set_state_string("");
+    return rc;
+  }
+  if (rc != RC::SUCCESS) {
+    // set error information to event
+    sql_result->set_return_code(rc);
+    sql_result->set_state_string("");
+    return rc;
+  }
+
   query_info->set_sql_node(std::move(sql_node));
 
   return RC::SUCCESS;
-}
\ No newline at end of file
+}
@@ -0,0 +1,256 @@
+#include "include/query_engine/parser/sql_normalizer.h"
+
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+
+#include "common/lang/string.h"
+
+namespace {
+
+enum class TokenType
+{
+  IDENTIFIER,
+  NUMBER,
+  STRING,
+  SYMBOL,
+};
+
+struct Token
+{
+  TokenType   type;
+  std::string text;
+};
+
+bool tokenize(const std::string &sql, std::vector<Token> &tokens)
+{
+  size_t i = 0;
+  const size_t size = sql.size();
+  while (i < size) {
+    const char c = sql[i];
+    if (isspace(static_cast<unsigned char>(c)) || c == ';') {
+      i++;
+      continue;
+    }
+
+    const size_t start = i;
+    if (isalpha(static_cast<unsigned char>(c)) || c == '_') {
+      while (i < size && (isalnum(static_cast<unsigned char>(sql[i])) || sql[i] == '_')) {
+        i++;
+      }
+      tokens.push_back({TokenType::IDENTIFIER, sql.substr(start, i - start)});
+    } else if (isdigit(static_cast<unsigned char>(c))) {
+      while (i < size && isdigit(static_cast<unsigned char>(sql[i]))) {
+        i++;
+      }
+      if (i + 1 < size && sql[i] == '.' && isdigit(static_cast<unsigned char>(sql[i + 1]))) {
+        i++;
+        while (i < size && isdigit(static_cast<unsigned char>(sql[i]))) {
+          i++;
+        }
+      }
+      if (i < size && (isalpha(static_cast<unsigned char>(sql[i])) || sql[i] == '_' || sql[i] == '.')) {
+        return false;
+      }
+      tokens.push_back({TokenType::NUMBER, sql.substr(start, i - start)});
+    } else if (c == '\'' || c == '"') {
+      const size_t end = sql.find(c, i + 1);
+      if (end == std::string::npos) {
+        return false;
+      }
+      i = end + 1;
+      tokens.push_back({TokenType::STRING, sql.substr(start, i - start)});
+    } else if (c == '?') {
+      // 已经有占位符的SQL只能通过 PREPARE 执行
+      return false;
+    } else {
+      static const char *two_char_symbols[] = {"<=", ">=", "<>", "!="};
+      i++;
+      for (const char *symbol : two_char_symbols) {
+        if (0 == sql.compare(start, 2, symbol)) {
+          i = start + 2;
+          break;
+        }
+      }
+      tokens.push_back({TokenType::SYMBOL, sql.substr(start, i - start)});
+    }
+  }
+  return true;
+}
+
+bool is_keyword(const Token &token, const char *keyword)
+{
+  return token.type == TokenType::IDENTIFIER && 0 == strcasecmp(token.text.c_str(), keyword);
+}
+
+bool is_keyword(const Token &token, std::initializer_list<const char *> keywords)
+{
+  for (const char *keyword : keywords) {
+    if (is_keyword(token, keyword)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool is_arithmetic(const Token &token)
+{
+  return token.type == TokenType::SYMBOL &&
+         (token.text == "+" || token.text == "-" || token.text == "*" || token.text == "/");
+}
+
+/// 负号前面是运算符或者关键字时，它与后面的数字组成一个负数常量
+bool is_unary_minus(const std::vector<Token> &tokens, size_t pos)
+{
+  if (tokens[pos].type != TokenType::SYMBOL || tokens[pos].text != "-" || pos == 0 || pos + 1 >= tokens.size() ||
+      tokens[pos + 1].type != TokenType::NUMBER) {
+    return false;
+  }
+  const Token &prev = tokens[pos - 1];
+  if (prev.type == TokenType::SYMBOL) {
+    return prev.text != ")";
+  }
+  return is_keyword(prev, {"where", "on", "set", "and", "or", "not", "between", "like"});
+}
+
+/// 找到与 pos 处的左括号匹配的右括号，没有时返回 tokens 的大小
+size_t matching_brace(const std::vector<Token> &tokens, size_t pos, bool &has_comma)
+{
+  int depth = 0;
+  has_comma = false;
+  for (size_t i = pos; i < tokens.size(); i++) {
+    if (tokens[i].type != TokenType::SYMBOL) {
+      continue;
+    }
+    if (tokens[i].text == "(") {
+      depth++;
+    } else if (tokens[i].text == ")") {
+      if (--depth == 0) {
+        return i;
+      }
+    } else if (tokens[i].text == "," && depth == 1) {
+      has_comma = true;
+    }
+  }
+  return tokens.size();
+}
+
+/// 与词法分析器中 DATE_STR 的规则相同：4位数字-1到2位数字-1到2位数字
+bool looks_like_date(const char *s)
+{
+  const int max_digits[] = {4, 2, 2};
+  for (int part = 0; part < 3; part++) {
+    int digits = 0;
+    while (isdigit(static_cast<unsigned char>(*s))) {
+      digits++;
+      s++;
+    }
+    if (digits == 0 || digits > max_digits[part] || (part == 0 && digits != 4)) {
+      return false;
+    }
+    if (*s != (part == 2 ? '\0' : '-')) {
+      return false;
+    }
+    if (part < 2) {
+      s++;
+    }
+  }
+  return true;
+}
+
+/// 按照词法分析器的规则把常量转换成值，日期无效时返回false
+bool literal_value(const Token &token, bool negative, Value &value)
+{
+  if (token.type == TokenType::NUMBER) {
+    if (token.text.find('.') != std::string::npos) {
+      const float float_value = static_cast<float>(atof(token.text.c_str()));
+      value = Value(negative ? -float_value : float_value);
+    } else {
+      const int int_value = atoi(token.text.c_str());
+      value = Value(negative ? -int_value : int_value);
+    }
+    return true;
+  }
+
+  char *tmp = common::substr(token.text.c_str(), 1, token.text.size() - 2);
+  bool valid = true;
+  if (looks_like_date(tmp)) {
+    value = Value(DATES, tmp, 4, true);
+    valid = value.get_int() > 0;
+  } else {
+    value = Value(tmp);
+  }
+  free(tmp);
+  return valid;
+}
+
+void append(std::string &normalized, const std::string &text)
+{
+  if (!normalized.empty()) {
+    normalized.push_back(' ');
+  }
+  normalized.append(text);
+}
+
+}  // namespace
+
+bool SqlNormalizer::normalize(const std::string &sql, std::string &normalized, std::vector<Value> &params)
+{
+  normalized.clear();
+  params.clear();
+
+  std::vector<Token> tokens;
+  if (!tokenize(sql, tokens) || tokens.empty() || !is_keyword(tokens.front(), {"select", "update", "delete"})) {
+    return false;
+  }
+
+  bool in_condition = false;
+  for (size_t i = 0; i < tokens.size(); i++) {
+    const Token &token = tokens[i];
+    if (is_keyword(token, {"where", "on", "set"})) {
+      in_condition = true;
+    } else if (is_keyword(token, {"group", "order", "limit", "having", "inner", "join", "from"})) {
+      in_condition = false;
+    }
+
+    // IN 后面的列表以及其它带逗号的括号中是常量列表，原样保留
+    bool has_comma = false;
+    const bool list_follows = is_keyword(token, {"in", "exists"}) && i + 1 < tokens.size() &&
+                              tokens[i + 1].type == TokenType::SYMBOL && tokens[i + 1].text == "(";
+    const bool is_list = token.type == TokenType::SYMBOL && token.text == "(" &&
+                         matching_brace(tokens, i, has_comma) < tokens.size() && has_comma;
+    if (list_follows || is_list) {
+      const size_t begin = list_follows ? i + 1 : i;
+      const size_t end = matching_brace(tokens, begin, has_comma);
+      if (end == tokens.size()) {
+        return false;
+      }
+      append(normalized, token.text);
+      for (size_t j = i + 1; j <= end; j++) {
+        append(normalized, tokens[j].text);
+      }
+      i = end;
+      continue;
+    }
+
+    const bool negative = in_condition && is_unary_minus(tokens, i);
+    const size_t literal_pos = negative ? i + 1 : i;
+    const Token &literal = tokens[literal_pos];
+    const bool is_literal = literal.type == TokenType::NUMBER || literal.type == TokenType::STRING;
+    const bool in_arithmetic = (i > 0 && is_arithmetic(tokens[i - 1])) ||
+                               (literal_pos + 1 < tokens.size() && is_arithmetic(tokens[literal_pos + 1]));
+    if (!in_condition || !is_literal || in_arithmetic) {
+      append(normalized, token.text);
+      continue;
+    }
+
+    Value value;
+    if (!literal_value(literal, negative, value)) {
+      return false;
+    }
+    params.push_back(value);
+    append(normalized, "?");
+    i = literal_pos;
+  }
+  return true;
+}
@@ -87,6 +87,7 @@
 #include "include/query_engine/structor/expression/field_expression.h"
 #include "include/query_engine/structor/expression/value_expression.h"
 #include "include/query_engine/structor/expression/attribute_expression.h"
+#include "include/query_engine/structor/expression/param_expression.h"
 
 using namespace std;
 
@@ -116,8 +117,26 @@ ArithmeticExpr *create_arithmetic_expression(ArithmeticExpr::Type type,
   return expr;
 }
 
+/**
+ * @brief 把 expr BETWEEN low AND high 展开成 expr >= low AND expr <= high
+ */
+void append_between_conditions(WhereConditions *conditions, Expression *expr, Expression *low, Expression *high)
+{
+  ConditionSqlNode high_condition;
+  high_condition.left_expr = expr->copy();
+  high_condition.comp = LESS_EQUAL;
+  high_condition.right_expr = high;
+  conditions->conditions.emplace_back(high_condition);
+
+  ConditionSqlNode low_condition;
+  low_condition.left_expr = expr;
+  low_condition.comp = GREAT_EQUAL;
+  low_condition.right_expr = low;
+  conditions->conditions.emplace_back(low_condition);
+}
+
 
-#line 121 "yacc_sql.cpp"
+#line 140 "yacc_sql.cpp"
 
 # ifndef YY_CAST
 #  ifdef __cplusplus
@@ -160,129 +179,145 @@ enum yysymbol_kind_t
   YYSYMBOL_SELECT = 12,                    /* SELECT  */
   YYSYMBOL_ASC = 13,                       /* ASC  */
   YYSYMBOL_DESC = 14,                      /* DESC  */
-  YYSYMBOL_ORDER = 15,                     /* ORDER  */
-  YYSYMBOL_BY = 16,                        /* BY  */
-  YYSYMBOL_IS = 17,                        /* IS  */
-  YYSYMBOL_NULL_T = 18,                    /* NULL_T  */
-  YYSYMBOL_SHOW = 19,                      /* SHOW  */
-  YYSYMBOL_SYNC = 20,                      /* SYNC  */
-  YYSYMBOL_INSERT = 21,                    /* INSERT  */
-  YYSYMBOL_DELETE = 22,                    /* DELETE  */
-  YYSYMBOL_UPDATE = 23,                    /* UPDATE  */
-  YYSYMBOL_LBRACE = 24,                    /* LBRACE  */
-  YYSYMBOL_RBRACE = 25,                    /* RBRACE  */
-  YYSYMBOL_COMMA = 26,                     /* COMMA  */
-  YYSYMBOL_TRX_BEGIN = 27,                 /* TRX_BEGIN  */
-  YYSYMBOL_TRX_COMMIT = 28,                /* TRX_COMMIT  */
-  YYSYMBOL_TRX_ROLLBACK = 29,              /* TRX_ROLLBACK  */
-  YYSYMBOL_INT_T = 30,                     /* INT_T  */
-  YYSYMBOL_STRING_T = 31,                  /* STRING_T  */
-  YYSYMBOL_FLOAT_T = 32,                   /* FLOAT_T  */
-  YYSYMBOL_DATE_T = 33,                    /* DATE_T  */
-  YYSYMBOL_TEXT_T = 34,                    /* TEXT_T  */
-  YYSYMBOL_NOT_T = 35,                     /* NOT_T  */
-  YYSYMBOL_LIKE_T = 36,                    /* LIKE_T  */
-  YYSYMBOL_COUNT_T = 37,                   /* COUNT_T  */
-  YYSYMBOL_MIN_T = 38,                     /* MIN_T  */
-  YYSYMBOL_MAX_T = 39,                     /* MAX_T  */
-  YYSYMBOL_AVG_T = 40,                     /* AVG_T  */
-  YYSYMBOL_SUM_T = 41,                     /* SUM_T  */
-  YYSYMBOL_HELP = 42,                      /* HELP  */
-  YYSYMBOL_EXIT = 43,                      /* EXIT  */
-  YYSYMBOL_DOT = 44,                       /* DOT  */
-  YYSYMBOL_INTO = 45,                      /* INTO  */
-  YYSYMBOL_VALUES = 46,                    /* VALUES  */
-  YYSYMBOL_FROM = 47,                      /* FROM  */
-  YYSYMBOL_WHERE = 48,                     /* WHERE  */
-  YYSYMBOL_AND = 49,                       /* AND  */
-  YYSYMBOL_OR = 50,                        /* OR  */
-  YYSYMBOL_SET = 51,                       /* SET  */
-  YYSYMBOL_INNER = 52,                     /* INNER  */
-  YYSYMBOL_JOIN = 53,                      /* JOIN  */
-  YYSYMBOL_ON = 54,                        /* ON  */
-  YYSYMBOL_LOAD = 55,                      /* LOAD  */
-  YYSYMBOL_DATA = 56,                      /* DATA  */
-  YYSYMBOL_INFILE = 57,                    /* INFILE  */
-  YYSYMBOL_EXPLAIN = 58,                   /* EXPLAIN  */
-  YYSYMBOL_GROUP = 59,                     /* GROUP  */
-  YYSYMBOL_HAVING = 60,                    /* HAVING  */
-  YYSYMBOL_AS = 61,                        /* AS  */
-  YYSYMBOL_IN_T = 62,                      /* IN_T  */
-  YYSYMBOL_EXISTS_T = 63,                  /* EXISTS_T  */
-  YYSYMBOL_EQ = 64,                        /* EQ  */
-  YYSYMBOL_LT = 65,                        /* LT  */
-  YYSYMBOL_GT = 66,                        /* GT  */
-  YYSYMBOL_LE = 67,                        /* LE  */
-  YYSYMBOL_GE = 68,                        /* GE  */
-  YYSYMBOL_NE = 69,                        /* NE  */
-  YYSYMBOL_NUMBER = 70,                    /* NUMBER  */
-  YYSYMBOL_FLOAT = 71,                     /* FLOAT  */
-  YYSYMBOL_ID = 72,                        /* ID  */
-  YYSYMBOL_SSS = 73,                       /* SSS  */
-  YYSYMBOL_DATE_STR = 74,                  /* DATE_STR  */
-  YYSYMBOL_75_ = 75,                       /* '+'  */
-  YYSYMBOL_76_ = 76,                       /* '-'  */
-  YYSYMBOL_77_ = 77,                       /* '*'  */
-  YYSYMBOL_78_ = 78,                       /* '/'  */
-  YYSYMBOL_YYACCEPT = 79,                  /* $accept  */
-  YYSYMBOL_commands = 80,                  /* commands  */
-  YYSYMBOL_command_wrapper = 81,           /* command_wrapper  */
-  YYSYMBOL_exit_stmt = 82,                 /* exit_stmt  */
-  YYSYMBOL_help_stmt = 83,                 /* help_stmt  */
-  YYSYMBOL_sync_stmt = 84,                 /* sync_stmt  */
-  YYSYMBOL_begin_stmt = 85,                /* begin_stmt  */
-  YYSYMBOL_commit_stmt = 86,               /* commit_stmt  */
-  YYSYMBOL_rollback_stmt = 87,             /* rollback_stmt  */
-  YYSYMBOL_drop_table_stmt = 88,           /* drop_table_stmt  */
-  YYSYMBOL_show_tables_stmt = 89,          /* show_tables_stmt  */
-  YYSYMBOL_desc_table_stmt = 90,           /* desc_table_stmt  */
-  YYSYMBOL_create_index_stmt = 91,         /* create_index_stmt  */
-  YYSYMBOL_multi_attribute_names = 92,     /* multi_attribute_names  */
-  YYSYMBOL_drop_index_stmt = 93,           /* drop_index_stmt  */
-  YYSYMBOL_create_table_stmt = 94,         /* create_table_stmt  */
-  YYSYMBOL_create_view_stmt = 95,          /* create_view_stmt  */
-  YYSYMBOL_attr_def_list = 96,             /* attr_def_list  */
-  YYSYMBOL_attr_def = 97,                  /* attr_def  */
-  YYSYMBOL_number = 98,                    /* number  */
-  YYSYMBOL_type = 99,                      /* type  */
-  YYSYMBOL_aggr_type = 100,                /* aggr_type  */
-  YYSYMBOL_insert_stmt = 101,              /* insert_stmt  */
-  YYSYMBOL_multi_value_list = 102,         /* multi_value_list  */
-  YYSYMBOL_value_list = 103,               /* value_list  */
-  YYSYMBOL_value_list_body = 104,          /* value_list_body  */
-  YYSYMBOL_value = 105,                    /* value  */
-  YYSYMBOL_delete_stmt = 106,              /* delete_stmt  */
-  YYSYMBOL_update_stmt = 107,              /* update_stmt  */
-  YYSYMBOL_update_def_list = 108,          /* update_def_list  */
-  YYSYMBOL_update_def = 109,               /* update_def  */
-  YYSYMBOL_select_stmt = 110,              /* select_stmt  */
-  YYSYMBOL_opt_group_by = 111,             /* opt_group_by  */
-  YYSYMBOL_opt_having = 112,               /* opt_having  */
-  YYSYMBOL_opt_order_by = 113,             /* opt_order_by  */
-  YYSYMBOL_sort_def_list = 114,            /* sort_def_list  */
-  YYSYMBOL_sort_def = 115,                 /* sort_def  */
-  YYSYMBOL_calc_stmt = 116,                /* calc_stmt  */
-  YYSYMBOL_aggr_expr = 117,                /* aggr_expr  */
-  YYSYMBOL_base_expr = 118,                /* base_expr  */
-  YYSYMBOL_mul_expr = 119,                 /* mul_expr  */
-  YYSYMBOL_add_expr = 120,                 /* add_expr  */
-  YYSYMBOL_select_attr = 121,              /* select_attr  */
-  YYSYMBOL_expression_list = 122,          /* expression_list  */
-  YYSYMBOL_rel_attr = 123,                 /* rel_attr  */
-  YYSYMBOL_rel_attr_list = 124,            /* rel_attr_list  */
-  YYSYMBOL_relation_list = 125,            /* relation_list  */
-  YYSYMBOL_rel_list = 126,                 /* rel_list  */
-  YYSYMBOL_rel_alias = 127,                /* rel_alias  */
-  YYSYMBOL_join_list = 128,                /* join_list  */
-  YYSYMBOL_join_conditions = 129,          /* join_conditions  */
-  YYSYMBOL_where_conditions = 130,         /* where_conditions  */
-  YYSYMBOL_condition_list = 131,           /* condition_list  */
-  YYSYMBOL_condition = 132,                /* condition  */
-  YYSYMBOL_comp_op = 133,                  /* comp_op  */
-  YYSYMBOL_load_data_stmt = 134,           /* load_data_stmt  */
-  YYSYMBOL_explain_stmt = 135,             /* explain_stmt  */
-  YYSYMBOL_set_variable_stmt = 136,        /* set_variable_stmt  */
-  YYSYMBOL_opt_semicolon = 137             /* opt_semicolon  */
+  YYSYMBOL_ANALYZE = 15,                   /* ANALYZE  */
+  YYSYMBOL_PREPARE = 16,                   /* PREPARE  */
+  YYSYMBOL_EXECUTE = 17,                   /* EXECUTE  */
+  YYSYMBOL_DEALLOCATE = 18,                /* DEALLOCATE  */
+  YYSYMBOL_USING = 19,                     /* USING  */
+  YYSYMBOL_RESET = 20,                     /* RESET  */
+  YYSYMBOL_ORDER = 21,                     /* ORDER  */
+  YYSYMBOL_BY = 22,                        /* BY  */
+  YYSYMBOL_IS = 23,                        /* IS  */
+  YYSYMBOL_NULL_T = 24,                    /* NULL_T  */
+  YYSYMBOL_SHOW = 25,                      /* SHOW  */
+  YYSYMBOL_SYNC = 26,                      /* SYNC  */
+  YYSYMBOL_INSERT = 27,                    /* INSERT  */
+  YYSYMBOL_DELETE = 28,                    /* DELETE  */
+  YYSYMBOL_UPDATE = 29,                    /* UPDATE  */
+  YYSYMBOL_LBRACE = 30,                    /* LBRACE  */
+  YYSYMBOL_RBRACE = 31,                    /* RBRACE  */
+  YYSYMBOL_COMMA = 32,                     /* COMMA  */
+  YYSYMBOL_TRX_BEGIN = 33,                 /* TRX_BEGIN  */
+  YYSYMBOL_TRX_COMMIT = 34,                /* TRX_COMMIT  */
+  YYSYMBOL_TRX_ROLLBACK = 35,              /* TRX_ROLLBACK  */
+  YYSYMBOL_INT_T = 36,                     /* INT_T  */
+  YYSYMBOL_STRING_T = 37,                  /* STRING_T  */
+  YYSYMBOL_FLOAT_T = 38,                   /* FLOAT_T  */
+  YYSYMBOL_DATE_T = 39,                    /* DATE_T  */
+  YYSYMBOL_TEXT_T = 40,                    /* TEXT_T  */
+  YYSYMBOL_NOT_T = 41,                     /* NOT_T  */
+  YYSYMBOL_LIKE_T = 42,                    /* LIKE_T  */
+  YYSYMBOL_COUNT_T = 43,                   /* COUNT_T  */
+  YYSYMBOL_MIN_T = 44,                     /* MIN_T  */
+  YYSYMBOL_MAX_T = 45,                     /* MAX_T  */
+  YYSYMBOL_AVG_T = 46,                     /* AVG_T  */
+  YYSYMBOL_SUM_T = 47,                     /* SUM_T  */
+  YYSYMBOL_HELP = 48,                      /* HELP  */
+  YYSYMBOL_EXIT = 49,                      /* EXIT  */
+  YYSYMBOL_DOT = 50,                       /* DOT  */
+  YYSYMBOL_INTO = 51,                      /* INTO  */
+  YYSYMBOL_VALUES = 52,                    /* VALUES  */
+  YYSYMBOL_FROM = 53,                      /* FROM  */
+  YYSYMBOL_WHERE = 54,                     /* WHERE  */
+  YYSYMBOL_AND = 55,                       /* AND  */
+  YYSYMBOL_OR = 56,                        /* OR  */
+  YYSYMBOL_SET = 57,                       /* SET  */
+  YYSYMBOL_INNER = 58,                     /* INNER  */
+  YYSYMBOL_JOIN = 59,                      /* JOIN  */
+  YYSYMBOL_ON = 60,                        /* ON  */
+  YYSYMBOL_LOAD = 61,                      /* LOAD  */
+  YYSYMBOL_DATA = 62,                      /* DATA  */
+  YYSYMBOL_INFILE = 63,                    /* INFILE  */
+  YYSYMBOL_EXPLAIN = 64,                   /* EXPLAIN  */
+  YYSYMBOL_GROUP = 65,                     /* GROUP  */
+  YYSYMBOL_HAVING = 66,                    /* HAVING  */
+  YYSYMBOL_LIMIT = 67,                     /* LIMIT  */
+  YYSYMBOL_OFFSET = 68,                    /* OFFSET  */
+  YYSYMBOL_BETWEEN = 69,                   /* BETWEEN  */
+  YYSYMBOL_AS = 70,                        /* AS  */
+  YYSYMBOL_IN_T = 71,                      /* IN_T  */
+  YYSYMBOL_EXISTS_T = 72,                  /* EXISTS_T  */
+  YYSYMBOL_EQ = 73,                        /* EQ  */
+  YYSYMBOL_LT = 74,                        /* LT  */
+  YYSYMBOL_GT = 75,                        /* GT  */
+  YYSYMBOL_LE = 76,                        /* LE  */
+  YYSYMBOL_GE = 77,                        /* GE  */
+  YYSYMBOL_NE = 78,                        /* NE  */
+  YYSYMBOL_NUMBER = 79,                    /* NUMBER  */
+  YYSYMBOL_FLOAT = 80,                     /* FLOAT  */
+  YYSYMBOL_ID = 81,                        /* ID  */
+  YYSYMBOL_SSS = 82,                       /* SSS  */
+  YYSYMBOL_DATE_STR = 83,                  /* DATE_STR  */
+  YYSYMBOL_84_ = 84,                       /* '+'  */
+  YYSYMBOL_85_ = 85,                       /* '-'  */
+  YYSYMBOL_86_ = 86,                       /* '*'  */
+  YYSYMBOL_87_ = 87,                       /* '/'  */
+  YYSYMBOL_88_ = 88,                       /* '?'  */
+  YYSYMBOL_YYACCEPT = 89,                  /* $accept  */
+  YYSYMBOL_commands = 90,                  /* commands  */
+  YYSYMBOL_command_wrapper = 91,           /* command_wrapper  */
+  YYSYMBOL_exit_stmt = 92,                 /* exit_stmt  */
+  YYSYMBOL_help_stmt = 93,                 /* help_stmt  */
+  YYSYMBOL_sync_stmt = 94,                 /* sync_stmt  */
+  YYSYMBOL_begin_stmt = 95,                /* begin_stmt  */
+  YYSYMBOL_commit_stmt = 96,               /* commit_stmt  */
+  YYSYMBOL_rollback_stmt = 97,             /* rollback_stmt  */
+  YYSYMBOL_drop_table_stmt = 98,           /* drop_table_stmt  */
+  YYSYMBOL_show_tables_stmt = 99,          /* show_tables_stmt  */
+  YYSYMBOL_desc_table_stmt = 100,          /* desc_table_stmt  */
+  YYSYMBOL_analyze_stmt = 101,             /* analyze_stmt  */
+  YYSYMBOL_create_index_stmt = 102,        /* create_index_stmt  */
+  YYSYMBOL_multi_attribute_names = 103,    /* multi_attribute_names  */
+  YYSYMBOL_drop_index_stmt = 104,          /* drop_index_stmt  */
+  YYSYMBOL_create_table_stmt = 105,        /* create_table_stmt  */
+  YYSYMBOL_create_view_stmt = 106,         /* create_view_stmt  */
+  YYSYMBOL_attr_def_list = 107,            /* attr_def_list  */
+  YYSYMBOL_attr_def = 108,                 /* attr_def  */
+  YYSYMBOL_number = 109,                   /* number  */
+  YYSYMBOL_type = 110,                     /* type  */
+  YYSYMBOL_aggr_type = 111,                /* aggr_type  */
+  YYSYMBOL_insert_stmt = 112,              /* insert_stmt  */
+  YYSYMBOL_multi_value_list = 113,         /* multi_value_list  */
+  YYSYMBOL_value_list = 114,               /* value_list  */
+  YYSYMBOL_value_list_body = 115,          /* value_list_body  */
+  YYSYMBOL_value = 116,                    /* value  */
+  YYSYMBOL_delete_stmt = 117,              /* delete_stmt  */
+  YYSYMBOL_update_stmt = 118,              /* update_stmt  */
+  YYSYMBOL_update_def_list = 119,          /* update_def_list  */
+  YYSYMBOL_update_def = 120,               /* update_def  */
+  YYSYMBOL_select_stmt = 121,              /* select_stmt  */
+  YYSYMBOL_opt_group_by = 122,             /* opt_group_by  */
+  YYSYMBOL_opt_having = 123,               /* opt_having  */
+  YYSYMBOL_opt_order_by = 124,             /* opt_order_by  */
+  YYSYMBOL_opt_limit = 125,                /* opt_limit  */
+  YYSYMBOL_sort_def_list = 126,            /* sort_def_list  */
+  YYSYMBOL_sort_def = 127,                 /* sort_def  */
+  YYSYMBOL_calc_stmt = 128,                /* calc_stmt  */
+  YYSYMBOL_aggr_expr = 129,                /* aggr_expr  */
+  YYSYMBOL_base_expr = 130,                /* base_expr  */
+  YYSYMBOL_mul_expr = 131,                 /* mul_expr  */
+  YYSYMBOL_add_expr = 132,                 /* add_expr  */
+  YYSYMBOL_select_attr = 133,              /* select_attr  */
+  YYSYMBOL_expression_list = 134,          /* expression_list  */
+  YYSYMBOL_rel_attr = 135,                 /* rel_attr  */
+  YYSYMBOL_rel_attr_list = 136,            /* rel_attr_list  */
+  YYSYMBOL_relation_list = 137,            /* relation_list  */
+  YYSYMBOL_rel_list = 138,                 /* rel_list  */
+  YYSYMBOL_rel_alias = 139,                /* rel_alias  */
+  YYSYMBOL_join_list = 140,                /* join_list  */
+  YYSYMBOL_join_conditions = 141,          /* join_conditions  */
+  YYSYMBOL_where_conditions = 142,         /* where_conditions  */
+  YYSYMBOL_condition_list = 143,           /* condition_list  */
+  YYSYMBOL_condition = 144,                /* condition  */
+  YYSYMBOL_comp_op = 145,                  /* comp_op  */
+  YYSYMBOL_load_data_stmt = 146,           /* load_data_stmt  */
+  YYSYMBOL_explain_stmt = 147,             /* explain_stmt  */
+  YYSYMBOL_set_variable_stmt = 148,        /* set_variable_stmt  */
+  YYSYMBOL_prepare_stmt = 149,             /* prepare_stmt  */
+  YYSYMBOL_execute_stmt = 150,             /* execute_stmt  */
+  YYSYMBOL_deallocate_stmt = 151,          /* deallocate_stmt  */
+  YYSYMBOL_reset_session_stmt = 152,       /* reset_session_stmt  */
+  YYSYMBOL_opt_semicolon = 153             /* opt_semicolon  */
 };
 typedef enum yysymbol_kind_t yysymbol_kind_t;
 
@@ -611,21 +646,21 @@ union yyalloc
 #endif /* !YYCOPY_NEEDED */
 
 /* YYFINAL -- State number of the termination state.  */
-#define YYFINAL  80
+#define YYFINAL  97
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   321
+#define YYLAST   367
 
 /* YYNTOKENS -- Number of terminals.  */
-#define YYNTOKENS  79
+#define YYNTOKENS  89
 /* YYNNTS -- Number of nonterminals.  */
-#define YYNNTS  59
+#define YYNNTS  65
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  156
+#define YYNRULES  179
 /* YYNSTATES -- Number of states.  */
-#define YYNSTATES  294
+#define YYNSTATES  337
 
 /* YYMAXUTOK -- Last valid token kind.  */
-#define YYMAXUTOK   329
+#define YYMAXUTOK   338
 
 
 /* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
@@ -643,9 +678,9 @@ static const yytype_int8 yytranslate[] =
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,    77,    75,     2,    76,     2,    78,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,    86,    84,     2,    85,     2,    87,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,    88,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -671,29 +706,32 @@ static const yytype_int8 yytranslate[] =
       35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
       45,    46,    47,    48,    49,    50,    51,    52,    53,    54,
       55,    56,    57,    58,    59,    60,    61,    62,    63,    64,
-      65,    66,    67,    68,    69,    70,    71,    72,    73,    74
+      65,    66,    67,    68,    69,    70,    71,    72,    73,    74,
+      75,    76,    77,    78,    79,    80,    81,    82,    83
 };
 
 #if YYDEBUG
 /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
 static const yytype_int16 yyrline[] =
 {
-       0,   232,   232,   240,   241,   242,   243,   244,   245,   246,
-     247,   248,   249,   250,   251,   252,   253,   254,   255,   256,
-     257,   258,   259,   260,   264,   270,   275,   281,   287,   293,
-     299,   306,   312,   320,   336,   356,   359,   371,   382,   401,
-     408,   419,   422,   435,   444,   453,   462,   471,   480,   492,
-     496,   497,   498,   499,   500,   505,   506,   507,   508,   509,
-     513,   529,   532,   545,   560,   563,   576,   579,   582,   585,
-     588,   592,   596,   604,   617,   639,   642,   655,   665,   707,
-     710,   715,   718,   725,   728,   735,   740,   752,   758,   765,
-     774,   784,   790,   793,   804,   808,   812,   815,   818,   829,
-     831,   833,   835,   841,   843,   845,   851,   862,   873,   880,
-     893,   895,   905,   916,   923,   932,   941,   955,   960,   970,
-     974,   985,   997,   999,  1011,  1016,  1022,  1033,  1036,  1057,
-    1060,  1068,  1071,  1077,  1079,  1083,  1088,  1098,  1103,  1109,
-    1113,  1118,  1124,  1129,  1137,  1138,  1139,  1140,  1141,  1142,
-    1143,  1144,  1148,  1161,  1169,  1179,  1180
+       0,   267,   267,   275,   276,   277,   278,   279,   280,   281,
+     282,   283,   284,   285,   286,   287,   288,   289,   290,   291,
+     292,   293,   294,   295,   296,   297,   298,   299,   300,   304,
+     310,   315,   321,   327,   333,   339,   346,   352,   360,   365,
+     371,   387,   405,   421,   443,   446,   458,   469,   488,   495,
+     506,   509,   522,   531,   540,   549,   558,   567,   579,   583,
+     584,   585,   586,   587,   592,   593,   594,   595,   596,   600,
+     616,   619,   632,   647,   650,   663,   666,   669,   672,   675,
+     679,   683,   691,   704,   726,   729,   742,   752,   798,   801,
+     806,   809,   816,   819,   827,   830,   835,   841,   851,   856,
+     868,   874,   881,   890,   900,   906,   909,   920,   924,   927,
+     931,   934,   937,   948,   950,   952,   954,   960,   962,   964,
+     970,   981,   992,   999,  1012,  1014,  1024,  1035,  1042,  1051,
+    1060,  1074,  1079,  1089,  1093,  1104,  1116,  1118,  1130,  1135,
+    1141,  1152,  1155,  1176,  1179,  1187,  1190,  1196,  1198,  1202,
+    1207,  1224,  1228,  1233,  1244,  1249,  1255,  1259,  1264,  1270,
+    1275,  1283,  1284,  1285,  1286,  1287,  1288,  1289,  1290,  1294,
+    1307,  1315,  1326,  1339,  1345,  1361,  1367,  1376,  1389,  1390
 };
 #endif
 
@@ -711,28 +749,31 @@ static const char *const yytname[] =
 {
   "\"end of file\"", "error", "\"invalid token\"", "SEMICOLON", "CREATE",
   "DROP", "VIEW", "TABLE", "TABLES", "INDEX", "UNIQUE", "CALC", "SELECT",
-  "ASC", "DESC", "ORDER", "BY", "IS", "NULL_T", "SHOW", "SYNC", "INSERT",
+  "ASC", "DESC", "ANALYZE", "PREPARE", "EXECUTE", "DEALLOCATE", "USING",
+  "RESET", "ORDER", "BY", "IS", "NULL_T", "SHOW", "SYNC", "INSERT",
   "DELETE", "UPDATE", "LBRACE", "RBRACE", "COMMA", "TRX_BEGIN",
   "TRX_COMMIT", "TRX_ROLLBACK", "INT_T", "STRING_T", "FLOAT_T", "DATE_T",
   "TEXT_T", "NOT_T", "LIKE_T", "COUNT_T", "MIN_T", "MAX_T", "AVG_T",
   "SUM_T", "HELP", "EXIT", "DOT", "INTO", "VALUES", "FROM", "WHERE", "AND",
   "OR", "SET", "INNER", "JOIN", "ON", "LOAD", "DATA", "INFILE", "EXPLAIN",
-  "GROUP", "HAVING", "AS", "IN_T", "EXISTS_T", "EQ", "LT", "GT", "LE",
-  "GE", "NE", "NUMBER", "FLOAT", "ID", "SSS", "DATE_STR", "'+'", "'-'",
-  "'*'", "'/'", "$accept", "commands", "command_wrapper", "exit_stmt",
-  "help_stmt", "sync_stmt", "begin_stmt", "commit_stmt", "rollback_stmt",
-  "drop_table_stmt", "show_tables_stmt", "desc_table_stmt",
+  "GROUP", "HAVING", "LIMIT", "OFFSET", "BETWEEN", "AS", "IN_T",
+  "EXISTS_T", "EQ", "LT", "GT", "LE", "GE", "NE", "NUMBER", "FLOAT", "ID",
+  "SSS", "DATE_STR", "'+'", "'-'", "'*'", "'/'", "'?'", "$accept",
+  "commands", "command_wrapper", "exit_stmt", "help_stmt", "sync_stmt",
+  "begin_stmt", "commit_stmt", "rollback_stmt", "drop_table_stmt",
+  "show_tables_stmt", "desc_table_stmt", "analyze_stmt",
   "create_index_stmt", "multi_attribute_names", "drop_index_stmt",
   "create_table_stmt", "create_view_stmt", "attr_def_list", "attr_def",
   "number", "type", "aggr_type", "insert_stmt", "multi_value_list",
   "value_list", "value_list_body", "value", "delete_stmt", "update_stmt",
   "update_def_list", "update_def", "select_stmt", "opt_group_by",
-  "opt_having", "opt_order_by", "sort_def_list", "sort_def", "calc_stmt",
-  "aggr_expr", "base_expr", "mul_expr", "add_expr", "select_attr",
-  "expression_list", "rel_attr", "rel_attr_list", "relation_list",
-  "rel_list", "rel_alias", "join_list", "join_conditions",
+  "opt_having", "opt_order_by", "opt_limit", "sort_def_list", "sort_def",
+  "calc_stmt", "aggr_expr", "base_expr", "mul_expr", "add_expr",
+  "select_attr", "expression_list", "rel_attr", "rel_attr_list",
+  "relation_list", "rel_list", "rel_alias", "join_list", "join_conditions",
   "where_conditions", "condition_list", "condition", "comp_op",
-  "load_data_stmt", "explain_stmt", "set_variable_stmt", "opt_semicolon", YY_NULLPTR
+  "load_data_stmt", "explain_stmt", "set_variable_stmt", "prepare_stmt",
+  "execute_stmt", "deallocate_stmt", "reset_session_stmt", "opt_semicolon", YY_NULLPTR
 };
 
 static const char *
@@ -742,12 +783,12 @@ yysymbol_name (yysymbol_kind_t yysymbol)
 }
 #endif
 
-#define YYPACT_NINF (-249)
+#define YYPACT_NINF (-239)
 
 #define yypact_value_is_default(Yyn) \
   ((Yyn) == YYPACT_NINF)
 
-#define YYTABLE_NINF (-65)
+#define YYTABLE_NINF (-74)
 
 #define yytable_value_is_error(Yyn) \
   0
@@ -756,36 +797,40 @@ yysymbol_name (yysymbol_kind_t yysymbol)
    STATE-NUM.  */
 static const yytype_int16 yypact[] =
 {
-       6,   115,   102,    42,    42,   -56,    11,  -249,   -22,    31,
-     -30,  -249,  -249,  -249,  -249,  -249,    14,    39,     6,   101,
-     107,  -249,  -249,  -249,  -249,  -249,  -249,  -249,  -249,  -249,
-    -249,  -249,  -249,  -249,  -249,  -249,  -249,  -249,  -249,  -249,
-    -249,  -249,    45,    51,    69,   138,    82,    97,  -249,   162,
-    -249,  -249,  -249,  -249,  -249,  -249,  -249,   128,  -249,  -249,
-     188,   163,   166,  -249,  -249,  -249,  -249,    53,    24,  -249,
-    -249,   144,  -249,  -249,   120,   132,   156,   147,   151,  -249,
-    -249,  -249,  -249,   -16,   185,   159,   142,  -249,   168,   176,
-     119,    16,    21,  -249,  -249,    94,  -249,    66,  -249,   -34,
-     213,   213,   152,   162,   162,  -249,   158,   177,   191,   169,
-     145,   167,   170,   231,   172,   174,   193,   183,   184,   145,
-     223,  -249,  -249,   163,  -249,  -249,   205,   163,    -5,   232,
-     238,   240,  -249,  -249,   163,    53,    53,   -17,   214,   241,
-     244,   111,  -249,   206,   243,  -249,   226,   246,   248,  -249,
-     164,   249,   250,   204,  -249,   251,  -249,  -249,    25,  -249,
-       3,   163,  -249,  -249,  -249,  -249,  -249,   207,  -249,   225,
-     191,   158,  -249,   145,   254,   218,   162,    91,  -249,   112,
-     162,   169,   191,   275,   170,   227,  -249,  -249,  -249,  -249,
-    -249,    12,   172,   265,   219,   268,  -249,   163,   163,   163,
-    -249,  -249,   158,   234,   241,   251,   244,  -249,   162,    95,
-      19,   -23,  -249,   162,  -249,  -249,  -249,  -249,  -249,  -249,
-     162,   111,   111,    95,   243,  -249,   222,  -249,   231,  -249,
-     228,   277,   249,  -249,   270,   229,  -249,  -249,  -249,   245,
-     281,   242,  -249,   254,    95,  -249,   282,  -249,   162,    95,
-      95,  -249,  -249,  -249,  -249,  -249,  -249,   278,  -249,  -249,
-     233,   279,   270,   111,   214,   170,   111,   291,  -249,  -249,
-      95,    33,   270,  -249,   283,  -249,  -249,  -249,  -249,   293,
-    -249,  -249,   289,  -249,  -249,   170,  -249,  -249,   284,   165,
-     170,  -249,  -249,  -249
+     301,   141,    97,    75,    75,   -59,   -33,   -16,    27,    57,
+      33,    69,  -239,    72,    74,    68,  -239,  -239,  -239,  -239,
+    -239,    78,   100,   301,   137,   171,  -239,  -239,  -239,  -239,
+    -239,  -239,  -239,  -239,  -239,  -239,  -239,  -239,  -239,  -239,
+    -239,  -239,  -239,  -239,  -239,  -239,  -239,  -239,  -239,  -239,
+    -239,  -239,    98,    99,   101,   175,   104,   112,   113,  -239,
+     145,  -239,  -239,  -239,  -239,  -239,  -239,  -239,   131,  -239,
+    -239,   172,   163,  -239,   168,  -239,  -239,  -239,  -239,    30,
+       6,  -239,  -239,   147,  -239,  -239,   150,   185,   124,  -239,
+    -239,   125,   126,   151,   136,   148,  -239,  -239,  -239,  -239,
+     -18,   180,   152,   132,  -239,   160,  -239,   173,    70,   -21,
+     -31,  -239,  -239,    46,  -239,    85,  -239,   -46,   219,   219,
+     155,   145,   145,  -239,   156,   140,     3,  -239,   179,   178,
+     157,     3,   159,   164,   232,   165,   166,   188,   169,   177,
+       3,   225,  -239,  -239,   163,  -239,  -239,   209,   163,   102,
+     230,   237,   246,  -239,  -239,   163,    30,    30,   -47,   220,
+     247,  -239,   248,   251,    15,  -239,   211,   253,  -239,   235,
+     255,   257,  -239,    -8,   258,   259,   210,  -239,   248,  -239,
+    -239,    52,  -239,   -48,   163,  -239,  -239,  -239,  -239,  -239,
+     212,  -239,   233,   178,   156,  -239,  -239,     3,   263,   224,
+     145,   198,  -239,    80,   145,   157,   178,   290,   164,   238,
+    -239,  -239,  -239,  -239,  -239,    -5,   165,   272,   228,   280,
+    -239,   163,   163,   163,  -239,  -239,   156,   249,   247,   248,
+     251,  -239,   145,    58,    -4,   -27,  -239,   145,   145,  -239,
+    -239,  -239,  -239,  -239,  -239,   145,    15,    15,    58,   253,
+    -239,   239,  -239,   232,  -239,   243,   287,   258,  -239,   291,
+     244,  -239,  -239,  -239,   264,   309,   266,  -239,   263,    58,
+    -239,   313,  -239,   145,   -38,    58,    58,  -239,  -239,  -239,
+    -239,  -239,  -239,   302,  -239,  -239,   260,   307,   291,    15,
+     220,   164,    15,   318,  -239,  -239,    58,   145,     0,   291,
+     321,   311,  -239,  -239,  -239,  -239,   322,   276,    55,  -239,
+     323,  -239,   265,   326,   164,   269,  -239,    15,    15,  -239,
+    -239,   270,  -239,   320,   139,   -19,  -239,  -239,  -239,   164,
+    -239,  -239,   274,   275,  -239,  -239,  -239
 };
 
 /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
@@ -793,58 +838,64 @@ static const yytype_int16 yypact[] =
    means the default is an error.  */
 static const yytype_uint8 yydefact[] =
 {
-       0,     0,     0,     0,     0,     0,     0,    26,     0,     0,
-       0,    27,    28,    29,    25,    24,     0,     0,     0,     0,
-     155,    23,    22,    15,    16,    17,    18,    10,    11,    12,
-      13,    14,     8,     9,     5,     7,     6,     4,     3,    19,
-      20,    21,     0,     0,     0,     0,     0,     0,    72,     0,
-      55,    56,    57,    58,    59,    66,    68,   117,    70,    71,
-       0,   110,     0,    98,    94,    97,    99,   103,   110,    90,
-      95,     0,    32,    31,     0,     0,     0,     0,     0,   153,
-       1,   156,     2,     0,     0,     0,     0,    30,     0,   117,
-      94,     0,     0,    66,    68,     0,   100,     0,   106,     0,
-       0,     0,     0,     0,     0,   108,     0,     0,   131,     0,
+       0,     0,     0,     0,     0,     0,    39,     0,     0,     0,
+       0,     0,    31,     0,     0,     0,    32,    33,    34,    30,
+      29,     0,     0,     0,     0,   178,    28,    27,    16,    17,
+      18,    19,    10,    11,    12,    13,    14,    15,     8,     9,
+       5,     7,     6,     4,     3,    20,    21,    22,    23,    24,
+      25,    26,     0,     0,     0,     0,     0,     0,     0,    81,
+       0,    64,    65,    66,    67,    68,    75,    77,   131,    79,
+      80,     0,   124,   108,     0,   112,   107,   111,   113,   117,
+     124,   103,   109,     0,    37,    38,     0,   173,     0,   177,
+      36,     0,     0,     0,     0,     0,   170,     1,   179,     2,
+       0,     0,     0,     0,    35,     0,   176,   131,   107,     0,
+       0,    75,    77,     0,   114,     0,   120,     0,     0,     0,
+       0,     0,     0,   122,     0,     0,     0,   175,     0,   145,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,    96,   118,   110,    67,    69,   117,   110,   110,     0,
-       0,     0,   101,   102,   110,   104,   105,   124,   127,   122,
-       0,   133,    73,     0,    75,   154,     0,   119,     0,    39,
-       0,    41,     0,     0,    37,    64,    63,   107,     0,   111,
-       0,   110,   113,    93,    91,    92,   109,     0,   125,     0,
-     131,     0,   121,     0,    61,     0,     0,     0,   132,   134,
-       0,     0,   131,     0,     0,     0,    50,    51,    52,    53,
-      54,    44,     0,     0,     0,     0,    65,   110,   110,   110,
-     114,   126,     0,    79,   122,    64,     0,    60,     0,   142,
-       0,     0,   150,     0,   144,   145,   146,   147,   148,   149,
-       0,   133,   133,    77,    75,    74,     0,   120,     0,    48,
-       0,     0,    41,    38,    35,     0,   112,   116,   115,   129,
-       0,    81,   123,    61,   143,   138,     0,   151,     0,   140,
-     137,   135,   136,    76,   152,    40,    49,     0,    46,    42,
-       0,     0,    35,   133,   127,     0,   133,    83,    62,   139,
-     141,    43,    35,    34,     0,   130,   128,    80,    82,     0,
-      78,    47,     0,    36,    33,     0,    45,    84,    85,    87,
-       0,    89,    88,    86
+       0,     0,   110,   132,   124,    76,    78,   131,   124,   124,
+       0,     0,     0,   115,   116,   124,   118,   119,   138,   141,
+     136,   172,    73,     0,   147,    82,     0,    84,   171,     0,
+     133,     0,    48,     0,    50,     0,     0,    46,    73,    72,
+     121,     0,   125,     0,   124,   127,   106,   104,   105,   123,
+       0,   139,     0,   145,     0,   135,   174,     0,    70,     0,
+       0,     0,   146,   148,     0,     0,   145,     0,     0,     0,
+      59,    60,    61,    62,    63,    53,     0,     0,     0,     0,
+      74,   124,   124,   124,   128,   140,     0,    88,   136,    73,
+       0,    69,     0,   159,     0,     0,   167,     0,     0,   161,
+     162,   163,   164,   165,   166,     0,   147,   147,    86,    84,
+      83,     0,   134,     0,    57,     0,     0,    50,    47,    44,
+       0,   126,   130,   129,   143,     0,    90,   137,    70,   160,
+     155,     0,   168,     0,     0,   157,   154,   149,   150,    85,
+     169,    49,    58,     0,    55,    51,     0,     0,    44,   147,
+     141,     0,   147,    92,    71,   156,   158,     0,    52,    44,
+      42,     0,   144,   142,    89,    91,     0,    94,   151,    56,
+       0,    45,     0,    40,     0,     0,    87,   147,   147,    54,
+      43,     0,    93,    98,   100,    95,   152,   153,    41,     0,
+     102,   101,     0,     0,    99,    97,    96
 };
 
 /* YYPGOTO[NTERM-NUM].  */
 static const yytype_int16 yypgoto[] =
 {
-    -249,  -249,   294,  -249,  -249,  -249,  -249,  -249,  -249,  -249,
-    -249,  -249,  -249,  -248,  -249,  -249,  -249,    79,   121,  -249,
-    -249,  -249,  -249,    71,  -134,   160,   -45,  -249,  -249,    92,
-     136,  -108,  -249,  -249,  -249,    28,  -249,  -249,  -249,   -48,
-      72,    -3,   315,   -65,   -97,  -177,  -249,   116,  -162,    57,
-    -249,   -93,  -190,  -249,  -249,  -249,  -249,  -249,  -249
+    -239,  -239,   332,  -239,  -239,  -239,  -239,  -239,  -239,  -239,
+    -239,  -239,  -239,  -239,  -207,  -239,  -239,  -239,   103,   143,
+    -239,  -239,  -239,  -239,    88,  -156,  -136,   -56,  -239,  -239,
+     108,   158,  -129,  -239,  -239,  -239,  -239,    32,  -239,  -239,
+    -239,   -50,    56,    -3,   360,   -77,  -115,  -202,  -239,   138,
+    -183,    77,  -239,  -140,  -238,  -239,  -239,  -239,  -239,  -239,
+    -239,  -239,  -239,  -239,  -239
 };
 
 /* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_int16 yydefgoto[] =
 {
-       0,    19,    20,    21,    22,    23,    24,    25,    26,    27,
-      28,    29,    30,   261,    31,    32,    33,   193,   151,   257,
-     191,    62,    34,   207,    63,   120,    64,    35,    36,   182,
-     144,    37,   241,   267,   280,   287,   288,    38,    65,    66,
-      67,   177,    69,    98,    70,   148,   138,   172,   139,   170,
-     264,   142,   178,   179,   220,    39,    40,    41,    82
+       0,    24,    25,    26,    27,    28,    29,    30,    31,    32,
+      33,    34,    35,    36,   287,    37,    38,    39,   217,   174,
+     283,   215,    74,    40,   231,    75,   141,    76,    41,    42,
+     206,   167,    43,   266,   293,   307,   316,   322,   323,    44,
+      77,    78,    79,   201,    81,   116,    82,   171,   159,   195,
+     160,   193,   290,   165,   202,   203,   245,    45,    46,    47,
+      48,    49,    50,    51,    99
 };
 
 /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
@@ -852,133 +903,147 @@ static const yytype_int16 yydefgoto[] =
    number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_int16 yytable[] =
 {
-      68,    68,   131,   105,    90,   149,   174,   227,   112,   204,
-       1,     2,    96,   247,   274,   147,    72,     3,     4,    73,
-       5,    97,   129,    74,   283,     6,     7,     8,     9,    10,
-     229,   251,   252,    11,    12,    13,   230,   245,    89,   248,
-     239,   121,    76,   130,   167,   113,    91,   231,    14,    15,
-      97,   281,   132,   133,   246,   168,   160,    16,   157,   198,
-      48,    17,   159,   162,    18,   145,    49,   161,   282,   166,
-     103,   104,   243,   275,   155,   199,   278,   203,    75,    50,
-      51,    52,    53,    54,    48,   102,    77,   147,   277,   225,
-      49,   103,   104,   122,   128,    78,   200,   122,   123,   103,
-     104,    80,   197,    50,    51,    52,    53,    54,   210,    46,
-      81,    47,    55,    56,    57,    58,    59,    83,    60,    61,
-     255,    42,    43,    84,    44,    45,   211,   212,   205,    48,
-     100,   101,   236,   237,   238,    49,    55,    56,   126,    58,
-      59,    85,    60,   127,   -64,   119,   175,    86,    50,    51,
-      52,    53,    54,   213,    87,   214,   215,   216,   217,   218,
-     219,   221,   222,    48,   124,   125,   103,   104,   147,    88,
-     103,   104,    92,   209,   176,   135,   136,   223,   291,   292,
-      48,    55,    56,    89,    58,    59,    49,    60,   289,    97,
-      99,   106,   107,   289,   186,   187,   188,   189,   190,    50,
-      51,    52,    53,    54,   108,   244,    48,   109,   111,   114,
-     249,   110,    49,   115,   116,    55,    56,   250,    58,    59,
-     118,    95,   117,   140,   134,    50,    51,    52,    53,    54,
-     137,    48,    55,    56,    89,    58,    59,    49,    60,   141,
-     146,   143,    89,     4,   150,   270,   152,   153,   156,   158,
-      50,    51,    52,    53,    54,   154,   122,   163,    93,    94,
-      89,    58,    59,   164,    95,   165,   169,   171,   173,   181,
-     180,   183,   184,   185,   194,   192,   195,   119,   202,   201,
-     206,   208,   226,    55,    56,    89,    58,    59,   228,    95,
-     233,   234,   235,   240,   254,   258,   260,   265,   256,   263,
-     269,   262,   266,   271,   273,   272,   279,   286,   284,   285,
-     290,   259,    79,   232,   268,   196,   253,   224,   293,    71,
-     242,   276
+      80,    80,   152,   123,   108,   172,   252,   198,   277,   278,
+     142,   228,   133,   332,   222,   272,   150,   297,   170,   254,
+     270,   114,    84,   190,   309,   255,   196,    59,   210,   211,
+     212,   213,   214,   223,   191,   107,   256,   271,   115,    59,
+     151,   310,   220,   264,   273,    60,   121,   122,    85,   333,
+     143,   302,   134,   227,   305,   144,   199,   109,    61,    62,
+      63,    64,    65,   121,   122,    86,   250,   180,   153,   154,
+     162,   182,   185,    88,   268,   168,   120,    90,   189,   326,
+     327,   301,    66,    67,   178,    69,    70,   200,   113,   304,
+     121,   122,   311,   170,    66,    67,   107,    69,    70,    59,
+      71,   -73,   140,    73,    56,    60,    57,   224,    87,    59,
+     317,   318,   149,    58,    89,    60,   118,   119,    61,    62,
+      63,    64,    65,    91,   281,   145,   146,    92,    61,    62,
+      63,    64,    65,   143,   115,   246,   247,    97,   221,   121,
+     122,   229,   121,   122,   261,   262,   263,    52,    53,    93,
+      54,    55,   330,   331,    66,    67,    68,    69,    70,    94,
+      71,    72,    95,    73,    66,    67,   147,    69,    70,    59,
+      71,   148,   183,    73,    98,    60,   170,   156,   157,   100,
+     101,   110,   102,   184,   103,   104,   121,   122,    61,    62,
+      63,    64,    65,   105,   106,   115,    59,   233,   117,   324,
+     124,   248,    60,   125,   126,   127,   128,   129,   130,   131,
+     135,   132,   136,   137,   324,    61,    62,    63,    64,    65,
+     138,   234,   161,   139,    66,    67,   107,    69,    70,   269,
+      71,   163,   164,    73,   274,   275,   155,   158,   166,   235,
+     236,   169,   276,    59,     4,   107,   173,   175,   176,    60,
+     177,   111,   112,   107,    69,    70,   179,   113,   143,   181,
+      73,   186,    61,    62,    63,    64,    65,   237,   187,   238,
+     296,   239,   240,   241,   242,   243,   244,   188,   192,   194,
+     140,   197,   121,   122,   204,   205,   207,   208,   209,   218,
+     216,   219,   226,   225,   308,   230,   232,   251,    66,    67,
+     107,    69,    70,   258,   113,     1,     2,    73,   253,   259,
+     260,   284,     3,     4,   265,     5,     6,     7,     8,     9,
+     280,    10,   282,   286,   289,   288,    11,    12,    13,    14,
+      15,   291,   292,   298,    16,    17,    18,   295,   300,   306,
+     312,   299,   313,   315,   314,   321,   320,   319,   325,    19,
+      20,   328,   329,   335,   336,    96,   294,   279,    21,   257,
+     285,   334,    22,   249,    83,    23,   267,   303
 };
 
 static const yytype_int16 yycheck[] =
 {
-       3,     4,    99,    68,    49,   113,   140,   184,    24,   171,
-       4,     5,    60,    36,   262,   112,    72,    11,    12,     8,
-      14,    26,    56,    45,   272,    19,    20,    21,    22,    23,
-      18,   221,   222,    27,    28,    29,    24,    18,    72,    62,
-     202,    25,    72,    77,    61,    61,    49,    35,    42,    43,
-      26,    18,   100,   101,    35,    72,    61,    51,   123,    56,
-      18,    55,   127,   128,    58,   110,    24,    72,    35,   134,
-      75,    76,   206,   263,   119,    72,   266,   170,    47,    37,
-      38,    39,    40,    41,    18,    61,    72,   184,   265,   182,
-      24,    75,    76,    72,    97,    56,   161,    72,    77,    75,
-      76,     0,    77,    37,    38,    39,    40,    41,    17,     7,
-       3,     9,    70,    71,    72,    73,    74,    72,    76,    77,
-     228,     6,     7,    72,     9,    10,    35,    36,   173,    18,
-      77,    78,   197,   198,   199,    24,    70,    71,    72,    73,
-      74,    72,    76,    77,    25,    26,    35,     9,    37,    38,
-      39,    40,    41,    62,    72,    64,    65,    66,    67,    68,
-      69,    49,    50,    18,    70,    71,    75,    76,   265,    72,
-      75,    76,    44,   176,    63,   103,   104,   180,    13,    14,
-      18,    70,    71,    72,    73,    74,    24,    76,   285,    26,
-      24,    47,    72,   290,    30,    31,    32,    33,    34,    37,
-      38,    39,    40,    41,    72,   208,    18,    51,    57,    24,
-     213,    64,    24,    54,    72,    70,    71,   220,    73,    74,
-      44,    76,    54,    46,    72,    37,    38,    39,    40,    41,
-      72,    18,    70,    71,    72,    73,    74,    24,    76,    48,
-      73,    72,    72,    12,    72,   248,    72,    54,    25,    44,
-      37,    38,    39,    40,    41,    72,    72,    25,    70,    71,
-      72,    73,    74,    25,    76,    25,    52,    26,    24,    26,
-      64,    45,    26,    25,    24,    26,    72,    26,    53,    72,
-      26,    63,     7,    70,    71,    72,    73,    74,    61,    76,
-      25,    72,    24,    59,    72,    18,    26,    16,    70,    54,
-      18,    72,    60,    25,    25,    72,    15,    18,    25,    16,
-      26,   232,    18,   192,   243,   155,   224,   181,   290,     4,
-     204,   264
+       3,     4,   117,    80,    60,   134,   208,   163,   246,   247,
+      31,   194,    30,    32,    62,    42,    62,    55,   133,    24,
+      24,    71,    81,    70,    24,    30,   162,    24,    36,    37,
+      38,    39,    40,    81,    81,    81,    41,    41,    32,    24,
+      86,    41,   178,   226,    71,    30,    84,    85,    81,    68,
+      81,   289,    70,   193,   292,    86,    41,    60,    43,    44,
+      45,    46,    47,    84,    85,    81,   206,   144,   118,   119,
+     126,   148,   149,    16,   230,   131,    70,     8,   155,   317,
+     318,   288,    79,    80,   140,    82,    83,    72,    85,   291,
+      84,    85,   299,   208,    79,    80,    81,    82,    83,    24,
+      85,    31,    32,    88,     7,    30,     9,   184,    81,    24,
+      55,    56,   115,    16,    81,    30,    86,    87,    43,    44,
+      45,    46,    47,    51,   253,    79,    80,    53,    43,    44,
+      45,    46,    47,    81,    32,    55,    56,     0,    86,    84,
+      85,   197,    84,    85,   221,   222,   223,     6,     7,    81,
+       9,    10,    13,    14,    79,    80,    81,    82,    83,    81,
+      85,    86,    62,    88,    79,    80,    81,    82,    83,    24,
+      85,    86,    70,    88,     3,    30,   291,   121,   122,    81,
+      81,    50,    81,    81,     9,    81,    84,    85,    43,    44,
+      45,    46,    47,    81,    81,    32,    24,   200,    30,   314,
+      53,   204,    30,    53,    19,    81,    81,    81,    57,    73,
+      30,    63,    60,    81,   329,    43,    44,    45,    46,    47,
+      60,    23,    82,    50,    79,    80,    81,    82,    83,   232,
+      85,    52,    54,    88,   237,   238,    81,    81,    81,    41,
+      42,    82,   245,    24,    12,    81,    81,    81,    60,    30,
+      81,    79,    80,    81,    82,    83,    31,    85,    81,    50,
+      88,    31,    43,    44,    45,    46,    47,    69,    31,    71,
+     273,    73,    74,    75,    76,    77,    78,    31,    58,    32,
+      32,    30,    84,    85,    73,    32,    51,    32,    31,    30,
+      32,    81,    59,    81,   297,    32,    72,     7,    79,    80,
+      81,    82,    83,    31,    85,     4,     5,    88,    70,    81,
+      30,    24,    11,    12,    65,    14,    15,    16,    17,    18,
+      81,    20,    79,    32,    60,    81,    25,    26,    27,    28,
+      29,    22,    66,    31,    33,    34,    35,    24,    31,    21,
+      19,    81,    31,    67,    22,    19,    81,    24,    79,    48,
+      49,    81,    32,    79,    79,    23,   268,   249,    57,   216,
+     257,   329,    61,   205,     4,    64,   228,   290
 };
 
 /* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
    state STATE-NUM.  */
 static const yytype_uint8 yystos[] =
 {
-       0,     4,     5,    11,    12,    14,    19,    20,    21,    22,
-      23,    27,    28,    29,    42,    43,    51,    55,    58,    80,
-      81,    82,    83,    84,    85,    86,    87,    88,    89,    90,
-      91,    93,    94,    95,   101,   106,   107,   110,   116,   134,
-     135,   136,     6,     7,     9,    10,     7,     9,    18,    24,
-      37,    38,    39,    40,    41,    70,    71,    72,    73,    74,
-      76,    77,   100,   103,   105,   117,   118,   119,   120,   121,
-     123,   121,    72,     8,    45,    47,    72,    72,    56,    81,
-       0,     3,   137,    72,    72,    72,     9,    72,    72,    72,
-     105,   120,    44,    70,    71,    76,   118,    26,   122,    24,
-      77,    78,    61,    75,    76,   122,    47,    72,    72,    51,
-      64,    57,    24,    61,    24,    54,    72,    54,    44,    26,
-     104,    25,    72,    77,    70,    71,    72,    77,   120,    56,
-      77,   123,   118,   118,    72,   119,   119,    72,   125,   127,
-      46,    48,   130,    72,   109,   105,    73,   123,   124,   110,
-      72,    97,    72,    54,    72,   105,    25,   122,    44,   122,
-      61,    72,   122,    25,    25,    25,   122,    61,    72,    52,
-     128,    26,   126,    24,   103,    35,    63,   120,   131,   132,
-      64,    26,   108,    45,    26,    25,    30,    31,    32,    33,
-      34,    99,    26,    96,    24,    72,   104,    77,    56,    72,
-     122,    72,    53,   130,   127,   105,    26,   102,    63,   120,
-      17,    35,    36,    62,    64,    65,    66,    67,    68,    69,
-     133,    49,    50,   120,   109,   130,     7,   124,    61,    18,
-      24,    35,    97,    25,    72,    24,   122,   122,   122,   127,
-      59,   111,   126,   103,   120,    18,    35,    36,    62,   120,
-     120,   131,   131,   108,    72,   110,    70,    98,    18,    96,
-      26,    92,    72,    54,   129,    16,    60,   112,   102,    18,
-     120,    25,    72,    25,    92,   131,   128,   124,   131,    15,
-     113,    18,    35,    92,    25,    16,    18,   114,   115,   123,
-      26,    13,    14,   114
+       0,     4,     5,    11,    12,    14,    15,    16,    17,    18,
+      20,    25,    26,    27,    28,    29,    33,    34,    35,    48,
+      49,    57,    61,    64,    90,    91,    92,    93,    94,    95,
+      96,    97,    98,    99,   100,   101,   102,   104,   105,   106,
+     112,   117,   118,   121,   128,   146,   147,   148,   149,   150,
+     151,   152,     6,     7,     9,    10,     7,     9,    16,    24,
+      30,    43,    44,    45,    46,    47,    79,    80,    81,    82,
+      83,    85,    86,    88,   111,   114,   116,   129,   130,   131,
+     132,   133,   135,   133,    81,    81,    81,    81,    16,    81,
+       8,    51,    53,    81,    81,    62,    91,     0,     3,   153,
+      81,    81,    81,     9,    81,    81,    81,    81,   116,   132,
+      50,    79,    80,    85,   130,    32,   134,    30,    86,    87,
+      70,    84,    85,   134,    53,    53,    19,    81,    81,    81,
+      57,    73,    63,    30,    70,    30,    60,    81,    60,    50,
+      32,   115,    31,    81,    86,    79,    80,    81,    86,   132,
+      62,    86,   135,   130,   130,    81,   131,   131,    81,   137,
+     139,    82,   116,    52,    54,   142,    81,   120,   116,    82,
+     135,   136,   121,    81,   108,    81,    60,    81,   116,    31,
+     134,    50,   134,    70,    81,   134,    31,    31,    31,   134,
+      70,    81,    58,   140,    32,   138,   115,    30,   114,    41,
+      72,   132,   143,   144,    73,    32,   119,    51,    32,    31,
+      36,    37,    38,    39,    40,   110,    32,   107,    30,    81,
+     115,    86,    62,    81,   134,    81,    59,   142,   139,   116,
+      32,   113,    72,   132,    23,    41,    42,    69,    71,    73,
+      74,    75,    76,    77,    78,   145,    55,    56,   132,   120,
+     142,     7,   136,    70,    24,    30,    41,   108,    31,    81,
+      30,   134,   134,   134,   139,    65,   122,   138,   114,   132,
+      24,    41,    42,    71,   132,   132,   132,   143,   143,   119,
+      81,   121,    79,   109,    24,   107,    32,   103,    81,    60,
+     141,    22,    66,   123,   113,    24,   132,    55,    31,    81,
+      31,   103,   143,   140,   136,   143,    21,   124,   132,    24,
+      41,   103,    19,    31,    22,    67,   125,    55,    56,    24,
+      81,    19,   126,   127,   135,    79,   143,   143,    81,    32,
+      13,    14,    32,    68,   126,    79,    79
 };
 
 /* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
 static const yytype_uint8 yyr1[] =
 {
-       0,    79,    80,    81,    81,    81,    81,    81,    81,    81,
-      81,    81,    81,    81,    81,    81,    81,    81,    81,    81,
-      81,    81,    81,    81,    82,    83,    84,    85,    86,    87,
-      88,    89,    90,    91,    91,    92,    92,    93,    94,    95,
-      95,    96,    96,    97,    97,    97,    97,    97,    97,    98,
-      99,    99,    99,    99,    99,   100,   100,   100,   100,   100,
-     101,   102,   102,   103,   104,   104,   105,   105,   105,   105,
-     105,   105,   105,   106,   107,   108,   108,   109,   110,   111,
-     111,   112,   112,   113,   113,   114,   114,   115,   115,   115,
-     116,   117,   117,   117,   118,   118,   118,   118,   118,   119,
-     119,   119,   119,   120,   120,   120,   121,   121,   121,   121,
-     122,   122,   122,   122,   122,   122,   122,   123,   123,   124,
-     124,   125,   126,   126,   127,   127,   127,   128,   128,   129,
-     129,   130,   130,   131,   131,   131,   131,   132,   132,   132,
-     132,   132,   132,   132,   133,   133,   133,   133,   133,   133,
-     133,   133,   134,   135,   136,   137,   137
+       0,    89,    90,    91,    91,    91,    91,    91,    91,    91,
+      91,    91,    91,    91,    91,    91,    91,    91,    91,    91,
+      91,    91,    91,    91,    91,    91,    91,    91,    91,    92,
+      93,    94,    95,    96,    97,    98,    99,   100,   101,   101,
+     102,   102,   102,   102,   103,   103,   104,   105,   106,   106,
+     107,   107,   108,   108,   108,   108,   108,   108,   109,   110,
+     110,   110,   110,   110,   111,   111,   111,   111,   111,   112,
+     113,   113,   114,   115,   115,   116,   116,   116,   116,   116,
+     116,   116,   117,   118,   119,   119,   120,   121,   122,   122,
+     123,   123,   124,   124,   125,   125,   125,   125,   126,   126,
+     127,   127,   127,   128,   129,   129,   129,   130,   130,   130,
+     130,   130,   130,   131,   131,   131,   131,   132,   132,   132,
+     133,   133,   133,   133,   134,   134,   134,   134,   134,   134,
+     134,   135,   135,   136,   136,   137,   138,   138,   139,   139,
+     139,   140,   140,   141,   141,   142,   142,   143,   143,   143,
+     143,   143,   143,   143,   144,   144,   144,   144,   144,   144,
+     144,   145,   145,   145,   145,   145,   145,   145,   145,   146,
+     147,   148,   149,   150,   150,   151,   151,   152,   153,   153
 };
 
 /* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
@@ -987,19 +1052,21 @@ static const yytype_int8 yyr2[] =
        0,     2,     2,     1,     1,     1,     1,     1,     1,     1,
        1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
        1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
-       3,     2,     2,    10,     9,     0,     3,     5,     7,     5,
-       8,     0,     3,     5,     2,     7,     4,     6,     3,     1,
-       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
-       6,     0,     3,     4,     0,     3,     1,     2,     1,     2,
-       1,     1,     1,     4,     6,     0,     3,     3,     9,     0,
-       3,     0,     2,     0,     3,     1,     3,     1,     2,     2,
-       2,     4,     4,     4,     1,     1,     3,     1,     1,     1,
-       2,     3,     3,     1,     3,     3,     2,     4,     2,     4,
-       0,     3,     5,     3,     4,     5,     5,     1,     3,     1,
-       3,     2,     0,     3,     1,     2,     3,     0,     5,     0,
-       2,     0,     2,     0,     1,     3,     3,     3,     3,     4,
-       3,     4,     2,     3,     1,     1,     1,     1,     1,     1,
-       1,     2,     7,     2,     4,     0,     1
+       1,     1,     1,     1,     1,     3,     2,     2,     2,     1,
+      10,    12,     9,    11,     0,     3,     5,     7,     5,     8,
+       0,     3,     5,     2,     7,     4,     6,     3,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     6,
+       0,     3,     4,     0,     3,     1,     2,     1,     2,     1,
+       1,     1,     4,     6,     0,     3,     3,    10,     0,     3,
+       0,     2,     0,     3,     0,     2,     4,     4,     1,     3,
+       1,     2,     2,     2,     4,     4,     4,     1,     1,     1,
+       3,     1,     1,     1,     2,     3,     3,     1,     3,     3,
+       2,     4,     2,     4,     0,     3,     5,     3,     4,     5,
+       5,     1,     3,     1,     3,     2,     0,     3,     1,     2,
+       3,     0,     5,     0,     2,     0,     2,     0,     1,     3,
+       3,     5,     7,     7,     3,     3,     4,     3,     4,     2,
+       3,     1,     1,     1,     1,     1,     1,     1,     2,     7,
+       2,     4,     4,     2,     5,     3,     3,     2,     0,     1
 };
 
 
@@ -1861,93 +1928,111 @@ yyreduce:
   switch (yyn)
     {
   case 2: /* commands: command_wrapper opt_semicolon  */
-#line 233 "yacc_sql.y"
+#line 268 "yacc_sql.y"
   {
     std::unique_ptr<ParsedSqlNode> sql_node = std::unique_ptr<ParsedSqlNode>((yyvsp[-1].sql_node));
     sql_result->add_sql_node(std::move(sql_node));
   }
-#line 1870 "yacc_sql.cpp"
+#line 1937 "yacc_sql.cpp"
     break;
 
-  case 24: /* exit_stmt: EXIT  */
-#line 264 "yacc_sql.y"
+  case 29: /* exit_stmt: EXIT  */
+#line 304 "yacc_sql.y"
          {
       (void)yynerrs;  // 这么写为了消除yynerrs未使用的告警。如果你有更好的方法欢迎提PR
       (yyval.sql_node) = new ParsedSqlNode(SCF_EXIT);
     }
-#line 1879 "yacc_sql.cpp"
+#line 1946 "yacc_sql.cpp"
     break;
 
-  case 25: /* help_stmt: HELP  */
-#line 270 "yacc_sql.y"
+  case 30: /* help_stmt: HELP  */
+#line 310 "yacc_sql.y"
          {
       (yyval.sql_node) = new ParsedSqlNode(SCF_HELP);
     }
-#line 1887 "yacc_sql.cpp"
+#line 1954 "yacc_sql.cpp"
     break;
 
-  case 26: /* sync_stmt: SYNC  */
-#line 275 "yacc_sql.y"
+  case 31: /* sync_stmt: SYNC  */
+#line 315 "yacc_sql.y"
          {
       (yyval.sql_node) = new ParsedSqlNode(SCF_SYNC);
     }
-#line 1895 "yacc_sql.cpp"
+#line 1962 "yacc_sql.cpp"
     break;
 
-  case 27: /* begin_stmt: TRX_BEGIN  */
-#line 281 "yacc_sql.y"
+  case 32: /* begin_stmt: TRX_BEGIN  */
+#line 321 "yacc_sql.y"
                {
       (yyval.sql_node) = new ParsedSqlNode(SCF_BEGIN);
     }
-#line 1903 "yacc_sql.cpp"
+#line 1970 "yacc_sql.cpp"
     break;
 
-  case 28: /* commit_stmt: TRX_COMMIT  */
-#line 287 "yacc_sql.y"
+  case 33: /* commit_stmt: TRX_COMMIT  */
+#line 327 "yacc_sql.y"
                {
       (yyval.sql_node) = new ParsedSqlNode(SCF_COMMIT);
     }
-#line 1911 "yacc_sql.cpp"
+#line 1978 "yacc_sql.cpp"
     break;
 
-  case 29: /* rollback_stmt: TRX_ROLLBACK  */
-#line 293 "yacc_sql.y"
+  case 34: /* rollback_stmt: TRX_ROLLBACK  */
+#line 333 "yacc_sql.y"
                   {
       (yyval.sql_node) = new ParsedSqlNode(SCF_ROLLBACK);
     }
-#line 1919 "yacc_sql.cpp"
+#line 1986 "yacc_sql.cpp"
     break;
 
-  case 30: /* drop_table_stmt: DROP TABLE ID  */
-#line 299 "yacc_sql.y"
+  case 35: /* drop_table_stmt: DROP TABLE ID  */
+#line 339 "yacc_sql.y"
                   {
       (yyval.sql_node) = new ParsedSqlNode(SCF_DROP_TABLE);
       (yyval.sql_node)->drop_table.relation_name = (yyvsp[0].string);
       free((yyvsp[0].string));
     }
-#line 1929 "yacc_sql.cpp"
+#line 1996 "yacc_sql.cpp"
     break;
 
-  case 31: /* show_tables_stmt: SHOW TABLES  */
-#line 306 "yacc_sql.y"
+  case 36: /* show_tables_stmt: SHOW TABLES  */
+#line 346 "yacc_sql.y"
                 {
       (yyval.sql_node) = new ParsedSqlNode(SCF_SHOW_TABLES);
     }
-#line 1937 "yacc_sql.cpp"
+#line 2004 "yacc_sql.cpp"
     break;
 
-  case 32: /* desc_table_stmt: DESC ID  */
-#line 312 "yacc_sql.y"
+  case 37: /* desc_table_stmt: DESC ID  */
+#line 352 "yacc_sql.y"
              {
 	(yyval.sql_node) = new ParsedSqlNode(SCF_DESC_TABLE);
 	(yyval.sql_node)->desc_table.relation_name = (yyvsp[0].string);
 	free((yyvsp[0].string));
     }
-#line 1947 "yacc_sql.cpp"
+#line 2014 "yacc_sql.cpp"
     break;
 
-  case 33: /* create_index_stmt: CREATE UNIQUE INDEX ID ON ID LBRACE ID multi_attribute_names RBRACE  */
-#line 321 "yacc_sql.y"
+  case 38: /* analyze_stmt: ANALYZE ID  */
+#line 360 "yacc_sql.y"
+                {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_ANALYZE_TABLE);
+      (yyval.sql_node)->analyze_table.relation_name = (yyvsp[0].string);
+      free((yyvsp[0].string));
+    }
+#line 2024 "yacc_sql.cpp"
+    break;
+
+  case 39: /* analyze_stmt: ANALYZE  */
+#line 365 "yacc_sql.y"
+               {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_ANALYZE_TABLE);
+    }
+#line 2032 "yacc_sql.cpp"
+    break;
+
+  case 40: /* create_index_stmt: CREATE UNIQUE INDEX ID ON ID LBRACE ID multi_attribute_names RBRACE  */
+#line 372 "yacc_sql.y"
   {
 	(yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_INDEX);
 	CreateIndexSqlNode &create_index = (yyval.sql_node)->create_index;
@@ -1963,11 +2048,33 @@ yyreduce:
 	free((yyvsp[-4].string));
 	free((yyvsp[-2].string));
   }
-#line 1967 "yacc_sql.cpp"
+#line 2052 "yacc_sql.cpp"
     break;
 
-  case 34: /* create_index_stmt: CREATE INDEX ID ON ID LBRACE ID multi_attribute_names RBRACE  */
-#line 337 "yacc_sql.y"
+  case 41: /* create_index_stmt: CREATE UNIQUE INDEX ID ON ID LBRACE ID multi_attribute_names RBRACE USING ID  */
+#line 388 "yacc_sql.y"
+  {
+	(yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_INDEX);
+	CreateIndexSqlNode &create_index = (yyval.sql_node)->create_index;
+	create_index.index_name = (yyvsp[-8].string);
+	create_index.relation_name = (yyvsp[-6].string);
+	create_index.is_unique_ = true;
+	create_index.index_type = (yyvsp[0].string);
+	if ((yyvsp[-3].multi_attribute_names) != nullptr) {
+	create_index.multi_attribute_names.swap(*(yyvsp[-3].multi_attribute_names));
+	}
+	create_index.multi_attribute_names.emplace_back((yyvsp[-4].string));
+	std::reverse(create_index.multi_attribute_names.begin(), create_index.multi_attribute_names.end());
+	free((yyvsp[-8].string));
+	free((yyvsp[-6].string));
+	free((yyvsp[-4].string));
+	free((yyvsp[0].string));
+  }
+#line 2074 "yacc_sql.cpp"
+    break;
+
+  case 42: /* create_index_stmt: CREATE INDEX ID ON ID LBRACE ID multi_attribute_names RBRACE  */
+#line 406 "yacc_sql.y"
   {
 	(yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_INDEX);
 	CreateIndexSqlNode &create_index = (yyval.sql_node)->create_index;
@@ -1983,19 +2090,41 @@ yyreduce:
 	free((yyvsp[-4].string));
 	free((yyvsp[-2].string));
   }
-#line 1987 "yacc_sql.cpp"
+#line 2094 "yacc_sql.cpp"
+    break;
+
+  case 43: /* create_index_stmt: CREATE INDEX ID ON ID LBRACE ID multi_attribute_names RBRACE USING ID  */
+#line 422 "yacc_sql.y"
+  {
+	(yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_INDEX);
+	CreateIndexSqlNode &create_index = (yyval.sql_node)->create_index;
+	create_index.index_name = (yyvsp[-8].string);
+	create_index.relation_name = (yyvsp[-6].string);
+	create_index.is_unique_ = false;
+	create_index.index_type = (yyvsp[0].string);
+	if ((yyvsp[-3].multi_attribute_names) != nullptr) {
+	create_index.multi_attribute_names.swap(*(yyvsp[-3].multi_attribute_names));
+	}
+	create_index.multi_attribute_names.emplace_back((yyvsp[-4].string));
+	std::reverse(create_index.multi_attribute_names.begin(), create_index.multi_attribute_names.end());
+	free((yyvsp[-8].string));
+	free((yyvsp[-6].string));
+	free((yyvsp[-4].string));
+	free((yyvsp[0].string));
+  }
+#line 2116 "yacc_sql.cpp"
     break;
 
-  case 35: /* multi_attribute_names: %empty  */
-#line 356 "yacc_sql.y"
+  case 44: /* multi_attribute_names: %empty  */
+#line 443 "yacc_sql.y"
   {
 	(yyval.multi_attribute_names) = nullptr;
   }
-#line 1995 "yacc_sql.cpp"
+#line 2124 "yacc_sql.cpp"
     break;
 
-  case 36: /* multi_attribute_names: COMMA ID multi_attribute_names  */
-#line 359 "yacc_sql.y"
+  case 45: /* multi_attribute_names: COMMA ID multi_attribute_names  */
+#line 446 "yacc_sql.y"
                                     {
 	if ((yyvsp[0].multi_attribute_names) != nullptr) {
 		(yyval.multi_attribute_names) = (yyvsp[0].multi_attribute_names);
@@ -2005,11 +2134,11 @@ yyreduce:
 	(yyval.multi_attribute_names)->emplace_back((yyvsp[-1].string));
 	free((yyvsp[-1].string));
   }
-#line 2009 "yacc_sql.cpp"
+#line 2138 "yacc_sql.cpp"
     break;
 
-  case 37: /* drop_index_stmt: DROP INDEX ID ON ID  */
-#line 372 "yacc_sql.y"
+  case 46: /* drop_index_stmt: DROP INDEX ID ON ID  */
+#line 459 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_DROP_INDEX);
       (yyval.sql_node)->drop_index.index_name = (yyvsp[-2].string);
@@ -2017,11 +2146,11 @@ yyreduce:
       free((yyvsp[-2].string));
       free((yyvsp[0].string));
     }
-#line 2021 "yacc_sql.cpp"
+#line 2150 "yacc_sql.cpp"
     break;
 
-  case 38: /* create_table_stmt: CREATE TABLE ID LBRACE attr_def attr_def_list RBRACE  */
-#line 383 "yacc_sql.y"
+  case 47: /* create_table_stmt: CREATE TABLE ID LBRACE attr_def attr_def_list RBRACE  */
+#line 470 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_TABLE);
       CreateTableSqlNode &create_table = (yyval.sql_node)->create_table;
@@ -2037,11 +2166,11 @@ yyreduce:
       std::reverse(create_table.attr_infos.begin(), create_table.attr_infos.end());
       delete (yyvsp[-2].attr_info);
     }
-#line 2041 "yacc_sql.cpp"
+#line 2170 "yacc_sql.cpp"
     break;
 
-  case 39: /* create_view_stmt: CREATE VIEW ID AS select_stmt  */
-#line 401 "yacc_sql.y"
+  case 48: /* create_view_stmt: CREATE VIEW ID AS select_stmt  */
+#line 488 "yacc_sql.y"
                                   {
       (yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_VIEW);
       CreateViewSqlNode &create_view = (yyval.sql_node)->create_view;
@@ -2050,11 +2179,11 @@ yyreduce:
       free((yyvsp[-2].string));
 
     }
-#line 2054 "yacc_sql.cpp"
+#line 2183 "yacc_sql.cpp"
     break;
 
-  case 40: /* create_view_stmt: CREATE VIEW ID LBRACE rel_attr_list RBRACE AS select_stmt  */
-#line 408 "yacc_sql.y"
+  case 49: /* create_view_stmt: CREATE VIEW ID LBRACE rel_attr_list RBRACE AS select_stmt  */
+#line 495 "yacc_sql.y"
                                                                   {
       (yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_VIEW);
       CreateViewSqlNode &create_view = (yyval.sql_node)->create_view;
@@ -2062,19 +2191,19 @@ yyreduce:
       create_view.select_sql_node = (yyvsp[0].sql_node)->selection;
       free((yyvsp[-5].string));
     }
-#line 2066 "yacc_sql.cpp"
+#line 2195 "yacc_sql.cpp"
     break;
 
-  case 41: /* attr_def_list: %empty  */
-#line 419 "yacc_sql.y"
+  case 50: /* attr_def_list: %empty  */
+#line 506 "yacc_sql.y"
     {
       (yyval.attr_infos) = nullptr;
     }
-#line 2074 "yacc_sql.cpp"
+#line 2203 "yacc_sql.cpp"
     break;
 
-  case 42: /* attr_def_list: COMMA attr_def attr_def_list  */
-#line 423 "yacc_sql.y"
+  case 51: /* attr_def_list: COMMA attr_def attr_def_list  */
+#line 510 "yacc_sql.y"
     {
       if ((yyvsp[0].attr_infos) != nullptr) {
         (yyval.attr_infos) = (yyvsp[0].attr_infos);
@@ -2084,11 +2213,11 @@ yyreduce:
       (yyval.attr_infos)->emplace_back(*(yyvsp[-1].attr_info));
       delete (yyvsp[-1].attr_info);
     }
-#line 2088 "yacc_sql.cpp"
+#line 2217 "yacc_sql.cpp"
     break;
 
-  case 43: /* attr_def: ID type LBRACE number RBRACE  */
-#line 436 "yacc_sql.y"
+  case 52: /* attr_def: ID type LBRACE number RBRACE  */
+#line 523 "yacc_sql.y"
     {
       (yyval.attr_info) = new AttrInfoSqlNode;
       (yyval.attr_info)->type = (AttrType)(yyvsp[-3].number);
@@ -2097,11 +2226,11 @@ yyreduce:
       (yyval.attr_info)->nullable = true;
       free((yyvsp[-4].string));
     }
-#line 2101 "yacc_sql.cpp"
+#line 2230 "yacc_sql.cpp"
     break;
 
-  case 44: /* attr_def: ID type  */
-#line 445 "yacc_sql.y"
+  case 53: /* attr_def: ID type  */
+#line 532 "yacc_sql.y"
     {
       (yyval.attr_info) = new AttrInfoSqlNode;
       (yyval.attr_info)->type = (AttrType)(yyvsp[0].number);
@@ -2110,11 +2239,11 @@ yyreduce:
       (yyval.attr_info)->nullable = true;
       free((yyvsp[-1].string));
     }
-#line 2114 "yacc_sql.cpp"
+#line 2243 "yacc_sql.cpp"
     break;
 
-  case 45: /* attr_def: ID type LBRACE number RBRACE NOT_T NULL_T  */
-#line 454 "yacc_sql.y"
+  case 54: /* attr_def: ID type LBRACE number RBRACE NOT_T NULL_T  */
+#line 541 "yacc_sql.y"
     {
       (yyval.attr_info) = new AttrInfoSqlNode;
       (yyval.attr_info)->type = (AttrType)(yyvsp[-5].number);
@@ -2123,11 +2252,11 @@ yyreduce:
       (yyval.attr_info)->nullable = false;
       free((yyvsp[-6].string));
     }
-#line 2127 "yacc_sql.cpp"
+#line 2256 "yacc_sql.cpp"
     break;
 
-  case 46: /* attr_def: ID type NOT_T NULL_T  */
-#line 463 "yacc_sql.y"
+  case 55: /* attr_def: ID type NOT_T NULL_T  */
+#line 550 "yacc_sql.y"
     {
       (yyval.attr_info) = new AttrInfoSqlNode;
       (yyval.attr_info)->type = (AttrType)(yyvsp[-2].number);
@@ -2136,11 +2265,11 @@ yyreduce:
       (yyval.attr_info)->nullable = false;
       free((yyvsp[-3].string));
     }
-#line 2140 "yacc_sql.cpp"
+#line 2269 "yacc_sql.cpp"
     break;
 
-  case 47: /* attr_def: ID type LBRACE number RBRACE NULL_T  */
-#line 472 "yacc_sql.y"
+  case 56: /* attr_def: ID type LBRACE number RBRACE NULL_T  */
+#line 559 "yacc_sql.y"
     {
       (yyval.attr_info) = new AttrInfoSqlNode;
       (yyval.attr_info)->type = (AttrType)(yyvsp[-4].number);
@@ -2149,11 +2278,11 @@ yyreduce:
       (yyval.attr_info)->nullable = true;
       free((yyvsp[-5].string));
     }
-#line 2153 "yacc_sql.cpp"
+#line 2282 "yacc_sql.cpp"
     break;
 
-  case 48: /* attr_def: ID type NULL_T  */
-#line 481 "yacc_sql.y"
+  case 57: /* attr_def: ID type NULL_T  */
+#line 568 "yacc_sql.y"
     {
       (yyval.attr_info) = new AttrInfoSqlNode;
       (yyval.attr_info)->type = (AttrType)(yyvsp[-1].number);
@@ -2162,77 +2291,77 @@ yyreduce:
       (yyval.attr_info)->nullable = true;
       free((yyvsp[-2].string));
     }
-#line 2166 "yacc_sql.cpp"
+#line 2295 "yacc_sql.cpp"
     break;
 
-  case 49: /* number: NUMBER  */
-#line 492 "yacc_sql.y"
+  case 58: /* number: NUMBER  */
+#line 579 "yacc_sql.y"
            {(yyval.number) = (yyvsp[0].number);}
-#line 2172 "yacc_sql.cpp"
+#line 2301 "yacc_sql.cpp"
     break;
 
-  case 50: /* type: INT_T  */
-#line 496 "yacc_sql.y"
+  case 59: /* type: INT_T  */
+#line 583 "yacc_sql.y"
                { (yyval.number)=INTS; }
-#line 2178 "yacc_sql.cpp"
+#line 2307 "yacc_sql.cpp"
     break;
 
-  case 51: /* type: STRING_T  */
-#line 497 "yacc_sql.y"
+  case 60: /* type: STRING_T  */
+#line 584 "yacc_sql.y"
                { (yyval.number)=CHARS; }
-#line 2184 "yacc_sql.cpp"
+#line 2313 "yacc_sql.cpp"
     break;
 
-  case 52: /* type: FLOAT_T  */
-#line 498 "yacc_sql.y"
+  case 61: /* type: FLOAT_T  */
+#line 585 "yacc_sql.y"
                { (yyval.number)=FLOATS; }
-#line 2190 "yacc_sql.cpp"
+#line 2319 "yacc_sql.cpp"
     break;
 
-  case 53: /* type: DATE_T  */
-#line 499 "yacc_sql.y"
+  case 62: /* type: DATE_T  */
+#line 586 "yacc_sql.y"
                { (yyval.number)=DATES; }
-#line 2196 "yacc_sql.cpp"
+#line 2325 "yacc_sql.cpp"
     break;
 
-  case 54: /* type: TEXT_T  */
-#line 500 "yacc_sql.y"
+  case 63: /* type: TEXT_T  */
+#line 587 "yacc_sql.y"
                { (yyval.number)=TEXTS; }
-#line 2202 "yacc_sql.cpp"
+#line 2331 "yacc_sql.cpp"
     break;
 
-  case 55: /* aggr_type: COUNT_T  */
-#line 505 "yacc_sql.y"
+  case 64: /* aggr_type: COUNT_T  */
+#line 592 "yacc_sql.y"
                { (yyval.number)=AGGR_COUNT; }
-#line 2208 "yacc_sql.cpp"
+#line 2337 "yacc_sql.cpp"
     break;
 
-  case 56: /* aggr_type: MIN_T  */
-#line 506 "yacc_sql.y"
+  case 65: /* aggr_type: MIN_T  */
+#line 593 "yacc_sql.y"
                { (yyval.number)=AGGR_MIN;   }
-#line 2214 "yacc_sql.cpp"
+#line 2343 "yacc_sql.cpp"
     break;
 
-  case 57: /* aggr_type: MAX_T  */
-#line 507 "yacc_sql.y"
+  case 66: /* aggr_type: MAX_T  */
+#line 594 "yacc_sql.y"
                { (yyval.number)=AGGR_MAX;   }
-#line 2220 "yacc_sql.cpp"
+#line 2349 "yacc_sql.cpp"
     break;
 
-  case 58: /* aggr_type: AVG_T  */
-#line 508 "yacc_sql.y"
+  case 67: /* aggr_type: AVG_T  */
+#line 595 "yacc_sql.y"
                { (yyval.number)=AGGR_AVG;   }
-#line 2226 "yacc_sql.cpp"
+#line 2355 "yacc_sql.cpp"
     break;
 
-  case 59: /* aggr_type: SUM_T  */
-#line 509 "yacc_sql.y"
+  case 68: /* aggr_type: SUM_T  */
+#line 596 "yacc_sql.y"
                { (yyval.number)=AGGR_SUM;   }
-#line 2232 "yacc_sql.cpp"
+#line 2361 "yacc_sql.cpp"
     break;
 
-  case 60: /* insert_stmt: INSERT INTO ID VALUES value_list multi_value_list  */
-#line 514 "yacc_sql.y"
+  case 69: /* insert_stmt: INSERT INTO ID VALUES value_list multi_value_list  */
+#line 601 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_INSERT);
       (yyval.sql_node)->insertion.relation_name = (yyvsp[-3].string);
@@ -2244,19 +2373,19 @@ yyreduce:
       delete (yyvsp[-1].value_list);
       free((yyvsp[-3].string));
     }
-#line 2248 "yacc_sql.cpp"
+#line 2377 "yacc_sql.cpp"
     break;
 
-  case 61: /* multi_value_list: %empty  */
-#line 529 "yacc_sql.y"
+  case 70: /* multi_value_list: %empty  */
+#line 616 "yacc_sql.y"
     {
       (yyval.multi_value_list) = nullptr;
     }
-#line 2256 "yacc_sql.cpp"
+#line 2385 "yacc_sql.cpp"
     break;
 
-  case 62: /* multi_value_list: COMMA value_list multi_value_list  */
-#line 533 "yacc_sql.y"
+  case 71: /* multi_value_list: COMMA value_list multi_value_list  */
+#line 620 "yacc_sql.y"
     {
       if ((yyvsp[0].multi_value_list) != nullptr) {
         (yyval.multi_value_list) = (yyvsp[0].multi_value_list);
@@ -2266,11 +2395,11 @@ yyreduce:
       (yyval.multi_value_list)->emplace_back(*(yyvsp[-1].value_list));
       delete (yyvsp[-1].value_list);
     }
-#line 2270 "yacc_sql.cpp"
+#line 2399 "yacc_sql.cpp"
     break;
 
-  case 63: /* value_list: LBRACE value value_list_body RBRACE  */
-#line 546 "yacc_sql.y"
+  case 72: /* value_list: LBRACE value value_list_body RBRACE  */
+#line 633 "yacc_sql.y"
     {
       if ((yyvsp[-1].value_list_body) != nullptr) {
         (yyval.value_list) = (yyvsp[-1].value_list_body);
@@ -2281,19 +2410,19 @@ yyreduce:
       std::reverse((yyval.value_list)->begin(), (yyval.value_list)->end());
       delete (yyvsp[-2].value);
     }
-#line 2285 "yacc_sql.cpp"
+#line 2414 "yacc_sql.cpp"
     break;
 
-  case 64: /* value_list_body: %empty  */
-#line 560 "yacc_sql.y"
+  case 73: /* value_list_body: %empty  */
+#line 647 "yacc_sql.y"
     {
       (yyval.value_list_body) = nullptr;
     }
-#line 2293 "yacc_sql.cpp"
+#line 2422 "yacc_sql.cpp"
     break;
 
-  case 65: /* value_list_body: COMMA value value_list_body  */
-#line 564 "yacc_sql.y"
+  case 74: /* value_list_body: COMMA value value_list_body  */
+#line 651 "yacc_sql.y"
     {
       if ((yyvsp[0].value_list_body) != nullptr) {
         (yyval.value_list_body) = (yyvsp[0].value_list_body);
@@ -2303,77 +2432,77 @@ yyreduce:
       (yyval.value_list_body)->emplace_back(*(yyvsp[-1].value));
       delete (yyvsp[-1].value);
     }
-#line 2307 "yacc_sql.cpp"
+#line 2436 "yacc_sql.cpp"
     break;
 
-  case 66: /* value: NUMBER  */
-#line 576 "yacc_sql.y"
+  case 75: /* value: NUMBER  */
+#line 663 "yacc_sql.y"
            {
       (yyval.value) = new Value((int)(yyvsp[0].number));
       (yyloc) = (yylsp[0]);
     }
-#line 2316 "yacc_sql.cpp"
+#line 2445 "yacc_sql.cpp"
     break;
 
-  case 67: /* value: '-' NUMBER  */
-#line 579 "yacc_sql.y"
+  case 76: /* value: '-' NUMBER  */
+#line 666 "yacc_sql.y"
                    {
       (yyval.value) = new Value(-(int)(yyvsp[0].number));
       (yyloc) = (yylsp[0]);
     }
-#line 2325 "yacc_sql.cpp"
+#line 2454 "yacc_sql.cpp"
     break;
 
-  case 68: /* value: FLOAT  */
-#line 582 "yacc_sql.y"
+  case 77: /* value: FLOAT  */
+#line 669 "yacc_sql.y"
               {
       (yyval.value) = new Value((float)(yyvsp[0].floats));
       (yyloc) = (yylsp[0]);
     }
-#line 2334 "yacc_sql.cpp"
+#line 2463 "yacc_sql.cpp"
     break;
 
-  case 69: /* value: '-' FLOAT  */
-#line 585 "yacc_sql.y"
+  case 78: /* value: '-' FLOAT  */
+#line 672 "yacc_sql.y"
                   {
       (yyval.value) = new Value(-(float)(yyvsp[0].floats));
       (yyloc) = (yylsp[0]);
     }
-#line 2343 "yacc_sql.cpp"
+#line 2472 "yacc_sql.cpp"
     break;
 
-  case 70: /* value: SSS  */
-#line 588 "yacc_sql.y"
+  case 79: /* value: SSS  */
+#line 675 "yacc_sql.y"
             {
       char *tmp = common::substr((yyvsp[0].string),1,strlen((yyvsp[0].string))-2);
       (yyval.value) = new Value(tmp);
       free(tmp);
     }
-#line 2353 "yacc_sql.cpp"
+#line 2482 "yacc_sql.cpp"
     break;
 
-  case 71: /* value: DATE_STR  */
-#line 592 "yacc_sql.y"
+  case 80: /* value: DATE_STR  */
+#line 679 "yacc_sql.y"
                  {
       char *tmp = common::substr((yyvsp[0].string),1,strlen((yyvsp[0].string))-2);
       (yyval.value) = new Value(DATES, tmp, 4, true);
       free(tmp);
     }
-#line 2363 "yacc_sql.cpp"
+#line 2492 "yacc_sql.cpp"
     break;
 
-  case 72: /* value: NULL_T  */
-#line 596 "yacc_sql.y"
+  case 81: /* value: NULL_T  */
+#line 683 "yacc_sql.y"
                {
       (yyval.value) = new Value(0);
       (yyval.value)->set_null();
       (yyloc) = (yylsp[0]);
     }
-#line 2373 "yacc_sql.cpp"
+#line 2502 "yacc_sql.cpp"
     break;
 
-  case 73: /* delete_stmt: DELETE FROM ID where_conditions  */
-#line 605 "yacc_sql.y"
+  case 82: /* delete_stmt: DELETE FROM ID where_conditions  */
+#line 692 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_DELETE);
       (yyval.sql_node)->deletion.relation_name = (yyvsp[-1].string);
@@ -2383,11 +2512,11 @@ yyreduce:
       }
       free((yyvsp[-1].string));
     }
-#line 2387 "yacc_sql.cpp"
+#line 2516 "yacc_sql.cpp"
     break;
 
-  case 74: /* update_stmt: UPDATE ID SET update_def update_def_list where_conditions  */
-#line 618 "yacc_sql.y"
+  case 83: /* update_stmt: UPDATE ID SET update_def update_def_list where_conditions  */
+#line 705 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_UPDATE);
       (yyval.sql_node)->update.relation_name = (yyvsp[-4].string);
@@ -2405,19 +2534,19 @@ yyreduce:
       }
       free((yyvsp[-4].string));
     }
-#line 2409 "yacc_sql.cpp"
+#line 2538 "yacc_sql.cpp"
     break;
 
-  case 75: /* update_def_list: %empty  */
-#line 639 "yacc_sql.y"
+  case 84: /* update_def_list: %empty  */
+#line 726 "yacc_sql.y"
     {
       (yyval.update_infos) = nullptr;
     }
-#line 2417 "yacc_sql.cpp"
+#line 2546 "yacc_sql.cpp"
     break;
 
-  case 76: /* update_def_list: COMMA update_def update_def_list  */
-#line 643 "yacc_sql.y"
+  case 85: /* update_def_list: COMMA update_def update_def_list  */
+#line 730 "yacc_sql.y"
     {
       if ((yyvsp[0].update_infos) != nullptr) {
         (yyval.update_infos) = (yyvsp[0].update_infos);
@@ -2427,125 +2556,167 @@ yyreduce:
       (yyval.update_infos)->emplace_back(*(yyvsp[-1].update_info));
       delete (yyvsp[-1].update_info);
     }
-#line 2431 "yacc_sql.cpp"
+#line 2560 "yacc_sql.cpp"
     break;
 
-  case 77: /* update_def: ID EQ add_expr  */
-#line 656 "yacc_sql.y"
+  case 86: /* update_def: ID EQ add_expr  */
+#line 743 "yacc_sql.y"
     {
       (yyval.update_info) = new UpdateUnit;
       (yyval.update_info)->attribute_name = (yyvsp[-2].string);
       (yyval.update_info)->value = (yyvsp[0].expression);
       free((yyvsp[-2].string));
     }
-#line 2442 "yacc_sql.cpp"
+#line 2571 "yacc_sql.cpp"
     break;
 
-  case 78: /* select_stmt: SELECT select_attr FROM relation_list join_list where_conditions opt_group_by opt_having opt_order_by  */
-#line 665 "yacc_sql.y"
-                                                                                                          {
+  case 87: /* select_stmt: SELECT select_attr FROM relation_list join_list where_conditions opt_group_by opt_having opt_order_by opt_limit  */
+#line 752 "yacc_sql.y"
+                                                                                                                    {
       (yyval.sql_node) = new ParsedSqlNode(SCF_SELECT);
 
-      (yyval.sql_node)->selection.attributes.swap(*(yyvsp[-7].expression_list));
-      delete (yyvsp[-7].expression_list);
+      (yyval.sql_node)->selection.attributes.swap(*(yyvsp[-8].expression_list));
+      delete (yyvsp[-8].expression_list);
 
-      (yyval.sql_node)->selection.relations.swap(*(yyvsp[-5].relation_list));
+      (yyval.sql_node)->selection.relations.swap(*(yyvsp[-6].relation_list));
       std::reverse((yyval.sql_node)->selection.relations.begin(), (yyval.sql_node)->selection.relations.end());
-      delete (yyvsp[-5].relation_list);
+      delete (yyvsp[-6].relation_list);
 
-      if ((yyvsp[-4].join_list) != nullptr) {
-        (yyval.sql_node)->selection.join_lists.swap(*(yyvsp[-4].join_list));
+      if ((yyvsp[-5].join_list) != nullptr) {
+        (yyval.sql_node)->selection.join_lists.swap(*(yyvsp[-5].join_list));
         std::reverse((yyval.sql_node)->selection.join_lists.begin(), (yyval.sql_node)->selection.join_lists.end());
         for (const auto& join_list : (yyval.sql_node)->selection.join_lists) {
           (yyval.sql_node)->selection.relations.emplace_back(join_list.relation);
         }
-        delete (yyvsp[-4].join_list);
+        delete (yyvsp[-5].join_list);
       }
-      if ((yyvsp[-3].condition_list) != nullptr) {
-        (yyval.sql_node)->selection.where_conditions.type = (yyvsp[-3].condition_list)->type;
-        (yyval.sql_node)->selection.where_conditions.conditions.swap((yyvsp[-3].condition_list)->conditions);
-        delete (yyvsp[-3].condition_list);
+      if ((yyvsp[-4].condition_list) != nullptr) {
+        (yyval.sql_node)->selection.where_conditions.type = (yyvsp[-4].condition_list)->type;
+        (yyval.sql_node)->selection.where_conditions.conditions.swap((yyvsp[-4].condition_list)->conditions);
+        delete (yyvsp[-4].condition_list);
       }
-      if ((yyvsp[-2].rel_attr_list) != nullptr) {
-      	(yyval.sql_node)->selection.group_by_attributes.swap(*(yyvsp[-2].rel_attr_list));
+      if ((yyvsp[-3].rel_attr_list) != nullptr) {
+      	(yyval.sql_node)->selection.group_by_attributes.swap(*(yyvsp[-3].rel_attr_list));
 	std::reverse((yyval.sql_node)->selection.group_by_attributes.begin(), (yyval.sql_node)->selection.group_by_attributes.end());
-	delete (yyvsp[-2].rel_attr_list);
+	delete (yyvsp[-3].rel_attr_list);
       }
-      if ((yyvsp[-1].condition_list) != nullptr) {
-	(yyval.sql_node)->selection.having_conditions.type = (yyvsp[-1].condition_list)->type;
-	(yyval.sql_node)->selection.having_conditions.conditions.swap((yyvsp[-1].condition_list)->conditions);
-	delete (yyvsp[-1].condition_list);
+      if ((yyvsp[-2].condition_list) != nullptr) {
+	(yyval.sql_node)->selection.having_conditions.type = (yyvsp[-2].condition_list)->type;
+	(yyval.sql_node)->selection.having_conditions.conditions.swap((yyvsp[-2].condition_list)->conditions);
+	delete (yyvsp[-2].condition_list);
       }
-      if ((yyvsp[0].order_infos) != nullptr) {
-        (yyval.sql_node)->selection.order_lists.swap(*(yyvsp[0].order_infos));
+      if ((yyvsp[-1].order_infos) != nullptr) {
+        (yyval.sql_node)->selection.order_lists.swap(*(yyvsp[-1].order_infos));
         std::reverse((yyval.sql_node)->selection.order_lists.begin(), (yyval.sql_node)->selection.order_lists.end());
-        delete (yyvsp[0].order_infos);
+        delete (yyvsp[-1].order_infos);
+      }
+      if ((yyvsp[0].limit_info) != nullptr) {
+        (yyval.sql_node)->selection.limit = *(yyvsp[0].limit_info);
+        delete (yyvsp[0].limit_info);
       }
     }
-#line 2486 "yacc_sql.cpp"
+#line 2619 "yacc_sql.cpp"
     break;
 
-  case 79: /* opt_group_by: %empty  */
-#line 707 "yacc_sql.y"
+  case 88: /* opt_group_by: %empty  */
+#line 798 "yacc_sql.y"
                 {
       (yyval.rel_attr_list) = nullptr;
 
     }
-#line 2495 "yacc_sql.cpp"
+#line 2628 "yacc_sql.cpp"
     break;
 
-  case 80: /* opt_group_by: GROUP BY rel_attr_list  */
-#line 710 "yacc_sql.y"
+  case 89: /* opt_group_by: GROUP BY rel_attr_list  */
+#line 801 "yacc_sql.y"
                                {
       (yyval.rel_attr_list) = (yyvsp[0].rel_attr_list);
     }
-#line 2503 "yacc_sql.cpp"
+#line 2636 "yacc_sql.cpp"
     break;
 
-  case 81: /* opt_having: %empty  */
-#line 715 "yacc_sql.y"
+  case 90: /* opt_having: %empty  */
+#line 806 "yacc_sql.y"
                 {
       (yyval.condition_list) = nullptr;
 
     }
-#line 2512 "yacc_sql.cpp"
+#line 2645 "yacc_sql.cpp"
     break;
 
-  case 82: /* opt_having: HAVING condition_list  */
-#line 718 "yacc_sql.y"
+  case 91: /* opt_having: HAVING condition_list  */
+#line 809 "yacc_sql.y"
                               {
       (yyval.condition_list) = (yyvsp[0].condition_list);
     }
-#line 2520 "yacc_sql.cpp"
+#line 2653 "yacc_sql.cpp"
     break;
 
-  case 83: /* opt_order_by: %empty  */
-#line 725 "yacc_sql.y"
+  case 92: /* opt_order_by: %empty  */
+#line 816 "yacc_sql.y"
         {
       (yyval.order_infos) = nullptr;
     }
-#line 2528 "yacc_sql.cpp"
+#line 2661 "yacc_sql.cpp"
     break;
 
-  case 84: /* opt_order_by: ORDER BY sort_def_list  */
-#line 729 "yacc_sql.y"
+  case 93: /* opt_order_by: ORDER BY sort_def_list  */
+#line 820 "yacc_sql.y"
         {
       (yyval.order_infos) = (yyvsp[0].order_infos);
 	}
-#line 2536 "yacc_sql.cpp"
+#line 2669 "yacc_sql.cpp"
+    break;
+
+  case 94: /* opt_limit: %empty  */
+#line 827 "yacc_sql.y"
+    {
+      (yyval.limit_info) = nullptr;
+    }
+#line 2677 "yacc_sql.cpp"
+    break;
+
+  case 95: /* opt_limit: LIMIT NUMBER  */
+#line 831 "yacc_sql.y"
+    {
+      (yyval.limit_info) = new LimitSqlNode;
+      (yyval.limit_info)->limit = (yyvsp[0].number);
+    }
+#line 2686 "yacc_sql.cpp"
     break;
 
-  case 85: /* sort_def_list: sort_def  */
-#line 736 "yacc_sql.y"
+  case 96: /* opt_limit: LIMIT NUMBER OFFSET NUMBER  */
+#line 836 "yacc_sql.y"
+    {
+      (yyval.limit_info) = new LimitSqlNode;
+      (yyval.limit_info)->limit = (yyvsp[-2].number);
+      (yyval.limit_info)->offset = (yyvsp[0].number);
+    }
+#line 2696 "yacc_sql.cpp"
+    break;
+
+  case 97: /* opt_limit: LIMIT NUMBER COMMA NUMBER  */
+#line 842 "yacc_sql.y"
+    {
+      // MySQL 风格: limit offset, count
+      (yyval.limit_info) = new LimitSqlNode;
+      (yyval.limit_info)->limit = (yyvsp[0].number);
+      (yyval.limit_info)->offset = (yyvsp[-2].number);
+    }
+#line 2707 "yacc_sql.cpp"
+    break;
+
+  case 98: /* sort_def_list: sort_def  */
+#line 852 "yacc_sql.y"
         {
       (yyval.order_infos) = new std::vector<OrderByNode>;
       (yyval.order_infos)->emplace_back(*(yyvsp[0].order_info));
 	}
-#line 2545 "yacc_sql.cpp"
+#line 2716 "yacc_sql.cpp"
     break;
 
-  case 86: /* sort_def_list: sort_def COMMA sort_def_list  */
-#line 741 "yacc_sql.y"
+  case 99: /* sort_def_list: sort_def COMMA sort_def_list  */
+#line 857 "yacc_sql.y"
         {
       if ((yyvsp[0].order_infos) != nullptr) {
         (yyval.order_infos) = (yyvsp[0].order_infos);
@@ -2554,53 +2725,53 @@ yyreduce:
       }
       (yyval.order_infos)->emplace_back(*(yyvsp[-2].order_info));
 	}
-#line 2558 "yacc_sql.cpp"
+#line 2729 "yacc_sql.cpp"
     break;
 
-  case 87: /* sort_def: rel_attr  */
-#line 753 "yacc_sql.y"
+  case 100: /* sort_def: rel_attr  */
+#line 869 "yacc_sql.y"
     {
       (yyval.order_info) = new OrderByNode;
       (yyval.order_info)->sort_attr = *(yyvsp[0].rel_attr);
       delete((yyvsp[0].rel_attr));
     }
-#line 2568 "yacc_sql.cpp"
+#line 2739 "yacc_sql.cpp"
     break;
 
-  case 88: /* sort_def: rel_attr DESC  */
-#line 759 "yacc_sql.y"
+  case 101: /* sort_def: rel_attr DESC  */
+#line 875 "yacc_sql.y"
     {
       (yyval.order_info) = new OrderByNode;
       (yyval.order_info)->sort_attr = *(yyvsp[-1].rel_attr);
       (yyval.order_info)->is_asc = 0;
       delete((yyvsp[-1].rel_attr));
     }
-#line 2579 "yacc_sql.cpp"
+#line 2750 "yacc_sql.cpp"
     break;
 
-  case 89: /* sort_def: rel_attr ASC  */
-#line 766 "yacc_sql.y"
+  case 102: /* sort_def: rel_attr ASC  */
+#line 882 "yacc_sql.y"
     {
       (yyval.order_info) = new OrderByNode;
       (yyval.order_info)->sort_attr = *(yyvsp[-1].rel_attr);
       delete((yyvsp[-1].rel_attr));
     }
-#line 2589 "yacc_sql.cpp"
+#line 2760 "yacc_sql.cpp"
     break;
 
-  case 90: /* calc_stmt: CALC select_attr  */
-#line 775 "yacc_sql.y"
+  case 103: /* calc_stmt: CALC select_attr  */
+#line 891 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_CALC);
       std::reverse((yyvsp[0].expression_list)->begin(), (yyvsp[0].expression_list)->end());
       (yyval.sql_node)->calc.expressions.swap(*(yyvsp[0].expression_list));
       delete (yyvsp[0].expression_list);
     }
-#line 2600 "yacc_sql.cpp"
+#line 2771 "yacc_sql.cpp"
     break;
 
-  case 91: /* aggr_expr: aggr_type LBRACE '*' RBRACE  */
-#line 784 "yacc_sql.y"
+  case 104: /* aggr_expr: aggr_type LBRACE '*' RBRACE  */
+#line 900 "yacc_sql.y"
                                 {
       RelAttrSqlNode *rel_attr_sql_node = new RelAttrSqlNode;
       rel_attr_sql_node->relation_name = "";
@@ -2608,20 +2779,20 @@ yyreduce:
       RelAttrExpr *relExpr = new RelAttrExpr(*rel_attr_sql_node);
       (yyval.expression) = new AggrExpr((AggrType)(yyvsp[-3].number), relExpr);
     }
-#line 2612 "yacc_sql.cpp"
+#line 2783 "yacc_sql.cpp"
     break;
 
-  case 92: /* aggr_expr: aggr_type LBRACE rel_attr RBRACE  */
-#line 790 "yacc_sql.y"
+  case 105: /* aggr_expr: aggr_type LBRACE rel_attr RBRACE  */
+#line 906 "yacc_sql.y"
                                          {
       RelAttrExpr *relExpr = new RelAttrExpr(*(yyvsp[-1].rel_attr));
       (yyval.expression) = new AggrExpr((AggrType)(yyvsp[-3].number), relExpr);
     }
-#line 2621 "yacc_sql.cpp"
+#line 2792 "yacc_sql.cpp"
     break;
 
-  case 93: /* aggr_expr: aggr_type LBRACE DATA RBRACE  */
-#line 793 "yacc_sql.y"
+  case 106: /* aggr_expr: aggr_type LBRACE DATA RBRACE  */
+#line 909 "yacc_sql.y"
                                      {
       // These shit is added due to a fucking test case
       RelAttrSqlNode *rel_attr_sql_node = new RelAttrSqlNode;
@@ -2630,49 +2801,58 @@ yyreduce:
       RelAttrExpr *relExpr = new RelAttrExpr(*rel_attr_sql_node);
       (yyval.expression) = new AggrExpr((AggrType)(yyvsp[-3].number), relExpr);
     }
-#line 2634 "yacc_sql.cpp"
+#line 2805 "yacc_sql.cpp"
     break;
 
-  case 94: /* base_expr: value  */
-#line 804 "yacc_sql.y"
+  case 107: /* base_expr: value  */
+#line 920 "yacc_sql.y"
           {
       (yyval.expression) = new ValueExpr(*(yyvsp[0].value));
       (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
       delete (yyvsp[0].value);
     }
-#line 2644 "yacc_sql.cpp"
+#line 2815 "yacc_sql.cpp"
+    break;
+
+  case 108: /* base_expr: '?'  */
+#line 924 "yacc_sql.y"
+            {
+      (yyval.expression) = new ParamExpr(sql_result->next_param_index());
+      (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
+    }
+#line 2824 "yacc_sql.cpp"
     break;
 
-  case 95: /* base_expr: rel_attr  */
-#line 808 "yacc_sql.y"
+  case 109: /* base_expr: rel_attr  */
+#line 927 "yacc_sql.y"
                  {
       (yyval.expression) = new RelAttrExpr(*(yyvsp[0].rel_attr));
       (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
       delete (yyvsp[0].rel_attr);
     }
-#line 2654 "yacc_sql.cpp"
+#line 2834 "yacc_sql.cpp"
     break;
 
-  case 96: /* base_expr: LBRACE add_expr RBRACE  */
-#line 812 "yacc_sql.y"
+  case 110: /* base_expr: LBRACE add_expr RBRACE  */
+#line 931 "yacc_sql.y"
                                {
       (yyval.expression) = (yyvsp[-1].expression);
       (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
     }
-#line 2663 "yacc_sql.cpp"
+#line 2843 "yacc_sql.cpp"
     break;
 
-  case 97: /* base_expr: aggr_expr  */
-#line 815 "yacc_sql.y"
+  case 111: /* base_expr: aggr_expr  */
+#line 934 "yacc_sql.y"
                   {
       (yyval.expression) = (yyvsp[0].expression);
       (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
     }
-#line 2672 "yacc_sql.cpp"
+#line 2852 "yacc_sql.cpp"
     break;
 
-  case 98: /* base_expr: value_list  */
-#line 818 "yacc_sql.y"
+  case 112: /* base_expr: value_list  */
+#line 937 "yacc_sql.y"
                    {
       (yyval.expression) = new ValuesExpr();
       for (auto &value : *(yyvsp[0].value_list)) {
@@ -2681,67 +2861,67 @@ yyreduce:
       (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
       delete (yyvsp[0].value_list);
     }
-#line 2685 "yacc_sql.cpp"
+#line 2865 "yacc_sql.cpp"
     break;
 
-  case 99: /* mul_expr: base_expr  */
-#line 829 "yacc_sql.y"
+  case 113: /* mul_expr: base_expr  */
+#line 948 "yacc_sql.y"
               {
       (yyval.expression) = (yyvsp[0].expression);
     }
-#line 2693 "yacc_sql.cpp"
+#line 2873 "yacc_sql.cpp"
     break;
 
-  case 100: /* mul_expr: '-' base_expr  */
-#line 831 "yacc_sql.y"
+  case 114: /* mul_expr: '-' base_expr  */
+#line 950 "yacc_sql.y"
                       {
       (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::NEGATIVE, (yyvsp[0].expression), nullptr, sql_string, &(yyloc));
     }
-#line 2701 "yacc_sql.cpp"
+#line 2881 "yacc_sql.cpp"
     break;
 
-  case 101: /* mul_expr: mul_expr '*' base_expr  */
-#line 833 "yacc_sql.y"
+  case 115: /* mul_expr: mul_expr '*' base_expr  */
+#line 952 "yacc_sql.y"
                                {
       (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::MUL, (yyvsp[-2].expression), (yyvsp[0].expression), sql_string, &(yyloc));
     }
-#line 2709 "yacc_sql.cpp"
+#line 2889 "yacc_sql.cpp"
     break;
 
-  case 102: /* mul_expr: mul_expr '/' base_expr  */
-#line 835 "yacc_sql.y"
+  case 116: /* mul_expr: mul_expr '/' base_expr  */
+#line 954 "yacc_sql.y"
                                {
       (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::DIV, (yyvsp[-2].expression), (yyvsp[0].expression), sql_string, &(yyloc));
     }
-#line 2717 "yacc_sql.cpp"
+#line 2897 "yacc_sql.cpp"
     break;
 
-  case 103: /* add_expr: mul_expr  */
-#line 841 "yacc_sql.y"
+  case 117: /* add_expr: mul_expr  */
+#line 960 "yacc_sql.y"
              {
       (yyval.expression) = (yyvsp[0].expression);
     }
-#line 2725 "yacc_sql.cpp"
+#line 2905 "yacc_sql.cpp"
     break;
 
-  case 104: /* add_expr: add_expr '+' mul_expr  */
-#line 843 "yacc_sql.y"
+  case 118: /* add_expr: add_expr '+' mul_expr  */
+#line 962 "yacc_sql.y"
                               {
       (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::ADD, (yyvsp[-2].expression), (yyvsp[0].expression), sql_string, &(yyloc));
     }
-#line 2733 "yacc_sql.cpp"
+#line 2913 "yacc_sql.cpp"
     break;
 
-  case 105: /* add_expr: add_expr '-' mul_expr  */
-#line 845 "yacc_sql.y"
+  case 119: /* add_expr: add_expr '-' mul_expr  */
+#line 964 "yacc_sql.y"
                               {
       (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::SUB, (yyvsp[-2].expression), (yyvsp[0].expression), sql_string, &(yyloc));
     }
-#line 2741 "yacc_sql.cpp"
+#line 2921 "yacc_sql.cpp"
     break;
 
-  case 106: /* select_attr: '*' expression_list  */
-#line 851 "yacc_sql.y"
+  case 120: /* select_attr: '*' expression_list  */
+#line 970 "yacc_sql.y"
                         {
       if ((yyvsp[0].expression_list) != nullptr) {
         (yyval.expression_list) = (yyvsp[0].expression_list);
@@ -2753,11 +2933,11 @@ yyreduce:
       relAttrSqlNode->attribute_name = "*";
       (yyval.expression_list)->emplace_back(new RelAttrExpr(*relAttrSqlNode));
     }
-#line 2757 "yacc_sql.cpp"
+#line 2937 "yacc_sql.cpp"
     break;
 
-  case 107: /* select_attr: ID DOT '*' expression_list  */
-#line 862 "yacc_sql.y"
+  case 121: /* select_attr: ID DOT '*' expression_list  */
+#line 981 "yacc_sql.y"
                                  {
       if ((yyvsp[0].expression_list) != nullptr) {
         (yyval.expression_list) = (yyvsp[0].expression_list);
@@ -2770,11 +2950,11 @@ yyreduce:
       (yyval.expression_list)->emplace_back(new RelAttrExpr(*relAttrSqlNode));
       free((yyvsp[-3].string));
     }
-#line 2774 "yacc_sql.cpp"
+#line 2954 "yacc_sql.cpp"
     break;
 
-  case 108: /* select_attr: add_expr expression_list  */
-#line 873 "yacc_sql.y"
+  case 122: /* select_attr: add_expr expression_list  */
+#line 992 "yacc_sql.y"
                                  {
       if ((yyvsp[0].expression_list) != nullptr) {
         (yyval.expression_list) = (yyvsp[0].expression_list);
@@ -2783,11 +2963,11 @@ yyreduce:
       }
       (yyval.expression_list)->emplace_back((yyvsp[-1].expression));
     }
-#line 2787 "yacc_sql.cpp"
+#line 2967 "yacc_sql.cpp"
     break;
 
-  case 109: /* select_attr: add_expr AS ID expression_list  */
-#line 880 "yacc_sql.y"
+  case 123: /* select_attr: add_expr AS ID expression_list  */
+#line 999 "yacc_sql.y"
                                        {
       if ((yyvsp[0].expression_list) != nullptr) {
         (yyval.expression_list) = (yyvsp[0].expression_list);
@@ -2798,19 +2978,19 @@ yyreduce:
       expr->set_alias((yyvsp[-1].string));
       (yyval.expression_list)->emplace_back(expr);
     }
-#line 2802 "yacc_sql.cpp"
+#line 2982 "yacc_sql.cpp"
     break;
 
-  case 110: /* expression_list: %empty  */
-#line 893 "yacc_sql.y"
+  case 124: /* expression_list: %empty  */
+#line 1012 "yacc_sql.y"
                 {
       (yyval.expression_list) = nullptr;
     }
-#line 2810 "yacc_sql.cpp"
+#line 2990 "yacc_sql.cpp"
     break;
 
-  case 111: /* expression_list: COMMA '*' expression_list  */
-#line 895 "yacc_sql.y"
+  case 125: /* expression_list: COMMA '*' expression_list  */
+#line 1014 "yacc_sql.y"
                                   {
       if ((yyvsp[0].expression_list) != nullptr) {
         (yyval.expression_list) = (yyvsp[0].expression_list);
@@ -2822,11 +3002,11 @@ yyreduce:
       relAttrSqlNode->attribute_name = "*";
       (yyval.expression_list)->emplace_back(new RelAttrExpr(*relAttrSqlNode));
     }
-#line 2826 "yacc_sql.cpp"
+#line 3006 "yacc_sql.cpp"
     break;
 
-  case 112: /* expression_list: COMMA ID DOT '*' expression_list  */
-#line 905 "yacc_sql.y"
+  case 126: /* expression_list: COMMA ID DOT '*' expression_list  */
+#line 1024 "yacc_sql.y"
                                          {
       if ((yyvsp[0].expression_list) != nullptr) {
         (yyval.expression_list) = (yyvsp[0].expression_list);
@@ -2839,11 +3019,11 @@ yyreduce:
       (yyval.expression_list)->emplace_back(new RelAttrExpr(*relAttrSqlNode));
       free((yyvsp[-3].string));
     }
-#line 2843 "yacc_sql.cpp"
+#line 3023 "yacc_sql.cpp"
     break;
 
-  case 113: /* expression_list: COMMA add_expr expression_list  */
-#line 916 "yacc_sql.y"
+  case 127: /* expression_list: COMMA add_expr expression_list  */
+#line 1035 "yacc_sql.y"
                                        {
       if ((yyvsp[0].expression_list) != nullptr) {
         (yyval.expression_list) = (yyvsp[0].expression_list);
@@ -2852,11 +3032,11 @@ yyreduce:
       }
       (yyval.expression_list)->emplace_back((yyvsp[-1].expression));
     }
-#line 2856 "yacc_sql.cpp"
+#line 3036 "yacc_sql.cpp"
     break;
 
-  case 114: /* expression_list: COMMA add_expr ID expression_list  */
-#line 923 "yacc_sql.y"
+  case 128: /* expression_list: COMMA add_expr ID expression_list  */
+#line 1042 "yacc_sql.y"
                                           {
       if ((yyvsp[0].expression_list) != nullptr) {
         (yyval.expression_list) = (yyvsp[0].expression_list);
@@ -2867,11 +3047,11 @@ yyreduce:
       expr->set_alias((yyvsp[-1].string));
       (yyval.expression_list)->emplace_back(expr);
     }
-#line 2871 "yacc_sql.cpp"
+#line 3051 "yacc_sql.cpp"
     break;
 
-  case 115: /* expression_list: COMMA add_expr AS ID expression_list  */
-#line 932 "yacc_sql.y"
+  case 129: /* expression_list: COMMA add_expr AS ID expression_list  */
+#line 1051 "yacc_sql.y"
                                              {
       if ((yyvsp[0].expression_list) != nullptr) {
 	(yyval.expression_list) = (yyvsp[0].expression_list);
@@ -2882,11 +3062,11 @@ yyreduce:
       expr->set_alias((yyvsp[-1].string));
       (yyval.expression_list)->emplace_back(expr);
     }
-#line 2886 "yacc_sql.cpp"
+#line 3066 "yacc_sql.cpp"
     break;
 
-  case 116: /* expression_list: COMMA add_expr AS DATA expression_list  */
-#line 941 "yacc_sql.y"
+  case 130: /* expression_list: COMMA add_expr AS DATA expression_list  */
+#line 1060 "yacc_sql.y"
                                                {
       // These shit is added due to a fucking test case
       if ((yyvsp[0].expression_list) != nullptr) {
@@ -2898,22 +3078,22 @@ yyreduce:
       expr->set_alias("data");
       (yyval.expression_list)->emplace_back(expr);
     }
-#line 2902 "yacc_sql.cpp"
+#line 3082 "yacc_sql.cpp"
     break;
 
-  case 117: /* rel_attr: ID  */
-#line 955 "yacc_sql.y"
+  case 131: /* rel_attr: ID  */
+#line 1074 "yacc_sql.y"
        {
       (yyval.rel_attr) = new RelAttrSqlNode;
       (yyval.rel_attr)->relation_name = "";
       (yyval.rel_attr)->attribute_name = (yyvsp[0].string);
       free((yyvsp[0].string));
     }
-#line 2913 "yacc_sql.cpp"
+#line 3093 "yacc_sql.cpp"
     break;
 
-  case 118: /* rel_attr: ID DOT ID  */
-#line 960 "yacc_sql.y"
+  case 132: /* rel_attr: ID DOT ID  */
+#line 1079 "yacc_sql.y"
                   {
       (yyval.rel_attr) = new RelAttrSqlNode;
       (yyval.rel_attr)->relation_name  = (yyvsp[-2].string);
@@ -2921,21 +3101,21 @@ yyreduce:
       free((yyvsp[-2].string));
       free((yyvsp[0].string));
     }
-#line 2925 "yacc_sql.cpp"
+#line 3105 "yacc_sql.cpp"
     break;
 
-  case 119: /* rel_attr_list: rel_attr  */
-#line 970 "yacc_sql.y"
+  case 133: /* rel_attr_list: rel_attr  */
+#line 1089 "yacc_sql.y"
              {
       (yyval.rel_attr_list) = new std::vector<RelAttrSqlNode>;
       (yyval.rel_attr_list)->emplace_back(*(yyvsp[0].rel_attr));
       delete (yyvsp[0].rel_attr);
     }
-#line 2935 "yacc_sql.cpp"
+#line 3115 "yacc_sql.cpp"
     break;
 
-  case 120: /* rel_attr_list: rel_attr COMMA rel_attr_list  */
-#line 974 "yacc_sql.y"
+  case 134: /* rel_attr_list: rel_attr COMMA rel_attr_list  */
+#line 1093 "yacc_sql.y"
                                      {
       if ((yyvsp[0].rel_attr_list) != nullptr) {
 	(yyval.rel_attr_list) = (yyvsp[0].rel_attr_list);
@@ -2945,11 +3125,11 @@ yyreduce:
       (yyval.rel_attr_list)->emplace_back(*(yyvsp[-2].rel_attr));
       delete (yyvsp[-2].rel_attr);
     }
-#line 2949 "yacc_sql.cpp"
+#line 3129 "yacc_sql.cpp"
     break;
 
-  case 121: /* relation_list: rel_alias rel_list  */
-#line 985 "yacc_sql.y"
+  case 135: /* relation_list: rel_alias rel_list  */
+#line 1104 "yacc_sql.y"
                        {
       if ((yyvsp[0].relation_list) != nullptr) {
         (yyval.relation_list) = (yyvsp[0].relation_list);
@@ -2959,19 +3139,19 @@ yyreduce:
       (yyval.relation_list)->push_back(*(yyvsp[-1].relation));
       delete (yyvsp[-1].relation);
     }
-#line 2963 "yacc_sql.cpp"
+#line 3143 "yacc_sql.cpp"
     break;
 
-  case 122: /* rel_list: %empty  */
-#line 997 "yacc_sql.y"
+  case 136: /* rel_list: %empty  */
+#line 1116 "yacc_sql.y"
                 {
       (yyval.relation_list) = nullptr;
     }
-#line 2971 "yacc_sql.cpp"
+#line 3151 "yacc_sql.cpp"
     break;
 
-  case 123: /* rel_list: COMMA rel_alias rel_list  */
-#line 999 "yacc_sql.y"
+  case 137: /* rel_list: COMMA rel_alias rel_list  */
+#line 1118 "yacc_sql.y"
                                  {
       if ((yyvsp[0].relation_list) != nullptr) {
         (yyval.relation_list) = (yyvsp[0].relation_list);
@@ -2981,22 +3161,22 @@ yyreduce:
       (yyval.relation_list)->push_back(*(yyvsp[-1].relation));
       delete (yyvsp[-1].relation);
     }
-#line 2985 "yacc_sql.cpp"
+#line 3165 "yacc_sql.cpp"
     break;
 
-  case 124: /* rel_alias: ID  */
-#line 1011 "yacc_sql.y"
+  case 138: /* rel_alias: ID  */
+#line 1130 "yacc_sql.y"
        {
       (yyval.relation) = new RelationSqlNode;
       (yyval.relation)->relation_name = (yyvsp[0].string);
       (yyval.relation)->alias = "";
       free((yyvsp[0].string));
     }
-#line 2996 "yacc_sql.cpp"
+#line 3176 "yacc_sql.cpp"
     break;
 
-  case 125: /* rel_alias: ID ID  */
-#line 1016 "yacc_sql.y"
+  case 139: /* rel_alias: ID ID  */
+#line 1135 "yacc_sql.y"
               {
       (yyval.relation) = new RelationSqlNode;
       (yyval.relation)->relation_name = (yyvsp[-1].string);
@@ -3004,11 +3184,11 @@ yyreduce:
       free((yyvsp[-1].string));
       free((yyvsp[0].string));
     }
-#line 3008 "yacc_sql.cpp"
+#line 3188 "yacc_sql.cpp"
     break;
 
-  case 126: /* rel_alias: ID AS ID  */
-#line 1022 "yacc_sql.y"
+  case 140: /* rel_alias: ID AS ID  */
+#line 1141 "yacc_sql.y"
                  {
       (yyval.relation) = new RelationSqlNode;
       (yyval.relation)->relation_name = (yyvsp[-2].string);
@@ -3016,19 +3196,19 @@ yyreduce:
       free((yyvsp[-2].string));
       free((yyvsp[0].string));
     }
-#line 3020 "yacc_sql.cpp"
+#line 3200 "yacc_sql.cpp"
     break;
 
-  case 127: /* join_list: %empty  */
-#line 1033 "yacc_sql.y"
+  case 141: /* join_list: %empty  */
+#line 1152 "yacc_sql.y"
     {
       (yyval.join_list) = nullptr;
     }
-#line 3028 "yacc_sql.cpp"
+#line 3208 "yacc_sql.cpp"
     break;
 
-  case 128: /* join_list: INNER JOIN rel_alias join_conditions join_list  */
-#line 1036 "yacc_sql.y"
+  case 142: /* join_list: INNER JOIN rel_alias join_conditions join_list  */
+#line 1155 "yacc_sql.y"
                                                     {
       if ((yyvsp[0].join_list) != nullptr) {
         (yyval.join_list) = (yyvsp[0].join_list);
@@ -3046,205 +3226,250 @@ yyreduce:
       delete joinSqlNode;
       delete (yyvsp[-2].relation);
     }
-#line 3050 "yacc_sql.cpp"
+#line 3230 "yacc_sql.cpp"
     break;
 
-  case 129: /* join_conditions: %empty  */
-#line 1057 "yacc_sql.y"
+  case 143: /* join_conditions: %empty  */
+#line 1176 "yacc_sql.y"
     {
       (yyval.condition_list) = nullptr;
     }
-#line 3058 "yacc_sql.cpp"
+#line 3238 "yacc_sql.cpp"
     break;
 
-  case 130: /* join_conditions: ON condition_list  */
-#line 1061 "yacc_sql.y"
+  case 144: /* join_conditions: ON condition_list  */
+#line 1180 "yacc_sql.y"
         {
 	  (yyval.condition_list) = (yyvsp[0].condition_list);
 	}
-#line 3066 "yacc_sql.cpp"
+#line 3246 "yacc_sql.cpp"
     break;
 
-  case 131: /* where_conditions: %empty  */
-#line 1068 "yacc_sql.y"
+  case 145: /* where_conditions: %empty  */
+#line 1187 "yacc_sql.y"
     {
       (yyval.condition_list) = nullptr;
     }
-#line 3074 "yacc_sql.cpp"
+#line 3254 "yacc_sql.cpp"
     break;
 
-  case 132: /* where_conditions: WHERE condition_list  */
-#line 1071 "yacc_sql.y"
+  case 146: /* where_conditions: WHERE condition_list  */
+#line 1190 "yacc_sql.y"
                            {
       (yyval.condition_list) = (yyvsp[0].condition_list);  
     }
-#line 3082 "yacc_sql.cpp"
+#line 3262 "yacc_sql.cpp"
     break;
 
-  case 133: /* condition_list: %empty  */
-#line 1077 "yacc_sql.y"
+  case 147: /* condition_list: %empty  */
+#line 1196 "yacc_sql.y"
                 {
       (yyval.condition_list) = nullptr;
     }
-#line 3090 "yacc_sql.cpp"
+#line 3270 "yacc_sql.cpp"
     break;
 
-  case 134: /* condition_list: condition  */
-#line 1079 "yacc_sql.y"
+  case 148: /* condition_list: condition  */
+#line 1198 "yacc_sql.y"
                   {
       (yyval.condition_list) = new WhereConditions;
       (yyval.condition_list)->conditions.emplace_back(*(yyvsp[0].condition));
       delete (yyvsp[0].condition);
     }
-#line 3100 "yacc_sql.cpp"
+#line 3280 "yacc_sql.cpp"
     break;
 
-  case 135: /* condition_list: condition AND condition_list  */
-#line 1083 "yacc_sql.y"
+  case 149: /* condition_list: condition AND condition_list  */
+#line 1202 "yacc_sql.y"
                                      {
       (yyval.condition_list) = (yyvsp[0].condition_list);
       (yyval.condition_list)->type = ConjunctionType::AND;
       (yyval.condition_list)->conditions.emplace_back(*(yyvsp[-2].condition));
       delete (yyvsp[-2].condition);
     }
-#line 3111 "yacc_sql.cpp"
+#line 3291 "yacc_sql.cpp"
     break;
 
-  case 136: /* condition_list: condition OR condition_list  */
-#line 1088 "yacc_sql.y"
+  case 150: /* condition_list: condition OR condition_list  */
+#line 1207 "yacc_sql.y"
                                     {
+      if ((yyvsp[0].condition_list) == nullptr) {
+        delete (yyvsp[-2].condition);
+        yyerror(&(yyloc), sql_string, sql_result, scanner, "missing condition after OR");
+        YYERROR;
+      }
+      if ((yyvsp[0].condition_list)->has_range) {
+        delete (yyvsp[-2].condition);
+        delete (yyvsp[0].condition_list);
+        yyerror(&(yyloc), sql_string, sql_result, scanner, "BETWEEN cannot be mixed with OR");
+        YYERROR;
+      }
       (yyval.condition_list) = (yyvsp[0].condition_list);
       (yyval.condition_list)->type = ConjunctionType::OR;
       (yyval.condition_list)->conditions.emplace_back(*(yyvsp[-2].condition));
       delete (yyvsp[-2].condition);
 
     }
-#line 3123 "yacc_sql.cpp"
+#line 3314 "yacc_sql.cpp"
+    break;
+
+  case 151: /* condition_list: add_expr BETWEEN add_expr AND add_expr  */
+#line 1224 "yacc_sql.y"
+                                               {
+      (yyval.condition_list) = new WhereConditions;
+      (yyval.condition_list)->has_range = true;
+      append_between_conditions((yyval.condition_list), (yyvsp[-4].expression), (yyvsp[-2].expression), (yyvsp[0].expression));
+    }
+#line 3324 "yacc_sql.cpp"
+    break;
+
+  case 152: /* condition_list: add_expr BETWEEN add_expr AND add_expr AND condition_list  */
+#line 1228 "yacc_sql.y"
+                                                                  {
+      (yyval.condition_list) = (yyvsp[0].condition_list);
+      (yyval.condition_list)->type = ConjunctionType::AND;
+      (yyval.condition_list)->has_range = true;
+      append_between_conditions((yyval.condition_list), (yyvsp[-6].expression), (yyvsp[-4].expression), (yyvsp[-2].expression));
+    }
+#line 3335 "yacc_sql.cpp"
+    break;
+
+  case 153: /* condition_list: add_expr BETWEEN add_expr AND add_expr OR condition_list  */
+#line 1233 "yacc_sql.y"
+                                                                 {
+      delete (yyvsp[-6].expression);
+      delete (yyvsp[-4].expression);
+      delete (yyvsp[-2].expression);
+      delete (yyvsp[0].condition_list);
+      yyerror(&(yyloc), sql_string, sql_result, scanner, "BETWEEN cannot be mixed with OR");
+      YYERROR;
+    }
+#line 3348 "yacc_sql.cpp"
     break;
 
-  case 137: /* condition: add_expr comp_op add_expr  */
-#line 1098 "yacc_sql.y"
+  case 154: /* condition: add_expr comp_op add_expr  */
+#line 1244 "yacc_sql.y"
                               {
       (yyval.condition) = new ConditionSqlNode;
       (yyval.condition)->left_expr = (yyvsp[-2].expression);
       (yyval.condition)->right_expr = (yyvsp[0].expression);
       (yyval.condition)->comp = (yyvsp[-1].comp);
     }
-#line 3134 "yacc_sql.cpp"
+#line 3359 "yacc_sql.cpp"
     break;
 
-  case 138: /* condition: add_expr IS NULL_T  */
-#line 1103 "yacc_sql.y"
+  case 155: /* condition: add_expr IS NULL_T  */
+#line 1249 "yacc_sql.y"
                            {
       (yyval.condition) = new ConditionSqlNode;
       (yyval.condition)->left_expr = (yyvsp[-2].expression);
       (yyval.condition)->comp = IS_NULL;
     }
-#line 3144 "yacc_sql.cpp"
+#line 3369 "yacc_sql.cpp"
     break;
 
-  case 139: /* condition: add_expr IS NOT_T NULL_T  */
-#line 1109 "yacc_sql.y"
+  case 156: /* condition: add_expr IS NOT_T NULL_T  */
+#line 1255 "yacc_sql.y"
                              {
       (yyval.condition) = new ConditionSqlNode;
       (yyval.condition)->left_expr = (yyvsp[-3].expression);
       (yyval.condition)->comp = IS_NOT_NULL;
     }
-#line 3154 "yacc_sql.cpp"
+#line 3379 "yacc_sql.cpp"
     break;
 
-  case 140: /* condition: add_expr IN_T add_expr  */
-#line 1113 "yacc_sql.y"
+  case 157: /* condition: add_expr IN_T add_expr  */
+#line 1259 "yacc_sql.y"
                                {
       (yyval.condition) = new ConditionSqlNode;
       (yyval.condition)->left_expr = (yyvsp[-2].expression);
       (yyval.condition)->right_expr = (yyvsp[0].expression);
       (yyval.condition)->comp = IN;
     }
-#line 3165 "yacc_sql.cpp"
+#line 3390 "yacc_sql.cpp"
     break;
 
-  case 141: /* condition: add_expr NOT_T IN_T add_expr  */
-#line 1118 "yacc_sql.y"
+  case 158: /* condition: add_expr NOT_T IN_T add_expr  */
+#line 1264 "yacc_sql.y"
                                      {
       (yyval.condition) = new ConditionSqlNode;
       (yyval.condition)->left_expr = (yyvsp[-3].expression);
       (yyval.condition)->right_expr = (yyvsp[0].expression);
       (yyval.condition)->comp = NOT_IN;
     }
-#line 3176 "yacc_sql.cpp"
+#line 3401 "yacc_sql.cpp"
     break;
 
-  case 142: /* condition: EXISTS_T add_expr  */
-#line 1124 "yacc_sql.y"
+  case 159: /* condition: EXISTS_T add_expr  */
+#line 1270 "yacc_sql.y"
                         {
       (yyval.condition) = new ConditionSqlNode;
       (yyval.condition)->left_expr = (yyvsp[0].expression);
       (yyval.condition)->comp = EXISTS;
     }
-#line 3186 "yacc_sql.cpp"
+#line 3411 "yacc_sql.cpp"
     break;
 
-  case 143: /* condition: NOT_T EXISTS_T add_expr  */
-#line 1129 "yacc_sql.y"
+  case 160: /* condition: NOT_T EXISTS_T add_expr  */
+#line 1275 "yacc_sql.y"
                               {
       (yyval.condition) = new ConditionSqlNode;
       (yyval.condition)->left_expr = (yyvsp[0].expression);
       (yyval.condition)->comp = NOT_EXISTS;
     }
-#line 3196 "yacc_sql.cpp"
+#line 3421 "yacc_sql.cpp"
     break;
 
-  case 144: /* comp_op: EQ  */
-#line 1137 "yacc_sql.y"
+  case 161: /* comp_op: EQ  */
+#line 1283 "yacc_sql.y"
          { (yyval.comp) = EQUAL_TO; }
-#line 3202 "yacc_sql.cpp"
+#line 3427 "yacc_sql.cpp"
     break;
 
-  case 145: /* comp_op: LT  */
-#line 1138 "yacc_sql.y"
+  case 162: /* comp_op: LT  */
+#line 1284 "yacc_sql.y"
          { (yyval.comp) = LESS_THAN; }
-#line 3208 "yacc_sql.cpp"
+#line 3433 "yacc_sql.cpp"
     break;
 
-  case 146: /* comp_op: GT  */
-#line 1139 "yacc_sql.y"
+  case 163: /* comp_op: GT  */
+#line 1285 "yacc_sql.y"
          { (yyval.comp) = GREAT_THAN; }
-#line 3214 "yacc_sql.cpp"
+#line 3439 "yacc_sql.cpp"
     break;
 
-  case 147: /* comp_op: LE  */
-#line 1140 "yacc_sql.y"
+  case 164: /* comp_op: LE  */
+#line 1286 "yacc_sql.y"
          { (yyval.comp) = LESS_EQUAL; }
-#line 3220 "yacc_sql.cpp"
+#line 3445 "yacc_sql.cpp"
     break;
 
-  case 148: /* comp_op: GE  */
-#line 1141 "yacc_sql.y"
+  case 165: /* comp_op: GE  */
+#line 1287 "yacc_sql.y"
          { (yyval.comp) = GREAT_EQUAL; }
-#line 3226 "yacc_sql.cpp"
+#line 3451 "yacc_sql.cpp"
     break;
 
-  case 149: /* comp_op: NE  */
-#line 1142 "yacc_sql.y"
+  case 166: /* comp_op: NE  */
+#line 1288 "yacc_sql.y"
          { (yyval.comp) = NOT_EQUAL; }
-#line 3232 "yacc_sql.cpp"
+#line 3457 "yacc_sql.cpp"
     break;
 
-  case 150: /* comp_op: LIKE_T  */
-#line 1143 "yacc_sql.y"
+  case 167: /* comp_op: LIKE_T  */
+#line 1289 "yacc_sql.y"
              { (yyval.comp) = LIKE_OP; }
-#line 3238 "yacc_sql.cpp"
+#line 3463 "yacc_sql.cpp"
     break;
 
-  case 151: /* comp_op: NOT_T LIKE_T  */
-#line 1144 "yacc_sql.y"
+  case 168: /* comp_op: NOT_T LIKE_T  */
+#line 1290 "yacc_sql.y"
                    { (yyval.comp) = NOT_LIKE_OP; }
-#line 3244 "yacc_sql.cpp"
+#line 3469 "yacc_sql.cpp"
     break;
 
-  case 152: /* load_data_stmt: LOAD DATA INFILE SSS INTO TABLE ID  */
-#line 1149 "yacc_sql.y"
+  case 169: /* load_data_stmt: LOAD DATA INFILE SSS INTO TABLE ID  */
+#line 1295 "yacc_sql.y"
     {
       char *tmp_file_name = common::substr((yyvsp[-3].string), 1, strlen((yyvsp[-3].string)) - 2);
       
@@ -3254,20 +3479,20 @@ yyreduce:
       free((yyvsp[0].string));
       free(tmp_file_name);
     }
-#line 3258 "yacc_sql.cpp"
+#line 3483 "yacc_sql.cpp"
     break;
 
-  case 153: /* explain_stmt: EXPLAIN command_wrapper  */
-#line 1162 "yacc_sql.y"
+  case 170: /* explain_stmt: EXPLAIN command_wrapper  */
+#line 1308 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_EXPLAIN);
       (yyval.sql_node)->explain.sql_node = std::unique_ptr<ParsedSqlNode>((yyvsp[0].sql_node));
     }
-#line 3267 "yacc_sql.cpp"
+#line 3492 "yacc_sql.cpp"
     break;
 
-  case 154: /* set_variable_stmt: SET ID EQ value  */
-#line 1170 "yacc_sql.y"
+  case 171: /* set_variable_stmt: SET ID EQ value  */
+#line 1316 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_SET_VARIABLE);
       (yyval.sql_node)->set_variable.name  = (yyvsp[-2].string);
@@ -3275,11 +3500,87 @@ yyreduce:
       free((yyvsp[-2].string));
       delete (yyvsp[0].value);
     }
-#line 3279 "yacc_sql.cpp"
+#line 3504 "yacc_sql.cpp"
+    break;
+
+  case 172: /* prepare_stmt: PREPARE ID FROM SSS  */
+#line 1327 "yacc_sql.y"
+    {
+      char *tmp = common::substr((yyvsp[0].string),1,strlen((yyvsp[0].string))-2);
+      (yyval.sql_node) = new ParsedSqlNode(SCF_PREPARE);
+      (yyval.sql_node)->prepare.name = (yyvsp[-2].string);
+      (yyval.sql_node)->prepare.sql = tmp;
+      free(tmp);
+      free((yyvsp[-2].string));
+      free((yyvsp[0].string));
+    }
+#line 3518 "yacc_sql.cpp"
+    break;
+
+  case 173: /* execute_stmt: EXECUTE ID  */
+#line 1340 "yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_EXECUTE);
+      (yyval.sql_node)->execute.name = (yyvsp[0].string);
+      free((yyvsp[0].string));
+    }
+#line 3528 "yacc_sql.cpp"
+    break;
+
+  case 174: /* execute_stmt: EXECUTE ID USING value value_list_body  */
+#line 1346 "yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_EXECUTE);
+      (yyval.sql_node)->execute.name = (yyvsp[-3].string);
+      if ((yyvsp[0].value_list_body) != nullptr) {
+        (yyval.sql_node)->execute.params.swap(*(yyvsp[0].value_list_body));
+        delete (yyvsp[0].value_list_body);
+      }
+      (yyval.sql_node)->execute.params.emplace_back(*(yyvsp[-1].value));
+      std::reverse((yyval.sql_node)->execute.params.begin(), (yyval.sql_node)->execute.params.end());
+      free((yyvsp[-3].string));
+      delete (yyvsp[-1].value);
+    }
+#line 3545 "yacc_sql.cpp"
+    break;
+
+  case 175: /* deallocate_stmt: DEALLOCATE PREPARE ID  */
+#line 1362 "yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_DEALLOCATE_PREPARE);
+      (yyval.sql_node)->deallocate.name = (yyvsp[0].string);
+      free((yyvsp[0].string));
+    }
+#line 3555 "yacc_sql.cpp"
+    break;
+
+  case 176: /* deallocate_stmt: DROP PREPARE ID  */
+#line 1368 "yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_DEALLOCATE_PREPARE);
+      (yyval.sql_node)->deallocate.name = (yyvsp[0].string);
+      free((yyvsp[0].string));
+    }
+#line 3565 "yacc_sql.cpp"
+    break;
+
+  case 177: /* reset_session_stmt: RESET ID  */
+#line 1377 "yacc_sql.y"
+    {
+      // SESSION 不作为关键字，避免不能再用作表名或者列名
+      const bool is_session = 0 == strcasecmp((yyvsp[0].string), "SESSION");
+      free((yyvsp[0].string));
+      if (!is_session) {
+        yyerror(&(yyloc), sql_string, sql_result, scanner, "only RESET SESSION is supported");
+        YYERROR;
+      }
+      (yyval.sql_node) = new ParsedSqlNode(SCF_RESET_SESSION);
+    }
+#line 3580 "yacc_sql.cpp"
     break;
 
 
-#line 3283 "yacc_sql.cpp"
+#line 3584 "yacc_sql.cpp"
 
       default: break;
     }
@@ -3508,7 +3809,7 @@ yyreturnlab:
   return yyresult;
 }
 
-#line 1182 "yacc_sql.y"
+#line 1392 "yacc_sql.y"
 
 
 //_____________________________________________________________________
@@ -66,66 +66,75 @@ extern int yydebug;
     SELECT = 267,                  /* SELECT  */
     ASC = 268,                     /* ASC  */
     DESC = 269,                    /* DESC  */
-    ORDER = 270,                   /* ORDER  */
-    BY = 271,                      /* BY  */
-    IS = 272,                      /* IS  */
-    NULL_T = 273,                  /* NULL_T  */
-    SHOW = 274,                    /* SHOW  */
-    SYNC = 275,                    /* SYNC  */
-    INSERT = 276,                  /* INSERT  */
-    DELETE = 277,                  /* DELETE  */
-    UPDATE = 278,                  /* UPDATE  */
-    LBRACE = 279,                  /* LBRACE  */
-    RBRACE = 280,                  /* RBRACE  */
-    COMMA = 281,                   /* COMMA  */
-    TRX_BEGIN = 282,               /* TRX_BEGIN  */
-    TRX_COMMIT = 283,              /* TRX_COMMIT  */
-    TRX_ROLLBACK = 284,            /* TRX_ROLLBACK  */
-    INT_T = 285,                   /* INT_T  */
-    STRING_T = 286,                /* STRING_T  */
-    FLOAT_T = 287,                 /* FLOAT_T  */
-    DATE_T = 288,                  /* DATE_T  */
-    TEXT_T = 289,                  /* TEXT_T  */
-    NOT_T = 290,                   /* NOT_T  */
-    LIKE_T = 291,                  /* LIKE_T  */
-    COUNT_T = 292,                 /* COUNT_T  */
-    MIN_T = 293,                   /* MIN_T  */
-    MAX_T = 294,                   /* MAX_T  */
-    AVG_T = 295,                   /* AVG_T  */
-    SUM_T = 296,                   /* SUM_T  */
-    HELP = 297,                    /* HELP  */
-    EXIT = 298,                    /* EXIT  */
-    DOT = 299,                     /* DOT  */
-    INTO = 300,                    /* INTO  */
-    VALUES = 301,                  /* VALUES  */
-    FROM = 302,                    /* FROM  */
-    WHERE = 303,                   /* WHERE  */
-    AND = 304,                     /* AND  */
-    OR = 305,                      /* OR  */
-    SET = 306,                     /* SET  */
-    INNER = 307,                   /* INNER  */
-    JOIN = 308,                    /* JOIN  */
-    ON = 309,                      /* ON  */
-    LOAD = 310,                    /* LOAD  */
-    DATA = 311,                    /* DATA  */
-    INFILE = 312,                  /* INFILE  */
-    EXPLAIN = 313,                 /* EXPLAIN  */
-    GROUP = 314,                   /* GROUP  */
-    HAVING = 315,                  /* HAVING  */
-    AS = 316,                      /* AS  */
-    IN_T = 317,                    /* IN_T  */
-    EXISTS_T = 318,                /* EXISTS_T  */
-    EQ = 319,                      /* EQ  */
-    LT = 320,                      /* LT  */
-    GT = 321,                      /* GT  */
-    LE = 322,                      /* LE  */
-    GE = 323,                      /* GE  */
-    NE = 324,                      /* NE  */
-    NUMBER = 325,                  /* NUMBER  */
-    FLOAT = 326,                   /* FLOAT  */
-    ID = 327,                      /* ID  */
-    SSS = 328,                     /* SSS  */
-    DATE_STR = 329                 /* DATE_STR  */
+    ANALYZE = 270,                 /* ANALYZE  */
+    PREPARE = 271,                 /* PREPARE  */
+    EXECUTE = 272,                 /* EXECUTE  */
+    DEALLOCATE = 273,              /* DEALLOCATE  */
+    USING = 274,                   /* USING  */
+    RESET = 275,                   /* RESET  */
+    ORDER = 276,                   /* ORDER  */
+    BY = 277,                      /* BY  */
+    IS = 278,                      /* IS  */
+    NULL_T = 279,                  /* NULL_T  */
+    SHOW = 280,                    /* SHOW  */
+    SYNC = 281,                    /* SYNC  */
+    INSERT = 282,                  /* INSERT  */
+    DELETE = 283,                  /* DELETE  */
+    UPDATE = 284,                  /* UPDATE  */
+    LBRACE = 285,                  /* LBRACE  */
+    RBRACE = 286,                  /* RBRACE  */
+    COMMA = 287,                   /* COMMA  */
+    TRX_BEGIN = 288,               /* TRX_BEGIN  */
+    TRX_COMMIT = 289,              /* TRX_COMMIT  */
+    TRX_ROLLBACK = 290,            /* TRX_ROLLBACK  */
+    INT_T = 291,                   /* INT_T  */
+    STRING_T = 292,                /* STRING_T  */
+    FLOAT_T = 293,                 /* FLOAT_T  */
+    DATE_T = 294,                  /* DATE_T  */
+    TEXT_T = 295,                  /* TEXT_T  */
+    NOT_T = 296,                   /* NOT_T  */
+    LIKE_T = 297,                  /* LIKE_T  */
+    COUNT_T = 298,                 /* COUNT_T  */
+    MIN_T = 299,                   /* MIN_T  */
+    MAX_T = 300,                   /* MAX_T  */
+    AVG_T = 301,                   /* AVG_T  */
+    SUM_T = 302,                   /* SUM_T  */
+    HELP = 303,                    /* HELP  */
+    EXIT = 304,                    /* EXIT  */
+    DOT = 305,                     /* DOT  */
+    INTO = 306,                    /* INTO  */
+    VALUES = 307,                  /* VALUES  */
+    FROM = 308,                    /* FROM  */
+    WHERE = 309,                   /* WHERE  */
+    AND = 310,                     /* AND  */
+    OR = 311,                      /* OR  */
+    SET = 312,                     /* SET  */
+    INNER = 313,                   /* INNER  */
+    JOIN = 314,                    /* JOIN  */
+    ON = 315,                      /* ON  */
+    LOAD = 316,                    /* LOAD  */
+    DATA = 317,                    /* DATA  */
+    INFILE = 318,                  /* INFILE  */
+    EXPLAIN = 319,                 /* EXPLAIN  */
+    GROUP = 320,                   /* GROUP  */
+    HAVING = 321,                  /* HAVING  */
+    LIMIT = 322,                   /* LIMIT  */
+    OFFSET = 323,                  /* OFFSET  */
+    BETWEEN = 324,                 /* BETWEEN  */
+    AS = 325,                      /* AS  */
+    IN_T = 326,                    /* IN_T  */
+    EXISTS_T = 327,                /* EXISTS_T  */
+    EQ = 328,                      /* EQ  */
+    LT = 329,                      /* LT  */
+    GT = 330,                      /* GT  */
+    LE = 331,                      /* LE  */
+    GE = 332,                      /* GE  */
+    NE = 333,                      /* NE  */
+    NUMBER = 334,                  /* NUMBER  */
+    FLOAT = 335,                   /* FLOAT  */
+    ID = 336,                      /* ID  */
+    SSS = 337,                     /* SSS  */
+    DATE_STR = 338                 /* DATE_STR  */
   };
   typedef enum yytokentype yytoken_kind_t;
 #endif
@@ -134,7 +143,7 @@ extern int yydebug;
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
 union YYSTYPE
 {
-#line 132 "yacc_sql.y"
+#line 160 "yacc_sql.y"
 
   ParsedSqlNode *                   sql_node;
   ConditionSqlNode *                condition;
@@ -149,6 +158,7 @@ union YYSTYPE
   UpdateUnit *                      update_info;
   std::vector<OrderByNode> *        order_infos;
   OrderByNode *                     order_info;
+  LimitSqlNode *                    limit_info;
   Expression *                      expression;
   std::vector<Expression *> *       expression_list;
   std::vector<Value> *              value_list;
@@ -162,7 +172,7 @@ union YYSTYPE
   int                               number;
   float                             floats;
 
-#line 166 "yacc_sql.hpp"
+#line 176 "yacc_sql.hpp"
 
 };
 typedef union YYSTYPE YYSTYPE;
@@ -18,6 +18,7 @@
 #include "include/query_engine/structor/expression/field_expression.h"
 #include "include/query_engine/structor/expression/value_expression.h"
 #include "include/query_engine/structor/expression/attribute_expression.h"
+#include "include/query_engine/structor/expression/param_expression.h"
 
 using namespace std;
 
@@ -47,6 +48,24 @@ ArithmeticExpr *create_arithmetic_expression(ArithmeticExpr::Type type,
   return expr;
 }
 
+/**
+ * @brief 把 expr BETWEEN low AND high 展开成 expr >= low AND expr <= high
+ */
+void append_between_conditions(WhereConditions *conditions, Expression *expr, Expression *low, Expression *high)
+{
+  ConditionSqlNode high_condition;
+  high_condition.left_expr = expr->copy();
+  high_condition.comp = LESS_EQUAL;
+  high_condition.right_expr = high;
+  conditions->conditions.emplace_back(high_condition);
+
+  ConditionSqlNode low_condition;
+  low_condition.left_expr = expr;
+  low_condition.comp = GREAT_EQUAL;
+  low_condition.right_expr = low;
+  conditions->conditions.emplace_back(low_condition);
+}
+
 %}
 
 %define api.pure full
@@ -72,6 +91,12 @@ ArithmeticExpr *create_arithmetic_expression(ArithmeticExpr::Type type,
         SELECT
         ASC
         DESC
+        ANALYZE
+        PREPARE
+        EXECUTE
+        DEALLOCATE
+        USING
+        RESET
         ORDER
         BY
         IS
@@ -118,6 +143,9 @@ ArithmeticExpr *create_arithmetic_expression(ArithmeticExpr::Type type,
         EXPLAIN
         GROUP
         HAVING
+        LIMIT
+        OFFSET
+        BETWEEN
         AS
         IN_T
         EXISTS_T
@@ -143,6 +171,7 @@ ArithmeticExpr *create_arithmetic_expression(ArithmeticExpr::Type type,
   UpdateUnit *                      update_info;
   std::vector<OrderByNode> *        order_infos;
   OrderByNode *                     order_info;
+  LimitSqlNode *                    limit_info;
   Expression *                      expression;
   std::vector<Expression *> *       expression_list;
   std::vector<Value> *              value_list;
@@ -181,6 +210,7 @@ ArithmeticExpr *create_arithmetic_expression(ArithmeticExpr::Type type,
 %type <order_infos>         opt_order_by
 %type <order_infos>         sort_def_list
 %type <order_info>          sort_def
+%type <limit_info>          opt_limit
 %type <value_list>          value_list
 %type <value_list_body>     value_list_body
 %type <multi_value_list>    multi_value_list
@@ -209,6 +239,7 @@ ArithmeticExpr *create_arithmetic_expression(ArithmeticExpr::Type type,
 %type <sql_node>            drop_table_stmt
 %type <sql_node>            show_tables_stmt
 %type <sql_node>            desc_table_stmt
+%type <sql_node>            analyze_stmt
 %type <sql_node>            create_index_stmt
 %type <sql_node>            drop_index_stmt
 %type <sql_node>            sync_stmt
@@ -218,6 +249,10 @@ ArithmeticExpr *create_arithmetic_expression(ArithmeticExpr::Type type,
 %type <sql_node>            load_data_stmt
 %type <sql_node>            explain_stmt
 %type <sql_node>            set_variable_stmt
+%type <sql_node>            prepare_stmt
+%type <sql_node>            execute_stmt
+%type <sql_node>            deallocate_stmt
+%type <sql_node>            reset_session_stmt
 %type <sql_node>            help_stmt
 %type <sql_node>            exit_stmt
 %type <sql_node>            command_wrapper
@@ -247,6 +282,7 @@ command_wrapper:
   | drop_table_stmt
   | show_tables_stmt
   | desc_table_stmt
+  | analyze_stmt
   | create_index_stmt
   | drop_index_stmt
   | sync_stmt
@@ -256,6 +292,10 @@ command_wrapper:
   | load_data_stmt
   | explain_stmt
   | set_variable_stmt
+  | prepare_stmt
+  | execute_stmt
+  | deallocate_stmt
+  | reset_session_stmt
   | help_stmt
   | exit_stmt
     ;
@@ -316,6 +356,17 @@ desc_table_stmt:
     }
     ;
 
+analyze_stmt:
+    ANALYZE ID  {
+      $$ = new ParsedSqlNode(SCF_ANALYZE_TABLE);
+      $$->analyze_table.relation_name = $2;
+      free($2);
+    }
+    | ANALYZE  {
+      $$ = new ParsedSqlNode(SCF_ANALYZE_TABLE);
+    }
+    ;
+
 create_index_stmt:    /*create index 语句的语法解析树*/
   CREATE UNIQUE INDEX ID ON ID LBRACE ID multi_attribute_names RBRACE
   {
@@ -333,6 +384,24 @@ create_index_stmt:    /*create index 语句的语法解析树*/
 	free($6);
 	free($8);
   }
+  | CREATE UNIQUE INDEX ID ON ID LBRACE ID multi_attribute_names RBRACE USING ID
+  {
+	$$ = new ParsedSqlNode(SCF_CREATE_INDEX);
+	CreateIndexSqlNode &create_index = $$->create_index;
+	create_index.index_name = $4;
+	create_index.relation_name = $6;
+	create_index.is_unique_ = true;
+	create_index.index_type = $12;
+	if ($9 != nullptr) {
+	create_index.multi_attribute_names.swap(*$9);
+	}
+	create_index.multi_attribute_names.emplace_back($8);
+	std::reverse(create_index.multi_attribute_names.begin(), create_index.multi_attribute_names.end());
+	free($4);
+	free($6);
+	free($8);
+	free($12);
+  }
   | CREATE INDEX ID ON ID LBRACE ID multi_attribute_names RBRACE
   {
 	$$ = new ParsedSqlNode(SCF_CREATE_INDEX);
@@ -349,6 +418,24 @@ create_index_stmt:    /*create index 语句的语法解析树*/
 	free($5);
 	free($7);
   }
+  | CREATE INDEX ID ON ID LBRACE ID multi_attribute_names RBRACE USING ID
+  {
+	$$ = new ParsedSqlNode(SCF_CREATE_INDEX);
+	CreateIndexSqlNode &create_index = $$->create_index;
+	create_index.index_name = $3;
+	create_index.relation_name = $5;
+	create_index.is_unique_ = false;
+	create_index.index_type = $11;
+	if ($8 != nullptr) {
+	create_index.multi_attribute_names.swap(*$8);
+	}
+	create_index.multi_attribute_names.emplace_back($7);
+	std::reverse(create_index.multi_attribute_names.begin(), create_index.multi_attribute_names.end());
+	free($3);
+	free($5);
+	free($7);
+	free($11);
+  }
   ;
 
 multi_attribute_names:
@@ -662,7 +749,7 @@ update_def:
     ;
 
 select_stmt:        /*  select 语句的语法解析树*/
-    SELECT select_attr FROM relation_list join_list where_conditions opt_group_by opt_having opt_order_by {
+    SELECT select_attr FROM relation_list join_list where_conditions opt_group_by opt_having opt_order_by opt_limit {
       $$ = new ParsedSqlNode(SCF_SELECT);
 
       $$->selection.attributes.swap(*$2);
@@ -700,6 +787,10 @@ select_stmt:        /*  select 语句的语法解析树*/
         std::reverse($$->selection.order_lists.begin(), $$->selection.order_lists.end());
         delete $9;
       }
+      if ($10 != nullptr) {
+        $$->selection.limit = *$10;
+        delete $10;
+      }
     }
     ;
 
@@ -731,6 +822,31 @@ opt_order_by:
 	}
 	;
 
+opt_limit:
+    /* empty */
+    {
+      $$ = nullptr;
+    }
+    | LIMIT NUMBER
+    {
+      $$ = new LimitSqlNode;
+      $$->limit = $2;
+    }
+    | LIMIT NUMBER OFFSET NUMBER
+    {
+      $$ = new LimitSqlNode;
+      $$->limit = $2;
+      $$->offset = $4;
+    }
+    | LIMIT NUMBER COMMA NUMBER
+    {
+      // MySQL 风格: limit offset, count
+      $$ = new LimitSqlNode;
+      $$->limit = $4;
+      $$->offset = $2;
+    }
+    ;
+
 sort_def_list:
     sort_def
 	{
@@ -805,6 +921,9 @@ base_expr:
       $$ = new ValueExpr(*$1);
       $$->set_name(token_name(sql_string, &@$));
       delete $1;
+    } | '?' {
+      $$ = new ParamExpr(sql_result->next_param_index());
+      $$->set_name(token_name(sql_string, &@$));
     } | rel_attr {
       $$ = new RelAttrExpr(*$1);
       $$->set_name(token_name(sql_string, &@$));
@@ -1086,11 +1205,38 @@ condition_list:
       $$->conditions.emplace_back(*$1);
       delete $1;
     } | condition OR condition_list {
+      if ($3 == nullptr) {
+        delete $1;
+        yyerror(&@$, sql_string, sql_result, scanner, "missing condition after OR");
+        YYERROR;
+      }
+      if ($3->has_range) {
+        delete $1;
+        delete $3;
+        yyerror(&@$, sql_string, sql_result, scanner, "BETWEEN cannot be mixed with OR");
+        YYERROR;
+      }
       $$ = $3;
       $$->type = ConjunctionType::OR;
       $$->conditions.emplace_back(*$1);
       delete $1;
 
+    } | add_expr BETWEEN add_expr AND add_expr {
+      $$ = new WhereConditions;
+      $$->has_range = true;
+      append_between_conditions($$, $1, $3, $5);
+    } | add_expr BETWEEN add_expr AND add_expr AND condition_list {
+      $$ = $7;
+      $$->type = ConjunctionType::AND;
+      $$->has_range = true;
+      append_between_conditions($$, $1, $3, $5);
+    } | add_expr BETWEEN add_expr AND add_expr OR condition_list {
+      delete $1;
+      delete $3;
+      delete $5;
+      delete $7;
+      yyerror(&@$, sql_string, sql_result, scanner, "BETWEEN cannot be mixed with OR");
+      YYERROR;
     }
     ;
 
@@ -1176,6 +1322,70 @@ set_variable_stmt:
     }
     ;
 
+prepare_stmt:
+    PREPARE ID FROM SSS
+    {
+      char *tmp = common::substr($4,1,strlen($4)-2);
+      $$ = new ParsedSqlNode(SCF_PREPARE);
+      $$->prepare.name = $2;
+      $$->prepare.sql = tmp;
+      free(tmp);
+      free($2);
+      free($4);
+    }
+    ;
+
+execute_stmt:
+    EXECUTE ID
+    {
+      $$ = new ParsedSqlNode(SCF_EXECUTE);
+      $$->execute.name = $2;
+      free($2);
+    }
+    | EXECUTE ID USING value value_list_body
+    {
+      $$ = new ParsedSqlNode(SCF_EXECUTE);
+      $$->execute.name = $2;
+      if ($5 != nullptr) {
+        $$->execute.params.swap(*$5);
+        delete $5;
+      }
+      $$->execute.params.emplace_back(*$4);
+      std::reverse($$->execute.params.begin(), $$->execute.params.end());
+      free($2);
+      delete $4;
+    }
+    ;
+
+deallocate_stmt:
+    DEALLOCATE PREPARE ID
+    {
+      $$ = new ParsedSqlNode(SCF_DEALLOCATE_PREPARE);
+      $$->deallocate.name = $3;
+      free($3);
+    }
+    | DROP PREPARE ID
+    {
+      $$ = new ParsedSqlNode(SCF_DEALLOCATE_PREPARE);
+      $$->deallocate.name = $3;
+      free($3);
+    }
+    ;
+
+reset_session_stmt:
+    RESET ID
+    {
+      // SESSION 不作为关键字，避免不能再用作表名或者列名
+      const bool is_session = 0 == strcasecmp($2, "SESSION");
+      free($2);
+      if (!is_session) {
+        yyerror(&@$, sql_string, sql_result, scanner, "only RESET SESSION is supported");
+        YYERROR;
+      }
+      $$ = new ParsedSqlNode(SCF_RESET_SESSION);
+    }
+    ;
+
 opt_semicolon: /*empty*/
     | SEMICOLON
     ;
@@ -9,3 +9,17 @@ AggrLogicalNode::AggrLogicalNode(const std::vector<AggrExpr *> &aggr_expressions
     aggr_fields_.emplace_back(field_expr->field());
   }
 }
+
+void AggrLogicalNode::copy_aggr_to(AggrLogicalNode &node) const
+{
+  node.alias_       = alias_;
+  node.aggr_types_  = aggr_types_;
+  node.aggr_fields_ = aggr_fields_;
+}
+
+std::unique_ptr<LogicalNode> AggrLogicalNode::clone() const
+{
+  std::unique_ptr<AggrLogicalNode> node(new AggrLogicalNode());
+  copy_aggr_to(*node);
+  return clone_to(std::move(node));
+}
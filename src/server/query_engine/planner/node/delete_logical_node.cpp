@@ -2,3 +2,8 @@
 
 DeleteLogicalNode::DeleteLogicalNode(Table *table) : table_(table)
 {}
+
+std::unique_ptr<LogicalNode> DeleteLogicalNode::clone() const
+{
+  return clone_to(std::make_unique<DeleteLogicalNode>(table_));
+}
@@ -4,4 +4,11 @@
 GroupByLogicalNode::GroupByLogicalNode(
     const std::vector<Expression *> &field_exprs,
     const std::vector<AggrExpr *> &aggr_exprs)
-    : AggrLogicalNode(aggr_exprs) {}
\ No newline at end of file
+    : AggrLogicalNode(aggr_exprs) {}
+
+std::unique_ptr<LogicalNode> GroupByLogicalNode::clone() const
+{
+  std::unique_ptr<GroupByLogicalNode> node(new GroupByLogicalNode());
+  copy_aggr_to(*node);
+  return clone_to(std::move(node));
+}
@@ -4,3 +4,8 @@ InsertLogicalNode::InsertLogicalNode(Table *table, const std::vector<std::vector
     : table_(table), multi_values_(multi_values)
 {
 }
+
+std::unique_ptr<LogicalNode> InsertLogicalNode::clone() const
+{
+  return clone_to(std::make_unique<InsertLogicalNode>(table_, multi_values_));
+}
@@ -1 +1,18 @@
-// TODO [Lab3] 根据需要实现该类
\ No newline at end of file
+#include "include/query_engine/planner/node/join_logical_node.h"
+
+std::unique_ptr<LogicalNode> JoinLogicalNode::clone() const
+{
+  auto node = std::make_unique<JoinLogicalNode>();
+  if (condition_ != nullptr) {
+    node->condition_.reset(condition_->copy());
+  }
+  node->method_ = method_;
+  for (const std::unique_ptr<Expression> &key : left_keys_) {
+    node->left_keys_.emplace_back(key->copy());
+  }
+  for (const std::unique_ptr<Expression> &key : right_keys_) {
+    node->right_keys_.emplace_back(key->copy());
+  }
+  node->index_ = index_;
+  return clone_to(std::move(node));
+}
@@ -0,0 +1,9 @@
+#include "include/query_engine/planner/node/limit_logical_node.h"
+
+LimitLogicalNode::LimitLogicalNode(int limit, int offset) : limit_(limit), offset_(offset)
+{}
+
+std::unique_ptr<LogicalNode> LimitLogicalNode::clone() const
+{
+  return clone_to(std::make_unique<LimitLogicalNode>(limit_, offset_));
+}
@@ -7,3 +7,18 @@ void LogicalNode::add_child(std::unique_ptr<LogicalNode> oper)
 {
   children_.emplace_back(std::move(oper));
 }
+
+std::unique_ptr<LogicalNode> LogicalNode::clone_to(std::unique_ptr<LogicalNode> node) const
+{
+  node->children_.clear();
+  for (const std::unique_ptr<LogicalNode> &child : children_) {
+    node->children_.emplace_back(child->clone());
+  }
+  node->expressions_.clear();
+  for (const std::unique_ptr<Expression> &expr : expressions_) {
+    node->expressions_.emplace_back(expr->copy());
+  }
+  node->estimated_rows_ = estimated_rows_;
+  node->estimated_cost_ = estimated_cost_;
+  return node;
+}
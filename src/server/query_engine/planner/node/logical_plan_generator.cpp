@@ -7,6 +7,7 @@
 #include "include/query_engine/planner/node/project_logical_node.h"
 #include "include/query_engine/planner/node/group_by_logical_node.h"
 #include "include/query_engine/planner/node/order_by_logical_node.h"
+#include "include/query_engine/planner/node/limit_logical_node.h"
 #include "include/query_engine/planner/node/predicate_logical_node.h"
 #include "include/query_engine/planner/node/table_get_logical_node.h"
 #include "include/query_engine/planner/node/insert_logical_node.h"
@@ -212,7 +213,15 @@ RC LogicalPlanGenerator::plan_node(
     root = std::move(order_node);
   }
 
-  // 7. project node
+  // 7. limit node
+  if (select_stmt->limit() >= 0) {
+    unique_ptr<LogicalNode> limit_node =
+        unique_ptr<LogicalNode>(new LimitLogicalNode(select_stmt->limit(), select_stmt->offset()));
+    limit_node->add_child(std::move(root));
+    root = std::move(limit_node);
+  }
+
+  // 8. project node
   unique_ptr<LogicalNode> project_logical_node =
       unique_ptr<LogicalNode>(new ProjectLogicalNode(select_stmt->projects()));
   project_logical_node->add_child(std::move(root));
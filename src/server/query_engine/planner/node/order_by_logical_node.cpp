@@ -2,3 +2,8 @@
 #include "include/query_engine/analyzer/statement/orderby_stmt.h"
 OrderByLogicalNode::OrderByLogicalNode(std::vector<OrderByUnit *> order_units): order_units_(std::move(order_units))
 {}
+
+std::unique_ptr<LogicalNode> OrderByLogicalNode::clone() const
+{
+  return clone_to(std::make_unique<OrderByLogicalNode>(order_units_));
+}
@@ -4,3 +4,8 @@ PredicateLogicalNode::PredicateLogicalNode(std::unique_ptr<Expression> expressio
 {
   expressions_.emplace_back(std::move(expression));
 }
+
+std::unique_ptr<LogicalNode> PredicateLogicalNode::clone() const
+{
+  return clone_to(std::make_unique<PredicateLogicalNode>(nullptr));
+}
@@ -8,3 +8,16 @@ void TableGetLogicalNode::set_predicates(std::vector<std::unique_ptr<Expression>
 {
   predicates_ = std::move(exprs);
 }
+
+std::unique_ptr<LogicalNode> TableGetLogicalNode::clone() const
+{
+  auto node = std::make_unique<TableGetLogicalNode>(table_, table_alias_, fields_, readonly_);
+  for (const std::unique_ptr<Expression> &predicate : predicates_) {
+    node->predicates_.emplace_back(predicate->copy());
+  }
+  node->ordered_index_     = ordered_index_;
+  node->used_fields_       = used_fields_;
+  node->used_fields_known_ = used_fields_known_;
+  node->prefer_table_scan_ = prefer_table_scan_;
+  return clone_to(std::move(node));
+}
@@ -10,3 +10,15 @@ UpdateLogicalNode::~UpdateLogicalNode()
     delete unit.value;
   }
 }
+
+std::unique_ptr<LogicalNode> UpdateLogicalNode::clone() const
+{
+  std::vector<UpdateUnit> update_units;
+  for (const UpdateUnit &unit : update_units_) {
+    UpdateUnit copied;
+    copied.attribute_name = unit.attribute_name;
+    copied.value          = unit.value->copy();
+    update_units.emplace_back(copied);
+  }
+  return clone_to(std::make_unique<UpdateLogicalNode>(table_, std::move(update_units)));
+}
@@ -1,100 +1,64 @@
 #include "common/log/log.h"
 #include "include/query_engine/planner/operator/aggr_physical_operator.h"
+#include "include/query_engine/planner/operator/exchange_physical_operator.h"
 #include "include/storage_engine/recorder/table.h"
 
-RC AggrPhysicalOperator::open(Trx *trx)
-{
-  if (children_.empty()) {
-    return RC::SUCCESS;
-  }
+Aggregator::Aggregator(const std::vector<AggrType> &aggr_types, const std::vector<Field> &aggr_fields)
+    : aggr_types_(aggr_types), aggr_fields_(aggr_fields)
+{}
 
-  PhysicalOperator *child = children_[0].get();
-  RC rc = child->open(trx);
-  if (rc != RC::SUCCESS) {
-    LOG_WARN("failed to init child operator: %s", strrc(rc));
-    return rc;
+void Aggregator::init()
+{
+  counts_.assign(aggr_fields_.size(), 0);
+  all_null_.assign(aggr_fields_.size(), true);
+  aggr_results_.resize(aggr_fields_.size());
+  for (Value &aggr_result : aggr_results_) {
+    aggr_result.set_null();
   }
-
-  aggr_init();
-
-  return RC::SUCCESS;
 }
 
-RC AggrPhysicalOperator::next()
+RC Aggregator::update(const Tuple &tuple)
 {
-  RC rc;
-  if (children_.empty()) {
-    return RC::RECORD_EOF;
-  }
-
-  PhysicalOperator *child = children_[0].get();
-  bool aggr_flag = false;
-  while (RC::SUCCESS == (rc = child->next())) {
-    aggr_flag = true;
-    Tuple *tuple = child->current_tuple();
-    if (nullptr == tuple) {
-      LOG_WARN("failed to get current record: %s", strrc(rc));
-      return rc;
-    }
-
-    for (int i = 0; i < aggr_fields_.size(); i ++) {
-      const auto& aggr_field = aggr_fields_[i];
-      if (0 == strcmp(aggr_field.field_name(), "*")) {
-        all_null_[i] = false;
-        counts_[i] ++;
-        continue;
-      }
-      Value value;
-      const TupleCellSpec *spec =
-          new TupleCellSpec(aggr_field.table_name(), aggr_field.field_name(), aggr_field.table_alias());
-      rc = tuple->find_cell(*spec, value);
-      if(rc != RC::SUCCESS) {
-        return rc;
-      }
-      if (value.is_null()) {
-        continue;
-      }
+  RC rc = RC::SUCCESS;
+  for (size_t i = 0; i < aggr_fields_.size(); i ++) {
+    const auto& aggr_field = aggr_fields_[i];
+    if (0 == strcmp(aggr_field.field_name(), "*")) {
       all_null_[i] = false;
       counts_[i] ++;
-      aggr_update(aggr_types_[i], aggr_results_[i], value);
+      continue;
     }
-    is_first_called_ = false;
-  }
-  if (aggr_flag || is_first_called_) {
-    aggr_done();
-    is_first_called_ = false;
-    return RC::SUCCESS;
-  } else {
-    return RC::RECORD_EOF;
+    Value value;
+    const TupleCellSpec spec(aggr_field.table_name(), aggr_field.field_name(), aggr_field.table_alias());
+    rc = tuple.find_cell(spec, value);
+    if(rc != RC::SUCCESS) {
+      return rc;
+    }
+    if (value.is_null()) {
+      continue;
+    }
+    all_null_[i] = false;
+    counts_[i] ++;
+    aggr_update(aggr_types_[i], aggr_results_[i], value);
   }
-
+  return rc;
 }
 
-RC AggrPhysicalOperator::close()
+void Aggregator::merge(const Aggregator &other)
 {
-  if (!children_.empty()) {
-    children_[0]->close();
+  for (size_t i = 0; i < aggr_fields_.size(); i ++) {
+    counts_[i] += other.counts_[i];
+    if (other.all_null_[i]) {
+      continue;
+    }
+    all_null_[i] = false;
+    // count 只用到了计数，其它聚合的部分结果与单个值的合并方式相同
+    if (!other.aggr_results_[i].is_null()) {
+      aggr_update(aggr_types_[i], aggr_results_[i], other.aggr_results_[i]);
+    }
   }
-  return RC::SUCCESS;
 }
 
-Tuple *AggrPhysicalOperator::current_tuple()
-{
-  return &tuple_;
-}
-
-void AggrPhysicalOperator::aggr_init() {
-  is_first_called_ = true;
-  counts_.resize(aggr_fields_.size());
-  all_null_.resize(aggr_fields_.size());
-  aggr_results_.resize(aggr_fields_.size());
-  for (size_t i = 0; i < all_null_.size(); ++i) {
-    all_null_[i] = true;
-    counts_[i]   = 0;
-    aggr_results_[i].set_null();
-  }
-}
-void AggrPhysicalOperator::aggr_update(AggrType aggr_type, Value& aggr_result, Value& value) {
+void Aggregator::aggr_update(AggrType aggr_type, Value& aggr_result, const Value& value) {
   if(aggr_result.is_null()) {
     aggr_result = value;
     return;
@@ -128,13 +92,15 @@ void AggrPhysicalOperator::aggr_update(AggrType aggr_type, Value& aggr_result, V
         default: break;
       }
     } break;
+    case AGGR_COUNT: break;
     default:
       LOG_ERROR("Unsupported AggrFuncType");
   }
 
 }
-void AggrPhysicalOperator::aggr_done() {
-  for (int i = 0; i < aggr_fields_.size(); i ++) {
+
+void Aggregator::finish(std::vector<std::string> &alias, AggrTuple &tuple) {
+  for (size_t i = 0; i < aggr_fields_.size(); i ++) {
     if (all_null_[i] && AGGR_COUNT != aggr_types_[i]) {
       aggr_results_[i].set_null();
       continue;
@@ -154,5 +120,95 @@ void AggrPhysicalOperator::aggr_done() {
       default: break;
     }
   }
-  tuple_.set_tuple(alias_, aggr_results_);
-}
\ No newline at end of file
+  tuple.set_tuple(alias, aggr_results_);
+}
+
+RC AggrPhysicalOperator::open(Trx *trx)
+{
+  if (children_.empty()) {
+    return RC::SUCCESS;
+  }
+
+  PhysicalOperator *child = children_[0].get();
+  RC rc = child->open(trx);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to init child operator: %s", strrc(rc));
+    return rc;
+  }
+
+  aggregator_.init();
+  is_first_called_ = true;
+
+  return RC::SUCCESS;
+}
+
+RC AggrPhysicalOperator::next()
+{
+  if (children_.empty() || !is_first_called_) {
+    return RC::RECORD_EOF;
+  }
+  is_first_called_ = false;
+
+  RC rc = RC::SUCCESS;
+  PhysicalOperator *child = children_[0].get();
+  if (child->type() == PhysicalOperatorType::EXCHANGE) {
+    rc = parallel_aggregate(static_cast<ExchangePhysicalOperator &>(*child));
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+  } else {
+    while (RC::SUCCESS == (rc = child->next_row())) {
+      Tuple *tuple = child->current_tuple();
+      if (nullptr == tuple) {
+        LOG_WARN("failed to get current record: %s", strrc(rc));
+        return rc;
+      }
+
+      rc = aggregator_.update(*tuple);
+      if (rc != RC::SUCCESS) {
+        return rc;
+      }
+    }
+    if (rc != RC::RECORD_EOF) {
+      return rc;
+    }
+  }
+
+  // 没有数据时也要输出一行，比如 count(*) 为 0
+  aggregator_.finish(alias_, tuple_);
+  return RC::SUCCESS;
+}
+
+RC AggrPhysicalOperator::parallel_aggregate(ExchangePhysicalOperator &exchange)
+{
+  std::vector<Aggregator> partial_aggregators(exchange.pipeline_num(), Aggregator(aggr_types_, aggr_fields_));
+  for (Aggregator &aggregator : partial_aggregators) {
+    aggregator.init();
+  }
+
+  RC rc = exchange.execute([&partial_aggregators](int pipeline, Tuple &tuple) {
+    return partial_aggregators[pipeline].update(tuple);
+  });
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to execute parallel pipelines. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  for (const Aggregator &aggregator : partial_aggregators) {
+    aggregator_.merge(aggregator);
+  }
+  return RC::SUCCESS;
+}
+
+RC AggrPhysicalOperator::close()
+{
+  if (!children_.empty()) {
+    children_[0]->close();
+  }
+  return RC::SUCCESS;
+}
+
+Tuple *AggrPhysicalOperator::current_tuple()
+{
+  return &tuple_;
+}
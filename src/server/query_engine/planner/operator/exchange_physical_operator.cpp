@@ -0,0 +1,169 @@
+#include "include/query_engine/planner/operator/exchange_physical_operator.h"
+
+#include <condition_variable>
+#include <mutex>
+
+#include "common/log/log.h"
+#include "include/common/global_context.h"
+#include "include/common/query_stats.h"
+#include "include/common/worker_pool.h"
+#include "include/storage_engine/recorder/table.h"
+
+void MorselQueue::reset(std::vector<std::pair<PageNum, PageNum>> &&morsels)
+{
+  morsels_ = std::move(morsels);
+  next_.store(0);
+}
+
+bool MorselQueue::pop(PageNum &begin_page, PageNum &end_page)
+{
+  size_t index = next_.fetch_add(1);
+  if (index >= morsels_.size()) {
+    return false;
+  }
+  begin_page = morsels_[index].first;
+  end_page = morsels_[index].second;
+  return true;
+}
+
+void MorselQueue::cancel()
+{
+  next_.store(morsels_.size());
+}
+
+ExchangePhysicalOperator::ExchangePhysicalOperator(Table *table, std::shared_ptr<MorselQueue> morsel_queue)
+    : table_(table), morsel_queue_(std::move(morsel_queue))
+{}
+
+std::string ExchangePhysicalOperator::param() const
+{
+  return "dop=" + std::to_string(pipeline_num());
+}
+
+void ExchangePhysicalOperator::add_pipeline(std::unique_ptr<PhysicalOperator> pipeline)
+{
+  if (children_.empty()) {
+    add_child(std::move(pipeline));
+  } else {
+    pipelines_.emplace_back(std::move(pipeline));
+  }
+}
+
+PhysicalOperator *ExchangePhysicalOperator::pipeline(int index)
+{
+  return index == 0 ? children_[0].get() : pipelines_[index - 1].get();
+}
+
+RC ExchangePhysicalOperator::open(Trx *trx)
+{
+  if (children_.empty()) {
+    LOG_WARN("exchange operator must has at least one pipeline");
+    return RC::INTERNAL;
+  }
+
+  // 每次执行时重新切分页面，表中的数据可能已经变化了
+  std::vector<std::pair<PageNum, PageNum>> morsels;
+  RC rc = table_->split_pages(MORSEL_PAGE_NUM, morsels);
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+  morsel_queue_->reset(std::move(morsels));
+
+  trx_ = trx;
+  return children_[0]->open(trx);
+}
+
+RC ExchangePhysicalOperator::next()
+{
+  return children_[0]->next_row();
+}
+
+RC ExchangePhysicalOperator::close()
+{
+  children_[0]->close();
+  return RC::SUCCESS;
+}
+
+Tuple *ExchangePhysicalOperator::current_tuple()
+{
+  return children_[0]->current_tuple();
+}
+
+RC ExchangePhysicalOperator::run_pipeline(int index, const std::function<RC(int, Tuple &)> &consumer)
+{
+  PhysicalOperator *oper = pipeline(index);
+  RC rc = RC::SUCCESS;
+  while (RC::SUCCESS == (rc = oper->next_row())) {
+    Tuple *tuple = oper->current_tuple();
+    rc = consumer(index, *tuple);
+    if (rc != RC::SUCCESS) {
+      break;
+    }
+  }
+
+  if (rc == RC::RECORD_EOF) {
+    return RC::SUCCESS;
+  }
+  morsel_queue_->cancel();
+  return rc;
+}
+
+RC ExchangePhysicalOperator::execute(const std::function<RC(int, Tuple &)> &consumer)
+{
+  // 任务可能在当前函数返回之后才被线程池调度，因此共享的状态由任务自己持有一份
+  struct ExecuteState
+  {
+    std::mutex lock;
+    std::condition_variable cond;
+    int running = 0;
+    bool closed = false;  ///< 设置之后，还没有开始的任务直接退出
+    RC rc = RC::SUCCESS;
+  };
+  auto state = std::make_shared<ExecuteState>();
+
+  // 工作线程中的页面读写也算到当前语句上，当前线程等所有开始的任务结束才返回，所以统计对象一直有效
+  QueryStats *stats = QueryStats::current();
+  WorkerPool *worker_pool = GCTX.worker_pool_;
+  for (int i = 1; i < pipeline_num() && worker_pool != nullptr; i++) {
+    worker_pool->submit([this, state, i, stats, &consumer]() {
+      {
+        std::lock_guard<std::mutex> guard(state->lock);
+        if (state->closed) {
+          return;
+        }
+        state->running++;
+      }
+
+      QueryStats *worker_stats = QueryStats::current();
+      QueryStats::set_current(stats);
+      PhysicalOperator *oper = pipeline(i);
+      RC rc = oper->open(trx_);
+      if (rc == RC::SUCCESS) {
+        rc = run_pipeline(i, consumer);
+        oper->close();
+      } else {
+        morsel_queue_->cancel();
+      }
+      QueryStats::set_current(worker_stats);
+
+      std::lock_guard<std::mutex> guard(state->lock);
+      if (rc != RC::SUCCESS && state->rc == RC::SUCCESS) {
+        state->rc = rc;
+      }
+      state->running--;
+      state->cond.notify_all();
+    });
+  }
+
+  // 当前线程运行第一条流水线。它会一直取页面段直到取完，
+  // 所以它结束时所有的页面段都已经被已经开始运行的流水线取走了，没有开始的任务可以直接丢弃
+  RC rc = run_pipeline(0, consumer);
+
+  std::unique_lock<std::mutex> guard(state->lock);
+  state->closed = true;
+  state->cond.wait(guard, [&state]() { return state->running == 0; });
+  if (rc == RC::SUCCESS) {
+    rc = state->rc;
+  }
+  return rc;
+}
@@ -0,0 +1,515 @@
+#include "include/query_engine/planner/operator/external_sort.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/log/log.h"
+
+namespace {
+
+/// arena 中每个内存块的大小
+constexpr size_t SORT_ARENA_BLOCK_SIZE = 1024 * 1024;
+/// 读写顺串文件时使用的缓冲区大小
+constexpr size_t SORT_RUN_IO_BUFFER_SIZE = 64 * 1024;
+
+struct EntryHeader
+{
+  uint32_t key_len;
+  uint32_t payload_len;
+};
+
+inline const char *entry_key(const char *entry) { return entry + sizeof(EntryHeader); }
+
+inline uint32_t entry_key_len(const char *entry) { return reinterpret_cast<const EntryHeader *>(entry)->key_len; }
+
+inline char *entry_payload(char *entry)
+{
+  return entry + sizeof(EntryHeader) + reinterpret_cast<const EntryHeader *>(entry)->key_len;
+}
+
+inline uint32_t entry_payload_len(const char *entry)
+{
+  return reinterpret_cast<const EntryHeader *>(entry)->payload_len;
+}
+
+inline size_t entry_size(const char *entry)
+{
+  const auto *header = reinterpret_cast<const EntryHeader *>(entry);
+  return sizeof(EntryHeader) + header->key_len + header->payload_len;
+}
+
+inline int compare_key(const char *key1, uint32_t len1, const char *key2, uint32_t len2)
+{
+  int result = memcmp(key1, key2, std::min(len1, len2));
+  if (result != 0) {
+    return result;
+  }
+  return len1 < len2 ? -1 : (len1 > len2 ? 1 : 0);
+}
+
+inline void append_big_endian(uint64_t bits, int bytes, bool is_asc, std::string &key)
+{
+  for (int i = bytes - 1; i >= 0; i--) {
+    auto byte = static_cast<unsigned char>((bits >> (i * 8)) & 0xFF);
+    key.push_back(static_cast<char>(is_asc ? byte : ~byte));
+  }
+}
+
+}  // namespace
+
+void SortKeyEncoder::append(const Value &value, bool is_asc, std::string &key)
+{
+  const char null_flag = value.is_null() ? 0x00 : 0x01;
+  key.push_back(static_cast<char>(is_asc ? null_flag : ~null_flag));
+  if (value.is_null()) {
+    return;
+  }
+
+  switch (value.attr_type()) {
+    case INTS:
+    case FLOATS:
+    case DATES: {
+      // 同一列的数据类型是确定的，但 int 与 float 之间也可以比较，所以统一转换成 double
+      double number = value.attr_type() == FLOATS ? static_cast<double>(value.get_float()) : value.get_int();
+      if (number == 0) {
+        number = 0;  // -0.0 与 0.0 视为相同
+      }
+      uint64_t bits = 0;
+      memcpy(&bits, &number, sizeof(bits));
+      bits = (bits & (1ULL << 63)) ? ~bits : (bits | (1ULL << 63));
+      append_big_endian(bits, sizeof(bits), is_asc, key);
+    } break;
+    case BOOLEANS: {
+      append_big_endian(value.get_boolean() ? 1 : 0, 1, is_asc, key);
+    } break;
+    case CHARS:
+    case TEXTS: {
+      const char *data = value.data();
+      const int   len  = value.length();
+      for (int i = 0; i < len; i++) {
+        append_big_endian(static_cast<unsigned char>(data[i]), 1, is_asc, key);
+        if (data[i] == 0) {
+          append_big_endian(0xFF, 1, is_asc, key);
+        }
+      }
+      append_big_endian(0, 2, is_asc, key);
+    } break;
+    default: {
+      LOG_WARN("unsupported sort key type: %d", value.attr_type());
+    } break;
+  }
+}
+
+void SortRowCodec::encode(const Tuple &tuple, std::string &payload)
+{
+  input_records_.clear();
+  tuple.get_record(input_records_);
+  payload.clear();
+  for (const Record *record : input_records_) {
+    const RID &rid = record->rid();
+    const int  len = record->len();
+    payload.append(reinterpret_cast<const char *>(&rid), sizeof(rid));
+    payload.append(reinterpret_cast<const char *>(&len), sizeof(len));
+    payload.append(record->data(), len);
+  }
+}
+
+void SortRowCodec::decode(char *payload, int payload_len, Tuple &tuple)
+{
+  const char *end        = payload + payload_len;
+  size_t      record_num = 0;
+  while (payload < end) {
+    if (output_records_.size() <= record_num) {
+      output_records_.emplace_back();
+    }
+    Record &record = output_records_[record_num++];
+    RID     rid;
+    int     len = 0;
+    memcpy(&rid, payload, sizeof(rid));
+    memcpy(&len, payload + sizeof(rid), sizeof(len));
+    payload += sizeof(rid) + sizeof(len);
+    record.set_rid(rid);
+    record.set_data(payload, len);
+    payload += len;
+  }
+
+  // set_record 会消费掉传入的数组，所以每次都重新填充
+  output_record_ptrs_.clear();
+  for (size_t i = 0; i < record_num; i++) {
+    output_record_ptrs_.push_back(&output_records_[i]);
+  }
+  tuple.set_record(output_record_ptrs_);
+}
+
+/**
+ * @brief 顺序读取一个顺串文件，只缓存当前行
+ */
+struct ExternalSorter::RunReader
+{
+  FILE             *file = nullptr;
+  std::vector<char> entry;
+  bool              exhausted = false;
+
+  RC advance()
+  {
+    EntryHeader header;
+    size_t      n = fread(&header, sizeof(header), 1, file);
+    if (n != 1) {
+      if (ferror(file)) {
+        LOG_WARN("failed to read sort run. error=%s", strerror(errno));
+        return RC::IOERR_READ;
+      }
+      exhausted = true;
+      return RC::SUCCESS;
+    }
+
+    entry.resize(sizeof(header) + header.key_len + header.payload_len);
+    memcpy(entry.data(), &header, sizeof(header));
+    const size_t body_len = header.key_len + header.payload_len;
+    if (body_len > 0 && fread(entry.data() + sizeof(header), body_len, 1, file) != 1) {
+      LOG_WARN("sort run is truncated. error=%s", strerror(errno));
+      return RC::IOERR_READ;
+    }
+    return RC::SUCCESS;
+  }
+
+  char *current() { return entry.data(); }
+};
+
+/**
+ * @brief 败者树
+ * @details 内部节点保存败者，tree_[0] 保存最终的胜者(最小的行)。
+ * 每输出一行只需要沿着胜者所在的叶子到根重新比较一次，代价为 log(k)
+ */
+class ExternalSorter::LoserTree
+{
+public:
+  explicit LoserTree(std::vector<std::unique_ptr<RunReader>> readers)
+      : readers_(std::move(readers)), k_(static_cast<int>(readers_.size())), tree_(std::max(k_, 1), k_)
+  {}
+
+  RC init()
+  {
+    for (auto &reader : readers_) {
+      RC rc = reader->advance();
+      if (rc != RC::SUCCESS) {
+        return rc;
+      }
+    }
+    for (int i = k_ - 1; i >= 0; i--) {
+      adjust(i);
+    }
+    return RC::SUCCESS;
+  }
+
+  /// 当前最小的行，全部读完后返回nullptr
+  RunReader *top()
+  {
+    if (k_ == 0 || readers_[tree_[0]]->exhausted) {
+      return nullptr;
+    }
+    return readers_[tree_[0]].get();
+  }
+
+  RC pop()
+  {
+    const int winner = tree_[0];
+    RC        rc     = readers_[winner]->advance();
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+    adjust(winner);
+    return RC::SUCCESS;
+  }
+
+private:
+  /// a 是否应该排在 b 前面。k_ 是建树时使用的哨兵，比所有行都小
+  bool less(int a, int b)
+  {
+    if (a == k_) {
+      return true;
+    }
+    if (b == k_) {
+      return false;
+    }
+    RunReader *ra = readers_[a].get();
+    RunReader *rb = readers_[b].get();
+    if (ra->exhausted || rb->exhausted) {
+      return !ra->exhausted;
+    }
+    const char *ea     = ra->current();
+    const char *eb     = rb->current();
+    int         result = compare_key(entry_key(ea), entry_key_len(ea), entry_key(eb), entry_key_len(eb));
+    return result != 0 ? result < 0 : a < b;
+  }
+
+  void adjust(int leaf)
+  {
+    int winner = leaf;
+    for (int parent = (leaf + k_) / 2; parent > 0; parent /= 2) {
+      if (less(tree_[parent], winner)) {
+        std::swap(winner, tree_[parent]);
+      }
+    }
+    tree_[0] = winner;
+  }
+
+private:
+  std::vector<std::unique_ptr<RunReader>> readers_;
+  int                                     k_;
+  std::vector<int>                        tree_;
+};
+
+ExternalSorter::ExternalSorter(size_t memory_budget, size_t merge_fan_in)
+    : memory_budget_(memory_budget), merge_fan_in_(std::max<size_t>(merge_fan_in, 2))
+{}
+
+ExternalSorter::~ExternalSorter()
+{
+  reset();
+}
+
+void ExternalSorter::reset()
+{
+  merger_.reset();
+  for (FILE *run : runs_) {
+    fclose(run);
+  }
+  runs_.clear();
+  run_levels_.clear();
+  blocks_.clear();
+  large_blocks_.clear();
+  large_bytes_ = 0;
+  block_used_  = 0;
+  block_count_ = 0;
+  entries_.clear();
+  entries_.shrink_to_fit();
+  output_pos_   = 0;
+  spilled_runs_ = 0;
+  finished_     = false;
+}
+
+char *ExternalSorter::allocate(size_t size)
+{
+  size = (size + alignof(EntryHeader) - 1) & ~(alignof(EntryHeader) - 1);
+  if (size > SORT_ARENA_BLOCK_SIZE) {
+    // 超大的行单独分配一块内存，不影响普通内存块剩余空间的使用
+    large_blocks_.emplace_back(std::make_unique<char[]>(size));
+    large_bytes_ += size;
+    return large_blocks_.back().get();
+  }
+
+  if (block_count_ == 0 || block_used_ + size > SORT_ARENA_BLOCK_SIZE) {
+    if (block_count_ == blocks_.size()) {
+      blocks_.emplace_back(std::make_unique<char[]>(SORT_ARENA_BLOCK_SIZE));
+    }
+    block_count_++;
+    block_used_ = 0;
+  }
+  char *data = blocks_[block_count_ - 1].get() + block_used_;
+  block_used_ += size;
+  return data;
+}
+
+size_t ExternalSorter::memory_usage() const
+{
+  return block_count_ * SORT_ARENA_BLOCK_SIZE + large_bytes_ + entries_.size() * sizeof(char *);
+}
+
+RC ExternalSorter::add(const char *key, int key_len, const char *payload, int payload_len)
+{
+  ASSERT(!finished_, "cannot add rows after sorter finished");
+
+  const size_t size  = sizeof(EntryHeader) + key_len + payload_len;
+  char        *entry = allocate(size);
+
+  EntryHeader header{static_cast<uint32_t>(key_len), static_cast<uint32_t>(payload_len)};
+  memcpy(entry, &header, sizeof(header));
+  memcpy(entry + sizeof(header), key, key_len);
+  memcpy(entry + sizeof(header) + key_len, payload, payload_len);
+  entries_.push_back(entry);
+
+  if (memory_usage() >= memory_budget_) {
+    return spill_run();
+  }
+  return RC::SUCCESS;
+}
+
+void ExternalSorter::sort_in_memory()
+{
+  std::stable_sort(entries_.begin(), entries_.end(), [](const char *a, const char *b) {
+    return compare_key(entry_key(a), entry_key_len(a), entry_key(b), entry_key_len(b)) < 0;
+  });
+}
+
+RC ExternalSorter::spill_run()
+{
+  if (entries_.empty()) {
+    return RC::SUCCESS;
+  }
+
+  sort_in_memory();
+
+  FILE *run = tmpfile();
+  if (run == nullptr) {
+    LOG_WARN("failed to create temporary file for sort run. error=%s", strerror(errno));
+    return RC::IOERR_OPEN;
+  }
+  setvbuf(run, nullptr, _IOFBF, SORT_RUN_IO_BUFFER_SIZE);
+
+  for (const char *entry : entries_) {
+    if (fwrite(entry, entry_size(entry), 1, run) != 1) {
+      LOG_WARN("failed to write sort run. error=%s", strerror(errno));
+      fclose(run);
+      return RC::IOERR_WRITE;
+    }
+  }
+  runs_.push_back(run);
+  run_levels_.push_back(0);
+  spilled_runs_++;
+  LOG_TRACE("spill sort run. rows=%d, runs=%d", static_cast<int>(entries_.size()), spilled_runs_);
+
+  // 与多路归并树一样按层合并: 末尾凑齐 fan-in 个同一层的顺串时就把它们归并成上一层的一个顺串，
+  // 这样打开的临时文件数只与层数相关，每行数据被重写的次数也只有 log(顺串数) 次
+  while (runs_.size() >= merge_fan_in_) {
+    const int level = run_levels_.back();
+    if (run_levels_[run_levels_.size() - merge_fan_in_] != level) {
+      break;
+    }
+    RC rc = merge_tail_runs(merge_fan_in_);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+  }
+
+  // 普通内存块留给下一个顺串复用
+  large_blocks_.clear();
+  large_bytes_ = 0;
+  block_count_ = 0;
+  block_used_  = 0;
+  entries_.clear();
+  return RC::SUCCESS;
+}
+
+RC ExternalSorter::open_merge(std::vector<FILE *> &runs)
+{
+  std::vector<std::unique_ptr<RunReader>> readers;
+  for (FILE *run : runs) {
+    if (fflush(run) != 0 || fseek(run, 0, SEEK_SET) != 0) {
+      LOG_WARN("failed to rewind sort run. error=%s", strerror(errno));
+      return RC::IOERR_SEEK;
+    }
+    auto reader  = std::make_unique<RunReader>();
+    reader->file = run;
+    readers.push_back(std::move(reader));
+  }
+  merger_ = std::make_unique<LoserTree>(std::move(readers));
+  return merger_->init();
+}
+
+RC ExternalSorter::merge_runs(std::vector<FILE *> &runs, FILE *output)
+{
+  RC rc = open_merge(runs);
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+
+  RunReader *reader = nullptr;
+  while ((reader = merger_->top()) != nullptr) {
+    if (fwrite(reader->current(), entry_size(reader->current()), 1, output) != 1) {
+      LOG_WARN("failed to write merged sort run. error=%s", strerror(errno));
+      return RC::IOERR_WRITE;
+    }
+    rc = merger_->pop();
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+  }
+  merger_.reset();
+  return RC::SUCCESS;
+}
+
+RC ExternalSorter::merge_tail_runs(size_t count)
+{
+  std::vector<FILE *> group(runs_.end() - count, runs_.end());
+  const int level = run_levels_.back() + 1;
+  runs_.resize(runs_.size() - count);
+  run_levels_.resize(run_levels_.size() - count);
+
+  FILE *merged = tmpfile();
+  if (merged == nullptr) {
+    LOG_WARN("failed to create temporary file for sort run. error=%s", strerror(errno));
+    for (FILE *run : group) {
+      fclose(run);
+    }
+    return RC::IOERR_OPEN;
+  }
+  setvbuf(merged, nullptr, _IOFBF, SORT_RUN_IO_BUFFER_SIZE);
+
+  RC rc = merge_runs(group, merged);
+  for (FILE *run : group) {
+    fclose(run);
+  }
+  runs_.push_back(merged);
+  run_levels_.push_back(level);
+  return rc;
+}
+
+RC ExternalSorter::finish()
+{
+  finished_ = true;
+  if (runs_.empty()) {
+    sort_in_memory();
+    output_pos_ = 0;
+    return RC::SUCCESS;
+  }
+
+  RC rc = spill_run();
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+  // 溢出时不再需要arena，释放掉以便归并阶段只占用读缓冲
+  blocks_.clear();
+  entries_.shrink_to_fit();
+
+  // 顺串太多时先把最小的几个归并起来，保证最终归并时同时打开的文件数与读缓冲都是有界的
+  while (runs_.size() > merge_fan_in_) {
+    rc = merge_tail_runs(merge_fan_in_);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+  }
+
+  return open_merge(runs_);
+}
+
+RC ExternalSorter::next(char *&payload, int &payload_len)
+{
+  ASSERT(finished_, "sorter should be finished before fetching rows");
+
+  if (merger_ == nullptr) {
+    if (output_pos_ >= entries_.size()) {
+      return RC::RECORD_EOF;
+    }
+    char *entry = entries_[output_pos_++];
+    payload     = entry_payload(entry);
+    payload_len = static_cast<int>(entry_payload_len(entry));
+    return RC::SUCCESS;
+  }
+
+  // 上一次返回的行在这里才真正出队，保证返回的payload在两次调用之间有效
+  if (output_pos_ > 0) {
+    RC rc = merger_->pop();
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+  }
+  RunReader *reader = merger_->top();
+  if (reader == nullptr) {
+    return RC::RECORD_EOF;
+  }
+  output_pos_++;
+  payload     = entry_payload(reader->current());
+  payload_len = static_cast<int>(entry_payload_len(reader->current()));
+  return RC::SUCCESS;
+}
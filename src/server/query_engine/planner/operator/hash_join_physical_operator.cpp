@@ -0,0 +1,234 @@
+#include "include/query_engine/planner/operator/hash_join_physical_operator.h"
+#include "include/query_engine/planner/operator/join_physical_operator.h"
+
+#include <algorithm>
+
+#include "include/storage_engine/recorder/table.h"
+
+HashJoinPhysicalOperator::HashJoinPhysicalOperator(std::vector<std::unique_ptr<Expression>> &&left_keys,
+    std::vector<std::unique_ptr<Expression>> &&right_keys, std::unique_ptr<Expression> condition)
+    : left_keys_(std::move(left_keys)), right_keys_(std::move(right_keys)), condition_(std::move(condition))
+{}
+
+std::string HashJoinPhysicalOperator::param() const
+{
+  return join_keys_to_string(left_keys_, right_keys_);
+}
+
+namespace {
+/// 构建侧不同的键不超过这个数时，探测侧可以逐个用布隆过滤器索引检查页面
+constexpr size_t MAX_PAGE_PROBE_KEYS = 64;
+}  // namespace
+
+RC HashJoinPhysicalOperator::open(Trx *trx)
+{
+  if (children_.size() != 2) {
+    LOG_WARN("hash join requires exactly two children");
+    return RC::INTERNAL;
+  }
+
+  // 先建立哈希表，得到运行时过滤器之后再打开左边的扫描
+  RC rc = children_[1]->open(trx);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to open right child of hash join. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  auto runtime_filter = std::make_shared<RuntimeFilter>();
+  TableScanPhysicalOperator *scan = probe_scan(*runtime_filter);
+  runtime_filter_ = scan != nullptr ? runtime_filter : nullptr;
+
+  matches_ = nullptr;
+  match_pos_ = 0;
+  rc = build();
+  if (rc != RC::SUCCESS) {
+    children_[1]->close();
+    return rc;
+  }
+
+  if (scan != nullptr) {
+    scan->set_runtime_filter(runtime_filter_);
+  }
+  rc = children_[0]->open(trx);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to open left child of hash join. rc=%s", strrc(rc));
+    children_[1]->close();
+    return rc;
+  }
+  return RC::SUCCESS;
+}
+
+TableScanPhysicalOperator *HashJoinPhysicalOperator::probe_scan(RuntimeFilter &runtime_filter) const
+{
+  // 过滤不会改变记录，可以穿过
+  PhysicalOperator *oper = children_[0].get();
+  while (oper->type() == PhysicalOperatorType::PREDICATE && oper->children().size() == 1) {
+    oper = oper->children().front().get();
+  }
+  if (oper->type() != PhysicalOperatorType::TABLE_SCAN) {
+    return nullptr;
+  }
+
+  auto *scan = static_cast<TableScanPhysicalOperator *>(oper);
+  ExpressionCompiler compiler(scan->table(), scan->table_alias());
+  std::vector<int> field_indexes;
+  for (const std::unique_ptr<Expression> &key : left_keys_) {
+    const int field_index = compiler.field_index(key.get());
+    if (field_index < 0) {
+      return nullptr;
+    }
+    field_indexes.push_back(field_index);
+  }
+  if (runtime_filter.key.init(scan->table()->table_meta(), field_indexes) != RC::SUCCESS) {
+    return nullptr;
+  }
+  return scan;
+}
+
+RC HashJoinPhysicalOperator::build()
+{
+  build_rows_.clear();
+  hash_table_.clear();
+
+  RC rc = RC::SUCCESS;
+  std::string key;
+  bool is_null = false;
+  std::vector<Value> key_values(right_keys_.size());
+  std::vector<uint64_t> key_hashes;
+  PhysicalOperator *right = children_[1].get();
+  while ((rc = right->next_row()) == RC::SUCCESS) {
+    Tuple *tuple = right->current_tuple();
+    rc = encode_join_key(right_keys_, *tuple, key, is_null);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+    if (is_null) {
+      continue;
+    }
+    build_rows_.emplace_back();
+    codec_.encode(*tuple, build_rows_.back());
+    hash_table_[key].push_back(build_rows_.size() - 1);
+
+    if (runtime_filter_ != nullptr) {
+      for (size_t i = 0; i < right_keys_.size(); i++) {
+        rc = right_keys_[i]->get_value(*tuple, key_values[i]);
+        if (rc != RC::SUCCESS) {
+          return rc;
+        }
+      }
+      uint64_t hash = 0;
+      if (runtime_filter_->key.hash_values(key_values.data(), hash)) {
+        key_hashes.push_back(hash);
+      } else {
+        // 类型与左边的字段不同，需要转换之后才能比较，不能按照哈希过滤
+        runtime_filter_.reset();
+      }
+    }
+  }
+  if (rc != RC::RECORD_EOF) {
+    LOG_WARN("failed to read right child of hash join. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  if (runtime_filter_ != nullptr) {
+    runtime_filter_->filter.init(static_cast<int>(hash_table_.size()));
+    for (uint64_t hash : key_hashes) {
+      runtime_filter_->filter.insert(hash);
+    }
+    if (hash_table_.size() <= MAX_PAGE_PROBE_KEYS) {
+      std::sort(key_hashes.begin(), key_hashes.end());
+      key_hashes.erase(std::unique(key_hashes.begin(), key_hashes.end()), key_hashes.end());
+      runtime_filter_->hashes = std::move(key_hashes);
+    }
+  }
+
+  right_tuple_ = right->current_tuple();
+  LOG_TRACE("hash join build finished. rows=%d, keys=%d, runtime filter=%d",
+      static_cast<int>(build_rows_.size()), static_cast<int>(hash_table_.size()), runtime_filter_ != nullptr);
+  return RC::SUCCESS;
+}
+
+RC HashJoinPhysicalOperator::match_condition(bool &result)
+{
+  result = true;
+  if (condition_ == nullptr) {
+    return RC::SUCCESS;
+  }
+  Value value;
+  RC rc = condition_->get_value(joined_tuple_, value);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to evaluate join condition. rc=%s", strrc(rc));
+    return rc;
+  }
+  result = value.get_boolean();
+  return RC::SUCCESS;
+}
+
+RC HashJoinPhysicalOperator::next()
+{
+  if (hash_table_.empty()) {
+    return RC::RECORD_EOF;
+  }
+
+  PhysicalOperator *left = children_[0].get();
+  while (true) {
+    if (matches_ != nullptr && match_pos_ < matches_->size()) {
+      std::string &row = build_rows_[(*matches_)[match_pos_++]];
+      codec_.decode(&row[0], static_cast<int>(row.size()), *right_tuple_);
+      joined_tuple_.set_right(right_tuple_);
+
+      bool result = false;
+      RC rc = match_condition(result);
+      if (rc != RC::SUCCESS) {
+        return rc;
+      }
+      if (result) {
+        return RC::SUCCESS;
+      }
+      continue;
+    }
+
+    RC rc = left->next_row();
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+    Tuple *left_tuple = left->current_tuple();
+    bool is_null = false;
+    rc = encode_join_key(left_keys_, *left_tuple, probe_key_, is_null);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+    matches_ = nullptr;
+    match_pos_ = 0;
+    if (is_null) {
+      continue;
+    }
+    auto iter = hash_table_.find(probe_key_);
+    if (iter != hash_table_.end()) {
+      matches_ = &iter->second;
+      joined_tuple_.set_left(left_tuple);
+    }
+  }
+}
+
+RC HashJoinPhysicalOperator::close()
+{
+  RC rc = RC::SUCCESS;
+  for (auto &child : children_) {
+    RC child_rc = child->close();
+    if (child_rc != RC::SUCCESS) {
+      LOG_WARN("failed to close child of hash join. rc=%s", strrc(child_rc));
+      rc = child_rc;
+    }
+  }
+  matches_ = nullptr;
+  build_rows_.clear();
+  hash_table_.clear();
+  runtime_filter_.reset();
+  return rc;
+}
+
+Tuple *HashJoinPhysicalOperator::current_tuple()
+{
+  return &joined_tuple_;
+}
@@ -0,0 +1,127 @@
+#include "include/query_engine/planner/operator/index_nested_loop_join_physical_operator.h"
+#include "include/query_engine/planner/operator/index_scan_physical_operator.h"
+#include "include/query_engine/planner/operator/join_physical_operator.h"
+
+IndexNestedLoopJoinPhysicalOperator::IndexNestedLoopJoinPhysicalOperator(
+    std::vector<std::unique_ptr<Expression>> &&left_keys, std::vector<std::unique_ptr<Expression>> &&right_keys,
+    std::unique_ptr<Expression> condition)
+    : left_keys_(std::move(left_keys)), right_keys_(std::move(right_keys)), condition_(std::move(condition))
+{}
+
+std::string IndexNestedLoopJoinPhysicalOperator::param() const
+{
+  return join_keys_to_string(left_keys_, right_keys_);
+}
+
+RC IndexNestedLoopJoinPhysicalOperator::open(Trx *trx)
+{
+  if (children_.size() != 2 || children_[1]->type() != PhysicalOperatorType::INDEX_SCAN || left_keys_.size() != 1) {
+    LOG_WARN("index nested loop join requires a left child and an index scan as right child");
+    return RC::INTERNAL;
+  }
+  index_scan_ = static_cast<IndexScanPhysicalOperator *>(children_[1].get());
+
+  RC rc = children_[0]->open(trx);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to open left child of index nested loop join. rc=%s", strrc(rc));
+    return rc;
+  }
+  // 右边以空范围打开，每次探测时再设置范围
+  rc = index_scan_->open(trx);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to open index scan of index nested loop join. rc=%s", strrc(rc));
+    children_[0]->close();
+    return rc;
+  }
+  probing_ = false;
+  return RC::SUCCESS;
+}
+
+RC IndexNestedLoopJoinPhysicalOperator::match_condition(bool &result)
+{
+  result = true;
+  if (condition_ == nullptr) {
+    return RC::SUCCESS;
+  }
+  Value value;
+  RC rc = condition_->get_value(joined_tuple_, value);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to evaluate join condition. rc=%s", strrc(rc));
+    return rc;
+  }
+  result = value.get_boolean();
+  return RC::SUCCESS;
+}
+
+RC IndexNestedLoopJoinPhysicalOperator::next()
+{
+  PhysicalOperator *left = children_[0].get();
+  while (true) {
+    if (probing_) {
+      RC rc = index_scan_->next_row();
+      if (rc == RC::SUCCESS) {
+        joined_tuple_.set_right(index_scan_->current_tuple());
+        bool result = false;
+        rc = match_condition(result);
+        if (rc != RC::SUCCESS) {
+          return rc;
+        }
+        if (result) {
+          return RC::SUCCESS;
+        }
+        continue;
+      }
+      if (rc != RC::RECORD_EOF) {
+        return rc;
+      }
+      probing_ = false;
+    }
+
+    RC rc = left->next_row();
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+    Tuple *left_tuple = left->current_tuple();
+    Value value;
+    rc = left_keys_.front()->get_value(*left_tuple, value);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to evaluate probe key. rc=%s", strrc(rc));
+      return rc;
+    }
+    if (value.is_null()) {
+      continue;
+    }
+
+    IndexScanRange range;
+    range.has_left = range.has_right = true;
+    range.left_inclusive = range.right_inclusive = true;
+    range.left_key.assign(value.data(), value.length());
+    range.right_key = range.left_key;
+    rc = index_scan_->rescan(std::move(range));
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to rescan index. rc=%s", strrc(rc));
+      return rc;
+    }
+    joined_tuple_.set_left(left_tuple);
+    probing_ = true;
+  }
+}
+
+RC IndexNestedLoopJoinPhysicalOperator::close()
+{
+  RC rc = RC::SUCCESS;
+  for (auto &child : children_) {
+    RC child_rc = child->close();
+    if (child_rc != RC::SUCCESS) {
+      LOG_WARN("failed to close child of index nested loop join. rc=%s", strrc(child_rc));
+      rc = child_rc;
+    }
+  }
+  probing_ = false;
+  return rc;
+}
+
+Tuple *IndexNestedLoopJoinPhysicalOperator::current_tuple()
+{
+  return &joined_tuple_;
+}
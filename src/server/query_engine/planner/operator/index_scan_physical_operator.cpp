@@ -1,6 +1,7 @@
 #include "include/query_engine/planner/operator/index_scan_physical_operator.h"
 
 #include "include/storage_engine/index/index.h"
+#include "include/storage_engine/transaction/trx.h"
 
 // TODO [Lab2]
 // IndexScanOperator的实现逻辑,通过索引直接获取对应的Page来减少磁盘的扫描
@@ -12,91 +13,211 @@ RC IndexScanPhysicalOperator::open(Trx *trx)
     return RC::INTERNAL;
   }
 
-  const char *left_key = left_null_ ? nullptr : left_value_.data();
-  const char *right_key = right_null_ ? nullptr : right_value_.data();
-  IndexScanner *index_scanner = index_->create_scanner(left_key, 
-                                                       left_value_.length(), 
-                                                       left_inclusive_,
-                                                       right_key, 
-                                                       right_value_.length(), 
-                                                       right_inclusive_);
-  if(index_scanner == nullptr)
-  {
-    return RC::INTERNAL;
+  trx_ = trx;
+  if (table_alias_.empty()) {
+    table_alias_ = table_->name();
+    LOG_WARN("table alias is empty, use table name as alias.\n"
+      "Hint: Consider calling set_table_alias() on IndexScanOperator to set an alias for the table.");
+  }
+  tuple_.set_schema(table_,table_alias_,table_->table_meta().field_metas());
+
+  ExpressionCompiler compiler(table_, table_alias_);
+  kernels_.clear();
+  always_false_ = false;
+  for (const std::unique_ptr<Expression> &expr : predicates_) {
+    kernels_.push_back(compiler.compile(expr.get()));
+    bool value = true;
+    if (kernels_.back()->constant(value) && !value) {
+      always_false_ = true;
+    }
+  }
+
+  if (index_only_) {
+    const TableMeta &table_meta = table_->table_meta();
+    const IndexMeta &index_meta = index_->index_meta();
+    key_fields_.clear();
+    // 只复制用户字段，B+树的键后面附带的系统字段是插入时的值，不能代表记录当前的状态
+    for (size_t i = 0; i < index_meta.user_field_amount(); i++) {
+      const FieldMeta *field_meta = table_meta.field(index_meta.field(static_cast<int>(i)));
+      key_fields_.emplace_back(field_meta->offset(), field_meta->len());
+    }
+    // 事务字段与NULL标记都是0，其它不在索引中的字段不会被访问
+    index_record_.assign(table_meta.record_size(), 0);
   }
 
   record_handler_ = table_->record_handler();
   if(record_handler_ == nullptr)
   {
-    index_scanner->destroy();
     return RC::INTERNAL;
   }
-  index_scanner_ = index_scanner;
+  return open_scanner();
+}
 
-  if (table_alias_.empty()) {
-    table_alias_ = table_->name();
-    LOG_WARN("table alias is empty, use table name as alias.\n"
-      "Hint: Consider calling set_table_alias() on IndexScanOperator to set an alias for the table.");
+RC IndexScanPhysicalOperator::open_scanner()
+{
+  if (range_.empty) {
+    // 范围为空，不需要打开索引
+    return RC::SUCCESS;
   }
 
-  tuple_.set_schema(table_,table_alias_,table_->table_meta().field_metas());
-
+  const char *left_key = range_.has_left ? range_.left_key.data() : nullptr;
+  const char *right_key = range_.has_right ? range_.right_key.data() : nullptr;
+  IndexScanner *index_scanner = index_->create_scanner(left_key,
+                                                       static_cast<int>(range_.left_key.size()),
+                                                       range_.left_inclusive,
+                                                       right_key,
+                                                       static_cast<int>(range_.right_key.size()),
+                                                       range_.right_inclusive);
+  if(index_scanner == nullptr)
+  {
+    return RC::INTERNAL;
+  }
+  index_scanner_ = index_scanner;
   return RC::SUCCESS;
 }
 
+RC IndexScanPhysicalOperator::rescan(IndexScanRange range)
+{
+  close();
+  range_ = std::move(range);
+  return open_scanner();
+}
+
 RC IndexScanPhysicalOperator::next()
 {
   RID rid;
-  record_page_handler_.cleanup();
-
-  RC rc = index_scanner_->next_entry(&rid, false);
-  if (rc == RC::RECORD_EOF) {
+  RC rc = RC::SUCCESS;
+  bool filter_result = false;
+  if (index_scanner_ == nullptr || always_false_) {
     return RC::RECORD_EOF;
   }
-  if (rc != RC::SUCCESS) {
-    LOG_WARN("Failed to fetch next entry from index scanner. rc=%s", strrc(rc));
-    return rc;
+  while (true) {
+    record_page_handler_.cleanup();
+
+    rc = next_rid(rid);
+    if (rc == RC::RECORD_EOF) {
+      return RC::RECORD_EOF;
+    }
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("Failed to fetch next entry from index scanner. rc=%s", strrc(rc));
+      return rc;
+    }
+    rows_scanned_++;
+
+    if (!index_only_ || !read_index_entry(rid)) {
+      rc = record_handler_->get_record(record_page_handler_, &rid, readonly_, &current_record_);
+      if (rc != RC::SUCCESS) {
+        LOG_WARN("Failed to fetch record for RID. rid=%s, rc=%s", rid.to_string().c_str(), strrc(rc));
+        return rc;
+      }
+
+      // 与表扫描一样，由事务判断当前记录是否可见
+      if (trx_ != nullptr) {
+        rc = trx_->visit_record(table_, current_record_, readonly_);
+        if (rc == RC::RECORD_INVISIBLE) {
+          continue;
+        }
+        if (rc != RC::SUCCESS) {
+          return rc;
+        }
+      }
+    }
+
+    tuple_._set_record(&current_record_);
+    rc = filter(tuple_, filter_result);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+    if (filter_result) {
+      return RC::SUCCESS;
+    }
   }
+}
 
-  rc = record_handler_->get_record(record_page_handler_, &rid, readonly_, &current_record_);
-  if (rc != RC::SUCCESS) {
-    LOG_WARN("Failed to fetch record for RID. rid=%s, rc=%s", rid.to_string().c_str(), strrc(rc));
-    return rc;
+RC IndexScanPhysicalOperator::next_rid(RID &rid)
+{
+  if (readonly_) {
+    return index_scanner_->next_entry(&rid, false);
   }
 
+  // 修改数据时先取出范围内所有的RID。更新会插入新版本的记录与索引项，边扫描边修改会再次访问到本条语句插入的版本
+  if (!rids_collected_) {
+    RC rc = RC::SUCCESS;
+    RID entry;
+    while ((rc = index_scanner_->next_entry(&entry, false)) == RC::SUCCESS) {
+      rids_.push_back(entry);
+    }
+    if (rc != RC::RECORD_EOF) {
+      return rc;
+    }
+    rids_collected_ = true;
+    rid_pos_ = 0;
+  }
+  if (rid_pos_ >= rids_.size()) {
+    return RC::RECORD_EOF;
+  }
+  rid = rids_[rid_pos_++];
   return RC::SUCCESS;
 }
 
 RC IndexScanPhysicalOperator::close()
 {
-  index_scanner_->destroy();
-  index_scanner_ = nullptr;
+  if (index_scanner_ != nullptr) {
+    index_scanner_->destroy();
+    index_scanner_ = nullptr;
+  }
+  rids_.clear();
+  rids_collected_ = false;
+  record_page_handler_.cleanup();
   return RC::SUCCESS;
 }
 
 Tuple* IndexScanPhysicalOperator::current_tuple(){
+  if (tuple_.order_set()) {
+    tuple_.remove_order_set();
+    return &tuple_;
+  }
   tuple_._set_record(&current_record_);
   return &tuple_;
 }
 
 std::string IndexScanPhysicalOperator::param() const
 {
-  return std::string(index_->index_meta().name()) + " ON " + table_->name();
+  std::string param = std::string(index_->index_meta().name()) + " ON " + table_->name();
+  if (index_only_) {
+    param += ", index only";
+  }
+  if (!range_.desc.empty()) {
+    param += ", " + range_.desc;
+  }
+  return param;
+}
+
+bool IndexScanPhysicalOperator::read_index_entry(const RID &rid)
+{
+  // 不能确定记录对当前事务可见时，还需要读取数据页面
+  if (trx_ != nullptr && !trx_->page_visible(record_handler_->visible_hint(rid.page_num))) {
+    return false;
+  }
+  const char *key = index_scanner_->current_key();
+  if (key == nullptr) {
+    return false;
+  }
+  for (const auto &[offset, len] : key_fields_) {
+    memcpy(index_record_.data() + offset, key, len);
+    key += len;
+  }
+  current_record_.set_data(index_record_.data(), static_cast<int>(index_record_.size()));
+  current_record_.set_rid(rid);
+  return true;
 }
 
 RC IndexScanPhysicalOperator::filter(RowTuple &tuple, bool &result)
 {
   RC rc = RC::SUCCESS;
-  Value value;
-  for (std::unique_ptr<Expression> &expr : predicates_) {
-    rc = expr->get_value(tuple, value);
-    if (rc != RC::SUCCESS) {
-      return rc;
-    }
-
-    bool tmp_result = value.get_boolean();
-    if (!tmp_result) {
-      result = false;
+  for (const std::unique_ptr<ExprKernel> &kernel : kernels_) {
+    rc = kernel->evaluate(tuple, result);
+    if (rc != RC::SUCCESS || !result) {
       return rc;
     }
   }
@@ -1,4 +1,52 @@
 #include "include/query_engine/planner/operator/join_physical_operator.h"
+#include "include/query_engine/planner/operator/external_sort.h"
+#include "include/query_engine/structor/expression/field_expression.h"
+
+RC encode_join_key(
+    const std::vector<std::unique_ptr<Expression>> &keys, const Tuple &tuple, std::string &key, bool &is_null)
+{
+  key.clear();
+  is_null = false;
+  Value value;
+  for (const std::unique_ptr<Expression> &expr : keys) {
+    RC rc = expr->get_value(tuple, value);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to evaluate join key. rc=%s", strrc(rc));
+      return rc;
+    }
+    if (value.is_null()) {
+      is_null = true;
+      return RC::SUCCESS;
+    }
+    SortKeyEncoder::append(value, true /*is_asc*/, key);
+  }
+  return RC::SUCCESS;
+}
+
+namespace {
+std::string key_name(const Expression *expr)
+{
+  if (expr->type() == ExprType::FIELD) {
+    const Field &field = static_cast<const FieldExpr *>(expr)->field();
+    const char *table_name = field.table_alias()[0] != '\0' ? field.table_alias() : field.table_name();
+    return std::string(table_name) + "." + field.field_name();
+  }
+  return expr->name();
+}
+}  // namespace
+
+std::string join_keys_to_string(
+    const std::vector<std::unique_ptr<Expression>> &left_keys, const std::vector<std::unique_ptr<Expression>> &right_keys)
+{
+  std::string result;
+  for (size_t i = 0; i < left_keys.size() && i < right_keys.size(); i++) {
+    if (!result.empty()) {
+      result += ", ";
+    }
+    result += key_name(left_keys[i].get()) + "=" + key_name(right_keys[i].get());
+  }
+  return result;
+}
 
 JoinPhysicalOperator::JoinPhysicalOperator() = default;
 
@@ -31,7 +79,7 @@ RC JoinPhysicalOperator::open(Trx *trx)
     return rc;
   }
 
-  rc = children_[0]->next();
+  rc = children_[0]->next_row();
   if (rc != RC::SUCCESS) {
     left_is_empty = true;
   }
@@ -69,7 +117,7 @@ RC JoinPhysicalOperator::next()
   while (true) {
     Tuple *left_tuple = children_[0]->current_tuple();
     
-    while (children_[1]->next() == RC::SUCCESS) {
+    while (children_[1]->next_row() == RC::SUCCESS) {
       Tuple *right_tuple = children_[1]->current_tuple();
       
       // 进行连接
@@ -86,7 +134,7 @@ RC JoinPhysicalOperator::next()
     children_[1]->close();
     children_[1]->open(trx_);
 
-    if (children_[0]->next() != RC::SUCCESS) {
+    if (children_[0]->next_row() != RC::SUCCESS) {
       // 左子树已经遍历完毕
       children_[0]->close();
       children_[1]->close();
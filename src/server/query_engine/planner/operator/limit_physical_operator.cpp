@@ -0,0 +1,55 @@
+#include "common/log/log.h"
+#include "include/query_engine/planner/operator/limit_physical_operator.h"
+
+LimitPhysicalOperator::LimitPhysicalOperator(int limit, int offset) : limit_(limit), offset_(offset)
+{}
+
+std::string LimitPhysicalOperator::param() const
+{
+  return "limit=" + std::to_string(limit_) + ", offset=" + std::to_string(offset_);
+}
+
+RC LimitPhysicalOperator::open(Trx *trx)
+{
+  if (children_.size() != 1) {
+    LOG_WARN("limit operator must has one child");
+    return RC::INTERNAL;
+  }
+
+  skipped_ = 0;
+  emitted_ = 0;
+  return children_[0]->open(trx);
+}
+
+RC LimitPhysicalOperator::next()
+{
+  if (limit_ >= 0 && emitted_ >= limit_) {
+    return RC::RECORD_EOF;
+  }
+
+  RC rc = RC::SUCCESS;
+  while (skipped_ < offset_) {
+    rc = children_[0]->next_row();
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+    skipped_++;
+  }
+
+  rc = children_[0]->next_row();
+  if (rc == RC::SUCCESS) {
+    emitted_++;
+  }
+  return rc;
+}
+
+RC LimitPhysicalOperator::close()
+{
+  children_[0]->close();
+  return RC::SUCCESS;
+}
+
+Tuple *LimitPhysicalOperator::current_tuple()
+{
+  return children_[0]->current_tuple();
+}
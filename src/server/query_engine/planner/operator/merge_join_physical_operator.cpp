@@ -0,0 +1,230 @@
+#include "include/query_engine/planner/operator/merge_join_physical_operator.h"
+
+#include <cstring>
+
+#include "include/query_engine/planner/operator/join_physical_operator.h"
+
+MergeJoinPhysicalOperator::MergeJoinPhysicalOperator(std::vector<std::unique_ptr<Expression>> &&left_keys,
+    std::vector<std::unique_ptr<Expression>> &&right_keys, std::unique_ptr<Expression> condition)
+    : left_keys_(std::move(left_keys)), right_keys_(std::move(right_keys)), condition_(std::move(condition))
+{}
+
+std::string MergeJoinPhysicalOperator::param() const
+{
+  return join_keys_to_string(left_keys_, right_keys_);
+}
+
+RC MergeJoinPhysicalOperator::sort_child(PhysicalOperator &child, const std::vector<std::unique_ptr<Expression>> &keys,
+    ExternalSorter &sorter, Tuple *&tuple)
+{
+  SortRowCodec codec;
+  std::string key;
+  std::string row;
+  std::string payload;
+  bool is_null = false;
+  RC rc = RC::SUCCESS;
+  while ((rc = child.next_row()) == RC::SUCCESS) {
+    Tuple *child_tuple = child.current_tuple();
+    rc = encode_join_key(keys, *child_tuple, key, is_null);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+    if (is_null) {
+      continue;
+    }
+    codec.encode(*child_tuple, row);
+    const uint32_t key_len = static_cast<uint32_t>(key.size());
+    payload.assign(reinterpret_cast<const char *>(&key_len), sizeof(key_len));
+    payload.append(key);
+    payload.append(row);
+    rc = sorter.add(key.data(), static_cast<int>(key.size()), payload.data(), static_cast<int>(payload.size()));
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+  }
+  if (rc != RC::RECORD_EOF) {
+    LOG_WARN("failed to read child of merge join. rc=%s", strrc(rc));
+    return rc;
+  }
+  tuple = child.current_tuple();
+  return sorter.finish();
+}
+
+RC MergeJoinPhysicalOperator::fetch(ExternalSorter &sorter, std::string_view &key, char *&row, int &row_len)
+{
+  char *payload = nullptr;
+  int payload_len = 0;
+  RC rc = sorter.next(payload, payload_len);
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+  uint32_t key_len = 0;
+  memcpy(&key_len, payload, sizeof(key_len));
+  key = std::string_view(payload + sizeof(key_len), key_len);
+  row = payload + sizeof(key_len) + key_len;
+  row_len = payload_len - static_cast<int>(sizeof(key_len) + key_len);
+  return RC::SUCCESS;
+}
+
+RC MergeJoinPhysicalOperator::open(Trx *trx)
+{
+  if (children_.size() != 2) {
+    LOG_WARN("merge join requires exactly two children");
+    return RC::INTERNAL;
+  }
+
+  RC rc = children_[0]->open(trx);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to open left child of merge join. rc=%s", strrc(rc));
+    return rc;
+  }
+  rc = children_[1]->open(trx);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to open right child of merge join. rc=%s", strrc(rc));
+    children_[0]->close();
+    return rc;
+  }
+
+  left_sorter_.reset();
+  right_sorter_.reset();
+  rc = sort_child(*children_[0], left_keys_, left_sorter_, left_tuple_);
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+  rc = sort_child(*children_[1], right_keys_, right_sorter_, right_tuple_);
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+
+  left_valid_ = false;
+  group_valid_ = false;
+  group_pos_ = 0;
+  right_group_.clear();
+  rc = fetch(right_sorter_, right_key_, right_row_, right_row_len_);
+  right_valid_ = rc == RC::SUCCESS;
+  return rc == RC::SUCCESS || rc == RC::RECORD_EOF ? RC::SUCCESS : rc;
+}
+
+RC MergeJoinPhysicalOperator::advance_left()
+{
+  std::string_view key;
+  char *row = nullptr;
+  int row_len = 0;
+  RC rc = fetch(left_sorter_, key, row, row_len);
+  if (rc != RC::SUCCESS) {
+    left_valid_ = false;
+    return rc;
+  }
+  left_key_.assign(key.data(), key.size());
+  left_codec_.decode(row, row_len, *left_tuple_);
+  joined_tuple_.set_left(left_tuple_);
+  left_valid_ = true;
+  return RC::SUCCESS;
+}
+
+RC MergeJoinPhysicalOperator::load_right_group()
+{
+  group_valid_ = false;
+  right_group_.clear();
+
+  RC rc = RC::SUCCESS;
+  while (right_valid_ && right_key_.compare(left_key_) < 0) {
+    rc = fetch(right_sorter_, right_key_, right_row_, right_row_len_);
+    right_valid_ = rc == RC::SUCCESS;
+  }
+  if (rc != RC::SUCCESS && rc != RC::RECORD_EOF) {
+    return rc;
+  }
+  if (!right_valid_ || right_key_ != left_key_) {
+    return RC::SUCCESS;
+  }
+
+  group_key_ = left_key_;
+  while (right_valid_ && right_key_ == group_key_) {
+    right_group_.emplace_back(right_row_, right_row_len_);
+    rc = fetch(right_sorter_, right_key_, right_row_, right_row_len_);
+    right_valid_ = rc == RC::SUCCESS;
+  }
+  if (rc != RC::SUCCESS && rc != RC::RECORD_EOF) {
+    return rc;
+  }
+  group_valid_ = true;
+  return RC::SUCCESS;
+}
+
+RC MergeJoinPhysicalOperator::match_condition(bool &result)
+{
+  result = true;
+  if (condition_ == nullptr) {
+    return RC::SUCCESS;
+  }
+  Value value;
+  RC rc = condition_->get_value(joined_tuple_, value);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to evaluate join condition. rc=%s", strrc(rc));
+    return rc;
+  }
+  result = value.get_boolean();
+  return RC::SUCCESS;
+}
+
+RC MergeJoinPhysicalOperator::next()
+{
+  while (true) {
+    if (left_valid_ && group_valid_ && group_pos_ < right_group_.size()) {
+      std::string &row = right_group_[group_pos_++];
+      right_codec_.decode(&row[0], static_cast<int>(row.size()), *right_tuple_);
+      joined_tuple_.set_right(right_tuple_);
+
+      bool result = false;
+      RC rc = match_condition(result);
+      if (rc != RC::SUCCESS) {
+        return rc;
+      }
+      if (result) {
+        return RC::SUCCESS;
+      }
+      continue;
+    }
+
+    // 右边已经读完并且没有可以复用的一组行，左边剩下的行都不会匹配
+    if (!right_valid_ && !group_valid_) {
+      return RC::RECORD_EOF;
+    }
+
+    RC rc = advance_left();
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+    group_pos_ = 0;
+    if (group_valid_ && left_key_ == group_key_) {
+      continue;
+    }
+    rc = load_right_group();
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+  }
+}
+
+RC MergeJoinPhysicalOperator::close()
+{
+  RC rc = RC::SUCCESS;
+  for (auto &child : children_) {
+    RC child_rc = child->close();
+    if (child_rc != RC::SUCCESS) {
+      LOG_WARN("failed to close child of merge join. rc=%s", strrc(child_rc));
+      rc = child_rc;
+    }
+  }
+  left_sorter_.reset();
+  right_sorter_.reset();
+  right_group_.clear();
+  left_valid_ = right_valid_ = group_valid_ = false;
+  return rc;
+}
+
+Tuple *MergeJoinPhysicalOperator::current_tuple()
+{
+  return &joined_tuple_;
+}
@@ -1,11 +1,10 @@
 #include "common/log/log.h"
 #include "include/query_engine/planner/operator/order_physical_operator.h"
-#include "include/storage_engine/recorder/record.h"
 #include "include/query_engine/analyzer/statement/filter_stmt.h"
 #include "include/storage_engine/recorder/field.h"
-#include <algorithm>
 
-OrderPhysicalOperator::OrderPhysicalOperator(std::vector<OrderByUnit *> order_units) : order_units_(std::move(order_units))
+OrderPhysicalOperator::OrderPhysicalOperator(std::vector<OrderByUnit *> order_units, size_t memory_budget)
+    : order_units_(std::move(order_units)), sorter_(memory_budget)
 {}
 
 RC OrderPhysicalOperator::open(Trx *trx)
@@ -15,6 +14,8 @@ RC OrderPhysicalOperator::open(Trx *trx)
     return RC::INTERNAL;
   }
 
+  is_init_ = true;
+  sorter_.reset();
   return children_[0]->open(trx);
 }
 
@@ -29,16 +30,20 @@ RC OrderPhysicalOperator::next()
     }
   }
 
-  if (it_ != st_idx_.end()) {
-    children_[0]->current_tuple()->set_record(st_[*it_]);
-    it_ ++;
-    return RC::SUCCESS;
+  char *payload = nullptr;
+  int payload_len = 0;
+  rc = sorter_.next(payload, payload_len);
+  if (rc != RC::SUCCESS) {
+    return rc;
   }
-  return RC::RECORD_EOF;
+
+  codec_.decode(payload, payload_len, *children_[0]->current_tuple());
+  return RC::SUCCESS;
 }
 
 RC OrderPhysicalOperator::close()
 {
+  sorter_.reset();
   children_[0]->close();
   return RC::SUCCESS;
 }
@@ -51,64 +56,40 @@ Tuple *OrderPhysicalOperator::current_tuple()
 RC OrderPhysicalOperator::sort_table() {
   RC rc = RC::SUCCESS;
 
-  std::vector<std::pair<std::vector<Value>, int>> tuple_table;
-  std::vector<Value> tuple_values;
+  while (RC::SUCCESS == (rc = children_[0]->next_row())) {
+    Tuple *tuple = children_[0]->current_tuple();
 
-  int index = 0;
-  while (RC::SUCCESS == (rc = children_[0]->next())) {
-    tuple_values.clear();
+    sort_key_.clear();
     for (const OrderByUnit *unit : order_units_) {
-      Expression *expr = unit->expr();
       Value value;
-      expr->get_value(*children_[0]->current_tuple(), value);
-      tuple_values.emplace_back(value);
+      rc = unit->expr()->get_value(*tuple, value);
+      if (rc != RC::SUCCESS) {
+        LOG_WARN("failed to get sort key value. rc=%s", strrc(rc));
+        return rc;
+      }
+      SortKeyEncoder::append(value, unit->sort_type(), sort_key_);
     }
-    tuple_table.emplace_back(tuple_values, index ++);
-    std::vector<Record *> records;
-    children_[0]->current_tuple()->get_record(records);
-    for (auto &rcd_ptr : records) {
-      rcd_ptr = new Record(*rcd_ptr);
+
+    codec_.encode(*tuple, payload_);
+
+    rc = sorter_.add(sort_key_.data(), static_cast<int>(sort_key_.size()), payload_.data(), static_cast<int>(payload_.size()));
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to add row to sorter. rc=%s", strrc(rc));
+      return rc;
     }
-    st_.emplace_back(records);
   }
   if (RC::RECORD_EOF != rc) {
     LOG_ERROR("Fetch Table Error In SortOperator. RC: %d", rc);
     return rc;
   }
 
-  bool is_asc[order_units_.size()];
-  for (int i = 0; i < order_units_.size(); ++i) {
-    is_asc[i] = order_units_[i]->sort_type();
+  rc = sorter_.finish();
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to finish external sort. rc=%s", strrc(rc));
+    return rc;
   }
-
-  auto cmp = [&is_asc](const std::pair<std::vector<Value>, int> &a, const std::pair<std::vector<Value>, int> &b) {
-    auto &cells_a = a.first;
-    auto &cells_b = b.first;
-    assert(cells_a.size() == cells_b.size());
-    for (int i = 0; i < cells_a.size(); i ++) {
-      auto &cell_a = cells_a[i];
-      auto &cell_b = cells_b[i];
-      if (cell_a.is_null() && cell_b.is_null()) {
-        continue;
-      }
-      if (cell_a.is_null()) {
-        return is_asc[i];
-      }
-      if (cell_b.is_null()) {
-        return !is_asc[i];
-      }
-      int cmp = cell_a.compare(cell_b);
-      if (cmp != 0) {
-        return is_asc[i] ? cmp < 0: cmp > 0;
-      }
-    }
-    return false;  // completely same
-  };
-  std::sort(tuple_table.begin(), tuple_table.end(), cmp);
-
-  for (auto & i : tuple_table) {
-    st_idx_.emplace_back(i.second);
+  if (sorter_.spilled_run_count() > 0) {
+    LOG_INFO("order by spilled %d runs to temporary files", sorter_.spilled_run_count());
   }
-  it_ = st_idx_.begin();
   return RC::SUCCESS;
 }
@@ -9,6 +9,12 @@ std::string physical_operator_type_name(PhysicalOperatorType type)
       return "INDEX_SCAN";
     case PhysicalOperatorType::JOIN:
       return "JOIN";
+    case PhysicalOperatorType::HASH_JOIN:
+      return "HASH_JOIN";
+    case PhysicalOperatorType::MERGE_JOIN:
+      return "MERGE_JOIN";
+    case PhysicalOperatorType::INDEX_NL_JOIN:
+      return "INDEX_NL_JOIN";
     case PhysicalOperatorType::EXPLAIN:
       return "EXPLAIN";
     case PhysicalOperatorType::PREDICATE:
@@ -27,6 +33,12 @@ std::string physical_operator_type_name(PhysicalOperatorType type)
       return "GROUP_BY";
     case PhysicalOperatorType::ORDER_BY:
       return "ORDER_BY";
+    case PhysicalOperatorType::LIMIT:
+      return "LIMIT";
+    case PhysicalOperatorType::TOP_N:
+      return "TOP_N";
+    case PhysicalOperatorType::EXCHANGE:
+      return "EXCHANGE";
     default:
       return "UNKNOWN";
   }
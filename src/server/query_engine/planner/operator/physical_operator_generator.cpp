@@ -26,15 +26,37 @@
 #include "include/query_engine/planner/operator/group_by_physical_operator.h"
 #include "include/query_engine/planner/operator/index_scan_physical_operator.h"
 #include "include/query_engine/planner/operator/join_physical_operator.h"
+#include "include/query_engine/planner/operator/hash_join_physical_operator.h"
+#include "include/query_engine/planner/operator/merge_join_physical_operator.h"
+#include "include/query_engine/planner/operator/index_nested_loop_join_physical_operator.h"
+#include "include/query_engine/planner/node/limit_logical_node.h"
+#include "include/query_engine/planner/operator/limit_physical_operator.h"
+#include "include/query_engine/planner/operator/top_n_physical_operator.h"
+#include "include/query_engine/planner/operator/exchange_physical_operator.h"
+#include "include/common/global_context.h"
+#include "include/common/worker_pool.h"
 #include "common/log/log.h"
 #include "include/query_engine/structor/expression/comparison_expression.h"
 #include "include/query_engine/structor/expression/field_expression.h"
 #include "include/query_engine/structor/expression/value_expression.h"
+#include "include/query_engine/structor/expression/conjunction_expression.h"
+#include "include/query_engine/structor/expression/arithmetic_expression.h"
 #include "include/storage_engine/recorder/table.h"
+#include "include/storage_engine/index/index.h"
 
 using namespace std;
 
 RC PhysicalOperatorGenerator::create(LogicalNode &logical_operator, unique_ptr<PhysicalOperator> &oper, bool is_delete)
+{
+  RC rc = create_operator(logical_operator, oper, is_delete);
+  if (rc == RC::SUCCESS && oper != nullptr && logical_operator.estimated_rows() >= 0) {
+    oper->set_estimate(logical_operator.estimated_rows(), logical_operator.estimated_cost());
+  }
+  return rc;
+}
+
+RC PhysicalOperatorGenerator::create_operator(
+    LogicalNode &logical_operator, unique_ptr<PhysicalOperator> &oper, bool is_delete)
 {
   switch (logical_operator.type()) {
     case LogicalNodeType::TABLE_GET: {
@@ -78,6 +100,9 @@ RC PhysicalOperatorGenerator::create(LogicalNode &logical_operator, unique_ptr<P
     case LogicalNodeType::GROUP_BY: {
       return RC::UNIMPLENMENT;
     }
+    case LogicalNodeType::LIMIT: {
+      return create_plan(static_cast<LimitLogicalNode &>(logical_operator), oper);
+    }
 
     default: {
       return RC::INVALID_ARGUMENT;
@@ -85,46 +110,438 @@ RC PhysicalOperatorGenerator::create(LogicalNode &logical_operator, unique_ptr<P
   }
 }
 
-RC PhysicalOperatorGenerator::create_plan(
-    TableGetLogicalNode &table_get_oper, unique_ptr<PhysicalOperator> &oper, bool is_delete)
+namespace {
+
+/**
+ * @brief 一个字段上由下推条件得到的取值范围
+ */
+struct FieldBounds
 {
+  bool  has_low        = false;
+  bool  low_inclusive  = false;
+  Value low;
+  bool  has_high       = false;
+  bool  high_inclusive = false;
+  Value high;
+  bool  empty          = false;
+  vector<size_t> predicates;  ///< 参与构成范围的条件下标
+
+  bool is_equal() const
+  {
+    return has_low && has_high && low_inclusive && high_inclusive && low.compare(high) == 0;
+  }
+
+  void tighten_low(const Value &value, bool inclusive)
+  {
+    int cmp = has_low ? value.compare(low) : 1;
+    if (cmp > 0 || (cmp == 0 && !inclusive)) {
+      low           = value;
+      low_inclusive = inclusive;
+      has_low       = true;
+    }
+  }
+
+  void tighten_high(const Value &value, bool inclusive)
+  {
+    int cmp = has_high ? value.compare(high) : -1;
+    if (cmp < 0 || (cmp == 0 && !inclusive)) {
+      high           = value;
+      high_inclusive = inclusive;
+      has_high       = true;
+    }
+  }
+};
+
+CompOp swap_comp_op(CompOp comp)
+{
+  switch (comp) {
+    case LESS_EQUAL: return GREAT_EQUAL;
+    case LESS_THAN: return GREAT_THAN;
+    case GREAT_EQUAL: return LESS_EQUAL;
+    case GREAT_THAN: return LESS_THAN;
+    default: return comp;
+  }
+}
+
+/**
+ * @brief 收集 field op value 形式的条件在某个字段上构成的范围
+ * @details 值的类型需要与字段一致，整数可以转换成浮点数。与 NULL 比较的条件不会使用索引
+ */
+FieldBounds collect_field_bounds(TableGetLogicalNode &table_get_oper, const FieldMeta &field_meta)
+{
+  FieldBounds bounds;
   vector<unique_ptr<Expression>> &predicates = table_get_oper.predicates();
-  Index *index = nullptr;
-  const Value *value = nullptr;
+  for (size_t i = 0; i < predicates.size(); i++) {
+    if (predicates[i]->type() != ExprType::COMPARISON) {
+      continue;
+    }
+    auto *compare_expr = static_cast<ComparisonExpr *>(predicates[i].get());
+    Expression *left_expr = compare_expr->left().get();
+    Expression *right_expr = compare_expr->right().get();
+    CompOp comp = compare_expr->comp();
+    if (right_expr == nullptr) {  // IS [NOT] NULL
+      continue;
+    }
+    if (left_expr->type() == ExprType::VALUE && right_expr->type() == ExprType::FIELD) {
+      std::swap(left_expr, right_expr);
+      comp = swap_comp_op(comp);
+    }
+    if (left_expr->type() != ExprType::FIELD || right_expr->type() != ExprType::VALUE) {
+      continue;
+    }
 
-  for (auto &predicate : predicates) {
-    if (predicate->type() == ExprType::COMPARISON) {
-      auto compare_expr = dynamic_cast<ComparisonExpr*>(predicate.get());
-      if (compare_expr->comp() != EQUAL_TO) {
+    const Field &field = static_cast<FieldExpr *>(left_expr)->field();
+    if (field.table() != table_get_oper.table() || 0 != strcmp(field.field_name(), field_meta.name())) {
+      continue;
+    }
+
+    Value value = static_cast<ValueExpr *>(right_expr)->get_value();
+    if (value.attr_type() != field_meta.type()) {
+      if (field_meta.type() == FLOATS && value.attr_type() == INTS) {
+        value = Value(static_cast<float>(value.get_int()));
+      } else {
         continue;
       }
+    }
+
+    switch (comp) {
+      case EQUAL_TO: {
+        bounds.tighten_low(value, true);
+        bounds.tighten_high(value, true);
+      } break;
+      case GREAT_EQUAL: bounds.tighten_low(value, true); break;
+      case GREAT_THAN: bounds.tighten_low(value, false); break;
+      case LESS_EQUAL: bounds.tighten_high(value, true); break;
+      case LESS_THAN: bounds.tighten_high(value, false); break;
+      default: continue;
+    }
+    bounds.predicates.push_back(i);
+  }
+
+  if (bounds.has_low && bounds.has_high) {
+    int cmp = bounds.low.compare(bounds.high);
+    if (cmp > 0 || (cmp == 0 && !(bounds.low_inclusive && bounds.high_inclusive))) {
+      bounds.empty = true;
+    }
+  }
+  return bounds;
+}
+
+/// 按照字段长度把值追加到多列索引的键中
+bool append_key_part(const Value &value, const FieldMeta &field_meta, std::string &key)
+{
+  if (value.length() > field_meta.len()) {
+    return false;
+  }
+  std::string part(value.data(), value.length());
+  part.resize(field_meta.len(), '\0');
+  key += part;
+  return true;
+}
+
+/// explain 中展示的范围
+std::string range_desc(const FieldBounds &bounds)
+{
+  return std::string("range=") + (bounds.has_low && bounds.low_inclusive ? "[" : "(") +
+         (bounds.has_low ? bounds.low.to_string() : "-inf") + "," + (bounds.has_high ? bounds.high.to_string() : "+inf") +
+         (bounds.has_high && bounds.high_inclusive ? "]" : ")");
+}
+
+/// 整数与日期的比较是精确的，不允许为 NULL 时索引范围已经完全表达了字段上的条件
+bool exact_key_field(const FieldMeta &field_meta)
+{
+  return !field_meta.nullable() && (field_meta.type() == INTS || field_meta.type() == DATES);
+}
+
+/**
+ * @brief 收集表达式中引用的字段
+ * @details 遇到无法确定引用了哪些字段的表达式时返回false
+ */
+bool collect_used_fields(Expression *expr, vector<const Field *> &fields)
+{
+  if (expr == nullptr) {
+    return true;
+  }
+  switch (expr->type()) {
+    case ExprType::FIELD: {
+      fields.push_back(&static_cast<FieldExpr *>(expr)->field());
+      return true;
+    }
+    case ExprType::VALUE:
+    case ExprType::VALUES: {
+      return true;
+    }
+    case ExprType::COMPARISON: {
+      auto *comparison_expr = static_cast<ComparisonExpr *>(expr);
+      return collect_used_fields(comparison_expr->left().get(), fields) &&
+             collect_used_fields(comparison_expr->right().get(), fields);
+    }
+    case ExprType::ARITHMETIC: {
+      auto *arithmetic_expr = static_cast<ArithmeticExpr *>(expr);
+      return collect_used_fields(arithmetic_expr->left().get(), fields) &&
+             collect_used_fields(arithmetic_expr->right().get(), fields);
+    }
+    case ExprType::CONJUNCTION: {
+      for (unique_ptr<Expression> &child : static_cast<ConjunctionExpr *>(expr)->children()) {
+        if (!collect_used_fields(child.get(), fields)) {
+          return false;
+        }
+      }
+      return true;
+    }
+    default: {
+      return false;
+    }
+  }
+}
+
+/**
+ * @brief 记录 投影 -> (过滤|排序|limit)* -> 单表扫描 的查询用到了表的哪些字段
+ */
+void mark_used_fields(ProjectLogicalNode &project_oper)
+{
+  vector<const Field *> fields;
+  for (const unique_ptr<Expression> &expr : project_oper.expressions()) {
+    if (!collect_used_fields(expr.get(), fields)) {
+      return;
+    }
+  }
+
+  LogicalNode *node = project_oper.children().empty() ? nullptr : project_oper.children().front().get();
+  while (node != nullptr && node->children().size() == 1) {
+    if (node->type() == LogicalNodeType::PREDICATE) {
+      for (unique_ptr<Expression> &expr : node->expressions()) {
+        if (!collect_used_fields(expr.get(), fields)) {
+          return;
+        }
+      }
+    } else if (node->type() == LogicalNodeType::ORDER) {
+      for (OrderByUnit *order_unit : static_cast<OrderByLogicalNode *>(node)->order_units()) {
+        if (!collect_used_fields(order_unit->expr(), fields)) {
+          return;
+        }
+      }
+    } else if (node->type() != LogicalNodeType::LIMIT) {
+      return;
+    }
+    node = node->children().front().get();
+  }
+  if (node == nullptr || node->type() != LogicalNodeType::TABLE_GET) {
+    return;
+  }
+
+  auto *table_get = static_cast<TableGetLogicalNode *>(node);
+  for (unique_ptr<Expression> &expr : table_get->predicates()) {
+    if (!collect_used_fields(expr.get(), fields)) {
+      return;
+    }
+  }
+
+  vector<std::string> field_names;
+  for (const Field *field : fields) {
+    if (field->table() != table_get->table()) {
+      return;
+    }
+    field_names.emplace_back(field->field_name());
+  }
+  table_get->set_used_fields(std::move(field_names));
+}
 
-      auto *left_expr = compare_expr->left().get();
-      auto *right_expr = compare_expr->right().get();
-      if (left_expr->type() == ExprType::FIELD && right_expr->type() == ExprType::VALUE) {
-        auto field_expr = dynamic_cast<FieldExpr*>(left_expr);
-        auto value_expr = dynamic_cast<ValueExpr*>(right_expr);
-        if (field_expr != nullptr && value_expr != nullptr) {
-          index = table_get_oper.table()->find_index_by_field(field_expr->field_name());
-          if (index != nullptr) {
-            value = &value_expr->get_value();
+/**
+ * @brief 查询用到的字段是否都可以直接从索引项中得到
+ * @details 索引中的 NULL 与普通值无法区分，因此要求字段不允许为 NULL
+ */
+bool covered_by_index(TableGetLogicalNode &table_get_oper, Index *index)
+{
+  if (!table_get_oper.readonly() || !table_get_oper.used_fields_known() || table_get_oper.table()->is_view()) {
+    return false;
+  }
+
+  // 哈希索引的扫描器不返回索引项的键
+  const TableMeta &table_meta = table_get_oper.table()->table_meta();
+  const IndexMeta &index_meta = index->index_meta();
+  if (index_meta.type() != IndexType::BPLUS_TREE) {
+    return false;
+  }
+  for (const std::string &field_name : table_get_oper.used_fields()) {
+    bool found = false;
+    for (size_t i = 0; i < index_meta.user_field_amount() && !found; i++) {
+      found = field_name == index_meta.field(static_cast<int>(i));
+    }
+    const FieldMeta *field_meta = table_meta.field(field_name.c_str());
+    if (!found || field_meta == nullptr || field_meta->nullable()) {
+      return false;
+    }
+    switch (field_meta->type()) {
+      case INTS:
+      case FLOATS:
+      case DATES:
+      case CHARS: break;
+      default: return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+Index *PhysicalOperatorGenerator::select_index(
+    TableGetLogicalNode &table_get_oper, IndexScanRange &range, vector<size_t> &covered_predicates)
+{
+  Table *table = table_get_oper.table();
+  const TableMeta &table_meta = table->table_meta();
+
+  Index *best_index = nullptr;
+  int best_score = 0;
+  vector<size_t> best_predicates;
+  bool best_exact = false;
+  for (int i = 0; i < table_meta.index_num(); i++) {
+    const IndexMeta *index_meta = table_meta.index(i);
+    if (index_meta->type() == IndexType::BLOOM) {
+      continue;
+    }
+    const int field_amount = static_cast<int>(index_meta->user_field_amount());
+
+    IndexScanRange candidate;
+    vector<size_t> used_predicates;
+    int score = 0;
+    bool exact = false;
+    if (index_meta->type() == IndexType::HASH) {
+      // 哈希索引只能查找完整的键，每个字段上都要有等值条件
+      std::string key;
+      std::string desc;
+      bool usable = true;
+      exact = true;
+      for (int j = 0; j < field_amount && usable && !candidate.empty; j++) {
+        const FieldMeta *field_meta = table_meta.field(index_meta->field(j));
+        if (field_meta == nullptr) {
+          usable = false;
+          break;
+        }
+        FieldBounds bounds = collect_field_bounds(table_get_oper, *field_meta);
+        if (bounds.empty) {
+          candidate.empty = true;
+          break;
+        }
+        usable = bounds.is_equal() && append_key_part(bounds.low, *field_meta, key);
+        desc += (j == 0 ? "" : ",") + bounds.low.to_string();
+        used_predicates.insert(used_predicates.end(), bounds.predicates.begin(), bounds.predicates.end());
+        exact = exact && !field_meta->nullable() && (field_meta->type() == INTS || field_meta->type() == DATES);
+      }
+      if (candidate.empty) {
+        candidate.desc = "range=empty";
+        score = INT32_MAX;
+      } else if (usable) {
+        candidate.has_left = candidate.has_right = true;
+        candidate.left_inclusive = candidate.right_inclusive = true;
+        candidate.left_key = key;
+        candidate.right_key = key;
+        candidate.desc = "hash=(" + desc + ")";
+        // 同样字段上的等值查找，哈希索引只需要读取一个桶页面，比B+树更好
+        score = 4 * field_amount + 1;
+      }
+    } else {
+      // 前缀字段上的等值条件，加上紧接着的一个字段上的范围条件，可以确定一段连续的范围。
+      // B+树的键后面还有系统字段，这里只拼接用户字段，打开扫描时再补齐
+      std::string prefix;
+      std::string desc;
+      int eq_num = 0;
+      FieldBounds range_bounds;
+      bool has_range = false;
+      exact = true;
+      for (int j = 0; j < field_amount; j++) {
+        const FieldMeta *field_meta = table_meta.field(index_meta->field(j));
+        if (field_meta == nullptr) {
+          break;
+        }
+        FieldBounds bounds = collect_field_bounds(table_get_oper, *field_meta);
+        if (bounds.empty) {
+          candidate.empty = true;
+          break;
+        }
+        if (bounds.is_equal()) {
+          if (!append_key_part(bounds.low, *field_meta, prefix)) {
             break;
           }
-        }
-      } else if (left_expr->type() == ExprType::VALUE && right_expr->type() == ExprType::FIELD) {
-        auto field_expr = dynamic_cast<FieldExpr*>(right_expr);
-        auto value_expr = dynamic_cast<ValueExpr*>(left_expr);
-        if (field_expr != nullptr && value_expr != nullptr) {
-          index = table_get_oper.table()->find_index_by_field(field_expr->field_name());
-          if (index != nullptr) {
-            value = &value_expr->get_value();
+          desc += (eq_num == 0 ? "" : ",") + bounds.low.to_string();
+          eq_num++;
+        } else {
+          std::string left_key = prefix;
+          std::string right_key = prefix;
+          if ((!bounds.has_low && !bounds.has_high) ||
+              (bounds.has_low && !append_key_part(bounds.low, *field_meta, left_key)) ||
+              (bounds.has_high && !append_key_part(bounds.high, *field_meta, right_key))) {
             break;
           }
+          candidate.left_key = std::move(left_key);
+          candidate.right_key = std::move(right_key);
+          range_bounds = bounds;
+          has_range = true;
+        }
+        used_predicates.insert(used_predicates.end(), bounds.predicates.begin(), bounds.predicates.end());
+        exact = exact && exact_key_field(*field_meta);
+        if (has_range) {
+          break;
         }
       }
+      if (candidate.empty) {
+        candidate.desc = "range=empty";
+        score = INT32_MAX;
+      } else if (has_range) {
+        // 范围字段上没有下界(上界)时，前缀本身就是下界(上界)
+        candidate.has_left = eq_num > 0 || range_bounds.has_low;
+        candidate.left_inclusive = range_bounds.has_low ? range_bounds.low_inclusive : true;
+        candidate.has_right = eq_num > 0 || range_bounds.has_high;
+        candidate.right_inclusive = range_bounds.has_high ? range_bounds.high_inclusive : true;
+        candidate.desc = (eq_num > 0 ? "prefix=(" + desc + "), " : std::string()) + range_desc(range_bounds);
+        score = 4 * eq_num + (range_bounds.has_low ? 1 : 0) + (range_bounds.has_high ? 1 : 0);
+      } else if (eq_num > 0) {
+        candidate.has_left = candidate.has_right = true;
+        candidate.left_inclusive = candidate.right_inclusive = true;
+        candidate.left_key = prefix;
+        candidate.right_key = prefix;
+        candidate.desc = field_amount == 1 ? "eq=" + desc : "prefix=(" + desc + ")";
+        score = 4 * eq_num;
+      }
+    }
+
+    if (score > best_score) {
+      best_index = table->find_index(index_meta->name());
+      best_score = score;
+      best_predicates = std::move(used_predicates);
+      best_exact = exact;
+      range = std::move(candidate);
     }
   }
 
+  if (best_index != nullptr && best_exact && !range.empty) {
+    covered_predicates = std::move(best_predicates);
+  }
+  return best_index;
+}
+
+RC PhysicalOperatorGenerator::create_plan(
+    TableGetLogicalNode &table_get_oper, unique_ptr<PhysicalOperator> &oper, bool is_delete)
+{
+  vector<unique_ptr<Expression>> &predicates = table_get_oper.predicates();
+
+  if (table_get_oper.ordered_index() != nullptr) {
+    // 上层需要按照索引顺序输出，扫描整个索引，所有条件都在扫描时过滤
+    IndexScanPhysicalOperator *index_scan_oper = new IndexScanPhysicalOperator(
+        table_get_oper.table(), table_get_oper.ordered_index(), table_get_oper.readonly(), nullptr, false, nullptr, false);
+    index_scan_oper->isdelete_ = is_delete;
+    index_scan_oper->set_index_only(!is_delete && covered_by_index(table_get_oper, table_get_oper.ordered_index()));
+    index_scan_oper->set_table_alias(table_get_oper.table_alias());
+    index_scan_oper->set_predicates(std::move(predicates));
+    oper = unique_ptr<PhysicalOperator>(index_scan_oper);
+    LOG_TRACE("use ordered index scan");
+    return RC::SUCCESS;
+  }
+
+  IndexScanRange range;
+  vector<size_t> covered_predicates;
+  Index *index = table_get_oper.prefer_table_scan() ? nullptr : select_index(table_get_oper, range, covered_predicates);
+
   if (index == nullptr) {
     Table *table = table_get_oper.table();
     auto table_scan_oper = new TableScanPhysicalOperator(table, table_get_oper.table_alias(), table_get_oper.readonly());
@@ -134,8 +551,15 @@ RC PhysicalOperatorGenerator::create_plan(
     LOG_TRACE("use table scan");
   } else {
     IndexScanPhysicalOperator *index_scan_oper = new IndexScanPhysicalOperator(
-        table_get_oper.table(), index, table_get_oper.readonly(), value, true, value, true);
+        table_get_oper.table(), index, table_get_oper.readonly(), std::move(range));
     index_scan_oper->isdelete_ = is_delete;
+    index_scan_oper->set_index_only(!is_delete && covered_by_index(table_get_oper, index));
+    index_scan_oper->set_table_alias(table_get_oper.table_alias());
+    // 已经由索引范围保证的条件不需要在扫描时再计算一次，其它条件仍然需要在扫描时过滤
+    for (auto iter = covered_predicates.rbegin(); iter != covered_predicates.rend(); ++iter) {
+      predicates.erase(predicates.begin() + *iter);
+    }
+    index_scan_oper->set_predicates(std::move(predicates));
     oper = unique_ptr<PhysicalOperator>(index_scan_oper);
     LOG_TRACE("use index scan");
   }
@@ -178,7 +602,11 @@ RC PhysicalOperatorGenerator::create_plan(AggrLogicalNode &aggr_oper, unique_ptr
   RC rc = RC::SUCCESS;
   if (!child_opers.empty()) {
     LogicalNode *child_oper = child_opers.front().get();
-    rc = create(*child_oper, child_phy_oper);
+    // 全表扫描的聚合尝试在多个线程中并行执行
+    rc = create_parallel_scan(*child_oper, child_phy_oper);
+    if (rc == RC::SUCCESS && child_phy_oper == nullptr) {
+      rc = create(*child_oper, child_phy_oper);
+    }
     if (rc != RC::SUCCESS) {
       LOG_WARN("failed to create project logical operator's child physical operator. rc=%s", strrc(rc));
       return rc;
@@ -232,6 +660,10 @@ RC PhysicalOperatorGenerator::create_plan(
 
   unique_ptr<PhysicalOperator> child_phy_oper;
 
+  if (!is_delete) {
+    mark_used_fields(project_oper);
+  }
+
   RC rc = RC::SUCCESS;
   if (!child_opers.empty()) {
     LogicalNode *child_oper = child_opers.front().get();
@@ -363,28 +795,257 @@ RC PhysicalOperatorGenerator::create_plan(
     return rc;
   }
 
-  // 为右子节点创建物理算子
+  // 为右子节点创建物理算子。索引嵌套循环连接的右边一定是索引扫描，扫描范围在探测时设置
   unique_ptr<PhysicalOperator> right_phy_oper;
-  rc = create(*child_opers[1], right_phy_oper);
+  if (join_oper.method() == JoinMethod::INDEX_NESTED_LOOP) {
+    if (child_opers[1]->type() != LogicalNodeType::TABLE_GET || join_oper.index() == nullptr) {
+      LOG_WARN("index nested loop join requires a table with index as right child");
+      return RC::INTERNAL;
+    }
+    auto &table_get_oper = static_cast<TableGetLogicalNode &>(*child_opers[1]);
+    IndexScanRange range;
+    range.empty = true;
+    auto *index_scan_oper = new IndexScanPhysicalOperator(
+        table_get_oper.table(), join_oper.index(), table_get_oper.readonly(), std::move(range));
+    index_scan_oper->set_index_only(covered_by_index(table_get_oper, join_oper.index()));
+    index_scan_oper->set_table_alias(table_get_oper.table_alias());
+    index_scan_oper->set_predicates(std::move(table_get_oper.predicates()));
+    right_phy_oper = unique_ptr<PhysicalOperator>(index_scan_oper);
+    if (table_get_oper.estimated_rows() >= 0) {
+      right_phy_oper->set_estimate(table_get_oper.estimated_rows(), table_get_oper.estimated_cost());
+    }
+  } else {
+    rc = create(*child_opers[1], right_phy_oper);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to create right physical operator of join. rc=%s", strrc(rc));
+      return rc;
+    }
+  }
+
+  switch (join_oper.method()) {
+    case JoinMethod::HASH: {
+      oper = unique_ptr<PhysicalOperator>(new HashJoinPhysicalOperator(
+          std::move(join_oper.left_keys()), std::move(join_oper.right_keys()), std::move(join_oper.condition())));
+    } break;
+    case JoinMethod::MERGE: {
+      oper = unique_ptr<PhysicalOperator>(new MergeJoinPhysicalOperator(
+          std::move(join_oper.left_keys()), std::move(join_oper.right_keys()), std::move(join_oper.condition())));
+    } break;
+    case JoinMethod::INDEX_NESTED_LOOP: {
+      oper = unique_ptr<PhysicalOperator>(new IndexNestedLoopJoinPhysicalOperator(
+          std::move(join_oper.left_keys()), std::move(join_oper.right_keys()), std::move(join_oper.condition())));
+    } break;
+    default: {
+      // 创建JoinPhysicalOperator，并设置join条件
+      if (join_oper.condition() != nullptr) {
+        oper = unique_ptr<PhysicalOperator>(new JoinPhysicalOperator(std::move(join_oper.condition())));
+      } else {
+        oper = unique_ptr<PhysicalOperator>(new JoinPhysicalOperator());
+      }
+    } break;
+  }
+
+  // 添加左右子算子
+  oper->add_child(std::move(left_phy_oper));
+  oper->add_child(std::move(right_phy_oper));
+
+  LOG_TRACE("create a join physical operator. type=%s", oper->name().c_str());
+  return RC::SUCCESS;
+}
+
+TableGetLogicalNode *PhysicalOperatorGenerator::find_ordered_index_scan(OrderByLogicalNode &order_oper, Index *&index)
+{
+  index = nullptr;
+  vector<OrderByUnit *> order_units = order_oper.order_units();
+  if (order_units.size() != 1 || !order_units.front()->sort_type() ||
+      order_units.front()->expr()->type() != ExprType::FIELD) {
+    return nullptr;
+  }
+  auto *order_field = static_cast<FieldExpr *>(order_units.front()->expr());
+
+  // 中间只允许有过滤算子，它们不会改变数据的顺序
+  LogicalNode *node = order_oper.children().empty() ? nullptr : order_oper.children().front().get();
+  while (node != nullptr && node->type() == LogicalNodeType::PREDICATE) {
+    node = node->children().empty() ? nullptr : node->children().front().get();
+  }
+  if (node == nullptr || node->type() != LogicalNodeType::TABLE_GET) {
+    return nullptr;
+  }
+
+  auto *table_get = static_cast<TableGetLogicalNode *>(node);
+  const Field &field = order_field->field();
+  if (field.table() != table_get->table()) {
+    return nullptr;
+  }
+
+  switch (field.attr_type()) {
+    case INTS:
+    case FLOATS:
+    case DATES:
+    case CHARS: break;
+    default: return nullptr;
+  }
+
+  Index *field_index = table_get->table()->find_index_by_field(field.field_name());
+  if (field_index == nullptr) {
+    return nullptr;
+  }
+
+  bool null_rejected = !field.meta()->nullable();
+  for (unique_ptr<Expression> &predicate : table_get->predicates()) {
+    if (null_rejected) {
+      break;
+    }
+    if (predicate->type() != ExprType::COMPARISON) {
+      continue;
+    }
+    auto *compare_expr = static_cast<ComparisonExpr *>(predicate.get());
+    if (compare_expr->comp() > GREAT_THAN) {
+      continue;
+    }
+    Expression *left = compare_expr->left().get();
+    Expression *right = compare_expr->right().get();
+    Expression *field_side = left->type() == ExprType::FIELD ? left : right;
+    Expression *value_side = left->type() == ExprType::FIELD ? right : left;
+    if (field_side->type() != ExprType::FIELD || value_side->type() != ExprType::VALUE) {
+      continue;
+    }
+    if (0 == strcmp(static_cast<FieldExpr *>(field_side)->field_name(), field.field_name())) {
+      null_rejected = true;
+    }
+  }
+  if (!null_rejected) {
+    return nullptr;
+  }
+
+  index = field_index;
+  return table_get;
+}
+
+RC PhysicalOperatorGenerator::create_plan(LimitLogicalNode &limit_oper, unique_ptr<PhysicalOperator> &oper)
+{
+  vector<unique_ptr<LogicalNode>> &child_opers = limit_oper.children();
+  ASSERT(child_opers.size() == 1, "limit logical operator's sub oper number should be 1");
+  LogicalNode &child_oper = *child_opers.front();
+
+  RC rc = RC::SUCCESS;
+  unique_ptr<PhysicalOperator> child_phy_oper;
+  if (child_oper.type() == LogicalNodeType::ORDER) {
+    auto &order_oper = static_cast<OrderByLogicalNode &>(child_oper);
+    Index *index = nullptr;
+    TableGetLogicalNode *table_get = find_ordered_index_scan(order_oper, index);
+    if (table_get != nullptr) {
+      // 索引已经有序，不需要再排序，limit 输出足够的行后就停止扫描
+      table_get->set_ordered_index(index);
+      rc = create(*order_oper.children().front(), child_phy_oper);
+      if (rc != RC::SUCCESS) {
+        LOG_WARN("failed to create child operator of limit operator. rc=%s", strrc(rc));
+        return rc;
+      }
+      oper = unique_ptr<PhysicalOperator>(new LimitPhysicalOperator(limit_oper.limit(), limit_oper.offset()));
+      oper->add_child(std::move(child_phy_oper));
+      return rc;
+    }
+
+    rc = create(*order_oper.children().front(), child_phy_oper);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to create child operator of limit operator. rc=%s", strrc(rc));
+      return rc;
+    }
+    oper = unique_ptr<PhysicalOperator>(
+        new TopNPhysicalOperator(order_oper.order_units(), limit_oper.limit(), limit_oper.offset()));
+    oper->add_child(std::move(child_phy_oper));
+    return rc;
+  }
+
+  rc = create(child_oper, child_phy_oper);
   if (rc != RC::SUCCESS) {
-    LOG_WARN("failed to create right physical operator of join. rc=%s", strrc(rc));
+    LOG_WARN("failed to create child operator of limit operator. rc=%s", strrc(rc));
     return rc;
   }
+  oper = unique_ptr<PhysicalOperator>(new LimitPhysicalOperator(limit_oper.limit(), limit_oper.offset()));
+  oper->add_child(std::move(child_phy_oper));
+  return rc;
+}
 
-  // 创建JoinPhysicalOperator，并设置join条件
-  JoinPhysicalOperator *join_physical_oper;
-  if (join_oper.condition() != nullptr) {
-    join_physical_oper = new JoinPhysicalOperator(std::move(join_oper.condition()));
-  } else {
-    join_physical_oper = new JoinPhysicalOperator();
+RC PhysicalOperatorGenerator::create_parallel_scan(LogicalNode &logical_oper, unique_ptr<PhysicalOperator> &oper)
+{
+  WorkerPool *worker_pool = GCTX.worker_pool_;
+  if (worker_pool == nullptr || worker_pool->thread_num() <= 1) {
+    return RC::SUCCESS;
   }
-  
-  // 添加左右子算子
-  join_physical_oper->add_child(std::move(left_phy_oper));
-  join_physical_oper->add_child(std::move(right_phy_oper));
-  
-  oper = unique_ptr<PhysicalOperator>(join_physical_oper);
-  
-  LOG_TRACE("create a join physical operator");
+
+  // 只处理 过滤* + 全表扫描 的流水线
+  vector<PredicateLogicalNode *> predicate_opers;
+  LogicalNode *node = &logical_oper;
+  while (node->type() == LogicalNodeType::PREDICATE && node->children().size() == 1) {
+    predicate_opers.push_back(static_cast<PredicateLogicalNode *>(node));
+    node = node->children().front().get();
+  }
+  if (node->type() != LogicalNodeType::TABLE_GET) {
+    return RC::SUCCESS;
+  }
+
+  auto &table_get_oper = static_cast<TableGetLogicalNode &>(*node);
+  Table *table = table_get_oper.table();
+  IndexScanRange range;
+  vector<size_t> covered_predicates;
+  if (table->is_view() || table->is_system() ||
+      (!table_get_oper.prefer_table_scan() && select_index(table_get_oper, range, covered_predicates) != nullptr)) {
+    return RC::SUCCESS;
+  }
+
+  // 每条流水线都需要一份自己的表达式
+  for (unique_ptr<Expression> &predicate : table_get_oper.predicates()) {
+    unique_ptr<Expression> copied(predicate->copy());
+    if (copied == nullptr) {
+      return RC::SUCCESS;
+    }
+  }
+  for (PredicateLogicalNode *predicate_oper : predicate_opers) {
+    if (predicate_oper->expressions().size() != 1) {
+      return RC::SUCCESS;
+    }
+    unique_ptr<Expression> copied(predicate_oper->expressions().front()->copy());
+    if (copied == nullptr) {
+      return RC::SUCCESS;
+    }
+  }
+
+  // 数据太少时并行执行得不偿失
+  vector<pair<PageNum, PageNum>> morsels;
+  RC rc = table->split_pages(MORSEL_PAGE_NUM, morsels);
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+  if (morsels.size() < 2) {
+    return RC::SUCCESS;
+  }
+
+  const int dop = std::min(worker_pool->thread_num(), static_cast<int>(morsels.size()));
+  auto morsel_queue = std::make_shared<MorselQueue>();
+  auto *exchange_oper = new ExchangePhysicalOperator(table, morsel_queue);
+  oper = unique_ptr<PhysicalOperator>(exchange_oper);
+
+  for (int i = 0; i < dop; i++) {
+    vector<unique_ptr<Expression>> predicates;
+    for (unique_ptr<Expression> &predicate : table_get_oper.predicates()) {
+      predicates.emplace_back(predicate->copy());
+    }
+    auto *table_scan_oper = new TableScanPhysicalOperator(table, table_get_oper.table_alias(), table_get_oper.readonly());
+    table_scan_oper->set_predicates(std::move(predicates));
+    table_scan_oper->set_morsel_queue(morsel_queue);
+
+    unique_ptr<PhysicalOperator> pipeline(table_scan_oper);
+    for (auto iter = predicate_opers.rbegin(); iter != predicate_opers.rend(); ++iter) {
+      unique_ptr<Expression> expression((*iter)->expressions().front()->copy());
+      unique_ptr<PhysicalOperator> predicate_oper(new PredicatePhysicalOperator(std::move(expression)));
+      predicate_oper->add_child(std::move(pipeline));
+      pipeline = std::move(predicate_oper);
+    }
+    exchange_oper->add_pipeline(std::move(pipeline));
+  }
+
+  LOG_TRACE("use parallel table scan. dop=%d, morsels=%d", dop, static_cast<int>(morsels.size()));
   return RC::SUCCESS;
-}
\ No newline at end of file
+}
@@ -3,11 +3,16 @@
 #include "include/storage_engine/recorder/record.h"
 #include "include/query_engine/structor/expression/conjunction_expression.h"
 #include "include/query_engine/structor/expression/comparison_expression.h"
+#include "include/query_engine/structor/expression/value_expression.h"
 #include "include/query_engine/structor/tuple/join_tuple.h"
 
 PredicatePhysicalOperator::PredicatePhysicalOperator(std::unique_ptr<Expression> expr) : expression_(std::move(expr))
 {
   ASSERT(expression_->value_type() == BOOLEANS, "predicate's expression should be BOOLEAN type");
+  if (expression_->type() == ExprType::VALUE) {
+    is_constant_ = true;
+    constant_value_ = static_cast<ValueExpr *>(expression_.get())->get_value().get_boolean();
+  }
 }
 
 RC PredicatePhysicalOperator::open(Trx *trx)
@@ -36,8 +41,12 @@ RC PredicatePhysicalOperator::next()
 {
   RC rc;
   PhysicalOperator *oper = children_.front().get();
+  if (is_constant_) {
+    // 常量条件不需要逐行计算，恒为假时不需要读取下层的数据
+    return constant_value_ ? oper->next_row() : RC::RECORD_EOF;
+  }
 
-  while (RC::SUCCESS == (rc = oper->next())) {
+  while (RC::SUCCESS == (rc = oper->next_row())) {
     Tuple *tuple = oper->current_tuple();
     if (nullptr == tuple) {
       rc = RC::INTERNAL;
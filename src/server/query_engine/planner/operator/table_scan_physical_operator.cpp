@@ -1,11 +1,49 @@
 #include "include/query_engine/planner/operator/table_scan_physical_operator.h"
 #include "include/storage_engine/recorder/table.h"
+#include "include/query_engine/planner/operator/exchange_physical_operator.h"
+#include "include/storage_engine/index/bloom_filter_index.h"
 
 using namespace std;
 
 RC TableScanPhysicalOperator::open(Trx *trx)
 {
-  RC rc = table_->get_record_scanner(record_scanner_, trx, readonly_);
+  ExpressionCompiler compiler(table_, table_alias_);
+  kernels_.clear();
+  always_false_ = false;
+  zone_predicate_ = ZonePredicate();
+  for (const unique_ptr<Expression> &expr : predicates_) {
+    kernels_.push_back(compiler.compile(expr.get()));
+    bool value = true;
+    if (kernels_.back()->constant(value) && !value) {
+      always_false_ = true;
+    }
+
+    ZonePredicate predicate;
+    if (compiler.compile_zone_predicate(expr.get(), predicate)) {
+      zone_predicate_.children.push_back(std::move(predicate));
+    }
+  }
+
+  collect_bloom_probes();
+
+  // 扫描打开时就会读取第一个页面，所以要先设置页面过滤
+  if (zone_predicate_.children.empty() && bloom_probes_.empty()) {
+    record_scanner_.set_page_filter(nullptr);
+  } else {
+    record_scanner_.set_page_filter([this](PageNum page_num) { return may_match_page(page_num); });
+  }
+
+  RC rc = RC::SUCCESS;
+  if (table_->is_system()) {
+    // 系统表在打开时生成全部记录
+    system_pos_ = 0;
+    rc = table_->load_system_records(system_records_);
+  } else if (morsel_queue_ != nullptr) {
+    // 在 next 中按需打开每一段页面的扫描
+    rc = record_scanner_.close_scan();
+  } else {
+    rc = table_->get_record_scanner(record_scanner_, trx, readonly_);
+  }
   if (rc == RC::SUCCESS) {
     tuple_.set_schema(table_, table_alias_, table_->table_meta().field_metas());
   }
@@ -13,19 +51,83 @@ RC TableScanPhysicalOperator::open(Trx *trx)
   return rc;
 }
 
-RC TableScanPhysicalOperator::next()
+void TableScanPhysicalOperator::collect_bloom_probes()
+{
+  bloom_probes_.clear();
+  const TableMeta &table_meta = table_->table_meta();
+  for (int i = 0; i < table_meta.index_num(); i++) {
+    const IndexMeta *index_meta = table_meta.index(i);
+    if (index_meta->type() != IndexType::BLOOM) {
+      continue;
+    }
+    auto *index = static_cast<const BloomFilterIndex *>(table_->find_index(index_meta->name()));
+    if (index == nullptr) {
+      continue;
+    }
+
+    std::vector<uint64_t> hashes;
+    if (!zone_predicate_.children.empty() && index->probe_hashes(zone_predicate_, hashes)) {
+      bloom_probes_.emplace_back(index, std::move(hashes));
+    } else if (runtime_filter_ != nullptr && !runtime_filter_->hashes.empty() &&
+               runtime_filter_->key.field_indexes() == index->key().field_indexes()) {
+      bloom_probes_.emplace_back(index, runtime_filter_->hashes);
+    }
+  }
+}
+
+bool TableScanPhysicalOperator::may_match_page(PageNum page_num) const
+{
+  if (!zone_predicate_.children.empty() && !table_->zone_map().may_match(page_num, zone_predicate_)) {
+    return false;
+  }
+  for (const auto &probe : bloom_probes_) {
+    if (!probe.first->may_contain_any(page_num, probe.second)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+RC TableScanPhysicalOperator::open_next_morsel()
 {
-  if (!record_scanner_.has_next()) {
+  PageNum begin_page = 0;
+  PageNum end_page = 0;
+  if (morsel_queue_ == nullptr || !morsel_queue_->pop(begin_page, end_page)) {
     return RC::RECORD_EOF;
   }
+  return table_->get_record_scanner(record_scanner_, trx_, readonly_, begin_page, end_page);
+}
 
+RC TableScanPhysicalOperator::next()
+{
   RC rc = RC::SUCCESS;
   bool filter_result = false;
-  while (record_scanner_.has_next()) {
-    rc = record_scanner_.next(current_record_);
-    if (rc != RC::SUCCESS) {
-      return rc;
+  if (always_false_) {
+    return RC::RECORD_EOF;
+  }
+  while (true) {
+    if (table_->is_system()) {
+      if (system_pos_ >= system_records_.size()) {
+        return RC::RECORD_EOF;
+      }
+      Record &record = system_records_[system_pos_++];
+      current_record_.set_rid(record.rid());
+      current_record_.set_data(record.data(), record.len());
+    } else {
+      if (!record_scanner_.has_next()) {
+        rc = open_next_morsel();
+        if (rc != RC::SUCCESS) {
+          return rc;
+        }
+        continue;
+      }
+
+      rc = record_scanner_.next(current_record_);
+      if (rc != RC::SUCCESS) {
+        return rc;
+      }
     }
+    rows_scanned_++;
 
     tuple_._set_record(&current_record_);
     rc = filter(tuple_, filter_result);
@@ -34,16 +136,17 @@ RC TableScanPhysicalOperator::next()
     }
 
     if (filter_result) {
-      break;
-    } else {
-      rc = RC::RECORD_EOF;
+      return rc;
     }
   }
-  return rc;
 }
 
 RC TableScanPhysicalOperator::close()
 {
+  if (record_scanner_.skipped_pages() > 0) {
+    LOG_TRACE("table scan skipped pages. table=%s, pages=%d", table_->name(), record_scanner_.skipped_pages());
+  }
+  system_records_.clear();
   return record_scanner_.close_scan();
 }
 
@@ -70,16 +173,18 @@ void TableScanPhysicalOperator::set_predicates(vector<unique_ptr<Expression>> &&
 RC TableScanPhysicalOperator::filter(RowTuple &tuple, bool &result)
 {
   RC rc = RC::SUCCESS;
-  Value value;
-  for (unique_ptr<Expression> &expr : predicates_) {
-    rc = expr->get_value(tuple, value);
-    if (rc != RC::SUCCESS) {
+  if (runtime_filter_ != nullptr) {
+    uint64_t hash = 0;
+    const RuntimeFilter &runtime_filter = *runtime_filter_;
+    if (!runtime_filter.key.hash_record(tuple.record().data(), hash) || !runtime_filter.filter.may_contain(hash)) {
+      result = false;
       return rc;
     }
+  }
 
-    bool tmp_result = value.get_boolean();
-    if (!tmp_result) {
-      result = false;
+  for (const unique_ptr<ExprKernel> &kernel : kernels_) {
+    rc = kernel->evaluate(tuple, result);
+    if (rc != RC::SUCCESS || !result) {
       return rc;
     }
   }
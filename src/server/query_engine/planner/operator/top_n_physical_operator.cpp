@@ -0,0 +1,127 @@
+#include <algorithm>
+
+#include "common/log/log.h"
+#include "include/query_engine/planner/operator/top_n_physical_operator.h"
+
+namespace {
+struct HeapEntryLess
+{
+  template <typename T>
+  bool operator()(const T &left, const T &right) const
+  {
+    int cmp = left.key.compare(right.key);
+    return cmp < 0 || (cmp == 0 && left.seq < right.seq);
+  }
+};
+}  // namespace
+
+TopNPhysicalOperator::TopNPhysicalOperator(std::vector<OrderByUnit *> order_units, int limit, int offset)
+    : order_units_(std::move(order_units)), limit_(limit), offset_(offset)
+{}
+
+std::string TopNPhysicalOperator::param() const
+{
+  return "limit=" + std::to_string(limit_) + ", offset=" + std::to_string(offset_);
+}
+
+RC TopNPhysicalOperator::open(Trx *trx)
+{
+  if (children_.size() != 1) {
+    LOG_WARN("top n operator must has one child");
+    return RC::INTERNAL;
+  }
+
+  is_init_ = true;
+  heap_.clear();
+  output_pos_ = 0;
+  return children_[0]->open(trx);
+}
+
+RC TopNPhysicalOperator::fill_heap()
+{
+  const size_t capacity = static_cast<size_t>(limit_) + static_cast<size_t>(offset_);
+  if (limit_ == 0) {
+    return RC::SUCCESS;
+  }
+
+  HeapEntryLess less;
+  size_t seq = 0;
+  RC rc = RC::SUCCESS;
+  while (RC::SUCCESS == (rc = children_[0]->next_row())) {
+    Tuple *tuple = children_[0]->current_tuple();
+
+    sort_key_.clear();
+    for (const OrderByUnit *unit : order_units_) {
+      Value value;
+      rc = unit->expr()->get_value(*tuple, value);
+      if (rc != RC::SUCCESS) {
+        LOG_WARN("failed to get sort key value. rc=%s", strrc(rc));
+        return rc;
+      }
+      SortKeyEncoder::append(value, unit->sort_type(), sort_key_);
+    }
+
+    if (heap_.size() < capacity) {
+      HeapEntry &entry = heap_.emplace_back();
+      entry.key = sort_key_;
+      entry.seq = seq++;
+      codec_.encode(*tuple, entry.payload);
+      std::push_heap(heap_.begin(), heap_.end(), less);
+      continue;
+    }
+
+    // 后到的行序号更大，排序键相同也排在堆顶之后
+    if (sort_key_.compare(heap_.front().key) >= 0) {
+      seq++;
+      continue;
+    }
+
+    // 复用堆顶的内存
+    std::pop_heap(heap_.begin(), heap_.end(), less);
+    HeapEntry &entry = heap_.back();
+    entry.key.swap(sort_key_);
+    entry.seq = seq++;
+    codec_.encode(*tuple, entry.payload);
+    std::push_heap(heap_.begin(), heap_.end(), less);
+  }
+
+  if (RC::RECORD_EOF != rc) {
+    LOG_WARN("failed to fetch tuple in top n operator. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  std::sort_heap(heap_.begin(), heap_.end(), less);
+  output_pos_ = static_cast<size_t>(offset_);
+  return RC::SUCCESS;
+}
+
+RC TopNPhysicalOperator::next()
+{
+  if (is_init_) {
+    is_init_ = false;
+    RC rc = fill_heap();
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+  }
+
+  if (output_pos_ >= heap_.size()) {
+    return RC::RECORD_EOF;
+  }
+
+  HeapEntry &entry = heap_[output_pos_++];
+  codec_.decode(entry.payload.data(), static_cast<int>(entry.payload.size()), *children_[0]->current_tuple());
+  return RC::SUCCESS;
+}
+
+RC TopNPhysicalOperator::close()
+{
+  heap_.clear();
+  children_[0]->close();
+  return RC::SUCCESS;
+}
+
+Tuple *TopNPhysicalOperator::current_tuple()
+{
+  return children_[0]->current_tuple();
+}
@@ -108,7 +108,7 @@ RC UpdatePhysicalOperator::next()
   }
 
   PhysicalOperator *child = children_[0].get();
-  while (RC::SUCCESS == (rc = child->next())) {
+  while (RC::SUCCESS == (rc = child->next_row())) {
     Tuple *tuple = child->current_tuple();
     if (nullptr == tuple) {
       LOG_WARN("failed to get current record: %s", strrc(rc));
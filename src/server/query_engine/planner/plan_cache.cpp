@@ -0,0 +1,201 @@
+#include "include/query_engine/planner/plan_cache.h"
+
+#include "common/log/log.h"
+#include "include/query_engine/analyzer/statement/stmt.h"
+#include "include/query_engine/planner/node/join_logical_node.h"
+#include "include/query_engine/planner/node/logical_node.h"
+#include "include/query_engine/planner/node/table_get_logical_node.h"
+#include "include/query_engine/planner/node/update_logical_node.h"
+#include "include/query_engine/structor/expression/arithmetic_expression.h"
+#include "include/query_engine/structor/expression/comparison_expression.h"
+#include "include/query_engine/structor/expression/conjunction_expression.h"
+#include "include/query_engine/structor/expression/param_expression.h"
+#include "include/query_engine/structor/expression/value_expression.h"
+
+namespace {
+
+RC bind_params(std::unique_ptr<Expression> &expr, const std::vector<Value> &params)
+{
+  if (expr == nullptr) {
+    return RC::SUCCESS;
+  }
+
+  RC rc = RC::SUCCESS;
+  switch (expr->type()) {
+    case ExprType::PARAM: {
+      const int index = static_cast<ParamExpr *>(expr.get())->index();
+      if (index < 0 || index >= static_cast<int>(params.size())) {
+        LOG_WARN("parameter %d is not bound. param count=%d", index, static_cast<int>(params.size()));
+        return RC::INVALID_ARGUMENT;
+      }
+      auto *value_expr = new ValueExpr(params[index]);
+      value_expr->set_name(expr->name());
+      value_expr->set_alias(expr->alias());
+      expr.reset(value_expr);
+    } break;
+
+    case ExprType::COMPARISON: {
+      auto *comparison_expr = static_cast<ComparisonExpr *>(expr.get());
+      rc = bind_params(comparison_expr->left(), params);
+      if (rc == RC::SUCCESS) {
+        rc = bind_params(comparison_expr->right(), params);
+      }
+    } break;
+
+    case ExprType::ARITHMETIC: {
+      auto *arithmetic_expr = static_cast<ArithmeticExpr *>(expr.get());
+      rc = bind_params(arithmetic_expr->left(), params);
+      if (rc == RC::SUCCESS) {
+        rc = bind_params(arithmetic_expr->right(), params);
+      }
+    } break;
+
+    case ExprType::CONJUNCTION: {
+      for (std::unique_ptr<Expression> &child : static_cast<ConjunctionExpr *>(expr.get())->children()) {
+        rc = bind_params(child, params);
+        if (rc != RC::SUCCESS) {
+          break;
+        }
+      }
+    } break;
+
+    default: {
+    } break;
+  }
+  return rc;
+}
+
+RC bind_params(std::vector<std::unique_ptr<Expression>> &exprs, const std::vector<Value> &params)
+{
+  for (std::unique_ptr<Expression> &expr : exprs) {
+    RC rc = bind_params(expr, params);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+  }
+  return RC::SUCCESS;
+}
+
+RC bind_params(LogicalNode &node, const std::vector<Value> &params)
+{
+  RC rc = bind_params(node.expressions(), params);
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+
+  switch (node.type()) {
+    case LogicalNodeType::TABLE_GET: {
+      rc = bind_params(static_cast<TableGetLogicalNode &>(node).predicates(), params);
+    } break;
+
+    case LogicalNodeType::JOIN: {
+      auto &join_node = static_cast<JoinLogicalNode &>(node);
+      rc = bind_params(join_node.condition(), params);
+      if (rc == RC::SUCCESS) {
+        rc = bind_params(join_node.left_keys(), params);
+      }
+      if (rc == RC::SUCCESS) {
+        rc = bind_params(join_node.right_keys(), params);
+      }
+    } break;
+
+    case LogicalNodeType::UPDATE: {
+      for (UpdateUnit &unit : static_cast<UpdateLogicalNode &>(node).update_units()) {
+        std::unique_ptr<Expression> value(unit.value);
+        rc = bind_params(value, params);
+        unit.value = value.release();
+        if (rc != RC::SUCCESS) {
+          break;
+        }
+      }
+    } break;
+
+    default: {
+    } break;
+  }
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+
+  for (std::unique_ptr<LogicalNode> &child : node.children()) {
+    rc = bind_params(*child, params);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+  }
+  return RC::SUCCESS;
+}
+
+}  // namespace
+
+CachedPlan::CachedPlan() = default;
+CachedPlan::~CachedPlan() = default;
+
+RC CachedPlan::instantiate(const std::vector<Value> &params, std::unique_ptr<LogicalNode> &logical_plan) const
+{
+  if (!usable()) {
+    return RC::INTERNAL;
+  }
+  if (static_cast<int>(params.size()) != param_count) {
+    LOG_WARN("parameter count mismatch. expect=%d, actual=%d", param_count, static_cast<int>(params.size()));
+    return RC::INVALID_ARGUMENT;
+  }
+
+  logical_plan = this->logical_plan->clone();
+  return bind_params(*logical_plan, params);
+}
+
+std::shared_ptr<const CachedPlan> PlanCache::get(const std::string &key, uint64_t schema_version)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = entries_.find(key);
+  if (iter == entries_.end()) {
+    return nullptr;
+  }
+
+  PlanList::iterator plan_iter = iter->second;
+  if ((*plan_iter)->schema_version != schema_version) {
+    plans_.erase(plan_iter);
+    entries_.erase(iter);
+    return nullptr;
+  }
+
+  plans_.splice(plans_.begin(), plans_, plan_iter);
+  return *plan_iter;
+}
+
+void PlanCache::put(std::shared_ptr<const CachedPlan> plan)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = entries_.find(plan->key);
+  if (iter != entries_.end()) {
+    plans_.erase(iter->second);
+    entries_.erase(iter);
+  }
+
+  plans_.emplace_front(std::move(plan));
+  entries_.emplace(plans_.front()->key, plans_.begin());
+  while (plans_.size() > capacity_) {
+    entries_.erase(plans_.back()->key);
+    plans_.pop_back();
+  }
+}
+
+void PlanCache::clear()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+  plans_.clear();
+}
+
+size_t PlanCache::size() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return plans_.size();
+}
+
+PlanCache &PlanCache::global_instance()
+{
+  static PlanCache instance(GLOBAL_PLAN_CACHE_CAPACITY);
+  return instance;
+}
@@ -3,7 +3,11 @@
 
 RC Planner::plan_logical_tree(QueryInfo *query_info, std::unique_ptr<LogicalNode> &logical_operator)
 {
-  Stmt *stmt = query_info->stmt();
+  return plan_logical_tree(query_info->stmt(), logical_operator);
+}
+
+RC Planner::plan_logical_tree(Stmt *stmt, std::unique_ptr<LogicalNode> &logical_operator)
+{
   if(stmt == nullptr){
     return RC::UNIMPLENMENT;
   }
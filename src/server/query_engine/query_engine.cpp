@@ -4,84 +4,290 @@
 #include "include/query_engine/parser/parser.h"
 #include "include/query_engine/analyzer/analyzer.h"
 #include "include/session/communicator.h"
+#include "include/query_engine/analyzer/statement/prepare_stmt.h"
+#include "include/query_engine/parser/sql_normalizer.h"
+#include "include/query_engine/planner/plan_cache.h"
+#include "include/query_engine/slow_query_log.h"
+#include "include/storage_engine/schema/database.h"
+#include "include/storage_engine/transaction/trx.h"
 
 #include <chrono>
 #include <memory>
 
 // 处理从session传来的请求, 包含sql执行与结果写回
+// 一个请求只回复一个以分隔符结尾的消息，客户端可以连续发送多个请求，再按顺序读取结果
 bool QueryEngine::process_session_request(SessionRequest *request) {
-  RC rc;
-  char *time_str = new char[64];
-  bool need_disconnect = true;
-
-  std::string sql = request->query();
+  const std::string &sql = request->query();
   if (common::is_blank(sql.c_str())) {
     return true;
   }
 
+  RequestProgress &progress = request->progress();
+  Parser::split(sql, progress.statements);
+  if (progress.statements.size() > 1) {
+    begin_batch(request);
+  }
+  return run_request(request);
+}
+
+bool QueryEngine::resume_session_request(SessionRequest *request)
+{
+  return run_request(request);
+}
+
+void QueryEngine::cancel_session_request(SessionRequest *request)
+{
+  RequestProgress &progress = request->progress();
+  if (progress.paused == nullptr) {
+    return;
+  }
+
   Session::set_current_session(request->session());
-  request->session()->set_current_request(request);
+  SqlResult *sql_result = progress.paused->sql_result();
+  if (sql_result->has_operator()) {
+    sql_result->close();
+  }
+  progress.paused = nullptr;
+  progress.query_info.reset();
+  progress.rc = RC::IOERR_WRITE;
+  Session::set_current_session(nullptr);
+  end_batch(request);
+}
 
-  QueryInfo query_info(request, sql);
+bool QueryEngine::run_request(SessionRequest *request)
+{
+  RequestProgress &progress = request->progress();
+  const bool   batch         = progress.statements.size() > 1;
+  const size_t statement_num = batch ? progress.statements.size() : 1;
 
-  auto start_time = std::chrono::high_resolution_clock::now();
-  rc = planQuery(&query_info);
-  if(RC_FAIL(rc) && rc != RC::UNIMPLENMENT){
-    request->get_communicator()->write_state(request->sql_result(), need_disconnect);
-    request->get_communicator()->flush();
-    return need_disconnect;
-  }else{
-    //执行引擎入口
-    executor_.execute(request, &query_info, need_disconnect);
+  while (progress.paused != nullptr || progress.next_statement < statement_num) {
+    SessionRequest *statement_request = progress.paused;
+    if (statement_request == nullptr) {
+      statement_request = request;
+      if (batch) {
+        progress.statement_request = std::make_unique<SessionRequest>(request->get_communicator());
+        progress.statement_request->set_query(progress.statements[progress.next_statement]);
+        statement_request = progress.statement_request.get();
+      }
+      progress.next_statement++;
+    }
+
+    progress.rc = execute_statement(statement_request, progress);
+    if (progress.rc == RC::SEND_PAUSED) {
+      return false;
+    }
+    if (RC_FAIL(progress.rc) || progress.need_disconnect) {
+      LOG_TRACE("stop executing the request at statement %s. rc=%s",
+          statement_request->query().c_str(), strrc(progress.rc));
+      break;
+    }
+  }
+  progress.statement_request.reset();
+
+  if (batch) {
+    end_batch(request);
   }
-  auto end_time = std::chrono::high_resolution_clock::now();
-  auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time);
-  snprintf(time_str, 64, "Cost time: %lld ns\n", duration.count());
-  
-  request->get_communicator()->write_result(time_str, strlen(time_str));
   request->get_communicator()->send_message_delimiter();
   request->get_communicator()->flush();
-  request->session()->set_current_request(nullptr);
+  return progress.need_disconnect;
+}
+
+RC QueryEngine::execute_statement(SessionRequest *request, RequestProgress &progress)
+{
+  Session::set_current_session(request->session());
+  request->session()->set_current_request(request);
+
+  RC rc = RC::SUCCESS;
+  if (progress.paused == nullptr) {
+    progress.start_time = std::chrono::high_resolution_clock::now();
+    progress.query_info = std::make_unique<QueryInfo>(request, request->query());
+    QueryStats::set_current(&progress.query_info->stats());
+    rc = planQuery(progress.query_info.get());
+    if (RC_FAIL(rc) && rc != RC::UNIMPLENMENT) {
+      request->get_communicator()->write_state(request->sql_result(), progress.need_disconnect);
+      finish_statement(request, progress, rc);
+      QueryStats::set_current(nullptr);
+      request->session()->set_current_request(nullptr);
+      Session::set_current_session(nullptr);
+      return rc;
+    }
+  } else {
+    QueryStats::set_current(&progress.query_info->stats());
+  }
+
+  // 执行的时间不包括写结果的时间，写结果的时间由发送缓冲统计在 SEND 中
+  QueryStats &stats = progress.query_info->stats();
+  const int64_t send_ns = stats.phase_time(QueryPhase::SEND);
+  const auto execute_begin = std::chrono::steady_clock::now();
+  if (progress.paused == nullptr) {
+    //执行引擎入口
+    rc = executor_.execute(request, progress.query_info.get(), progress.need_disconnect);
+  } else {
+    // 继续发送暂停的语句的结果
+    rc = executor_.resume(request, progress.need_disconnect);
+  }
+  const auto execute_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - execute_begin).count();
+  stats.add_phase_time(QueryPhase::EXECUTE, execute_ns - (stats.phase_time(QueryPhase::SEND) - send_ns));
+
+  if (rc == RC::SEND_PAUSED) {
+    progress.paused = request;
+  } else {
+    progress.paused = nullptr;
+    if (RC_SUCC(rc)) {
+      rc = request->sql_result()->return_code();
+    }
 
+    const int64_t duration = finish_statement(request, progress, rc);
+    char time_str[64];
+    snprintf(time_str, sizeof(time_str), "Cost time: %lld ns\n", static_cast<long long>(duration));
+    request->get_communicator()->write_result(time_str, strlen(time_str));
+  }
+
+  QueryStats::set_current(nullptr);
+  request->session()->set_current_request(nullptr);
   Session::set_current_session(nullptr);
-  delete[] time_str;
-  return need_disconnect;
+  return rc;
+}
+
+int64_t QueryEngine::finish_statement(SessionRequest *request, RequestProgress &progress, RC rc)
+{
+  auto end_time = std::chrono::high_resolution_clock::now();
+  const int64_t duration =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - progress.start_time).count();
+
+  QueryStats &stats = progress.query_info->stats();
+  stats.total_ns = duration;
+  Db *db = request->session()->get_current_db();
+  SlowQueryLog::instance().record(db == nullptr ? nullptr : db->name(), request->query(), rc, stats);
+
+  progress.query_info.reset();
+  return duration;
+}
+
+void QueryEngine::begin_batch(SessionRequest *request)
+{
+  Session *session = request->session();
+
+  // 已经在显式事务中时，这些语句就是那个事务的一部分；否则放在同一个事务中，全部成功才提交
+  RequestProgress &progress = request->progress();
+  progress.own_trx = !session->is_trx_multi_operation_mode();
+  if (progress.own_trx) {
+    Session::set_current_session(session);
+    session->set_trx_multi_operation_mode(true);
+    session->current_trx()->start_if_need();
+    Session::set_current_session(nullptr);
+  }
+}
+
+void QueryEngine::end_batch(SessionRequest *request)
+{
+  Session *session = request->session();
+  RequestProgress &progress = request->progress();
+
+  // 语句中的 COMMIT/ROLLBACK 已经结束了事务时，不需要再处理
+  if (progress.own_trx && session->is_trx_multi_operation_mode()) {
+    Session::set_current_session(session);
+    session->set_trx_multi_operation_mode(false);
+    Trx *trx = session->current_trx();
+    RC end_rc = RC_SUCC(progress.rc) ? trx->commit() : trx->rollback();
+    if (RC_FAIL(end_rc)) {
+      LOG_WARN("failed to end the transaction of batch. rc=%s", strrc(end_rc));
+      SqlResult sql_result(session);
+      sql_result.set_return_code(end_rc);
+      request->get_communicator()->write_state(&sql_result, progress.need_disconnect);
+      progress.rc = end_rc;
+    }
+    Session::set_current_session(nullptr);
+  }
+  progress.own_trx = false;
 }
 
 // 查询的前端解析阶段，对输入的sql进行解析，并构建QueryInfo
 RC QueryEngine::planQuery(QueryInfo *query_info) {
 
+  // 0. 计划缓存：规范化之后的SQL有缓存的计划时，跳过解析、分析与优化，只需要绑定参数并生成物理计划
+  QueryStats *stats = &query_info->stats();
+  bool cache_hit = false;
+  RC rc = RC::SUCCESS;
+  {
+    QueryPhaseTimer timer(stats, QueryPhase::PLAN);
+    rc = plan_from_cache(query_info, cache_hit);
+  }
+  if (cache_hit) {
+    return rc;
+  }
+
   // 1. 语法解析：将sql转为语法树
-  RC rc = Parser::parse(query_info);
+  {
+    QueryPhaseTimer timer(stats, QueryPhase::PARSE);
+    rc = Parser::parse(query_info);
+  }
   if (RC_FAIL(rc)) {
     LOG_TRACE("failed to do parse. rc=%s", strrc(rc));
     return rc;
   }
 
   // 2. 分析预处理：解析抽象语法树并进行预处理，生成statement结构
-  rc = Analyzer::analyze(query_info);
+  {
+    QueryPhaseTimer timer(stats, QueryPhase::ANALYZE);
+    rc = Analyzer::analyze(query_info);
+  }
   if (RC_FAIL(rc)) {
     LOG_TRACE("failed to do resolve. rc=%s", strrc(rc));
     return rc;
   }
 
+  // PREPARE 在这里生成计划，由执行器保存到会话中；EXECUTE 使用保存的计划
+  Stmt *stmt = query_info->stmt();
+  if (stmt != nullptr && stmt->type() == StmtType::PREPARE) {
+    QueryPhaseTimer timer(stats, QueryPhase::PLAN);
+    auto *prepare_stmt = static_cast<PrepareStmt *>(stmt);
+    std::shared_ptr<const CachedPlan> plan;
+    rc = build_cached_plan(query_info->session_event()->session()->get_current_db(), prepare_stmt->name(),
+        prepare_stmt->sql(), plan);
+    if (rc != RC::SUCCESS) {
+      LOG_TRACE("failed to prepare statement. rc=%s", strrc(rc));
+      query_info->session_event()->sql_result()->set_return_code(rc);
+      return rc;
+    }
+    prepare_stmt->set_plan(plan);
+  } else if (stmt != nullptr && stmt->type() == StmtType::EXECUTE) {
+    QueryPhaseTimer timer(stats, QueryPhase::PLAN);
+    return plan_execute(query_info);
+  }
+
   // 3. 逻辑计划生成：参照statement结构生成逻辑计划树
   std::unique_ptr<LogicalNode> logical_nodes;
-  rc = planner_.plan_logical_tree(query_info, logical_nodes);
+  {
+    QueryPhaseTimer timer(stats, QueryPhase::PLAN);
+    rc = planner_.plan_logical_tree(query_info, logical_nodes);
+  }
   if (rc != RC::SUCCESS) {
     LOG_TRACE("failed to create logical nodes. rc=%s", strrc(rc));
     return rc;
   }
 
-  // 4. 查询优化：对逻辑计划树进行优化，生成优化后的逻辑计划树，目前仅基于RBO进行优化
-  rc = optimizer_.rewrite(logical_nodes);
-  if (rc != RC::UNIMPLENMENT && rc != RC::SUCCESS) {
-    LOG_TRACE("failed to do optimize. rc=%s", strrc(rc));
+  // 4. 查询优化：先基于规则重写逻辑计划树，再基于代价选择连接顺序与访问方式
+  {
+    QueryPhaseTimer timer(stats, QueryPhase::OPTIMIZE);
+    rc = optimizer_.rewrite(logical_nodes);
+    if (rc != RC::UNIMPLENMENT && rc != RC::SUCCESS) {
+      LOG_TRACE("failed to do optimize. rc=%s", strrc(rc));
+      return rc;
+    }
+    rc = optimizer_.optimize(logical_nodes);
+  }
+  if (rc != RC::SUCCESS) {
+    LOG_TRACE("failed to do cost based optimize. rc=%s", strrc(rc));
     return rc;
   }
 
   // 5. 物理计划生成：根据优化后的逻辑计划树生成物理计划树，描述了查询的具体执行逻辑
-  rc = planner_.plan_physical_operator(logical_nodes, query_info);
+  {
+    QueryPhaseTimer timer(stats, QueryPhase::PLAN);
+    rc = planner_.plan_physical_operator(logical_nodes, query_info);
+  }
   if(RC_FAIL(rc)) {
     LOG_TRACE("failed to create physical operator. rc=%s", strrc(rc));
     return rc;
@@ -90,3 +296,144 @@ RC QueryEngine::planQuery(QueryInfo *query_info) {
   return rc;
 }
 
+
+RC QueryEngine::build_cached_plan(
+    Db *db, const std::string &key, const std::string &sql, std::shared_ptr<const CachedPlan> &plan)
+{
+  auto cached_plan            = std::make_shared<CachedPlan>();
+  cached_plan->key            = key;
+  cached_plan->sql            = sql;
+  cached_plan->schema_version = db->schema_version();
+  plan                        = cached_plan;
+
+  std::unique_ptr<ParsedSqlNode> sql_node;
+  int param_count = 0;
+  RC rc = Parser::parse(sql, sql_node, param_count);
+  if (rc != RC::SUCCESS) {
+    return rc == RC::INTERNAL ? RC::SQL_SYNTAX : rc;
+  }
+  if (sql_node->flag != SCF_SELECT && sql_node->flag != SCF_INSERT && sql_node->flag != SCF_UPDATE &&
+      sql_node->flag != SCF_DELETE) {
+    LOG_WARN("only select/insert/update/delete can be prepared. flag=%d", sql_node->flag);
+    return RC::INVALID_ARGUMENT;
+  }
+
+  Stmt *stmt = nullptr;
+  rc = Stmt::create_stmt(db, *sql_node, stmt);
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+  cached_plan->stmt.reset(stmt);
+
+  std::unique_ptr<LogicalNode> logical_plan;
+  rc = planner_.plan_logical_tree(stmt, logical_plan);
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+  rc = optimizer_.rewrite(logical_plan);
+  if (rc != RC::UNIMPLENMENT && rc != RC::SUCCESS) {
+    return rc;
+  }
+  rc = optimizer_.optimize(logical_plan);
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+
+  cached_plan->param_count  = param_count;
+  cached_plan->logical_plan = std::move(logical_plan);
+  return RC::SUCCESS;
+}
+
+RC QueryEngine::plan_from_cache(QueryInfo *query_info, bool &hit)
+{
+  hit = false;
+  Session *session = query_info->session_event()->session();
+  Db *db = session->get_current_db();
+  std::string normalized;
+  std::vector<Value> params;
+  if (db == nullptr || !SqlNormalizer::normalize(query_info->sql(), normalized, params)) {
+    return RC::SUCCESS;
+  }
+
+  const std::string key = std::string(db->name()) + ":" + normalized;
+  const uint64_t schema_version = db->schema_version();
+  std::shared_ptr<const CachedPlan> plan = session->plan_cache().get(key, schema_version);
+  if (plan == nullptr) {
+    PlanCache &global_cache = PlanCache::global_instance();
+    plan = global_cache.get(key, schema_version);
+    if (plan == nullptr) {
+      // 生成失败的SQL也放到缓存中，之后直接走完整的流程，由完整的流程报告错误
+      RC rc = build_cached_plan(db, key, normalized, plan);
+      if (rc != RC::SUCCESS) {
+        LOG_TRACE("sql can not use cached plan. sql=%s, rc=%s", normalized.c_str(), strrc(rc));
+      }
+      global_cache.put(plan);
+    }
+    session->plan_cache().put(plan);
+  }
+  if (!plan->usable()) {
+    return RC::SUCCESS;
+  }
+
+  RC rc = instantiate_plan(query_info, plan, params);
+  if (rc != RC::SUCCESS) {
+    LOG_TRACE("failed to instantiate cached plan, fallback to full planning. rc=%s", strrc(rc));
+    return rc;
+  }
+  hit = true;
+  return rc;
+}
+
+RC QueryEngine::plan_execute(QueryInfo *query_info)
+{
+  auto *execute_stmt = static_cast<ExecuteStmt *>(query_info->stmt());
+  Session *session = query_info->session_event()->session();
+  SqlResult *sql_result = query_info->session_event()->sql_result();
+  Db *db = session->get_current_db();
+
+  std::shared_ptr<const CachedPlan> plan = session->find_prepared_stmt(execute_stmt->name());
+  if (plan == nullptr) {
+    LOG_WARN("no such prepared statement: %s", execute_stmt->name().c_str());
+    sql_result->set_return_code(RC::NOTFOUND);
+    return RC::NOTFOUND;
+  }
+
+  RC rc = RC::SUCCESS;
+  if (plan->schema_version != db->schema_version()) {
+    // 执行过DDL，按照保存的SQL重新生成计划
+    std::shared_ptr<const CachedPlan> new_plan;
+    rc = build_cached_plan(db, plan->key, plan->sql, new_plan);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to re-prepare statement %s. rc=%s", plan->key.c_str(), strrc(rc));
+      sql_result->set_return_code(rc);
+      return rc;
+    }
+    session->add_prepared_stmt(execute_stmt->name(), new_plan);
+    plan = new_plan;
+  }
+
+  rc = instantiate_plan(query_info, plan, execute_stmt->params());
+  if (rc != RC::SUCCESS) {
+    sql_result->set_return_code(rc);
+  }
+  return rc;
+}
+
+RC QueryEngine::instantiate_plan(
+    QueryInfo *query_info, const std::shared_ptr<const CachedPlan> &plan, const std::vector<Value> &params)
+{
+  std::unique_ptr<LogicalNode> logical_plan;
+  RC rc = plan->instantiate(params, logical_plan);
+  if (rc != RC::SUCCESS) {
+    LOG_TRACE("failed to bind parameters. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  rc = planner_.plan_physical_operator(logical_plan, query_info);
+  if (rc != RC::SUCCESS) {
+    LOG_TRACE("failed to create physical operator. rc=%s", strrc(rc));
+    return rc;
+  }
+  query_info->set_cached_stmt(plan->stmt);
+  return rc;
+}
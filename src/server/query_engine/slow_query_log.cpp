@@ -0,0 +1,284 @@
+#include "include/query_engine/slow_query_log.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+
+#include "include/storage_engine/schema/system_table.h"
+
+namespace {
+
+/// 日志中一行最多 1KB，SQL 和算子描述超过这个长度时截断
+constexpr size_t MAX_SQL_LEN       = 512;
+constexpr size_t MAX_OPERATORS_LEN = 256;
+
+void append_json_string(std::string &out, const std::string &str, size_t max_len)
+{
+  out += '"';
+  const size_t len = std::min(str.size(), max_len);
+  for (size_t i = 0; i < len; i++) {
+    const char c = str[i];
+    switch (c) {
+      case '"': out += "\\\""; break;
+      case '\\': out += "\\\\"; break;
+      case '\n': out += "\\n"; break;
+      case '\r': out += "\\r"; break;
+      case '\t': out += "\\t"; break;
+      default: {
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char buf[8];
+          snprintf(buf, sizeof(buf), "\\u%04x", c);
+          out += buf;
+        } else {
+          out += c;
+        }
+      } break;
+    }
+  }
+  if (len < str.size()) {
+    out += "...";
+  }
+  out += '"';
+}
+
+void append_json_ms(std::string &out, const char *name, int64_t ns)
+{
+  char buf[64];
+  snprintf(buf, sizeof(buf), "\"%s_ms\":%.3f", name, ns / 1000000.0);
+  out += buf;
+}
+
+void append_json_count(std::string &out, const char *name, uint64_t count)
+{
+  out += "\"";
+  out += name;
+  out += "\":";
+  out += std::to_string(count);
+}
+
+std::string format_time(std::chrono::system_clock::time_point time_point)
+{
+  const auto us = std::chrono::duration_cast<std::chrono::microseconds>(time_point.time_since_epoch()).count();
+  const time_t seconds = static_cast<time_t>(us / 1000000);
+  struct tm tm;
+  localtime_r(&seconds, &tm);
+  char buf[64];
+  snprintf(buf, sizeof(buf), "%04d-%02d-%02d %02d:%02d:%02d.%06d",
+      tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec,
+      static_cast<int>(us % 1000000));
+  return buf;
+}
+
+AttrInfoSqlNode make_attr(AttrType type, const char *name, size_t length)
+{
+  AttrInfoSqlNode attr;
+  attr.type     = type;
+  attr.name     = name;
+  attr.length   = length;
+  attr.nullable = false;
+  return attr;
+}
+
+Value chars_value(const std::string &str, size_t field_len)
+{
+  // 定长字段最后留一个字节作为结束符
+  const size_t len = std::min(str.size(), field_len - 1);
+  return Value(str.substr(0, len).c_str());
+}
+
+Value int_value(uint64_t count)
+{
+  return Value(static_cast<int>(std::min<uint64_t>(count, INT_MAX)));
+}
+
+Value ms_value(int64_t ns)
+{
+  return Value(static_cast<float>(ns / 1000000.0));
+}
+
+constexpr size_t TIME_LEN      = 32;
+constexpr size_t NAME_LEN      = 32;
+constexpr size_t SQL_TEXT_LEN  = 256;
+constexpr size_t OPERATORS_LEN = 256;
+
+}  // namespace
+
+std::string SlowQueryRecord::to_json() const
+{
+  std::string out;
+  out.reserve(256 + std::min(sql.size(), MAX_SQL_LEN) + std::min(operators.size(), MAX_OPERATORS_LEN));
+  out += "{\"time\":";
+  append_json_string(out, start_time, start_time.size());
+  out += ",\"db\":";
+  append_json_string(out, db, db.size());
+  out += ",\"sql\":";
+  append_json_string(out, sql, MAX_SQL_LEN);
+  out += ",\"rc\":\"";
+  out += strrc(rc);
+  out += "\",";
+  append_json_ms(out, "total", total_ns);
+  for (int i = 0; i < static_cast<int>(QueryPhase::NUM); i++) {
+    out += ",";
+    append_json_ms(out, query_phase_name(static_cast<QueryPhase>(i)), phase_ns[i]);
+  }
+  out += ",";
+  append_json_count(out, "pages_read", pages_read);
+  out += ",";
+  append_json_count(out, "pages_hit", pages_hit);
+  out += ",";
+  append_json_count(out, "pages_written", pages_written);
+  out += ",";
+  append_json_count(out, "rows_scanned", rows_scanned);
+  out += ",";
+  append_json_count(out, "rows_sent", rows_sent);
+  out += ",";
+  append_json_count(out, "bytes_sent", bytes_sent);
+  out += ",";
+  append_json_count(out, "log_bytes", log_bytes);
+  out += ",\"operators\":";
+  append_json_string(out, operators, MAX_OPERATORS_LEN);
+  out += "}";
+  return out;
+}
+
+SlowQueryLog &SlowQueryLog::instance()
+{
+  static SlowQueryLog instance;
+  return instance;
+}
+
+RC SlowQueryLog::init(const std::string &file_name, double threshold_ms, int history_size)
+{
+  std::lock_guard<std::mutex> guard(lock_);
+  history_size_ = history_size > 0 ? static_cast<size_t>(history_size) : 0;
+  history_.clear();
+
+  if (threshold_ms < 0) {
+    threshold_ns_.store(-1, std::memory_order_relaxed);
+    log_.reset();
+    return RC::SUCCESS;
+  }
+
+  if (!file_name.empty()) {
+    // 只输出 INFO 级别，不输出到控制台
+    log_ = std::make_unique<common::Log>(file_name, common::LOG_LEVEL_INFO, common::LOG_LEVEL_PANIC);
+    log_->start_async();
+  }
+  threshold_ns_.store(static_cast<int64_t>(threshold_ms * 1000000), std::memory_order_relaxed);
+  LOG_INFO("slow query log enabled. threshold=%.3fms, file=%s, history=%d",
+      threshold_ms, file_name.c_str(), history_size);
+  return RC::SUCCESS;
+}
+
+void SlowQueryLog::cleanup()
+{
+  threshold_ns_.store(-1, std::memory_order_relaxed);
+  std::lock_guard<std::mutex> guard(lock_);
+  history_.clear();
+  log_.reset();
+}
+
+void SlowQueryLog::record(const char *db, const std::string &sql, RC rc, const QueryStats &stats)
+{
+  if (!is_slow(stats.total_ns)) {
+    return;
+  }
+
+  SlowQueryRecord record;
+  record.start_time = format_time(std::chrono::system_clock::now() - std::chrono::nanoseconds(stats.total_ns));
+  record.db         = db == nullptr ? "" : db;
+  record.sql        = sql;
+  record.rc         = rc;
+  record.total_ns   = stats.total_ns;
+  for (int i = 0; i < static_cast<int>(QueryPhase::NUM); i++) {
+    record.phase_ns[i] = stats.phase_time(static_cast<QueryPhase>(i));
+  }
+  record.pages_read    = stats.pages_read.load(std::memory_order_relaxed);
+  record.pages_hit     = stats.pages_hit.load(std::memory_order_relaxed);
+  record.pages_written = stats.pages_written.load(std::memory_order_relaxed);
+  record.rows_scanned  = stats.rows_scanned;
+  record.rows_sent     = stats.rows_sent;
+  record.bytes_sent    = stats.bytes_sent;
+  record.log_bytes     = stats.log_bytes.load(std::memory_order_relaxed);
+  record.operators     = stats.operators();
+
+  std::lock_guard<std::mutex> guard(lock_);
+  if (log_ != nullptr) {
+    log_->output(common::LOG_LEVEL_INFO, "slow_query", "", "%s", record.to_json().c_str());
+  }
+  if (history_size_ > 0) {
+    if (history_.size() >= history_size_) {
+      history_.pop_front();
+    }
+    history_.push_back(std::move(record));
+  }
+}
+
+std::vector<SlowQueryRecord> SlowQueryLog::history() const
+{
+  std::lock_guard<std::mutex> guard(lock_);
+  return std::vector<SlowQueryRecord>(history_.begin(), history_.end());
+}
+
+RC SlowQueryLog::register_system_table()
+{
+  const AttrInfoSqlNode attributes[] = {
+      make_attr(CHARS, "start_time", TIME_LEN),
+      make_attr(CHARS, "db", NAME_LEN),
+      make_attr(CHARS, "sql_text", SQL_TEXT_LEN),
+      make_attr(CHARS, "rc", NAME_LEN),
+      make_attr(FLOATS, "total_ms", sizeof(float)),
+      make_attr(FLOATS, "parse_ms", sizeof(float)),
+      make_attr(FLOATS, "analyze_ms", sizeof(float)),
+      make_attr(FLOATS, "plan_ms", sizeof(float)),
+      make_attr(FLOATS, "optimize_ms", sizeof(float)),
+      make_attr(FLOATS, "execute_ms", sizeof(float)),
+      make_attr(FLOATS, "send_ms", sizeof(float)),
+      make_attr(INTS, "pages_read", sizeof(int)),
+      make_attr(INTS, "pages_hit", sizeof(int)),
+      make_attr(INTS, "pages_written", sizeof(int)),
+      make_attr(INTS, "rows_scanned", sizeof(int)),
+      make_attr(INTS, "rows_sent", sizeof(int)),
+      make_attr(INTS, "bytes_sent", sizeof(int)),
+      make_attr(INTS, "log_bytes", sizeof(int)),
+      make_attr(CHARS, "operators", OPERATORS_LEN),
+  };
+  const int attribute_count = static_cast<int>(sizeof(attributes) / sizeof(attributes[0]));
+
+  auto loader = [](Table &table, std::vector<Record> &records) -> RC {
+    for (const SlowQueryRecord &slow_query : SlowQueryLog::instance().history()) {
+      std::vector<Value> values;
+      values.reserve(attribute_count);
+      values.push_back(chars_value(slow_query.start_time, TIME_LEN));
+      values.push_back(chars_value(slow_query.db, NAME_LEN));
+      values.push_back(chars_value(slow_query.sql, SQL_TEXT_LEN));
+      values.push_back(chars_value(strrc(slow_query.rc), NAME_LEN));
+      values.push_back(ms_value(slow_query.total_ns));
+      for (int i = 0; i < static_cast<int>(QueryPhase::NUM); i++) {
+        values.push_back(ms_value(slow_query.phase_ns[i]));
+      }
+      values.push_back(int_value(slow_query.pages_read));
+      values.push_back(int_value(slow_query.pages_hit));
+      values.push_back(int_value(slow_query.pages_written));
+      values.push_back(int_value(slow_query.rows_scanned));
+      values.push_back(int_value(slow_query.rows_sent));
+      values.push_back(int_value(slow_query.bytes_sent));
+      values.push_back(int_value(slow_query.log_bytes));
+      values.push_back(chars_value(slow_query.operators, OPERATORS_LEN));
+
+      Record record;
+      RC rc = table.make_record(static_cast<int>(values.size()), values.data(), record);
+      if (rc != RC::SUCCESS) {
+        LOG_WARN("failed to make record of slow query log. rc=%s", strrc(rc));
+        return rc;
+      }
+      records.push_back(std::move(record));
+    }
+    return RC::SUCCESS;
+  };
+  return SystemTables::instance().add(SYSTEM_TABLE_NAME, attribute_count, attributes, loader);
+}
@@ -55,7 +55,8 @@ RC ComparisonExpr::compare_value(const Value &left, const Value &right, bool &re
       LOG_WARN("failed to get value from sub query. rc=%s", strrc(rc));
       return rc;
     }
-    result = CompOp::IN == comp_ ? in.get_boolean() : !in.get_boolean();
+    // 结果未知(NULL)时 IN 与 NOT IN 都不成立
+    result = !in.is_null() && (CompOp::IN == comp_ ? in.get_boolean() : !in.get_boolean());
     return RC::SUCCESS;
   }
 
@@ -119,6 +120,23 @@ RC ComparisonExpr::compare_value(const Value &left, const Value &right, bool &re
 
 RC ComparisonExpr::try_get_value(Value &cell) const
 {
+  // 常量列表上的 (NOT) EXISTS 与 常量 (NOT) IN 常量列表
+  const bool exists_on_values = (comp_ == EXISTS || comp_ == NOT_EXISTS) && left_->type() == ExprType::VALUES;
+  const bool in_values = (comp_ == IN || comp_ == NOT_IN) && left_->type() == ExprType::VALUE &&
+                         right_ != nullptr && right_->type() == ExprType::VALUES;
+  if (exists_on_values || in_values) {
+    Value left_cell;
+    if (in_values) {
+      left_cell = static_cast<ValueExpr *>(left_.get())->get_value();
+    }
+    bool value = false;
+    RC rc = compare_value(left_cell, Value(), value);
+    if (rc == RC::SUCCESS) {
+      cell.set_boolean(value);
+    }
+    return rc;
+  }
+
   if (left_->type() == ExprType::VALUE &&
       right_ != nullptr && right_->type() == ExprType::VALUE) {
     auto *left_value_expr = dynamic_cast<ValueExpr *>(left_.get());
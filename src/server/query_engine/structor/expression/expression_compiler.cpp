@@ -0,0 +1,528 @@
+#include "include/query_engine/structor/expression/expression_compiler.h"
+
+#include <cstring>
+#include <vector>
+
+#include "common/defs.h"
+#include "common/lang/comparator.h"
+#include "include/query_engine/structor/expression/comparison_expression.h"
+#include "include/query_engine/structor/expression/conjunction_expression.h"
+#include "include/query_engine/structor/expression/field_expression.h"
+#include "include/query_engine/structor/expression/value_expression.h"
+#include "include/query_engine/structor/tuple/row_tuple.h"
+#include "include/storage_engine/recorder/table.h"
+#include "include/storage_engine/recorder/zone_map.h"
+
+namespace {
+
+CompOp swap_comp(CompOp comp)
+{
+  switch (comp) {
+    case LESS_EQUAL: return GREAT_EQUAL;
+    case LESS_THAN: return GREAT_THAN;
+    case GREAT_EQUAL: return LESS_EQUAL;
+    case GREAT_THAN: return LESS_THAN;
+    default: return comp;
+  }
+}
+
+/**
+ * @brief 字段在记录中的位置
+ * @details index 是字段在表中的序号，也是它在空值位图中的位置
+ */
+struct FieldSlot
+{
+  int offset = 0;
+  int len = 0;
+  int index = 0;
+  int null_offset = 0;
+
+  bool is_null(const char *data) const
+  {
+    return (data[null_offset + index / 8] & (1 << (index % 8))) != 0;
+  }
+};
+
+/// 整数与日期按照整数比较
+struct IntCompare
+{
+  using Constant = int;
+
+  static int read(const char *data, const FieldSlot &slot)
+  {
+    int value;
+    memcpy(&value, data + slot.offset, sizeof(value));
+    return value;
+  }
+  static int compare(int left, int right) { return (left > right) - (left < right); }
+};
+
+/// 与 common::compare_float 相同，差值在 EPSILON 以内认为相等
+struct FloatCompare
+{
+  using Constant = float;
+
+  static float read(const char *data, const FieldSlot &slot)
+  {
+    float value;
+    memcpy(&value, data + slot.offset, sizeof(value));
+    return value;
+  }
+  static int compare(float left, float right)
+  {
+    const float cmp = left - right;
+    return cmp > EPSILON ? 1 : (cmp < -EPSILON ? -1 : 0);
+  }
+};
+
+/// 整数字段与浮点数常量比较时，字段转换成浮点数
+struct IntAsFloatCompare
+{
+  using Constant = float;
+
+  static float read(const char *data, const FieldSlot &slot) { return static_cast<float>(IntCompare::read(data, slot)); }
+  static int compare(float left, float right) { return FloatCompare::compare(left, right); }
+};
+
+/// 定长字符串，字段中第一个'\0'之后的内容不参与比较
+struct StringCompare
+{
+  struct Constant
+  {
+    std::string value;
+  };
+
+  struct Slice
+  {
+    const char *data;
+    int len;
+  };
+
+  static Slice read(const char *data, const FieldSlot &slot)
+  {
+    const char *value = data + slot.offset;
+    return {value, static_cast<int>(strnlen(value, slot.len))};
+  }
+  static int compare(const Slice &left, const Constant &right)
+  {
+    return common::compare_string(const_cast<char *>(left.data), left.len,
+        const_cast<char *>(right.value.data()), static_cast<int>(right.value.size()));
+  }
+};
+
+template <CompOp OP>
+inline bool apply_comp(int cmp)
+{
+  switch (OP) {
+    case EQUAL_TO: return cmp == 0;
+    case NOT_EQUAL: return cmp != 0;
+    case LESS_THAN: return cmp < 0;
+    case LESS_EQUAL: return cmp <= 0;
+    case GREAT_THAN: return cmp > 0;
+    case GREAT_EQUAL: return cmp >= 0;
+    default: return false;
+  }
+}
+
+/// 字段 op 常量
+template <typename Compare, CompOp OP>
+class FieldValueKernel : public ExprKernel
+{
+public:
+  FieldValueKernel(const FieldSlot &slot, typename Compare::Constant constant)
+      : slot_(slot), constant_(std::move(constant))
+  {}
+
+  RC evaluate(const RowTuple &tuple, bool &result) const override
+  {
+    const char *data = tuple.record().data();
+    result = !slot_.is_null(data) && apply_comp<OP>(Compare::compare(Compare::read(data, slot_), constant_));
+    return RC::SUCCESS;
+  }
+
+private:
+  FieldSlot                   slot_;
+  typename Compare::Constant  constant_;
+};
+
+/// 同一张表中两个相同类型字段的比较
+template <typename Compare, CompOp OP>
+class FieldFieldKernel : public ExprKernel
+{
+public:
+  FieldFieldKernel(const FieldSlot &left, const FieldSlot &right) : left_(left), right_(right) {}
+
+  RC evaluate(const RowTuple &tuple, bool &result) const override
+  {
+    const char *data = tuple.record().data();
+    result = !left_.is_null(data) && !right_.is_null(data) &&
+             apply_comp<OP>(Compare::compare(Compare::read(data, left_), Compare::read(data, right_)));
+    return RC::SUCCESS;
+  }
+
+private:
+  FieldSlot left_;
+  FieldSlot right_;
+};
+
+template <bool IS_NULL>
+class NullTestKernel : public ExprKernel
+{
+public:
+  explicit NullTestKernel(const FieldSlot &slot) : slot_(slot) {}
+
+  RC evaluate(const RowTuple &tuple, bool &result) const override
+  {
+    result = slot_.is_null(tuple.record().data()) == IS_NULL;
+    return RC::SUCCESS;
+  }
+
+private:
+  FieldSlot slot_;
+};
+
+class ConjunctionKernel : public ExprKernel
+{
+public:
+  ConjunctionKernel(ConjunctionType type, std::vector<std::unique_ptr<ExprKernel>> children)
+      : is_and_(type == ConjunctionType::AND), children_(std::move(children))
+  {}
+
+  RC evaluate(const RowTuple &tuple, bool &result) const override
+  {
+    for (const std::unique_ptr<ExprKernel> &child : children_) {
+      RC rc = child->evaluate(tuple, result);
+      if (rc != RC::SUCCESS) {
+        return rc;
+      }
+      if (result != is_and_) {
+        return RC::SUCCESS;
+      }
+    }
+    result = is_and_;
+    return RC::SUCCESS;
+  }
+
+  bool compiled() const override
+  {
+    for (const std::unique_ptr<ExprKernel> &child : children_) {
+      if (!child->compiled()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+private:
+  bool                                     is_and_ = true;
+  std::vector<std::unique_ptr<ExprKernel>> children_;
+};
+
+/**
+ * @brief 字段 [NOT] IN 常量列表，直接在列表的哈希集合中查找字段的值
+ * @details 与 ValuesExpr::value_in 相同，字段为 NULL 或者列表中有 NULL 而没有找到时结果为假
+ */
+template <bool NOT>
+class InListKernel : public ExprKernel
+{
+public:
+  InListKernel(const FieldSlot &slot, AttrType type, const ValuesExpr *values)
+      : slot_(slot), is_string_(type == CHARS), values_(values)
+  {}
+
+  RC evaluate(const RowTuple &tuple, bool &result) const override
+  {
+    const char *data = tuple.record().data();
+    if (slot_.is_null(data)) {
+      result = false;
+      return RC::SUCCESS;
+    }
+
+    bool found = false;
+    if (is_string_) {
+      const StringCompare::Slice value = StringCompare::read(data, slot_);
+      found = values_->contains_string(std::string_view(value.data, value.len));
+    } else {
+      found = values_->contains_int(IntCompare::read(data, slot_));
+    }
+    result = found ? !NOT : (NOT && !values_->has_null());
+    return RC::SUCCESS;
+  }
+
+private:
+  FieldSlot         slot_;
+  bool              is_string_ = false;
+  const ValuesExpr *values_ = nullptr;
+};
+
+/// 优化时已经化简成常量的条件
+class ConstantKernel : public ExprKernel
+{
+public:
+  explicit ConstantKernel(bool value) : value_(value) {}
+
+  RC evaluate(const RowTuple &tuple, bool &result) const override
+  {
+    result = value_;
+    return RC::SUCCESS;
+  }
+
+  bool constant(bool &value) const override
+  {
+    value = value_;
+    return true;
+  }
+
+private:
+  bool value_ = false;
+};
+
+/// 不能编译的表达式，按照表达式树求值
+class ExpressionKernel : public ExprKernel
+{
+public:
+  explicit ExpressionKernel(const Expression *expr) : expr_(expr) {}
+
+  RC evaluate(const RowTuple &tuple, bool &result) const override
+  {
+    Value value;
+    RC rc = expr_->get_value(tuple, value);
+    if (rc == RC::SUCCESS) {
+      result = value.get_boolean();
+    }
+    return rc;
+  }
+
+  bool compiled() const override { return false; }
+
+private:
+  const Expression *expr_ = nullptr;
+};
+
+template <typename Compare, typename... Args>
+std::unique_ptr<ExprKernel> make_value_kernel(CompOp comp, const FieldSlot &slot, Args &&...args)
+{
+  typename Compare::Constant constant{std::forward<Args>(args)...};
+  switch (comp) {
+    case EQUAL_TO: return std::make_unique<FieldValueKernel<Compare, EQUAL_TO>>(slot, std::move(constant));
+    case NOT_EQUAL: return std::make_unique<FieldValueKernel<Compare, NOT_EQUAL>>(slot, std::move(constant));
+    case LESS_THAN: return std::make_unique<FieldValueKernel<Compare, LESS_THAN>>(slot, std::move(constant));
+    case LESS_EQUAL: return std::make_unique<FieldValueKernel<Compare, LESS_EQUAL>>(slot, std::move(constant));
+    case GREAT_THAN: return std::make_unique<FieldValueKernel<Compare, GREAT_THAN>>(slot, std::move(constant));
+    case GREAT_EQUAL: return std::make_unique<FieldValueKernel<Compare, GREAT_EQUAL>>(slot, std::move(constant));
+    default: return nullptr;
+  }
+}
+
+template <typename Compare>
+std::unique_ptr<ExprKernel> make_field_kernel(CompOp comp, const FieldSlot &left, const FieldSlot &right)
+{
+  switch (comp) {
+    case EQUAL_TO: return std::make_unique<FieldFieldKernel<Compare, EQUAL_TO>>(left, right);
+    case NOT_EQUAL: return std::make_unique<FieldFieldKernel<Compare, NOT_EQUAL>>(left, right);
+    case LESS_THAN: return std::make_unique<FieldFieldKernel<Compare, LESS_THAN>>(left, right);
+    case LESS_EQUAL: return std::make_unique<FieldFieldKernel<Compare, LESS_EQUAL>>(left, right);
+    case GREAT_THAN: return std::make_unique<FieldFieldKernel<Compare, GREAT_THAN>>(left, right);
+    case GREAT_EQUAL: return std::make_unique<FieldFieldKernel<Compare, GREAT_EQUAL>>(left, right);
+    default: return nullptr;
+  }
+}
+
+/**
+ * @brief 字段与常量比较的计算
+ * @details 类型组合与 Value::compare 中有专门处理的分支一致，其它组合返回空
+ */
+std::unique_ptr<ExprKernel> compile_field_value(CompOp comp, AttrType field_type, const FieldSlot &slot, const Value &value)
+{
+  const AttrType value_type = value.attr_type();
+  if (field_type == INTS && value_type == INTS) {
+    return make_value_kernel<IntCompare>(comp, slot, value.get_int());
+  }
+  if (field_type == DATES && value_type == DATES) {
+    return make_value_kernel<IntCompare>(comp, slot, value.get_int());
+  }
+  if (field_type == FLOATS && (value_type == FLOATS || value_type == INTS)) {
+    return make_value_kernel<FloatCompare>(comp, slot, value.get_float());
+  }
+  if (field_type == INTS && value_type == FLOATS) {
+    return make_value_kernel<IntAsFloatCompare>(comp, slot, value.get_float());
+  }
+  if ((field_type == CHARS && value_type == CHARS) || (field_type == TEXTS && value_type == TEXTS)) {
+    return make_value_kernel<StringCompare>(comp, slot, value.get_string());
+  }
+  return nullptr;
+}
+
+std::unique_ptr<ExprKernel> compile_field_field(CompOp comp, AttrType type, const FieldSlot &left, const FieldSlot &right)
+{
+  switch (type) {
+    case INTS:
+    case DATES: return make_field_kernel<IntCompare>(comp, left, right);
+    case FLOATS: return make_field_kernel<FloatCompare>(comp, left, right);
+    default: return nullptr;
+  }
+}
+
+}  // namespace
+
+std::unique_ptr<ExprKernel> ExpressionCompiler::compile(const Expression *expr) const
+{
+  const TableMeta &table_meta = table_->table_meta();
+  const std::vector<FieldMeta> &field_metas = *table_meta.field_metas();
+
+  auto field_slot = [&](const Expression *field_expr, FieldSlot &slot, AttrType &type) {
+    const int index = field_index(field_expr);
+    if (index < 0) {
+      return false;
+    }
+    const FieldMeta &field_meta = field_metas[index];
+    slot.offset = field_meta.offset();
+    slot.len = field_meta.len();
+    slot.index = index;
+    slot.null_offset = table_meta.null_bitmap_field()->offset();
+    type = field_meta.type();
+    return true;
+  };
+
+  std::unique_ptr<ExprKernel> kernel;
+  if (expr->type() == ExprType::VALUE && expr->value_type() == BOOLEANS) {
+    kernel = std::make_unique<ConstantKernel>(static_cast<const ValueExpr *>(expr)->get_value().get_boolean());
+  } else if (expr->type() == ExprType::CONJUNCTION) {
+    auto *conjunction_expr = const_cast<ConjunctionExpr *>(static_cast<const ConjunctionExpr *>(expr));
+    std::vector<std::unique_ptr<ExprKernel>> children;
+    for (const std::unique_ptr<Expression> &child : conjunction_expr->children()) {
+      children.push_back(compile(child.get()));
+    }
+    kernel = std::make_unique<ConjunctionKernel>(conjunction_expr->conjunction_type(), std::move(children));
+  } else if (expr->type() == ExprType::COMPARISON) {
+    auto *comparison_expr = static_cast<const ComparisonExpr *>(expr);
+    const Expression *left = comparison_expr->_left_().get();
+    const Expression *right = comparison_expr->_right_().get();
+    CompOp comp = comparison_expr->comp();
+
+    FieldSlot left_slot;
+    FieldSlot right_slot;
+    AttrType left_type = UNDEFINED;
+    AttrType right_type = UNDEFINED;
+    const bool left_is_field = field_slot(left, left_slot, left_type);
+    const bool right_is_field = field_slot(right, right_slot, right_type);
+    if (comp == IS_NULL || comp == IS_NOT_NULL) {
+      if (left_is_field && comp == IS_NULL) {
+        kernel = std::make_unique<NullTestKernel<true>>(left_slot);
+      } else if (left_is_field) {
+        kernel = std::make_unique<NullTestKernel<false>>(left_slot);
+      }
+    } else if (comp == IN || comp == NOT_IN) {
+      auto *values = right != nullptr && right->type() == ExprType::VALUES ? static_cast<const ValuesExpr *>(right)
+                                                                           : nullptr;
+      if (left_is_field && values != nullptr && values->hash_type() == left_type) {
+        if (comp == IN) {
+          kernel = std::make_unique<InListKernel<false>>(left_slot, left_type, values);
+        } else {
+          kernel = std::make_unique<InListKernel<true>>(left_slot, left_type, values);
+        }
+      }
+    } else if (left_is_field && right_is_field) {
+      if (left_type == right_type) {
+        kernel = compile_field_field(comp, left_type, left_slot, right_slot);
+      }
+    } else if (left_is_field && right != nullptr && right->type() == ExprType::VALUE) {
+      const Value &value = static_cast<const ValueExpr *>(right)->get_value();
+      kernel = compile_field_value(comp, left_type, left_slot, value);
+    } else if (right_is_field && left->type() == ExprType::VALUE) {
+      const Value &value = static_cast<const ValueExpr *>(left)->get_value();
+      kernel = compile_field_value(swap_comp(comp), right_type, right_slot, value);
+    }
+  }
+
+  if (kernel == nullptr) {
+    kernel = std::make_unique<ExpressionKernel>(expr);
+  }
+  return kernel;
+}
+
+int ExpressionCompiler::field_index(const Expression *expr) const
+{
+  // 只能编译引用当前表的字段，与 RowTuple::find_cell 的匹配规则相同
+  if (expr == nullptr || expr->type() != ExprType::FIELD) {
+    return -1;
+  }
+  const Field &field = static_cast<const FieldExpr *>(expr)->field();
+  if (0 != strcmp(field.table_name(), table_->name()) || table_alias_ != field.table_alias()) {
+    return -1;
+  }
+  const std::vector<FieldMeta> &field_metas = *table_->table_meta().field_metas();
+  for (size_t i = 0; i < field_metas.size(); i++) {
+    if (0 == strcmp(field_metas[i].name(), field.field_name())) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+bool ExpressionCompiler::compile_zone_predicate(const Expression *expr, ZonePredicate &predicate) const
+{
+  if (expr->type() == ExprType::CONJUNCTION) {
+    auto *conjunction_expr = const_cast<ConjunctionExpr *>(static_cast<const ConjunctionExpr *>(expr));
+    const bool is_and = conjunction_expr->conjunction_type() == ConjunctionType::AND;
+    predicate.kind = is_and ? ZonePredicate::Kind::AND : ZonePredicate::Kind::OR;
+    predicate.children.clear();
+    for (const std::unique_ptr<Expression> &child : conjunction_expr->children()) {
+      ZonePredicate child_predicate;
+      if (compile_zone_predicate(child.get(), child_predicate)) {
+        predicate.children.push_back(std::move(child_predicate));
+      } else if (!is_and) {
+        // OR 中有一个条件不能判断，整个条件就不能判断
+        return false;
+      }
+    }
+    return !predicate.children.empty();
+  }
+
+  if (expr->type() != ExprType::COMPARISON) {
+    return false;
+  }
+  auto *comparison_expr = static_cast<const ComparisonExpr *>(expr);
+  const Expression *left = comparison_expr->_left_().get();
+  const Expression *right = comparison_expr->_right_().get();
+  CompOp comp = comparison_expr->comp();
+  int index = field_index(left);
+  if (index < 0 && comp <= GREAT_THAN) {
+    index = field_index(right);
+    std::swap(left, right);
+    comp = swap_comp(comp);
+  }
+  if (index < 0) {
+    return false;
+  }
+
+  predicate.kind = ZonePredicate::Kind::COMPARE;
+  predicate.field_index = index;
+  predicate.comp = comp;
+  if (comp == IS_NULL || comp == IS_NOT_NULL) {
+    return true;
+  }
+  if (comp <= GREAT_THAN) {
+    if (right == nullptr || right->type() != ExprType::VALUE) {
+      return false;
+    }
+    predicate.value = static_cast<const ValueExpr *>(right)->get_value();
+    return true;
+  }
+  if (comp == IN && right != nullptr && right->type() == ExprType::VALUES) {
+    // 列表中的每个值都是一个等值条件，NULL 不会与任何值相等
+    predicate.kind = ZonePredicate::Kind::OR;
+    for (const Value &value : static_cast<const ValuesExpr *>(right)->values()) {
+      if (!value.is_null()) {
+        ZonePredicate child;
+        child.kind = ZonePredicate::Kind::COMPARE;
+        child.field_index = index;
+        child.comp = EQUAL_TO;
+        child.value = value;
+        predicate.children.push_back(std::move(child));
+      }
+    }
+    return true;
+  }
+  return false;
+}
@@ -0,0 +1,7 @@
+#include "include/query_engine/structor/expression/param_expression.h"
+
+RC ParamExpr::get_value(const Tuple &tuple, Value &value) const
+{
+  LOG_WARN("parameter %d is not bound", index_);
+  return RC::INTERNAL;
+}
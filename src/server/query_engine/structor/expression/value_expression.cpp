@@ -1,17 +1,61 @@
 #include "include/query_engine/structor/expression/value_expression.h"
 
+void ValuesExpr::add_value(const Value &value)
+{
+  values_.push_back(value);
+  if (value.is_null()) {
+    has_null_ = true;
+    return;
+  }
+  if (!hashable_) {
+    return;
+  }
+
+  const AttrType type = value.attr_type();
+  if ((type != INTS && type != DATES && type != CHARS) || (hash_type_ != UNDEFINED && hash_type_ != type)) {
+    // 浮点数按照 EPSILON 比较，不同类型之间需要转换，只能逐个比较
+    hashable_ = false;
+    int_set_.clear();
+    string_set_.clear();
+    return;
+  }
+
+  hash_type_ = type;
+  if (type == CHARS) {
+    string_set_.emplace(value.data(), value.length());
+  } else {
+    int_set_.insert(value.get_int());
+  }
+}
+
 RC ValuesExpr::value_in(const Value &value, Value &result) const {
-  for (const Value &cache : values_) {
-    if (cache.compare(value) == 0) {
-      result.set_boolean(true);
-      return RC::SUCCESS;
+  if (value.is_null()) {
+    result.set_null();
+    return RC::SUCCESS;
+  }
+
+  bool found = false;
+  if (hash_type() != UNDEFINED && value.attr_type() == hash_type_) {
+    found = hash_type_ == CHARS ? contains_string(std::string_view(value.data(), value.length()))
+                                : contains_int(value.get_int());
+  } else {
+    for (const Value &cache : values_) {
+      if (!cache.is_null() && cache.compare(value) == 0) {
+        found = true;
+        break;
+      }
     }
   }
-  result.set_boolean(false);
+
+  if (!found && has_null_) {
+    result.set_null();
+  } else {
+    result.set_boolean(found);
+  }
   return RC::SUCCESS;
 }
 
 RC ValuesExpr::value_exists(Value &value) const {
   value.set_boolean(!values_.empty());
   return RC::SUCCESS;
-}
\ No newline at end of file
+}
@@ -14,9 +14,18 @@ QueryInfo::~QueryInfo() noexcept
     session_event_ = nullptr;
   }
 
-  if (stmt_ != nullptr) {
+  if (stmt_ != nullptr && cached_stmt_ == nullptr) {
     delete stmt_;
-    stmt_ = nullptr;
   }
+  stmt_ = nullptr;
+}
+
+void QueryInfo::set_cached_stmt(std::shared_ptr<Stmt> stmt)
+{
+  if (stmt_ != nullptr && cached_stmt_ == nullptr) {
+    delete stmt_;
+  }
+  stmt_        = stmt.get();
+  cached_stmt_ = std::move(stmt);
 }
 
@@ -0,0 +1,188 @@
+#include "include/session/binary_communicator.h"
+#include "include/session/buffered_writer.h"
+#include "include/query_engine/structor/tuple/tuple.h"
+#include "common/io/binary_protocol.h"
+#include "common/log/log.h"
+
+using namespace common;
+
+BinaryCommunicator::BinaryCommunicator()
+{
+  // 一个请求的结果以 END 消息结束
+  send_message_delimiter_.clear();
+  std::string end;
+  finish_binary_message(end, begin_binary_message(end, BinaryMessageType::END));
+  send_message_delimiter_.assign(end.begin(), end.end());
+}
+
+RC BinaryCommunicator::write_result(const char *data, int32_t size)
+{
+  message_.clear();
+  size_t header = begin_binary_message(message_, BinaryMessageType::TEXT);
+  message_.append(data, size);
+  finish_binary_message(message_, header);
+  return writer_->writen(message_.data(), static_cast<int32_t>(message_.size()));
+}
+
+RC BinaryCommunicator::write_schema(const TupleSchema &schema)
+{
+  column_num_ = schema.cell_num();
+  rows_       = 0;
+  cells_.clear();
+
+  message_.clear();
+  size_t header = begin_binary_message(message_, BinaryMessageType::SCHEMA);
+  put_u16(message_, static_cast<uint16_t>(column_num_));
+  for (int i = 0; i < column_num_; i++) {
+    const char *alias = schema.cell_at(i).alias();
+    uint16_t    len   = alias == nullptr ? 0 : static_cast<uint16_t>(strlen(alias));
+    put_u16(message_, len);
+    message_.append(alias == nullptr ? "" : alias, len);
+  }
+  finish_binary_message(message_, header);
+  return writer_->writen(message_.data(), static_cast<int32_t>(message_.size()));
+}
+
+RC BinaryCommunicator::append_row(std::vector<Value> &row)
+{
+  ASSERT(static_cast<int>(row.size()) == column_num_, "row size mismatch with schema");
+  // 复用已经分配的值，避免每一行都重新分配
+  const size_t offset = static_cast<size_t>(rows_) * column_num_;
+  if (cells_.size() < offset + column_num_) {
+    cells_.resize(offset + column_num_);
+  }
+  for (int i = 0; i < column_num_; i++) {
+    cells_[offset + i] = row[i];
+  }
+  rows_++;
+
+  if (rows_ >= BATCH_ROWS) {
+    return flush_batch();
+  }
+  return RC::SUCCESS;
+}
+
+RC BinaryCommunicator::flush_batch()
+{
+  if (rows_ == 0) {
+    return RC::SUCCESS;
+  }
+
+  message_.clear();
+  size_t header = begin_binary_message(message_, BinaryMessageType::BATCH);
+  put_u32(message_, static_cast<uint32_t>(rows_));
+  put_u16(message_, static_cast<uint16_t>(column_num_));
+  for (int i = 0; i < column_num_; i++) {
+    encode_column(i);
+  }
+  finish_binary_message(message_, header);
+  rows_ = 0;
+  return writer_->writen(message_.data(), static_cast<int32_t>(message_.size()));
+}
+
+void BinaryCommunicator::release_batch()
+{
+  rows_ = 0;
+  std::vector<Value>().swap(cells_);
+  std::string().swap(message_);
+  dictionary_ = {};
+}
+
+void BinaryCommunicator::encode_column(int column)
+{
+  auto cell = [this, column](int row) -> const Value & { return cells_[static_cast<size_t>(row) * column_num_ + column]; };
+
+  // 列的类型由非NULL的值决定，类型不一致时全部按照字符串发送
+  AttrType value_type = UNDEFINED;
+  bool     mixed      = false;
+  for (int row = 0; row < rows_; row++) {
+    const Value &value = cell(row);
+    if (value.is_null()) {
+      continue;
+    }
+    AttrType type = value.attr_type() == TEXTS ? CHARS : value.attr_type();
+    if (value_type == UNDEFINED) {
+      value_type = type;
+    } else if (value_type != type) {
+      mixed = true;
+    }
+  }
+
+  BinaryColumnType column_type = BinaryColumnType::STRING;
+  if (value_type == UNDEFINED) {
+    column_type = BinaryColumnType::NULLS;
+  } else if (!mixed) {
+    switch (value_type) {
+      case INTS: column_type = BinaryColumnType::INT; break;
+      case DATES: column_type = BinaryColumnType::DATE; break;
+      case FLOATS: column_type = BinaryColumnType::FLOAT; break;
+      case BOOLEANS: column_type = BinaryColumnType::BOOL; break;
+      default: column_type = BinaryColumnType::STRING; break;
+    }
+  }
+  put_u8(message_, static_cast<uint8_t>(column_type));
+
+  const size_t bitmap_pos = message_.size();
+  message_.append((rows_ + 7) / 8, '\0');
+  for (int row = 0; row < rows_; row++) {
+    if (cell(row).is_null()) {
+      message_[bitmap_pos + row / 8] |= static_cast<char>(1 << (row % 8));
+    }
+  }
+
+  switch (column_type) {
+    case BinaryColumnType::NULLS: break;
+    case BinaryColumnType::INT:
+    case BinaryColumnType::DATE: {
+      for (int row = 0; row < rows_; row++) {
+        put_u32(message_, cell(row).is_null() ? 0 : static_cast<uint32_t>(cell(row).get_int()));
+      }
+    } break;
+    case BinaryColumnType::FLOAT: {
+      for (int row = 0; row < rows_; row++) {
+        put_float(message_, cell(row).is_null() ? 0 : cell(row).get_float());
+      }
+    } break;
+    case BinaryColumnType::BOOL: {
+      for (int row = 0; row < rows_; row++) {
+        put_u8(message_, cell(row).is_null() ? 0 : cell(row).get_boolean());
+      }
+    } break;
+    case BinaryColumnType::STRING: {
+      // 先给每一行分配字典下标，再写字典与下标。字典的键直接引用值中的字符串，不需要复制
+      dictionary_.clear();
+      std::vector<std::string>      mixed_strings;
+      std::vector<std::string_view> entries;
+      std::vector<uint32_t>         codes(rows_, 0);
+      if (mixed) {
+        mixed_strings.resize(rows_);
+      }
+      for (int row = 0; row < rows_; row++) {
+        const Value &value = cell(row);
+        if (value.is_null()) {
+          continue;
+        }
+        std::string_view str;
+        if (mixed) {
+          mixed_strings[row] = value.to_string();
+          str = mixed_strings[row];
+        } else {
+          str = std::string_view(value.data(), value.length());
+        }
+        auto [iter, inserted] = dictionary_.emplace(str, static_cast<uint32_t>(entries.size()));
+        if (inserted) {
+          entries.push_back(str);
+        }
+        codes[row] = iter->second;
+      }
+      put_u32(message_, static_cast<uint32_t>(entries.size()));
+      for (std::string_view entry : entries) {
+        put_u32(message_, static_cast<uint32_t>(entry.size()));
+        message_.append(entry);
+      }
+      for (uint32_t code : codes) {
+        put_u32(message_, code);
+      }
+    } break;
+  }
+}
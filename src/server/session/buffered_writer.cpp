@@ -1,8 +1,11 @@
 #include <sys/errno.h>
 #include <unistd.h>
 #include <algorithm>
+#include <cstdint>
 
 #include "include/session/buffered_writer.h"
+#include "include/common/query_stats.h"
+#include "common/io/shm_channel.h"
 
 using namespace std;
 
@@ -26,13 +29,10 @@ RC BufferedWriter::close()
   }
 
   RC rc = flush();
-  if (RC_FAIL(rc)) {
-    return rc;
-  }
-
   fd_ = -1;
-
-  return RC::SUCCESS;
+  overflow_.clear();
+  overflow_pos_ = 0;
+  return rc;
 }
 
 RC BufferedWriter::write(const char *data, int32_t size, int32_t &write_size)
@@ -41,14 +41,23 @@ RC BufferedWriter::write(const char *data, int32_t size, int32_t &write_size)
     return RC::INVALID_ARGUMENT;
   }
 
-  if (buffer_.remain() == 0) {
-    RC rc = flush_internal(size);
+  // 溢出缓存中有数据说明套接字刚刚写不进去，直接追加，等调用者刷新时再尝试写
+  if (buffer_.remain() == 0 && overflow_pos_ == overflow_.size()) {
+    bool would_block = false;
+    RC rc = flush_internal(size, would_block);
     if (RC_FAIL(rc)) {
       return rc;
     }
   }
 
-  return buffer_.write(data, size, write_size);
+  if (buffer_.remain() > 0 && overflow_pos_ == overflow_.size()) {
+    return buffer_.write(data, size, write_size);
+  }
+
+  // 套接字暂时写不进去时不在这里等待，由调用者根据 pending 决定是否暂停写入
+  overflow_.append(data, size);
+  write_size = size;
+  return RC::SUCCESS;
 }
 
 RC BufferedWriter::writen(const char *data, int32_t size)
@@ -68,6 +77,9 @@ RC BufferedWriter::writen(const char *data, int32_t size)
     write_size += tmp_write_size;
   }
 
+  if (QueryStats *stats = QueryStats::current()) {
+    stats->bytes_sent += size;
+  }
   return RC::SUCCESS;
 }
 
@@ -78,13 +90,18 @@ RC BufferedWriter::flush()
   }
 
   RC rc = RC::SUCCESS;
-  while (RC_SUCC(rc) && buffer_.size() > 0) {
-    rc = flush_internal(buffer_.size());
+  bool would_block = false;
+  while (RC_SUCC(rc) && pending() > 0 && !would_block) {
+    rc = flush_internal(static_cast<int32_t>(std::min<int64_t>(pending(), INT32_MAX)), would_block);
+  }
+  if (pending() == 0) {
+    // 结果都发送完了，空闲的连接不保留缓存
+    buffer_.release();
   }
   return rc;
 }
 
-RC BufferedWriter::flush_internal(int32_t size)
+RC BufferedWriter::flush_internal(int32_t size, bool &would_block)
 {
   if (fd_ < 0) {
     return RC::INVALID_ARGUMENT;
@@ -92,30 +109,89 @@ RC BufferedWriter::flush_internal(int32_t size)
 
   RC rc = RC::SUCCESS;
   int32_t write_size = 0;
-  while (RC_SUCC(rc) && buffer_.size() > 0 && size > write_size) {
+  would_block = false;
+  while (RC_SUCC(rc) && pending() > 0 && size > write_size) {
+    // 先写环形缓存中的数据，环形缓存空了再写溢出缓存
+    const bool from_ring = buffer_.size() > 0;
     const char *buf = nullptr;
     int32_t read_size = 0;
-    rc = buffer_.buffer(buf, read_size);
-    if (RC_FAIL(rc)) {
-      return rc;
+    if (from_ring) {
+      rc = buffer_.buffer(buf, read_size);
+      if (RC_FAIL(rc)) {
+        return rc;
+      }
+    } else {
+      buf = overflow_.data() + overflow_pos_;
+      read_size = static_cast<int32_t>(std::min<size_t>(overflow_.size() - overflow_pos_, INT32_MAX));
     }
 
     ssize_t tmp_write_size = 0;
-    while (tmp_write_size == 0) {
-      tmp_write_size = ::write(fd_, buf, read_size);
-      if (tmp_write_size < 0) {
-        if (errno == EAGAIN || errno == EINTR) {
-          tmp_write_size = 0;
-          continue;
-        } else {
-          return RC::IOERR_WRITE;
-        }
+    {
+      QueryPhaseTimer timer(QueryStats::current(), QueryPhase::SEND);
+      tmp_write_size = write_some(buf, read_size);
+    }
+    if (tmp_write_size < 0) {
+      if (errno == EINTR) {
+        continue;
       }
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        would_block = true;
+        break;
+      }
+      return RC::IOERR_WRITE;
     }
 
     write_size += tmp_write_size;
-    buffer_.forward(tmp_write_size);
+    if (from_ring) {
+      buffer_.forward(tmp_write_size);
+    } else {
+      overflow_pos_ += tmp_write_size;
+      if (overflow_pos_ == overflow_.size()) {
+        // 溢出缓存只在客户端接收慢的时候使用，写完之后释放内存
+        std::string().swap(overflow_);
+        overflow_pos_ = 0;
+      }
+    }
   }
 
   return rc;
 }
+
+ssize_t BufferedWriter::write_some(const char *buf, int32_t size)
+{
+  return ::write(fd_, buf, size);
+}
+
+ShmWriter::ShmWriter(int fd, common::ShmChannel *channel)
+  : BufferedWriter(fd), channel_(channel)
+{}
+
+ShmWriter::~ShmWriter()
+{
+  // 基类析构时已经不能调用到 write_some，在这里先把缓存写出去
+  close();
+}
+
+ssize_t ShmWriter::write_some(const char *buf, int32_t size)
+{
+  common::ShmRing &ring = channel_->response_ring();
+  while (true) {
+    const uint32_t write_size = ring.write(buf, static_cast<uint32_t>(size));
+    if (write_size > 0) {
+      if (ring.take_reader_waiting()) {
+        common::ShmChannel::notify(channel_->fd(common::SHM_CLIENT_EVENT_FD));
+      }
+      return write_size;
+    }
+
+    // 结果环满了，准备等待客户端读取。之前的唤醒已经没有用了，顺便发现客户端是否已经断开
+    if (common::ShmChannel::drain_doorbell(fd_) < 0) {
+      errno = EPIPE;
+      return -1;
+    }
+    if (ring.prepare_write_wait()) {
+      errno = EAGAIN;
+      return -1;
+    }
+  }
+}
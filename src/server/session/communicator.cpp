@@ -1,10 +1,14 @@
 #include "include/session/communicator.h"
 #include "include/session/plain_communicator.h"
 #include "include/session/cli_communicator.h"
+#include "include/session/binary_communicator.h"
 #include "include/session/buffered_writer.h"
 #include "include/session/session.h"
 
 #include "common/lang/mutex.h"
+#include "common/log/log.h"
+
+#include <chrono>
 
 RC Communicator::init(int fd, Session *session, const std::string &addr)
 {
@@ -15,6 +19,118 @@ RC Communicator::init(int fd, Session *session, const std::string &addr)
   return RC::SUCCESS;
 }
 
+RC Communicator::check_send_window(bool &full)
+{
+  full = false;
+  if (send_window_ <= 0 || writer_->pending() < send_window_) {
+    return RC::SUCCESS;
+  }
+
+  RC rc = writer_->flush();
+  if (RC_FAIL(rc)) {
+    return rc;
+  }
+  full = writer_->pending() >= send_window_;
+  return RC::SUCCESS;
+}
+
+bool Communicator::shm_has_data() const
+{
+  return shm_ != nullptr && shm_->request_ring().readable() > 0;
+}
+
+bool Communicator::wait_pending_data()
+{
+  if (has_pending_data()) {
+    return true;
+  }
+  if (shm_ == nullptr || shm_spin_us_ <= 0) {
+    return false;
+  }
+
+  const auto end = std::chrono::steady_clock::now() + std::chrono::microseconds(shm_spin_us_);
+  while (std::chrono::steady_clock::now() < end) {
+    if (shm_has_data()) {
+      return true;
+    }
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+  }
+  return false;
+}
+
+bool Communicator::prepare_wait_request()
+{
+  return shm_ != nullptr && !shm_->request_ring().prepare_read_wait();
+}
+
+ssize_t Communicator::recv_data(char *buf, int32_t size)
+{
+  if (shm_ == nullptr) {
+    return ::read(fd_, buf, size);
+  }
+
+  common::ShmRing &ring = shm_->request_ring();
+  while (true) {
+    const uint32_t read_size = ring.read(buf, static_cast<uint32_t>(size));
+    if (read_size > 0) {
+      if (ring.take_writer_waiting()) {
+        common::ShmChannel::notify(shm_->fd(common::SHM_CLIENT_EVENT_FD));
+      }
+      return read_size;
+    }
+
+    // 请求环为空，准备回到事件循环等待。读走之前的唤醒，客户端断开时套接字读到结尾
+    if (common::ShmChannel::drain_doorbell(fd_) < 0) {
+      return 0;
+    }
+    if (ring.prepare_read_wait()) {
+      errno = EAGAIN;
+      return -1;
+    }
+  }
+}
+
+RC Communicator::accept_shm_handshake()
+{
+  std::unique_ptr<common::ShmChannel> channel;
+  if (shm_ring_size_ > 0 && shm_ == nullptr && !has_pending_output()) {
+    channel = std::make_unique<common::ShmChannel>();
+    if (channel->create(shm_ring_size_) < 0) {
+      LOG_WARN("Failed to create shared memory channel for %s, %s", addr(), strerror(errno));
+      channel.reset();
+    }
+  }
+
+  if (channel == nullptr) {
+    const char reply = common::SHM_HANDSHAKE_REJECT;
+    if (common::send_fds(fd_, &reply, 1, nullptr, 0) < 0) {
+      LOG_WARN("Failed to reply shared memory handshake of %s, %s", addr(), strerror(errno));
+      return RC::IOERR_WRITE;
+    }
+    return RC::SUCCESS;
+  }
+
+  int fds[common::SHM_CHANNEL_FD_NUM];
+  for (int i = 0; i < common::SHM_CHANNEL_FD_NUM; i++) {
+    fds[i] = channel->fd(static_cast<common::ShmChannelFd>(i));
+  }
+  const char reply = common::SHM_HANDSHAKE_ACCEPT;
+  if (common::send_fds(fd_, &reply, 1, fds, common::SHM_CHANNEL_FD_NUM) < 0) {
+    LOG_WARN("Failed to send shared memory channel to %s, %s", addr(), strerror(errno));
+    return RC::IOERR_WRITE;
+  }
+
+  // 客户端收到应答之后才会写请求环，先设置等待标记，第一个请求到达时就会唤醒服务端
+  shm_ = std::move(channel);
+  shm_->request_ring().prepare_read_wait();
+  delete writer_;
+  writer_ = new ShmWriter(fd_, shm_.get());
+  LOG_INFO("Switch connection of %s to shared memory channel, ring size %u", addr(), shm_ring_size_);
+  return RC::SUCCESS;
+}
+
 Communicator::~Communicator()
 {
   if (fd_ >= 0) {
@@ -22,7 +138,8 @@ Communicator::~Communicator()
     fd_ = -1;
   }
   if (session_ != nullptr) {
-    delete session_;
+    // 会话重置之后放回会话池，下一个连接直接复用
+    SessionPool::instance().release(session_);
     session_ = nullptr;
   }
 
@@ -43,6 +160,9 @@ Communicator *CommunicatorFactory::create(CommunicateProtocol protocol)
     case CommunicateProtocol::CLI: {
       return new CliCommunicator;
     } break;
+    case CommunicateProtocol::BINARY: {
+      return new BinaryCommunicator;
+    } break;
     default: {
       return nullptr;
     }
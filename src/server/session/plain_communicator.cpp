@@ -5,68 +5,114 @@
 #include "common/io/io.h"
 #include "common/log/log.h"
 
-RC PlainCommunicator::read_event(SessionRequest *&event)
+static const int MAX_PACKET_SIZE = 65535 * 2;  ///< 一个消息的最大长度
+static const int RECV_BUFFER_SIZE = 8 * 1024;  ///< 每个连接接收数据的环形缓存大小
+
+RC PlainCommunicator::take_message(bool &complete)
 {
-  RC rc = RC::SUCCESS;
+  complete = false;
+  while (recv_buffer_.size() > 0) {
+    const char *buf = nullptr;
+    int32_t size = 0;
+    RC rc = recv_buffer_.buffer(buf, size);
+    if (RC_FAIL(rc)) {
+      return rc;
+    }
 
-  event = nullptr;
+    const char *end = static_cast<const char *>(memchr(buf, 0, size));
+    const int32_t data_size = (end == nullptr) ? size : static_cast<int32_t>(end - buf);
+    if (static_cast<int64_t>(message_.size()) + data_size >= MAX_PACKET_SIZE) {
+      LOG_WARN("The length of sql exceeds the limitation %d", MAX_PACKET_SIZE);
+      return RC::IOERR_TOO_LONG;
+    }
+    message_.append(buf, data_size);
 
-  int data_len = 0;
-  int read_len = 0;
+    // 结尾的'\0'也需要跳过
+    rc = recv_buffer_.forward(end == nullptr ? size : data_size + 1);
+    if (RC_FAIL(rc)) {
+      return rc;
+    }
+    if (end != nullptr) {
+      complete = true;
+      break;
+    }
+  }
+  return RC::SUCCESS;
+}
 
-  const int max_packet_size = 65535*2;
-  std::vector<char> buf(max_packet_size);
+RC PlainCommunicator::fill_buffer(bool &would_block)
+{
+  would_block = false;
+  char *buf = nullptr;
+  int32_t size = 0;
+  RC rc = recv_buffer_.write_buffer(buf, size);
+  if (RC_FAIL(rc)) {
+    return rc;
+  }
 
-  // 持续接收消息，直到遇到'\0'。将'\0'遇到的后续数据直接丢弃没有处理，因为目前仅支持一收一发的模式
   while (true) {
-    read_len = ::read(fd_, buf.data() + data_len, max_packet_size - data_len);
-    if (read_len < 0) {
-      if (errno == EAGAIN) {
-        continue;
-      }
-      break;
+    ssize_t read_len = recv_data(buf, size);
+    if (read_len > 0) {
+      return recv_buffer_.commit(static_cast<int32_t>(read_len));
     }
     if (read_len == 0) {
-      break;
+      LOG_INFO("The peer has been closed %s", addr());
+      return RC::IOERR_CLOSE;
     }
-
-    if (read_len + data_len > max_packet_size) {
-      data_len += read_len;
-      break;
+    if (errno == EINTR) {
+      continue;
     }
+    if (errno == EAGAIN || errno == EWOULDBLOCK) {
+      would_block = true;
+      return RC::SUCCESS;
+    }
+    LOG_ERROR("Failed to read socket of %s, %s", addr(), strerror(errno));
+    return RC::IOERR_READ;
+  }
+}
 
-    bool msg_end = false;
-    for (int i = 0; i < read_len; i++) {
-      if (buf[data_len + i] == 0) {
-        data_len += i + 1;
-        msg_end = true;
-        break;
-      }
+RC PlainCommunicator::read_event(SessionRequest *&event)
+{
+  event = nullptr;
+
+  // 先处理上一次留下来的数据，环形缓存空了再从套接字读取，直到得到完整的消息或者套接字暂时没有数据
+  while (true) {
+    bool complete = false;
+    RC rc = take_message(complete);
+    if (RC_FAIL(rc)) {
+      return rc;
     }
 
-    if (msg_end) {
-      break;
+    if (complete && message_ == common::SHM_HANDSHAKE_REQUEST) {
+      // 申请共享内存通道的请求由通讯层处理，不交给SQL线程
+      message_.clear();
+      return accept_shm_handshake();
     }
 
-    data_len += read_len;
-  }
+    if (complete) {
+      LOG_INFO_LIMITED(1000, "receive command(size=%d): %s", static_cast<int>(message_.size()), message_.c_str());
+      event = new SessionRequest(this);
+      event->set_query(message_);
+      if (message_.capacity() > RECV_BUFFER_SIZE) {
+        std::string().swap(message_);  // 很长的消息占用的空间不保留到下一个消息
+      } else {
+        message_.clear();  // 保留已经分配的空间给下一个消息使用
+      }
+      // 接收缓存为空时释放，空闲的连接不保留缓存
+      recv_buffer_.release();
+      return RC::SUCCESS;
+    }
 
-  if (data_len > max_packet_size) {
-    LOG_WARN("The length of sql exceeds the limitation %d", max_packet_size);
-    return RC::IOERR_TOO_LONG;
-  }
-  if (read_len == 0) {
-    LOG_INFO("The peer has been closed %s", addr());
-    return RC::IOERR_CLOSE;
-  } else if (read_len < 0) {
-    LOG_ERROR("Failed to read socket of %s, %s", addr(), strerror(errno));
-    return RC::IOERR_READ;
+    bool would_block = false;
+    rc = fill_buffer(would_block);
+    if (RC_FAIL(rc)) {
+      return rc;
+    }
+    if (would_block) {
+      recv_buffer_.release();
+      return RC::SUCCESS;
+    }
   }
-
-  LOG_INFO("receive command(size=%d): %s", data_len, buf.data());
-  event = new SessionRequest(this);
-  event->set_query(std::string(buf.data()));
-  return rc;
 }
 
 RC PlainCommunicator::write_state(SqlResult *sql_result, bool &need_disconnect)
@@ -84,7 +130,8 @@ RC PlainCommunicator::write_state(SqlResult *sql_result, bool &need_disconnect)
     snprintf(buf, buf_size, "%s > %s\n", strrc(sql_result->return_code()), state_string.c_str());
   }
 
-  RC rc = writer_->writen(buf, strlen(buf));
+  // 通过 write_result 写出，子类可以改变文本的封装方式
+  RC rc = write_result(buf, strlen(buf));
   if (RC_FAIL(rc)) {
     LOG_WARN("failed to send data to client. err=%s", strerror(errno));
     need_disconnect = true;
@@ -92,8 +139,7 @@ RC PlainCommunicator::write_state(SqlResult *sql_result, bool &need_disconnect)
     return RC::IOERR_WRITE;
   }
 
-  send_message_delimiter();
-
+  // 消息分隔符在整个请求处理完之后由 QueryEngine 统一发送
   need_disconnect = false;
   delete[] buf;
 
@@ -104,6 +150,6 @@ RC PlainCommunicator::write_result(const char *data, int32_t size)
 {
   return writer_->writen(data, size);
 }
-PlainCommunicator::PlainCommunicator() {
+PlainCommunicator::PlainCommunicator() : recv_buffer_(RECV_BUFFER_SIZE) {
   send_message_delimiter_.assign(1, '\0');
 }
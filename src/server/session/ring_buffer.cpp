@@ -12,7 +12,7 @@ RingBuffer::RingBuffer()
 {}
 
 RingBuffer::RingBuffer(int32_t size)
-    : buffer_(size)
+    : capacity_(size)
 {}
 
 RingBuffer::~RingBuffer()
@@ -84,6 +84,7 @@ RC RingBuffer::write(const char *data, int32_t size, int32_t &write_size)
 
   RC rc = RC::SUCCESS;
   write_size = 0;
+  allocate();
   while (RC_SUCC(rc) && write_size < size && this->remain() > 0) {
 
     const int32_t read_pos = this->read_pos();
@@ -98,3 +99,47 @@ RC RingBuffer::write(const char *data, int32_t size, int32_t &write_size)
 
   return rc;
 }
+
+RC RingBuffer::write_buffer(char *&buf, int32_t &size)
+{
+  allocate();
+  if (this->remain() == 0) {
+    buf = buffer_.data() + write_pos_;
+    size = 0;
+    return RC::SUCCESS;
+  }
+
+  const int32_t read_pos = this->read_pos();
+  if (this->size() > 0 && read_pos > write_pos_) {
+    size = read_pos - write_pos_;
+  } else {
+    size = capacity() - write_pos_;
+  }
+  buf = buffer_.data() + write_pos_;
+  return RC::SUCCESS;
+}
+
+RC RingBuffer::commit(int32_t size)
+{
+  if (size <= 0) {
+    return RC::INVALID_ARGUMENT;
+  }
+
+  if (size > this->remain()) {
+    LOG_DEBUG("commit size is too large.size=%d, remain=%d", size, this->remain());
+    return RC::INVALID_ARGUMENT;
+  }
+
+  write_pos_ = (write_pos_ + size) % capacity();
+  data_size_ += size;
+  return RC::SUCCESS;
+}
+
+void RingBuffer::release()
+{
+  if (data_size_ > 0) {
+    return;
+  }
+  std::vector<char>().swap(buffer_);
+  write_pos_ = 0;
+}
@@ -1,13 +1,25 @@
+#include <algorithm>
+#include <sys/resource.h>
+
 #include "include/session/server.h"
 #include "include/query_engine/query_engine.h"
 
 QueryEngine Server::query_engine_ = QueryEngine();
+Server *Server::instance_ = nullptr;
 
 ServerParam::ServerParam()
 {
   listen_addr = INADDR_ANY;
   max_connection_num = MAX_CONNECTION_NUM_DEFAULT;
   port = PORT_DEFAULT;
+  send_window_size = SEND_WINDOW_SIZE_DEFAULT;
+  reuse_port = false;
+  tcp_nodelay = true;
+  tcp_cork = false;
+  shm_transport = true;
+  shm_ring_size = SHM_RING_SIZE_DEFAULT;
+  shm_spin_us = SHM_SPIN_US_DEFAULT;
+  session_pool_size = SESSION_POOL_SIZE_DEFAULT;
 }
 
 Server::Server(ServerParam input_server_param) : server_param_(input_server_param)
@@ -46,6 +58,13 @@ void Server::close_connection(Communicator *communicator)
 {
   LOG_INFO("Close connection of %s.", communicator->addr());
   event_del(&communicator->read_event());
+  event_del(&communicator->write_event());
+  SessionRequest *paused_request = communicator->paused_request();
+  if (paused_request != nullptr) {
+    communicator->set_paused_request(nullptr);
+    query_engine_.cancel_session_request(paused_request);
+    delete paused_request;
+  }
   delete communicator;
 }
 
@@ -56,35 +75,276 @@ void Server::recv(int fd, short ev, void *arg)
   SessionRequest *event = nullptr;
   RC rc = comm->read_event(event);
   if (rc != RC::SUCCESS) {
-    close_connection(comm);
+    instance_->submit_close(comm);
     return;
   }
 
   if (event == nullptr) {
-    LOG_WARN("event is null while read event return success");
+    // 消息还不完整，等待下一次可读事件继续接收
+    add_read_event(comm);
     return;
   }
-  bool need_disconnect = query_engine_.process_session_request(event);
-  if(need_disconnect){
-    close_connection(comm);
+  instance_->submit_request(event);
+}
+
+void Server::send(int fd, short ev, void *arg)
+{
+  Communicator *comm = (Communicator *)arg;
+
+  RC rc = comm->flush();
+  SessionRequest *request = comm->paused_request();
+  if (request != nullptr) {
+    if (RC_SUCC(rc) && !comm->below_low_watermark()) {
+      add_write_event(comm);
+      return;
+    }
+    // 发送失败时也交给SQL线程，由它关闭结果集并断开连接
+    comm->set_paused_request(nullptr);
+    instance_->submit_request(request);
+    return;
+  }
+
+  if (RC_FAIL(rc)) {
+    instance_->submit_close(comm);
     return;
   }
+  if (comm->has_pending_output()) {
+    add_write_event(comm);
+    return;
+  }
+  // 结果都发送完了，接收下一个请求，缓存中可能已经有完整的请求
+  recv(fd, EV_READ, arg);
 }
 
-void Server::accept(int fd, short ev, void *arg)
+int Server::add_read_event(Communicator *comm)
+{
+  if (comm->prepare_wait_request()) {
+    // 共享内存通道中已经有请求了，直接触发读事件
+    event_active(&comm->read_event(), EV_READ, 0);
+    return 0;
+  }
+  int ret = event_add(&comm->read_event(), nullptr);
+  if (ret < 0) {
+    LOG_ERROR("Failed to event_add for read event of %s into libevent, %s", comm->addr(), strerror(errno));
+  }
+  return ret;
+}
+
+int Server::add_write_event(Communicator *comm)
 {
-  Server *instance = (Server *)arg;
-  struct sockaddr_in addr;
-  socklen_t addrlen = sizeof(addr);
+  // 切换到共享内存通道之后等待的是套接字可读，写事件不在等待中，可以直接重新设置
+  struct event *ev = &comm->write_event();
+  if ((event_get_events(ev) & (EV_READ | EV_WRITE)) != comm->write_events()) {
+    event_assign(ev, event_get_base(ev), comm->fd(), comm->write_events(), send, comm);
+  }
 
-  int ret = 0;
+  int ret = event_add(ev, nullptr);
+  if (ret < 0) {
+    LOG_ERROR("Failed to event_add for write event of %s into libevent, %s", comm->addr(), strerror(errno));
+  }
+  return ret;
+}
+
+void Server::submit_request(SessionRequest *request)
+{
+  // 每个连接最多只有一个请求在队列中，队列的容量不小于最大连接数，连接数超过时等待SQL线程取走请求
+  while (!request_queue_->push(request)) {
+    std::this_thread::yield();
+  }
+  request_ready_.release();
+}
+
+void Server::submit_close(Communicator *comm)
+{
+  // 连接上没有其它正在执行的请求，先停止事件，SQL线程关闭连接时不会再被IO线程使用
+  event_del(&comm->read_event());
+  event_del(&comm->write_event());
+  SessionRequest *request = new SessionRequest(comm);
+  request->set_close_request(true);
+  submit_request(request);
+}
+
+void Server::sql_thread_func()
+{
+  while (true) {
+    request_ready_.acquire();
+    SessionRequest *request = nullptr;
+    // 信号量保证有请求，生产者可能还没有写完槽位
+    while (!request_queue_->pop(request)) {
+      std::this_thread::yield();
+    }
+    if (request == nullptr) {
+      break;
+    }
 
-  int client_fd = ::accept(fd, (struct sockaddr *)&addr, &addrlen);
-  if (client_fd < 0) {
-    LOG_ERROR("Failed to accept client's connection, %s", strerror(errno));
+    handle_request(request);
+  }
+}
+
+void Server::handle_request(SessionRequest *request)
+{
+  Communicator *comm = request->get_communicator();
+  if (request->close_request()) {
+    delete request;
+    close_connection(comm);
     return;
   }
 
+  for (int handled = 1; ; handled++) {
+    set_cork(comm, true);
+    bool need_disconnect = request->paused() ? query_engine_.resume_session_request(request)
+                                             : query_engine_.process_session_request(request);
+    set_cork(comm, false);
+    if (request->paused()) {
+      // 发送窗口已满，等套接字可写之后再继续执行
+      comm->set_paused_request(request);
+      if (add_write_event(comm) < 0) {
+        close_connection(comm);
+      }
+      return;
+    }
+
+    // request 对象在 read_event 中创建，需要在这里释放
+    delete request;
+    if (need_disconnect) {
+      close_connection(comm);
+      return;
+    }
+
+    if (comm->has_pending_output()) {
+      // 结果还没有发送完，先不处理下一个请求，发送完之后由写事件接着接收
+      if (add_write_event(comm) < 0) {
+        close_connection(comm);
+      }
+      return;
+    }
+    if (!comm->wait_pending_data()) {
+      break;
+    }
+
+    // 客户端使用流水线时，缓存中可能已经有下一个请求，直接在当前线程处理，不需要再经过IO线程
+    request = nullptr;
+    RC rc = comm->read_event(request);
+    if (RC_FAIL(rc)) {
+      close_connection(comm);
+      return;
+    }
+    if (request == nullptr) {
+      break;
+    }
+    if (handled >= MAX_PIPELINED_REQUESTS) {
+      // 连续处理了很多请求，放回队列的末尾，让其它连接的请求先执行
+      submit_request(request);
+      return;
+    }
+  }
+
+  if (add_read_event(comm) < 0) {
+    close_connection(comm);
+  }
+}
+
+void Server::io_thread_func(struct event_base *base)
+{
+  // 连接都关闭时也不退出，等待新的连接分配过来
+  event_base_loop(base, EVLOOP_NO_EXIT_ON_EMPTY);
+}
+
+int Server::start_threads()
+{
+  int io_thread_num = server_param_.io_thread_num;
+  if (io_thread_num <= 0) {
+    io_thread_num = static_cast<int>(std::thread::hardware_concurrency());
+  }
+  io_thread_num = std::max(io_thread_num, 1);
+
+  int sql_thread_num = server_param_.sql_thread_num;
+  if (sql_thread_num <= 0) {
+    sql_thread_num = static_cast<int>(std::thread::hardware_concurrency());
+  }
+  sql_thread_num = std::max(sql_thread_num, 1);
+#ifndef CONCURRENCY
+  // 没有打开并发编译选项时存储层的锁都是空操作，只能使用一个SQL线程串行执行请求
+  if (sql_thread_num > 1) {
+    LOG_WARN("concurrency is disabled(build with -DCONCURRENCY=ON to enable it), "
+             "use 1 sql thread instead of %d",
+        sql_thread_num);
+    sql_thread_num = 1;
+  }
+#endif
+
+  request_queue_ = std::make_unique<MpmcQueue<SessionRequest *>>(
+      std::max(server_param_.max_connection_num, sql_thread_num) + sql_thread_num);
+
+  for (int i = 0; i < io_thread_num; i++) {
+    struct event_base *base = event_base_new();
+    if (base == nullptr) {
+      LOG_ERROR("Failed to create event base of io thread, %s.", strerror(errno));
+      return -1;
+    }
+    io_bases_.push_back(base);
+  }
+  for (struct event_base *base : io_bases_) {
+    io_threads_.emplace_back(&Server::io_thread_func, this, base);
+  }
+  for (int i = 0; i < sql_thread_num; i++) {
+    sql_threads_.emplace_back(&Server::sql_thread_func, this);
+  }
+  LOG_INFO("server start with %d io threads and %d sql threads", io_thread_num, sql_thread_num);
+  return 0;
+}
+
+void Server::stop_threads()
+{
+  for (struct event_base *base : io_bases_) {
+    event_base_loopexit(base, nullptr);
+  }
+  for (std::thread &thread : io_threads_) {
+    thread.join();
+  }
+  io_threads_.clear();
+
+  // 每个SQL线程取到一个空请求后退出，之前的请求会先执行完
+  for (size_t i = 0; i < sql_threads_.size(); i++) {
+    submit_request(nullptr);
+  }
+  for (std::thread &thread : sql_threads_) {
+    thread.join();
+  }
+  sql_threads_.clear();
+
+  for (struct event_base *base : io_bases_) {
+    event_base_free(base);
+  }
+  io_bases_.clear();
+}
+
+void Server::accept(int fd, short ev, void *arg)
+{
+  Listener *listener = (Listener *)arg;
+
+  // 大量连接同时到达时，一次事件把已经完成握手的连接都接收下来
+  for (int i = 0; i < MAX_ACCEPT_PER_EVENT; i++) {
+    struct sockaddr_in addr;
+    socklen_t addrlen = sizeof(addr);
+    int client_fd = ::accept(fd, (struct sockaddr *)&addr, &addrlen);
+    if (client_fd < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno != EAGAIN && errno != EWOULDBLOCK) {
+        LOG_ERROR("Failed to accept client's connection, %s", strerror(errno));
+      }
+      return;
+    }
+    listener->server->init_connection(client_fd, addr, listener->io_base);
+  }
+}
+
+void Server::init_connection(int client_fd, const struct sockaddr_in &addr, struct event_base *io_base)
+{
+  int ret = 0;
+
   char ip_addr[24];
   if (inet_ntop(AF_INET, &addr.sin_addr, ip_addr, sizeof(ip_addr)) == nullptr) {
     LOG_ERROR("Failed to get ip address of client, %s", strerror(errno));
@@ -95,14 +355,14 @@ void Server::accept(int fd, short ev, void *arg)
   address << ip_addr << ":" << addr.sin_port;
   std::string addr_str = address.str();
 
-  ret = instance->set_non_block(client_fd);
+  ret = set_non_block(client_fd);
   if (ret < 0) {
     LOG_ERROR("Failed to set socket of %s as non blocking, %s", addr_str.c_str(), strerror(errno));
     ::close(client_fd);
     return;
   }
 
-  if (!instance->server_param_.use_unix_socket) {
+  if (!server_param_.use_unix_socket && server_param_.tcp_nodelay) {
     // unix socket不支持设置NODELAY
     int yes = 1;
     ret = setsockopt(client_fd, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
@@ -113,23 +373,38 @@ void Server::accept(int fd, short ev, void *arg)
     }
   }
 
-  Communicator *communicator = instance->communicator_factory_.create(instance->server_param_.protocol);
-  RC rc = communicator->init(client_fd, new Session(Session::default_session()), addr_str);
+  Communicator *communicator = communicator_factory_.create(server_param_.protocol);
+  RC rc = communicator->init(client_fd, SessionPool::instance().acquire(), addr_str);
   if (rc != RC::SUCCESS) {
     LOG_WARN("failed to init communicator. rc=%s", strrc(rc));
     delete communicator;
     return;
   }
 
-  event_set(&communicator->read_event(), client_fd, EV_READ | EV_PERSIST, recv, communicator);
+  // 读事件不是持久的，请求处理完之后再重新注册
+  if (io_base == nullptr) {
+    io_base = io_bases_[next_io_++ % io_bases_.size()];
+  }
+  ret = event_assign(&communicator->read_event(), io_base, client_fd, EV_READ, recv, communicator);
+  if (ret < 0) {
+    LOG_ERROR("Failed to do event_assign for read event of %s into libevent, %s", 
+              communicator->addr(), strerror(errno));
+    delete communicator;
+    return;
+  }
 
-  ret = event_base_set(instance->event_base_, &communicator->read_event());
+  ret = event_assign(&communicator->write_event(), io_base, client_fd, EV_WRITE, send, communicator);
   if (ret < 0) {
-    LOG_ERROR("Failed to do event_base_set for read event of %s into libevent, %s", 
+    LOG_ERROR("Failed to do event_assign for write event of %s into libevent, %s",
               communicator->addr(), strerror(errno));
     delete communicator;
     return;
   }
+  communicator->set_send_window(server_param_.send_window_size);
+  if (server_param_.use_unix_socket && server_param_.shm_transport && server_param_.shm_ring_size > 0) {
+    communicator->enable_shm(static_cast<uint32_t>(server_param_.shm_ring_size),
+        common::ShmChannel::effective_spin_us(server_param_.shm_spin_us));
+  }
 
   ret = event_add(&communicator->read_event(), nullptr);
   if (ret < 0) {
@@ -141,8 +416,43 @@ void Server::accept(int fd, short ev, void *arg)
   LOG_INFO("Accepted connection from %s\n", communicator->addr());
 }
 
+void Server::set_cork(Communicator *comm, bool cork)
+{
+#ifdef TCP_CORK
+  if (!server_param_.tcp_cork || server_param_.use_unix_socket) {
+    return;
+  }
+  int value = cork ? 1 : 0;
+  if (setsockopt(comm->fd(), IPPROTO_TCP, TCP_CORK, &value, sizeof(value)) < 0) {
+    LOG_WARN("Failed to set TCP_CORK=%d of %s, %s", value, comm->addr(), strerror(errno));
+  }
+#endif
+}
+
+void Server::raise_open_files_limit()
+{
+  struct rlimit limit;
+  if (getrlimit(RLIMIT_NOFILE, &limit) < 0) {
+    LOG_WARN("Failed to get limit of open files, %s", strerror(errno));
+    return;
+  }
+  if (limit.rlim_cur < limit.rlim_max) {
+    limit.rlim_cur = limit.rlim_max;
+    if (setrlimit(RLIMIT_NOFILE, &limit) < 0) {
+      LOG_WARN("Failed to raise limit of open files to %lu, %s", (unsigned long)limit.rlim_max, strerror(errno));
+      getrlimit(RLIMIT_NOFILE, &limit);
+    }
+  }
+  LOG_INFO("limit of open files is %lu", (unsigned long)limit.rlim_cur);
+  if (limit.rlim_cur != RLIM_INFINITY && (rlim_t)server_param_.max_connection_num > limit.rlim_cur) {
+    LOG_WARN("max connection num %d is larger than the limit of open files %lu",
+        server_param_.max_connection_num, (unsigned long)limit.rlim_cur);
+  }
+}
+
 int Server::start()
 {
+  SessionPool::instance().set_capacity(server_param_.session_pool_size);
   if (server_param_.use_std_io) {
     return start_stdin_server();
   } else if (server_param_.use_unix_socket) {
@@ -152,31 +462,40 @@ int Server::start()
   }
 }
 
-int Server::start_tcp_server()
+int Server::create_tcp_socket()
 {
   int ret = 0;
   struct sockaddr_in sa;
 
-  server_socket_ = socket(AF_INET, SOCK_STREAM, 0);
-  if (server_socket_ < 0) {
+  int server_socket = socket(AF_INET, SOCK_STREAM, 0);
+  if (server_socket < 0) {
     LOG_ERROR("socket(): can not create server socket: %s.", strerror(errno));
     return -1;
   }
 
   int yes = 1;
   int recvBufferSize = 65535*2;
-  ret = setsockopt(server_socket_, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
-  ret = setsockopt(server_socket_, SOL_SOCKET, SO_RCVBUF, &recvBufferSize, sizeof(recvBufferSize));
+  ret = setsockopt(server_socket, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+  ret = setsockopt(server_socket, SOL_SOCKET, SO_RCVBUF, &recvBufferSize, sizeof(recvBufferSize));
   if (ret < 0) {
     LOG_ERROR("Failed to set socket option of reuse address: %s.", strerror(errno));
-    ::close(server_socket_);
+    ::close(server_socket);
     return -1;
   }
 
-  ret = set_non_block(server_socket_);
+  if (server_param_.reuse_port) {
+    ret = setsockopt(server_socket, SOL_SOCKET, SO_REUSEPORT, &yes, sizeof(yes));
+    if (ret < 0) {
+      LOG_ERROR("Failed to set socket option of reuse port: %s.", strerror(errno));
+      ::close(server_socket);
+      return -1;
+    }
+  }
+
+  ret = set_non_block(server_socket);
   if (ret < 0) {
     LOG_ERROR("Failed to set socket option non-blocking:%s. ", strerror(errno));
-    ::close(server_socket_);
+    ::close(server_socket);
     return -1;
   }
 
@@ -185,34 +504,73 @@ int Server::start_tcp_server()
   sa.sin_port = htons(server_param_.port);
   sa.sin_addr.s_addr = htonl(server_param_.listen_addr);
 
-  ret = ::bind(server_socket_, (struct sockaddr *)&sa, sizeof(sa));
+  ret = ::bind(server_socket, (struct sockaddr *)&sa, sizeof(sa));
   if (ret < 0) {
     LOG_ERROR("bind(): can not bind server socket, %s", strerror(errno));
-    ::close(server_socket_);
+    ::close(server_socket);
     return -1;
   }
 
-  ret = listen(server_socket_, server_param_.max_connection_num);
+  ret = listen(server_socket, server_param_.max_connection_num);
   if (ret < 0) {
     LOG_ERROR("listen(): can not listen server socket, %s", strerror(errno));
-    ::close(server_socket_);
+    ::close(server_socket);
     return -1;
   }
-  LOG_INFO("Listen on port %d", server_param_.port);
+  return server_socket;
+}
 
-  listen_ev_ = event_new(event_base_, server_socket_, EV_READ | EV_PERSIST, accept, this);
-  if (listen_ev_ == nullptr) {
+int Server::add_listener(int fd, struct event_base *base, struct event_base *io_base)
+{
+  auto listener = std::make_unique<Listener>();
+  listener->server  = this;
+  listener->fd      = fd;
+  listener->io_base = io_base;
+  listener->ev      = event_new(base, fd, EV_READ | EV_PERSIST, accept, listener.get());
+  if (listener->ev == nullptr) {
     LOG_ERROR("Failed to create listen event, %s.", strerror(errno));
-    ::close(server_socket_);
+    ::close(fd);
     return -1;
   }
 
-  ret = event_add(listen_ev_, nullptr);
+  int ret = event_add(listener->ev, nullptr);
   if (ret < 0) {
     LOG_ERROR("event_add(): can not add accept event into libevent, %s", strerror(errno));
-    ::close(server_socket_);
+    event_free(listener->ev);
+    ::close(fd);
     return -1;
   }
+  listeners_.push_back(std::move(listener));
+  return 0;
+}
+
+void Server::close_listeners()
+{
+  for (std::unique_ptr<Listener> &listener : listeners_) {
+    event_del(listener->ev);
+    event_free(listener->ev);
+    ::close(listener->fd);
+  }
+  listeners_.clear();
+}
+
+int Server::start_tcp_server()
+{
+  // 打开 REUSE_PORT 时每个IO线程各自监听，连接直接由内核分配到IO线程上
+  const size_t listener_num = server_param_.reuse_port ? io_bases_.size() : 1;
+  for (size_t i = 0; i < listener_num; i++) {
+    int server_socket = create_tcp_socket();
+    if (server_socket < 0) {
+      return -1;
+    }
+
+    int ret = server_param_.reuse_port ? add_listener(server_socket, io_bases_[i], io_bases_[i])
+                                       : add_listener(server_socket, event_base_, nullptr);
+    if (ret < 0) {
+      return -1;
+    }
+  }
+  LOG_INFO("Listen on port %d with %d listeners", server_param_.port, static_cast<int>(listener_num));
 
   started_ = true;
   LOG_INFO("TDB server start success");
@@ -223,16 +581,16 @@ int Server::start_tcp_server()
 int Server::start_unix_socket_server()
 {
   int ret = 0;
-  server_socket_ = socket(PF_UNIX, SOCK_STREAM, 0);
-  if (server_socket_ < 0) {
+  int server_socket = socket(PF_UNIX, SOCK_STREAM, 0);
+  if (server_socket < 0) {
     LOG_ERROR("socket(): can not create unix socket: %s.", strerror(errno));
     return -1;
   }
 
-  ret = set_non_block(server_socket_);
+  ret = set_non_block(server_socket);
   if (ret < 0) {
     LOG_ERROR("Failed to set socket option non-blocking:%s. ", strerror(errno));
-    ::close(server_socket_);
+    ::close(server_socket);
     return -1;
   }
 
@@ -243,32 +601,22 @@ int Server::start_unix_socket_server()
   sockaddr.sun_family = PF_UNIX;
   snprintf(sockaddr.sun_path, sizeof(sockaddr.sun_path), "%s", server_param_.unix_socket_path.c_str());
 
-  ret = ::bind(server_socket_, (struct sockaddr *)&sockaddr, sizeof(sockaddr));
+  ret = ::bind(server_socket, (struct sockaddr *)&sockaddr, sizeof(sockaddr));
   if (ret < 0) {
     LOG_ERROR("bind(): can not bind server socket(path=%s), %s", sockaddr.sun_path, strerror(errno));
-    ::close(server_socket_);
+    ::close(server_socket);
     return -1;
   }
 
-  ret = listen(server_socket_, server_param_.max_connection_num);
+  ret = listen(server_socket, server_param_.max_connection_num);
   if (ret < 0) {
     LOG_ERROR("listen(): can not listen server socket, %s", strerror(errno));
-    ::close(server_socket_);
+    ::close(server_socket);
     return -1;
   }
   LOG_INFO("Listen on unix socket: %s", sockaddr.sun_path);
 
-  listen_ev_ = event_new(event_base_, server_socket_, EV_READ | EV_PERSIST, accept, this);
-  if (listen_ev_ == nullptr) {
-    LOG_ERROR("Failed to create listen event, %s.", strerror(errno));
-    ::close(server_socket_);
-    return -1;
-  }
-
-  ret = event_add(listen_ev_, nullptr);
-  if (ret < 0) {
-    LOG_ERROR("event_add(): can not add accept event into libevent, %s", strerror(errno));
-    ::close(server_socket_);
+  if (add_listener(server_socket, event_base_, nullptr) < 0) {
     return -1;
   }
 
@@ -280,7 +628,7 @@ int Server::start_unix_socket_server()
 int Server::start_stdin_server()
 {
   Communicator *communicator = communicator_factory_.create(server_param_.protocol);
-  RC rc = communicator->init(STDIN_FILENO, new Session(Session::default_session()), "stdin");
+  RC rc = communicator->init(STDIN_FILENO, SessionPool::instance().acquire(), "stdin");
   if (RC_FAIL(rc)) {
     LOG_WARN("failed to init cli communicator. rc=%s", strrc(rc));
     return -1;
@@ -326,6 +674,16 @@ int Server::serve()
     exit(-1);
   }
 
+  // IO线程先启动，每个IO线程监听端口时需要它们的event_base
+  if (!server_param_.use_std_io) {
+    raise_open_files_limit();
+    instance_ = this;
+    if (start_threads() < 0) {
+      LOG_PANIC("Failed to start io threads and sql threads");
+      exit(-1);
+    }
+  }
+
   int retval = start();
   if (retval == -1) {
     LOG_PANIC("Failed to start network");
@@ -333,13 +691,11 @@ int Server::serve()
   }
 
   if (!server_param_.use_std_io) {
-    event_base_dispatch(event_base_);
-  }
-
-  if (listen_ev_ != nullptr) {
-    event_del(listen_ev_);
-    event_free(listen_ev_);
-    listen_ev_ = nullptr;
+    // 监听套接字都在IO线程上时主线程没有事件，只等待退出
+    event_base_loop(event_base_, EVLOOP_NO_EXIT_ON_EMPTY);
+    close_listeners();
+    stop_threads();
+    instance_ = nullptr;
   }
 
   if (event_base_ != nullptr) {
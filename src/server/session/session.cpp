@@ -3,6 +3,9 @@
 #include "include/storage_engine/schema/database.h"
 #include "include/storage_engine/schema/default_handler.h"
 #include "include/common/global_context.h"
+#include "include/query_engine/planner/plan_cache.h"
+
+#include <algorithm>
 
 Session &Session::default_session()
 {
@@ -13,6 +16,8 @@ Session &Session::default_session()
 Session::Session(const Session &other) : db_(other.db_)
 {}
 
+Session::Session() = default;
+
 Session::~Session()
 {
   if (nullptr != trx_) {
@@ -65,6 +70,32 @@ Trx *Session::current_trx()
   return trx_;
 }
 
+RC Session::reset()
+{
+  RC rc = RC::SUCCESS;
+  if (trx_ != nullptr) {
+    if (trx_multi_operation_mode_) {
+      rc = trx_->rollback();
+      if (rc != RC::SUCCESS) {
+        LOG_WARN("failed to rollback transaction while resetting session. rc=%s", strrc(rc));
+      }
+    }
+    GCTX.trx_manager_->destroy_trx(trx_);
+    trx_ = nullptr;
+  }
+  trx_multi_operation_mode_ = false;
+
+  const Session &defaults = default_session();
+  if (plan_cache_ != nullptr && db_ != defaults.db_) {
+    plan_cache_->clear();
+  }
+  db_ = defaults.db_;
+  sql_debug_ = defaults.sql_debug_;
+  current_request_ = nullptr;
+  prepared_stmts_.clear();
+  return rc;
+}
+
 thread_local Session *thread_session = nullptr;
 
 void Session::set_current_session(Session *session)
@@ -86,3 +117,95 @@ SessionRequest *Session::current_request() const
 {
   return current_request_;
 }
+
+void Session::add_prepared_stmt(const std::string &name, std::shared_ptr<const CachedPlan> plan)
+{
+  prepared_stmts_[name] = std::move(plan);
+}
+
+std::shared_ptr<const CachedPlan> Session::find_prepared_stmt(const std::string &name) const
+{
+  auto iter = prepared_stmts_.find(name);
+  return iter == prepared_stmts_.end() ? nullptr : iter->second;
+}
+
+bool Session::remove_prepared_stmt(const std::string &name)
+{
+  return prepared_stmts_.erase(name) > 0;
+}
+
+PlanCache &Session::plan_cache()
+{
+  if (plan_cache_ == nullptr) {
+    plan_cache_ = std::make_unique<PlanCache>(SESSION_PLAN_CACHE_CAPACITY);
+  }
+  return *plan_cache_;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+SessionPool &SessionPool::instance()
+{
+  static SessionPool pool;
+  return pool;
+}
+
+SessionPool::~SessionPool()
+{
+  for (Session *session : idle_sessions_) {
+    delete session;
+  }
+  idle_sessions_.clear();
+}
+
+void SessionPool::set_capacity(int capacity)
+{
+  std::vector<Session *> evicted;
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    capacity_ = static_cast<size_t>(std::max(capacity, 0));
+    while (idle_sessions_.size() > capacity_) {
+      evicted.push_back(idle_sessions_.back());
+      idle_sessions_.pop_back();
+    }
+  }
+  for (Session *session : evicted) {
+    delete session;
+  }
+}
+
+Session *SessionPool::acquire()
+{
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (!idle_sessions_.empty()) {
+      Session *session = idle_sessions_.back();
+      idle_sessions_.pop_back();
+      return session;
+    }
+  }
+  return new Session(Session::default_session());
+}
+
+void SessionPool::release(Session *session)
+{
+  if (session == nullptr) {
+    return;
+  }
+
+  // 多语句事务没有结束时不在这里回滚，与之前一样直接释放
+  if (!session->is_trx_multi_operation_mode() && RC_SUCC(session->reset())) {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (idle_sessions_.size() < capacity_) {
+      idle_sessions_.push_back(session);
+      return;
+    }
+  }
+  delete session;
+}
+
+size_t SessionPool::idle_size()
+{
+  std::lock_guard<std::mutex> guard(lock_);
+  return idle_sessions_.size();
+}
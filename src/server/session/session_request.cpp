@@ -1,5 +1,8 @@
 #include "include/session/session_request.h"
 #include "include/session/communicator.h"
+#include "include/query_engine/structor/query_info.h"
+
+RequestProgress::~RequestProgress() = default;
 
 SessionRequest::SessionRequest(Communicator *comm)
     : communicator_(comm),
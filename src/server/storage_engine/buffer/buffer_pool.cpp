@@ -1,4 +1,5 @@
 #include "include/storage_engine/buffer/buffer_pool.h"
+#include "include/common/query_stats.h"
 
 using namespace common;
 using namespace std;
@@ -103,10 +104,14 @@ RC FileBufferPool::get_this_page(PageNum page_num, Frame **frame)
   RC rc = RC::SUCCESS;
   *frame = nullptr;
 
+  QueryStats *stats = QueryStats::current();
   Frame *used_match_frame = frame_manager_.get(file_desc_, page_num);
   if (used_match_frame != nullptr) {
     used_match_frame->access();
     *frame = used_match_frame;
+    if (stats != nullptr) {
+      stats->pages_hit.fetch_add(1, std::memory_order_relaxed);
+    }
     return RC::SUCCESS;
   }
 
@@ -130,6 +135,9 @@ RC FileBufferPool::get_this_page(PageNum page_num, Frame **frame)
     return rc;
   }
 
+  if (stats != nullptr) {
+    stats->pages_read.fetch_add(1, std::memory_order_relaxed);
+  }
   *frame = allocated_frame;
   return RC::SUCCESS;
 }
@@ -234,6 +242,9 @@ RC FileBufferPool::flush_page_internal(Frame &frame)
 
   frame.clear_dirty();
 
+  if (QueryStats *stats = QueryStats::current()) {
+    stats->pages_written.fetch_add(1, std::memory_order_relaxed);
+  }
   return RC::SUCCESS;
 }
 
@@ -396,6 +407,7 @@ BufferPoolIterator::~BufferPoolIterator()
 RC BufferPoolIterator::init(FileBufferPool &bp, PageNum start_page /* = 0 */)
 {
   bitmap_.init(bp.file_header_->bitmap, bp.file_header_->page_count);
+  end_page_num_ = -1;
   if (start_page <= 0) {
     current_page_num_ = 0;
   } else {
@@ -404,14 +416,25 @@ RC BufferPoolIterator::init(FileBufferPool &bp, PageNum start_page /* = 0 */)
   return RC::SUCCESS;
 }
 
+RC BufferPoolIterator::init(FileBufferPool &bp, PageNum start_page, PageNum end_page)
+{
+  RC rc = init(bp, start_page);
+  end_page_num_ = end_page;
+  return rc;
+}
+
 bool BufferPoolIterator::has_next()
 {
-  return bitmap_.next_setted_bit(current_page_num_ + 1) != -1;
+  PageNum next_page = bitmap_.next_setted_bit(current_page_num_ + 1);
+  return next_page != -1 && (end_page_num_ < 0 || next_page < end_page_num_);
 }
 
 PageNum BufferPoolIterator::next()
 {
   PageNum next_page = bitmap_.next_setted_bit(current_page_num_ + 1);
+  if (end_page_num_ >= 0 && next_page >= end_page_num_) {
+    next_page = -1;
+  }
   if (next_page != -1) {
     current_page_num_ = next_page;
   }
@@ -0,0 +1,176 @@
+#include "include/storage_engine/index/bloom_filter.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/lang/bitmap.h"
+#include "common/log/log.h"
+#include "include/storage_engine/recorder/table_meta.h"
+
+namespace {
+
+constexpr int WORDS_PER_BLOCK = BloomFilter::BLOCK_SIZE / sizeof(uint64_t);
+
+/// 每个字中选择一位使用的乘数，取自 Parquet 的 split block bloom filter
+constexpr uint32_t SALT[WORDS_PER_BLOCK] = {
+    0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU, 0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+/// 高32位选择块，低32位选择块中的位
+inline int block_of(uint64_t hash, int block_num)
+{
+  return static_cast<int>(((hash >> 32) * static_cast<uint64_t>(block_num)) >> 32);
+}
+
+inline uint64_t bit_of(uint64_t hash, int word)
+{
+  const uint32_t h = static_cast<uint32_t>(hash) * SALT[word];
+  return 1ULL << (h >> 26);
+}
+
+uint64_t fmix64(uint64_t h)
+{
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return h;
+}
+
+/// FNV-1a，最后再做一次 murmur 的 finalizer
+class Hasher
+{
+public:
+  void feed(const void *data, size_t len)
+  {
+    const unsigned char *bytes = static_cast<const unsigned char *>(data);
+    for (size_t i = 0; i < len; i++) {
+      h_ ^= bytes[i];
+      h_ *= 0x100000001b3ULL;
+    }
+  }
+
+  /// 字符串后面带上长度，多个字段拼接时不会混淆
+  void feed_string(const char *data, size_t len)
+  {
+    feed(data, len);
+    const uint32_t length = static_cast<uint32_t>(len);
+    feed(&length, sizeof(length));
+  }
+
+  uint64_t result() const { return fmix64(h_); }
+
+private:
+  uint64_t h_ = 0xcbf29ce484222325ULL;
+};
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+void BloomFilter::init(int expected_keys)
+{
+  const int64_t bits = static_cast<int64_t>(std::max(expected_keys, 1)) * BITS_PER_KEY;
+  block_num_ = static_cast<int>((bits + BLOCK_SIZE * 8 - 1) / (BLOCK_SIZE * 8));
+  words_.assign(static_cast<size_t>(block_num_) * WORDS_PER_BLOCK, 0);
+}
+
+void BloomFilter::insert(uint64_t hash)
+{
+  insert(reinterpret_cast<char *>(words_.data()), block_num_, hash);
+}
+
+bool BloomFilter::may_contain(uint64_t hash) const
+{
+  return may_contain(reinterpret_cast<const char *>(words_.data()), block_num_, hash);
+}
+
+void BloomFilter::insert(char *blocks, int block_num, uint64_t hash)
+{
+  // 页面中的数据不保证按8字节对齐，使用 memcpy 读写
+  char *block = blocks + block_of(hash, block_num) * BLOCK_SIZE;
+  for (int i = 0; i < WORDS_PER_BLOCK; i++) {
+    uint64_t word;
+    memcpy(&word, block + i * sizeof(word), sizeof(word));
+    word |= bit_of(hash, i);
+    memcpy(block + i * sizeof(word), &word, sizeof(word));
+  }
+}
+
+bool BloomFilter::may_contain(const char *blocks, int block_num, uint64_t hash)
+{
+  const char *block = blocks + block_of(hash, block_num) * BLOCK_SIZE;
+  for (int i = 0; i < WORDS_PER_BLOCK; i++) {
+    uint64_t word;
+    memcpy(&word, block + i * sizeof(word), sizeof(word));
+    if ((word & bit_of(hash, i)) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool BloomKey::support_type(AttrType type)
+{
+  return type == INTS || type == DATES || type == BOOLEANS || type == CHARS;
+}
+
+RC BloomKey::init(const TableMeta &table_meta, const std::vector<int> &field_indexes)
+{
+  field_indexes_ = field_indexes;
+  columns_.clear();
+  null_bitmap_offset_ = table_meta.null_bitmap_field()->offset();
+  null_bitmap_len_ = table_meta.null_bitmap_field()->len();
+  for (int field_index : field_indexes) {
+    const FieldMeta *field = table_meta.field(field_index);
+    if (field == nullptr || !support_type(field->type())) {
+      LOG_WARN("unsupported field of bloom filter key. table=%s, field index=%d", table_meta.name(), field_index);
+      return RC::INVALID_ARGUMENT;
+    }
+    columns_.push_back(Column{field_index, field->type(), field->offset(), field->len(), field->nullable()});
+  }
+  return RC::SUCCESS;
+}
+
+bool BloomKey::hash_record(const char *record, uint64_t &hash) const
+{
+  common::Bitmap null_bitmap(const_cast<char *>(record) + null_bitmap_offset_, null_bitmap_len_);
+  Hasher hasher;
+  for (const Column &column : columns_) {
+    if (column.nullable && null_bitmap.get_bit(column.field_index)) {
+      return false;
+    }
+    const char *data = record + column.offset;
+    if (column.type == CHARS) {
+      // 字段中字符串后面的部分清零，只有字段写满时没有结尾的0
+      hasher.feed_string(data, strnlen(data, column.len));
+    } else {
+      hasher.feed(data, sizeof(int));
+    }
+  }
+  hash = hasher.result();
+  return true;
+}
+
+bool BloomKey::hash_values(const Value *values, uint64_t &hash) const
+{
+  Hasher hasher;
+  for (size_t i = 0; i < columns_.size(); i++) {
+    const Value &value = values[i];
+    if (value.is_null() || value.attr_type() != columns_[i].type) {
+      return false;
+    }
+    if (value.attr_type() == CHARS) {
+      // 比字段长的字符串不可能与记录中的值相等，得到的哈希一般不会命中，正好可以排除
+      const std::string s = value.get_string();
+      hasher.feed_string(s.data(), s.size());
+    } else {
+      const int v = value.get_int();
+      hasher.feed(&v, sizeof(v));
+    }
+  }
+  hash = hasher.result();
+  return true;
+}
@@ -0,0 +1,346 @@
+#include "include/storage_engine/index/bloom_filter_index.h"
+
+#include <algorithm>
+#include <mutex>
+
+#include "include/storage_engine/recorder/zone_map.h"
+
+namespace {
+
+/// 一个过滤器页面中的块数
+constexpr int FILTER_BLOCK_NUM = BP_PAGE_DATA_SIZE / BloomFilter::BLOCK_SIZE;
+
+/// 一组页面最多有多少个，记录很大时也不让一个分组覆盖太多的数据
+constexpr int MAX_PAGES_PER_GROUP = 64;
+
+/// 一次查找的键的个数上限，IN 列表太长时逐个检查过滤器得不偿失
+constexpr size_t MAX_PROBE_KEYS = 64;
+
+/// 按照记录的大小估计一组页面的个数，让每个过滤器中大约有 BITS_PER_KEY 位对应一个键
+int calc_pages_per_group(int record_size)
+{
+  const int records_per_page = std::max(1, (BP_PAGE_DATA_SIZE * 8) / (record_size * 8 + 1));
+  const int keys_per_filter = FILTER_BLOCK_NUM * BloomFilter::BLOCK_SIZE * 8 / BloomFilter::BITS_PER_KEY;
+  return std::min(std::max(1, keys_per_filter / records_per_page), MAX_PAGES_PER_GROUP);
+}
+
+/// 单个等值条件或者由同一个字段的等值条件组成的 OR(IN 列表转换得到)
+bool equal_values(const ZonePredicate &predicate, int &field_index, std::vector<Value> &values)
+{
+  if (predicate.kind == ZonePredicate::Kind::COMPARE) {
+    if (predicate.comp != EQUAL_TO) {
+      return false;
+    }
+    field_index = predicate.field_index;
+    values.assign(1, predicate.value);
+    return true;
+  }
+  if (predicate.kind != ZonePredicate::Kind::OR || predicate.children.empty()) {
+    return false;
+  }
+  values.clear();
+  field_index = predicate.children.front().field_index;
+  for (const ZonePredicate &child : predicate.children) {
+    if (child.kind != ZonePredicate::Kind::COMPARE || child.comp != EQUAL_TO || child.field_index != field_index) {
+      return false;
+    }
+    values.push_back(child.value);
+  }
+  return true;
+}
+
+}  // namespace
+
+BloomFilterIndex::~BloomFilterIndex() noexcept
+{
+  close();
+}
+
+RC BloomFilterIndex::create(
+    const char *file_name, const IndexMeta &index_meta, const std::vector<FieldMeta> &multi_field_metas)
+{
+  if (file_buffer_pool_ != nullptr) {
+    LOG_WARN("Failed to create index due to the index has been inited before. file_name:%s, index:%s",
+             file_name, index_meta.name());
+    return RC::RECORD_OPENNED;
+  }
+
+  Index::init(index_meta, multi_field_metas);
+  RC rc = init_key(index_meta, multi_field_metas);
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+
+  BufferPoolManager &bpm = BufferPoolManager::instance();
+  rc = bpm.create_file(file_name);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("Failed to create file. file name=%s, rc=%d:%s", file_name, rc, strrc(rc));
+    return rc;
+  }
+
+  FileBufferPool *bp = nullptr;
+  rc = bpm.open_file(file_name, bp);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("Failed to open file. file name=%s, rc=%d:%s", file_name, rc, strrc(rc));
+    return rc;
+  }
+
+  Frame *header_frame = nullptr;
+  rc = bp->allocate_page(&header_frame);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to allocate header page for bloom filter index. rc=%d:%s", rc, strrc(rc));
+    bpm.close_file(file_name);
+    return rc;
+  }
+  if (header_frame->page_num() != HEADER_PAGE) {
+    LOG_WARN("header page num should be %d but got %d. is it a new file : %s",
+             HEADER_PAGE, header_frame->page_num(), file_name);
+    bp->unpin_page(header_frame);
+    bpm.close_file(file_name);
+    return RC::INTERNAL;
+  }
+
+  header_.pages_per_group = calc_pages_per_group(table_->table_meta().record_size());
+  header_.filter_num = 0;
+  memcpy(header_frame->data(), &header_, sizeof(header_));
+  header_frame->mark_dirty();
+  bp->unpin_page(header_frame);
+
+  file_buffer_pool_ = bp;
+  LOG_INFO("Successfully create bloom filter index, file_name:%s, index:%s, field_names:%s, pages per group:%d",
+           file_name, index_meta.name(), index_meta.multi_fields(), header_.pages_per_group);
+  return RC::SUCCESS;
+}
+
+RC BloomFilterIndex::open(
+    const char *file_name, const IndexMeta &index_meta, const std::vector<FieldMeta> &multi_field_metas)
+{
+  if (file_buffer_pool_ != nullptr) {
+    LOG_WARN("Failed to open index due to the index has been inited before. file_name:%s, index:%s",
+             file_name, index_meta.name());
+    return RC::RECORD_OPENNED;
+  }
+
+  Index::init(index_meta, multi_field_metas);
+  RC rc = init_key(index_meta, multi_field_metas);
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+
+  BufferPoolManager &bpm = BufferPoolManager::instance();
+  FileBufferPool *bp = nullptr;
+  rc = bpm.open_file(file_name, bp);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("Failed to open file name=%s, rc=%d:%s", file_name, rc, strrc(rc));
+    return rc;
+  }
+
+  Frame *frame = nullptr;
+  rc = bp->get_this_page(HEADER_PAGE, &frame);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("Failed to get header page. file name=%s, rc=%d:%s", file_name, rc, strrc(rc));
+    bpm.close_file(file_name);
+    return rc;
+  }
+  memcpy(&header_, frame->data(), sizeof(header_));
+  bp->unpin_page(frame);
+
+  file_buffer_pool_ = bp;
+  LOG_INFO("Successfully open bloom filter index, file_name:%s, index:%s, filters:%d",
+           file_name, index_meta.name(), header_.filter_num);
+  return RC::SUCCESS;
+}
+
+RC BloomFilterIndex::close()
+{
+  if (file_buffer_pool_ != nullptr) {
+    LOG_INFO("Begin to close bloom filter index, index:%s", index_meta_.name());
+    file_buffer_pool_->close_file();
+    file_buffer_pool_ = nullptr;
+  }
+  return RC::SUCCESS;
+}
+
+RC BloomFilterIndex::init_key(const IndexMeta &index_meta, const std::vector<FieldMeta> &multi_field_metas)
+{
+  const TableMeta &table_meta = table_->table_meta();
+  const std::vector<FieldMeta> &field_metas = *table_meta.field_metas();
+  std::vector<int> field_indexes;
+  for (const FieldMeta &field_meta : multi_field_metas) {
+    auto iter = std::find_if(field_metas.begin(), field_metas.end(),
+        [&field_meta](const FieldMeta &field) { return 0 == strcmp(field.name(), field_meta.name()); });
+    if (iter == field_metas.end()) {
+      LOG_WARN("no such field of bloom filter index. index=%s, field=%s", index_meta.name(), field_meta.name());
+      return RC::SCHEMA_FIELD_MISSING;
+    }
+    field_indexes.push_back(static_cast<int>(iter - field_metas.begin()));
+  }
+  return key_.init(table_meta, field_indexes);
+}
+
+RC BloomFilterIndex::write_header()
+{
+  Frame *frame = nullptr;
+  RC rc = file_buffer_pool_->get_this_page(HEADER_PAGE, &frame);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to get header page of bloom filter index. index=%s, rc=%s", index_meta_.name(), strrc(rc));
+    return rc;
+  }
+  memcpy(frame->data(), &header_, sizeof(header_));
+  frame->mark_dirty();
+  file_buffer_pool_->unpin_page(frame);
+  return RC::SUCCESS;
+}
+
+RC BloomFilterIndex::ensure_filter(int group)
+{
+  if (group < header_.filter_num) {
+    return RC::SUCCESS;
+  }
+  // 数据页面基本是顺序分配的，过滤器页面也跟着顺序分配，新分配的页面已经清零
+  while (header_.filter_num <= group) {
+    Frame *frame = nullptr;
+    RC rc = file_buffer_pool_->allocate_page(&frame);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to allocate filter page. index=%s, rc=%s", index_meta_.name(), strrc(rc));
+      return rc;
+    }
+    const PageNum page_num = frame->page_num();
+    frame->mark_dirty();
+    file_buffer_pool_->unpin_page(frame);
+    if (page_num != FIRST_FILTER_PAGE + header_.filter_num) {
+      LOG_ERROR("unexpected filter page. index=%s, expect=%d, got=%d",
+          index_meta_.name(), FIRST_FILTER_PAGE + header_.filter_num, page_num);
+      return RC::INTERNAL;
+    }
+    header_.filter_num++;
+  }
+  return write_header();
+}
+
+RC BloomFilterIndex::insert_entry(const char *record, const RID *rid)
+{
+  uint64_t hash = 0;
+  if (!key_.hash_record(record, hash)) {
+    // 有 NULL 的键不会与任何值相等
+    return RC::SUCCESS;
+  }
+
+  const int group = rid->page_num / header_.pages_per_group;
+  std::unique_lock<std::shared_mutex> guard(lock_);
+  RC rc = ensure_filter(group);
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+
+  Frame *frame = nullptr;
+  rc = file_buffer_pool_->get_this_page(FIRST_FILTER_PAGE + group, &frame);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to get filter page. index=%s, group=%d, rc=%s", index_meta_.name(), group, strrc(rc));
+    return rc;
+  }
+  BloomFilter::insert(frame->data(), FILTER_BLOCK_NUM, hash);
+  frame->mark_dirty();
+  file_buffer_pool_->unpin_page(frame);
+  return RC::SUCCESS;
+}
+
+RC BloomFilterIndex::delete_entry(const char *record, const RID *rid)
+{
+  return RC::SUCCESS;
+}
+
+IndexScanner *BloomFilterIndex::create_scanner(
+    const char *left_key, int left_len, bool left_inclusive, const char *right_key, int right_len, bool right_inclusive)
+{
+  LOG_WARN("bloom filter index does not support scan. index=%s", index_meta_.name());
+  return nullptr;
+}
+
+RC BloomFilterIndex::sync()
+{
+  std::shared_lock<std::shared_mutex> guard(lock_);
+  return file_buffer_pool_->flush_all_pages();
+}
+
+bool BloomFilterIndex::probe_hashes(const ZonePredicate &predicate, std::vector<uint64_t> &hashes) const
+{
+  // 扫描上的多个条件是 AND 的关系
+  std::vector<const ZonePredicate *> conjuncts;
+  if (predicate.kind == ZonePredicate::Kind::AND) {
+    for (const ZonePredicate &child : predicate.children) {
+      conjuncts.push_back(&child);
+    }
+  } else {
+    conjuncts.push_back(&predicate);
+  }
+
+  const std::vector<int> &field_indexes = key_.field_indexes();
+  std::vector<Value> key_values(field_indexes.size());
+  std::vector<Value> in_values;
+  for (size_t i = 0; i < field_indexes.size(); i++) {
+    bool found = false;
+    for (const ZonePredicate *conjunct : conjuncts) {
+      int field_index = -1;
+      std::vector<Value> values;
+      if (!equal_values(*conjunct, field_index, values) || field_index != field_indexes[i]) {
+        continue;
+      }
+      if (values.size() == 1) {
+        key_values[i] = values.front();
+        found = true;
+        break;
+      }
+      // 只有单个字段的索引可以使用 IN 列表
+      if (field_indexes.size() == 1 && values.size() <= MAX_PROBE_KEYS) {
+        in_values = std::move(values);
+        found = true;
+        break;
+      }
+    }
+    if (!found) {
+      return false;
+    }
+  }
+
+  hashes.clear();
+  if (in_values.empty()) {
+    uint64_t hash = 0;
+    if (!key_.hash_values(key_values.data(), hash)) {
+      return false;
+    }
+    hashes.push_back(hash);
+    return true;
+  }
+  for (const Value &value : in_values) {
+    uint64_t hash = 0;
+    if (!key_.hash_values(&value, hash)) {
+      return false;
+    }
+    hashes.push_back(hash);
+  }
+  return true;
+}
+
+bool BloomFilterIndex::may_contain_any(PageNum page_num, const std::vector<uint64_t> &hashes) const
+{
+  const int group = page_num / header_.pages_per_group;
+  std::shared_lock<std::shared_mutex> guard(lock_);
+  if (group >= header_.filter_num) {
+    return true;
+  }
+
+  Frame *frame = nullptr;
+  if (file_buffer_pool_->get_this_page(FIRST_FILTER_PAGE + group, &frame) != RC::SUCCESS) {
+    return true;
+  }
+  bool result = false;
+  for (uint64_t hash : hashes) {
+    if (BloomFilter::may_contain(frame->data(), FILTER_BLOCK_NUM, hash)) {
+      result = true;
+      break;
+    }
+  }
+  file_buffer_pool_->unpin_page(frame);
+  return result;
+}
@@ -1,5 +1,7 @@
 #include "include/storage_engine/index/bplus_tree.h"
 
+#include <cfloat>
+
 #include "common/log/log.h"
 #include "common/lang/lower_bound.h"
 
@@ -23,6 +25,27 @@ int calc_leaf_page_capacity(int attr_length)
   return capacity;
 }
 
+/**
+ * 把范围键中没有给出的字段填成这个类型的最小值或最大值
+ */
+static void fill_attr_bound(char *buf, AttrType attr_type, int attr_length, bool max)
+{
+  switch (attr_type) {
+    case INTS:
+    case DATES: {
+      const int32_t value = max ? INT32_MAX : INT32_MIN;
+      memcpy(buf, &value, sizeof(value));
+    } break;
+    case FLOATS: {
+      const float value = max ? FLT_MAX : -FLT_MAX;
+      memcpy(buf, &value, sizeof(value));
+    } break;
+    default: {
+      memset(buf, max ? 0xff : 0, attr_length);
+    } break;
+  }
+}
+
 /////////////////////////////////////////////////////////////////////////////////
 IndexNodeHandler::IndexNodeHandler(const IndexFileHeader &header, Frame *frame)
     : header_(header), page_num_(frame->page_num()), node_((IndexNode *)frame->data())
@@ -794,7 +817,7 @@ RC BplusTreeHandler::create(const char *file_name, bool is_unique, std::vector<A
 
   if (multi_attr_length.size() > 1) {
     file_header->attrs_type = CHARS;
-    key_comparator_.init(CHARS, total_attr_length);
+    key_comparator_.init(file_header->attr_amount, file_header->multi_attr_types, file_header->multi_attr_lengths);
     key_printer_.init(CHARS, total_attr_length);
   } else {
     file_header->attrs_type = multi_attr_types[0];
@@ -863,7 +886,7 @@ RC BplusTreeHandler::open(const char *file_name)
   }
 
   if (file_header_.attr_amount > 1) {
-    key_comparator_.init(CHARS, total_attr_length);
+    key_comparator_.init(file_header_.attr_amount, file_header_.multi_attr_types, file_header_.multi_attr_lengths);
     key_printer_.init(CHARS, total_attr_length);
   } else {
     key_comparator_.init(file_header_.multi_attr_types[0], total_attr_length);
@@ -1339,7 +1362,7 @@ RC BplusTreeHandler::create_new_tree(const char *key, const RID *rid)
   return rc;
 }
 
-MemPoolItem::unique_ptr BplusTreeHandler::make_key(const char *multi_keys[], const RID &rid, int multi_keys_amount, int left_or_right,  bool all_in_one_input_key)
+MemPoolItem::unique_ptr BplusTreeHandler::make_key(const char *multi_keys[], const RID &rid, int multi_keys_amount, int left_or_right, int bound_key_len)
 {
   MemPoolItem::unique_ptr key = mem_pool_item_->alloc_unique_ptr();
   if (key == nullptr) {
@@ -1347,54 +1370,37 @@ MemPoolItem::unique_ptr BplusTreeHandler::make_key(const char *multi_keys[], con
     return nullptr;
   }
 
+  char *key_data = static_cast<char *>(key.get());
   if (file_header_.attr_amount == 1) {
-    memcpy(static_cast<char *>(key.get()), multi_keys[0], file_header_.multi_attr_lengths[0]);
+    memcpy(key_data, multi_keys[0], file_header_.multi_attr_lengths[0]);
     if (left_or_right != 3) {
-      memcpy(static_cast<char *>(key.get()) + file_header_.multi_attr_lengths[0], &rid, sizeof(rid));
+      memcpy(key_data + file_header_.multi_attr_lengths[0], &rid, sizeof(rid));
     }
-  } else {
-    if (left_or_right == 0) {  // occurs when inserting
-      int accumulated_length = 0;
-      for (int i=0; i < multi_keys_amount; i++) {
-        memcpy(static_cast<char *>(key.get()) + accumulated_length, multi_keys[i], file_header_.multi_attr_lengths[i]);
-        accumulated_length += file_header_.multi_attr_lengths[i];
-      }
-      memcpy(static_cast<char *>(key.get()) + accumulated_length, &rid, sizeof(rid));
-    } else if (left_or_right == 1) {  // occurs when finding left_bound
-      int accumulated_length = 0;
-      if (all_in_one_input_key) {
-        memcpy(static_cast<char *>(key.get()), multi_keys[0], file_header_.attrs_length);
-        accumulated_length = file_header_.attrs_length;
-      } else {
-        memcpy(static_cast<char *>(key.get()), multi_keys[0], file_header_.multi_attr_lengths[0]);
-        accumulated_length = file_header_.multi_attr_lengths[0];
-        for (int i = 1; i < multi_keys_amount; i++) {
-          memset(static_cast<char *>(key.get()) + accumulated_length, 0, file_header_.multi_attr_lengths[i]);
-          accumulated_length += file_header_.multi_attr_lengths[i];
-        }
-      }
-      memcpy(static_cast<char *>(key.get()) + accumulated_length, &rid, sizeof(rid));
-    } else if (left_or_right == 2) {  // occurs when finding right_bound
-      int accumulated_length = 0;
-      if (all_in_one_input_key) {
-        memcpy(static_cast<char *>(key.get()), multi_keys[0], file_header_.attrs_length);
-        accumulated_length = file_header_.attrs_length;
-      } else {
-        memcpy(static_cast<char *>(key.get()), multi_keys[0], file_header_.multi_attr_lengths[0]);
-        accumulated_length = file_header_.multi_attr_lengths[0];
-        for (int i = 1; i < multi_keys_amount; i++) {
-          memset(static_cast<char *>(key.get()) + accumulated_length, 0, file_header_.multi_attr_lengths[i]);
-          accumulated_length += file_header_.multi_attr_lengths[i];
-        }
-      }
-      memcpy(static_cast<char *>(key.get()) + accumulated_length, &rid, sizeof(rid));
-    } else if (left_or_right == 3) {
-      int accumulated_length = 0;
-      for (int i=0; i < multi_keys_amount; i++) {
-        memcpy(static_cast<char *>(key.get()) + accumulated_length, multi_keys[i], file_header_.multi_attr_lengths[i]);
-        accumulated_length += file_header_.multi_attr_lengths[i];
+  } else if (left_or_right == 0 || left_or_right == 3) {  // occurs when inserting or finding an entry
+    int accumulated_length = 0;
+    for (int i=0; i < multi_keys_amount; i++) {
+      memcpy(key_data + accumulated_length, multi_keys[i], file_header_.multi_attr_lengths[i]);
+      accumulated_length += file_header_.multi_attr_lengths[i];
+    }
+    if (left_or_right == 0) {
+      memcpy(key_data + accumulated_length, &rid, sizeof(rid));
+    }
+  } else {  // occurs when finding left_bound(1) or right_bound(2)
+    // 范围的键可以只给出前面若干个字段(比如不带事务字段)，剩下的字段在左边界填最小值，在右边界填最大值
+    const int copy_length = std::min(bound_key_len, file_header_.attrs_length);
+    memcpy(key_data, multi_keys[0], copy_length);
+    int accumulated_length = 0;
+    for (int i = 0; i < file_header_.attr_amount; i++) {
+      const int attr_length = file_header_.multi_attr_lengths[i];
+      if (accumulated_length >= copy_length) {
+        fill_attr_bound(key_data + accumulated_length, file_header_.multi_attr_types[i], attr_length, left_or_right == 2);
+      } else if (accumulated_length + attr_length > copy_length) {
+        // 只给出了一部分的字符串字段，与定长字段的存储一样补0
+        memset(key_data + copy_length, 0, accumulated_length + attr_length - copy_length);
       }
+      accumulated_length += attr_length;
     }
+    memcpy(key_data + accumulated_length, &rid, sizeof(rid));
   }
 
   return key;
@@ -1726,30 +1732,14 @@ RC BplusTreeScanner::open(const char *left_user_key, int left_len, bool left_inc
   inited_ = true;
   first_emitted_ = false;
 
-  // 校验输入的键值是否是合法范围
-  if (left_user_key && right_user_key) {
-    const auto &attr_comparator = tree_handler_.key_comparator_.attr_comparator();
-    const int result = attr_comparator(left_user_key, right_user_key);
-    if (result > 0 ||  // left > right
-                       // left == right but is (left,right)/[left,right) or (left,right]
-        (result == 0 && (!left_inclusive|| !right_inclusive))) {
-      return RC::INVALID_ARGUMENT;
-    }
-  }
-
-  bool all_in_one_key_left = left_len == tree_handler_.file_header_.attrs_length;
-  bool all_in_one_key_right = right_len == tree_handler_.file_header_.attrs_length;
+  const IndexFileHeader &file_header = tree_handler_.file_header_;
+  // 多列索引的键不做调整，没有给出的字段由 make_key 补齐
+  const bool fix_chars_key = file_header.attr_amount == 1 && file_header.attrs_type == CHARS;
 
-  if (nullptr == left_user_key) {
-    rc = tree_handler_.left_most_page(current_frame_);
-    if (rc != RC::SUCCESS) {
-      LOG_WARN("failed to find left most page. rc=%s", strrc(rc));
-      return rc;
-    }
-    iter_index_ = 0;
-  } else {
+  MemPoolItem::unique_ptr left_pkey;
+  if (nullptr != left_user_key) {
     char *fixed_left_key = const_cast<char *>(left_user_key);
-    if (tree_handler_.file_header_.attrs_type == CHARS) {
+    if (fix_chars_key) {
       bool should_inclusive_after_fix = false;
       rc = fix_user_key(left_user_key, left_len, true /*greater*/, &fixed_left_key, &should_inclusive_after_fix);
       if (rc != RC::SUCCESS) {
@@ -1761,21 +1751,73 @@ RC BplusTreeScanner::open(const char *left_user_key, int left_len, bool left_inc
       }
     }
 
-    MemPoolItem::unique_ptr left_pkey;
     const char *multi_fixed_left_key[1] = {fixed_left_key};
     if (left_inclusive) {
-      left_pkey = tree_handler_.make_key(multi_fixed_left_key, *RID::min(), tree_handler_.file_header_.attr_amount, 1, all_in_one_key_left);
+      left_pkey = tree_handler_.make_key(multi_fixed_left_key, *RID::min(), file_header.attr_amount, 1, left_len);
     } else {
-      left_pkey = tree_handler_.make_key(multi_fixed_left_key, *RID::max(), tree_handler_.file_header_.attr_amount, 2, all_in_one_key_left);
+      left_pkey = tree_handler_.make_key(multi_fixed_left_key, *RID::max(), file_header.attr_amount, 2, left_len);
     }
 
-    const char *left_key = (const char *)left_pkey.get();
-
     if (fixed_left_key != left_user_key) {
       delete[] fixed_left_key;
       fixed_left_key = nullptr;
     }
+  }
+
+  // 没有指定右边界范围，那么就返回右边界最大值
+  if (nullptr == right_user_key) {
+    right_key_ = nullptr;
+  } else {
+    char *fixed_right_key = const_cast<char *>(right_user_key);
+    bool should_include_after_fix = false;
+    if (fix_chars_key) {
+      rc = fix_user_key(right_user_key, right_len, false /*want_greater*/, &fixed_right_key, &should_include_after_fix);
+      if (rc != RC::SUCCESS) {
+        LOG_WARN("failed to fix right user key. rc=%s", strrc(rc));
+        return rc;
+      }
+
+      if (should_include_after_fix) {
+        right_inclusive = true;
+      }
+    }
+    const char *multi_fixed_right_key[1] = {fixed_right_key};
+    if (right_inclusive) {
+      right_key_ = tree_handler_.make_key(multi_fixed_right_key, *RID::max(), file_header.attr_amount, 2, right_len);
+    } else {
+      right_key_ = tree_handler_.make_key(multi_fixed_right_key, *RID::min(), file_header.attr_amount, 1, right_len);
+    }
+
+    if (fixed_right_key != right_user_key) {
+      delete[] fixed_right_key;
+      fixed_right_key = nullptr;
+    }
+  }
+
+  // 校验输入的键值是否是合法范围
+  if (left_pkey != nullptr && right_key_ != nullptr) {
+    const auto &attr_comparator = tree_handler_.key_comparator_.attr_comparator();
+    const int result = attr_comparator(static_cast<const char *>(left_pkey.get()), static_cast<const char *>(right_key_.get()));
+    if (result > 0 ||  // left > right
+                       // left == right but is (left,right)/[left,right) or (left,right]
+        (result == 0 && (!left_inclusive|| !right_inclusive))) {
+      return RC::INVALID_ARGUMENT;
+    }
+  }
 
+  if (nullptr == left_pkey) {
+    rc = tree_handler_.left_most_page(current_frame_);
+    if (rc == RC::EMPTY) {
+      // 空树，与左边界查找不到数据时一样返回一个空的扫描
+      current_frame_ = nullptr;
+      return RC::SUCCESS;
+    } else if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to find left most page. rc=%s", strrc(rc));
+      return rc;
+    }
+    iter_index_ = 0;
+  } else {
+    const char *left_key = (const char *)left_pkey.get();
     rc = tree_handler_.find_leaf(BplusTreeOperationType::READ, left_key, current_frame_);
     if (rc == RC::EMPTY) {
       rc = RC::SUCCESS;
@@ -1787,7 +1829,7 @@ RC BplusTreeScanner::open(const char *left_user_key, int left_len, bool left_inc
     }
 
 
-    LeafIndexNodeHandler left_node(tree_handler_.file_header_, current_frame_);
+    LeafIndexNodeHandler left_node(file_header, current_frame_);
     int left_index = left_node.lookup(tree_handler_.key_comparator_, left_key);
     // lookup 返回的是适合插入的位置，还需要判断一下是否在合适的边界范围内
     if (left_index >= left_node.size()) {  // 超出了当前页，就需要向后移动一个位置
@@ -1808,36 +1850,6 @@ RC BplusTreeScanner::open(const char *left_user_key, int left_len, bool left_inc
     iter_index_ = left_index;
   }
 
-  // 没有指定右边界范围，那么就返回右边界最大值
-  if (nullptr == right_user_key) {
-    right_key_ = nullptr;
-  } else {
-    char *fixed_right_key = const_cast<char *>(right_user_key);
-    bool should_include_after_fix = false;
-    if (tree_handler_.file_header_.attrs_type == CHARS) {
-      rc = fix_user_key(right_user_key, right_len, false /*want_greater*/, &fixed_right_key, &should_include_after_fix);
-      if (rc != RC::SUCCESS) {
-        LOG_WARN("failed to fix right user key. rc=%s", strrc(rc));
-        return rc;
-      }
-
-      if (should_include_after_fix) {
-        right_inclusive = true;
-      }
-    }
-    const char *multi_fixed_right_key[1] = {fixed_right_key};
-    if (right_inclusive) {
-      right_key_ = tree_handler_.make_key(multi_fixed_right_key, *RID::max(), tree_handler_.file_header_.attr_amount, 2, all_in_one_key_right);
-    } else {
-      right_key_ = tree_handler_.make_key(multi_fixed_right_key, *RID::min(), tree_handler_.file_header_.attr_amount, 1, all_in_one_key_right);
-    }
-
-    if (fixed_right_key != right_user_key) {
-      delete[] fixed_right_key;
-      fixed_right_key = nullptr;
-    }
-  }
-
   if (touch_end()) {
     // 释放 current_frame_ 的引用前需要先 unpin
     tree_handler_.file_buffer_pool_->unpin_page(current_frame_);
@@ -1851,6 +1863,16 @@ void BplusTreeScanner::fetch_item(RID &rid)
 {
   LeafIndexNodeHandler node(tree_handler_.file_header_, current_frame_);
   memcpy(&rid, node.value_at(iter_index_), sizeof(rid));
+  current_index_ = iter_index_;
+}
+
+const char *BplusTreeScanner::current_key()
+{
+  if (current_frame_ == nullptr || current_index_ < 0) {
+    return nullptr;
+  }
+  LeafIndexNodeHandler node(tree_handler_.file_header_, current_frame_);
+  return node.key_at(current_index_);
 }
 
 bool BplusTreeScanner::touch_end()
@@ -178,6 +178,11 @@ RC BplusTreeIndexScanner::next_entry(RID *rid, bool isdelete)
   return tree_scanner_.next_entry(*rid, isdelete);
 }
 
+const char *BplusTreeIndexScanner::current_key()
+{
+  return tree_scanner_.current_key();
+}
+
 RC BplusTreeIndexScanner::destroy()
 {
   delete this;
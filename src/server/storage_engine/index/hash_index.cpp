@@ -0,0 +1,662 @@
+#include "include/storage_engine/index/hash_index.h"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+#include "common/lang/bitmap.h"
+#include "include/storage_engine/transaction/mvcc_trx.h"
+
+namespace {
+
+/// 目录最多有 2^MAX_GLOBAL_DEPTH 项，目录页面的页号都要能放到头页面中
+constexpr int MAX_GLOBAL_DEPTH = 20;
+
+/// 一个目录页面中的目录项个数
+constexpr int DIR_ENTRIES_PER_PAGE = BP_PAGE_DATA_SIZE / sizeof(PageNum);
+
+constexpr int MAX_DIR_PAGE_NUM = (BP_PAGE_DATA_SIZE - sizeof(HashIndexFileHeader)) / sizeof(PageNum);
+
+static_assert((1 << MAX_GLOBAL_DEPTH) <= MAX_DIR_PAGE_NUM * DIR_ENTRIES_PER_PAGE, "directory is too large");
+
+/// FNV-1a，再用 murmur 的 finalizer 打散，取高32位
+uint32_t hash_key(const char *key, int len)
+{
+  uint64_t h = 0xcbf29ce484222325ULL;
+  for (int i = 0; i < len; i++) {
+    h ^= static_cast<unsigned char>(key[i]);
+    h *= 0x100000001b3ULL;
+  }
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return static_cast<uint32_t>(h >> 32);
+}
+
+/**
+ * @brief 桶页面的访问接口
+ * @details 索引项的格式是 [哈希值][键][RID]，页面数据不保证对齐，都使用 memcpy 读写
+ */
+class BucketPage
+{
+public:
+  BucketPage(const HashIndexFileHeader &header, Frame *frame) : header_(header), frame_(frame)
+  {}
+
+  HashBucketHeader *bucket() { return reinterpret_cast<HashBucketHeader *>(frame_->data()); }
+
+  char *entry(int index)
+  {
+    return frame_->data() + sizeof(HashBucketHeader) + index * header_.entry_size;
+  }
+
+  uint32_t hash(int index)
+  {
+    uint32_t hash;
+    memcpy(&hash, entry(index), sizeof(hash));
+    return hash;
+  }
+
+  const char *key(int index) { return entry(index) + sizeof(uint32_t); }
+
+  RID rid(int index)
+  {
+    RID rid;
+    memcpy(&rid, entry(index) + sizeof(uint32_t) + header_.key_len, sizeof(RID));
+    return rid;
+  }
+
+  bool match(int index, uint32_t hash, const std::string &key)
+  {
+    return this->hash(index) == hash && 0 == memcmp(this->key(index), key.data(), header_.key_len);
+  }
+
+  void append(const char *entry_data)
+  {
+    memcpy(entry(bucket()->size), entry_data, header_.entry_size);
+    bucket()->size++;
+    frame_->mark_dirty();
+  }
+
+  /// 用最后一个索引项覆盖要删除的索引项
+  void remove(int index)
+  {
+    const int last = bucket()->size - 1;
+    if (index != last) {
+      memcpy(entry(index), entry(last), header_.entry_size);
+    }
+    bucket()->size--;
+    frame_->mark_dirty();
+  }
+
+  void init(int local_depth)
+  {
+    bucket()->local_depth = local_depth;
+    bucket()->size = 0;
+    bucket()->overflow = BP_INVALID_PAGE_NUM;
+    frame_->mark_dirty();
+  }
+
+private:
+  const HashIndexFileHeader &header_;
+  Frame *frame_;
+};
+
+}  // namespace
+
+bool HashIndex::support_type(AttrType type)
+{
+  return type == INTS || type == DATES || type == CHARS;
+}
+
+HashIndex::~HashIndex() noexcept
+{
+  close();
+}
+
+RC HashIndex::create(const char *file_name, const IndexMeta &index_meta, const std::vector<FieldMeta> &multi_field_metas)
+{
+  if (file_buffer_pool_ != nullptr) {
+    LOG_WARN("Failed to create index due to the index has been inited before. file_name:%s, index:%s",
+             file_name, index_meta.name());
+    return RC::RECORD_OPENNED;
+  }
+
+  Index::init(index_meta, multi_field_metas);
+
+  header_.key_len = 0;
+  for (const FieldMeta &field_meta : multi_field_metas) {
+    if (!support_type(field_meta.type())) {
+      LOG_WARN("unsupported field type of hash index. index=%s, field=%s", index_meta.name(), field_meta.name());
+      return RC::INVALID_ARGUMENT;
+    }
+    header_.key_len += field_meta.len();
+  }
+  header_.entry_size = static_cast<int32_t>(sizeof(uint32_t) + header_.key_len + sizeof(RID));
+  header_.bucket_capacity = static_cast<int32_t>((BP_PAGE_DATA_SIZE - sizeof(HashBucketHeader)) / header_.entry_size);
+  header_.global_depth = 0;
+  header_.dir_page_num = 0;
+  if (header_.bucket_capacity < 1) {
+    LOG_WARN("key of hash index is too long. index=%s, key len=%d", index_meta.name(), header_.key_len);
+    return RC::INVALID_ARGUMENT;
+  }
+
+  RC rc = init_null_bits();
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+
+  BufferPoolManager &bpm = BufferPoolManager::instance();
+  rc = bpm.create_file(file_name);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("Failed to create file. file name=%s, rc=%d:%s", file_name, rc, strrc(rc));
+    return rc;
+  }
+
+  FileBufferPool *bp = nullptr;
+  rc = bpm.open_file(file_name, bp);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("Failed to open file. file name=%s, rc=%d:%s", file_name, rc, strrc(rc));
+    return rc;
+  }
+
+  Frame *header_frame = nullptr;
+  rc = bp->allocate_page(&header_frame);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to allocate header page for hash index. rc=%d:%s", rc, strrc(rc));
+    bpm.close_file(file_name);
+    return rc;
+  }
+  const PageNum header_page = header_frame->page_num();
+  header_frame->mark_dirty();
+  bp->unpin_page(header_frame);
+  if (header_page != HEADER_PAGE) {
+    LOG_WARN("header page num should be %d but got %d. is it a new file : %s", HEADER_PAGE, header_page, file_name);
+    bpm.close_file(file_name);
+    return RC::INTERNAL;
+  }
+
+  // 一开始只有一个桶，目录只有一项
+  file_buffer_pool_ = bp;
+  Frame *bucket_frame = nullptr;
+  rc = file_buffer_pool_->allocate_page(&bucket_frame);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to allocate bucket page for hash index. rc=%d:%s", rc, strrc(rc));
+    close();
+    return rc;
+  }
+  BucketPage(header_, bucket_frame).init(0);
+  directory_.assign(1, bucket_frame->page_num());
+  file_buffer_pool_->unpin_page(bucket_frame);
+
+  rc = ensure_dir_pages();
+  if (rc == RC::SUCCESS) {
+    rc = write_directory(0, 1);
+  }
+  if (rc == RC::SUCCESS) {
+    rc = write_header();
+  }
+  if (rc != RC::SUCCESS) {
+    close();
+    return rc;
+  }
+
+  LOG_INFO("Successfully create hash index, file_name:%s, index:%s, field_names:%s, bucket capacity:%d",
+           file_name, index_meta.name(), index_meta.multi_fields(), header_.bucket_capacity);
+  return RC::SUCCESS;
+}
+
+RC HashIndex::open(const char *file_name, const IndexMeta &index_meta, const std::vector<FieldMeta> &multi_field_metas)
+{
+  if (file_buffer_pool_ != nullptr) {
+    LOG_WARN("Failed to open index due to the index has been inited before. file_name:%s, index:%s",
+             file_name, index_meta.name());
+    return RC::RECORD_OPENNED;
+  }
+
+  Index::init(index_meta, multi_field_metas);
+  RC rc = init_null_bits();
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+
+  BufferPoolManager &bpm = BufferPoolManager::instance();
+  FileBufferPool *bp = nullptr;
+  rc = bpm.open_file(file_name, bp);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("Failed to open file name=%s, rc=%d:%s", file_name, rc, strrc(rc));
+    return rc;
+  }
+
+  Frame *frame = nullptr;
+  rc = bp->get_this_page(HEADER_PAGE, &frame);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("Failed to get header page. file name=%s, rc=%d:%s", file_name, rc, strrc(rc));
+    bpm.close_file(file_name);
+    return rc;
+  }
+  memcpy(&header_, frame->data(), sizeof(header_));
+  dir_pages_.resize(header_.dir_page_num);
+  memcpy(dir_pages_.data(), frame->data() + sizeof(header_), header_.dir_page_num * sizeof(PageNum));
+  bp->unpin_page(frame);
+
+  file_buffer_pool_ = bp;
+  rc = load_directory();
+  if (rc != RC::SUCCESS) {
+    close();
+    return rc;
+  }
+
+  LOG_INFO("Successfully open hash index, file_name:%s, index:%s, global depth:%d",
+           file_name, index_meta.name(), header_.global_depth);
+  return RC::SUCCESS;
+}
+
+RC HashIndex::close()
+{
+  if (file_buffer_pool_ != nullptr) {
+    LOG_INFO("Begin to close hash index, index:%s", index_meta_.name());
+    file_buffer_pool_->close_file();
+    file_buffer_pool_ = nullptr;
+  }
+  directory_.clear();
+  dir_pages_.clear();
+  return RC::SUCCESS;
+}
+
+RC HashIndex::init_null_bits()
+{
+  const TableMeta &table_meta = table_->table_meta();
+  const std::vector<FieldMeta> &field_metas = *table_meta.field_metas();
+  null_bits_.clear();
+  for (const FieldMeta &field_meta : multi_field_metas_) {
+    auto iter = std::find_if(field_metas.begin(), field_metas.end(),
+        [&field_meta](const FieldMeta &field) { return 0 == strcmp(field.name(), field_meta.name()); });
+    if (iter == field_metas.end()) {
+      LOG_WARN("no such field of hash index. index=%s, field=%s", index_meta_.name(), field_meta.name());
+      return RC::SCHEMA_FIELD_MISSING;
+    }
+    null_bits_.push_back(iter->nullable() ? static_cast<int>(iter - field_metas.begin()) : -1);
+  }
+  return RC::SUCCESS;
+}
+
+bool HashIndex::make_key(const char *record, std::string &key) const
+{
+  const FieldMeta *null_bitmap_field = table_->table_meta().null_bitmap_field();
+  common::Bitmap null_bitmap(const_cast<char *>(record) + null_bitmap_field->offset(), null_bitmap_field->len());
+  key.clear();
+  for (size_t i = 0; i < multi_field_metas_.size(); i++) {
+    if (null_bits_[i] >= 0 && null_bitmap.get_bit(null_bits_[i])) {
+      return false;
+    }
+    const FieldMeta &field_meta = multi_field_metas_[i];
+    const char *data = record + field_meta.offset();
+    if (field_meta.type() == CHARS) {
+      // 与查找时的键一样，字符串后面的部分都是0
+      const size_t len = strnlen(data, field_meta.len());
+      key.append(data, len);
+      key.append(field_meta.len() - len, '\0');
+    } else {
+      key.append(data, field_meta.len());
+    }
+  }
+  return true;
+}
+
+uint32_t HashIndex::bucket_slot(uint32_t hash) const
+{
+  return header_.global_depth == 0 ? 0 : hash >> (32 - header_.global_depth);
+}
+
+RC HashIndex::load_directory()
+{
+  const size_t slot_num = static_cast<size_t>(1) << header_.global_depth;
+  directory_.resize(slot_num);
+  for (size_t begin = 0; begin < slot_num; begin += DIR_ENTRIES_PER_PAGE) {
+    Frame *frame = nullptr;
+    RC rc = file_buffer_pool_->get_this_page(dir_pages_[begin / DIR_ENTRIES_PER_PAGE], &frame);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to get directory page of hash index. index=%s, rc=%s", index_meta_.name(), strrc(rc));
+      return rc;
+    }
+    const size_t count = std::min(slot_num - begin, static_cast<size_t>(DIR_ENTRIES_PER_PAGE));
+    memcpy(directory_.data() + begin, frame->data(), count * sizeof(PageNum));
+    file_buffer_pool_->unpin_page(frame);
+  }
+  return RC::SUCCESS;
+}
+
+RC HashIndex::ensure_dir_pages()
+{
+  const int needed = static_cast<int>((directory_.size() + DIR_ENTRIES_PER_PAGE - 1) / DIR_ENTRIES_PER_PAGE);
+  while (static_cast<int>(dir_pages_.size()) < needed) {
+    Frame *frame = nullptr;
+    RC rc = file_buffer_pool_->allocate_page(&frame);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to allocate directory page. index=%s, rc=%s", index_meta_.name(), strrc(rc));
+      return rc;
+    }
+    dir_pages_.push_back(frame->page_num());
+    frame->mark_dirty();
+    file_buffer_pool_->unpin_page(frame);
+  }
+  header_.dir_page_num = static_cast<int32_t>(dir_pages_.size());
+  return RC::SUCCESS;
+}
+
+RC HashIndex::write_directory(int begin, int end)
+{
+  while (begin < end) {
+    const int page_index = begin / DIR_ENTRIES_PER_PAGE;
+    const int page_end = std::min(end, (page_index + 1) * DIR_ENTRIES_PER_PAGE);
+    Frame *frame = nullptr;
+    RC rc = file_buffer_pool_->get_this_page(dir_pages_[page_index], &frame);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to get directory page of hash index. index=%s, rc=%s", index_meta_.name(), strrc(rc));
+      return rc;
+    }
+    memcpy(frame->data() + (begin - page_index * DIR_ENTRIES_PER_PAGE) * sizeof(PageNum),
+           directory_.data() + begin,
+           (page_end - begin) * sizeof(PageNum));
+    frame->mark_dirty();
+    file_buffer_pool_->unpin_page(frame);
+    begin = page_end;
+  }
+  return RC::SUCCESS;
+}
+
+RC HashIndex::write_header()
+{
+  Frame *frame = nullptr;
+  RC rc = file_buffer_pool_->get_this_page(HEADER_PAGE, &frame);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to get header page of hash index. index=%s, rc=%s", index_meta_.name(), strrc(rc));
+    return rc;
+  }
+  memcpy(frame->data(), &header_, sizeof(header_));
+  memcpy(frame->data() + sizeof(header_), dir_pages_.data(), dir_pages_.size() * sizeof(PageNum));
+  frame->mark_dirty();
+  file_buffer_pool_->unpin_page(frame);
+  return RC::SUCCESS;
+}
+
+RC HashIndex::double_directory()
+{
+  // 使用哈希值的高位作为槽位，加倍后原来的第 i 项变成第 2i 与 2i+1 项
+  std::vector<PageNum> directory(directory_.size() * 2);
+  for (size_t i = 0; i < directory_.size(); i++) {
+    directory[2 * i] = directory[2 * i + 1] = directory_[i];
+  }
+  directory_.swap(directory);
+  header_.global_depth++;
+
+  RC rc = ensure_dir_pages();
+  if (rc == RC::SUCCESS) {
+    rc = write_directory(0, static_cast<int>(directory_.size()));
+  }
+  if (rc == RC::SUCCESS) {
+    rc = write_header();
+  }
+  return rc;
+}
+
+RC HashIndex::split_bucket(uint32_t slot, Frame *frame)
+{
+  BucketPage old_page(header_, frame);
+  const int local_depth = old_page.bucket()->local_depth;
+  RC rc = RC::SUCCESS;
+  if (local_depth == header_.global_depth) {
+    rc = double_directory();
+    if (rc != RC::SUCCESS) {
+      file_buffer_pool_->unpin_page(frame);
+      return rc;
+    }
+    slot *= 2;
+  }
+
+  Frame *new_frame = nullptr;
+  rc = file_buffer_pool_->allocate_page(&new_frame);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to allocate bucket page. index=%s, rc=%s", index_meta_.name(), strrc(rc));
+    file_buffer_pool_->unpin_page(frame);
+    return rc;
+  }
+
+  // 哈希值的第 local_depth+1 高位是1的索引项放到新的桶中
+  BucketPage new_page(header_, new_frame);
+  new_page.init(local_depth + 1);
+  for (int i = old_page.bucket()->size - 1; i >= 0; i--) {
+    if ((old_page.hash(i) >> (31 - local_depth)) & 1) {
+      new_page.append(old_page.entry(i));
+      old_page.remove(i);
+    }
+  }
+  old_page.bucket()->local_depth = local_depth + 1;
+  frame->mark_dirty();
+
+  // 指向原来的桶的槽位是连续的一段，后一半改为指向新的桶
+  const int span = 1 << (header_.global_depth - local_depth);
+  const int begin = static_cast<int>(slot) / span * span;
+  const PageNum new_page_num = new_frame->page_num();
+  for (int i = begin + span / 2; i < begin + span; i++) {
+    directory_[i] = new_page_num;
+  }
+  file_buffer_pool_->unpin_page(new_frame);
+  file_buffer_pool_->unpin_page(frame);
+  return write_directory(begin + span / 2, begin + span);
+}
+
+RC HashIndex::append_overflow(Frame *frame, const char *entry)
+{
+  RC rc = RC::SUCCESS;
+  while (BucketPage(header_, frame).bucket()->size >= header_.bucket_capacity) {
+    BucketPage page(header_, frame);
+    Frame *next = nullptr;
+    if (page.bucket()->overflow == BP_INVALID_PAGE_NUM) {
+      rc = file_buffer_pool_->allocate_page(&next);
+      if (rc == RC::SUCCESS) {
+        BucketPage(header_, next).init(page.bucket()->local_depth);
+        page.bucket()->overflow = next->page_num();
+        frame->mark_dirty();
+      }
+    } else {
+      rc = file_buffer_pool_->get_this_page(page.bucket()->overflow, &next);
+    }
+    file_buffer_pool_->unpin_page(frame);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to get overflow page of hash index. index=%s, rc=%s", index_meta_.name(), strrc(rc));
+      return rc;
+    }
+    frame = next;
+  }
+  BucketPage(header_, frame).append(entry);
+  file_buffer_pool_->unpin_page(frame);
+  return RC::SUCCESS;
+}
+
+RC HashIndex::find_in_bucket(uint32_t hash, const std::string &key, std::vector<RID> &rids)
+{
+  PageNum page_num = directory_[bucket_slot(hash)];
+  while (page_num != BP_INVALID_PAGE_NUM) {
+    Frame *frame = nullptr;
+    RC rc = file_buffer_pool_->get_this_page(page_num, &frame);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to get bucket page of hash index. index=%s, rc=%s", index_meta_.name(), strrc(rc));
+      return rc;
+    }
+    BucketPage page(header_, frame);
+    for (int i = 0; i < page.bucket()->size; i++) {
+      if (page.match(i, hash, key)) {
+        rids.push_back(page.rid(i));
+      }
+    }
+    page_num = page.bucket()->overflow;
+    file_buffer_pool_->unpin_page(frame);
+  }
+  return RC::SUCCESS;
+}
+
+bool HashIndex::conflict(const std::vector<RID> &rids)
+{
+  const std::pair<const FieldMeta *, int> trx_fields = table_->table_meta().trx_fields();
+  if (trx_fields.second < 2) {
+    return !rids.empty();
+  }
+  // 多版本事务中，删除只修改记录的 end_xid，不会从索引中去掉：正在删除的记录 end_xid 为负数，
+  // 删除已经提交的记录 end_xid 为提交时的事务号，只有 end_xid 为 max_trx_id 的记录才是有效的
+  const int end_xid_offset = trx_fields.first[1].offset();
+  for (const RID &rid : rids) {
+    int32_t end_xid = 0;
+    RC rc = table_->visit_record(rid, true/*readonly*/, [&end_xid, end_xid_offset](Record &record) {
+      memcpy(&end_xid, record.data() + end_xid_offset, sizeof(end_xid));
+    });
+    if (rc != RC::SUCCESS || end_xid == MvccTrxManager::max_trx_id()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+RC HashIndex::insert_entry(const char *record, const RID *rid)
+{
+  std::string key;
+  if (!make_key(record, key)) {
+    return RC::SUCCESS;
+  }
+  const uint32_t hash = hash_key(key.data(), header_.key_len);
+
+  std::unique_lock<std::shared_mutex> guard(lock_);
+  if (index_meta_.is_unique()) {
+    std::vector<RID> rids;
+    RC rc = find_in_bucket(hash, key, rids);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+    if (conflict(rids)) {
+      LOG_WARN("Duplicate key found for unique index. index=%s", index_meta_.name());
+      return RC::RECORD_DUPLICATE_KEY;
+    }
+  }
+
+  std::string entry(reinterpret_cast<const char *>(&hash), sizeof(hash));
+  entry += key;
+  entry.append(reinterpret_cast<const char *>(rid), sizeof(RID));
+
+  while (true) {
+    const uint32_t slot = bucket_slot(hash);
+    Frame *frame = nullptr;
+    RC rc = file_buffer_pool_->get_this_page(directory_[slot], &frame);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to get bucket page of hash index. index=%s, rc=%s", index_meta_.name(), strrc(rc));
+      return rc;
+    }
+
+    BucketPage page(header_, frame);
+    HashBucketHeader *bucket = page.bucket();
+    if (bucket->size < header_.bucket_capacity) {
+      page.append(entry.data());
+      file_buffer_pool_->unpin_page(frame);
+      return RC::SUCCESS;
+    }
+
+    // 所有键的哈希值都相同时分裂不能让桶变小，只能使用溢出页面
+    bool same_hash = true;
+    for (int i = 0; i < bucket->size && same_hash; i++) {
+      same_hash = page.hash(i) == hash;
+    }
+    if (bucket->overflow != BP_INVALID_PAGE_NUM || bucket->local_depth >= MAX_GLOBAL_DEPTH || same_hash) {
+      return append_overflow(frame, entry.data());
+    }
+
+    rc = split_bucket(slot, frame);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+  }
+}
+
+RC HashIndex::delete_entry(const char *record, const RID *rid)
+{
+  std::string key;
+  if (!make_key(record, key)) {
+    return RC::SUCCESS;
+  }
+  const uint32_t hash = hash_key(key.data(), header_.key_len);
+
+  std::unique_lock<std::shared_mutex> guard(lock_);
+  PageNum page_num = directory_[bucket_slot(hash)];
+  while (page_num != BP_INVALID_PAGE_NUM) {
+    Frame *frame = nullptr;
+    RC rc = file_buffer_pool_->get_this_page(page_num, &frame);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to get bucket page of hash index. index=%s, rc=%s", index_meta_.name(), strrc(rc));
+      return rc;
+    }
+    BucketPage page(header_, frame);
+    for (int i = 0; i < page.bucket()->size; i++) {
+      if (page.match(i, hash, key) && page.rid(i) == *rid) {
+        page.remove(i);
+        file_buffer_pool_->unpin_page(frame);
+        return RC::SUCCESS;
+      }
+    }
+    page_num = page.bucket()->overflow;
+    file_buffer_pool_->unpin_page(frame);
+  }
+  return RC::RECORD_INVALID_KEY;
+}
+
+RC HashIndex::find(const char *key, std::vector<RID> &rids)
+{
+  std::string key_str(key, header_.key_len);
+  std::shared_lock<std::shared_mutex> guard(lock_);
+  return find_in_bucket(hash_key(key, header_.key_len), key_str, rids);
+}
+
+IndexScanner *HashIndex::create_scanner(
+    const char *left_key, int left_len, bool left_inclusive, const char *right_key, int right_len, bool right_inclusive)
+{
+  if (left_key == nullptr || right_key == nullptr || !left_inclusive || !right_inclusive || left_len != right_len ||
+      0 != memcmp(left_key, right_key, left_len)) {
+    LOG_WARN("hash index only supports equality lookup. index=%s", index_meta_.name());
+    return nullptr;
+  }
+
+  std::vector<RID> rids;
+  if (left_len <= header_.key_len) {
+    std::string key(left_key, left_len);
+    key.resize(header_.key_len, '\0');
+    RC rc = find(key.data(), rids);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to find key in hash index. index=%s, rc=%s", index_meta_.name(), strrc(rc));
+      return nullptr;
+    }
+  }
+  return new HashIndexScanner(std::move(rids));
+}
+
+RC HashIndex::sync()
+{
+  std::shared_lock<std::shared_mutex> guard(lock_);
+  return file_buffer_pool_->flush_all_pages();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+RC HashIndexScanner::next_entry(RID *rid, bool isdelete)
+{
+  if (position_ >= rids_.size()) {
+    return RC::RECORD_EOF;
+  }
+  *rid = rids_[position_++];
+  return RC::SUCCESS;
+}
+
+RC HashIndexScanner::destroy()
+{
+  delete this;
+  return RC::SUCCESS;
+}
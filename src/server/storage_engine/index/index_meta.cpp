@@ -4,8 +4,33 @@ const static Json::StaticString FIELD_NAME("name");
 const static Json::StaticString FIELD_AMOUNT("field_amount");
 const static Json::StaticString FIELD_FIELD_NAME("field_name");
 const static Json::StaticString UNIQUE_FLAG("is_unique");
+const static Json::StaticString INDEX_TYPE("type");
 
-RC IndexMeta::init(bool is_unique, const char *name, std::vector<const FieldMeta *> &multi_fields)
+const char *index_type_to_string(IndexType type)
+{
+  switch (type) {
+    case IndexType::BPLUS_TREE: return "btree";
+    case IndexType::BLOOM: return "bloom";
+    case IndexType::HASH: return "hash";
+  }
+  return "unknown";
+}
+
+RC index_type_from_string(const char *name, IndexType &type)
+{
+  if (0 == strcasecmp(name, "btree")) {
+    type = IndexType::BPLUS_TREE;
+  } else if (0 == strcasecmp(name, "bloom")) {
+    type = IndexType::BLOOM;
+  } else if (0 == strcasecmp(name, "hash")) {
+    type = IndexType::HASH;
+  } else {
+    return RC::INVALID_ARGUMENT;
+  }
+  return RC::SUCCESS;
+}
+
+RC IndexMeta::init(bool is_unique, const char *name, std::vector<const FieldMeta *> &multi_fields, IndexType type)
 {
   if (common::is_blank(name)) {
     LOG_ERROR("Failed to init index, name is empty.");
@@ -13,8 +38,12 @@ RC IndexMeta::init(bool is_unique, const char *name, std::vector<const FieldMeta
   }
   is_unique_ = is_unique;
   name_ = name;
+  type_ = type;
   for (int i = 0; i < multi_fields.size(); i++) {
     multi_fields_.emplace_back(multi_fields[i]->name());
+    if (multi_fields[i]->visible()) {
+      user_field_amount_++;
+    }
   }
   return RC::SUCCESS;
 }
@@ -23,6 +52,7 @@ void IndexMeta::to_json(Json::Value &json_value) const
 {
   json_value[UNIQUE_FLAG] = is_unique_;
   json_value[FIELD_NAME] = name_;
+  json_value[INDEX_TYPE] = index_type_to_string(type_);
   json_value[FIELD_AMOUNT] = std::to_string(multi_fields_.size());
   std::string multi_fields_names = "";
   for (int i = 0; i < multi_fields_.size() - 1; i++) {
@@ -71,7 +101,14 @@ RC IndexMeta::from_json(const TableMeta &table, const Json::Value &json_value, I
     }
     multi_fields.emplace_back(field);
   }
-  return index.init(unique_value.asBool(), name_value.asCString(), multi_fields);
+  // 旧版本的元数据没有类型，都是B+树
+  IndexType type = IndexType::BPLUS_TREE;
+  const Json::Value &type_value = json_value[INDEX_TYPE];
+  if (type_value.isString() && index_type_from_string(type_value.asCString(), type) != RC::SUCCESS) {
+    LOG_ERROR("Unknown type of index [%s]: %s", name_value.asCString(), type_value.asCString());
+    return RC::INTERNAL;
+  }
+  return index.init(unique_value.asBool(), name_value.asCString(), multi_fields, type);
 }
 
 const char *IndexMeta::name() const
@@ -98,7 +135,7 @@ const size_t IndexMeta::field_amount() const
 
 void IndexMeta::desc(std::ostream &os) const
 {
-  os << "index name=" << name_ << ", field amount=" << multi_fields_.size();
+  os << "index name=" << name_ << ", type=" << index_type_to_string(type_) << ", field amount=" << multi_fields_.size();
   for (int i = 0; i < multi_fields_.size(); i++) {
     os << ", field no."<< i <<"=" << multi_fields_[i];
   }
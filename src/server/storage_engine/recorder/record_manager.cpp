@@ -367,7 +367,11 @@ RC RecordFileHandler::insert_record(const char *data, int record_size, RID *rid)
   }
 
   // 找到空闲位置
-  return record_page_handler.insert_record(data, rid);
+  RC rc = record_page_handler.insert_record(data, rid);
+  if (RC_SUCC(rc)) {
+    clear_visible_hint(rid->page_num);
+  }
+  return rc;
 }
 
 RC RecordFileHandler::recover_insert_record(const char *data, int record_size, const RID &rid)
@@ -379,7 +383,9 @@ RC RecordFileHandler::recover_insert_record(const char *data, int record_size, c
     LOG_WARN("failed to init record page handler. page num=%d, rc=%s", rid.page_num, strrc(ret));
     return ret;
   }
-  return record_page_handler.recover_insert_record(data, rid);
+  ret = record_page_handler.recover_insert_record(data, rid);
+  clear_visible_hint(rid.page_num);
+  return ret;
 }
 
 RC RecordFileHandler::delete_record(const RID *rid)
@@ -398,6 +404,7 @@ RC RecordFileHandler::delete_record(const RID *rid)
   // insert record是加上未满page集合的锁，然后拿到指定页面锁再释放未满page集合的锁
   page_handler.cleanup();
   if (RC_SUCC(rc)) {
+    clear_visible_hint(rid->page_num);
     // 因为这里已经释放了页面锁，并发时，其它线程可能又把该页面填满了，那就不应该再放入free_pages_中。
     // 但是这里可以不关心，因为在查找空闲页面时，会自动过滤掉已经满的页面。
     lock_.lock();
@@ -442,15 +449,43 @@ RC RecordFileHandler::visit_record(const RID &rid, bool readonly, std::function<
   }
 
   visitor(record);
+  if (!readonly) {
+    clear_visible_hint(rid.page_num);
+  }
   return rc;
 }
 
+int32_t RecordFileHandler::visible_hint(PageNum page_num) const
+{
+  std::shared_lock<std::shared_mutex> guard(hint_lock_);
+  auto iter = visible_hints_.find(page_num);
+  return iter == visible_hints_.end() ? -1 : iter->second;
+}
+
+void RecordFileHandler::set_visible_hint(PageNum page_num, int32_t xid)
+{
+  std::unique_lock<std::shared_mutex> guard(hint_lock_);
+  visible_hints_[page_num] = xid;
+}
+
+void RecordFileHandler::clear_visible_hint(PageNum page_num)
+{
+  std::unique_lock<std::shared_mutex> guard(hint_lock_);
+  visible_hints_.erase(page_num);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 RecordFileScanner::~RecordFileScanner() { close_scan(); }
 
 RC RecordFileScanner::open_scan(
     Table *table, FileBufferPool &buffer_pool, Trx *trx, bool readonly, ConditionFilter *condition_filter)
+{
+  return open_scan(table, buffer_pool, trx, readonly, condition_filter, 0, -1);
+}
+
+RC RecordFileScanner::open_scan(Table *table, FileBufferPool &buffer_pool, Trx *trx, bool readonly,
+    ConditionFilter *condition_filter, PageNum begin_page, PageNum end_page)
 {
   close_scan();
 
@@ -459,7 +494,8 @@ RC RecordFileScanner::open_scan(
   trx_              = trx;
   readonly_         = readonly;
 
-  RC rc = bp_iterator_.init(buffer_pool);
+  // 迭代器返回的是 start_page 之后的页面
+  RC rc = bp_iterator_.init(buffer_pool, begin_page - 1, end_page);
   if (rc != RC::SUCCESS) {
     LOG_WARN("failed to init bp iterator. rc=%d:%s", rc, strrc(rc));
     return rc;
@@ -497,6 +533,10 @@ RC RecordFileScanner::fetch_next_record()
   while (bp_iterator_.has_next()) {
     PageNum page_num = bp_iterator_.next();
     record_page_handler_.cleanup();
+    if (page_filter_ && !page_filter_(page_num)) {
+      skipped_pages_++;
+      continue;
+    }
     rc = record_page_handler_.init(*file_buffer_pool_, page_num, readonly_);
     if (RC_FAIL(rc)) {
       LOG_WARN("failed to init record page handler. page_num=%d, rc=%s", page_num, strrc(rc));
@@ -504,6 +544,8 @@ RC RecordFileScanner::fetch_next_record()
     }
 
     record_page_iterator_.init(record_page_handler_);
+    // 只读扫描时页面上的数据不会被修改，可以顺便计算页面的可见性提示
+    page_visible_xid_ = (readonly_ && trx_ != nullptr && table_ != nullptr) ? 0 : -1;
     rc = fetch_next_record_in_page();
     if (rc == RC::SUCCESS || rc != RC::RECORD_EOF) {
       // 有有效记录：RC::SUCCESS
@@ -533,6 +575,11 @@ RC RecordFileScanner::fetch_next_record_in_page()
       return rc;
     }
 
+    if (page_visible_xid_ >= 0) {
+      const int32_t xid = trx_->visible_xid(table_, next_record_);
+      page_visible_xid_ = xid < 0 ? -1 : std::max(page_visible_xid_, xid);
+    }
+
     // 如果有过滤条件，就用过滤条件过滤一下
     if (condition_filter_ != nullptr && !condition_filter_->filter(next_record_)) {
       continue;
@@ -553,6 +600,12 @@ RC RecordFileScanner::fetch_next_record_in_page()
     return rc;
   }
 
+  // 整个页面都遍历过了，并且还持有页面锁，可以更新页面的可见性提示
+  if (page_visible_xid_ >= 0) {
+    table_->record_handler()->set_visible_hint(record_page_handler_.get_page_num(), page_visible_xid_);
+    page_visible_xid_ = -1;
+  }
+
   next_record_.rid().slot_num = -1;
   return RC::RECORD_EOF;
 }
@@ -568,6 +621,8 @@ RC RecordFileScanner::close_scan()
   }
 
   record_page_handler_.cleanup();
+  record_page_iterator_ = RecordPageIterator();
+  next_record_.rid().slot_num = -1;
 
   return RC::SUCCESS;
 }
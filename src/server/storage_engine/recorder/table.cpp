@@ -2,7 +2,10 @@
 #include "include/storage_engine/recorder/record_manager.h"
 #include "include/storage_engine/schema/schema_util.h"
 #include "include/storage_engine/index/bplus_tree_index.h"
+#include "include/storage_engine/index/bloom_filter_index.h"
+#include "include/storage_engine/index/hash_index.h"
 #include <random>
+#include <algorithm>
 
 
 Table::~Table()
@@ -97,6 +100,8 @@ RC Table::create(int32_t table_id,
   }
 
   base_dir_ = base_dir;
+  stats_.init_empty();
+  zone_map_.build(this);
   LOG_INFO("Successfully create table %s:%s", base_dir, name);
   return rc;
 }
@@ -130,6 +135,42 @@ RC Table::create(int32_t table_id,
   return rc;
 }
 
+RC Table::create_system(int32_t table_id,
+    const char *name,
+    int attribute_count,
+    const AttrInfoSqlNode attributes[],
+    SystemRecordLoader loader)
+{
+  if (loader == nullptr) {
+    LOG_WARN("system table must have a record loader. name=%s", name);
+    return RC::INVALID_ARGUMENT;
+  }
+
+  RC rc = table_meta_.init(table_id, name, attribute_count, attributes);
+  if (rc != RC::SUCCESS) {
+    LOG_ERROR("Failed to init meta of system table. name:%s, ret:%d", name, rc);
+    return rc;
+  }
+
+  system_loader_ = std::move(loader);
+  stats_.init_empty();
+  LOG_INFO("Successfully create system table %s", name);
+  return rc;
+}
+
+RC Table::load_system_records(std::vector<Record> &records)
+{
+  records.clear();
+  if (!is_system()) {
+    return RC::INTERNAL;
+  }
+  RC rc = system_loader_(*this, records);
+  for (size_t i = 0; i < records.size(); i++) {
+    records[i].set_rid(0, static_cast<SlotNum>(i));
+  }
+  return rc;
+}
+
 RC Table::drop(int32_t table_id,
     const char *name,
     const char *base_dir) {
@@ -159,9 +200,15 @@ RC Table::drop(int32_t table_id,
     return RC::FILE_REMOVE;
   }
 
+  // 统计信息文件不一定存在
+  std::string stats_file = table_stats_file(base_dir, name);
+  if (unlink(stats_file.c_str()) != 0 && errno != ENOENT) {
+    LOG_WARN("Failed to remove stats file=%s, errno=%d", stats_file.c_str(), errno);
+  }
+
   const int index_num = table_meta_.index_num();
   for (int i = 0; i < index_num; i ++) {
-    ((BplusTreeIndex*)indexes_[i])->close();
+    indexes_[i]->close();
     const IndexMeta *index_meta = table_meta_.index(i);
     std::string index_file = table_index_file(base_dir, name, index_meta->name());
     if(unlink(index_file.c_str()) != 0) {
@@ -201,6 +248,16 @@ RC Table::open(const char *meta_file, const char *base_dir)
 
   base_dir_ = base_dir;
 
+  // 没有统计信息文件时行数未知，等待 ANALYZE
+  if (stats_.load(table_stats_file(base_dir, name())) == RC::SUCCESS) {
+    LOG_INFO("Load table stats. table=%s, rows=%ld", name(), stats_.row_count());
+  }
+
+  // 摘要构建失败时只是不能跳过页面，不影响表的使用
+  if (zone_map_.build(this) != RC::SUCCESS) {
+    LOG_WARN("Failed to build zone map. table=%s", name());
+  }
+
   const int index_num = table_meta_.index_num();
   std::vector<FieldMeta> multi_field_metas;
   for (int i = 0; i < index_num; i++) {
@@ -217,9 +274,21 @@ RC Table::open(const char *meta_file, const char *base_dir)
       multi_field_metas.emplace_back(*field_meta);
     }
 
-    BplusTreeIndex *index = new BplusTreeIndex(this);
     std::string index_file = table_index_file(base_dir, name(), index_meta->name());
-    rc = index->open(index_file.c_str(), *index_meta, multi_field_metas);
+    Index *index = nullptr;
+    if (index_meta->type() == IndexType::BLOOM) {
+      BloomFilterIndex *bloom_index = new BloomFilterIndex(this);
+      index = bloom_index;
+      rc = bloom_index->open(index_file.c_str(), *index_meta, multi_field_metas);
+    } else if (index_meta->type() == IndexType::HASH) {
+      HashIndex *hash_index = new HashIndex(this);
+      index = hash_index;
+      rc = hash_index->open(index_file.c_str(), *index_meta, multi_field_metas);
+    } else {
+      BplusTreeIndex *bplus_tree_index = new BplusTreeIndex(this);
+      index = bplus_tree_index;
+      rc = bplus_tree_index->open(index_file.c_str(), *index_meta, multi_field_metas);
+    }
     if (rc != RC::SUCCESS) {
       delete index;
       LOG_ERROR("Failed to open index. table=%s, index=%s, file=%s, rc=%s",
@@ -239,8 +308,10 @@ RC Table::open(const char *meta_file, const char *base_dir)
  * @param multi_field_metas 多个字段的元数据
  * @param index_name 索引名称
  * @param is_unique 是否是唯一索引
+ * @param index_type 索引的类型
  */
-RC Table::create_index(Trx *trx, std::vector<const FieldMeta *> &multi_field_metas, const char *index_name, bool is_unique)
+RC Table::create_index(Trx *trx, std::vector<const FieldMeta *> &multi_field_metas, const char *index_name, bool is_unique,
+    IndexType index_type)
 {
   if (common::is_blank(index_name) || multi_field_metas.empty()) {
     LOG_INFO("Invalid input arguments, table name is %s, index_name is blank or attribute_name is blank", name());
@@ -248,7 +319,7 @@ RC Table::create_index(Trx *trx, std::vector<const FieldMeta *> &multi_field_met
   }
 
   IndexMeta new_index_meta;
-  RC rc = new_index_meta.init(is_unique, index_name, multi_field_metas);
+  RC rc = new_index_meta.init(is_unique, index_name, multi_field_metas, index_type);
   if (rc != RC::SUCCESS) {
     LOG_INFO("Failed to init IndexMeta in table:%s, index_name:%s, field_amount:%d",
              name(), index_name, multi_field_metas.size());
@@ -256,22 +327,36 @@ RC Table::create_index(Trx *trx, std::vector<const FieldMeta *> &multi_field_met
   }
 
   // 创建索引相关数据
-  BplusTreeIndex *index = new BplusTreeIndex(this);
   std::string index_file = table_index_file(base_dir_.c_str(), name(), index_name);
   std::vector<FieldMeta> new_multi_field_metas;
   for (int i = 0; i < multi_field_metas.size(); i++) {
     new_multi_field_metas.emplace_back(*(multi_field_metas[i]));
   }
-  rc = index->create(index_file.c_str(), new_index_meta, new_multi_field_metas);
+  Index *index = nullptr;
+  if (index_type == IndexType::BLOOM) {
+    BloomFilterIndex *bloom_index = new BloomFilterIndex(this);
+    index = bloom_index;
+    rc = bloom_index->create(index_file.c_str(), new_index_meta, new_multi_field_metas);
+  } else if (index_type == IndexType::HASH) {
+    HashIndex *hash_index = new HashIndex(this);
+    index = hash_index;
+    rc = hash_index->create(index_file.c_str(), new_index_meta, new_multi_field_metas);
+  } else {
+    BplusTreeIndex *bplus_tree_index = new BplusTreeIndex(this);
+    index = bplus_tree_index;
+    rc = bplus_tree_index->create(index_file.c_str(), new_index_meta, new_multi_field_metas);
+  }
   if (rc != RC::SUCCESS) {
     delete index;
-    LOG_ERROR("Failed to create bplus tree index. file name=%s, rc=%d:%s", index_file.c_str(), rc, strrc(rc));
+    LOG_ERROR("Failed to create %s index. file name=%s, rc=%d:%s",
+        index_type_to_string(index_type), index_file.c_str(), rc, strrc(rc));
     return rc;
   }
 
-  // 遍历当前的所有数据，插入这个索引
+  // 遍历当前的所有数据，插入这个索引。
+  // 所有版本的记录都要放到索引中，由使用索引的事务判断可见性，所以这里扫描时不按照当前事务过滤
   RecordFileScanner scanner;
-  rc = get_record_scanner(scanner, trx, true/*readonly*/);
+  rc = get_record_scanner(scanner, nullptr, true/*readonly*/);
   if (rc != RC::SUCCESS) {
     LOG_WARN("failed to create scanner while creating index. table=%s, index=%s, rc=%s",
              name(), index_name, strrc(rc));
@@ -372,6 +457,7 @@ RC Table::insert_record(Record &record)
     LOG_ERROR("Insert record failed. table name=%s, rc=%s", table_meta_.name(), strrc(rc));
     return rc;
   }
+  zone_map_.on_insert(record.rid().page_num, record.data());
 
   rc = insert_entry_of_indexes(record.data(), record.rid());
   if (rc != RC::SUCCESS) {
@@ -382,7 +468,15 @@ RC Table::insert_record(Record &record)
     if (rc2 != RC::SUCCESS) {
       LOG_ERROR("Failed to delete record from index. table name=%s, rc=%s", table_meta_.name(), strrc(rc2));
     }
+    // 唯一索引冲突时记录已经写到了数据页面，也要删掉，否则表扫描还能看到它
+    rc2 = record_handler_->delete_record(&record.rid());
+    if (rc2 != RC::SUCCESS) {
+      LOG_ERROR("Failed to rollback record data when insert index entries failed. table name=%s, rc=%s",
+          table_meta_.name(), strrc(rc2));
+    }
+    return rc;
   }
+  stats_.on_insert();
   return rc;
 }
 
@@ -397,6 +491,9 @@ RC Table::delete_record(const Record &record)
   }
 
   rc = record_handler_->delete_record(&record.rid());
+  if (rc == RC::SUCCESS) {
+    stats_.on_delete();
+  }
   return rc;
 }
 
@@ -502,6 +599,46 @@ RC Table::get_record_scanner(RecordFileScanner &scanner, Trx *trx, bool readonly
   return rc;
 }
 
+RC Table::get_record_scanner(RecordFileScanner &scanner, Trx *trx, bool readonly, PageNum begin_page, PageNum end_page)
+{
+  RC rc = scanner.open_scan(this, *data_buffer_pool_, trx, readonly, nullptr, begin_page, end_page);
+  if (rc != RC::SUCCESS) {
+    LOG_ERROR("failed to open scanner. rc=%s", strrc(rc));
+  }
+  return rc;
+}
+
+RC Table::split_pages(int page_num_per_morsel, std::vector<std::pair<PageNum, PageNum>> &morsels) const
+{
+  BufferPoolIterator iterator;
+  RC rc = iterator.init(*data_buffer_pool_);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to init buffer pool iterator. table=%s, rc=%s", name(), strrc(rc));
+    return rc;
+  }
+
+  int page_count = 0;
+  while (iterator.has_next()) {
+    PageNum page_num = iterator.next();
+    if (page_count == 0) {
+      morsels.emplace_back(page_num, page_num + 1);
+    } else {
+      morsels.back().second = page_num + 1;
+    }
+    if (++page_count == page_num_per_morsel) {
+      page_count = 0;
+    }
+  }
+  return RC::SUCCESS;
+}
+
+int32_t Table::data_page_count() const
+{
+  if (data_buffer_pool_ == nullptr) {
+    return 0;
+  }
+  return std::max(data_buffer_pool_->allocated_page_count() - 1, 0);
+}
 
 Index *Table::find_index(const char *index_name) const
 {
@@ -523,8 +660,29 @@ Index *Table::find_index_by_field(const char *field_name) const
   return nullptr;
 }
 
+RC Table::analyze(Trx *trx, WorkerPool *worker_pool)
+{
+  std::vector<ColumnStats> columns;
+  int64_t rows = 0;
+  int64_t pages = 0;
+  RC rc = TableStats::analyze(this, trx, worker_pool, columns, rows, pages);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to analyze table. table=%s, rc=%s", name(), strrc(rc));
+    return rc;
+  }
+
+  stats_.set_analyzed(rows, pages, std::move(columns));
+  rc = stats_.save(table_stats_file(base_dir_.c_str(), name()));
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to save table stats. table=%s, rc=%s", name(), strrc(rc));
+    return rc;
+  }
+  LOG_INFO("Analyze table over. table=%s, rows=%ld, pages=%ld", name(), rows, pages);
+  return rc;
+}
+
 /**
- * 将索引数据刷到磁盘
+ * 将索引数据与统计信息刷到磁盘
  */
 RC Table::sync()
 {
@@ -540,6 +698,13 @@ RC Table::sync()
       return rc;
     }
   }
+  if (!is_view() && !base_dir_.empty()) {
+    rc = stats_.save(table_stats_file(base_dir_.c_str(), name()));
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("Failed to save table stats. table=%s, rc=%s", name(), strrc(rc));
+      return rc;
+    }
+  }
   LOG_INFO("Sync table over. table=%s", name());
   return rc;
 }
@@ -584,6 +749,8 @@ RC Table::change_record_value(char *&record, int idx, const Value &value) const
     if (copy_len > data_len) {
       copy_len = data_len + 1;
     }
+    // 字符串后面剩余的部分清零，索引按照整个字段的字节比较
+    memset(record + field->offset(), 0, field->len());
     memcpy(record + field->offset(), tmp.data(), copy_len);
   } else if (field->type() == INTS || field->type() == DATES || field->type() == BOOLEANS) {
     int tmp = value.get_int();
@@ -607,6 +774,7 @@ RC Table::recover_insert_record(Record &record)
     LOG_ERROR("Insert record failed. table name=%s, rc=%s", table_meta_.name(), strrc(rc));
     return rc;
   }
+  zone_map_.on_insert(record.rid().page_num, record.data());
 
   rc = insert_entry_of_indexes(record.data(), record.rid());
   if (rc != RC::SUCCESS) { // 可能出现了键值重复
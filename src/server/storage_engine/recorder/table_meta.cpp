@@ -224,10 +224,12 @@ const IndexMeta *TableMeta::index(const char *name) const
 const IndexMeta *TableMeta::find_index_by_field(const char *field) const
 {
   for (const IndexMeta &index : indexes_) {
-    // if (0 == strcmp(index.field(0), field)) {
-    //   return &index;
-    // }
-    if (0 == strcmp(index.multi_fields(), field)) {
+    // 只有B+树索引可以按照字段的顺序扫描，布隆过滤器与哈希索引都不行
+    if (index.type() != IndexType::BPLUS_TREE) {
+      continue;
+    }
+    // 键中除了这个字段只有系统字段时，索引的顺序就是这个字段的顺序
+    if (index.user_field_amount() == 1 && 0 == strcmp(index.field(0), field)) {
       return &index;
     }
   }
@@ -0,0 +1,771 @@
+#include "include/storage_engine/recorder/table_stats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <json/json.h>
+
+#include "common/lang/bitmap.h"
+#include "common/log/log.h"
+#include "include/common/worker_pool.h"
+#include "include/storage_engine/recorder/record_manager.h"
+#include "include/storage_engine/recorder/table.h"
+
+namespace {
+
+bool is_numeric(AttrType type)
+{
+  return type == INTS || type == FLOATS || type == DATES;
+}
+
+double numeric_value(const Value &value)
+{
+  if (value.attr_type() == INTS || value.attr_type() == DATES) {
+    return value.get_int();
+  }
+  return value.get_float();
+}
+
+uint64_t fmix64(uint64_t h)
+{
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return h;
+}
+
+void value_to_json(const Value &value, Json::Value &json)
+{
+  switch (value.attr_type()) {
+    case INTS:
+    case DATES:
+    case BOOLEANS: json = value.get_int(); break;
+    case FLOATS: json = value.get_float(); break;
+    default: json = value.get_string(); break;
+  }
+}
+
+void value_from_json(AttrType type, const Json::Value &json, Value &value)
+{
+  switch (type) {
+    case INTS: value.set_int(json.asInt()); break;
+    case DATES: value.set_date(json.asInt()); break;
+    case BOOLEANS: value.set_boolean(json.asInt() != 0); break;
+    case FLOATS: value.set_float(json.asFloat()); break;
+    default: value.set_string(json.asString().c_str()); break;
+  }
+}
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+uint64_t HyperLogLog::hash_value(const Value &value)
+{
+  // FNV-1a 的分布不够均匀，最后再做一次 murmur 的 finalizer
+  uint64_t h = 0xcbf29ce484222325ULL;
+  auto feed = [&h](const void *data, size_t len) {
+    const unsigned char *bytes = static_cast<const unsigned char *>(data);
+    for (size_t i = 0; i < len; i++) {
+      h ^= bytes[i];
+      h *= 0x100000001b3ULL;
+    }
+  };
+
+  switch (value.attr_type()) {
+    case FLOATS: {
+      float f = value.get_float();
+      if (f == 0) {
+        f = 0;  // -0.0 与 0.0 相等
+      }
+      feed(&f, sizeof(f));
+    } break;
+    case CHARS:
+    case TEXTS: {
+      std::string s = value.get_string();
+      feed(s.data(), s.size());
+    } break;
+    default: {
+      int v = value.get_int();
+      feed(&v, sizeof(v));
+    } break;
+  }
+  return fmix64(h);
+}
+
+void HyperLogLog::add(const Value &value)
+{
+  add_hash(hash_value(value));
+}
+
+void HyperLogLog::add_hash(uint64_t hash)
+{
+  const uint32_t index = hash >> (64 - PRECISION);
+  const uint64_t rest = (hash << PRECISION) | (1ULL << (PRECISION - 1));
+  const uint8_t rank = __builtin_clzll(rest) + 1;
+  if (registers_[index] < rank) {
+    registers_[index] = rank;
+  }
+}
+
+void HyperLogLog::merge(const HyperLogLog &other)
+{
+  for (int i = 0; i < REGISTER_NUM; i++) {
+    registers_[i] = std::max(registers_[i], other.registers_[i]);
+  }
+}
+
+double HyperLogLog::estimate() const
+{
+  const double m = REGISTER_NUM;
+  double sum = 0;
+  int zeros = 0;
+  for (uint8_t r : registers_) {
+    sum += std::ldexp(1.0, -r);
+    if (r == 0) {
+      zeros++;
+    }
+  }
+
+  const double alpha = 0.7213 / (1 + 1.079 / m);
+  double estimate = alpha * m * m / sum;
+  if (estimate <= 2.5 * m && zeros > 0) {
+    // 基数较小时使用线性计数
+    estimate = m * std::log(m / zeros);
+  }
+  return estimate;
+}
+
+std::string HyperLogLog::to_string() const
+{
+  static const char *digits = "0123456789abcdef";
+  std::string str;
+  str.reserve(REGISTER_NUM * 2);
+  for (uint8_t r : registers_) {
+    str.push_back(digits[r >> 4]);
+    str.push_back(digits[r & 0xf]);
+  }
+  return str;
+}
+
+RC HyperLogLog::from_string(const std::string &str)
+{
+  if (str.size() != REGISTER_NUM * 2) {
+    return RC::INVALID_ARGUMENT;
+  }
+  auto hex = [](char c) -> int {
+    if (c >= '0' && c <= '9') {
+      return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+      return c - 'a' + 10;
+    }
+    return -1;
+  };
+  for (int i = 0; i < REGISTER_NUM; i++) {
+    int high = hex(str[2 * i]);
+    int low = hex(str[2 * i + 1]);
+    if (high < 0 || low < 0) {
+      return RC::INVALID_ARGUMENT;
+    }
+    registers_[i] = (high << 4) | low;
+  }
+  return RC::SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+double ColumnStats::eq_selectivity(const Value &value) const
+{
+  for (size_t i = 0; i < mcv_values.size(); i++) {
+    if (mcv_values[i].compare(value) == 0) {
+      return mcv_freqs[i];
+    }
+  }
+
+  if (histogram.empty()) {
+    return 0;
+  }
+  if (value.compare(histogram.front()) < 0 || value.compare(histogram.back()) > 0) {
+    return 0;
+  }
+
+  // 其余的值平均分配剩下的行
+  double rest_ndv = std::max(ndv - (double)mcv_values.size(), 1.0);
+  return std::max(histogram_frac, 0.0) / rest_ndv;
+}
+
+double ColumnStats::histogram_position(const Value &value) const
+{
+  const int bucket_num = static_cast<int>(histogram.size()) - 1;
+  if (bucket_num <= 0) {
+    if (histogram.empty()) {
+      return 0;
+    }
+    return value.compare(histogram.front()) > 0 ? 1 : 0;
+  }
+  if (value.compare(histogram.front()) <= 0) {
+    return 0;
+  }
+  if (value.compare(histogram.back()) >= 0) {
+    return 1;
+  }
+
+  // 找到第一个大于 value 的边界，value 落在它前面的那个桶中
+  auto iter = std::upper_bound(histogram.begin(), histogram.end(), value,
+      [](const Value &v, const Value &bound) { return v.compare(bound) < 0; });
+  const int bucket = static_cast<int>(iter - histogram.begin()) - 1;
+  const Value &low = histogram[bucket];
+  const Value &high = histogram[bucket + 1];
+
+  double fraction = 0.5;
+  if (is_numeric(type) && is_numeric(value.attr_type())) {
+    double l = numeric_value(low);
+    double h = numeric_value(high);
+    if (h > l) {
+      fraction = (numeric_value(value) - l) / (h - l);
+    }
+  }
+  return (bucket + fraction) / bucket_num;
+}
+
+double ColumnStats::less_selectivity(const Value &value, bool inclusive) const
+{
+  double selectivity = 0;
+  for (size_t i = 0; i < mcv_values.size(); i++) {
+    int cmp = mcv_values[i].compare(value);
+    if (cmp < 0 || (inclusive && cmp == 0)) {
+      selectivity += mcv_freqs[i];
+    }
+  }
+  selectivity += histogram_frac * histogram_position(value);
+  return selectivity;
+}
+
+double ColumnStats::selectivity(CompOp op, const Value &value) const
+{
+  const double not_null = 1 - null_frac;
+  double selectivity = DEFAULT_SELECTIVITY;
+  switch (op) {
+    case EQUAL_TO: selectivity = eq_selectivity(value); break;
+    case NOT_EQUAL: selectivity = not_null - eq_selectivity(value); break;
+    case LESS_THAN: selectivity = less_selectivity(value, false); break;
+    case LESS_EQUAL: selectivity = less_selectivity(value, true); break;
+    case GREAT_THAN: selectivity = not_null - less_selectivity(value, true); break;
+    case GREAT_EQUAL: selectivity = not_null - less_selectivity(value, false); break;
+    case IS_NULL: selectivity = null_frac; break;
+    case IS_NOT_NULL: selectivity = not_null; break;
+    default: break;
+  }
+  return std::min(std::max(selectivity, 0.0), 1.0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TableStats::init_empty()
+{
+  std::lock_guard<std::mutex> guard(lock_);
+  row_count_known_ = true;
+  analyzed_ = false;
+  base_rows_ = 0;
+  pages_ = 0;
+  columns_.reset();
+  inserted_.store(0);
+  deleted_.store(0);
+}
+
+int64_t TableStats::row_count() const
+{
+  int64_t base_rows = 0;
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    base_rows = base_rows_;
+  }
+  return std::max<int64_t>(base_rows + inserted_.load() - deleted_.load(), 0);
+}
+
+bool TableStats::analyzed() const
+{
+  std::lock_guard<std::mutex> guard(lock_);
+  return analyzed_;
+}
+
+int64_t TableStats::page_count() const
+{
+  std::lock_guard<std::mutex> guard(lock_);
+  return pages_;
+}
+
+int64_t TableStats::modified_rows() const
+{
+  return inserted_.load() + deleted_.load();
+}
+
+bool TableStats::column(const char *name, ColumnStats &stats) const
+{
+  std::shared_ptr<const std::vector<ColumnStats>> columns;
+  int64_t base_rows = 0;
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    columns = columns_;
+    base_rows = base_rows_;
+  }
+  if (!columns) {
+    return false;
+  }
+
+  for (const ColumnStats &column : *columns) {
+    if (column.name != name) {
+      continue;
+    }
+    stats = column;
+    const int64_t rows = row_count();
+    const double not_null_rows = base_rows * (1 - column.null_frac);
+    if (base_rows > 0 && rows != base_rows && column.ndv >= 0.9 * not_null_rows) {
+      stats.ndv = column.ndv * rows / base_rows;
+    }
+    return true;
+  }
+  return false;
+}
+
+void TableStats::set_analyzed(int64_t rows, int64_t pages, std::vector<ColumnStats> &&columns)
+{
+  auto new_columns = std::make_shared<const std::vector<ColumnStats>>(std::move(columns));
+  std::lock_guard<std::mutex> guard(lock_);
+  row_count_known_ = true;
+  analyzed_ = true;
+  base_rows_ = rows;
+  pages_ = pages;
+  columns_ = std::move(new_columns);
+  inserted_.store(0);
+  deleted_.store(0);
+}
+
+RC TableStats::save(const std::string &file) const
+{
+  Json::Value root;
+  std::shared_ptr<const std::vector<ColumnStats>> columns;
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    root["row_count_known"] = row_count_known_;
+    root["analyzed"] = analyzed_;
+    root["rows"] = (Json::Int64)base_rows_;
+    root["pages"] = (Json::Int64)pages_;
+    columns = columns_;
+  }
+  root["inserted"] = (Json::Int64)inserted_.load();
+  root["deleted"] = (Json::Int64)deleted_.load();
+
+  Json::Value columns_value(Json::arrayValue);
+  if (columns) {
+    for (const ColumnStats &column : *columns) {
+      Json::Value column_value;
+      column_value["name"] = column.name;
+      column_value["type"] = attr_type_to_string(column.type);
+      column_value["null_frac"] = column.null_frac;
+      column_value["ndv"] = column.ndv;
+      column_value["hll"] = column.hll.to_string();
+
+      Json::Value mcv_value(Json::arrayValue);
+      for (size_t i = 0; i < column.mcv_values.size(); i++) {
+        Json::Value item;
+        value_to_json(column.mcv_values[i], item["value"]);
+        item["freq"] = column.mcv_freqs[i];
+        mcv_value.append(std::move(item));
+      }
+      column_value["mcv"] = std::move(mcv_value);
+
+      Json::Value histogram_value(Json::arrayValue);
+      for (const Value &bound : column.histogram) {
+        Json::Value item;
+        value_to_json(bound, item);
+        histogram_value.append(std::move(item));
+      }
+      column_value["histogram"] = std::move(histogram_value);
+      column_value["histogram_frac"] = column.histogram_frac;
+      columns_value.append(std::move(column_value));
+    }
+  }
+  root["columns"] = std::move(columns_value);
+
+  // 先写临时文件再重命名，避免写到一半时宕机留下不完整的文件
+  std::string tmp_file = file + ".tmp";
+  std::fstream fs;
+  fs.open(tmp_file, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+  if (!fs.is_open()) {
+    LOG_ERROR("Failed to open stats file for write. file name=%s, errmsg=%s", tmp_file.c_str(), strerror(errno));
+    return RC::IOERR_OPEN;
+  }
+  Json::StreamWriterBuilder builder;
+  std::unique_ptr<Json::StreamWriter> writer(builder.newStreamWriter());
+  writer->write(root, &fs);
+  fs.close();
+  if (fs.fail()) {
+    LOG_ERROR("Failed to write stats file. file name=%s", tmp_file.c_str());
+    return RC::IOERR_WRITE;
+  }
+
+  if (rename(tmp_file.c_str(), file.c_str()) != 0) {
+    LOG_ERROR("Failed to rename stats file. from=%s, to=%s, errmsg=%s", tmp_file.c_str(), file.c_str(), strerror(errno));
+    return RC::IOERR_WRITE;
+  }
+  return RC::SUCCESS;
+}
+
+RC TableStats::load(const std::string &file)
+{
+  std::fstream fs;
+  fs.open(file, std::ios_base::in | std::ios_base::binary);
+  if (!fs.is_open()) {
+    return RC::FILE_NOT_EXIST;
+  }
+
+  Json::Value root;
+  Json::CharReaderBuilder builder;
+  std::string errors;
+  if (!Json::parseFromStream(builder, fs, &root, &errors)) {
+    LOG_WARN("Failed to parse stats file. file=%s, error=%s", file.c_str(), errors.c_str());
+    return RC::INTERNAL;
+  }
+
+  std::vector<ColumnStats> columns;
+  const Json::Value &columns_value = root["columns"];
+  for (Json::ArrayIndex i = 0; i < columns_value.size(); i++) {
+    const Json::Value &column_value = columns_value[i];
+    ColumnStats column;
+    column.name = column_value["name"].asString();
+    column.type = attr_type_from_string(column_value["type"].asCString());
+    column.null_frac = column_value["null_frac"].asDouble();
+    column.ndv = column_value["ndv"].asDouble();
+    if (column.hll.from_string(column_value["hll"].asString()) != RC::SUCCESS) {
+      LOG_WARN("Invalid hyperloglog in stats file. file=%s, column=%s", file.c_str(), column.name.c_str());
+    }
+
+    const Json::Value &mcv_value = column_value["mcv"];
+    for (Json::ArrayIndex j = 0; j < mcv_value.size(); j++) {
+      Value value;
+      value_from_json(column.type, mcv_value[j]["value"], value);
+      column.mcv_values.push_back(value);
+      column.mcv_freqs.push_back(mcv_value[j]["freq"].asDouble());
+    }
+
+    const Json::Value &histogram_value = column_value["histogram"];
+    for (Json::ArrayIndex j = 0; j < histogram_value.size(); j++) {
+      Value value;
+      value_from_json(column.type, histogram_value[j], value);
+      column.histogram.push_back(value);
+    }
+    column.histogram_frac = column_value["histogram_frac"].asDouble();
+    columns.push_back(std::move(column));
+  }
+
+  std::lock_guard<std::mutex> guard(lock_);
+  row_count_known_ = root["row_count_known"].asBool();
+  analyzed_ = root["analyzed"].asBool();
+  base_rows_ = root["rows"].asInt64();
+  pages_ = root["pages"].asInt64();
+  columns_ = analyzed_ ? std::make_shared<const std::vector<ColumnStats>>(std::move(columns)) : nullptr;
+  inserted_.store(root["inserted"].asInt64());
+  deleted_.store(root["deleted"].asInt64());
+  return RC::SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/**
+ * @brief 一个扫描线程收集到的数据
+ * @details 每一列的空值个数与 HyperLogLog 是精确合并的，样本使用蓄水池抽样
+ */
+struct StatsCollector
+{
+  int64_t rows = 0;
+  std::vector<int64_t> null_counts;
+  std::vector<HyperLogLog> hlls;
+  std::vector<std::vector<Value>> samples;  ///< 每个样本是一行中所有用户字段的值
+  std::mt19937_64 random;
+
+  StatsCollector(int column_num, uint64_t seed) : null_counts(column_num, 0), hlls(column_num), random(seed) {}
+
+  void add_row(std::vector<Value> &row)
+  {
+    for (size_t i = 0; i < row.size(); i++) {
+      if (row[i].is_null()) {
+        null_counts[i]++;
+      } else if (row[i].attr_type() != TEXTS) {
+        hlls[i].add(row[i]);
+      }
+    }
+
+    rows++;
+    if (samples.size() < STATS_SAMPLE_ROWS) {
+      samples.push_back(row);
+    } else {
+      uint64_t pos = random() % rows;
+      if (pos < STATS_SAMPLE_ROWS) {
+        samples[pos] = row;
+      }
+    }
+  }
+};
+
+/**
+ * @brief 把各个线程的样本合并成一个
+ * @details 每个线程的样本代表的行数不同，按照 rows/样本数 作为权重做加权抽样(A-ES 算法)
+ */
+void merge_samples(std::vector<std::unique_ptr<StatsCollector>> &collectors, std::vector<std::vector<Value>> &samples)
+{
+  std::mt19937_64 random(0x5eed);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  std::vector<std::pair<double, std::vector<Value> *>> keyed;
+  for (auto &collector : collectors) {
+    if (collector->samples.empty()) {
+      continue;
+    }
+    const double weight = (double)collector->rows / collector->samples.size();
+    for (auto &row : collector->samples) {
+      double key = std::pow(std::max(uniform(random), 1e-300), 1.0 / weight);
+      keyed.emplace_back(key, &row);
+    }
+  }
+
+  if (keyed.size() > STATS_SAMPLE_ROWS) {
+    std::nth_element(keyed.begin(), keyed.begin() + STATS_SAMPLE_ROWS, keyed.end(),
+        [](const auto &a, const auto &b) { return a.first > b.first; });
+    keyed.resize(STATS_SAMPLE_ROWS);
+  }
+  samples.reserve(keyed.size());
+  for (auto &item : keyed) {
+    samples.push_back(std::move(*item.second));
+  }
+}
+
+void build_column_stats(int column, int64_t total_rows, int64_t null_count, const HyperLogLog &hll,
+    const std::vector<std::vector<Value>> &samples, ColumnStats &stats)
+{
+  stats.hll = hll;
+  stats.null_frac = total_rows > 0 ? (double)null_count / total_rows : 0;
+  if (stats.type == TEXTS || samples.empty()) {
+    stats.ndv = 0;
+    return;
+  }
+
+  std::vector<Value> values;
+  for (const auto &row : samples) {
+    if (!row[column].is_null()) {
+      values.push_back(row[column]);
+    }
+  }
+  std::sort(values.begin(), values.end(), [](const Value &a, const Value &b) { return a.compare(b) < 0; });
+
+  const double not_null_rows = total_rows - null_count;
+  stats.ndv = std::min(std::max(hll.estimate(), values.empty() ? 0.0 : 1.0), not_null_rows);
+  if (values.empty()) {
+    return;
+  }
+
+  // 统计样本中每个值出现的次数
+  std::vector<std::pair<size_t, size_t>> groups;  // (起始位置, 次数)
+  for (size_t i = 0; i < values.size(); i++) {
+    if (i == 0 || values[i].compare(values[i - 1]) != 0) {
+      groups.emplace_back(i, 1);
+    } else {
+      groups.back().second++;
+    }
+  }
+
+  // 出现次数明显高于平均值的作为高频值
+  const double sample_rows = samples.size();
+  const double average = values.size() / std::min<double>(stats.ndv, groups.size());
+  std::vector<size_t> candidates;
+  for (size_t i = 0; i < groups.size(); i++) {
+    if (groups[i].second >= 2 && groups[i].second > 1.25 * average) {
+      candidates.push_back(i);
+    }
+  }
+  std::sort(candidates.begin(), candidates.end(),
+      [&groups](size_t a, size_t b) { return groups[a].second > groups[b].second; });
+  if (candidates.size() > STATS_MCV_NUM) {
+    candidates.resize(STATS_MCV_NUM);
+  }
+
+  std::vector<bool> is_mcv(groups.size(), false);
+  for (size_t index : candidates) {
+    is_mcv[index] = true;
+    stats.mcv_values.push_back(values[groups[index].first]);
+    stats.mcv_freqs.push_back(groups[index].second / sample_rows);
+  }
+
+  std::vector<const Value *> rest;
+  for (size_t i = 0; i < groups.size(); i++) {
+    if (!is_mcv[i]) {
+      for (size_t j = 0; j < groups[i].second; j++) {
+        rest.push_back(&values[groups[i].first + j]);
+      }
+    }
+  }
+  stats.histogram_frac = rest.size() / sample_rows;
+  if (rest.empty()) {
+    return;
+  }
+
+  const size_t bucket_num = std::min<size_t>(STATS_HISTOGRAM_BUCKETS, rest.size());
+  for (size_t i = 0; i <= bucket_num; i++) {
+    size_t pos = i * (rest.size() - 1) / bucket_num;
+    stats.histogram.push_back(*rest[pos]);
+  }
+}
+
+}  // namespace
+
+RC TableStats::analyze(Table *table, Trx *trx, WorkerPool *worker_pool, std::vector<ColumnStats> &columns,
+    int64_t &rows, int64_t &pages)
+{
+  const TableMeta &table_meta = table->table_meta();
+  const int field_begin = table_meta.sys_field_num();
+  const int field_end = table_meta.field_num() - table_meta.null_filed_num();
+  const int column_num = field_end - field_begin;
+  const FieldMeta *null_field = table_meta.null_bitmap_field();
+
+  std::vector<std::pair<PageNum, PageNum>> page_list;
+  RC rc = table->split_pages(1, page_list);
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+  pages = page_list.size();
+
+  // 任务可能在当前函数返回之后才被线程池调度，因此共享的状态由任务自己持有一份
+  struct AnalyzeState
+  {
+    std::mutex lock;
+    std::condition_variable cond;
+    int running = 0;
+    bool closed = false;
+    RC rc = RC::SUCCESS;
+    std::atomic<size_t> next_morsel{0};
+    std::vector<std::unique_ptr<StatsCollector>> collectors;
+  };
+  auto state = std::make_shared<AnalyzeState>();
+
+  const size_t morsel_pages = 16;
+  const size_t morsel_num = (page_list.size() + morsel_pages - 1) / morsel_pages;
+#ifdef CONCURRENCY
+  const int dop = worker_pool == nullptr ? 1 : std::max(1, std::min<int>(worker_pool->thread_num(), morsel_num));
+#else
+  // 没有打开并发编译选项时缓冲池的锁是空操作，只能在当前线程中扫描
+  const int dop = 1;
+#endif
+  for (int i = 0; i < dop; i++) {
+    state->collectors.emplace_back(new StatsCollector(column_num, 0x9e3779b97f4a7c15ULL * (i + 1)));
+  }
+
+  const TableMeta *meta = &table_meta;
+  auto run = [=](StatsCollector &collector) -> RC {
+    std::vector<Value> row(column_num);
+    size_t morsel = 0;
+    while ((morsel = state->next_morsel.fetch_add(1)) < morsel_num) {
+      const size_t first = morsel * morsel_pages;
+      const size_t last = std::min(first + morsel_pages, page_list.size()) - 1;
+
+      RecordFileScanner scanner;
+      RC rc = table->get_record_scanner(scanner, trx, true, page_list[first].first, page_list[last].second);
+      if (rc != RC::SUCCESS) {
+        return rc;
+      }
+      Record record;
+      while (scanner.has_next()) {
+        rc = scanner.next(record);
+        if (rc != RC::SUCCESS) {
+          break;
+        }
+        common::Bitmap bitmap(record.data() + null_field->offset(), null_field->len());
+        for (int i = 0; i < column_num; i++) {
+          const FieldMeta *field = meta->field(field_begin + i);
+          if (bitmap.get_bit(field_begin + i)) {
+            row[i].set_null();
+          } else {
+            row[i].set_type(field->type());
+            row[i].set_data(record.data() + field->offset(), field->len());
+          }
+        }
+        collector.add_row(row);
+      }
+      scanner.close_scan();
+      if (rc != RC::SUCCESS && rc != RC::RECORD_EOF) {
+        return rc;
+      }
+    }
+    return RC::SUCCESS;
+  };
+
+  for (int i = 1; i < dop; i++) {
+    worker_pool->submit([state, i, run]() {
+      {
+        std::lock_guard<std::mutex> guard(state->lock);
+        if (state->closed) {
+          return;
+        }
+        state->running++;
+      }
+
+      RC rc = run(*state->collectors[i]);
+      if (rc != RC::SUCCESS) {
+        state->next_morsel.store(SIZE_MAX / 2);
+      }
+
+      std::lock_guard<std::mutex> guard(state->lock);
+      if (rc != RC::SUCCESS && state->rc == RC::SUCCESS) {
+        state->rc = rc;
+      }
+      state->running--;
+      state->cond.notify_all();
+    });
+  }
+
+  // 当前线程也参与扫描，结束时所有的页面段都已经被取走了，没有开始的任务可以直接丢弃
+  rc = run(*state->collectors[0]);
+  {
+    std::unique_lock<std::mutex> guard(state->lock);
+    state->closed = true;
+    state->cond.wait(guard, [&state]() { return state->running == 0; });
+    if (rc == RC::SUCCESS) {
+      rc = state->rc;
+    }
+  }
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to scan table for analyze. table=%s, rc=%s", table->name(), strrc(rc));
+    return rc;
+  }
+
+  auto &collectors = state->collectors;
+  rows = 0;
+  std::vector<int64_t> null_counts(column_num, 0);
+  std::vector<HyperLogLog> hlls(column_num);
+  for (auto &collector : collectors) {
+    rows += collector->rows;
+    for (int i = 0; i < column_num; i++) {
+      null_counts[i] += collector->null_counts[i];
+      hlls[i].merge(collector->hlls[i]);
+    }
+  }
+
+  std::vector<std::vector<Value>> samples;
+  merge_samples(collectors, samples);
+
+  columns.clear();
+  columns.resize(column_num);
+  for (int i = 0; i < column_num; i++) {
+    const FieldMeta *field = table_meta.field(field_begin + i);
+    columns[i].name = field->name();
+    columns[i].type = field->type();
+    build_column_stats(i, rows, null_counts[i], hlls[i], samples, columns[i]);
+  }
+  return RC::SUCCESS;
+}
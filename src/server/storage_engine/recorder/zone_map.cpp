@@ -0,0 +1,196 @@
+#include "include/storage_engine/recorder/zone_map.h"
+
+#include <mutex>
+
+#include "common/lang/bitmap.h"
+#include "common/log/log.h"
+#include "include/storage_engine/recorder/record_manager.h"
+#include "include/storage_engine/recorder/table.h"
+
+namespace {
+
+/// 整数与浮点数之间的转换保持大小关系，可以用另一种类型的常量与范围比较
+bool comparable(AttrType column_type, AttrType value_type)
+{
+  if (column_type == value_type) {
+    return true;
+  }
+  const bool column_numeric = column_type == INTS || column_type == FLOATS;
+  const bool value_numeric = value_type == INTS || value_type == FLOATS;
+  return column_numeric && value_numeric;
+}
+
+/// 记录精确的范围。浮点数的 Value::compare 把差值在 EPSILON 以内的数当作相等，不能用于维护边界
+bool less_than(const Value &left, const Value &right)
+{
+  if (left.attr_type() == FLOATS) {
+    return left.get_float() < right.get_float();
+  }
+  return left.compare(right) < 0;
+}
+
+}  // namespace
+
+RC ZoneMap::build(Table *table)
+{
+  const TableMeta &table_meta = table->table_meta();
+  const int field_begin = table_meta.sys_field_num();
+  const int field_end = table_meta.field_num() - table_meta.null_filed_num();
+  const FieldMeta *null_field = table_meta.null_bitmap_field();
+
+  std::unique_lock<std::shared_mutex> guard(lock_);
+  built_ = false;
+  pages_.clear();
+  columns_.clear();
+  column_of_field_.assign(table_meta.field_num(), -1);
+  null_offset_ = null_field->offset();
+  null_len_ = null_field->len();
+  for (int i = field_begin; i < field_end; i++) {
+    const FieldMeta *field = table_meta.field(i);
+    // 长文本只保存了存放位置，不记录范围
+    if (field->type() == TEXTS) {
+      continue;
+    }
+    column_of_field_[i] = static_cast<int>(columns_.size());
+    columns_.push_back(Column{i, field->type(), field->offset(), field->len()});
+  }
+
+  RecordFileScanner scanner;
+  RC rc = table->get_record_scanner(scanner, nullptr /*trx*/, true /*readonly*/);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to open scanner to build zone map. table=%s, rc=%s", table->name(), strrc(rc));
+    return rc;
+  }
+
+  Record record;
+  while (scanner.has_next()) {
+    rc = scanner.next(record);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to scan record to build zone map. table=%s, rc=%s", table->name(), strrc(rc));
+      return rc;
+    }
+    PageZone &zone = pages_[record.rid().page_num];
+    if (zone.empty()) {
+      zone.resize(columns_.size());
+    }
+    widen(zone, record.data());
+  }
+  scanner.close_scan();
+
+  built_ = true;
+  LOG_INFO("build zone map done. table=%s, pages=%d", table->name(), static_cast<int>(pages_.size()));
+  return RC::SUCCESS;
+}
+
+void ZoneMap::on_insert(PageNum page_num, const char *record)
+{
+  std::unique_lock<std::shared_mutex> guard(lock_);
+  if (!built_) {
+    return;
+  }
+  PageZone &zone = pages_[page_num];
+  if (zone.empty()) {
+    zone.resize(columns_.size());
+  }
+  widen(zone, record);
+}
+
+void ZoneMap::widen(PageZone &zone, const char *record) const
+{
+  common::Bitmap null_bitmap(const_cast<char *>(record) + null_offset_, null_len_);
+  Value value;
+  for (size_t i = 0; i < columns_.size(); i++) {
+    const Column &column = columns_[i];
+    ColumnZone &column_zone = zone[i];
+    if (null_bitmap.get_bit(column.field_index)) {
+      column_zone.null_count++;
+      continue;
+    }
+
+    value.set_type(column.type);
+    value.set_data(record + column.offset, column.len);
+    if (!column_zone.has_value) {
+      column_zone.has_value = true;
+      column_zone.min = value;
+      column_zone.max = value;
+    } else if (less_than(value, column_zone.min)) {
+      column_zone.min = value;
+    } else if (less_than(column_zone.max, value)) {
+      column_zone.max = value;
+    }
+  }
+}
+
+bool ZoneMap::may_match(PageNum page_num, const ZonePredicate &predicate) const
+{
+  std::shared_lock<std::shared_mutex> guard(lock_);
+  if (!built_) {
+    return true;
+  }
+  auto iter = pages_.find(page_num);
+  if (iter == pages_.end()) {
+    return true;
+  }
+  return may_match(iter->second, predicate);
+}
+
+bool ZoneMap::may_match(const PageZone &zone, const ZonePredicate &predicate) const
+{
+  switch (predicate.kind) {
+    case ZonePredicate::Kind::AND: {
+      for (const ZonePredicate &child : predicate.children) {
+        if (!may_match(zone, child)) {
+          return false;
+        }
+      }
+      return true;
+    }
+    case ZonePredicate::Kind::OR: {
+      for (const ZonePredicate &child : predicate.children) {
+        if (may_match(zone, child)) {
+          return true;
+        }
+      }
+      return predicate.children.empty();
+    }
+    case ZonePredicate::Kind::COMPARE: {
+      if (predicate.field_index < 0 || predicate.field_index >= static_cast<int>(column_of_field_.size()) ||
+          column_of_field_[predicate.field_index] < 0) {
+        return true;
+      }
+      const int column = column_of_field_[predicate.field_index];
+      return may_match(zone[column], columns_[column].type, predicate.comp, predicate.value);
+    }
+  }
+  return true;
+}
+
+bool ZoneMap::may_match(const ColumnZone &zone, AttrType type, CompOp comp, const Value &value) const
+{
+  if (comp == IS_NULL) {
+    return zone.null_count > 0;
+  }
+  if (comp == IS_NOT_NULL) {
+    return zone.has_value;
+  }
+  if (comp > GREAT_THAN) {
+    return true;
+  }
+  // 与 NULL 的比较结果总是假
+  if (!zone.has_value || value.is_null()) {
+    return false;
+  }
+  if (!comparable(type, value.attr_type())) {
+    return true;
+  }
+
+  switch (comp) {
+    case EQUAL_TO: return zone.min.compare(value) <= 0 && zone.max.compare(value) >= 0;
+    case NOT_EQUAL: return zone.min.compare(value) != 0 || zone.max.compare(value) != 0;
+    case LESS_THAN: return zone.min.compare(value) < 0;
+    case LESS_EQUAL: return zone.min.compare(value) <= 0;
+    case GREAT_THAN: return zone.max.compare(value) > 0;
+    case GREAT_EQUAL: return zone.max.compare(value) >= 0;
+    default: return true;
+  }
+}
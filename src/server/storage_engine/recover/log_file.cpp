@@ -1,4 +1,5 @@
 #include "include/storage_engine/recover/log_file.h"
+#include "include/common/query_stats.h"
 
 using namespace std;
 using namespace common;
@@ -20,6 +21,9 @@ RC LogBuffer::append_log_entry(LogEntry *log_entry)
   lock_guard<Mutex> lock_guard(lock_);
   log_entrys_.emplace_back(log_entry);
   total_size_ += log_entry->log_entry_len();
+  if (QueryStats *stats = QueryStats::current()) {
+    stats->log_bytes.fetch_add(sizeof(LogEntryHeader) + log_entry->log_entry_len(), std::memory_order_relaxed);
+  }
   LOG_DEBUG("append log. log_entry={%s}", log_entry->to_string().c_str());
   return RC::SUCCESS;
 }
@@ -1,4 +1,5 @@
 #include "include/storage_engine/schema/database.h"
+#include "include/storage_engine/schema/system_table.h"
 
 Db::~Db()
 {
@@ -70,6 +71,7 @@ RC Db::create_table(const char *table_name, int attribute_count, const AttrInfoS
   }
 
   opened_tables_[table_name] = table;
+  bump_schema_version();
   LOG_INFO("Create table success. table name=%s, table_id:%d", table_name, table_id);
   return RC::SUCCESS;
 }
@@ -94,6 +96,7 @@ RC Db::create_view(const char *view_name, const char *origin_table_name, SelectS
   }
 
   opened_tables_[view_name] = view;
+  bump_schema_version();
   LOG_INFO("Create view success. view name=%s, table_id:%d", view_name, table_id);
   return RC::SUCCESS;
 }
@@ -116,6 +119,7 @@ RC Db::drop_table(const char *table_name)
   }
 
   opened_tables_.erase(table_name);
+  bump_schema_version();
   delete table;
   LOG_INFO("Drop table success. table name=%s", table_name);
   return RC::SUCCESS;
@@ -127,7 +131,7 @@ Table *Db::find_table(const char *table_name) const
   if (iter != opened_tables_.end()) {
     return iter->second;
   }
-  return nullptr;
+  return SystemTables::instance().find(table_name);
 }
 
 Table *Db::find_table(int32_t table_id) const
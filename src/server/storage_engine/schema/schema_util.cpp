@@ -13,3 +13,8 @@ std::string table_index_file(const char *base_dir, const char *table_name, const
 {
   return std::string(base_dir) + common::FILE_PATH_SPLIT_STR + table_name + "-" + index_name + TABLE_INDEX_SUFFIX;
 }
+
+std::string table_stats_file(const char *base_dir, const char *table_name)
+{
+  return std::string(base_dir) + common::FILE_PATH_SPLIT_STR + table_name + TABLE_STATS_SUFFIX;
+}
@@ -0,0 +1,48 @@
+#include "include/storage_engine/schema/system_table.h"
+
+#include <string.h>
+
+#include "common/log/log.h"
+
+SystemTables &SystemTables::instance()
+{
+  static SystemTables instance;
+  return instance;
+}
+
+RC SystemTables::add(const char *name, int attribute_count, const AttrInfoSqlNode attributes[], SystemRecordLoader loader)
+{
+  std::lock_guard<std::mutex> guard(lock_);
+  for (const std::unique_ptr<Table> &table : tables_) {
+    if (0 == strcmp(table->name(), name)) {
+      LOG_WARN("system table already exists. name=%s", name);
+      return RC::SCHEMA_TABLE_EXIST;
+    }
+  }
+
+  auto table = std::make_unique<Table>();
+  const int32_t table_id = SYSTEM_TABLE_ID_BEGIN + static_cast<int32_t>(tables_.size());
+  RC rc = table->create_system(table_id, name, attribute_count, attributes, std::move(loader));
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+  tables_.push_back(std::move(table));
+  return rc;
+}
+
+Table *SystemTables::find(const char *name) const
+{
+  std::lock_guard<std::mutex> guard(lock_);
+  for (const std::unique_ptr<Table> &table : tables_) {
+    if (0 == strcmp(table->name(), name)) {
+      return table.get();
+    }
+  }
+  return nullptr;
+}
+
+void SystemTables::clear()
+{
+  std::lock_guard<std::mutex> guard(lock_);
+  tables_.clear();
+}
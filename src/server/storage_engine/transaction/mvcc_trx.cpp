@@ -1,5 +1,6 @@
 #include "include/storage_engine/transaction/mvcc_trx.h"
 #include "include/storage_engine/schema/database.h"
+#include "include/storage_engine/recorder/record_manager.h"
 
 using namespace std;
 
@@ -10,6 +11,10 @@ MvccTrxManager::~MvccTrxManager()
   for (Trx *trx : tmp_trxes) {
     delete trx;
   }
+  for (MvccTrx *trx : free_trxes_) {
+    delete trx;
+  }
+  free_trxes_.clear();
 }
 
 RC MvccTrxManager::init()
@@ -29,12 +34,23 @@ const vector<FieldMeta> *MvccTrxManager::trx_fields() const
 
 Trx *MvccTrxManager::create_trx(LogManager *log_manager)
 {
-  Trx *trx = new MvccTrx(*this, log_manager);
+  MvccTrx *trx = nullptr;
+  lock_.lock();
+  if (!free_trxes_.empty()) {
+    trx = free_trxes_.back();
+    free_trxes_.pop_back();
+  }
+  lock_.unlock();
+
   if (trx != nullptr) {
-    lock_.lock();
-    trxes_.push_back(trx);
-    lock_.unlock();
+    trx->reinit(log_manager);
+  } else {
+    trx = new MvccTrx(*this, log_manager);
   }
+
+  lock_.lock();
+  trxes_.push_back(trx);
+  lock_.unlock();
   return trx;
 }
 
@@ -54,6 +70,8 @@ Trx *MvccTrxManager::create_trx(int32_t trx_id)
 
 void MvccTrxManager::destroy_trx(Trx *trx)
 {
+  // 这里只会有 MvccTrx 对象
+  MvccTrx *mvcc_trx = static_cast<MvccTrx *>(trx);
   lock_.lock();
   for (auto iter = trxes_.begin(), itend = trxes_.end(); iter != itend; ++iter) {
     if (*iter == trx) {
@@ -61,8 +79,12 @@ void MvccTrxManager::destroy_trx(Trx *trx)
       break;
     }
   }
+  if (mvcc_trx->reusable() && free_trxes_.size() < MAX_FREE_TRX_NUM) {
+    free_trxes_.push_back(mvcc_trx);
+    mvcc_trx = nullptr;
+  }
   lock_.unlock();
-  delete trx;
+  delete mvcc_trx;
 }
 
 Trx *MvccTrxManager::find_trx(int32_t trx_id)
@@ -90,7 +112,7 @@ int32_t MvccTrxManager::next_trx_id()
   return ++current_trx_id_;
 }
 
-int32_t MvccTrxManager::max_trx_id() const
+int32_t MvccTrxManager::max_trx_id()
 {
   return numeric_limits<int32_t>::max();
 }
@@ -111,6 +133,13 @@ MvccTrx::MvccTrx(MvccTrxManager &kit, int32_t trx_id) : trx_kit_(kit), trx_id_(t
   recovering_ = true;
 }
 
+void MvccTrx::reinit(LogManager *log_manager)
+{
+  ASSERT(reusable(), "try to reuse a trx that is still running. trx id=%d", trx_id_);
+  log_manager_ = log_manager;
+  trx_id_      = -1;
+}
+
 RC MvccTrx::insert_record(Table *table, Record &record)
 {
   RC rc = RC::SUCCESS;
@@ -161,6 +190,7 @@ RC MvccTrx::delete_record(Table *table, Record &record)
   trx_fields(table, begin_xid_field, end_xid_field);
 
   end_xid_field.set_int(record, -trx_id_);
+  table->record_handler()->clear_visible_hint(record.rid().page_num);
 
   pair<OperationSet::iterator, bool> ret = operations_.insert(Operation(Operation::Type::DELETE, table, record.rid()));
   if (!ret.second) {
@@ -216,6 +246,19 @@ RC MvccTrx::visit_record(Table *table, Record &record, bool readonly)
   return RC::SUCCESS;
 }
 
+int32_t MvccTrx::visible_xid(Table *table, const Record &record)
+{
+  Field begin_xid_field, end_xid_field;
+  trx_fields(table, begin_xid_field, end_xid_field);
+
+  int32_t begin_xid = begin_xid_field.get_int(record);
+  int32_t end_xid = end_xid_field.get_int(record);
+  if (begin_xid < 0 || end_xid != trx_kit_.max_trx_id()) {
+    return -1;
+  }
+  return begin_xid;
+}
+
 RC MvccTrx::start_if_need()
 {
   if (!started_) {
@@ -0,0 +1,52 @@
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "common/io/binary_protocol.h"
+
+using namespace common;
+
+TEST(test_binary_protocol, test_decode_batch)
+{
+  // 2 行 2 列：INT 列第二行为 NULL，STRING 列两行共用一个字典项
+  std::string buf;
+  size_t      pos = begin_binary_message(buf, BinaryMessageType::BATCH);
+  put_u32(buf, 2);
+  put_u16(buf, 2);
+
+  put_u8(buf, static_cast<uint8_t>(BinaryColumnType::INT));
+  put_u8(buf, 0x02);
+  put_u32(buf, static_cast<uint32_t>(-7));
+  put_u32(buf, 0);
+
+  put_u8(buf, static_cast<uint8_t>(BinaryColumnType::STRING));
+  put_u8(buf, 0x00);
+  put_u32(buf, 1);
+  put_u32(buf, 3);
+  buf.append("a;b");
+  put_u32(buf, 0);
+  put_u32(buf, 0);
+  finish_binary_message(buf, pos);
+
+  // 消息不完整时不能解析
+  BinaryMessage message;
+  size_t        consumed = 0;
+  ASSERT_FALSE(parse_binary_message(buf.data(), buf.size() - 1, message, consumed));
+  ASSERT_TRUE(parse_binary_message(buf.data(), buf.size(), message, consumed));
+  ASSERT_EQ(buf.size(), consumed);
+  ASSERT_EQ(BinaryMessageType::BATCH, message.type);
+
+  BinaryBatch batch;
+  ASSERT_TRUE(decode_binary_batch(message, batch));
+  ASSERT_EQ(2, batch.rows);
+  ASSERT_EQ(2, (int)batch.columns.size());
+  ASSERT_EQ("-7", batch.columns[0].cell_string(0));
+  ASSERT_EQ("NULL", batch.columns[0].cell_string(1));
+  ASSERT_EQ("a;b", batch.columns[1].cell_string(0));
+  ASSERT_EQ("a;b", batch.columns[1].cell_string(1));
+
+  // 字典下标越界
+  buf[buf.size() - 1] = 1;
+  ASSERT_TRUE(parse_binary_message(buf.data(), buf.size(), message, consumed));
+  ASSERT_FALSE(decode_binary_batch(message, batch));
+}
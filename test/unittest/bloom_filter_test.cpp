@@ -0,0 +1,66 @@
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "include/storage_engine/index/bloom_filter.h"
+
+TEST(test_bloom_filter, test_memory_filter)
+{
+  std::mt19937_64 random(1234);
+  std::vector<uint64_t> keys;
+  for (int i = 0; i < 10000; i++) {
+    keys.push_back(random());
+  }
+
+  BloomFilter filter;
+  filter.init(static_cast<int>(keys.size()));
+  for (uint64_t key : keys) {
+    filter.insert(key);
+  }
+
+  // 插入过的键一定存在
+  for (uint64_t key : keys) {
+    ASSERT_TRUE(filter.may_contain(key));
+  }
+
+  // 每个键12位时误判率大约是1%，这里留出足够的余量
+  int false_positives = 0;
+  const int probes = 100000;
+  for (int i = 0; i < probes; i++) {
+    if (filter.may_contain(random())) {
+      false_positives++;
+    }
+  }
+  ASSERT_LT(false_positives, probes * 3 / 100);
+
+  // 空的过滤器不包含任何键
+  BloomFilter empty;
+  empty.init(0);
+  ASSERT_FALSE(empty.may_contain(keys.front()));
+}
+
+TEST(test_bloom_filter, test_page_filter)
+{
+  // 直接在一块内存(比如页面)上操作，与内存中的过滤器使用同样的格式
+  const int block_num = 127;
+  std::vector<char> page(block_num * BloomFilter::BLOCK_SIZE + 3, 0);
+  char *blocks = page.data() + 3;  // 页面数据不保证对齐
+
+  std::mt19937_64 random(99);
+  std::vector<uint64_t> keys;
+  for (int i = 0; i < 3000; i++) {
+    keys.push_back(random());
+    BloomFilter::insert(blocks, block_num, keys.back());
+  }
+  for (uint64_t key : keys) {
+    ASSERT_TRUE(BloomFilter::may_contain(blocks, block_num, key));
+  }
+
+  int false_positives = 0;
+  for (int i = 0; i < 10000; i++) {
+    if (BloomFilter::may_contain(blocks, block_num, random())) {
+      false_positives++;
+    }
+  }
+  ASSERT_LT(false_positives, 10000 * 5 / 100);
+}
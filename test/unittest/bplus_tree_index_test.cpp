@@ -90,6 +90,51 @@ TEST(test_bplus_tree_index, single_attribute)
   delete index;
 }
 
+/**
+ * 范围扫描，并且通过 current_key 直接读取索引项中的键
+ */
+TEST(test_bplus_tree_index, range_scan_with_key)
+{
+  std::vector<const FieldMeta *> multi_field_metas;
+  FieldMeta id_meta;
+  id_meta.init("id", AttrType::INTS, 0, 4, true, false);
+  multi_field_metas.emplace_back(&id_meta);
+  IndexMeta new_index_meta;
+  new_index_meta.init(false, "i_range", multi_field_metas);
+  const char *index_file = "table1-i_range.index";
+  ::remove(index_file);
+  std::vector<FieldMeta> new_multi_field_metas{id_meta};
+  BplusTreeIndex *index = new BplusTreeIndex();
+  ASSERT_EQ(index->create(index_file, new_index_meta, new_multi_field_metas), RC::SUCCESS);
+
+  for (int i = 0; i < 1000; i++) {
+    int id = (i * 7) % 1000;
+    RID rid(1, id);
+    ASSERT_EQ(index->insert_entry(reinterpret_cast<const char *>(&id), &rid), RC::SUCCESS);
+  }
+
+  int left = 100;
+  int right = 200;
+  IndexScanner *scanner = index->create_scanner(reinterpret_cast<const char *>(&left), sizeof(left), false,
+                                                reinterpret_cast<const char *>(&right), sizeof(right), true);
+  ASSERT_NE(scanner, nullptr);
+  RID rid;
+  int expected = left + 1;
+  while (scanner->next_entry(&rid, false) == RC::SUCCESS) {
+    int key = 0;
+    ASSERT_NE(scanner->current_key(), nullptr);
+    std::memcpy(&key, scanner->current_key(), sizeof(key));
+    ASSERT_EQ(key, expected);
+    ASSERT_EQ(rid.slot_num, expected);
+    expected++;
+  }
+  ASSERT_EQ(expected, right + 1);
+  scanner->destroy();
+
+  delete index;
+  ::remove(index_file);
+}
+
 int main(int argc, char **argv)
 {
   // 分析gtest程序的命令行参数
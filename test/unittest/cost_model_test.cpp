@@ -0,0 +1,50 @@
+#include <string>
+
+#include "gtest/gtest.h"
+#include "include/query_engine/optimizer/cost_model.h"
+#include "sql_test_util.h"
+
+TEST(test_cost_model, test_join_cost)
+{
+  // 两边都是 1000 行时，嵌套循环要重复执行右子树
+  const double nested_loop = CostModel::nested_loop_join_cost(1000, 10, 1000, 10);
+  const double hash = CostModel::hash_join_cost(1000, 10, 1000, 10);
+  const double merge = CostModel::merge_join_cost(1000, 10, 1000, 10);
+  ASSERT_LT(hash, merge);
+  ASSERT_LT(merge, nested_loop);
+
+  // 构建哈希表比探测贵，构建侧应该是小的一边
+  ASSERT_LT(CostModel::hash_join_cost(1000, 10, 10, 1), CostModel::hash_join_cost(10, 1, 1000, 10));
+
+  // 每次探测读取两层索引页面，再回表读取一行
+  ASSERT_DOUBLE_EQ(1 + 10 * (2 * RANDOM_PAGE_COST + RANDOM_PAGE_COST + CPU_TUPLE_COST),
+      CostModel::index_nested_loop_join_cost(10, 1, 1, 2));
+}
+
+TEST(test_cost_model, test_index_height_and_sort)
+{
+  ASSERT_DOUBLE_EQ(1, CostModel::index_height(0));
+  ASSERT_DOUBLE_EQ(1, CostModel::index_height(100));
+  ASSERT_DOUBLE_EQ(3, CostModel::index_height(1000000));
+
+  ASSERT_DOUBLE_EQ(0, CostModel::sort_cost(1));
+  ASSERT_DOUBLE_EQ(1024 * 10 * CPU_OPERATOR_COST * 2, CostModel::sort_cost(1024));
+}
+
+TEST(test_cost_model, test_estimate_with_stats)
+{
+  SqlTestEnv env("vacuous");
+  ASSERT_EQ("SUCCESS\n", env.execute("create table t(id int not null, v int not null)"));
+  for (int i = 1; i <= 100; i++) {
+    ASSERT_EQ("SUCCESS\n", env.execute("insert into t values(" + std::to_string(i) + ", " + std::to_string(i % 4) + ")"));
+  }
+
+  // 没有统计信息时等值条件使用默认的选择率
+  ASSERT_NE(std::string::npos, env.execute("explain select * from t where v = 1").find("TABLE_SCAN(t) rows=10 "));
+
+  // ANALYZE 之后按照不同值的个数估计
+  ASSERT_NE(std::string::npos, env.query("analyze t").find("t|v|100|0.0000|4|"));
+  ASSERT_NE(std::string::npos, env.execute("explain select * from t where v = 1").find("TABLE_SCAN(t) rows=25 "));
+  ASSERT_NE(std::string::npos, env.execute("explain select * from t where id <= 50").find("TABLE_SCAN(t) rows=50 "));
+  ASSERT_NE(std::string::npos, env.execute("explain select * from t where id > 1000").find("TABLE_SCAN(t) rows=0 "));
+}
@@ -0,0 +1,150 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "include/query_engine/optimizer/comparison_simplification_rule.h"
+#include "include/query_engine/optimizer/conjunction_simplification_rule.h"
+#include "include/query_engine/optimizer/optimizer.h"
+#include "include/query_engine/planner/node/table_get_logical_node.h"
+#include "sql_test_util.h"
+
+namespace {
+
+std::unique_ptr<Expression> value_expr(const Value &value)
+{
+  return std::unique_ptr<Expression>(new ValueExpr(value));
+}
+
+std::unique_ptr<Expression> comparison_expr(CompOp comp, const Value &left, const Value &right)
+{
+  return std::unique_ptr<Expression>(new ComparisonExpr(comp, value_expr(left), value_expr(right)));
+}
+
+}  // namespace
+
+TEST(test_expression_rewriter, test_comparison_rule)
+{
+  ComparisonSimplificationRule rule;
+  bool change_made = false;
+
+  std::unique_ptr<Expression> expr = comparison_expr(LESS_THAN, Value(1), Value(2));
+  ASSERT_EQ(RC::SUCCESS, rule.rewrite(expr, change_made));
+  ASSERT_TRUE(change_made);
+  ASSERT_EQ(ExprType::VALUE, expr->type());
+  ASSERT_TRUE(static_cast<ValueExpr *>(expr.get())->get_value().get_boolean());
+
+  // 与 NULL 的大小比较恒为假
+  Value null_value;
+  null_value.set_null();
+  expr = comparison_expr(EQUAL_TO, Value(1), null_value);
+  ASSERT_EQ(RC::SUCCESS, rule.rewrite(expr, change_made));
+  ASSERT_EQ(ExprType::VALUE, expr->type());
+  ASSERT_FALSE(static_cast<ValueExpr *>(expr.get())->get_value().get_boolean());
+}
+
+TEST(test_expression_rewriter, test_conjunction_rule)
+{
+  ConjunctionSimplificationRule rule;
+  bool change_made = false;
+
+  // AND 中的常量 true 被去掉，只剩一个子表达式时直接使用子表达式
+  std::vector<std::unique_ptr<Expression>> children;
+  children.push_back(value_expr(Value(true)));
+  children.push_back(comparison_expr(GREAT_THAN, Value(2), Value(1)));
+  std::unique_ptr<Expression> expr(new ConjunctionExpr(ConjunctionType::AND, children));
+  ASSERT_EQ(RC::SUCCESS, rule.rewrite(expr, change_made));
+  ASSERT_TRUE(change_made);
+  ASSERT_EQ(ExprType::COMPARISON, expr->type());
+
+  // OR 中有常量 true 时整个表达式为真
+  children.clear();
+  children.push_back(comparison_expr(GREAT_THAN, Value(2), Value(1)));
+  children.push_back(value_expr(Value(true)));
+  expr.reset(new ConjunctionExpr(ConjunctionType::OR, children));
+  ASSERT_EQ(RC::SUCCESS, rule.rewrite(expr, change_made));
+  ASSERT_EQ(ExprType::VALUE, expr->type());
+  ASSERT_TRUE(static_cast<ValueExpr *>(expr.get())->get_value().get_boolean());
+}
+
+/**
+ * 在逻辑计划上重复执行所有的重写规则，检查单表扫描上最后剩下的条件
+ */
+class ExpressionRewriterTest : public ::testing::Test
+{
+protected:
+  static void SetUpTestSuite()
+  {
+    env_ = new SqlTestEnv("vacuous");
+    ASSERT_EQ("SUCCESS\n", env_->execute("create table t(id int not null, v int, f float)"));
+    for (int i = 1; i <= 5; i++) {
+      ASSERT_EQ("SUCCESS\n", env_->execute("insert into t values(" + std::to_string(i) + ", " + std::to_string(i) + ", 0.5)"));
+    }
+  }
+
+  static void TearDownTestSuite()
+  {
+    delete env_;
+    env_ = nullptr;
+  }
+
+  /// 重写之后的条件，下推到扫描上的条件用 AND 连接，保留在谓词节点上的用 [] 标出
+  std::string rewrite(const std::string &sql)
+  {
+    std::unique_ptr<Stmt> stmt;
+    std::unique_ptr<LogicalNode> plan;
+    EXPECT_EQ(RC::SUCCESS, env_->logical_plan(sql, stmt, plan));
+    Optimizer optimizer;
+    EXPECT_EQ(RC::SUCCESS, optimizer.rewrite(plan));
+
+    std::string result;
+    LogicalNode *node = plan.get();
+    while (node->type() != LogicalNodeType::TABLE_GET) {
+      if (node->type() == LogicalNodeType::PREDICATE) {
+        result += "[" + expr_to_string(node->expressions()[0].get()) + "]";
+      }
+      node = node->children()[0].get();
+    }
+    for (std::unique_ptr<Expression> &expr : static_cast<TableGetLogicalNode *>(node)->predicates()) {
+      result += (result.empty() ? "" : " AND ") + expr_to_string(expr.get());
+    }
+    return result;
+  }
+
+  static SqlTestEnv *env_;
+};
+
+SqlTestEnv *ExpressionRewriterTest::env_ = nullptr;
+
+TEST_F(ExpressionRewriterTest, constant_folding)
+{
+  // 常量 op 字段 改写成 字段 op 常量，算术运算先计算出来
+  ASSERT_EQ("t.id=3", rewrite("select * from t where 1 + 2 = id"));
+  ASSERT_EQ("t.id<4", rewrite("select * from t where 4 > id"));
+  ASSERT_EQ("t.id>10", rewrite("select * from t where id > 10 and 1 = 1"));
+  ASSERT_EQ("", rewrite("select * from t where v is null or 1 = 1"));
+  ASSERT_EQ("(t.v=2 OR t.v=1)", rewrite("select * from t where v = 1 or v = 2 or 1 = 2"));
+}
+
+TEST_F(ExpressionRewriterTest, null_rules)
+{
+  // 不允许为空的字段
+  ASSERT_EQ("[0]", rewrite("select * from t where id is null"));
+  ASSERT_EQ("", rewrite("select * from t where id is not null"));
+  ASSERT_EQ("t.v IS NULL", rewrite("select * from t where v is null"));
+  ASSERT_EQ("[0]", rewrite("select * from t where v = null"));
+}
+
+TEST_F(ExpressionRewriterTest, contradiction)
+{
+  // 条件恒为假时保留一个常量 false 的过滤，执行时不读取数据
+  ASSERT_EQ("[0]", rewrite("select * from t where id = 1 and id = 2"));
+  ASSERT_EQ("[0]", rewrite("select * from t where id > 5 and id < 3"));
+  ASSERT_EQ("[0]", rewrite("select * from t where id >= 3 and v = 1 and id < 3"));
+  ASSERT_EQ("id|v|f\n", env_->query("select * from t where id > 5 and id < 3"));
+
+  // 不矛盾的范围保持原样
+  ASSERT_EQ("t.id<=3 AND t.id>=3", rewrite("select * from t where id >= 3 and id <= 3"));
+  // 浮点数的比较不是精确的，不做矛盾检查
+  ASSERT_EQ("t.f<0.4 AND t.f>0.5", rewrite("select * from t where f > 0.5 and f < 0.4"));
+}
@@ -0,0 +1,84 @@
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "include/query_engine/planner/operator/external_sort.h"
+
+static std::string encode_int_key(int v, bool is_asc)
+{
+  std::string key;
+  SortKeyEncoder::append(Value(v), is_asc, key);
+  return key;
+}
+
+TEST(test_external_sort, test_sort_key_encoder)
+{
+  // 数值、字符串、NULL 编码之后按 memcmp 比较的结果应该与 Value::compare 一致
+  ASSERT_LT(encode_int_key(-5, true), encode_int_key(3, true));
+  ASSERT_GT(encode_int_key(-5, false), encode_int_key(3, false));
+
+  std::string float_key, int_key;
+  SortKeyEncoder::append(Value(2.5f), true, float_key);
+  SortKeyEncoder::append(Value(2), true, int_key);
+  ASSERT_LT(int_key, float_key);
+
+  std::string ab, abc;
+  SortKeyEncoder::append(Value("ab"), true, ab);
+  SortKeyEncoder::append(Value("abc"), true, abc);
+  ASSERT_LT(ab, abc);
+
+  Value null_value(0);
+  null_value.set_null();
+  std::string null_asc, null_desc;
+  SortKeyEncoder::append(null_value, true, null_asc);
+  SortKeyEncoder::append(null_value, false, null_desc);
+  ASSERT_LT(null_asc, encode_int_key(INT32_MIN, true));
+  ASSERT_GT(null_desc, encode_int_key(INT32_MAX, false));
+}
+
+static void sort_and_check(size_t memory_budget, size_t merge_fan_in, int row_num, bool expect_spill)
+{
+  ExternalSorter sorter(memory_budget, merge_fan_in);
+  std::vector<int> expected;
+  for (int i = 0; i < row_num; i++) {
+    int v = (i * 7919) % 10007 - 5000;
+    expected.push_back(v);
+    std::string key = encode_int_key(v, true);
+    ASSERT_EQ(RC::SUCCESS, sorter.add(key.data(), key.size(), reinterpret_cast<const char *>(&v), sizeof(v)));
+  }
+  ASSERT_EQ(RC::SUCCESS, sorter.finish());
+  ASSERT_EQ(expect_spill, sorter.spilled_run_count() > 0);
+
+  std::sort(expected.begin(), expected.end());
+  char *payload = nullptr;
+  int payload_len = 0;
+  for (int v : expected) {
+    ASSERT_EQ(RC::SUCCESS, sorter.next(payload, payload_len));
+    ASSERT_EQ(static_cast<int>(sizeof(int)), payload_len);
+    int actual = 0;
+    memcpy(&actual, payload, sizeof(actual));
+    ASSERT_EQ(v, actual);
+  }
+  ASSERT_EQ(RC::RECORD_EOF, sorter.next(payload, payload_len));
+}
+
+TEST(test_external_sort, test_in_memory)
+{
+  sort_and_check(DEFAULT_SORT_MEMORY_BUDGET, MAX_SORT_MERGE_FAN_IN, 1000, false);
+}
+
+TEST(test_external_sort, test_spill_and_merge)
+{
+  // 每插入一行就溢出一个顺串，归并路数很小时会产生多层中间归并
+  sort_and_check(1, 4, 2000, true);
+  // 内存上限只有两个内存块，每写满一块溢出一个顺串
+  sort_and_check(2 * 1024 * 1024, MAX_SORT_MERGE_FAN_IN, 200000, true);
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
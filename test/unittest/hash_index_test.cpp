@@ -0,0 +1,184 @@
+#include <stdlib.h>
+
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "include/storage_engine/buffer/buffer_pool.h"
+#include "include/storage_engine/index/hash_index.h"
+#include "include/storage_engine/recorder/table.h"
+#include "include/storage_engine/transaction/mvcc_trx.h"
+
+/**
+ * 假设table的元数据为(id int, k int)，在 k 上创建哈希索引。
+ * 使用多版本事务，这样唯一索引的冲突检查需要读取记录中的 end_xid
+ */
+class HashIndexTest : public ::testing::Test
+{
+protected:
+  static void SetUpTestSuite()
+  {
+    BufferPoolManager::set_instance(new BufferPoolManager());
+    ASSERT_EQ(RC::SUCCESS, TrxManager::init_global("mvcc"));
+  }
+
+  void SetUp() override
+  {
+    char dir_template[] = "/tmp/tdb_hash_index_test_XXXXXX";
+    ASSERT_NE(nullptr, mkdtemp(dir_template));
+    dir_ = dir_template;
+
+    const AttrInfoSqlNode attributes[] = {{INTS, "id", 4, false}, {INTS, "k", 4, false}};
+    table_ = std::make_unique<Table>();
+    ASSERT_EQ(RC::SUCCESS, table_->create(1, (dir_ + "/t.table").c_str(), "t", dir_.c_str(), 2, attributes));
+    index_file_ = dir_ + "/t-hk.index";
+  }
+
+  void TearDown() override
+  {
+    if (index_ != nullptr) {
+      index_->close();
+      index_.reset();
+    }
+    table_.reset();
+    std::filesystem::remove_all(dir_);
+  }
+
+  void create_index(bool unique)
+  {
+    std::vector<const FieldMeta *> fields{table_->table_meta().field("k")};
+    ASSERT_EQ(RC::SUCCESS, index_meta_.init(unique, "hk", fields, IndexType::HASH));
+    field_metas_ = {*fields[0]};
+    index_ = std::make_unique<HashIndex>(table_.get());
+    ASSERT_EQ(RC::SUCCESS, index_->create(index_file_.c_str(), index_meta_, field_metas_));
+  }
+
+  void reopen_index()
+  {
+    ASSERT_EQ(RC::SUCCESS, index_->close());
+    index_ = std::make_unique<HashIndex>(table_.get());
+    ASSERT_EQ(RC::SUCCESS, index_->open(index_file_.c_str(), index_meta_, field_metas_));
+  }
+
+  /// 生成一条记录，事务字段设置为没有被删除的有效记录
+  void make_record(int id, int k, Record &record)
+  {
+    Value values[] = {Value(id), Value(k)};
+    ASSERT_EQ(RC::SUCCESS, table_->make_record(2, values, record));
+    const std::pair<const FieldMeta *, int> trx_fields = table_->table_meta().trx_fields();
+    const int32_t begin_xid = 1;
+    const int32_t end_xid = MvccTrxManager::max_trx_id();
+    memcpy(record.data() + trx_fields.first[0].offset(), &begin_xid, sizeof(begin_xid));
+    memcpy(record.data() + trx_fields.first[1].offset(), &end_xid, sizeof(end_xid));
+  }
+
+  size_t count(int k)
+  {
+    std::vector<RID> rids;
+    EXPECT_EQ(RC::SUCCESS, index_->find(reinterpret_cast<const char *>(&k), rids));
+    return rids.size();
+  }
+
+protected:
+  std::string                dir_;
+  std::string                index_file_;
+  std::unique_ptr<Table>     table_;
+  IndexMeta                  index_meta_;
+  std::vector<FieldMeta>     field_metas_;
+  std::unique_ptr<HashIndex> index_;
+};
+
+TEST_F(HashIndexTest, split_overflow_and_reopen)
+{
+  create_index(false);
+
+  // 不同的键足够多，桶会多次分裂、目录会加倍
+  const int key_num = 20000;
+  Record record;
+  for (int i = 0; i < key_num; i++) {
+    make_record(i, i, record);
+    RID rid(i / 100 + 1, i % 100);
+    ASSERT_EQ(RC::SUCCESS, index_->insert_entry(record.data(), &rid));
+  }
+  // 相同的键哈希值也相同，桶无法分裂，只能放到溢出页面上
+  const int dup_key = -1;
+  const int dup_num = 2000;
+  for (int i = 0; i < dup_num; i++) {
+    make_record(key_num + i, dup_key, record);
+    RID rid(1000 + i / 100, i % 100);
+    ASSERT_EQ(RC::SUCCESS, index_->insert_entry(record.data(), &rid));
+  }
+
+  for (int i = 0; i < key_num; i += 97) {
+    ASSERT_EQ(1U, count(i));
+  }
+  ASSERT_EQ(static_cast<size_t>(dup_num), count(dup_key));
+  ASSERT_EQ(0U, count(key_num + 1));
+
+  // 关闭之后重新打开，目录和溢出页面都从文件中读取
+  reopen_index();
+  for (int i = 0; i < key_num; i++) {
+    std::vector<RID> rids;
+    ASSERT_EQ(RC::SUCCESS, index_->find(reinterpret_cast<const char *>(&i), rids));
+    ASSERT_EQ(1U, rids.size());
+    ASSERT_EQ(RID(i / 100 + 1, i % 100), rids[0]);
+  }
+  ASSERT_EQ(static_cast<size_t>(dup_num), count(dup_key));
+
+  // 删除溢出页面上的一项，其它的不受影响
+  make_record(key_num, dup_key, record);
+  RID rid(1000, 0);
+  ASSERT_EQ(RC::SUCCESS, index_->delete_entry(record.data(), &rid));
+  ASSERT_EQ(static_cast<size_t>(dup_num - 1), count(dup_key));
+
+  // 只支持等值查找
+  const int k = 5;
+  IndexScanner *scanner = index_->create_scanner(
+      reinterpret_cast<const char *>(&k), sizeof(k), true, reinterpret_cast<const char *>(&k), sizeof(k), true);
+  ASSERT_NE(nullptr, scanner);
+  RID found;
+  ASSERT_EQ(RC::SUCCESS, scanner->next_entry(&found, false));
+  ASSERT_EQ(RID(1, 5), found);
+  ASSERT_EQ(RC::RECORD_EOF, scanner->next_entry(&found, false));
+  scanner->destroy();
+  ASSERT_EQ(nullptr, index_->create_scanner(reinterpret_cast<const char *>(&k), sizeof(k), true,
+      reinterpret_cast<const char *>(&k), sizeof(k), false));
+}
+
+TEST_F(HashIndexTest, unique_delete_and_reinsert)
+{
+  create_index(true);
+
+  Record first;
+  make_record(1, 10, first);
+  ASSERT_EQ(RC::SUCCESS, table_->insert_record(first));
+  ASSERT_EQ(RC::SUCCESS, index_->insert_entry(first.data(), &first.rid()));
+
+  // 有效的记录与新插入的键冲突
+  Record second;
+  make_record(2, 10, second);
+  ASSERT_EQ(RC::SUCCESS, table_->insert_record(second));
+  ASSERT_EQ(RC::RECORD_DUPLICATE_KEY, index_->insert_entry(second.data(), &second.rid()));
+
+  // 多版本事务提交删除时只设置 end_xid，索引项还在，但是不再冲突
+  const int end_xid_offset = table_->table_meta().trx_fields().first[1].offset();
+  ASSERT_EQ(RC::SUCCESS, table_->visit_record(first.rid(), false, [end_xid_offset](Record &record) {
+    const int32_t commit_xid = 2;
+    memcpy(record.data() + end_xid_offset, &commit_xid, sizeof(commit_xid));
+  }));
+  ASSERT_EQ(RC::SUCCESS, index_->insert_entry(second.data(), &second.rid()));
+  ASSERT_EQ(2U, count(10));
+
+  // 从索引中删除之后重新插入同一个键
+  ASSERT_EQ(RC::SUCCESS, index_->delete_entry(second.data(), &second.rid()));
+  ASSERT_EQ(RC::SUCCESS, index_->delete_entry(first.data(), &first.rid()));
+  ASSERT_EQ(0U, count(10));
+  ASSERT_EQ(RC::SUCCESS, index_->insert_entry(second.data(), &second.rid()));
+  ASSERT_EQ(1U, count(10));
+
+  reopen_index();
+  ASSERT_EQ(RC::RECORD_DUPLICATE_KEY, index_->insert_entry(first.data(), &first.rid()));
+}
@@ -0,0 +1,110 @@
+#include <string>
+
+#include "gtest/gtest.h"
+#include "sql_test_util.h"
+
+/**
+ * 使用多版本事务，B+树索引的键后面带有事务字段，扫描的范围只由用户字段确定
+ */
+class IndexScanTest : public ::testing::Test
+{
+protected:
+  static void SetUpTestSuite()
+  {
+    env_ = new SqlTestEnv("mvcc");
+    ASSERT_EQ("SUCCESS\n", env_->execute("create table t1(id int not null, v int)"));
+    // 先插入数据再创建索引，已有的记录都要放到索引中
+    for (int id : {1, 2, 300, 70000, -5}) {
+      ASSERT_EQ("SUCCESS\n", env_->execute("insert into t1 values(" + std::to_string(id) + ", " + std::to_string(id) + ")"));
+    }
+    ASSERT_EQ("SUCCESS\n", env_->execute("create index i_id on t1(id)"));
+  }
+
+  static void TearDownTestSuite()
+  {
+    delete env_;
+    env_ = nullptr;
+  }
+
+  static bool contains(const std::string &str, const std::string &sub)
+  {
+    return str.find(sub) != std::string::npos;
+  }
+
+  static SqlTestEnv *env_;
+};
+
+SqlTestEnv *IndexScanTest::env_ = nullptr;
+
+TEST_F(IndexScanTest, equal)
+{
+  ASSERT_TRUE(contains(env_->execute("explain select * from t1 where id = 70000"), "INDEX_SCAN(i_id ON t1, eq=70000)"));
+  ASSERT_EQ("id|v\n70000|70000\n", env_->query("select * from t1 where id = 70000"));
+  ASSERT_EQ("id|v\n-5|-5\n", env_->query("select * from t1 where id = -5"));
+  ASSERT_EQ("id|v\n", env_->query("select * from t1 where id = 3"));
+}
+
+TEST_F(IndexScanTest, range)
+{
+  ASSERT_TRUE(contains(env_->execute("explain select * from t1 where id > 1 and id < 500"), "INDEX_SCAN(i_id ON t1, range=(1,500))"));
+  ASSERT_EQ("id|v\n2|2\n300|300\n", env_->query("select * from t1 where id > 1 and id < 500"));
+
+  ASSERT_TRUE(contains(env_->execute("explain select * from t1 where id between -10 and 2"), "range=[-10,2]"));
+  ASSERT_EQ("id|v\n-5|-5\n1|1\n2|2\n", env_->query("select * from t1 where id between -10 and 2"));
+  ASSERT_EQ("id|v\n300|300\n70000|70000\n", env_->query("select * from t1 where id >= 300"));
+  ASSERT_EQ("id|v\n", env_->query("select * from t1 where id > 70000"));
+}
+
+TEST_F(IndexScanTest, ordered_index_scan)
+{
+  const std::string plan = env_->execute("explain select * from t1 order by id limit 1");
+  ASSERT_TRUE(contains(plan, "INDEX_SCAN(i_id ON t1)"));
+  ASSERT_FALSE(contains(plan, "TOP_N"));
+  ASSERT_EQ("id|v\n-5|-5\n1|1\n", env_->query("select * from t1 order by id limit 2"));
+}
+
+TEST_F(IndexScanTest, index_only)
+{
+  ASSERT_TRUE(contains(env_->execute("explain select id from t1 where id = 1"), "INDEX_SCAN(i_id ON t1, index only, eq=1)"));
+  ASSERT_EQ("id\n1\n", env_->query("select id from t1 where id = 1"));
+  ASSERT_EQ("id\n-5\n1\n2\n", env_->query("select id from t1 where id < 300"));
+}
+
+TEST_F(IndexScanTest, update_and_delete)
+{
+  ASSERT_EQ("SUCCESS\n", env_->execute("create table t2(id int not null, v int)"));
+  for (int id = 1; id <= 20; id++) {
+    ASSERT_EQ("SUCCESS\n", env_->execute("insert into t2 values(" + std::to_string(id) + ", 0)"));
+  }
+  ASSERT_EQ("SUCCESS\n", env_->execute("create index i_t2 on t2(id)"));
+
+  // 更新插入的新版本也在扫描的范围中，不能再次被更新
+  ASSERT_TRUE(contains(env_->execute("explain update t2 set v = 9 where id = 1"), "INDEX_SCAN"));
+  ASSERT_EQ("SUCCESS\n", env_->execute("update t2 set v = 9 where id = 1"));
+  ASSERT_EQ("SUCCESS\n", env_->execute("update t2 set v = 8 where id >= 18"));
+  ASSERT_EQ("count(*)\n20\n", env_->query("select count(*) from t2"));
+  ASSERT_EQ("id|v\n1|9\n", env_->query("select * from t2 where id = 1"));
+  ASSERT_EQ("id|v\n18|8\n19|8\n20|8\n", env_->query("select * from t2 where id > 17"));
+
+  ASSERT_EQ("SUCCESS\n", env_->execute("delete from t2 where id = 2"));
+  ASSERT_EQ("SUCCESS\n", env_->execute("delete from t2 where id between 10 and 12"));
+  ASSERT_EQ("count(*)\n16\n", env_->query("select count(*) from t2"));
+  ASSERT_EQ("id|v\n", env_->query("select * from t2 where id = 2"));
+  ASSERT_EQ("id|v\n9|0\n13|0\n", env_->query("select * from t2 where id >= 9 and id <= 13"));
+}
+
+TEST_F(IndexScanTest, multi_column_prefix)
+{
+  ASSERT_EQ("SUCCESS\n", env_->execute("create table t3(a int not null, b char(4) not null, c float)"));
+  ASSERT_EQ("SUCCESS\n", env_->execute("insert into t3 values(1, 'x', 1.5)"));
+  ASSERT_EQ("SUCCESS\n", env_->execute("insert into t3 values(1, 'y', 2.5)"));
+  ASSERT_EQ("SUCCESS\n", env_->execute("insert into t3 values(2, 'x', -3.5)"));
+  ASSERT_EQ("SUCCESS\n", env_->execute("insert into t3 values(-1, 'z', 0.5)"));
+  ASSERT_EQ("SUCCESS\n", env_->execute("create index i_ab on t3(a, b)"));
+
+  ASSERT_TRUE(contains(env_->execute("explain select * from t3 where a = 1 and b = 'y'"), "prefix=(1,y)"));
+  ASSERT_EQ("a|b|c\n1|y|2.5\n", env_->query("select * from t3 where a = 1 and b = 'y'"));
+  ASSERT_TRUE(contains(env_->execute("explain select * from t3 where a = 1 and b > 'x'"), "prefix=(1), range=(x,+inf)"));
+  ASSERT_EQ("a|b|c\n1|y|2.5\n", env_->query("select * from t3 where a = 1 and b > 'x'"));
+  ASSERT_EQ("a|b|c\n-1|z|0.5\n1|x|1.5\n1|y|2.5\n", env_->query("select * from t3 where a < 2"));
+}
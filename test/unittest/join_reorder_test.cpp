@@ -0,0 +1,97 @@
+#include <string>
+
+#include "gtest/gtest.h"
+#include "sql_test_util.h"
+
+/**
+ * 使用多版本事务，B+树索引的键后面带有事务字段。每个测试使用自己的表，表中的数据是 (i, i % 5)，i 从 1 到 30。
+ * 需要大表的测试通过统计信息模拟，实际执行时仍然只有 30 行
+ */
+class JoinReorderTest : public ::testing::Test
+{
+protected:
+  static void SetUpTestSuite() { env_ = new SqlTestEnv("mvcc"); }
+
+  static void TearDownTestSuite()
+  {
+    delete env_;
+    env_ = nullptr;
+  }
+
+  static void create_table(const std::string &name)
+  {
+    ASSERT_EQ("SUCCESS\n", env_->execute("create table " + name + "(id int not null, v int not null)"));
+    for (int i = 1; i <= 30; i++) {
+      ASSERT_EQ("SUCCESS\n",
+          env_->execute("insert into " + name + " values(" + std::to_string(i) + ", " + std::to_string(i % 5) + ")"));
+    }
+  }
+
+  static bool contains(const std::string &str, const std::string &sub)
+  {
+    return str.find(sub) != std::string::npos;
+  }
+
+  static SqlTestEnv *env_;
+};
+
+SqlTestEnv *JoinReorderTest::env_ = nullptr;
+
+TEST_F(JoinReorderTest, hash_join)
+{
+  create_table("h1");
+  create_table("h2");
+
+  const std::string plan = env_->execute("explain select h1.id, h2.v from h1, h2 where h1.id = h2.id and h1.v = 1");
+  ASSERT_TRUE(contains(plan, "HASH_JOIN"));
+  ASSERT_EQ("h1.id|h2.v\n1|1\n6|1\n11|1\n16|1\n21|1\n26|1\n",
+      env_->query("select h1.id, h2.v from h1, h2 where h1.id = h2.id and h1.v = 1"));
+}
+
+TEST_F(JoinReorderTest, merge_join)
+{
+  create_table("m1");
+  create_table("m2");
+  // 两边都太大，哈希表放不进内存
+  env_->set_table_rows("m1", 4000000, 40000);
+  env_->set_table_rows("m2", 4000000, 40000);
+
+  const std::string plan = env_->execute("explain select m1.id, m2.id from m1, m2 where m1.id = m2.id");
+  ASSERT_TRUE(contains(plan, "MERGE_JOIN"));
+  ASSERT_FALSE(contains(plan, "HASH_JOIN"));
+  ASSERT_EQ("m1.id|m2.id\n28|28\n29|29\n30|30\n",
+      env_->query("select m1.id, m2.id from m1, m2 where m1.id = m2.id and m1.id > 27"));
+}
+
+TEST_F(JoinReorderTest, index_nested_loop_join)
+{
+  create_table("l");
+  create_table("r");
+  ASSERT_EQ("SUCCESS\n", env_->execute("create index i_r on r(id)"));
+  // 左边过滤之后只剩几行，用索引查找大表比扫描整个大表便宜
+  env_->set_table_rows("r", 4000000, 40000);
+
+  const std::string plan = env_->execute("explain select l.id, r.v from l, r where l.id = r.id and l.v = 2");
+  ASSERT_TRUE(contains(plan, "INDEX_NL_JOIN(l.id=r.id)"));
+  ASSERT_TRUE(contains(plan, "INDEX_SCAN(i_r ON r)"));
+  ASSERT_EQ("l.id|r.v\n2|2\n7|2\n12|2\n17|2\n22|2\n27|2\n",
+      env_->query("select l.id, r.v from l, r where l.id = r.id and l.v = 2"));
+}
+
+TEST_F(JoinReorderTest, join_reorder)
+{
+  create_table("x");
+  create_table("y");
+  create_table("z");
+
+  // FROM 中相邻的 x 与 y 之间没有条件，先连接 z 避免笛卡尔积
+  const std::string plan = env_->execute("explain select * from x, y, z where x.id = z.id and y.id = z.id");
+  ASSERT_FALSE(contains(plan, "─JOIN"));
+  ASSERT_EQ("x.id|y.v|z.id\n3|3|3\n", env_->query("select x.id, y.v, z.id from x, y, z where x.id = z.id and y.id = z.id and z.id = 3"));
+
+  // 大表作为探测的一边，小表用来构建哈希表
+  env_->set_table_rows("z", 4000000, 40000);
+  const std::string hash_plan = env_->execute("explain select * from x, z where x.id = z.v");
+  ASSERT_TRUE(contains(hash_plan, "HASH_JOIN"));
+  ASSERT_LT(hash_plan.find("TABLE_SCAN(z)"), hash_plan.find("TABLE_SCAN(x)"));
+}
@@ -0,0 +1,75 @@
+#include <unistd.h>
+
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "common/log/log.h"
+
+using namespace common;
+
+TEST(test_log, test_async_output)
+{
+  char dir_template[] = "/tmp/tdb_log_test_XXXXXX";
+  ASSERT_NE(nullptr, mkdtemp(dir_template));
+  const std::string log_file = std::string(dir_template) + "/test.log";
+
+  const int thread_num = 4;
+  const int line_num   = 20000;  // 超过线程缓存的大小，缓存写满时由业务线程自己写文件
+  {
+    Log log(log_file, LOG_LEVEL_INFO, LOG_LEVEL_PANIC);
+    log.set_rotate_type(LOG_ROTATE_BYSIZE);
+    ASSERT_EQ(LOG_STATUS_OK, log.start_async());
+    ASSERT_TRUE(log.async());
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_num; t++) {
+      threads.emplace_back([&log, t]() {
+        for (int i = 0; i < line_num; i++) {
+          log.output(LOG_LEVEL_INFO, "log_test.cpp", "", "%d %d", t, i);
+        }
+      });
+    }
+    for (std::thread &thread : threads) {
+      thread.join();
+    }
+    // 被过滤的级别不输出，同步输出的级别排在当前线程之前的日志后面
+    log.output(LOG_LEVEL_DEBUG, "log_test.cpp", "", "%d %d", thread_num, 0);
+    log.output(LOG_LEVEL_INFO, "log_test.cpp", "", "%d %d", thread_num, 0);
+    log.output(LOG_LEVEL_ERR, "log_test.cpp", "", "%d %d", thread_num, 1);
+    log.stop_async();
+    ASSERT_FALSE(log.async());
+  }
+
+  std::ifstream    ifs(log_file);
+  std::vector<int> next(thread_num + 1, 0);
+  int              lines = 0;
+  int              t = 0, i = 0;
+  while (ifs >> t >> i) {
+    ASSERT_TRUE(t >= 0 && t <= thread_num);
+    ASSERT_EQ(next[t], i);
+    next[t]++;
+    lines++;
+  }
+  ASSERT_EQ(thread_num * line_num + 2, lines);
+
+  unlink(log_file.c_str());
+  rmdir(dir_template);
+}
+
+TEST(test_log, test_rate_limiter)
+{
+  LogRateLimiter limiter(50);
+  uint64_t       suppressed = 0;
+  ASSERT_TRUE(limiter.allow(suppressed));
+  ASSERT_EQ(0U, suppressed);
+  for (int i = 0; i < 3; i++) {
+    ASSERT_FALSE(limiter.allow(suppressed));
+  }
+
+  usleep(60 * 1000);
+  ASSERT_TRUE(limiter.allow(suppressed));
+  ASSERT_EQ(3U, suppressed);
+}
@@ -0,0 +1,31 @@
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "include/query_engine/parser/parser.h"
+
+TEST(test_parser_split, test_split_statements)
+{
+  std::vector<std::string> statements;
+
+  Parser::split("select * from t", statements);
+  ASSERT_EQ(1, statements.size());
+  ASSERT_EQ("select * from t", statements[0]);
+
+  // 每条语句保留分号，空白的语句被忽略
+  Parser::split("insert into t values(1); ;\n insert into t values(2);  ", statements);
+  ASSERT_EQ(2, statements.size());
+  ASSERT_EQ("insert into t values(1);", statements[0]);
+  ASSERT_EQ("\n insert into t values(2);", statements[1]);
+
+  // 引号中的分号不是语句的结尾
+  Parser::split("insert into t values('a;b'); select * from t where s = \"c;\";", statements);
+  ASSERT_EQ(2, statements.size());
+  ASSERT_EQ("insert into t values('a;b');", statements[0]);
+  ASSERT_EQ(" select * from t where s = \"c;\";", statements[1]);
+
+  // 引号没有闭合时剩下的部分作为一条语句
+  Parser::split("select 1; select 'abc;", statements);
+  ASSERT_EQ(2, statements.size());
+  ASSERT_EQ(" select 'abc;", statements[1]);
+}
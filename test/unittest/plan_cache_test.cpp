@@ -0,0 +1,67 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "include/query_engine/parser/sql_normalizer.h"
+#include "include/query_engine/planner/plan_cache.h"
+
+TEST(test_plan_cache, test_normalize)
+{
+  std::string normalized;
+  std::vector<Value> params;
+
+  ASSERT_TRUE(SqlNormalizer::normalize("select * from t where id = 1 and name='a';", normalized, params));
+  ASSERT_EQ("select * from t where id = ? and name = ?", normalized);
+  ASSERT_EQ(2, static_cast<int>(params.size()));
+  ASSERT_EQ(1, params[0].get_int());
+  ASSERT_EQ("a", params[1].get_string());
+
+  // 只有常量与空白不同的SQL得到相同的结果
+  std::string other;
+  ASSERT_TRUE(SqlNormalizer::normalize("select  *  from t   where id = -20 and name = 'bcd'", other, params));
+  ASSERT_EQ(normalized, other);
+  ASSERT_EQ(-20, params[0].get_int());
+
+  // IN 列表、算术运算与 LIMIT 中的常量保持原样
+  ASSERT_TRUE(SqlNormalizer::normalize("select * from t where id in (1, 2) and a + 1 > 3 limit 5", normalized, params));
+  ASSERT_EQ("select * from t where id in ( 1 , 2 ) and a + 1 > ? limit 5", normalized);
+  ASSERT_EQ(1, static_cast<int>(params.size()));
+
+  ASSERT_TRUE(SqlNormalizer::normalize("update t set score = 1.5 where d = '2020-1-1'", normalized, params));
+  ASSERT_EQ("update t set score = ? where d = ?", normalized);
+  ASSERT_EQ(DATES, params[1].attr_type());
+
+  ASSERT_FALSE(SqlNormalizer::normalize("insert into t values(1)", normalized, params));
+  ASSERT_FALSE(SqlNormalizer::normalize("select * from t where id = ?", normalized, params));
+  ASSERT_FALSE(SqlNormalizer::normalize("select * from t where d = '2020-2-30'", normalized, params));
+}
+
+TEST(test_plan_cache, test_lru)
+{
+  auto make_plan = [](const std::string &key, uint64_t version) {
+    auto plan = std::make_shared<CachedPlan>();
+    plan->key = key;
+    plan->schema_version = version;
+    return std::shared_ptr<const CachedPlan>(plan);
+  };
+
+  PlanCache cache(2);
+  cache.put(make_plan("a", 1));
+  cache.put(make_plan("b", 1));
+  ASSERT_NE(nullptr, cache.get("a", 1));
+
+  // b 最久没有使用，被淘汰
+  cache.put(make_plan("c", 1));
+  ASSERT_EQ(2, static_cast<int>(cache.size()));
+  ASSERT_EQ(nullptr, cache.get("b", 1));
+  ASSERT_NE(nullptr, cache.get("a", 1));
+  ASSERT_NE(nullptr, cache.get("c", 1));
+
+  // 模式版本变化之后计划失效
+  ASSERT_EQ(nullptr, cache.get("a", 2));
+  ASSERT_EQ(1, static_cast<int>(cache.size()));
+
+  cache.clear();
+  ASSERT_EQ(0, static_cast<int>(cache.size()));
+}
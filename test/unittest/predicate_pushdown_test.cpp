@@ -0,0 +1,145 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "include/query_engine/optimizer/predicate_pushdown_rewriter.h"
+#include "include/query_engine/planner/node/join_logical_node.h"
+#include "include/query_engine/planner/node/table_get_logical_node.h"
+#include "sql_test_util.h"
+
+/**
+ * 只执行谓词下推规则，检查条件被放到了哪个单表节点或者连接节点上
+ */
+class PredicatePushdownTest : public ::testing::Test
+{
+protected:
+  static void SetUpTestSuite()
+  {
+    env_ = new SqlTestEnv("vacuous");
+    ASSERT_EQ("SUCCESS\n", env_->execute("create table a(id int not null, v int)"));
+    ASSERT_EQ("SUCCESS\n", env_->execute("create table b(id int not null, v int)"));
+    ASSERT_EQ("SUCCESS\n", env_->execute("create table c(id int not null, f float)"));
+  }
+
+  static void TearDownTestSuite()
+  {
+    delete env_;
+    env_ = nullptr;
+  }
+
+  void SetUp() override
+  {
+    table_gets_.clear();
+    joins_.clear();
+  }
+
+  /// 生成逻辑计划并执行一次谓词下推，返回是否有变化
+  bool pushdown(const std::string &sql)
+  {
+    EXPECT_EQ(RC::SUCCESS, env_->logical_plan(sql, stmt_, plan_));
+    bool change_made = false;
+    PredicatePushdownRewriter rewriter;
+    EXPECT_EQ(RC::SUCCESS, rewriter.rewrite(plan_->children()[0], change_made));
+    collect(plan_.get());
+    return change_made;
+  }
+
+  /// 单表节点上的条件，多个条件用 AND 连接
+  std::string scan_predicates(const std::string &table)
+  {
+    for (TableGetLogicalNode *table_get : table_gets_) {
+      if (table_get->table_alias() == table) {
+        std::string result;
+        for (std::unique_ptr<Expression> &expr : table_get->predicates()) {
+          result += (result.empty() ? "" : " AND ") + expr_to_string(expr.get());
+        }
+        return result;
+      }
+    }
+    return "no table";
+  }
+
+  void collect(LogicalNode *node)
+  {
+    if (node->type() == LogicalNodeType::TABLE_GET) {
+      table_gets_.push_back(static_cast<TableGetLogicalNode *>(node));
+    } else if (node->type() == LogicalNodeType::JOIN) {
+      joins_.push_back(static_cast<JoinLogicalNode *>(node));
+    }
+    for (std::unique_ptr<LogicalNode> &child : node->children()) {
+      collect(child.get());
+    }
+  }
+
+  static SqlTestEnv *env_;
+
+  std::unique_ptr<Stmt>              stmt_;
+  std::unique_ptr<LogicalNode>       plan_;
+  std::vector<TableGetLogicalNode *> table_gets_;
+  std::vector<JoinLogicalNode *>     joins_;  ///< 先序遍历的顺序，第一个是最上面的连接
+};
+
+SqlTestEnv *PredicatePushdownTest::env_ = nullptr;
+
+TEST_F(PredicatePushdownTest, split_conjuncts)
+{
+  ASSERT_TRUE(pushdown("select * from a, b where a.id = b.id and a.v = 1 and b.v > 2"));
+  // 所有条件都下推之后谓词节点只剩下常量 true
+  LogicalNode *predicate = plan_->children()[0].get();
+  ASSERT_EQ(LogicalNodeType::PREDICATE, predicate->type());
+  ASSERT_EQ(ExprType::VALUE, predicate->expressions()[0]->type());
+  ASSERT_EQ(1U, joins_.size());
+  ASSERT_EQ("a.id=b.id", expr_to_string(joins_[0]->condition().get()));
+  ASSERT_EQ("a.v=1", scan_predicates("a"));
+  ASSERT_EQ("b.v>2", scan_predicates("b"));
+}
+
+TEST_F(PredicatePushdownTest, lowest_join)
+{
+  // 只涉及 a 与 b 的条件放在下面的连接上，涉及 c 的放在上面的连接上
+  ASSERT_TRUE(pushdown("select * from a, b, c where a.id = b.id and b.v = c.id and a.v < b.v"));
+  ASSERT_EQ(2U, joins_.size());
+  ASSERT_EQ("b.v=c.id", expr_to_string(joins_[0]->condition().get()));
+  ASSERT_EQ("(a.v<b.v AND a.id=b.id)", expr_to_string(joins_[1]->condition().get()));
+  ASSERT_EQ("", scan_predicates("c"));
+}
+
+TEST_F(PredicatePushdownTest, derive_constant)
+{
+  // a.id = b.id 与 b.id = 5 推出 a.id = 5
+  pushdown("select * from a, b where a.id = b.id and b.id = 5");
+  ASSERT_EQ("a.id=5", scan_predicates("a"));
+  ASSERT_EQ("b.id=5", scan_predicates("b"));
+  ASSERT_EQ("a.id=b.id", expr_to_string(joins_[0]->condition().get()));
+}
+
+TEST_F(PredicatePushdownTest, derive_join_equality)
+{
+  // a.id = b.id 与 b.id = c.id 推出 c.id = a.id，三张表两两之间都有连接条件
+  pushdown("select * from a, b, c where a.id = b.id and b.id = c.id");
+  ASSERT_EQ(2U, joins_.size());
+  ASSERT_EQ("(b.id=c.id AND c.id=a.id)", expr_to_string(joins_[0]->condition().get()));
+  ASSERT_EQ("a.id=b.id", expr_to_string(joins_[1]->condition().get()));
+}
+
+TEST_F(PredicatePushdownTest, no_derivation_between_inexact_types)
+{
+  // 整数与浮点数的比较不是精确的，不能传递常量
+  pushdown("select * from a, c where a.id = c.f and c.f = 1.5");
+  ASSERT_EQ("", scan_predicates("a"));
+  ASSERT_EQ("c.f=1.5", scan_predicates("c"));
+}
+
+TEST_F(PredicatePushdownTest, idempotent)
+{
+  ASSERT_TRUE(pushdown("select * from a, b, c where a.id = b.id and b.id = c.id and c.id = 3"));
+  const std::string a_predicates = scan_predicates("a");
+  ASSERT_EQ("a.id=3", a_predicates);
+
+  bool change_made = false;
+  PredicatePushdownRewriter rewriter;
+  ASSERT_EQ(RC::SUCCESS, rewriter.rewrite(plan_->children()[0], change_made));
+  ASSERT_FALSE(change_made);
+  ASSERT_EQ(a_predicates, scan_predicates("a"));
+}
@@ -0,0 +1,73 @@
+#include <string>
+
+#include "gtest/gtest.h"
+#include "include/session/ring_buffer.h"
+
+TEST(test_ring_buffer, test_write_buffer_and_commit)
+{
+  RingBuffer buffer(8);
+
+  // 空的缓存可以写满整个空间
+  char *buf = nullptr;
+  int32_t size = 0;
+  ASSERT_EQ(RC::SUCCESS, buffer.write_buffer(buf, size));
+  ASSERT_EQ(8, size);
+  memcpy(buf, "abcdef", 6);
+  ASSERT_EQ(RC::SUCCESS, buffer.commit(6));
+  ASSERT_EQ(6, buffer.size());
+
+  // 读走一部分之后，写指针绕回到开头
+  char out[8];
+  int32_t read_size = 0;
+  ASSERT_EQ(RC::SUCCESS, buffer.read(out, 4, read_size));
+  ASSERT_EQ(4, read_size);
+  ASSERT_EQ(0, memcmp(out, "abcd", 4));
+
+  ASSERT_EQ(RC::SUCCESS, buffer.write_buffer(buf, size));
+  ASSERT_EQ(2, size);  // 到数组末尾为止的连续空间
+  memcpy(buf, "gh", 2);
+  ASSERT_EQ(RC::SUCCESS, buffer.commit(2));
+
+  ASSERT_EQ(RC::SUCCESS, buffer.write_buffer(buf, size));
+  ASSERT_EQ(4, size);  // 绕回开头，到读指针为止
+  memcpy(buf, "ijkl", 4);
+  ASSERT_EQ(RC::SUCCESS, buffer.commit(4));
+  ASSERT_EQ(0, buffer.remain());
+
+  // 缓存已满
+  ASSERT_EQ(RC::SUCCESS, buffer.write_buffer(buf, size));
+  ASSERT_EQ(0, size);
+  ASSERT_NE(RC::SUCCESS, buffer.commit(1));
+
+  ASSERT_EQ(RC::SUCCESS, buffer.read(out, 8, read_size));
+  ASSERT_EQ(8, read_size);
+  ASSERT_EQ(std::string("efghijkl"), std::string(out, 8));
+  ASSERT_EQ(0, buffer.size());
+}
+
+TEST(test_ring_buffer, test_release)
+{
+  RingBuffer buffer(8);
+
+  int32_t write_size = 0;
+  ASSERT_EQ(RC::SUCCESS, buffer.write("abc", 3, write_size));
+  ASSERT_EQ(3, write_size);
+
+  // 还有数据时不能释放
+  buffer.release();
+  ASSERT_EQ(3, buffer.size());
+
+  char out[8];
+  int32_t read_size = 0;
+  ASSERT_EQ(RC::SUCCESS, buffer.read(out, 3, read_size));
+  ASSERT_EQ(0, memcmp(out, "abc", 3));
+
+  // 释放之后容量不变，再次写入时重新分配
+  buffer.release();
+  ASSERT_EQ(8, buffer.capacity());
+  ASSERT_EQ(8, buffer.remain());
+  ASSERT_EQ(RC::SUCCESS, buffer.write("defghijk", 8, write_size));
+  ASSERT_EQ(8, write_size);
+  ASSERT_EQ(RC::SUCCESS, buffer.read(out, 8, read_size));
+  ASSERT_EQ(std::string("defghijk"), std::string(out, 8));
+}
@@ -0,0 +1,37 @@
+#include "gtest/gtest.h"
+#include "include/session/session.h"
+
+TEST(test_session_pool, test_reuse_and_reset)
+{
+  SessionPool pool;
+  pool.set_capacity(1);
+
+  // 放回的会话会被重置，下一个连接取出的是同一个对象
+  Session *session = pool.acquire();
+  session->set_sql_debug(true);
+  session->add_prepared_stmt("p1", nullptr);
+  pool.release(session);
+  ASSERT_EQ(1U, pool.idle_size());
+
+  Session *reused = pool.acquire();
+  ASSERT_EQ(session, reused);
+  ASSERT_EQ(0U, pool.idle_size());
+  ASSERT_FALSE(reused->sql_debug_on());
+  ASSERT_FALSE(reused->remove_prepared_stmt("p1"));
+
+  // 池满时直接释放
+  Session *other = pool.acquire();
+  pool.release(reused);
+  pool.release(other);
+  ASSERT_EQ(1U, pool.idle_size());
+
+  // 多语句事务还没有结束的会话不能复用
+  Session *in_trx = pool.acquire();
+  in_trx->set_trx_multi_operation_mode(true);
+  pool.release(in_trx);
+  ASSERT_EQ(0U, pool.idle_size());
+
+  pool.set_capacity(0);
+  pool.release(pool.acquire());
+  ASSERT_EQ(0U, pool.idle_size());
+}
@@ -0,0 +1,96 @@
+#include <string.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "common/io/shm_channel.h"
+
+using namespace common;
+
+TEST(test_shm_channel, test_ring_wrap_and_wait)
+{
+  ShmChannel server;
+  ASSERT_EQ(0, server.create(8));
+
+  // 客户端用同一组描述符再映射一次，两边看到的是同一块内存
+  int fds[SHM_CHANNEL_FD_NUM];
+  for (int i = 0; i < SHM_CHANNEL_FD_NUM; i++) {
+    fds[i] = dup(server.fd(static_cast<ShmChannelFd>(i)));
+  }
+  ShmChannel client;
+  ASSERT_EQ(0, client.attach(fds));
+
+  ShmRing &producer = server.response_ring();
+  ShmRing &consumer = client.response_ring();
+  ASSERT_EQ(8U, consumer.capacity());
+
+  // 空间不够时只写一部分
+  ASSERT_EQ(8U, producer.write("abcdefghij", 10));
+  ASSERT_EQ(0U, producer.write("x", 1));
+  char out[16];
+  ASSERT_EQ(6U, consumer.read(out, 6));
+  ASSERT_EQ(0, memcmp(out, "abcdef", 6));
+
+  // 写指针绕回到开头
+  ASSERT_EQ(6U, producer.write("klmnop", 6));
+  ASSERT_EQ(8U, consumer.read(out, sizeof(out)));
+  ASSERT_EQ(0, memcmp(out, "ghklmnop", 8));
+  ASSERT_EQ(0U, consumer.read(out, sizeof(out)));
+
+  // 消费者设置等待标记之后，生产者写入时才需要唤醒
+  ASSERT_FALSE(producer.take_reader_waiting());
+  ASSERT_TRUE(consumer.prepare_read_wait());
+  ASSERT_EQ(1U, producer.write("q", 1));
+  ASSERT_TRUE(producer.take_reader_waiting());
+  ASSERT_FALSE(producer.take_reader_waiting());
+  // 已经有数据时不需要睡眠
+  ASSERT_FALSE(consumer.prepare_read_wait());
+}
+
+TEST(test_shm_channel, test_concurrent_transfer)
+{
+  ShmChannel channel;
+  ASSERT_EQ(0, channel.create(4096));
+  ShmRing &ring = channel.request_ring();
+
+  const size_t total = 4 * 1024 * 1024;
+  std::thread producer([&ring, total]() {
+    char   buf[1000];
+    size_t pos = 0;
+    while (pos < total) {
+      const size_t size = std::min<size_t>(1 + pos % sizeof(buf), total - pos);
+      for (size_t i = 0; i < size; i++) {
+        buf[i] = static_cast<char>((pos + i) % 251);
+      }
+      size_t written = 0;
+      while (written < size) {
+        const uint32_t n = ring.write(buf + written, static_cast<uint32_t>(size - written));
+        if (n == 0) {
+          std::this_thread::yield();
+        }
+        written += n;
+      }
+      pos += size;
+    }
+  });
+
+  char   buf[777];
+  size_t pos = 0;
+  size_t bad = 0;
+  while (pos < total) {
+    const uint32_t size = ring.read(buf, sizeof(buf));
+    if (size == 0) {
+      std::this_thread::yield();
+    }
+    for (uint32_t i = 0; i < size; i++) {
+      if (buf[i] != static_cast<char>((pos + i) % 251)) {
+        bad++;
+      }
+    }
+    pos += size;
+  }
+  producer.join();
+  ASSERT_EQ(0U, bad);
+}
@@ -0,0 +1,60 @@
+#include <string>
+
+#include "gtest/gtest.h"
+#include "include/query_engine/slow_query_log.h"
+
+TEST(test_slow_query_log, test_threshold_and_history)
+{
+  SlowQueryLog &slow_query_log = SlowQueryLog::instance();
+  ASSERT_EQ(RC::SUCCESS, slow_query_log.init("", 1, 2));
+  ASSERT_FALSE(slow_query_log.is_slow(999999));
+  ASSERT_TRUE(slow_query_log.is_slow(1000000));
+
+  QueryStats stats;
+  stats.total_ns = 100;
+  slow_query_log.record("db", "select 0", RC::SUCCESS, stats);
+  ASSERT_TRUE(slow_query_log.history().empty());
+
+  // 只保留最近的两条
+  stats.total_ns = 2000000;
+  stats.pages_read = 3;
+  stats.add_phase_time(QueryPhase::EXECUTE, 1500000);
+  for (int i = 1; i <= 3; i++) {
+    slow_query_log.record("db", "select " + std::to_string(i), RC::SUCCESS, stats);
+  }
+  std::vector<SlowQueryRecord> history = slow_query_log.history();
+  ASSERT_EQ(2U, history.size());
+  ASSERT_EQ("select 2", history[0].sql);
+  ASSERT_EQ("select 3", history[1].sql);
+  ASSERT_EQ(3U, history[1].pages_read);
+  ASSERT_EQ(1500000, history[1].phase_ns[static_cast<int>(QueryPhase::EXECUTE)]);
+
+  // 阈值小于0时关闭
+  ASSERT_EQ(RC::SUCCESS, slow_query_log.init("", -1, 2));
+  ASSERT_FALSE(slow_query_log.is_slow(INT64_MAX));
+  slow_query_log.cleanup();
+}
+
+TEST(test_slow_query_log, test_json)
+{
+  SlowQueryRecord record;
+  record.db        = "db";
+  record.sql       = "select \"a\\b\"\nfrom t";
+  record.rc        = RC::SUCCESS;
+  record.total_ns  = 1500000;
+  record.rows_sent = 7;
+  record.operators = "PROJECT(7) <- TABLE_SCAN t(7/10)";
+
+  const std::string json = record.to_json();
+  ASSERT_EQ('{', json.front());
+  ASSERT_EQ('}', json.back());
+  ASSERT_NE(std::string::npos, json.find("\"sql\":\"select \\\"a\\\\b\\\"\\nfrom t\""));
+  ASSERT_NE(std::string::npos, json.find("\"rc\":\"SUCCESS\""));
+  ASSERT_NE(std::string::npos, json.find("\"total_ms\":1.500"));
+  ASSERT_NE(std::string::npos, json.find("\"rows_sent\":7"));
+  ASSERT_EQ(std::string::npos, json.find('\n'));
+
+  // 过长的SQL被截断，整行不超过日志一行的长度
+  record.sql = std::string(4096, 'x');
+  ASSERT_LT(record.to_json().size(), 1024U);
+}
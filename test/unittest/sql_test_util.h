@@ -0,0 +1,192 @@
+#pragma once
+
+#include <stdlib.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "include/common/global_context.h"
+#include "include/query_engine/analyzer/statement/stmt.h"
+#include "include/query_engine/parser/parser.h"
+#include "include/query_engine/planner/planner.h"
+#include "include/query_engine/query_engine.h"
+#include "include/query_engine/structor/expression/comparison_expression.h"
+#include "include/query_engine/structor/expression/conjunction_expression.h"
+#include "include/query_engine/structor/expression/field_expression.h"
+#include "include/query_engine/structor/expression/value_expression.h"
+#include "include/session/plain_communicator.h"
+#include "include/session/session.h"
+#include "include/session/session_request.h"
+#include "include/storage_engine/buffer/buffer_pool.h"
+#include "include/storage_engine/recorder/table.h"
+#include "include/storage_engine/schema/default_handler.h"
+#include "include/storage_engine/transaction/trx.h"
+
+/**
+ * @brief 在单元测试中执行SQL
+ * @details 在临时目录中初始化数据库，通过套接字对以文本协议发送请求，返回去掉执行时间之后的结果。
+ * 事务模块只能初始化一次，一个测试程序只能使用一种事务模型
+ */
+class SqlTestEnv
+{
+public:
+  explicit SqlTestEnv(const char *trx_kit)
+  {
+    char dir_template[] = "/tmp/tdb_sql_test_XXXXXX";
+    EXPECT_NE(nullptr, mkdtemp(dir_template));
+    dir_ = dir_template;
+
+    GCTX.buffer_pool_manager_ = new BufferPoolManager();
+    BufferPoolManager::set_instance(GCTX.buffer_pool_manager_);
+    EXPECT_EQ(RC::SUCCESS, TrxManager::init_global(trx_kit));
+    GCTX.trx_manager_ = TrxManager::instance();
+    GCTX.handler_ = new DefaultHandler();
+    DefaultHandler::set_default(GCTX.handler_);
+    EXPECT_EQ(RC::SUCCESS, GCTX.handler_->init(dir_.c_str()));
+
+    int fds[2];
+    EXPECT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+    client_fd_ = fds[1];
+    communicator_ = new PlainCommunicator();
+    EXPECT_EQ(RC::SUCCESS, communicator_->init(fds[0], SessionPool::instance().acquire(), "test"));
+  }
+
+  ~SqlTestEnv()
+  {
+    delete communicator_;
+    close(client_fd_);
+    delete GCTX.handler_;
+    GCTX.handler_ = nullptr;
+    DefaultHandler::set_default(nullptr);
+    std::filesystem::remove_all(dir_);
+  }
+
+  /**
+   * @brief 执行一个请求，结果不能超过套接字的缓冲区
+   */
+  std::string execute(const std::string &sql)
+  {
+    SessionRequest request(communicator_);
+    request.set_query(sql);
+    query_engine_.process_session_request(&request);
+
+    std::string output;
+    char buf[4096];
+    while (output.empty() || output.back() != '\0') {
+      ssize_t len = read(client_fd_, buf, sizeof(buf));
+      if (len <= 0) {
+        break;
+      }
+      output.append(buf, len);
+    }
+    if (!output.empty() && output.back() == '\0') {
+      output.pop_back();
+    }
+
+    // 执行时间每次都不一样
+    std::string result;
+    size_t pos = 0;
+    while (pos < output.size()) {
+      size_t end = output.find('\n', pos);
+      end = end == std::string::npos ? output.size() : end + 1;
+      if (output.compare(pos, 10, "Cost time:") != 0) {
+        result.append(output, pos, end - pos);
+      }
+      pos = end;
+    }
+    return result;
+  }
+
+  /**
+   * @brief 执行查询，去掉结果中用来对齐的空格，比如 "id|v\n1|2\n"
+   */
+  std::string query(const std::string &sql)
+  {
+    std::string result = execute(sql);
+    result.erase(std::remove(result.begin(), result.end(), ' '), result.end());
+    return result;
+  }
+
+  /**
+   * @brief 解析SQL并生成还没有重写的逻辑计划，逻辑计划引用了语句中的对象，两者要一起释放
+   */
+  RC logical_plan(const std::string &sql, std::unique_ptr<Stmt> &stmt, std::unique_ptr<LogicalNode> &plan)
+  {
+    std::unique_ptr<ParsedSqlNode> sql_node;
+    int param_count = 0;
+    RC rc = Parser::parse(sql, sql_node, param_count);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+    Stmt *raw_stmt = nullptr;
+    rc = Stmt::create_stmt(GCTX.handler_->find_db("sys"), *sql_node, raw_stmt);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+    stmt.reset(raw_stmt);
+    Planner planner;
+    return planner.plan_logical_tree(raw_stmt, plan);
+  }
+
+  /**
+   * @brief 把表的统计信息设置为指定的行数与页面数，用来模拟大表，表中实际的数据不变
+   */
+  void set_table_rows(const char *table_name, int64_t rows, int64_t pages)
+  {
+    Table *table = GCTX.handler_->find_table("sys", table_name);
+    ASSERT_NE(nullptr, table);
+    std::vector<ColumnStats> columns;
+    const_cast<TableStats &>(table->stats()).set_analyzed(rows, pages, std::move(columns));
+  }
+
+private:
+  std::string        dir_;
+  int                client_fd_    = -1;
+  PlainCommunicator *communicator_ = nullptr;
+  QueryEngine        query_engine_;
+};
+
+/**
+ * @brief 把条件表达式转换成字符串，比如 "(t.a=1 AND t.b>t.c)"，用来检查重写的结果
+ */
+inline std::string expr_to_string(const Expression *expr)
+{
+  static const char *const comp_names[] = {"=", "<=", "<>", "<", ">=", ">"};
+  if (expr == nullptr) {
+    return "null";
+  }
+  switch (expr->type()) {
+    case ExprType::FIELD: {
+      auto *field_expr = static_cast<const FieldExpr *>(expr);
+      return std::string(field_expr->table_name()) + "." + field_expr->field_name();
+    }
+    case ExprType::VALUE: {
+      return static_cast<const ValueExpr *>(expr)->get_value().to_string();
+    }
+    case ExprType::COMPARISON: {
+      auto *comparison_expr = static_cast<const ComparisonExpr *>(expr);
+      if (comparison_expr->comp() == IS_NULL || comparison_expr->comp() == IS_NOT_NULL) {
+        return expr_to_string(comparison_expr->_left_().get()) +
+               (comparison_expr->comp() == IS_NULL ? " IS NULL" : " IS NOT NULL");
+      }
+      const char *comp = comparison_expr->comp() <= GREAT_THAN ? comp_names[comparison_expr->comp()] : "?";
+      return expr_to_string(comparison_expr->_left_().get()) + comp + expr_to_string(comparison_expr->_right_().get());
+    }
+    case ExprType::CONJUNCTION: {
+      auto *conjunction_expr = const_cast<ConjunctionExpr *>(static_cast<const ConjunctionExpr *>(expr));
+      const char *sep = conjunction_expr->conjunction_type() == ConjunctionType::AND ? " AND " : " OR ";
+      std::string result = "(";
+      for (size_t i = 0; i < conjunction_expr->children().size(); i++) {
+        result += (i == 0 ? "" : sep) + expr_to_string(conjunction_expr->children()[i].get());
+      }
+      return result + ")";
+    }
+    default: return expr->name();
+  }
+}
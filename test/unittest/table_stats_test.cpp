@@ -0,0 +1,115 @@
+#include <cmath>
+#include <cstdio>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "include/storage_engine/recorder/table_stats.h"
+
+TEST(test_table_stats, test_hyperloglog)
+{
+  HyperLogLog hll;
+  for (int i = 0; i < 100000; i++) {
+    hll.add(Value(i % 20000));
+  }
+  // 标准误差约为 3%，这里留出足够的余量
+  ASSERT_NEAR(hll.estimate(), 20000, 20000 * 0.1);
+
+  HyperLogLog small;
+  for (int i = 0; i < 10; i++) {
+    small.add(Value(std::to_string(i).c_str()));
+  }
+  ASSERT_NEAR(small.estimate(), 10, 1);
+
+  // 合并之后等于对所有值一起统计
+  HyperLogLog other;
+  for (int i = 20000; i < 40000; i++) {
+    other.add(Value(i));
+  }
+  other.merge(hll);
+  ASSERT_NEAR(other.estimate(), 40000, 40000 * 0.1);
+
+  HyperLogLog restored;
+  ASSERT_EQ(RC::SUCCESS, restored.from_string(other.to_string()));
+  ASSERT_DOUBLE_EQ(other.estimate(), restored.estimate());
+  ASSERT_NE(RC::SUCCESS, restored.from_string("xyz"));
+}
+
+TEST(test_table_stats, test_selectivity)
+{
+  // 1..100 均匀分布，另外有 10% 的行是 NULL，10% 的行等于 0
+  ColumnStats stats;
+  stats.type = INTS;
+  stats.null_frac = 0.1;
+  stats.ndv = 101;
+  stats.mcv_values.push_back(Value(0));
+  stats.mcv_freqs.push_back(0.1);
+  for (int i = 0; i <= 4; i++) {
+    stats.histogram.push_back(Value(1 + i * 25));  // 1, 26, 51, 76, 101
+  }
+  stats.histogram_frac = 0.8;
+
+  ASSERT_DOUBLE_EQ(0.1, stats.selectivity(EQUAL_TO, Value(0)));
+  ASSERT_NEAR(0.008, stats.selectivity(EQUAL_TO, Value(50)), 1e-6);
+  ASSERT_DOUBLE_EQ(0, stats.selectivity(EQUAL_TO, Value(1000)));
+  ASSERT_DOUBLE_EQ(0.1, stats.selectivity(IS_NULL, Value()));
+
+  // 一半的直方图加上高频值 0
+  ASSERT_NEAR(0.5, stats.selectivity(LESS_THAN, Value(51)), 1e-6);
+  ASSERT_NEAR(0.4, stats.selectivity(GREAT_EQUAL, Value(51)), 1e-6);
+  ASSERT_NEAR(0.9, stats.selectivity(LESS_EQUAL, Value(1000)), 1e-6);
+  ASSERT_NEAR(0.8, stats.selectivity(GREAT_THAN, Value(0)), 1e-6);
+  ASSERT_NEAR(0.2, stats.selectivity(LESS_THAN, Value(38.5f)) - stats.selectivity(LESS_THAN, Value(13.5f)), 1e-6);
+}
+
+TEST(test_table_stats, test_save_and_load)
+{
+  ColumnStats column;
+  column.name = "c";
+  column.type = CHARS;
+  column.ndv = 3;
+  column.mcv_values.push_back(Value("hot"));
+  column.mcv_freqs.push_back(0.5);
+  column.histogram.push_back(Value("a"));
+  column.histogram.push_back(Value("z"));
+  column.histogram_frac = 0.5;
+  column.hll.add(Value("hot"));
+
+  TableStats stats;
+  std::vector<ColumnStats> columns{column};
+  stats.set_analyzed(100, 2, std::move(columns));
+  stats.on_insert();
+  stats.on_insert();
+  stats.on_delete();
+
+  const std::string file = "table_stats_test.stats";
+  ASSERT_EQ(RC::SUCCESS, stats.save(file));
+
+  TableStats loaded;
+  ASSERT_EQ(RC::SUCCESS, loaded.load(file));
+  remove(file.c_str());
+
+  ASSERT_TRUE(loaded.analyzed());
+  ASSERT_EQ(101, loaded.row_count());
+  ASSERT_EQ(3, loaded.modified_rows());
+  ASSERT_EQ(2, loaded.page_count());
+
+  ColumnStats loaded_column;
+  ASSERT_TRUE(loaded.column("c", loaded_column));
+  ASSERT_FALSE(loaded.column("d", loaded_column));
+  ASSERT_EQ(CHARS, loaded_column.type);
+  ASSERT_EQ(1, (int)loaded_column.mcv_values.size());
+  ASSERT_EQ("hot", loaded_column.mcv_values[0].to_string());
+  ASSERT_DOUBLE_EQ(0.5, loaded_column.selectivity(EQUAL_TO, Value("hot")));
+  ASSERT_EQ(2, (int)loaded_column.histogram.size());
+  ASSERT_DOUBLE_EQ(column.hll.estimate(), loaded_column.hll.estimate());
+
+  TableStats missing;
+  ASSERT_NE(RC::SUCCESS, missing.load("no_such_file.stats"));
+  ASSERT_FALSE(missing.row_count_known());
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
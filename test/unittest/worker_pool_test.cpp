@@ -0,0 +1,52 @@
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+#include "gtest/gtest.h"
+#include "include/common/worker_pool.h"
+
+TEST(test_worker_pool, test_run_all_tasks)
+{
+  const int task_num = 10000;
+  std::atomic<int> finished{0};
+  {
+    WorkerPool pool(4);
+    ASSERT_EQ(4, pool.thread_num());
+    for (int i = 0; i < task_num; i++) {
+      pool.submit([&finished]() { finished++; });
+    }
+    // 析构时会等待已经提交的任务执行完
+  }
+  ASSERT_EQ(task_num, finished.load());
+}
+
+TEST(test_worker_pool, test_submit_in_worker)
+{
+  // 在工作线程中提交的任务放在自己的队列里，空闲的线程会把它们偷走
+  const int task_num = 1000;
+  std::atomic<int> finished{0};
+  std::mutex lock;
+  std::condition_variable cond;
+
+  WorkerPool pool(4);
+  pool.submit([&]() {
+    for (int i = 0; i < task_num; i++) {
+      pool.submit([&]() {
+        if (++finished == task_num) {
+          std::lock_guard<std::mutex> guard(lock);
+          cond.notify_all();
+        }
+      });
+    }
+  });
+
+  std::unique_lock<std::mutex> guard(lock);
+  cond.wait(guard, [&]() { return finished.load() == task_num; });
+  ASSERT_EQ(task_num, finished.load());
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,172 @@
+#include <stdlib.h>
+
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "include/storage_engine/buffer/buffer_pool.h"
+#include "include/storage_engine/recorder/record_manager.h"
+#include "include/storage_engine/recorder/table.h"
+#include "include/storage_engine/recorder/zone_map.h"
+#include "include/storage_engine/transaction/trx.h"
+
+/**
+ * 假设table的元数据为(id int not null, v int)，id 按照插入的顺序递增，每个页面上的 id 是一段连续的范围
+ */
+class ZoneMapTest : public ::testing::Test
+{
+protected:
+  static void SetUpTestSuite()
+  {
+    BufferPoolManager::set_instance(new BufferPoolManager());
+    ASSERT_EQ(RC::SUCCESS, TrxManager::init_global("vacuous"));
+  }
+
+  void SetUp() override
+  {
+    char dir_template[] = "/tmp/tdb_zone_map_test_XXXXXX";
+    ASSERT_NE(nullptr, mkdtemp(dir_template));
+    dir_ = dir_template;
+
+    const AttrInfoSqlNode attributes[] = {{INTS, "id", 4, false}, {INTS, "v", 4, true}};
+    table_ = std::make_unique<Table>();
+    ASSERT_EQ(RC::SUCCESS, table_->create(1, (dir_ + "/t.table").c_str(), "t", dir_.c_str(), 2, attributes));
+
+    const TableMeta &table_meta = table_->table_meta();
+    for (int i = 0; i < table_meta.field_num(); i++) {
+      if (0 == strcmp(table_meta.field(i)->name(), "id")) {
+        id_index_ = i;
+      } else if (0 == strcmp(table_meta.field(i)->name(), "v")) {
+        v_index_ = i;
+      }
+    }
+  }
+
+  void TearDown() override
+  {
+    table_.reset();
+    std::filesystem::remove_all(dir_);
+  }
+
+  /// v 为负数时插入空值，返回记录所在的页面
+  PageNum insert(int id, int v)
+  {
+    Value values[] = {Value(id), Value(v)};
+    if (v < 0) {
+      values[1].set_null();
+    }
+    Record record;
+    EXPECT_EQ(RC::SUCCESS, table_->make_record(2, values, record));
+    EXPECT_EQ(RC::SUCCESS, table_->insert_record(record));
+    return record.rid().page_num;
+  }
+
+  ZonePredicate compare(int field_index, CompOp comp, const Value &value = Value())
+  {
+    ZonePredicate predicate;
+    predicate.kind        = ZonePredicate::Kind::COMPARE;
+    predicate.field_index = field_index;
+    predicate.comp        = comp;
+    predicate.value       = value;
+    return predicate;
+  }
+
+  ZonePredicate combine(ZonePredicate::Kind kind, ZonePredicate left, ZonePredicate right)
+  {
+    ZonePredicate predicate;
+    predicate.kind = kind;
+    predicate.children.push_back(std::move(left));
+    predicate.children.push_back(std::move(right));
+    return predicate;
+  }
+
+  /// 使用摘要过滤页面扫描整张表，返回满足 filter 的记录数与跳过的页面数
+  int scan(const ZonePredicate &predicate, int low, int high, int &skipped_pages)
+  {
+    RecordFileScanner scanner;
+    scanner.set_page_filter([this, &predicate](PageNum page_num) {
+      return table_->zone_map().may_match(page_num, predicate);
+    });
+    EXPECT_EQ(RC::SUCCESS, table_->get_record_scanner(scanner, nullptr, true));
+    int count = 0;
+    Record record;
+    while (scanner.has_next()) {
+      EXPECT_EQ(RC::SUCCESS, scanner.next(record));
+      int id = 0;
+      memcpy(&id, record.data() + table_->table_meta().field(id_index_)->offset(), sizeof(id));
+      count += (id >= low && id <= high) ? 1 : 0;
+    }
+    skipped_pages = scanner.skipped_pages();
+    EXPECT_EQ(RC::SUCCESS, scanner.close_scan());
+    return count;
+  }
+
+protected:
+  std::string            dir_;
+  std::unique_ptr<Table> table_;
+  int                    id_index_ = -1;
+  int                    v_index_  = -1;
+};
+
+TEST_F(ZoneMapTest, prune_pages)
+{
+  // 每个页面上 id 的范围
+  std::map<PageNum, std::pair<int, int>> ranges;
+  const int record_num = 5000;
+  for (int id = 0; id < record_num; id++) {
+    const PageNum page_num = insert(id, id % 10);
+    auto iter = ranges.find(page_num);
+    if (iter == ranges.end()) {
+      ranges[page_num] = {id, id};
+    } else {
+      iter->second.second = id;
+    }
+  }
+  ASSERT_GT(ranges.size(), 3U);
+
+  const ZoneMap &zone_map = table_->zone_map();
+  const ZonePredicate greater = compare(id_index_, GREAT_THAN, Value(4000));
+  const ZonePredicate equal = compare(id_index_, EQUAL_TO, Value(10));
+  for (const auto &[page_num, range] : ranges) {
+    ASSERT_EQ(range.second > 4000, zone_map.may_match(page_num, greater));
+    ASSERT_EQ(range.first <= 10 && range.second >= 10, zone_map.may_match(page_num, equal));
+    ASSERT_EQ(range.second > 4000 || range.first <= 10,
+        zone_map.may_match(page_num, combine(ZonePredicate::Kind::OR, greater, equal)));
+    ASSERT_FALSE(zone_map.may_match(page_num, combine(ZonePredicate::Kind::AND, greater, equal)));
+    // 每个页面上的 v 都在 0 到 9 之间，并且没有空值
+    ASSERT_FALSE(zone_map.may_match(page_num, compare(v_index_, GREAT_EQUAL, Value(10))));
+    ASSERT_FALSE(zone_map.may_match(page_num, compare(v_index_, IS_NULL)));
+    ASSERT_TRUE(zone_map.may_match(page_num, compare(v_index_, IS_NOT_NULL)));
+  }
+  // 没有摘要的页面不能跳过
+  ASSERT_TRUE(zone_map.may_match(ranges.rbegin()->first + 100, greater));
+
+  // 跳过页面之后结果不变
+  int skipped_pages = 0;
+  ASSERT_EQ(record_num - 4001, scan(greater, 4001, record_num, skipped_pages));
+  ASSERT_GT(skipped_pages, 0);
+}
+
+TEST_F(ZoneMapTest, widen_and_rebuild)
+{
+  PageNum page_num = insert(1, 1);
+  insert(2, 2);
+  const ZoneMap &zone_map = table_->zone_map();
+  ASSERT_FALSE(zone_map.may_match(page_num, compare(id_index_, GREAT_THAN, Value(100))));
+  ASSERT_FALSE(zone_map.may_match(page_num, compare(v_index_, IS_NULL)));
+
+  // 插入之后范围扩大
+  ASSERT_EQ(page_num, insert(200, -1));
+  ASSERT_TRUE(zone_map.may_match(page_num, compare(id_index_, GREAT_THAN, Value(100))));
+  ASSERT_TRUE(zone_map.may_match(page_num, compare(v_index_, IS_NULL)));
+
+  // 重新打开表时从数据重新构建
+  table_ = std::make_unique<Table>();
+  ASSERT_EQ(RC::SUCCESS, table_->open("t.table", dir_.c_str()));
+  ASSERT_TRUE(table_->zone_map().may_match(page_num, compare(id_index_, GREAT_THAN, Value(100))));
+  ASSERT_FALSE(table_->zone_map().may_match(page_num, compare(id_index_, LESS_THAN, Value(1))));
+  ASSERT_FALSE(table_->zone_map().may_match(page_num, compare(v_index_, GREAT_THAN, Value(2))));
+}